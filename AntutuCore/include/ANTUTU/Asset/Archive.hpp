@@ -0,0 +1,75 @@
+/*
+ * Archive.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Read side of the .apak archive (see ArchiveFormat.hpp).
+ * Opening maps the whole file and validates the table of contents, after
+ * that a lookup is a binary search and reading an uncompressed asset is a
+ * pointer into the mapping: no open / read / close per asset, the page
+ * cache is the only copy until the data lands in a staging buffer.
+ *
+ *      Archive archive;
+ *      archive.Open("data/level1.apak");
+ *      if (const ArchiveEntry* entry = archive.Find("textures/rock.tex"))
+ *          archive.Read(*entry, stagingMemory);
+ *
+ * Read only and thread safe once opened.
+ */
+
+#ifndef ANTUTU_ASSET_ARCHIVE_HPP
+#define ANTUTU_ASSET_ARCHIVE_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Asset/ArchiveFormat.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace att::Asset
+{
+    class ANTUTU_API Archive
+    {
+    public:
+        Archive() = default;
+        ~Archive();
+
+        Archive(const Archive&) = delete;
+        Archive& operator=(const Archive&) = delete;
+
+        // false when the file is missing, truncated or not an archive this build can read.
+        bool Open(const char* path);
+        void Close();
+        bool IsOpen() const { return m_data != nullptr; }
+
+        const ArchiveEntry* Find(std::string_view path) const { return Find(HashAssetPath(path)); }
+        const ArchiveEntry* Find(uint64_t pathHash) const;
+
+        // the stored bytes, compressed or not, valid until Close.
+        const uint8_t* GetData(const ArchiveEntry& entry) const { return m_data + entry.offset; }
+        // rawSize bytes into destination, decompressing if needed.
+        bool Read(const ArchiveEntry& entry, void* destination) const;
+        // starts the page-in of the entry ahead of the read, a hint. offset and size pick a
+        // part of an uncompressed entry, a compressed one is prefetched whole.
+        void Prefetch(const ArchiveEntry& entry, uint64_t offset = 0, uint64_t size = UINT64_MAX) const;
+
+        std::string_view GetPath(const ArchiveEntry& entry) const;
+        // sorted by pathHash.
+        const ArchiveEntry* GetEntries() const { return m_entries; }
+        uint32_t GetEntryCount() const { return m_entryCount; }
+        const ArchiveHeader& GetHeader() const { return *reinterpret_cast<const ArchiveHeader*>(m_data); }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        uint64_t m_size = 0;
+        const ArchiveEntry* m_entries = nullptr;
+        uint32_t m_entryCount = 0;
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+}
+
+#endif // ANTUTU_ASSET_ARCHIVE_HPP
@@ -0,0 +1,85 @@
+/*
+ * ArchiveFormat.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: On-disk layout of the .apak asset archive, shared by the
+ * runtime reader and the tools that write it.
+ *
+ *      ArchiveHeader
+ *      blob 0          aligned to ArchiveHeader::alignment (4 KB or 64 KB)
+ *      blob 1
+ *      ...
+ *      ArchiveEntry[entryCount]    sorted by pathHash
+ *      path strings    not null terminated, for tools and error messages
+ *
+ * Blobs are page aligned so the mapped file can be handed to the GPU
+ * upload path as is: an uncompressed blob is already the staging data.
+ * Everything is little endian; the structs are read in place.
+ */
+
+#ifndef ANTUTU_ASSET_ARCHIVE_FORMAT_HPP
+#define ANTUTU_ASSET_ARCHIVE_FORMAT_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace att::Asset
+{
+    constexpr uint32_t ArchiveMagic = 0x4B415041; // "APAK"
+    constexpr uint32_t ArchiveVersion = 1;
+    constexpr uint32_t ArchiveSmallAlignment = 4096;
+    // large pages / what some GPUs want for sparse textures.
+    constexpr uint32_t ArchiveLargeAlignment = 65536;
+
+    enum class ArchiveCompression : uint8_t
+    {
+        None,
+        LZ4,
+        Zstd
+    };
+
+    struct ArchiveHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t alignment;
+        uint64_t tocOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+        // of the whole archive, catches truncated files.
+        uint64_t fileSize;
+    };
+
+    struct ArchiveEntry
+    {
+        uint64_t pathHash;
+        uint64_t offset;
+        // as stored.
+        uint64_t size;
+        // once decompressed, equal to size when stored uncompressed.
+        uint64_t rawSize;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        ArchiveCompression compression;
+        uint8_t reserved[7];
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 48 && sizeof(ArchiveEntry) == 48, "on-disk layout");
+
+    // FNV-1a 64 of the path relative to the archive root, '\' read as '/'.
+    constexpr uint64_t HashAssetPath(std::string_view path)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : path)
+        {
+            hash ^= static_cast<uint8_t>(c == '\\' ? '/' : c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
+
+#endif // ANTUTU_ASSET_ARCHIVE_FORMAT_HPP
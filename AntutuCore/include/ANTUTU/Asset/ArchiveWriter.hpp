@@ -0,0 +1,71 @@
+/*
+ * ArchiveWriter.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Writes a .apak archive (see ArchiveFormat.hpp), used by
+ * the packer and the cooking tools. Blobs are streamed to the file as they
+ * are added, the table of contents is written by Finish.
+ *
+ *      ArchiveWriter writer;
+ *      writer.Open("data/level1.apak");
+ *      writer.Add("meshes/rock.mesh", bytes.data(), bytes.size(), ArchiveCompression::LZ4);
+ *      writer.Finish();
+ */
+
+#ifndef ANTUTU_ASSET_ARCHIVE_WRITER_HPP
+#define ANTUTU_ASSET_ARCHIVE_WRITER_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Asset/ArchiveFormat.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace att::Asset
+{
+    class ANTUTU_API ArchiveWriter
+    {
+    public:
+        ArchiveWriter() = default;
+        // an archive not finished is deleted.
+        ~ArchiveWriter();
+
+        ArchiveWriter(const ArchiveWriter&) = delete;
+        ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+        // alignment: ArchiveSmallAlignment or ArchiveLargeAlignment, any power of two works.
+        bool Open(const std::string& path, uint32_t alignment = ArchiveSmallAlignment);
+        // the blob is stored uncompressed when the codec is missing or saves less than
+        // minSaving of its size. false on a duplicate path or a write error.
+        bool Add(std::string_view path, const void* data, uint64_t size,
+                 ArchiveCompression compression = ArchiveCompression::None, int level = 0, float minSaving = 0.1f);
+        bool Finish();
+
+        uint32_t GetEntryCount() const { return static_cast<uint32_t>(m_entries.size()); }
+        // bytes added / bytes written for the blobs so far, padding included.
+        uint64_t GetRawBytes() const { return m_rawBytes; }
+        uint64_t GetStoredBytes() const { return m_offset; }
+
+    private:
+        bool Write(const void* data, uint64_t size);
+        bool Pad(uint64_t alignment);
+
+        std::string m_path;
+        FILE* m_file = nullptr;
+        uint32_t m_alignment = ArchiveSmallAlignment;
+        uint64_t m_offset = 0;
+        uint64_t m_rawBytes = 0;
+        std::vector<ArchiveEntry> m_entries;
+        std::unordered_set<uint64_t> m_hashes;
+        std::string m_strings;
+        std::vector<uint8_t> m_scratch;
+    };
+}
+
+#endif // ANTUTU_ASSET_ARCHIVE_WRITER_HPP
@@ -0,0 +1,186 @@
+/*
+ * AssetCache.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Shares loaded assets between their users. Assets are keyed
+ * by their path and import settings, so two objects asking for the same
+ * texture get the same AssetRef and it is loaded (and uploaded) once.
+ *
+ * AssetRef is an intrusive reference: one pointer, the count lives in the
+ * cache entry, no control block per asset. An asset nobody references any
+ * more is not released right away but parked in an LRU, so dropping a level
+ * and coming back to it finds its assets still resident; the least
+ * recently used unreferenced assets are released once the resident bytes
+ * go over the budget.
+ *
+ *      AssetRef rock = m_cache.Acquire("meshes/rock.mesh", AssetType::Mesh);
+ *      ...
+ *      if (const Mesh* mesh = rock.As<Mesh>()) { ... }    // nullptr until Ready
+ *
+ *      m_streamer.Update();
+ *      m_cache.Update();                                   // once per frame, after the streamer
+ */
+
+#ifndef ANTUTU_ASSET_ASSET_CACHE_HPP
+#define ANTUTU_ASSET_ASSET_CACHE_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Asset/ArchiveFormat.hpp>
+#include <ANTUTU/Asset/AssetStreamer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace att::Asset
+{
+    // HashAssetPath of the path, mixed with the type and the import settings.
+    using AssetKey = uint64_t;
+    ANTUTU_API AssetKey MakeAssetKey(std::string_view path, uint32_t assetType, uint64_t settings);
+
+    class AssetCache;
+
+    namespace Detail
+    {
+        struct CacheEntry
+        {
+            AssetCache* cache = nullptr;
+            std::atomic<uint32_t> references{ 0 };
+            AssetKey key = 0;
+            AssetHandle handle = InvalidAsset;
+            // what the key was made of, to tell a hit from a hash collision.
+            std::string path;
+            uint32_t assetType = 0;
+            uint64_t settings = 0;
+            // in AssetCache::m_unreferenced, guarded by its mutex.
+            bool listed = false;
+
+            // owner thread.
+            uint64_t size = 0;
+            bool resident = false;
+            // unreferenced, most recently used first.
+            CacheEntry* lruPrevious = nullptr;
+            CacheEntry* lruNext = nullptr;
+            bool inLru = false;
+        };
+    }
+
+    // Copies and releases may happen on any thread, only the owner thread acquires new ones.
+    class ANTUTU_API AssetRef
+    {
+    public:
+        AssetRef() = default;
+        AssetRef(const AssetRef& other);
+        AssetRef(AssetRef&& other) noexcept : m_entry(other.m_entry) { other.m_entry = nullptr; }
+        ~AssetRef() { Reset(); }
+
+        AssetRef& operator=(const AssetRef& other);
+        AssetRef& operator=(AssetRef&& other) noexcept;
+
+        void Reset();
+
+        bool IsValid() const { return m_entry != nullptr; }
+        explicit operator bool() const { return m_entry != nullptr; }
+        bool operator==(const AssetRef& other) const { return m_entry == other.m_entry; }
+
+        AssetKey GetKey() const { return m_entry != nullptr ? m_entry->key : 0; }
+        AssetHandle GetHandle() const { return m_entry != nullptr ? m_entry->handle : InvalidAsset; }
+        // owner thread, see AssetStreamer.
+        AssetState GetState() const;
+        void* Get() const;
+        template<typename T>
+        T* As() const { return static_cast<T*>(Get()); }
+
+    private:
+        friend class AssetCache;
+        // takes a reference already counted.
+        explicit AssetRef(Detail::CacheEntry* entry) : m_entry(entry) {}
+
+        Detail::CacheEntry* m_entry = nullptr;
+    };
+
+    struct AssetCacheStats
+    {
+        // Acquire found the asset referenced, or loading.
+        uint32_t hits = 0;
+        // Acquire found the asset in the LRU.
+        uint32_t revived = 0;
+        uint32_t misses = 0;
+        uint32_t evicted = 0;
+        uint32_t entries = 0;
+        uint64_t residentBytes = 0;
+        // resident but unreferenced, released first when over budget.
+        uint64_t unusedBytes = 0;
+    };
+
+    class ANTUTU_API AssetCache
+    {
+    public:
+        AssetCache() = default;
+        ~AssetCache();
+
+        AssetCache(const AssetCache&) = delete;
+        AssetCache& operator=(const AssetCache&) = delete;
+
+        // memoryBudget: resident bytes (AssetStreamer::GetSize) above which unused assets
+        // are released. Referenced assets are never released, so the budget can be exceeded.
+        void Initialize(AssetStreamer& streamer, uint64_t memoryBudget);
+        // releases every asset, the refs still alive must not be used afterwards.
+        void Shutdown();
+
+        // everything below is for the owner thread of the streamer.
+
+        // loads the asset unless it is cached. priority only applies to a new load.
+        // An invalid ref when the key collides with a different cached asset.
+        AssetRef Acquire(const std::string& path, uint32_t assetType, uint64_t settings = 0, float priority = 0.0f);
+        // the cached asset, or an invalid ref, without loading.
+        AssetRef Find(AssetKey key);
+
+        // after AssetStreamer::Update: accounts the newly resident assets, parks the
+        // unreferenced ones in the LRU and evicts down to the budget.
+        void Update();
+        // evicts every unreferenced asset, e.g. on a low memory warning.
+        void Purge();
+
+        void SetMemoryBudget(uint64_t memoryBudget) { m_memoryBudget = memoryBudget; }
+        uint64_t GetMemoryBudget() const { return m_memoryBudget; }
+        const AssetCacheStats& GetStats() const { return m_stats; }
+
+    private:
+        friend class AssetRef;
+
+        // any thread, drops what looked like the last reference. The decrement and the
+        // listing happen under m_unreferencedMutex, so Update can't free the entry in between.
+        void ReleaseLastReference(Detail::CacheEntry* entry);
+
+        void LinkLru(Detail::CacheEntry* entry);
+        void UnlinkLru(Detail::CacheEntry* entry);
+        void Evict(Detail::CacheEntry* entry);
+        void TrimToBudget(uint64_t budget);
+
+        AssetStreamer* m_streamer = nullptr;
+        uint64_t m_memoryBudget = 0;
+
+        std::unordered_map<AssetKey, std::unique_ptr<Detail::CacheEntry>> m_entries;
+        // requested, not resident yet.
+        std::vector<Detail::CacheEntry*> m_loading;
+        Detail::CacheEntry* m_lruHead = nullptr;
+        Detail::CacheEntry* m_lruTail = nullptr;
+
+        // entries whose last reference went away, parked by Update.
+        std::mutex m_unreferencedMutex;
+        std::vector<Detail::CacheEntry*> m_unreferenced;
+        std::vector<Detail::CacheEntry*> m_unreferencedScratch;
+
+        AssetCacheStats m_stats;
+    };
+}
+
+#endif // ANTUTU_ASSET_ASSET_CACHE_HPP
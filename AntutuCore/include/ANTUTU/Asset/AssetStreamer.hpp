@@ -0,0 +1,286 @@
+/*
+ * AssetStreamer.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Asynchronous asset loading. The owner thread (the game
+ * loop) asks for files by path and gets a handle back immediately; a
+ * dedicated I/O thread reads them through an AsyncFileReader, highest
+ * priority first and in chunks so one large file doesn't hold the whole
+ * queue; the loader registered for the asset type decodes the bytes on the
+ * job system; and Update, once per frame, hands decoded assets to their
+ * upload callback within a byte budget and posts an AssetReadyEvent for
+ * every asset that finished.
+ *
+ * Paths found in a mounted archive skip the reads: the decoder works on
+ * the mapped archive directly (after decompression, if it is compressed).
+ * LoadRange reads a part of the file only, e.g. one mip of a texture.
+ *
+ * Priorities can be changed at any time (distance, visibility...) and
+ * reorder everything that hasn't started reading. A cancelled request stops
+ * at its next stage and its memory is released.
+ *
+ *      m_streamer.RegisterLoader(AssetType::Mesh, { &DecodeMesh, &UploadMesh, &ReleaseMesh, this });
+ *      const AssetHandle handle = m_streamer.Load("meshes/rock.mesh", AssetType::Mesh, 1.0f / distance);
+ *      ...
+ *      m_streamer.Update();                            // once per frame
+ *      Common::EventBus::Get().DispatchDeferred();     // delivers AssetReadyEvent
+ */
+
+#ifndef ANTUTU_ASSET_ASSET_STREAMER_HPP
+#define ANTUTU_ASSET_ASSET_STREAMER_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Asset/Archive.hpp>
+#include <ANTUTU/Asset/AsyncFileReader.hpp>
+#include <Common/Job/JobSystem.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace att::Asset
+{
+    // low 32 bits: slot, high 32 bits: generation. Also AssetReadyEvent::assetId.
+    using AssetHandle = uint64_t;
+    constexpr AssetHandle InvalidAsset = 0;
+
+    enum class AssetState : uint8_t
+    {
+        None,           // unknown or released handle
+        Queued,
+        Reading,
+        Decoding,
+        Uploading,      // decoded, waiting for the upload budget
+        Ready,
+        Failed,
+        Cancelled
+    };
+
+    // What turns file bytes into a usable asset, per asset type.
+    struct AssetLoader
+    {
+        // job thread: the whole file (the range for LoadRange), freed after the call, and the
+        // settings given to Load.
+        // Returns the asset, nullptr on failure.
+        void* (*decode)(void* context, const uint8_t* data, uint64_t size, uint64_t settings) = nullptr;
+        // owner thread, counted against the upload budget. Returns the bytes uploaded.
+        // Optional, e.g. for CPU only assets.
+        uint64_t (*upload)(void* context, void* asset) = nullptr;
+        // owner thread, on Unload or when a decoded asset is cancelled.
+        void (*release)(void* context, void* asset) = nullptr;
+        void* context = nullptr;
+    };
+
+    struct StreamerConfig
+    {
+        // reads in flight.
+        uint32_t queueDepth = 64;
+        // larger files are read in pieces of this size.
+        uint32_t chunkSize = 1u << 20;
+        // bytes the upload callbacks may report per Update. At least one asset is
+        // uploaded per frame, however large.
+        uint64_t uploadBudget = 32ull << 20;
+        // read buffers kept for the next loads once decoded. A fresh allocation that
+        // large is page faulted in again on every load, which costs more than the read.
+        uint64_t bufferPoolSize = 64ull << 20;
+        // false forces the synchronous pread / ReadFile path.
+        bool allowIoUring = true;
+    };
+
+    struct StreamingStats
+    {
+        // by the reads, entries of mounted archives are mapped instead.
+        uint64_t bytesRead = 0;
+        uint32_t loaded = 0;
+        uint32_t failed = 0;
+        uint32_t cancelled = 0;
+        // requests not finished yet.
+        uint32_t pending = 0;
+        uint64_t uploadedLastUpdate = 0;
+        // bytes read over the time the I/O thread had reads in flight.
+        double throughputMBps = 0.0;
+        // from the first request made while idle until every request finished: how
+        // long a level transition waits before its first complete frame.
+        double lastBatchMs = 0.0;
+    };
+
+    class ANTUTU_API AssetStreamer
+    {
+    public:
+        static constexpr uint32_t MaxAssetTypes = 32;
+
+        AssetStreamer() = default;
+        ~AssetStreamer();
+
+        AssetStreamer(const AssetStreamer&) = delete;
+        AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+        // the calling thread becomes the owner thread.
+        bool Initialize(const StreamerConfig& config = {});
+        // cancels everything still pending and releases every asset.
+        void Shutdown();
+
+        // before the first Load of that type.
+        void RegisterLoader(uint32_t assetType, const AssetLoader& loader);
+
+        // everything below is for the owner thread.
+
+        // Load looks paths up in the archive before the file system, the last mounted
+        // archive first. The archive must stay open until Shutdown.
+        void Mount(const Archive& archive);
+
+        // higher priority is read first. settings is handed to the decoder as is, e.g.
+        // import flags like sRGB or the mip count packed by the loader of that type.
+        AssetHandle Load(const std::string& path, uint32_t assetType, float priority = 0.0f, uint64_t settings = 0);
+        // size bytes from offset, cut at the end of the file. An offset past the end fails.
+        // Compressed archive entries are decompressed whole for every range.
+        AssetHandle LoadRange(const std::string& path, uint32_t assetType, uint64_t offset, uint64_t size,
+                              float priority = 0.0f, uint64_t settings = 0);
+        void SetPriority(AssetHandle handle, float priority);
+        // a pending request stops at its next stage, GetState reports Cancelled until then.
+        void Cancel(AssetHandle handle);
+        // releases a loaded (or failed) asset and frees its handle, cancels a pending one.
+        void Unload(AssetHandle handle);
+
+        AssetState GetState(AssetHandle handle) const;
+        // nullptr until Ready.
+        void* GetAsset(AssetHandle handle) const;
+        // once Ready: the bytes the upload callback reported, the file size without one.
+        uint64_t GetSize(AssetHandle handle) const;
+
+        // once per frame: uploads within the budget and posts the AssetReadyEvents.
+        void Update();
+        // blocks until nothing is pending, e.g. behind a loading screen.
+        void Flush();
+
+        bool IsIdle() const { return m_stats.pending == 0; }
+        const char* GetBackendName() const { return m_reader.GetBackendName(); }
+        const StreamingStats& GetStats() const { return m_stats; }
+
+    private:
+        struct Request
+        {
+            AssetStreamer* streamer = nullptr;
+            uint32_t slot = 0;
+            std::string path;
+            uint32_t type = 0;
+            uint64_t settings = 0;
+            // UINT64_MAX: to the end of the file.
+            uint64_t rangeOffset = 0;
+            uint64_t rangeSize = UINT64_MAX;
+            uint32_t generation = 1;
+            float priority = 0.0f;
+            // guarded by m_queueMutex. Every push bumps the version, older entries are
+            // skipped; queued is cleared once the I/O thread took the request.
+            uint32_t queueVersion = 0;
+            bool queued = false;
+            std::atomic<AssetState> state{ AssetState::None };
+            std::atomic<bool> cancelled{ false };
+            // set by Update once the worker side handed the request back.
+            bool returned = false;
+
+            // I/O thread. size: of the range.
+            FileHandle file = InvalidFile;
+            uint64_t size = 0;
+            uint64_t submitted = 0;
+            uint32_t chunksInFlight = 0;
+            bool readFailed = false;
+            std::vector<uint8_t> data;
+            // set by Load when the path is in a mounted archive.
+            const Archive* archive = nullptr;
+            const ArchiveEntry* entry = nullptr;
+
+            // set by the decode job, owned by the owner thread afterwards.
+            void* asset = nullptr;
+            // set by Update on upload.
+            uint64_t residentSize = 0;
+        };
+
+        struct QueueEntry
+        {
+            float priority;
+            // not a slot: the I/O thread can't index the deque while Load grows it.
+            Request* request;
+            uint32_t version;
+
+            bool operator<(const QueueEntry& other) const { return priority < other.priority; }
+        };
+
+        // one read of the I/O thread, indexed by FileRead::userData.
+        struct Chunk
+        {
+            Request* request;
+            uint64_t offset;
+            uint32_t size;
+        };
+
+        Request* Find(AssetHandle handle) const;
+        // requeue: only if the I/O thread hasn't taken it yet.
+        void Push(Request& request, float priority, bool requeue);
+        void Release(Request& request);
+
+        void IoThread();
+        bool StartNext();
+        bool SubmitNextChunk();
+        void SubmitChunk(Request& request, uint64_t offset, uint32_t size);
+        void OnChunkDone(uint32_t chunk, int64_t result);
+        void FinishRead(Request& request);
+        // hands the request back to the owner thread, the worker side must not touch it afterwards.
+        void Complete(Request& request);
+        static void DecodeJob(void* data);
+
+        // I/O thread / any thread.
+        void AcquireBuffer(std::vector<uint8_t>& buffer, uint64_t size);
+        void RecycleBuffer(std::vector<uint8_t>& buffer);
+
+        StreamerConfig m_config;
+        AsyncFileReader m_reader;
+        std::thread::id m_owner;
+
+        // owner thread. A deque: the other threads hold pointers to its elements.
+        std::deque<Request> m_requests;
+        std::vector<uint32_t> m_freeSlots;
+        AssetLoader m_loaders[MaxAssetTypes] = {};
+        std::vector<const Archive*> m_archives;
+        // decoded, waiting for the upload budget.
+        std::vector<uint32_t> m_uploads;
+
+        // owner -> I/O thread.
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueWakeup;
+        std::vector<QueueEntry> m_queue;
+        std::atomic<bool> m_running{ false };
+        std::thread m_thread;
+
+        // I/O thread only.
+        std::vector<Request*> m_reading;
+        std::vector<Chunk> m_chunks;
+        std::vector<uint32_t> m_freeChunks;
+
+        // I/O thread and decode jobs -> owner.
+        std::mutex m_completedMutex;
+        std::vector<uint32_t> m_completed;
+        std::vector<uint32_t> m_completedScratch;
+        Common::JobCounter m_decodeJobs;
+
+        std::mutex m_bufferMutex;
+        std::vector<std::vector<uint8_t>> m_buffers;
+        uint64_t m_bufferBytes = 0;
+
+        std::atomic<uint64_t> m_bytesRead{ 0 };
+        std::atomic<uint64_t> m_readNanoseconds{ 0 };
+        std::chrono::steady_clock::time_point m_batchStart;
+        bool m_batchOpen = false;
+        StreamingStats m_stats;
+    };
+}
+
+#endif // ANTUTU_ASSET_ASSET_STREAMER_HPP
@@ -0,0 +1,97 @@
+/*
+ * AsyncFileReader.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Queue of positioned file reads. On Linux the reads go
+ * through an io_uring (raw syscalls, no liburing needed) so one thread can
+ * keep dozens of them in flight with a single syscall per batch. Where
+ * io_uring is missing or refused (old kernels, seccomp'd containers) and on
+ * the other platforms the same interface runs every read synchronously
+ * with pread / ReadFile when the batch is flushed.
+ *
+ * Not thread safe: one thread (the streamer's I/O thread) owns a reader.
+ */
+
+#ifndef ANTUTU_ASSET_ASYNC_FILE_READER_HPP
+#define ANTUTU_ASSET_ASYNC_FILE_READER_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace att::Asset
+{
+    // file descriptor, or HANDLE on Windows.
+    using FileHandle = intptr_t;
+    constexpr FileHandle InvalidFile = -1;
+
+    struct FileRead
+    {
+        FileHandle file;
+        uint64_t offset;
+        void* buffer;
+        uint32_t size;
+        // handed back untouched in the result.
+        uint64_t userData;
+    };
+
+    struct FileReadResult
+    {
+        uint64_t userData;
+        // bytes read (can be short), or a negative errno (Win32 error code on Windows).
+        int64_t result;
+    };
+
+    class ANTUTU_API AsyncFileReader
+    {
+    public:
+        AsyncFileReader();
+        ~AsyncFileReader();
+
+        AsyncFileReader(const AsyncFileReader&) = delete;
+        AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+        // queueDepth: reads in flight at most. allowIoUring = false forces the fallback.
+        bool Initialize(uint32_t queueDepth = 64, bool allowIoUring = true);
+        void Shutdown();
+
+        // read only, outSize receives the file size. InvalidFile on failure.
+        static FileHandle Open(const char* path, uint64_t* outSize);
+        static void Close(FileHandle file);
+
+        // false when queueDepth reads are already queued or in flight.
+        bool Submit(const FileRead& read);
+        // hands the reads queued by Submit to the kernel (or runs them, without io_uring).
+        void Flush();
+        // finished reads since the last call. With wait it blocks until at least one
+        // is available, unless nothing is in flight.
+        uint32_t Reap(FileReadResult* out, uint32_t capacity, bool wait);
+
+        uint32_t GetInFlight() const { return m_inFlight; }
+        uint32_t GetQueueDepth() const { return m_queueDepth; }
+        bool IsUsingIoUring() const { return m_ring != nullptr; }
+        const char* GetBackendName() const;
+
+    private:
+        struct Ring;
+
+        bool CreateRing(uint32_t queueDepth);
+
+        std::unique_ptr<Ring> m_ring;
+        uint32_t m_queueDepth = 0;
+        // submitted, not reaped yet.
+        uint32_t m_inFlight = 0;
+        // io_uring: entries written since the last Flush.
+        uint32_t m_unflushed = 0;
+
+        // fallback: queued by Submit, run by Flush.
+        std::vector<FileRead> m_pending;
+        std::vector<FileReadResult> m_completed;
+    };
+}
+
+#endif // ANTUTU_ASSET_ASYNC_FILE_READER_HPP
@@ -0,0 +1,38 @@
+/*
+ * Compression.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: The block codecs of the asset archive. LZ4 decodes at
+ * several GB/s per core and suits data read every load; Zstd compresses
+ * noticeably better at a few times the decode cost. Both are optional
+ * (found by CMake), an archive stored uncompressed needs neither.
+ */
+
+#ifndef ANTUTU_ASSET_COMPRESSION_HPP
+#define ANTUTU_ASSET_COMPRESSION_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Asset/ArchiveFormat.hpp>
+
+#include <cstdint>
+
+namespace att::Asset
+{
+    ANTUTU_API const char* GetCompressionName(ArchiveCompression compression);
+    // whether this build links the codec.
+    ANTUTU_API bool IsCompressionSupported(ArchiveCompression compression);
+
+    // worst case compressed size, 0 when unsupported.
+    ANTUTU_API uint64_t GetCompressBound(ArchiveCompression compression, uint64_t size);
+    // level: codec specific, 0 picks a high one (the packer runs offline). Returns the
+    // compressed size, 0 on failure.
+    ANTUTU_API uint64_t Compress(ArchiveCompression compression, const void* source, uint64_t size,
+                                 void* destination, uint64_t capacity, int level = 0);
+    // destination receives exactly rawSize bytes, anything else is a failure.
+    ANTUTU_API bool Decompress(ArchiveCompression compression, const void* source, uint64_t size,
+                               void* destination, uint64_t rawSize);
+}
+
+#endif // ANTUTU_ASSET_COMPRESSION_HPP
@@ -0,0 +1,110 @@
+/*
+ * MeshFormat.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Layout of the cooked .mesh asset the MeshCooker writes into
+ * the archive. The blob is what the GPU consumes, loading it is copying the
+ * two sections into their buffers:
+ *
+ *      CookedMeshHeader
+ *      PackedVertex[vertexCount]       16-byte aligned
+ *      indices[indexCount]             16 or 32-bit, every LOD, LOD 0 first
+ *
+ * Every LOD indexes the same vertices, ordered by first use over the LODs so
+ * the coarse ones touch a prefix of the buffer. PackedVertex is 16 bytes
+ * against 48 for float position, normal, tangent and uv:
+ *
+ *      position    R16G16B16A16_UNORM  in the mesh bounds: positionOffset + p * positionScale
+ *      normal      A2B10G10R10_UNORM   octahedral normal xy, tangent angle around
+ *                                      the normal, bitangent sign in the 2 bits
+ *      uv          R16G16_SFLOAT
+ *
+ * shaders/PackedVertex.glsl decodes it; the position transform can be folded
+ * into the model matrix instead.
+ */
+
+#ifndef ANTUTU_ASSET_MESH_FORMAT_HPP
+#define ANTUTU_ASSET_MESH_FORMAT_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace att::Asset
+{
+    constexpr uint32_t CookedMeshMagic = 0x4853454D; // "MESH"
+    constexpr uint32_t CookedMeshVersion = 1;
+    constexpr uint32_t CookedMeshMaxLods = 8;
+
+    enum CookedMeshFlags : uint32_t
+    {
+        CookedMeshIndex16 = 1 << 0,
+        // the normal's tangent bits are meaningful.
+        CookedMeshTangents = 1 << 1
+    };
+
+    struct PackedVertex
+    {
+        uint16_t position[4];
+        uint32_t normal;
+        uint16_t uv[2];
+    };
+
+    struct CookedMeshLod
+    {
+        // in indices, from the start of the index section.
+        uint32_t indexOffset;
+        uint32_t indexCount;
+        // object space distance the surface moved from LOD 0, for LOD selection.
+        float error;
+        uint32_t reserved;
+    };
+
+    struct CookedMeshHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t flags;
+        uint32_t vertexCount;
+        // of all the LODs.
+        uint32_t indexCount;
+        uint32_t lodCount;
+        float positionOffset[3];
+        float positionScale[3];
+        // center, radius.
+        float boundingSphere[4];
+        // from the start of the blob.
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        CookedMeshLod lods[CookedMeshMaxLods];
+    };
+
+    static_assert(sizeof(PackedVertex) == 16 && sizeof(CookedMeshLod) == 16, "on-disk layout");
+    static_assert(sizeof(CookedMeshHeader) == 208 && sizeof(CookedMeshHeader) % 16 == 0, "on-disk layout");
+
+    // pointers into the blob, nothing is copied.
+    struct CookedMeshView
+    {
+        const CookedMeshHeader* header = nullptr;
+        const PackedVertex* vertices = nullptr;
+        const void* indices = nullptr;
+        uint64_t vertexBytes = 0;
+        uint64_t indexBytes = 0;
+    };
+
+    // validates the header and the sections against size.
+    ANTUTU_API bool ParseCookedMesh(const void* data, uint64_t size, CookedMeshView& view);
+
+    // normal and tangent unit length, bitangent = cross(normal, tangent) * bitangentSign.
+    ANTUTU_API uint32_t PackNormalTangent(const glm::vec3& normal, const glm::vec3& tangent, float bitangentSign);
+    ANTUTU_API glm::vec3 UnpackNormal(uint32_t packed);
+    // w: bitangent sign.
+    ANTUTU_API glm::vec4 UnpackTangent(uint32_t packed);
+}
+
+#endif // ANTUTU_ASSET_MESH_FORMAT_HPP
@@ -0,0 +1,141 @@
+/*
+ * ShaderFormat.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Layout of the cooked .shader asset the ShaderCompiler
+ * writes for every shader permutation: the reflection the pipeline layout
+ * is built from, then the optimized SPIR-V.
+ *
+ *      CookedShaderHeader
+ *      CookedShaderBinding[bindingCount]           sorted by set, binding
+ *      CookedShaderVertexInput[vertexInputCount]   sorted by location
+ *      SPIR-V                                      codeOffset, 16-byte aligned
+ *
+ * Everything is read in place out of the mapped shaders.apak: no SPIR-V
+ * parsing at runtime, the code pointer goes to vkCreateShaderModule as is.
+ * The stage and descriptor type values are the Vulkan ones, the vertex
+ * input formats are VkFormat values of the shader side types.
+ */
+
+#ifndef ANTUTU_ASSET_SHADER_FORMAT_HPP
+#define ANTUTU_ASSET_SHADER_FORMAT_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <cstdint>
+
+namespace att::Asset
+{
+    constexpr uint32_t CookedShaderMagic = 0x52445341; // "ASDR"
+    constexpr uint32_t CookedShaderVersion = 1;
+    constexpr uint32_t CookedShaderMaxEntryPoint = 32;
+
+    // VkShaderStageFlagBits.
+    enum ShaderStage : uint32_t
+    {
+        ShaderStageVertex = 0x1,
+        ShaderStageTessControl = 0x2,
+        ShaderStageTessEvaluation = 0x4,
+        ShaderStageGeometry = 0x8,
+        ShaderStageFragment = 0x10,
+        ShaderStageCompute = 0x20,
+        ShaderStageTask = 0x40,
+        ShaderStageMesh = 0x80,
+        ShaderStageRayGen = 0x100,
+        ShaderStageAnyHit = 0x200,
+        ShaderStageClosestHit = 0x400,
+        ShaderStageMiss = 0x800,
+        ShaderStageIntersection = 0x1000,
+        ShaderStageCallable = 0x2000
+    };
+
+    // VkDescriptorType.
+    enum class ShaderDescriptorType : uint32_t
+    {
+        Sampler = 0,
+        CombinedImageSampler = 1,
+        SampledImage = 2,
+        StorageImage = 3,
+        UniformTexelBuffer = 4,
+        StorageTexelBuffer = 5,
+        UniformBuffer = 6,
+        StorageBuffer = 7,
+        InputAttachment = 10,
+        AccelerationStructure = 1000150000
+    };
+
+    enum CookedShaderFlags : uint32_t
+    {
+        // float math marked RelaxedPrecision (fragment shaders, ANTUTU_SHADER_FULL_PRECISION off).
+        CookedShaderRelaxedPrecision = 1 << 0
+    };
+
+    struct CookedShaderBinding
+    {
+        uint32_t set;
+        uint32_t binding;
+        ShaderDescriptorType type;
+        // array size, 0 for a runtime sized array.
+        uint32_t count;
+    };
+
+    struct CookedShaderVertexInput
+    {
+        uint32_t location;
+        // VkFormat, 32-bit or 16-bit components as declared.
+        uint32_t format;
+    };
+
+    struct CookedShaderHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        // one ShaderStage bit.
+        uint32_t stage;
+        uint32_t flags;
+        // source, includes, defines and compiler: the up-to-date check of the build.
+        uint64_t sourceHash;
+        // compute, task and mesh stages, 0 otherwise.
+        uint32_t localSize[3];
+        // the push constant block, size 0 when there is none.
+        uint32_t pushConstantOffset;
+        uint32_t pushConstantSize;
+        uint32_t bindingCount;
+        // vertex stage only.
+        uint32_t vertexInputCount;
+        // from the start of the blob, in bytes.
+        uint32_t codeOffset;
+        uint32_t codeSize;
+        uint32_t reserved;
+        // null terminated.
+        char entryPoint[CookedShaderMaxEntryPoint];
+    };
+
+    static_assert(sizeof(CookedShaderBinding) == 16 && sizeof(CookedShaderVertexInput) == 8, "on-disk layout");
+    static_assert(sizeof(CookedShaderHeader) == 96, "on-disk layout");
+
+    inline const CookedShaderBinding* GetShaderBindings(const CookedShaderHeader& header)
+    {
+        return reinterpret_cast<const CookedShaderBinding*>(&header + 1);
+    }
+
+    inline const CookedShaderVertexInput* GetShaderVertexInputs(const CookedShaderHeader& header)
+    {
+        return reinterpret_cast<const CookedShaderVertexInput*>(GetShaderBindings(header) + header.bindingCount);
+    }
+
+    inline const uint32_t* GetShaderCode(const CookedShaderHeader& header)
+    {
+        return reinterpret_cast<const uint32_t*>(reinterpret_cast<const uint8_t*>(&header) + header.codeOffset);
+    }
+
+    ANTUTU_API const char* GetShaderStageName(uint32_t stage);
+
+    // validates the header, the tables and the SPIR-V magic; data must be 16-byte aligned
+    // (archive blobs are).
+    ANTUTU_API const CookedShaderHeader* ParseCookedShader(const void* data, uint64_t size);
+}
+
+#endif // ANTUTU_ASSET_SHADER_FORMAT_HPP
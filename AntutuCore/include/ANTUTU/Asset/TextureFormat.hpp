@@ -0,0 +1,107 @@
+/*
+ * TextureFormat.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Layout of the cooked .tex asset the TextureCooker writes
+ * into the archive. The mips are stored tail first, smallest first:
+ *
+ *      CookedTextureHeader
+ *      mip[mipCount - 1] ... mip[tailMip]      the packed tail, read with the header
+ *      mip[tailMip - 1]                        16-byte aligned
+ *      ...
+ *      mip[0]                                  full resolution, last
+ *
+ * so the first read of a texture (header and tail, a few KB) gives a
+ * complete low resolution texture, and every finer mip is one contiguous
+ * range the TextureStreamer reads when the screen asks for it. Archive
+ * entries are meant to be stored uncompressed for that: a range of a
+ * compressed entry costs the decompression of the whole entry.
+ *
+ * The blocks are the GPU's, uploads are copies: BC1/BC3/BC5/BC7 on
+ * desktop, ASTC 4x4 on mobile.
+ */
+
+#ifndef ANTUTU_ASSET_TEXTURE_FORMAT_HPP
+#define ANTUTU_ASSET_TEXTURE_FORMAT_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <cstdint>
+
+namespace att::Asset
+{
+    constexpr uint32_t CookedTextureMagic = 0x58455441; // "ATEX"
+    constexpr uint32_t CookedTextureVersion = 1;
+    // 32768 x 32768.
+    constexpr uint32_t CookedTextureMaxMips = 16;
+    // mips this size and smaller are the packed tail.
+    constexpr uint32_t CookedTextureTailSize = 128;
+
+    enum class TextureFormat : uint32_t
+    {
+        RGBA8,
+        RGBA8Srgb,
+        BC1,
+        BC1Srgb,
+        BC3,
+        BC3Srgb,
+        // two channels, normal maps: z = sqrt(1 - x^2 - y^2).
+        BC5,
+        BC7,
+        BC7Srgb,
+        ASTC4x4,
+        ASTC4x4Srgb,
+        Count
+    };
+
+    enum CookedTextureFlags : uint32_t
+    {
+        // the alpha channel isn't all 255.
+        CookedTextureAlpha = 1 << 0,
+        CookedTextureNormalMap = 1 << 1
+    };
+
+    struct CookedTextureMip
+    {
+        // from the start of the blob.
+        uint64_t offset;
+        uint32_t size;
+        uint16_t width;
+        uint16_t height;
+    };
+
+    struct CookedTextureHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        TextureFormat format;
+        uint32_t flags;
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipCount;
+        // first mip of the packed tail.
+        uint32_t tailMip;
+        // header and packed tail: the first read.
+        uint64_t tailSize;
+        uint64_t reserved;
+        CookedTextureMip mips[CookedTextureMaxMips];
+    };
+
+    static_assert(sizeof(CookedTextureMip) == 16, "on-disk layout");
+    static_assert(sizeof(CookedTextureHeader) == 304 && sizeof(CookedTextureHeader) % 16 == 0, "on-disk layout");
+
+    // 4x4 blocks for the compressed formats, single pixels for RGBA8.
+    ANTUTU_API uint32_t GetTextureBlockSize(TextureFormat format);
+    ANTUTU_API uint32_t GetTextureBlockBytes(TextureFormat format);
+    ANTUTU_API uint64_t GetTextureMipBytes(TextureFormat format, uint32_t width, uint32_t height);
+    ANTUTU_API bool IsTextureFormatSrgb(TextureFormat format);
+    ANTUTU_API const char* GetTextureFormatName(TextureFormat format);
+
+    // validates the header and the mip layout; the data must hold the packed tail at
+    // least, the finer mips may be beyond size when only the start of the blob was read.
+    ANTUTU_API const CookedTextureHeader* ParseCookedTexture(const void* data, uint64_t size);
+}
+
+#endif // ANTUTU_ASSET_TEXTURE_FORMAT_HPP
@@ -0,0 +1,205 @@
+/*
+ * TextureStreamer.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Mip streaming of cooked .tex assets (TextureFormat.hpp) on
+ * top of the AssetStreamer. Opening a texture reads its header and packed
+ * tail, one small read that makes it usable at low resolution right away;
+ * the finer mips are then read one range at a time, coarse to fine, as far
+ * as the screen asks for.
+ *
+ * The renderer reports each frame how large every texture it draws is on
+ * screen, in pixels along the texture's larger axis (the projected size of
+ * the object times the UV density), or the mip a GPU feedback pass found:
+ * the mip it needs is log2(texture size / screen size). Mips asked for are
+ * loaded by the gap to what is resident, largest first; mips nobody asked
+ * for during keepFrames are dropped again; and when the streamed mips go
+ * over the memory budget, the textures with the most detail to spare give
+ * their finest mip up to the ones that need it more.
+ *
+ * The GPU side stays with the callbacks. A texture is created with its full
+ * chain and made partially resident: with sparse residency only the mips
+ * from the resident one are bound, otherwise the memory is there and the
+ * sampler (or view) min LOD is clamped to the resident mip, which is what
+ * hides the mips that haven't arrived yet.
+ *
+ *      m_textures.Initialize(m_streamer, AssetType::TextureMip, { &Create, &Upload, &Evict, &Destroy, this });
+ *      const TextureHandle rock = m_textures.Open("textures/rock.tex");
+ *      ...
+ *      m_textures.ReportScreenSize(rock, projectedPixels);    // while drawing
+ *      m_streamer.Update();
+ *      m_textures.Update();                                    // once per frame, after the streamer
+ */
+
+#ifndef ANTUTU_ASSET_TEXTURE_STREAMER_HPP
+#define ANTUTU_ASSET_TEXTURE_STREAMER_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Asset/AssetStreamer.hpp>
+#include <ANTUTU/Asset/TextureFormat.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace att::Asset
+{
+    // low 32 bits: slot, high 32 bits: generation.
+    using TextureHandle = uint64_t;
+    constexpr TextureHandle InvalidTexture = 0;
+
+    // owner thread, from the streamer's Update (within its upload budget) or Update here.
+    struct TextureStreamingCallbacks
+    {
+        // the header and packed tail are in: creates the texture with all mipCount mips,
+        // resident from tailMip on. Returns the texture, nullptr on failure.
+        void* (*create)(void* context, const CookedTextureHeader& header) = nullptr;
+        // one mip's blocks, the mip becomes the finest resident one. Returns the bytes uploaded.
+        uint64_t (*upload)(void* context, void* texture, uint32_t mip, const uint8_t* data, uint64_t size) = nullptr;
+        // the mips finer than residentMip aren't resident any more: unbind them / clamp the min LOD.
+        void (*evict)(void* context, void* texture, uint32_t residentMip) = nullptr;
+        void (*destroy)(void* context, void* texture) = nullptr;
+        void* context = nullptr;
+    };
+
+    struct TextureStreamerConfig
+    {
+        // the streamed mips, the packed tails don't count.
+        uint64_t memoryBudget = 256ull << 20;
+        // mip reads in flight.
+        uint32_t maxRequests = 16;
+        // a mip nobody asked for during that many frames is dropped.
+        uint32_t keepFrames = 60;
+        // added to the mip the screen size gives, > 0 trades detail for memory.
+        float mipBias = 0.0f;
+    };
+
+    struct TextureStreamingStats
+    {
+        uint32_t textures = 0;
+        // streamed mips resident.
+        uint64_t residentBytes = 0;
+        uint32_t requests = 0;
+        uint32_t requestsInFlight = 0;
+        uint32_t evictions = 0;
+        // textures with fewer mips resident than wanted, the budget or the reads are behind.
+        uint32_t starved = 0;
+    };
+
+    class ANTUTU_API TextureStreamer
+    {
+    public:
+        TextureStreamer() = default;
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        // registers the loader of assetType, a type of its own for the mip reads.
+        void Initialize(AssetStreamer& streamer, uint32_t assetType, const TextureStreamingCallbacks& callbacks,
+                        const TextureStreamerConfig& config = {});
+        // destroys every texture, before the AssetStreamer shuts down.
+        void Shutdown();
+
+        // everything below is for the owner thread of the AssetStreamer.
+
+        // priority: of the header read, and the weight of this texture's mip requests.
+        TextureHandle Open(const std::string& path, float priority = 1.0f);
+        void Close(TextureHandle handle);
+
+        // the texture's on-screen size in pixels along its larger axis, the largest of the
+        // frame counts.
+        void ReportScreenSize(TextureHandle handle, float pixels);
+        // the mip a GPU feedback pass asked for, the finest of the frame counts.
+        void ReportMip(TextureHandle handle, uint32_t mip);
+
+        // once per frame, after AssetStreamer::Update: eviction, then the next mip reads.
+        void Update();
+
+        // nullptr until the header and tail are in, or when the texture failed.
+        void* GetTexture(TextureHandle handle) const;
+        const CookedTextureHeader* GetHeader(TextureHandle handle) const;
+        // finest resident mip, CookedTextureMaxMips before the tail is in.
+        uint32_t GetResidentMip(TextureHandle handle) const;
+        uint32_t GetWantedMip(TextureHandle handle) const;
+
+        const TextureStreamingStats& GetStats() const { return m_stats; }
+
+    private:
+        enum class TextureState : uint8_t
+        {
+            None,
+            LoadingHead,
+            Ready,
+            Failed
+        };
+
+        struct Texture
+        {
+            std::string path;
+            uint32_t generation = 1;
+            TextureState state = TextureState::None;
+            float priority = 1.0f;
+            CookedTextureHeader header = {};
+            void* texture = nullptr;
+            uint32_t residentMip = CookedTextureMaxMips;
+            // bytes of the mips finer than the tail.
+            uint64_t residentBytes = 0;
+
+            // the read in flight, header or mip.
+            AssetHandle pending = InvalidAsset;
+            uint32_t pendingMip = 0;
+            // the first read didn't hold the whole tail, the next one does.
+            bool headIncomplete = false;
+            // the finest mip that can be read, the one before it failed.
+            uint32_t minMip = 0;
+
+            // finest mip asked for this frame, and the one kept over keepFrames.
+            uint32_t frameMip = CookedTextureMaxMips;
+            uint32_t wantedMip = CookedTextureMaxMips;
+            uint64_t wantedFrame = 0;
+        };
+
+        // what a read hands from the decode job to the upload callback.
+        struct StreamedData
+        {
+            uint32_t slot;
+            uint32_t generation;
+            uint32_t mip;
+            std::vector<uint8_t> bytes;
+        };
+
+        Texture* Find(TextureHandle handle) const;
+        void Poll(Texture& texture);
+        void UpdateWanted(Texture& texture);
+        // drops the finest streamed mip.
+        void EvictOne(Texture& texture);
+        // evicts for a mip of `bytes` wanted by a texture with that score (mips short times priority).
+        bool MakeRoom(uint64_t bytes, float score, const Texture& requester);
+        void Destroy(Texture& texture);
+
+        static void* DecodeRead(void* context, const uint8_t* data, uint64_t size, uint64_t settings);
+        static uint64_t UploadRead(void* context, void* asset);
+        static void ReleaseRead(void* context, void* asset);
+        uint64_t Upload(StreamedData& data);
+
+        AssetStreamer* m_streamer = nullptr;
+        uint32_t m_assetType = 0;
+        TextureStreamingCallbacks m_callbacks;
+        TextureStreamerConfig m_config;
+        uint64_t m_frame = 0;
+
+        std::vector<Texture> m_textures;
+        std::vector<uint32_t> m_freeSlots;
+        // of the mip reads in flight.
+        uint64_t m_pendingBytes = 0;
+        // scratch of Update: (score, slot) of the textures short of their wanted mip.
+        std::vector<std::pair<float, uint32_t>> m_candidates;
+        TextureStreamingStats m_stats;
+    };
+}
+
+#endif // ANTUTU_ASSET_TEXTURE_STREAMER_HPP
@@ -0,0 +1,113 @@
+/*
+ * Archetype.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Storage of every entity with the same set of components.
+ * Rows live in 16 KB chunks laid out as structure of arrays: the entity
+ * column first, then one 64 byte aligned column per component, sorted by
+ * id. Every chunk but the last is full, removing a row moves the last row
+ * of the archetype into the hole, so iteration never sees gaps.
+ */
+
+#ifndef ANTUTU_ECS_ARCHETYPE_HPP
+#define ANTUTU_ECS_ARCHETYPE_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/ECS/Component.hpp>
+#include <ANTUTU/ECS/Entity.hpp>
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace att::ECS
+{
+    constexpr uint32_t ChunkSize = 16 * 1024;
+    constexpr uint32_t ChunkColumnAlignment = 64;
+
+    struct Chunk
+    {
+        std::byte* data = nullptr;
+        uint32_t count = 0;
+        // per column, the world version of the last write. Structural changes and queries
+        // with write access stamp it, Changed<T> filters compare against it.
+        std::vector<uint32_t> versions;
+    };
+
+    // recycles chunk memory between archetypes.
+    class ANTUTU_API ChunkPool
+    {
+    public:
+        ChunkPool() = default;
+        ~ChunkPool();
+
+        ChunkPool(const ChunkPool&) = delete;
+        ChunkPool& operator=(const ChunkPool&) = delete;
+
+        std::byte* Acquire();
+        void Release(std::byte* data);
+
+    private:
+        std::vector<std::byte*> m_free;
+    };
+
+    struct RowLocation
+    {
+        uint32_t chunk;
+        uint32_t row;
+    };
+
+    class ANTUTU_API Archetype
+    {
+    public:
+        // components sorted by id, without duplicates.
+        explicit Archetype(std::vector<ComponentInfo> components);
+        ~Archetype() = default;
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        const std::vector<ComponentId>& GetSignature() const { return m_signature; }
+        const ComponentInfo& GetColumnInfo(uint32_t column) const { return m_components[column]; }
+        uint32_t GetColumnCount() const { return static_cast<uint32_t>(m_components.size()); }
+
+        // -1 when the archetype doesn't have the component.
+        int32_t FindColumn(ComponentId id) const;
+        bool Has(ComponentId id) const { return FindColumn(id) >= 0; }
+
+        // rows per chunk.
+        uint32_t GetCapacity() const { return m_capacity; }
+        uint32_t GetEntityCount() const { return m_entityCount; }
+
+        std::vector<Chunk>& GetChunks() { return m_chunks; }
+        const std::vector<Chunk>& GetChunks() const { return m_chunks; }
+
+        Entity* GetEntities(const Chunk& chunk) const { return reinterpret_cast<Entity*>(chunk.data); }
+        std::byte* GetColumn(const Chunk& chunk, uint32_t column) const { return chunk.data + m_offsets[column]; }
+        std::byte* GetComponentData(const Chunk& chunk, uint32_t column, uint32_t row) const
+        {
+            return GetColumn(chunk, column) + static_cast<size_t>(row) * m_components[column].size;
+        }
+
+        // World only: rows are added at the end, the component data is left to the caller.
+        RowLocation AllocateRow(Entity entity, ChunkPool& pool, uint32_t version);
+        // moves the last row into the hole; returns the entity that moved, NullEntity if none did.
+        Entity RemoveRow(RowLocation location, ChunkPool& pool, uint32_t version);
+
+        // cached transitions, owned by the World.
+        std::unordered_map<ComponentId, Archetype*> addEdges;
+        std::unordered_map<ComponentId, Archetype*> removeEdges;
+
+    private:
+        std::vector<ComponentInfo> m_components;
+        std::vector<ComponentId> m_signature;
+        std::vector<uint32_t> m_offsets;
+        uint32_t m_capacity = 0;
+        uint32_t m_entityCount = 0;
+        std::vector<Chunk> m_chunks;
+    };
+}
+
+#endif // ANTUTU_ECS_ARCHETYPE_HPP
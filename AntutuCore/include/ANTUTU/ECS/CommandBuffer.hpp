@@ -0,0 +1,186 @@
+/*
+ * CommandBuffer.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Deferred structural changes. Systems running on worker
+ * threads record create / destroy / add / remove into their thread's
+ * CommandBuffer (plain arena memory, no locks) and the CommandQueue plays
+ * them back into the World at a sync point.
+ *
+ * Playback first folds the commands of each entity into a single final
+ * archetype, so an entity moves at most once, then sorts the entities by
+ * (source, destination) archetype so rows moving between the same pair of
+ * archetypes are moved together. Entities created in a buffer go straight
+ * into their final archetype.
+ */
+
+#ifndef ANTUTU_ECS_COMMAND_BUFFER_HPP
+#define ANTUTU_ECS_COMMAND_BUFFER_HPP
+
+#include <ANTUTU/ECS/World.hpp>
+
+namespace att::ECS
+{
+    class ANTUTU_API CommandBuffer
+    {
+    public:
+        // placeholder entities: valid in this buffer only, until playback creates them,
+        // CommandQueue::Resolve gives the real entity afterwards.
+        static constexpr uint32_t PlaceholderBit = 0x80000000u;
+        static constexpr uint32_t BlockSize = 64 * 1024;
+
+        enum class CommandType : uint8_t
+        {
+            Create,
+            Destroy,
+            Add,
+            Remove
+        };
+
+        // one record in the arena, the component bytes follow it.
+        struct Command
+        {
+            CommandType type;
+            Entity entity;
+            ComponentInfo info;
+        };
+
+        explicit CommandBuffer(uint32_t id) : m_id(id) {}
+        ~CommandBuffer();
+
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        static bool IsPlaceholder(Entity entity) { return (entity.index & PlaceholderBit) != 0; }
+
+        Entity Create();
+
+        template<Component... Ts>
+        Entity Create(const Ts&... components)
+        {
+            const Entity entity = Create();
+            (Add(entity, components), ...);
+            return entity;
+        }
+
+        void Destroy(Entity entity);
+
+        template<Component T>
+        void Add(Entity entity, const T& value = T{})
+        {
+            RegisterComponent<T>();
+            const ComponentInfo info = GetComponentInfo<T>();
+            AddComponent(entity, info, &value);
+        }
+
+        template<Component T>
+        void Remove(Entity entity) { RemoveComponent(entity, T::ComponentId); }
+
+        void AddComponent(Entity entity, const ComponentInfo& info, const void* data);
+        void RemoveComponent(Entity entity, ComponentId id);
+
+        uint32_t GetId() const { return m_id; }
+        uint32_t GetCommandCount() const { return m_commandCount; }
+        bool IsEmpty() const { return m_commandCount == 0; }
+
+        // fn(const Command&, const std::byte* data) in recording order.
+        template<typename Fn>
+        void ForEach(Fn&& fn) const
+        {
+            for (size_t block = 0; block < m_blocks.size() && block <= m_currentBlock; block++)
+            {
+                const std::byte* cursor = m_blocks[block];
+                const std::byte* end = cursor + (block == m_currentBlock ? m_offset : m_blockEnds[block]);
+                while (cursor < end)
+                {
+                    const Command* command = reinterpret_cast<const Command*>(cursor);
+                    fn(*command, cursor + sizeof(Command));
+                    cursor += RecordSize(command->info.size);
+                }
+            }
+        }
+
+        // keeps the arena blocks for the next frame.
+        void Clear();
+
+    private:
+        static size_t RecordSize(uint32_t dataSize)
+        {
+            return (sizeof(Command) + dataSize + 15) & ~size_t(15);
+        }
+
+        std::byte* Push(CommandType type, Entity entity, const ComponentInfo& info);
+
+        uint32_t m_id;
+        uint32_t m_nextPlaceholder = 0;
+        uint32_t m_commandCount = 0;
+
+        std::vector<std::byte*> m_blocks;
+        std::vector<size_t> m_blockEnds;
+        size_t m_currentBlock = 0;
+        size_t m_offset = 0;
+    };
+
+    // one CommandBuffer per recording thread, played back together.
+    class ANTUTU_API CommandQueue
+    {
+    public:
+        static constexpr uint32_t MaxThreads = 64;
+
+        CommandQueue() = default;
+        ~CommandQueue();
+
+        CommandQueue(const CommandQueue&) = delete;
+        CommandQueue& operator=(const CommandQueue&) = delete;
+
+        // the calling thread's buffer, created on first use. Its slot is recycled when
+        // the thread exits, more than MaxThreads threads recording at once aborts.
+        CommandBuffer& GetLocal();
+
+        // sync point: applies and clears every buffer. Not thread safe, nothing may record
+        // or iterate the world meanwhile.
+        void Playback(World& world);
+
+        // the entity the last Playback created for a placeholder, NullEntity when it was
+        // destroyed in the same frame (or isn't from that playback). Real entities pass through.
+        Entity Resolve(Entity placeholder) const;
+
+    private:
+        struct EntityPlan
+        {
+            uint64_t key;
+            Entity entity;
+            Archetype* from;
+            Archetype* to;
+            bool destroyed;
+            uint32_t firstCommand;
+            uint32_t commandCount;
+        };
+
+        struct PendingCommand
+        {
+            uint64_t key;
+            uint32_t sequence;
+            const CommandBuffer::Command* command;
+            const std::byte* data;
+        };
+
+        struct CreatedEntity
+        {
+            uint64_t key;
+            Entity entity;
+        };
+
+        std::atomic<CommandBuffer*> m_buffers[MaxThreads] = {};
+
+        // reused by every playback.
+        std::vector<PendingCommand> m_pending;
+        std::vector<EntityPlan> m_plans;
+        // placeholders of the last playback, sorted by key.
+        std::vector<CreatedEntity> m_created;
+    };
+}
+
+#endif // ANTUTU_ECS_COMMAND_BUFFER_HPP
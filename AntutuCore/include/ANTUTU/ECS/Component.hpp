@@ -0,0 +1,97 @@
+/*
+ * Component.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Component ids and signatures. A component is a plain struct
+ * tagged with ATT_COMPONENT, its id is a hash of the name so signatures are
+ * known at compile time and no RTTI is needed:
+ *
+ *     struct Velocity { ATT_COMPONENT(Velocity); glm::vec3 value; };
+ *
+ * Components are moved between chunks with memcpy, so they must be
+ * trivially copyable.
+ */
+
+#ifndef ANTUTU_ECS_COMPONENT_HPP
+#define ANTUTU_ECS_COMPONENT_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+#define ATT_COMPONENT(name)                                                                   \
+    static constexpr att::ECS::ComponentId ComponentId = att::ECS::HashComponentName(#name); \
+    static constexpr const char* ComponentName = #name
+
+namespace att::ECS
+{
+    using ComponentId = uint32_t;
+
+    // FNV-1a, the same in every module and build.
+    constexpr ComponentId HashComponentName(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (; *name != '\0'; name++)
+        {
+            hash ^= static_cast<uint8_t>(*name);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    concept Component = std::is_trivially_copyable_v<T>
+        && std::is_default_constructible_v<T>
+        && requires { { T::ComponentId } -> std::convertible_to<ComponentId>; };
+
+    struct ComponentInfo
+    {
+        ComponentId id;
+        uint32_t size;
+        uint32_t alignment;
+        const char* name;
+    };
+
+    template<Component T>
+    constexpr ComponentInfo GetComponentInfo()
+    {
+        return { T::ComponentId, static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(alignof(T)), T::ComponentName };
+    }
+
+    // debug registry of id -> (name, size): false, and an assert, when another component
+    // already has this id.
+    ANTUTU_API bool RegisterComponentInfo(const ComponentInfo& info);
+
+    // once per type in debug builds, called where components enter or leave the ECS.
+    template<Component T>
+    inline void RegisterComponent()
+    {
+#ifndef NDEBUG
+        [[maybe_unused]] static const bool registered = RegisterComponentInfo(GetComponentInfo<T>());
+#endif
+    }
+
+    // sorted ids of a component list, the archetype signature order.
+    template<Component... Ts>
+    constexpr std::array<ComponentId, sizeof...(Ts)> GetSortedIds()
+    {
+        std::array<ComponentId, sizeof...(Ts)> ids = { Ts::ComponentId... };
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    template<Component... Ts>
+    constexpr bool HasUniqueComponents()
+    {
+        constexpr auto ids = GetSortedIds<Ts...>();
+        return std::adjacent_find(ids.begin(), ids.end()) == ids.end();
+    }
+}
+
+#endif // ANTUTU_ECS_COMPONENT_HPP
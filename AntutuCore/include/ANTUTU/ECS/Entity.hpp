@@ -0,0 +1,31 @@
+/*
+ * Entity.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Entity handle of the ECS. The index addresses the World's
+ * entity records, the generation tells a destroyed entity from the one that
+ * reuses its index.
+ */
+
+#ifndef ANTUTU_ECS_ENTITY_HPP
+#define ANTUTU_ECS_ENTITY_HPP
+
+#include <cstdint>
+
+namespace att::ECS
+{
+    struct Entity
+    {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool IsValid() const { return index != UINT32_MAX; }
+        bool operator==(const Entity&) const = default;
+    };
+
+    constexpr Entity NullEntity{};
+}
+
+#endif // ANTUTU_ECS_ENTITY_HPP
@@ -0,0 +1,348 @@
+/*
+ * Query.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Iteration over every archetype holding a set of components.
+ * The component list is the access declaration: `const T` is read only,
+ * `T` is read / write and stamps the chunk column with a new change version.
+ *
+ *     Query<const Velocity, Position> query(world);
+ *     query.ParallelEach([dt](const Velocity& v, Position& p) { p.value += v.value * dt; });
+ *
+ * Matching archetypes are cached and only new archetypes are checked on the
+ * next run. The per row loops work on raw column pointers so the compiler
+ * can vectorize them; the parallel variants split the work by chunk over
+ * the Common job system.
+ */
+
+#ifndef ANTUTU_ECS_QUERY_HPP
+#define ANTUTU_ECS_QUERY_HPP
+
+#include <ANTUTU/ECS/World.hpp>
+#include <Common/Job/JobSystem.h>
+
+#include <array>
+#include <tuple>
+#include <utility>
+
+namespace att::ECS
+{
+    namespace Detail
+    {
+        template<typename T, typename... Ts>
+        constexpr size_t IndexOfComponent()
+        {
+            constexpr bool matches[] = { std::is_same_v<T, std::remove_const_t<Ts>>..., false };
+            for (size_t i = 0; i < sizeof...(Ts); i++)
+            {
+                if (matches[i])
+                {
+                    return i;
+                }
+            }
+            return sizeof...(Ts);
+        }
+    }
+
+    template<typename... Ts>
+    class ChunkView
+    {
+    public:
+        static constexpr size_t ComponentCount = sizeof...(Ts);
+
+        uint32_t Count() const { return m_chunk->count; }
+        const Entity* Entities() const { return m_entities; }
+
+        // column of the I-th component of the query, const when declared read only.
+        template<size_t I>
+        std::tuple_element_t<I, std::tuple<Ts...>>* Column() const
+        {
+            return reinterpret_cast<std::tuple_element_t<I, std::tuple<Ts...>>*>(m_columns[I]);
+        }
+
+        template<Component T>
+        auto* Get() const
+        {
+            constexpr size_t index = Detail::IndexOfComponent<T, Ts...>();
+            static_assert(index < ComponentCount, "the query doesn't have this component");
+            return Column<index>();
+        }
+
+        // true when the component was written after `version`.
+        template<Component T>
+        bool ChangedSince(uint32_t version) const
+        {
+            constexpr size_t index = Detail::IndexOfComponent<T, Ts...>();
+            static_assert(index < ComponentCount, "the query doesn't have this component");
+            return m_chunk->versions[m_columnIndices[index]] > version;
+        }
+
+    private:
+        template<typename...>
+        friend class Query;
+
+        const Chunk* m_chunk = nullptr;
+        const Entity* m_entities = nullptr;
+        std::byte* m_columns[ComponentCount > 0 ? ComponentCount : 1] = {};
+        const uint32_t* m_columnIndices = nullptr;
+    };
+
+    template<typename... Ts>
+    class Query
+    {
+        static_assert((Component<std::remove_const_t<Ts>> && ...), "query types must be components");
+        static_assert(HasUniqueComponents<std::remove_const_t<Ts>...>(), "a component appears twice");
+
+    public:
+        using View = ChunkView<Ts...>;
+
+        static constexpr size_t ComponentCount = sizeof...(Ts);
+        static constexpr std::array<ComponentId, ComponentCount> Ids = { std::remove_const_t<Ts>::ComponentId... };
+        static constexpr std::array<bool, ComponentCount> Writes = { !std::is_const_v<Ts>... };
+        static constexpr bool HasWrites = (!std::is_const_v<Ts> || ...);
+
+        explicit Query(World& world) : m_world(world)
+        {
+            (RegisterComponent<std::remove_const_t<Ts>>(), ...);
+        }
+
+        // skips archetypes that have T.
+        template<Component T>
+        Query& Without()
+        {
+            m_excluded.push_back(T::ComponentId);
+            ResetMatches();
+            return *this;
+        }
+
+        // only visits chunks where T was written since this query last ran.
+        template<Component T>
+        Query& Changed()
+        {
+            m_changed.push_back(T::ComponentId);
+            ResetMatches();
+            return *this;
+        }
+
+        // declared access, for the scheduler.
+        static void GetAccess(std::vector<ComponentId>& reads, std::vector<ComponentId>& writes)
+        {
+            for (size_t i = 0; i < ComponentCount; i++)
+            {
+                (Writes[i] ? writes : reads).push_back(Ids[i]);
+            }
+        }
+
+        World& GetWorld() const { return m_world; }
+
+        // entities in the matched archetypes, filters other than Without are ignored.
+        uint32_t Count()
+        {
+            UpdateMatches();
+            uint32_t count = 0;
+            for (const Match& match : m_matched)
+            {
+                count += match.archetype->GetEntityCount();
+            }
+            return count;
+        }
+
+        // fn(const View&)
+        template<typename Fn>
+        void EachChunk(Fn&& fn)
+        {
+            const uint32_t version = Begin();
+            for (const Match& match : m_matched)
+            {
+                for (Chunk& chunk : match.archetype->GetChunks())
+                {
+                    if (Accept(match, chunk))
+                    {
+                        Stamp(match, chunk, version);
+                        fn(MakeView(match, chunk));
+                    }
+                }
+            }
+            m_lastRunVersion = version;
+        }
+
+        // fn(Ts&...) or fn(Entity, Ts&...)
+        template<typename Fn>
+        void Each(Fn&& fn)
+        {
+            EachChunk([&fn](const View& view) { RunRows(view, fn, std::index_sequence_for<Ts...>{}); });
+        }
+
+        // chunks are handed to the job system in batches of `chunksPerJob`, fn must be thread safe.
+        template<typename Fn>
+        void ParallelEachChunk(Fn&& fn, uint32_t chunksPerJob = 1)
+        {
+            const uint32_t version = Begin();
+            m_work.clear();
+            for (const Match& match : m_matched)
+            {
+                for (Chunk& chunk : match.archetype->GetChunks())
+                {
+                    if (Accept(match, chunk))
+                    {
+                        Stamp(match, chunk, version);
+                        m_work.push_back({ &match, &chunk });
+                    }
+                }
+            }
+
+            Common::JobSystem::Get().ParallelFor(static_cast<uint32_t>(m_work.size()), chunksPerJob,
+                [this, &fn](uint32_t begin, uint32_t end)
+                {
+                    for (uint32_t i = begin; i < end; i++)
+                    {
+                        fn(MakeView(*m_work[i].match, *m_work[i].chunk));
+                    }
+                });
+            m_lastRunVersion = version;
+        }
+
+        template<typename Fn>
+        void ParallelEach(Fn&& fn, uint32_t chunksPerJob = 1)
+        {
+            ParallelEachChunk([&fn](const View& view) { RunRows(view, fn, std::index_sequence_for<Ts...>{}); }, chunksPerJob);
+        }
+
+    private:
+        struct Match
+        {
+            Archetype* archetype;
+            std::array<uint32_t, ComponentCount> columns;
+            std::vector<uint32_t> changedColumns;
+        };
+
+        struct WorkItem
+        {
+            const Match* match;
+            Chunk* chunk;
+        };
+
+        template<typename Fn, size_t... I>
+        static void RunRows(const View& view, Fn& fn, std::index_sequence<I...>)
+        {
+            const auto columns = std::make_tuple(view.template Column<I>()...);
+            const uint32_t count = view.Count();
+            if constexpr (std::is_invocable_v<Fn&, Entity, Ts&...>)
+            {
+                const Entity* entities = view.Entities();
+                for (uint32_t row = 0; row < count; row++)
+                {
+                    fn(entities[row], std::get<I>(columns)[row]...);
+                }
+            }
+            else
+            {
+                for (uint32_t row = 0; row < count; row++)
+                {
+                    fn(std::get<I>(columns)[row]...);
+                }
+            }
+        }
+
+        void ResetMatches()
+        {
+            m_matched.clear();
+            m_matchedCount = 0;
+        }
+
+        void UpdateMatches()
+        {
+            const auto& archetypes = m_world.GetArchetypes();
+            for (; m_matchedCount < archetypes.size(); m_matchedCount++)
+            {
+                Archetype* archetype = archetypes[m_matchedCount].get();
+
+                Match match{ archetype, {}, {} };
+                bool matches = true;
+                for (size_t i = 0; i < ComponentCount && matches; i++)
+                {
+                    const int32_t column = archetype->FindColumn(Ids[i]);
+                    matches = column >= 0;
+                    match.columns[i] = static_cast<uint32_t>(column);
+                }
+                for (ComponentId excluded : m_excluded)
+                {
+                    matches = matches && !archetype->Has(excluded);
+                }
+                for (ComponentId changed : m_changed)
+                {
+                    const int32_t column = archetype->FindColumn(changed);
+                    matches = matches && column >= 0;
+                    match.changedColumns.push_back(static_cast<uint32_t>(column));
+                }
+
+                if (matches)
+                {
+                    m_matched.push_back(std::move(match));
+                }
+            }
+        }
+
+        uint32_t Begin()
+        {
+            UpdateMatches();
+            return HasWrites ? m_world.IncrementVersion() : m_world.GetVersion();
+        }
+
+        bool Accept(const Match& match, const Chunk& chunk) const
+        {
+            if (chunk.count == 0)
+            {
+                return false;
+            }
+            if (match.changedColumns.empty())
+            {
+                return true;
+            }
+            for (uint32_t column : match.changedColumns)
+            {
+                if (chunk.versions[column] > m_lastRunVersion)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void Stamp(const Match& match, Chunk& chunk, uint32_t version)
+        {
+            for (size_t i = 0; i < ComponentCount; i++)
+            {
+                if (Writes[i])
+                {
+                    chunk.versions[match.columns[i]] = version;
+                }
+            }
+        }
+
+        View MakeView(const Match& match, const Chunk& chunk) const
+        {
+            View view;
+            view.m_chunk = &chunk;
+            view.m_entities = match.archetype->GetEntities(chunk);
+            view.m_columnIndices = match.columns.data();
+            for (size_t i = 0; i < ComponentCount; i++)
+            {
+                view.m_columns[i] = match.archetype->GetColumn(chunk, match.columns[i]);
+            }
+            return view;
+        }
+
+        World& m_world;
+        std::vector<Match> m_matched;
+        size_t m_matchedCount = 0;
+        std::vector<ComponentId> m_excluded;
+        std::vector<ComponentId> m_changed;
+        uint32_t m_lastRunVersion = 0;
+        std::vector<WorkItem> m_work;
+    };
+}
+
+#endif // ANTUTU_ECS_QUERY_HPP
@@ -0,0 +1,52 @@
+/*
+ * System.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Interface of an ECS system. A system declares which
+ * components it reads and writes; the scheduler runs systems whose
+ * access doesn't conflict at the same time, so Update must touch
+ * nothing it didn't declare. Structural changes go through the
+ * CommandQueue and are applied after every system has run.
+ */
+
+#ifndef ANTUTU_ECS_SYSTEM_HPP
+#define ANTUTU_ECS_SYSTEM_HPP
+
+#include <ANTUTU/ECS/CommandBuffer.hpp>
+#include <ANTUTU/ECS/Query.hpp>
+
+namespace att::ECS
+{
+    struct SystemAccess
+    {
+        std::vector<ComponentId> reads;
+        std::vector<ComponentId> writes;
+        // touches something outside the ECS (or everything): runs alone.
+        bool exclusive = false;
+
+        // same access as a Query with these types: Uses<const Velocity, Position>().
+        template<typename... Ts>
+        void Uses() { Query<Ts...>::GetAccess(reads, writes); }
+
+        template<Component T>
+        void Read() { reads.push_back(T::ComponentId); }
+
+        template<Component T>
+        void Write() { writes.push_back(T::ComponentId); }
+    };
+
+    class ANTUTU_API ISystem
+    {
+    public:
+        virtual ~ISystem() = default;
+
+        // must outlive the system, it names the trace zone.
+        virtual const char* GetName() const = 0;
+        virtual void DeclareAccess(SystemAccess& access) const = 0;
+        virtual void Update(World& world, CommandQueue& commands, float deltaTime) = 0;
+    };
+}
+
+#endif // ANTUTU_ECS_SYSTEM_HPP
@@ -0,0 +1,114 @@
+/*
+ * SystemScheduler.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Runs the ECS systems on the job system. Two systems
+ * depend on each other when one writes a component the other reads or
+ * writes; the earlier registered one runs first. The graph is built once
+ * and cached until the system set changes.
+ *
+ * Every frame the scheduler measures each system and computes the total
+ * work against the critical path (the longest chain of dependent
+ * systems): total / critical is the best speed-up the current graph
+ * allows, and the longest system on the critical path is the one
+ * serializing the frame.
+ */
+
+#ifndef ANTUTU_ECS_SYSTEM_SCHEDULER_HPP
+#define ANTUTU_ECS_SYSTEM_SCHEDULER_HPP
+
+#include <ANTUTU/ECS/System.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace att::ECS
+{
+    struct SystemTiming
+    {
+        const char* name = nullptr;
+        double startMs = 0.0;		// from the start of the frame's update
+        double durationMs = 0.0;
+        bool onCriticalPath = false;
+    };
+
+    struct ScheduleStats
+    {
+        double wallMs = 0.0;
+        double totalWorkMs = 0.0;
+        double criticalPathMs = 0.0;
+        // longest system on the critical path.
+        const char* bottleneck = nullptr;
+        std::vector<SystemTiming> systems;
+
+        double GetParallelism() const { return criticalPathMs > 0.0 ? totalWorkMs / criticalPathMs : 1.0; }
+    };
+
+    class ANTUTU_API SystemScheduler
+    {
+    public:
+        explicit SystemScheduler(World& world);
+        ~SystemScheduler();
+
+        SystemScheduler(const SystemScheduler&) = delete;
+        SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+        // systems keep their registration order wherever they conflict.
+        ISystem* AddSystem(std::unique_ptr<ISystem> system);
+        void RemoveSystem(ISystem* system);
+
+        // runs every system, then plays the command queue back.
+        void Update(float deltaTime);
+
+        CommandQueue& GetCommands() { return m_commands; }
+        const ScheduleStats& GetLastStats() const { return m_stats; }
+
+        // the dependency graph and the last frame's timings, one system per line.
+        std::string FormatReport() const;
+
+        // logs FormatReport every `frames` frames, 0 disables it.
+        void SetReportInterval(uint32_t frames) { m_reportInterval = frames; }
+
+    private:
+        struct Node
+        {
+            ISystem* system;
+            SystemAccess access;
+            std::vector<uint32_t> predecessors;
+            std::vector<uint32_t> dependents;
+        };
+
+        struct NodeJob
+        {
+            SystemScheduler* scheduler;
+            uint32_t index;
+        };
+
+        static bool Conflicts(const SystemAccess& a, const SystemAccess& b);
+        void BuildGraph();
+        void Launch(uint32_t index);
+        void RunNode(uint32_t index);
+        void ComputeStats(double wallMs);
+
+        World& m_world;
+        CommandQueue m_commands;
+        std::vector<std::unique_ptr<ISystem>> m_systems;
+
+        bool m_graphDirty = true;
+        std::vector<Node> m_nodes;
+        std::vector<NodeJob> m_jobs;
+        std::unique_ptr<std::atomic<uint32_t>[]> m_remaining;
+        Common::JobCounter* m_frameCounter = nullptr;
+        float m_deltaTime = 0.0f;
+
+        std::chrono::steady_clock::time_point m_frameStart;
+        ScheduleStats m_stats;
+        uint64_t m_frameIndex = 0;
+        uint32_t m_reportInterval = 0;
+    };
+}
+
+#endif // ANTUTU_ECS_SYSTEM_SCHEDULER_HPP
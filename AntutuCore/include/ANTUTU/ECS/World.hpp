@@ -0,0 +1,134 @@
+/*
+ * World.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Owner of the entities and their archetype storage. The
+ * templates are thin wrappers over the ComponentInfo + bytes API, which
+ * is what deferred playback and tools go through.
+ *
+ * Structural changes (create, destroy, add, remove) move rows between
+ * chunks: they must not happen while a query iterates, record them in a
+ * CommandQueue instead (CommandBuffer.hpp).
+ */
+
+#ifndef ANTUTU_ECS_WORLD_HPP
+#define ANTUTU_ECS_WORLD_HPP
+
+#include <ANTUTU/ECS/Archetype.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace att::ECS
+{
+    class ANTUTU_API World
+    {
+    public:
+        // components of an entity created in one call.
+        static constexpr uint32_t MaxCreateComponents = 64;
+
+        World();
+        ~World();
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        template<Component... Ts>
+        Entity Create(const Ts&... components)
+        {
+            static_assert(HasUniqueComponents<Ts...>(), "a component appears twice");
+            static_assert(sizeof...(Ts) <= MaxCreateComponents, "too many components for one entity");
+            (RegisterComponent<Ts>(), ...);
+            const ComponentInfo infos[] = { GetComponentInfo<Ts>()..., ComponentInfo{} };
+            const void* data[] = { static_cast<const void*>(&components)..., nullptr };
+            return CreateEntity(infos, data, sizeof...(Ts));
+        }
+
+        // the component is overwritten when the entity already has it.
+        template<Component T>
+        void Add(Entity entity, const T& value = T{})
+        {
+            RegisterComponent<T>();
+            const ComponentInfo info = GetComponentInfo<T>();
+            AddComponent(entity, info, &value);
+        }
+
+        template<Component T>
+        void Remove(Entity entity) { RemoveComponent(entity, T::ComponentId); }
+
+        template<Component T>
+        bool Has(Entity entity) const { return HasComponent(entity, T::ComponentId); }
+
+        // marks the column of the chunk as changed, use Read for lookups.
+        template<Component T>
+        T* Get(Entity entity)
+        {
+            RegisterComponent<T>();
+            return reinterpret_cast<T*>(WriteComponent(entity, T::ComponentId));
+        }
+
+        template<Component T>
+        const T* Read(Entity entity) const
+        {
+            RegisterComponent<T>();
+            return reinterpret_cast<const T*>(ReadComponent(entity, T::ComponentId));
+        }
+
+        // infos in any order, data[i] may be null for a zero-filled component.
+        // NullEntity when count exceeds MaxCreateComponents.
+        Entity CreateEntity(const ComponentInfo* infos, const void* const* data, uint32_t count);
+        // every component zero filled.
+        Entity CreateEntity(Archetype* archetype);
+        void Destroy(Entity entity);
+        bool IsAlive(Entity entity) const;
+
+        void AddComponent(Entity entity, const ComponentInfo& info, const void* data);
+        void RemoveComponent(Entity entity, ComponentId id);
+        bool HasComponent(Entity entity, ComponentId id) const;
+        std::byte* WriteComponent(Entity entity, ComponentId id);
+        const std::byte* ReadComponent(Entity entity, ComponentId id) const;
+
+        // the archetype the entity lives in, null when it is not alive.
+        Archetype* GetArchetype(Entity entity) const;
+        Archetype* GetOrCreateArchetype(const ComponentInfo* infos, uint32_t count);
+        Archetype* GetArchetypeWith(Archetype* from, const ComponentInfo& info);
+        Archetype* GetArchetypeWithout(Archetype* from, ComponentId id);
+        // moves the entity to `to`; shared components are copied, new ones zero filled.
+        void MoveEntity(Entity entity, Archetype* to);
+
+        // append only, queries remember how many they have matched so far.
+        const std::vector<std::unique_ptr<Archetype>>& GetArchetypes() const { return m_archetypes; }
+        uint32_t GetEntityCount() const { return m_entityCount; }
+
+        // change versions: every write access takes a new one, thread safe.
+        uint32_t GetVersion() const { return m_version.load(std::memory_order_acquire); }
+        uint32_t IncrementVersion() { return m_version.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+    private:
+        struct EntityRecord
+        {
+            Archetype* archetype = nullptr;
+            RowLocation location = { 0, 0 };
+            uint32_t generation = 0;
+        };
+
+        const EntityRecord* FindRecord(Entity entity) const;
+        Entity AllocateEntity();
+        void Place(Entity entity, Archetype* archetype);
+
+        std::vector<EntityRecord> m_records;
+        std::vector<uint32_t> m_freeIndices;
+        uint32_t m_entityCount = 0;
+
+        ChunkPool m_chunkPool;
+        std::vector<std::unique_ptr<Archetype>> m_archetypes;
+        // signature hash -> archetypes with that hash.
+        std::unordered_map<uint64_t, std::vector<Archetype*>> m_archetypeLookup;
+
+        std::atomic<uint32_t> m_version{ 1 };
+    };
+}
+
+#endif // ANTUTU_ECS_WORLD_HPP
@@ -0,0 +1,52 @@
+/*
+ * BatchKernels.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Batch math over structure-of-arrays data: point, normal
+ * and AABB transforms and sphere / frustum tests. Each kernel exists for
+ * plain C++, 4-wide SIMD (SSE4.1 / NEON), AVX2 and AVX-512; the widest one
+ * the CPU supports is picked on first use. SetSimdLevel forces a lower
+ * level, e.g. to compare them in a benchmark.
+ */
+
+#ifndef ANTUTU_MATH_BATCH_KERNELS_HPP
+#define ANTUTU_MATH_BATCH_KERNELS_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Math/BatchTypes.hpp>
+
+#include <glm/glm.hpp>
+
+namespace att::Math
+{
+    struct ANTUTU_API FrustumPlanes
+    {
+        glm::vec4 planes[6];
+
+        // Gribb / Hartmann extraction for a 0..1 depth range, planes are normalized.
+        static FrustumPlanes FromViewProjection(const glm::mat4& viewProjection);
+    };
+
+    // widest level this CPU and OS support, within what the build compiled in.
+    ANTUTU_API SimdLevel GetSupportedSimdLevel();
+    ANTUTU_API SimdLevel GetSimdLevel();
+    // clamped to the supported level, returns the level in use.
+    ANTUTU_API SimdLevel SetSimdLevel(SimdLevel level);
+    ANTUTU_API const char* GetSimdLevelName(SimdLevel level);
+
+    ANTUTU_API const BatchKernelTable& GetBatchKernels();
+
+    // out may alias in.
+    ANTUTU_API void TransformPoints(const glm::mat4& matrix, SoAConstVec3 in, SoAVec3 out, uint32_t count);
+    // transforms by the inverse transpose of the upper 3x3 and renormalizes, inputs must not be zero.
+    ANTUTU_API void TransformNormals(const glm::mat4& matrix, SoAConstVec3 in, SoAVec3 out, uint32_t count);
+    // bounds of the transformed boxes (center / extent form, no corner loop).
+    ANTUTU_API void TransformAabbs(const glm::mat4& matrix, SoAConstAabbs in, SoAAabbs out, uint32_t count);
+    ANTUTU_API uint32_t CullSpheres(const FrustumPlanes& frustum, SoASpheres spheres, uint32_t count, uint32_t* visible);
+    // a box with extent -FLT_MAX never passes, which parks unused slots.
+    ANTUTU_API uint32_t CullBoxes(const FrustumPlanes& frustum, SoABoxes boxes, uint32_t count, uint32_t* visible);
+}
+
+#endif // ANTUTU_MATH_BATCH_KERNELS_HPP
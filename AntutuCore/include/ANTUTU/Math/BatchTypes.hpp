@@ -0,0 +1,96 @@
+/*
+ * BatchTypes.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Plain structs shared by the batch kernels and the
+ * translation units that implement them for each instruction set. Those
+ * units are compiled with -mavx2 / -mavx512f, so this header must stay
+ * free of inline functions: an inline function instantiated there could
+ * be the copy the linker keeps and run on a CPU without the extension.
+ */
+
+#ifndef ANTUTU_MATH_BATCH_TYPES_HPP
+#define ANTUTU_MATH_BATCH_TYPES_HPP
+
+#include <cstdint>
+
+namespace att::Math
+{
+    enum class SimdLevel : uint8_t
+    {
+        Scalar,
+        // SSE4.1 on x86, NEON on ARM64.
+        Simd4,
+        Avx2,
+        Avx512
+    };
+
+    // structure of arrays, one float per element in each array.
+    struct SoAVec3
+    {
+        float* x = nullptr;
+        float* y = nullptr;
+        float* z = nullptr;
+    };
+
+    struct SoAConstVec3
+    {
+        const float* x = nullptr;
+        const float* y = nullptr;
+        const float* z = nullptr;
+    };
+
+    struct SoAAabbs
+    {
+        SoAVec3 min;
+        SoAVec3 max;
+    };
+
+    struct SoAConstAabbs
+    {
+        SoAConstVec3 min;
+        SoAConstVec3 max;
+    };
+
+    struct SoASpheres
+    {
+        SoAConstVec3 center;
+        const float* radius = nullptr;
+    };
+
+    // boxes in center / half-extent form, the cheap one to test against planes.
+    struct SoABoxes
+    {
+        SoAConstVec3 center;
+        SoAConstVec3 extent;
+    };
+
+    // matrices are 16 floats, column major. Planes are 6 x (nx, ny, nz, d),
+    // normals point inwards and a point p is inside when dot(n, p) + d >= 0.
+    struct BatchKernelTable
+    {
+        SimdLevel level;
+        const char* name;
+
+        void (*transformPoints)(const float* matrix, SoAConstVec3 in, SoAVec3 out, uint32_t count);
+        // matrix is the normal matrix (upper 3x3 used), results are normalized.
+        void (*transformNormals)(const float* matrix, SoAConstVec3 in, SoAVec3 out, uint32_t count);
+        void (*transformAabbs)(const float* matrix, SoAConstAabbs in, SoAAabbs out, uint32_t count);
+        // writes the indices of the spheres touching the frustum, returns how many.
+        uint32_t (*cullSpheres)(const float* planes, SoASpheres spheres, uint32_t count, uint32_t* visible);
+        uint32_t (*cullBoxes)(const float* planes, SoABoxes boxes, uint32_t count, uint32_t* visible);
+    };
+
+    namespace Detail
+    {
+        // the wide kernels hand their remainder to the scalar ones.
+        const BatchKernelTable& GetScalarKernels();
+        // nullptr when the build can't emit the instruction set.
+        const BatchKernelTable* GetAvx2Kernels();
+        const BatchKernelTable* GetAvx512Kernels();
+    }
+}
+
+#endif // ANTUTU_MATH_BATCH_TYPES_HPP
@@ -0,0 +1,340 @@
+/*
+ * SimdTypes.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: 16 byte aligned Vec4 / Mat4 / Quat for hot single-value
+ * math. They use the baseline instruction set of the build (SSE4.1 on
+ * x86, NEON on ARM64, plain floats otherwise) and convert to and from
+ * glm with the same memory layout, so they can be dropped into existing
+ * glm code on the paths that matter. Wider instruction sets are only used
+ * by the batch kernels, behind runtime dispatch.
+ */
+
+#ifndef ANTUTU_MATH_SIMD_TYPES_HPP
+#define ANTUTU_MATH_SIMD_TYPES_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cmath>
+
+// set by the root CMake from ANTUTU_SIMD.
+#ifndef _ANTUTU_SIMD_ENABLED
+    #define _ANTUTU_SIMD_ENABLED 1
+#endif
+
+#if _ANTUTU_SIMD_ENABLED && (defined(__SSE4_1__) || defined(_M_X64) || defined(_M_AMD64))
+    #define ANTUTU_MATH_SSE 1
+    #include <smmintrin.h>
+#elif _ANTUTU_SIMD_ENABLED && (defined(__aarch64__) || defined(_M_ARM64))
+    #define ANTUTU_MATH_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace att::Math
+{
+    ////////////////////////////////////////////////////////////////////////////
+    /// Float4 primitives
+    ////////////////////////////////////////////////////////////////////////////
+
+    namespace Simd
+    {
+#if defined(ANTUTU_MATH_SSE)
+        using Float4 = __m128;
+
+        ANTUTU_INLINE Float4 Load(const float* p) { return _mm_loadu_ps(p); }
+        ANTUTU_INLINE void Store(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+        ANTUTU_INLINE Float4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+        ANTUTU_INLINE Float4 Splat(float s) { return _mm_set1_ps(s); }
+        ANTUTU_INLINE Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+        ANTUTU_INLINE Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+        ANTUTU_INLINE Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+        ANTUTU_INLINE Float4 Div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+        ANTUTU_INLINE Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+        ANTUTU_INLINE Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+        ANTUTU_INLINE Float4 Sqrt(Float4 a) { return _mm_sqrt_ps(a); }
+        // a * b + c
+        ANTUTU_INLINE Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        ANTUTU_INLINE float Dot(Float4 a, Float4 b) { return _mm_cvtss_f32(_mm_dp_ps(a, b, 0xFF)); }
+        // per lane: a >= b ? ifTrue : ifFalse
+        ANTUTU_INLINE Float4 SelectGe(Float4 a, Float4 b, Float4 ifTrue, Float4 ifFalse) { return _mm_blendv_ps(ifFalse, ifTrue, _mm_cmpge_ps(a, b)); }
+
+        template<int X, int Y, int Z, int W>
+        ANTUTU_INLINE Float4 Swizzle(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X)); }
+
+        template<int I>
+        ANTUTU_INLINE Float4 SplatLane(Float4 v) { return Swizzle<I, I, I, I>(v); }
+
+        template<int I>
+        ANTUTU_INLINE float GetLane(Float4 v) { return _mm_cvtss_f32(SplatLane<I>(v)); }
+
+#elif defined(ANTUTU_MATH_NEON)
+        using Float4 = float32x4_t;
+
+        ANTUTU_INLINE Float4 Load(const float* p) { return vld1q_f32(p); }
+        ANTUTU_INLINE void Store(float* p, Float4 v) { vst1q_f32(p, v); }
+        ANTUTU_INLINE Float4 Set(float x, float y, float z, float w) { const float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+        ANTUTU_INLINE Float4 Splat(float s) { return vdupq_n_f32(s); }
+        ANTUTU_INLINE Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+        ANTUTU_INLINE Float4 Sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+        ANTUTU_INLINE Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+        ANTUTU_INLINE Float4 Div(Float4 a, Float4 b) { return vdivq_f32(a, b); }
+        ANTUTU_INLINE Float4 Min(Float4 a, Float4 b) { return vminq_f32(a, b); }
+        ANTUTU_INLINE Float4 Max(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+        ANTUTU_INLINE Float4 Sqrt(Float4 a) { return vsqrtq_f32(a); }
+        ANTUTU_INLINE Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return vfmaq_f32(c, a, b); }
+        ANTUTU_INLINE float Dot(Float4 a, Float4 b) { return vaddvq_f32(vmulq_f32(a, b)); }
+        ANTUTU_INLINE Float4 SelectGe(Float4 a, Float4 b, Float4 ifTrue, Float4 ifFalse) { return vbslq_f32(vcgeq_f32(a, b), ifTrue, ifFalse); }
+
+        template<int I>
+        ANTUTU_INLINE float GetLane(Float4 v) { return vgetq_lane_f32(v, I); }
+
+        template<int I>
+        ANTUTU_INLINE Float4 SplatLane(Float4 v) { return vdupq_laneq_f32(v, I); }
+
+        template<int X, int Y, int Z, int W>
+        ANTUTU_INLINE Float4 Swizzle(Float4 v) { return Set(GetLane<X>(v), GetLane<Y>(v), GetLane<Z>(v), GetLane<W>(v)); }
+
+#else
+        struct Float4
+        {
+            float v[4];
+        };
+
+        ANTUTU_INLINE Float4 Load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+        ANTUTU_INLINE void Store(float* p, Float4 a) { for (int i = 0; i < 4; i++) p[i] = a.v[i]; }
+        ANTUTU_INLINE Float4 Set(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+        ANTUTU_INLINE Float4 Splat(float s) { return { { s, s, s, s } }; }
+
+        template<typename Op>
+        ANTUTU_INLINE Float4 Map(Float4 a, Float4 b, Op op) { return { { op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]) } }; }
+
+        ANTUTU_INLINE Float4 Add(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x + y; }); }
+        ANTUTU_INLINE Float4 Sub(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x - y; }); }
+        ANTUTU_INLINE Float4 Mul(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x * y; }); }
+        ANTUTU_INLINE Float4 Div(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x / y; }); }
+        ANTUTU_INLINE Float4 Min(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+        ANTUTU_INLINE Float4 Max(Float4 a, Float4 b) { return Map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+        ANTUTU_INLINE Float4 Sqrt(Float4 a) { return { { std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) } }; }
+        ANTUTU_INLINE Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return Add(Mul(a, b), c); }
+        ANTUTU_INLINE float Dot(Float4 a, Float4 b) { return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3]; }
+        ANTUTU_INLINE Float4 SelectGe(Float4 a, Float4 b, Float4 ifTrue, Float4 ifFalse)
+        {
+            return { { a.v[0] >= b.v[0] ? ifTrue.v[0] : ifFalse.v[0], a.v[1] >= b.v[1] ? ifTrue.v[1] : ifFalse.v[1],
+                       a.v[2] >= b.v[2] ? ifTrue.v[2] : ifFalse.v[2], a.v[3] >= b.v[3] ? ifTrue.v[3] : ifFalse.v[3] } };
+        }
+
+        template<int I>
+        ANTUTU_INLINE float GetLane(Float4 v) { return v.v[I]; }
+
+        template<int I>
+        ANTUTU_INLINE Float4 SplatLane(Float4 v) { return Splat(v.v[I]); }
+
+        template<int X, int Y, int Z, int W>
+        ANTUTU_INLINE Float4 Swizzle(Float4 v) { return { { v.v[X], v.v[Y], v.v[Z], v.v[W] } }; }
+#endif
+
+        ANTUTU_INLINE Float4 Negate(Float4 v) { return Sub(Splat(0.0f), v); }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Vec4
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct alignas(16) Vec4
+    {
+        Simd::Float4 value;
+
+        Vec4() : value(Simd::Splat(0.0f)) {}
+        explicit Vec4(Simd::Float4 v) : value(v) {}
+        Vec4(float x, float y, float z, float w) : value(Simd::Set(x, y, z, w)) {}
+        explicit Vec4(float s) : value(Simd::Splat(s)) {}
+        Vec4(const glm::vec4& v) : value(Simd::Load(&v.x)) {}
+        Vec4(const glm::vec3& v, float w) : value(Simd::Set(v.x, v.y, v.z, w)) {}
+
+        glm::vec4 ToGlm() const
+        {
+            glm::vec4 result;
+            Simd::Store(&result.x, value);
+            return result;
+        }
+        glm::vec3 ToGlm3() const { return glm::vec3(X(), Y(), Z()); }
+
+        float X() const { return Simd::GetLane<0>(value); }
+        float Y() const { return Simd::GetLane<1>(value); }
+        float Z() const { return Simd::GetLane<2>(value); }
+        float W() const { return Simd::GetLane<3>(value); }
+
+        Vec4 operator+(const Vec4& o) const { return Vec4(Simd::Add(value, o.value)); }
+        Vec4 operator-(const Vec4& o) const { return Vec4(Simd::Sub(value, o.value)); }
+        Vec4 operator*(const Vec4& o) const { return Vec4(Simd::Mul(value, o.value)); }
+        Vec4 operator/(const Vec4& o) const { return Vec4(Simd::Div(value, o.value)); }
+        Vec4 operator*(float s) const { return Vec4(Simd::Mul(value, Simd::Splat(s))); }
+        Vec4 operator-() const { return Vec4(Simd::Negate(value)); }
+        Vec4& operator+=(const Vec4& o) { value = Simd::Add(value, o.value); return *this; }
+        Vec4& operator-=(const Vec4& o) { value = Simd::Sub(value, o.value); return *this; }
+        Vec4& operator*=(const Vec4& o) { value = Simd::Mul(value, o.value); return *this; }
+        Vec4& operator*=(float s) { value = Simd::Mul(value, Simd::Splat(s)); return *this; }
+    };
+
+    ANTUTU_INLINE float Dot(const Vec4& a, const Vec4& b) { return Simd::Dot(a.value, b.value); }
+    ANTUTU_INLINE Vec4 Min(const Vec4& a, const Vec4& b) { return Vec4(Simd::Min(a.value, b.value)); }
+    ANTUTU_INLINE Vec4 Max(const Vec4& a, const Vec4& b) { return Vec4(Simd::Max(a.value, b.value)); }
+
+    // xyz cross product, w is 0 when both inputs have w == 0.
+    ANTUTU_INLINE Vec4 Cross3(const Vec4& a, const Vec4& b)
+    {
+        using namespace Simd;
+        const Float4 lhs = Mul(Swizzle<1, 2, 0, 3>(a.value), Swizzle<2, 0, 1, 3>(b.value));
+        const Float4 rhs = Mul(Swizzle<2, 0, 1, 3>(a.value), Swizzle<1, 2, 0, 3>(b.value));
+        return Vec4(Sub(lhs, rhs));
+    }
+
+    ANTUTU_INLINE float Length(const Vec4& v) { return std::sqrt(Dot(v, v)); }
+    ANTUTU_INLINE Vec4 Normalize(const Vec4& v) { return v * (1.0f / Length(v)); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Mat4
+    ////////////////////////////////////////////////////////////////////////////
+
+    // column major like glm, columns[3] is the translation.
+    struct alignas(16) Mat4
+    {
+        Vec4 columns[4];
+
+        Mat4() : columns{ Vec4(1, 0, 0, 0), Vec4(0, 1, 0, 0), Vec4(0, 0, 1, 0), Vec4(0, 0, 0, 1) } {}
+        Mat4(const Vec4& c0, const Vec4& c1, const Vec4& c2, const Vec4& c3) : columns{ c0, c1, c2, c3 } {}
+        Mat4(const glm::mat4& m) : columns{ Vec4(m[0]), Vec4(m[1]), Vec4(m[2]), Vec4(m[3]) } {}
+
+        glm::mat4 ToGlm() const
+        {
+            glm::mat4 result;
+            for (int i = 0; i < 4; i++)
+            {
+                Simd::Store(&result[i].x, columns[i].value);
+            }
+            return result;
+        }
+
+        static Mat4 Identity() { return Mat4(); }
+
+        // translation * rotation * scale, the same as glm::translate * mat4_cast * glm::scale.
+        static Mat4 FromTRS(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale);
+
+        Vec4 operator*(const Vec4& v) const
+        {
+            using namespace Simd;
+            Float4 result = Mul(columns[0].value, SplatLane<0>(v.value));
+            result = MulAdd(columns[1].value, SplatLane<1>(v.value), result);
+            result = MulAdd(columns[2].value, SplatLane<2>(v.value), result);
+            result = MulAdd(columns[3].value, SplatLane<3>(v.value), result);
+            return Vec4(result);
+        }
+
+        Mat4 operator*(const Mat4& o) const
+        {
+            return Mat4((*this) * o.columns[0], (*this) * o.columns[1], (*this) * o.columns[2], (*this) * o.columns[3]);
+        }
+
+        Vec4 TransformPoint(const Vec4& p) const
+        {
+            using namespace Simd;
+            Float4 result = MulAdd(columns[0].value, SplatLane<0>(p.value), columns[3].value);
+            result = MulAdd(columns[1].value, SplatLane<1>(p.value), result);
+            result = MulAdd(columns[2].value, SplatLane<2>(p.value), result);
+            return Vec4(result);
+        }
+
+        Vec4 TransformVector(const Vec4& v) const
+        {
+            using namespace Simd;
+            Float4 result = Mul(columns[0].value, SplatLane<0>(v.value));
+            result = MulAdd(columns[1].value, SplatLane<1>(v.value), result);
+            result = MulAdd(columns[2].value, SplatLane<2>(v.value), result);
+            return Vec4(result);
+        }
+
+        Mat4 Transposed() const
+        {
+#if defined(ANTUTU_MATH_SSE)
+            __m128 c0 = columns[0].value, c1 = columns[1].value, c2 = columns[2].value, c3 = columns[3].value;
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            return Mat4(Vec4(c0), Vec4(c1), Vec4(c2), Vec4(c3));
+#else
+            const glm::mat4 m = glm::transpose(ToGlm());
+            return Mat4(m);
+#endif
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Quat
+    ////////////////////////////////////////////////////////////////////////////
+
+    // lanes are x, y, z, w whatever glm's storage order is.
+    struct alignas(16) Quat
+    {
+        Simd::Float4 value;
+
+        Quat() : value(Simd::Set(0.0f, 0.0f, 0.0f, 1.0f)) {}
+        explicit Quat(Simd::Float4 v) : value(v) {}
+        Quat(const glm::quat& q) : value(Simd::Set(q.x, q.y, q.z, q.w)) {}
+
+        glm::quat ToGlm() const
+        {
+            return glm::quat(Simd::GetLane<3>(value), Simd::GetLane<0>(value), Simd::GetLane<1>(value), Simd::GetLane<2>(value));
+        }
+
+        Quat operator*(const Quat& o) const
+        {
+            using namespace Simd;
+            // (w1 v2 + w2 v1 + v1 x v2, w1 w2 - v1 . v2), one lane splat of this per term.
+            Float4 result = Mul(SplatLane<3>(value), o.value);
+            result = MulAdd(SplatLane<0>(value), Mul(Swizzle<3, 2, 1, 0>(o.value), Set(1.0f, -1.0f, 1.0f, -1.0f)), result);
+            result = MulAdd(SplatLane<1>(value), Mul(Swizzle<2, 3, 0, 1>(o.value), Set(1.0f, 1.0f, -1.0f, -1.0f)), result);
+            result = MulAdd(SplatLane<2>(value), Mul(Swizzle<1, 0, 3, 2>(o.value), Set(-1.0f, 1.0f, 1.0f, -1.0f)), result);
+            return Quat(result);
+        }
+
+        // rotates the xyz of v, w is carried through.
+        Vec4 Rotate(const Vec4& v) const
+        {
+            using namespace Simd;
+            const Vec4 axis(Mul(value, Set(1.0f, 1.0f, 1.0f, 0.0f)));
+            const Vec4 t = Cross3(axis, v) * 2.0f;
+            return Vec4(Add(Add(v.value, Mul(SplatLane<3>(value), t.value)), Cross3(axis, t).value));
+        }
+
+        Quat Conjugate() const { return Quat(Simd::Mul(value, Simd::Set(-1.0f, -1.0f, -1.0f, 1.0f))); }
+        Quat Normalized() const { return Quat(Simd::Mul(value, Simd::Splat(1.0f / std::sqrt(Simd::Dot(value, value))))); }
+
+        Mat4 ToMat4() const
+        {
+            const float x = Simd::GetLane<0>(value), y = Simd::GetLane<1>(value), z = Simd::GetLane<2>(value), w = Simd::GetLane<3>(value);
+            const float xx = x * x, yy = y * y, zz = z * z;
+            const float xy = x * y, xz = x * z, yz = y * z;
+            const float wx = w * x, wy = w * y, wz = w * z;
+            return Mat4(
+                Vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f),
+                Vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f),
+                Vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f),
+                Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        }
+    };
+
+    inline Mat4 Mat4::FromTRS(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale)
+    {
+        Mat4 result = Quat(rotation).ToMat4();
+        result.columns[0] *= scale.x;
+        result.columns[1] *= scale.y;
+        result.columns[2] *= scale.z;
+        result.columns[3] = Vec4(translation, 1.0f);
+        return result;
+    }
+}
+
+#endif // ANTUTU_MATH_SIMD_TYPES_HPP
@@ -3,17 +3,63 @@
 
 #include <ANTUTU/VulkanCommon.hpp>
 
+#include <algorithm>
+#include <string_view>
+
 namespace att::PlatformInfo
 {
-    struct VulkanDeviceInfo
+    /**
+     * Everything the engine needs to know about a physical device, queried once.
+     * The Features2 / Properties2 chains are flattened into named members,
+     * every pNext pointer is cleared after the query so the struct can be copied.
+     */
+    struct ANTUTU_API VulkanDeviceInfo
     {
-        VkPhysicalDeviceProperties properties;
-        VkPhysicalDeviceFeatures features;
+        VkPhysicalDevice device = VK_NULL_HANDLE;
+        // VkApplicationInfo::apiVersion of the instance the device was queried through.
+        uint32_t instanceApiVersion = VK_API_VERSION_1_0;
+
+        VkPhysicalDeviceProperties properties{};
+        VkPhysicalDeviceVulkan11Properties properties11{};
+        VkPhysicalDeviceVulkan12Properties properties12{};
+        VkPhysicalDeviceVulkan13Properties properties13{};
+        VkPhysicalDeviceMeshShaderPropertiesEXT meshShaderProperties{};
+
+        VkPhysicalDeviceFeatures features{};
+        VkPhysicalDeviceVulkan11Features features11{};
+        VkPhysicalDeviceVulkan12Features features12{};
+        VkPhysicalDeviceVulkan13Features features13{};
+        VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures{};
+        VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{};
+        VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{};
+
+        VkPhysicalDeviceMemoryProperties memory{};
         std::vector<VkQueueFamilyProperties> queueFamilies;
         std::vector<VkExtensionProperties> extensions;
+
+        bool HasExtension(std::string_view name) const;
+
+        // first family supporting all flags, -1 when none.
+        int32_t FindQueueFamily(VkQueueFlags flags) const;
+
+        // first family with the flags but none of the excluded ones (dedicated compute / transfer).
+        int32_t FindDedicatedQueueFamily(VkQueueFlags flags, VkQueueFlags excluded) const;
+
+        // sum of the DEVICE_LOCAL heaps.
+        VkDeviceSize GetDeviceLocalMemory() const;
+
+        // the version usable through the instance: a 1.3 device behind a 1.2 instance
+        // must not see 1.3 structures in its pNext chains.
+        uint32_t GetApiVersion() const { return std::min(properties.apiVersion, instanceApiVersion); }
     };
 
-    VulkanDeviceInfo QueryVulkanDeviceInfo(VkPhysicalDevice device);
+    // queries (and caches per physical device) the full capability set of a device,
+    // instanceApiVersion being the apiVersion the instance was created with.
+    // Thread safe, the cached copy is returned on later calls.
+    ANTUTU_API VulkanDeviceInfo QueryVulkanDeviceInfo(VkPhysicalDevice device, uint32_t instanceApiVersion);
+
+    // forget cached results, e.g. after the instance was recreated.
+    ANTUTU_API void ClearVulkanDeviceInfoCache();
 }
 
-#endif // ANTUTU_RHI_VULKAN_DEVICE_INFO_HPP
\ No newline at end of file
+#endif // ANTUTU_RHI_VULKAN_DEVICE_INFO_HPP
@@ -0,0 +1,46 @@
+/*
+ * HeadlessSurfaceProvider.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: ISurfaceProvider for machines without a display (build
+ * machines, lavapipe runs). When the loader exposes VK_EXT_headless_surface a
+ * real surface is created so the swapchain / present path is exercised,
+ * otherwise no surface is produced and the renderer draws into a
+ * VulkanOffscreenRing instead.
+ */
+
+#ifndef ANTUTU_RHI_HEADLESS_SURFACE_PROVIDER_HPP
+#define ANTUTU_RHI_HEADLESS_SURFACE_PROVIDER_HPP
+
+#include <ANTUTU/RHI/ISurfaceProvider.hpp>
+
+namespace att::RHI
+{
+    class ANTUTU_API HeadlessSurfaceProvider : public ISurfaceProvider
+    {
+    public:
+        // useHeadlessSurface = false forces the offscreen path even when the extension exists.
+        explicit HeadlessSurfaceProvider(bool useHeadlessSurface = true);
+
+        ~HeadlessSurfaceProvider() override = default;
+
+    public:
+        // nullptr when no surface is produced, the caller owns the returned surface.
+        VkSurfaceKHR* CreateSurface(VkInstance instance) const override;
+
+        // VK_KHR_surface + VK_EXT_headless_surface when available, otherwise nothing.
+        std::vector<const char*> GetRequiredExtensions() const override;
+
+        bool UsesHeadlessSurface() const { return m_useHeadlessSurface; }
+
+        static bool IsHeadlessSurfaceSupported();
+
+    private:
+        bool m_useHeadlessSurface;
+        mutable VkSurfaceKHR m_surface = VK_NULL_HANDLE;
+    };
+};
+
+#endif // ANTUTU_RHI_HEADLESS_SURFACE_PROVIDER_HPP
@@ -0,0 +1,62 @@
+/*
+ * VulkanBuffer.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Thin owner of a VkBuffer and its dedicated VkDeviceMemory.
+ * Used for the large device buffers of the GPU-driven path and for
+ * host visible staging / readback buffers.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_BUFFER_HPP
+#define ANTUTU_RHI_VULKAN_BUFFER_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+
+namespace att::RHI
+{
+    class ANTUTU_API VulkanBuffer
+    {
+    public:
+        VulkanBuffer() = default;
+
+        ~VulkanBuffer();
+
+        VulkanBuffer(const VulkanBuffer&) = delete;
+
+        VulkanBuffer& operator=(const VulkanBuffer&) = delete;
+
+        VulkanBuffer(VulkanBuffer&& other) noexcept;
+
+        VulkanBuffer& operator=(VulkanBuffer&& other) noexcept;
+
+    public:
+        // host visible buffers are persistently mapped, see GetMappedData().
+        bool Initialize(VkPhysicalDevice physicalDevice, VkDevice device,
+                        VkDeviceSize size, VkBufferUsageFlags usage,
+                        VkMemoryPropertyFlags properties);
+
+        void Destroy();
+
+        VkBuffer GetHandle() const { return m_buffer; }
+
+        VkDeviceSize GetSize() const { return m_size; }
+
+        void* GetMappedData() const { return m_mapped; }
+
+        // returns UINT32_MAX when no memory type matches.
+        static uint32_t FindMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter,
+                                       VkMemoryPropertyFlags properties);
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        VkBuffer m_buffer = VK_NULL_HANDLE;
+        VkDeviceMemory m_memory = VK_NULL_HANDLE;
+        VkDeviceSize m_size = 0;
+        VkDeviceSize m_allocationSize = 0;
+        void* m_mapped = nullptr;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_BUFFER_HPP
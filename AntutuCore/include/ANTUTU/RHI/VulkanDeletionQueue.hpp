@@ -0,0 +1,63 @@
+/*
+ * VulkanDeletionQueue.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Deferred destruction of GPU objects. A resource retired during
+ * frame N may still be referenced by command buffers in flight, so its deleter
+ * only runs once the renderer reports frame N as completed on the GPU. This
+ * replaces vkDeviceWaitIdle on resize / recreation paths.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_DELETION_QUEUE_HPP
+#define ANTUTU_RHI_VULKAN_DELETION_QUEUE_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+
+#include <deque>
+#include <mutex>
+#include <functional>
+
+namespace att::RHI
+{
+    class ANTUTU_API VulkanDeletionQueue
+    {
+    public:
+        using Deleter = std::function<void()>;
+
+    public:
+        VulkanDeletionQueue() = default;
+
+        ~VulkanDeletionQueue();
+
+        VulkanDeletionQueue(const VulkanDeletionQueue&) = delete;
+
+        VulkanDeletionQueue& operator=(const VulkanDeletionQueue&) = delete;
+
+    public:
+        // retire a resource last used by frameNumber (the frame being recorded).
+        void Push(uint64_t frameNumber, Deleter deleter);
+
+        // run the deleters of every frame <= completedFrameNumber.
+        void Flush(uint64_t completedFrameNumber);
+
+        // run everything, only valid once the device is idle (shutdown).
+        void FlushAll();
+
+        size_t GetPendingCount() const;
+
+    private:
+        struct Entry
+        {
+            uint64_t frameNumber;
+            Deleter deleter;
+        };
+
+    private:
+        mutable std::mutex m_mutex;
+        std::deque<Entry> m_entries;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_DELETION_QUEUE_HPP
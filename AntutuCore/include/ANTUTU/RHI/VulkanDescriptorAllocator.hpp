@@ -0,0 +1,172 @@
+/*
+ * VulkanDescriptorAllocator.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Growable descriptor set allocator for passes that still use
+ * classic descriptor sets. Every (frame in flight, thread) pair owns its own
+ * chain of VkDescriptorPool objects, so allocation never takes a lock and
+ * the whole chain is recycled with vkResetDescriptorPool once the fence of
+ * that frame has signaled. Sets are never freed one by one.
+ * Sets that do not change across frames (immutable sets) are allocated from
+ * a persistent chain and cached by layout + content key.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_DESCRIPTOR_ALLOCATOR_HPP
+#define ANTUTU_RHI_VULKAN_DESCRIPTOR_ALLOCATOR_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+
+namespace att::RHI
+{
+    ////////////////////////////////////////////////////////////////////////////
+    /// Share of each descriptor type in a pool, relative to the set count.
+    ////////////////////////////////////////////////////////////////////////////
+    struct ANTUTU_API DescriptorPoolSizeRatio
+    {
+        VkDescriptorType type;
+        float ratio;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// A list of descriptor pools that grows when the current one is exhausted.
+    /// Not thread safe, every thread owns its own chain.
+    ////////////////////////////////////////////////////////////////////////////
+    class ANTUTU_API DescriptorPoolChain
+    {
+    public:
+        DescriptorPoolChain() = default;
+
+        ~DescriptorPoolChain();
+
+        DescriptorPoolChain(const DescriptorPoolChain&) = delete;
+
+        DescriptorPoolChain& operator=(const DescriptorPoolChain&) = delete;
+
+        DescriptorPoolChain(DescriptorPoolChain&& other) noexcept;
+
+        DescriptorPoolChain& operator=(DescriptorPoolChain&& other) noexcept;
+
+    public:
+        bool Initialize(VkDevice device, uint32_t initialSets,
+                        const std::vector<DescriptorPoolSizeRatio>& ratios);
+
+        void Destroy();
+
+        VkDescriptorSet Allocate(VkDescriptorSetLayout layout, const void* pNext = nullptr);
+
+        // return every pool of the chain to the ready list with vkResetDescriptorPool.
+        void Reset();
+
+        uint32_t GetPoolCount() const { return static_cast<uint32_t>(m_readyPools.size() + m_fullPools.size()); }
+
+    private:
+        VkDescriptorPool GetPool();
+
+        VkDescriptorPool CreatePool(uint32_t setCount);
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        std::vector<DescriptorPoolSizeRatio> m_ratios;
+        std::vector<VkDescriptorPool> m_readyPools;
+        std::vector<VkDescriptorPool> m_fullPools;
+        uint32_t m_setsPerPool = 0;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Per frame / per thread descriptor allocator with an immutable set cache.
+    ///
+    /// Usage:
+    ///     allocator.BeginFrame(frameIndex);   // after the frame fence has signaled
+    ///     VkDescriptorSet set = allocator.Allocate(frameIndex, threadIndex, layout);
+    ////////////////////////////////////////////////////////////////////////////
+    class ANTUTU_API VulkanDescriptorAllocator
+    {
+    public:
+        // called once for a freshly allocated immutable set to write its descriptors.
+        using WriteCallback = std::function<void(VkDescriptorSet)>;
+
+        static constexpr uint32_t DefaultSetsPerPool = 256;
+
+        VulkanDescriptorAllocator() = default;
+
+        ~VulkanDescriptorAllocator();
+
+        VulkanDescriptorAllocator(const VulkanDescriptorAllocator&) = delete;
+
+        VulkanDescriptorAllocator& operator=(const VulkanDescriptorAllocator&) = delete;
+
+    public:
+        bool Initialize(VkDevice device,
+                        uint32_t threadCount,
+                        uint32_t framesInFlight = att::Config::MaxFramesInFlight,
+                        const std::vector<DescriptorPoolSizeRatio>& ratios = GetDefaultRatios());
+
+        void Destroy();
+
+        // reset every pool chain owned by frameIndex. Must only be called after the
+        // fence of that frame has signaled, the GPU can't be using any of its sets.
+        void BeginFrame(uint32_t frameIndex);
+
+        // allocate a transient set that lives until the next BeginFrame(frameIndex).
+        // Lock free: threadIndex selects a chain owned by the calling thread.
+        VkDescriptorSet Allocate(uint32_t frameIndex, uint32_t threadIndex, VkDescriptorSetLayout layout);
+
+        // fetch a set that is reused across frames, allocating and writing it on first use.
+        // key identifies the content of the set (e.g. a hash of the bound resources).
+        VkDescriptorSet GetOrCreateImmutable(VkDescriptorSetLayout layout, uint64_t key, const WriteCallback& writer);
+
+        // drop every cached immutable set, e.g. after the resources they reference are destroyed.
+        void ClearImmutableCache();
+
+        static const std::vector<DescriptorPoolSizeRatio>& GetDefaultRatios();
+
+    private:
+        DescriptorPoolChain& GetChain(uint32_t frameIndex, uint32_t threadIndex)
+        {
+            return m_frameChains[frameIndex * m_threadCount + threadIndex];
+        }
+
+        struct ImmutableKey
+        {
+            VkDescriptorSetLayout layout;
+            uint64_t key;
+
+            bool operator==(const ImmutableKey& other) const
+            {
+                return layout == other.layout && key == other.key;
+            }
+        };
+
+        struct ImmutableKeyHash
+        {
+            size_t operator()(const ImmutableKey& k) const
+            {
+                size_t h = std::hash<uint64_t>{}(k.key);
+                return h ^ (std::hash<VkDescriptorSetLayout>{}(k.layout) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+            }
+        };
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        uint32_t m_threadCount = 0;
+        uint32_t m_framesInFlight = 0;
+
+        // [frame * threadCount + thread]
+        std::vector<DescriptorPoolChain> m_frameChains;
+
+        // immutable sets are never reset, only released in Destroy / ClearImmutableCache.
+        std::mutex m_immutableMutex;
+        DescriptorPoolChain m_immutableChain;
+        std::vector<DescriptorPoolSizeRatio> m_ratios;
+        std::unordered_map<ImmutableKey, VkDescriptorSet, ImmutableKeyHash> m_immutableSets;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_DESCRIPTOR_ALLOCATOR_HPP
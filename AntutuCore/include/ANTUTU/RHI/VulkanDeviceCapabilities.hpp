@@ -0,0 +1,95 @@
+/*
+ * VulkanDeviceCapabilities.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Central record of the optional device features that were
+ * actually enabled. VulkanDeviceFeatureSet turns a VulkanDeviceInfo into the
+ * feature chain / extension list for vkCreateDevice, enabling performance
+ * critical features only when the device supports them. Render paths branch
+ * on GetDeviceCapabilities() instead of re-querying the device.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_DEVICE_CAPABILITIES_HPP
+#define ANTUTU_RHI_VULKAN_DEVICE_CAPABILITIES_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+#include <ANTUTU/PlatformInfo/VulkanDeviceInfo.h>
+
+#include <vector>
+
+namespace att::RHI
+{
+    struct ANTUTU_API DeviceCapabilities
+    {
+        // features, true only when enabled on the logical device.
+        bool meshShader = false;            // VK_EXT_mesh_shader, VulkanMeshletPass
+        bool drawIndirectCount = false;     // compacted GpuCulling.comp output
+        bool multiDrawIndirect = false;
+        bool descriptorIndexing = false;
+        bool bufferDeviceAddress = false;
+        bool timelineSemaphore = false;
+        bool synchronization2 = false;
+        bool dynamicRendering = false;
+        bool hostQueryReset = false;
+        bool samplerFilterMinmax = false;   // single fetch Hi-Z reduction
+        bool pipelineStatistics = false;
+        bool presentId = false;             // VK_KHR_present_id
+        bool presentWait = false;           // VK_KHR_present_wait
+
+        // queues, -1 when the device has no dedicated family.
+        int32_t graphicsFamily = -1;
+        int32_t computeFamily = -1;
+        int32_t transferFamily = -1;
+
+        // misc limits the render paths need.
+        float timestampPeriod = 0.0f;       // nanoseconds per timestamp tick
+        uint32_t timestampValidBits = 0;    // of the graphics family, 0 = no timestamps
+        VkDeviceSize deviceLocalMemory = 0;
+    };
+
+    class ANTUTU_API VulkanDeviceFeatureSet
+    {
+    public:
+        VulkanDeviceFeatureSet() = default;
+
+        // the feature chain points into this object, it can't be copied.
+        VulkanDeviceFeatureSet(const VulkanDeviceFeatureSet&) = delete;
+
+        VulkanDeviceFeatureSet& operator=(const VulkanDeviceFeatureSet&) = delete;
+
+    public:
+        // pick the features and extensions to enable. requiredExtensions are always added.
+        void Build(const PlatformInfo::VulkanDeviceInfo& info, const std::vector<const char*>& requiredExtensions);
+
+        // use as VkDeviceCreateInfo::pNext, with pEnabledFeatures = nullptr.
+        const VkPhysicalDeviceFeatures2* GetFeatureChain() const { return &m_features2; }
+
+        const std::vector<const char*>& GetExtensions() const { return m_extensions; }
+
+        const DeviceCapabilities& GetCapabilities() const { return m_capabilities; }
+
+    private:
+        void AddExtension(const PlatformInfo::VulkanDeviceInfo& info, const char* name, bool* enabled);
+
+    private:
+        VkPhysicalDeviceFeatures2 m_features2{};
+        VkPhysicalDeviceVulkan11Features m_features11{};
+        VkPhysicalDeviceVulkan12Features m_features12{};
+        VkPhysicalDeviceVulkan13Features m_features13{};
+        VkPhysicalDeviceMeshShaderFeaturesEXT m_meshShaderFeatures{};
+        VkPhysicalDevicePresentIdFeaturesKHR m_presentIdFeatures{};
+        VkPhysicalDevicePresentWaitFeaturesKHR m_presentWaitFeatures{};
+
+        std::vector<const char*> m_extensions;
+        DeviceCapabilities m_capabilities;
+    };
+
+    // capabilities of the device the renderer created, set once after vkCreateDevice.
+    ANTUTU_API const DeviceCapabilities& GetDeviceCapabilities();
+
+    ANTUTU_API void SetDeviceCapabilities(const DeviceCapabilities& capabilities);
+};
+
+#endif // ANTUTU_RHI_VULKAN_DEVICE_CAPABILITIES_HPP
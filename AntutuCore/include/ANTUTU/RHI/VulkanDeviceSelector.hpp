@@ -0,0 +1,89 @@
+/*
+ * VulkanDeviceSelector.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Declarative physical device selection. Requirements reject a
+ * device, preferences add weighted points. Every candidate is scored against
+ * the cached VulkanDeviceInfo and a readable report explains the choice.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_DEVICE_SELECTOR_HPP
+#define ANTUTU_RHI_VULKAN_DEVICE_SELECTOR_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+#include <ANTUTU/PlatformInfo/VulkanDeviceInfo.h>
+
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace att::RHI
+{
+    struct ANTUTU_API DeviceSelection
+    {
+        VkPhysicalDevice device = VK_NULL_HANDLE;
+        PlatformInfo::VulkanDeviceInfo info;
+        int64_t score = 0;
+    };
+
+    class ANTUTU_API VulkanDeviceSelector
+    {
+    public:
+        using Predicate = std::function<bool(const PlatformInfo::VulkanDeviceInfo&)>;
+
+        // continuous preference, the returned points are added as-is.
+        using Scorer = std::function<int64_t(const PlatformInfo::VulkanDeviceInfo&)>;
+
+    public:
+        VulkanDeviceSelector& Require(std::string name, Predicate predicate);
+
+        VulkanDeviceSelector& RequireExtension(const char* extension);
+
+        VulkanDeviceSelector& RequireApiVersion(uint32_t apiVersion);
+
+        VulkanDeviceSelector& RequireQueue(VkQueueFlags flags);
+
+        // a queue family must be able to present to the surface.
+        VulkanDeviceSelector& RequirePresent(VkSurfaceKHR surface);
+
+        VulkanDeviceSelector& Prefer(std::string name, int64_t weight, Predicate predicate);
+
+        VulkanDeviceSelector& PreferExtension(const char* extension, int64_t weight);
+
+        VulkanDeviceSelector& PreferScore(std::string name, Scorer scorer);
+
+        // the engine defaults: swapchain + graphics/present queue, weighted toward
+        // discrete GPUs, VRAM and the features the render paths branch on.
+        // surface may be VK_NULL_HANDLE for headless use.
+        static VulkanDeviceSelector CreateDefault(VkSurfaceKHR surface);
+
+        // false when no device passes every requirement. instanceApiVersion is the
+        // apiVersion the instance was created with, it caps what the devices may use.
+        bool Select(VkInstance instance, uint32_t instanceApiVersion, DeviceSelection& selection);
+
+        // per device pass/fail of every requirement and points of every preference.
+        const std::string& GetReport() const { return m_report; }
+
+    private:
+        struct Requirement
+        {
+            std::string name;
+            Predicate predicate;
+        };
+
+        struct Preference
+        {
+            std::string name;
+            Scorer scorer;
+        };
+
+    private:
+        std::vector<Requirement> m_requirements;
+        std::vector<Preference> m_preferences;
+        std::string m_report;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_DEVICE_SELECTOR_HPP
@@ -0,0 +1,186 @@
+/*
+ * VulkanGpuProfiler.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: GPU timing through timestamp queries. Every frame in flight
+ * owns its own query pools, scopes write a timestamp at begin / end and the
+ * results are read back MaxFramesInFlight frames later, after the frame fence
+ * already signalled, so reading never stalls. Ticks are converted with the
+ * device timestampPeriod. Pipeline statistics are gathered for outermost
+ * scopes when the device supports them.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_GPU_PROFILER_HPP
+#define ANTUTU_RHI_VULKAN_GPU_PROFILER_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+#include <ANTUTU/RHI/VulkanDeviceCapabilities.hpp>
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+namespace att::RHI
+{
+    enum class GpuPipelineStatistic : uint32_t
+    {
+        InputAssemblyPrimitives,
+        VertexShaderInvocations,
+        ClippingPrimitives,
+        FragmentShaderInvocations,
+        ComputeShaderInvocations,
+        Count
+    };
+
+    struct ANTUTU_API GpuScopeResult
+    {
+        const char* name = nullptr;
+        uint32_t depth = 0;
+        // milliseconds relative to the frame's first timestamp.
+        double beginMs = 0.0;
+        double endMs = 0.0;
+        bool hasStatistics = false;
+        uint64_t statistics[static_cast<uint32_t>(GpuPipelineStatistic::Count)] = {};
+
+        double GetDurationMs() const { return endMs - beginMs; }
+    };
+
+    struct ANTUTU_API GpuPassStats
+    {
+        std::string name;
+        double lastMs = 0.0;
+        double averageMs = 0.0;   // rolling average over RollingWindow frames
+        double maxMs = 0.0;       // max inside the rolling window
+        uint64_t samples = 0;
+        uint64_t statistics[static_cast<uint32_t>(GpuPipelineStatistic::Count)] = {};
+    };
+
+    class ANTUTU_API VulkanGpuProfiler
+    {
+    public:
+        static constexpr uint32_t RollingWindow = 64;
+
+        // receives every resolved frame, e.g. for the trace exporter.
+        // frameNumber is the frame the results belong to, not the current one.
+        using FrameCallback = std::function<void(uint64_t frameNumber, const std::vector<GpuScopeResult>& scopes)>;
+
+    public:
+        VulkanGpuProfiler() = default;
+
+        ~VulkanGpuProfiler();
+
+        VulkanGpuProfiler(const VulkanGpuProfiler&) = delete;
+
+        VulkanGpuProfiler& operator=(const VulkanGpuProfiler&) = delete;
+
+    public:
+        bool Initialize(VkDevice device, const DeviceCapabilities& capabilities, uint32_t maxScopesPerFrame = 256);
+
+        void Destroy();
+
+        // call once the frame fence of this slot was waited on: resolves the results the
+        // slot recorded MaxFramesInFlight frames ago, then resets its pools.
+        void BeginFrame(VkCommandBuffer cmd, uint64_t frameNumber);
+
+        // returns a scope id for EndScope. Scopes nest, statistics are only gathered
+        // for a scope when no other statistics scope is open.
+        uint32_t BeginScope(VkCommandBuffer cmd, const char* name, bool statistics = false);
+
+        void EndScope(VkCommandBuffer cmd, uint32_t scope);
+
+        void SetFrameCallback(FrameCallback callback) { m_frameCallback = std::move(callback); }
+
+    public:
+        bool IsEnabled() const { return m_device != VK_NULL_HANDLE; }
+
+        bool SupportsStatistics() const { return m_statisticsSupported; }
+
+        // the most recently resolved frame.
+        const std::vector<GpuScopeResult>& GetLastFrame() const { return m_lastFrame; }
+
+        double GetLastFrameMs() const { return m_lastFrameMs; }
+
+        const std::vector<GpuPassStats>& GetPassStats() const { return m_passStats; }
+
+        // fixed width table of the rolling averages, one line per pass.
+        std::string FormatPassTable() const;
+
+    private:
+        struct Scope
+        {
+            const char* name;
+            uint32_t depth;
+            int32_t statisticsQuery;   // -1 when the scope gathers no statistics
+        };
+
+        struct FrameQueries
+        {
+            VkQueryPool timestampPool = VK_NULL_HANDLE;
+            VkQueryPool statisticsPool = VK_NULL_HANDLE;
+            std::vector<Scope> scopes;
+            uint32_t statisticsCount = 0;
+            uint64_t frameNumber = 0;
+            bool recorded = false;
+        };
+
+        struct PassHistory
+        {
+            double samples[RollingWindow] = {};
+            uint32_t cursor = 0;
+            uint32_t count = 0;
+        };
+
+    private:
+        void Resolve(FrameQueries& frame);
+
+        void Accumulate(const GpuScopeResult& result);
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        double m_nsPerTick = 0.0;
+        uint64_t m_timestampMask = 0;
+        uint32_t m_maxScopes = 0;
+        bool m_statisticsSupported = false;
+
+        FrameQueries m_frames[Config::MaxFramesInFlight];
+        FrameQueries* m_current = nullptr;
+        std::vector<uint32_t> m_openStack;
+        int32_t m_openStatistics = -1;
+
+        std::vector<GpuScopeResult> m_lastFrame;
+        double m_lastFrameMs = 0.0;
+        std::vector<GpuPassStats> m_passStats;
+        std::vector<PassHistory> m_passHistory;
+        std::unordered_map<std::string, size_t> m_passIndex;
+        FrameCallback m_frameCallback;
+    };
+
+    // RAII scope: GpuProfileScope scope(profiler, cmd, "Shadow");
+    class ANTUTU_API GpuProfileScope
+    {
+    public:
+        GpuProfileScope(VulkanGpuProfiler& profiler, VkCommandBuffer cmd, const char* name, bool statistics = false)
+            : m_profiler(profiler), m_cmd(cmd), m_scope(profiler.BeginScope(cmd, name, statistics))
+        {
+        }
+
+        ~GpuProfileScope()
+        {
+            m_profiler.EndScope(m_cmd, m_scope);
+        }
+
+        GpuProfileScope(const GpuProfileScope&) = delete;
+
+        GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+    private:
+        VulkanGpuProfiler& m_profiler;
+        VkCommandBuffer m_cmd;
+        uint32_t m_scope;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_GPU_PROFILER_HPP
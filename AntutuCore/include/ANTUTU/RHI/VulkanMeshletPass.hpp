@@ -0,0 +1,97 @@
+/*
+ * VulkanMeshletPass.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Draws a mesh split by Render::MeshletBuilder.
+ * With VK_EXT_mesh_shader the task shader (shaders/Meshlet.task) culls
+ * meshlets by frustum and normal cone and the mesh shader emits the
+ * survivors. Without it, shaders/MeshletExpand.comp applies the same culling
+ * and expands the visible meshlets into an index buffer drawn with
+ * vkCmdDrawIndexedIndirect.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_MESHLET_PASS_HPP
+#define ANTUTU_RHI_VULKAN_MESHLET_PASS_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+#include <ANTUTU/RHI/VulkanBuffer.hpp>
+#include <ANTUTU/Render/MeshletBuilder.hpp>
+
+namespace att::RHI
+{
+    // uniform block "MeshletView" of shaders/MeshletCommon.glsl.
+    struct alignas(16) MeshletViewParams
+    {
+        glm::mat4 viewProjection;
+        glm::mat4 model;
+        glm::vec4 frustumPlanes[6];
+        glm::vec4 cameraPosition;
+        uint32_t meshletCount;
+        uint32_t padding[3];
+    };
+
+    class ANTUTU_API VulkanMeshletPass
+    {
+    public:
+        static constexpr uint32_t TaskGroupSize = 32;
+        static constexpr uint32_t ExpandGroupSize = 64;
+
+        VulkanMeshletPass() = default;
+
+        ~VulkanMeshletPass();
+
+        VulkanMeshletPass(const VulkanMeshletPass&) = delete;
+
+        VulkanMeshletPass& operator=(const VulkanMeshletPass&) = delete;
+
+    public:
+        // useMeshShader must only be true when VK_EXT_mesh_shader and its taskShader / meshShader
+        // features were enabled on the device. The mesh path fails on meshlets above
+        // Render::MeshletMaxVertices / MeshletMaxTriangles.
+        bool Initialize(VkPhysicalDevice physicalDevice, VkDevice device,
+                        const Render::MeshletData& meshlets, bool useMeshShader);
+
+        void Destroy();
+
+        // copy the meshlet data from the staging buffer, call once before the first draw.
+        void RecordUpload(VkCommandBuffer cmd);
+
+        // the staging memory can be released once the upload has completed on the GPU.
+        void ReleaseStaging();
+
+        // binds 0..4 (and 5..6 for the fallback) of the set described in MeshletCommon.glsl.
+        void WriteDescriptors(VkDescriptorSet set, VkBuffer viewParams, VkBuffer positions) const;
+
+        // fallback only: cull and expand into the index buffer. No-op with mesh shaders.
+        void RecordExpand(VkCommandBuffer cmd, VkPipeline expandPipeline,
+                          VkPipelineLayout layout, VkDescriptorSet set);
+
+        // the graphics (mesh or vertex) pipeline and its descriptor set must be bound.
+        void RecordDraw(VkCommandBuffer cmd) const;
+
+        bool UsesMeshShader() const { return m_useMeshShader; }
+
+        uint32_t GetMeshletCount() const { return m_meshletCount; }
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        bool m_useMeshShader = false;
+        uint32_t m_meshletCount = 0;
+        uint32_t m_maxIndexCount = 0;
+        PFN_vkCmdDrawMeshTasksEXT m_cmdDrawMeshTasks = nullptr;
+
+        VulkanBuffer m_meshletBuffer;
+        VulkanBuffer m_boundsBuffer;
+        VulkanBuffer m_vertexBuffer;
+        VulkanBuffer m_triangleBuffer;
+        VulkanBuffer m_stagingBuffer;
+
+        // fallback path.
+        VulkanBuffer m_expandedIndexBuffer;
+        VulkanBuffer m_drawCommandBuffer;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_MESHLET_PASS_HPP
@@ -0,0 +1,106 @@
+/*
+ * VulkanOffscreenRing.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Ring of offscreen color targets standing in for a swapchain
+ * in headless runs. Images are handed out round robin like a FIFO swapchain,
+ * the frame fences already guarantee an image is idle when it comes around.
+ * Each slot can own a host visible readback buffer so a finished frame can be
+ * written to PNG for regression comparisons.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_OFFSCREEN_RING_HPP
+#define ANTUTU_RHI_VULKAN_OFFSCREEN_RING_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+#include <ANTUTU/RHI/VulkanBuffer.hpp>
+#include <ANTUTU/RHI/VulkanDeletionQueue.hpp>
+
+#include <string>
+#include <vector>
+
+namespace att::RHI
+{
+    struct ANTUTU_API OffscreenRingDesc
+    {
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        VkDevice device = VK_NULL_HANDLE;
+        // 8 bit RGBA / BGRA, the formats WritePng understands.
+        VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+        // one more than the frames in flight, like a triple buffered swapchain.
+        uint32_t imageCount = Config::MaxFramesInFlight + 1;
+        bool readback = false;
+    };
+
+    class ANTUTU_API VulkanOffscreenRing
+    {
+    public:
+        VulkanOffscreenRing() = default;
+
+        ~VulkanOffscreenRing();
+
+        VulkanOffscreenRing(const VulkanOffscreenRing&) = delete;
+
+        VulkanOffscreenRing& operator=(const VulkanOffscreenRing&) = delete;
+
+    public:
+        bool Initialize(const OffscreenRingDesc& desc, VulkanDeletionQueue* deletionQueue, uint32_t width, uint32_t height);
+
+        // immediate destruction, the device must be idle.
+        void Destroy();
+
+        // same contract as VulkanSwapchain::Recreate, the old images are retired at frameNumber.
+        bool Recreate(uint32_t width, uint32_t height, uint64_t frameNumber);
+
+        uint32_t AcquireNextImage();
+
+        // copies the image (in TRANSFER_SRC_OPTIMAL) to the slot's readback buffer.
+        void RecordReadback(VkCommandBuffer cmd, uint32_t index) const;
+
+        // tightly packed pixels, valid once the frame that recorded the readback completed.
+        const void* GetReadbackData(uint32_t index) const;
+
+        bool WritePng(uint32_t index, const std::string& path) const;
+
+    public:
+        bool IsValid() const { return !m_slots.empty(); }
+
+        bool HasReadback() const { return m_desc.readback; }
+
+        VkFormat GetFormat() const { return m_desc.format; }
+
+        VkExtent2D GetExtent() const { return m_extent; }
+
+        uint32_t GetImageCount() const { return static_cast<uint32_t>(m_slots.size()); }
+
+        VkImage GetImage(uint32_t index) const { return m_slots[index].image; }
+
+        VkImageView GetImageView(uint32_t index) const { return m_slots[index].view; }
+
+    private:
+        struct Slot
+        {
+            VkImage image = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            VkDeviceSize allocationSize = 0;
+            VkImageView view = VK_NULL_HANDLE;
+            VulkanBuffer readback;
+        };
+
+    private:
+        bool Create(uint32_t width, uint32_t height);
+
+        static void DestroySlots(VkDevice device, std::vector<Slot>& slots);
+
+    private:
+        OffscreenRingDesc m_desc{};
+        VulkanDeletionQueue* m_deletionQueue = nullptr;
+        VkExtent2D m_extent{ 0, 0 };
+        std::vector<Slot> m_slots;
+        uint32_t m_next = 0;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_OFFSCREEN_RING_HPP
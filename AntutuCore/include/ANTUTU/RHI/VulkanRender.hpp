@@ -3,14 +3,20 @@
 
 #include <ANTUTU/VulkanCommon.hpp>
 #include <ANTUTU/RHI/VulkanInstance.hpp>
+#include <ANTUTU/RHI/VulkanDeviceSelector.hpp>
+#include <ANTUTU/RHI/VulkanDeviceCapabilities.hpp>
+#include <ANTUTU/RHI/VulkanDeletionQueue.hpp>
+#include <ANTUTU/RHI/VulkanSwapchain.hpp>
+#include <ANTUTU/RHI/VulkanOffscreenRing.hpp>
+#include <ANTUTU/RHI/HeadlessSurfaceProvider.hpp>
+#include <ANTUTU/RHI/VulkanGpuProfiler.hpp>
 #include <ANTUTU/PlatformInfo/VulkanSurface.h>
 #include <ANTUTU/RHI/WindowHandle.h>
-
-#define GLFW_INCLUDE_VULKAN
-#include <GLFW/glfw3.h>
-
-#define GLFW_EXPOSE_NATIVE_WIN32
-#include <GLFW/glfw3native.h>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace att::RHI
 {
@@ -25,13 +31,6 @@ namespace att::RHI
         }
     };
 
-    struct ANTUTU_API SwapChainSupportDetails
-    {
-        VkSurfaceCapabilitiesKHR capabilities;
-        std::vector<VkSurfaceFormatKHR> formats;
-        std::vector<VkPresentModeKHR> presentModes;
-    };
-
     struct ANTUTU_API VulkanInitInfo
     {
         const char* applicationName;
@@ -52,43 +51,89 @@ namespace att::RHI
         VulkanRender(const VulkanRender&) = delete;
         VulkanRender& operator=(const VulkanRender&) = delete;
 
-        bool Initialize(const WindowHandle& windowHandle, uint32_t width, uint32_t height);
-        std::vector<const char*> GetRequiredExtensions(std::vector<const char*> &additionalExtensions);
+        // extra device requirement, checked next to the defaults by Initialize.
+        void RequireDevice(std::string name, VulkanDeviceSelector::Predicate predicate);
+
+        // HEADLESS only, false renders into the offscreen ring even when
+        // VK_EXT_headless_surface exists. Must be set before Initialize.
+        void SetUseHeadlessSurface(bool useHeadlessSurface);
+
+        bool Initialize(const PlatformInfo::WindowHandle& windowHandle, uint32_t width, uint32_t height);
 
         void RenderFrame();
 
+        // records the new size, the swapchain is rebuilt by the next RenderFrame
+        // without waiting for the device.
         void Resize(uint32_t width, uint32_t height);
 
+        void SetPresentPolicy(PresentPolicy policy);
+
+        PresentPolicy GetPresentPolicy() const { return m_swapchain.GetPresentPolicy(); }
+
+        // offscreen (headless) rendering only: the next frame is written to a PNG
+        // once its fence signalled.
+        void CaptureNextFrame(const std::string& path);
+
+        // disabled (IsEnabled() == false) when the graphics queue has no timestamps.
+        VulkanGpuProfiler& GetGpuProfiler() { return m_gpuProfiler; }
+
+        const PlatformInfo::VulkanDeviceInfo& GetDeviceInfo() const { return m_deviceInfo; }
+
+        // frames submitted so far, a skipped (minimized) frame doesn't count.
+        uint64_t GetFrameNumber() const { return m_frameNumber; }
+
         void Cleanup();
 
     private:
         // Add necessary private members for rendering, 
         // such as command buffers, pipelines, etc.
-        bool CreateInstance(const WindowHandle& handle);
-        bool CreateSurface(const WindowHandle& handle);
+        bool CreateInstance(const PlatformInfo::WindowHandle& handle);
+        bool CreateSurface(const PlatformInfo::WindowHandle& handle);
         bool PickPhysicalDevice();
         bool CreateLogicalDevice();
         bool CreateSwapchain(uint32_t width, uint32_t height);
+        bool CreateFrameResources();
+        void RecordFrame(VkCommandBuffer cmd, uint32_t imageIndex, bool readback);
         bool CheckValidationLayerSupport();
-        int RateDeviceSuitability(VkPhysicalDevice device);
         QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device);
-        SwapChainSupportDetails QuerySwapChainSupport(VkPhysicalDevice device);
-        VkSurfaceFormatKHR ChooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
-        VkPresentModeKHR ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
-        VkExtent2D ChooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities, uint32_t width, uint32_t height);
     
     private:
+        std::vector<std::pair<std::string, VulkanDeviceSelector::Predicate>> m_deviceRequirements;
         VkInstance m_instance{VK_NULL_HANDLE};
         VkSurfaceKHR m_surface{VK_NULL_HANDLE};
         VkPhysicalDevice m_physicalDevice{VK_NULL_HANDLE};
+        PlatformInfo::VulkanDeviceInfo m_deviceInfo;
+        VulkanDeviceFeatureSet m_featureSet;
         VkDevice m_device{VK_NULL_HANDLE};
         VkQueue m_graphicsQueue{VK_NULL_HANDLE};
         VkQueue m_presentQueue{VK_NULL_HANDLE};
-        VkSwapchainKHR m_swapchain{VK_NULL_HANDLE};
-        VkFormat m_swapchainImageFormat;
-        VkExtent2D m_swapchainExtent;
-        std::vector<VkImage> m_swapchainImages;
-        std::vector<VkImageView> m_swapchainImageViews;
+        VulkanDeletionQueue m_deletionQueue;
+        VulkanSwapchain m_swapchain;
+        HeadlessSurfaceProvider m_headlessProvider;
+        VulkanOffscreenRing m_offscreen;
+        VulkanGpuProfiler m_gpuProfiler;
+        std::string m_capturePath;
+        uint32_t m_width{0};
+        uint32_t m_height{0};
+        bool m_resizePending{false};
+
+        struct FrameResources
+        {
+            VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
+            VkSemaphore imageAvailable{VK_NULL_HANDLE};
+            VkFence inFlight{VK_NULL_HANDLE};
+            // Tracer ticks at submit, anchors the GPU timings in the CPU trace.
+            uint64_t submitTicks{0};
+            // pending PNG capture of this slot's last frame, -1 = none.
+            int32_t captureImage{-1};
+            std::string capturePath;
+        };
+        void ResolveCapture(FrameResources& frame);
+
+        VkCommandPool m_commandPool{VK_NULL_HANDLE};
+        FrameResources m_frames[Config::MaxFramesInFlight];
+        uint64_t m_frameNumber{0};
+        std::chrono::steady_clock::time_point m_lastFrameTime{};
         // Other Vulkan objects like command buffers, pipelines, etc.
     };
 };
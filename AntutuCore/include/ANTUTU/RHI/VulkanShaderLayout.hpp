@@ -0,0 +1,78 @@
+/*
+ * VulkanShaderLayout.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Descriptor set layouts and pipeline layout of a pipeline,
+ * built from the reflection tables of its cooked shaders (ShaderFormat.hpp)
+ * instead of being written out by hand next to every pass. Nothing parses
+ * SPIR-V here: the tables and the code are read in place from the mapped
+ * shaders.apak.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_SHADER_LAYOUT_HPP
+#define ANTUTU_RHI_VULKAN_SHADER_LAYOUT_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+#include <ANTUTU/Asset/ShaderFormat.hpp>
+
+#include <vector>
+
+namespace att::RHI
+{
+    class ANTUTU_API VulkanShaderLayout
+    {
+    public:
+        VulkanShaderLayout() = default;
+
+        ~VulkanShaderLayout();
+
+        VulkanShaderLayout(const VulkanShaderLayout&) = delete;
+
+        VulkanShaderLayout& operator=(const VulkanShaderLayout&) = delete;
+
+    public:
+        // every stage of one pipeline. A binding declared by several stages is visible to all
+        // of them and must have the same type everywhere. Runtime sized arrays get
+        // runtimeArraySize descriptors and are partially bound (descriptorIndexing);
+        // with runtimeArraySize 0 they are an error.
+        bool Initialize(VkDevice device, const Asset::CookedShaderHeader* const* shaders, uint32_t shaderCount,
+                        uint32_t runtimeArraySize = 0);
+
+        void Destroy();
+
+        VkPipelineLayout GetPipelineLayout() const { return m_pipelineLayout; }
+
+        // sets 0 .. GetSetCount() - 1, those no shader uses are empty.
+        VkDescriptorSetLayout GetSetLayout(uint32_t set) const
+        {
+            return set < m_setLayouts.size() ? m_setLayouts[set] : VK_NULL_HANDLE;
+        }
+
+        uint32_t GetSetCount() const { return static_cast<uint32_t>(m_setLayouts.size()); }
+
+        // the stageFlags vkCmdPushConstants needs, 0 without push constants.
+        VkShaderStageFlags GetPushConstantStages() const { return m_pushConstantStages; }
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        std::vector<VkDescriptorSetLayout> m_setLayouts;
+        VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+        VkShaderStageFlags m_pushConstantStages = 0;
+    };
+
+    // the module of a cooked shader, the SPIR-V is passed in place.
+    ANTUTU_API VkShaderModule CreateShaderModule(VkDevice device, const Asset::CookedShaderHeader& shader);
+
+    // stage info for the pipeline create info; the entry point points into the shader blob.
+    ANTUTU_API VkPipelineShaderStageCreateInfo GetShaderStageInfo(const Asset::CookedShaderHeader& shader,
+                                                                  VkShaderModule module);
+
+    // the vertex inputs of a vertex shader as attributes of one interleaved binding, packed
+    // in location order. Returns the stride, 0 when the shader has no vertex inputs.
+    ANTUTU_API uint32_t GetVertexAttributes(const Asset::CookedShaderHeader& vertexShader, uint32_t binding,
+                                            std::vector<VkVertexInputAttributeDescription>& attributes);
+};
+
+#endif // ANTUTU_RHI_VULKAN_SHADER_LAYOUT_HPP
@@ -0,0 +1,152 @@
+/*
+ * VulkanSwapchain.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Swapchain owner with hitch free recreation. A resize or a
+ * present policy change builds the new swapchain with the current one as
+ * oldSwapchain and retires the old handles through the VulkanDeletionQueue,
+ * the device is never idled. The present policy picks present mode and image
+ * count together, and VK_KHR_present_wait (when enabled) paces the CPU so no
+ * more than a policy defined number of frames queue up for display.
+ */
+
+#ifndef ANTUTU_RHI_VULKAN_SWAPCHAIN_HPP
+#define ANTUTU_RHI_VULKAN_SWAPCHAIN_HPP
+
+#include <ANTUTU/VulkanCommon.hpp>
+#include <ANTUTU/RHI/VulkanDeletionQueue.hpp>
+
+#include <vector>
+
+namespace att::RHI
+{
+    enum class PresentPolicy : uint8_t
+    {
+        // FIFO, triple buffered, smooth frame delivery.
+        Vsync,
+        // MAILBOX when available, otherwise double buffered FIFO paced to one queued frame.
+        LowLatency,
+        // IMMEDIATE (tearing) when available, otherwise MAILBOX, no pacing.
+        Uncapped,
+    };
+
+    struct ANTUTU_API SwapChainSupportDetails
+    {
+        VkSurfaceCapabilitiesKHR capabilities;
+        std::vector<VkSurfaceFormatKHR> formats;
+        std::vector<VkPresentModeKHR> presentModes;
+    };
+
+    struct ANTUTU_API SwapchainDesc
+    {
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        VkDevice device = VK_NULL_HANDLE;
+        VkSurfaceKHR surface = VK_NULL_HANDLE;
+        uint32_t graphicsFamily = 0;
+        uint32_t presentFamily = 0;
+        PresentPolicy policy = PresentPolicy::Vsync;
+        // VK_KHR_present_id + VK_KHR_present_wait are enabled on the device.
+        bool presentWait = false;
+        VkImageUsageFlags imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    };
+
+    class ANTUTU_API VulkanSwapchain
+    {
+    public:
+        VulkanSwapchain() = default;
+
+        ~VulkanSwapchain();
+
+        VulkanSwapchain(const VulkanSwapchain&) = delete;
+
+        VulkanSwapchain& operator=(const VulkanSwapchain&) = delete;
+
+    public:
+        bool Initialize(const SwapchainDesc& desc, VulkanDeletionQueue* deletionQueue, uint32_t width, uint32_t height);
+
+        // immediate destruction, the device must be idle.
+        void Destroy();
+
+        // rebuild for the new size / policy. The old swapchain is retired at frameNumber.
+        // A zero sized surface (minimized window) leaves the swapchain invalid until the next call.
+        bool Recreate(uint32_t width, uint32_t height, uint64_t frameNumber);
+
+        // takes effect on the next Recreate, only flags it when mode or image count change.
+        void SetPresentPolicy(PresentPolicy policy);
+
+        // blocks until the frame about to be rendered is within the policy latency
+        // of the display. No-op without present_wait or for Uncapped.
+        void WaitForPacing(uint64_t timeoutNs);
+
+        // VK_ERROR_OUT_OF_DATE_KHR / VK_SUBOPTIMAL_KHR flag a recreate.
+        VkResult AcquireNextImage(VkSemaphore imageAvailable, uint32_t& imageIndex);
+
+        // waits on GetPresentSemaphore(imageIndex).
+        VkResult Present(VkQueue queue, uint32_t imageIndex);
+
+    public:
+        bool IsValid() const { return m_swapchain != VK_NULL_HANDLE; }
+
+        bool NeedsRecreate() const { return m_needsRecreate; }
+
+        PresentPolicy GetPresentPolicy() const { return m_policy; }
+
+        VkSwapchainKHR GetHandle() const { return m_swapchain; }
+
+        VkFormat GetFormat() const { return m_format; }
+
+        VkExtent2D GetExtent() const { return m_extent; }
+
+        VkPresentModeKHR GetPresentMode() const { return m_presentMode; }
+
+        uint32_t GetImageCount() const { return static_cast<uint32_t>(m_images.size()); }
+
+        VkImage GetImage(uint32_t index) const { return m_images[index]; }
+
+        VkImageView GetImageView(uint32_t index) const { return m_imageViews[index]; }
+
+        // signalled by the frame's submit, waited by Present. One per image so a
+        // semaphore is never re-signalled while a present still waits on it.
+        VkSemaphore GetPresentSemaphore(uint32_t index) const { return m_presentSemaphores[index]; }
+
+    public:
+        static SwapChainSupportDetails QuerySupport(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
+
+        static VkPresentModeKHR ChoosePresentMode(PresentPolicy policy, const std::vector<VkPresentModeKHR>& availableModes);
+
+        static uint32_t ChooseImageCount(PresentPolicy policy, VkPresentModeKHR mode, const VkSurfaceCapabilitiesKHR& capabilities);
+
+        // frames allowed between present and display, 0 = unpaced.
+        static uint32_t GetPacingLatency(PresentPolicy policy);
+
+    private:
+        static VkSurfaceFormatKHR ChooseSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);
+
+        static VkExtent2D ChooseExtent(const VkSurfaceCapabilitiesKHR& capabilities, uint32_t width, uint32_t height);
+
+        bool Create(uint32_t width, uint32_t height, VkSwapchainKHR oldSwapchain);
+
+    private:
+        SwapchainDesc m_desc{};
+        VulkanDeletionQueue* m_deletionQueue = nullptr;
+        PFN_vkWaitForPresentKHR m_waitForPresent = nullptr;
+
+        VkSwapchainKHR m_swapchain = VK_NULL_HANDLE;
+        VkFormat m_format = VK_FORMAT_UNDEFINED;
+        VkExtent2D m_extent{ 0, 0 };
+        VkPresentModeKHR m_presentMode = VK_PRESENT_MODE_FIFO_KHR;
+        PresentPolicy m_policy = PresentPolicy::Vsync;
+        bool m_needsRecreate = false;
+
+        std::vector<VkImage> m_images;
+        std::vector<VkImageView> m_imageViews;
+        std::vector<VkSemaphore> m_presentSemaphores;
+
+        // ids restart per swapchain, 0 = nothing presented yet.
+        uint64_t m_presentId = 0;
+    };
+};
+
+#endif // ANTUTU_RHI_VULKAN_SWAPCHAIN_HPP
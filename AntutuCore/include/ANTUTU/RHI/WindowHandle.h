@@ -12,7 +12,9 @@ namespace att::PlatformInfo
         //SDL, for now, we will focus on GLFW, but we can add more window systems in the future.
         WINDOWS,
         X11,
-        WAYLAND
+        WAYLAND,
+        // no window, see HeadlessSurfaceProvider.
+        HEADLESS
     };
 
     struct ANTUTU_API WindowHandle
@@ -0,0 +1,138 @@
+/*
+ * FrustumCuller.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: CPU frustum culling of object bounds for any number of
+ * views (main camera, shadow cascades, reflection probes...). Bounds are
+ * kept as center / extent SoA arrays ordered by the leaves of a BVH, so a
+ * leaf that straddles a frustum plane is one contiguous run for the batch
+ * box kernel (4 / 8 / 16 boxes per instruction) and a leaf fully inside is
+ * copied without any test.
+ *
+ * Moving an object only rewrites its slot; Refit grows the touched leaves
+ * and their ancestors once per frame. New objects go into a small unsorted
+ * tail that is tested linearly, and the tree is rebuilt when the tail, the
+ * freed slots or the refitted bounds have degraded too much.
+ *
+ * Cull traverses the tree per view, then tests every candidate leaf of
+ * every view across the job system, and returns a compact list of handles
+ * per view.
+ */
+
+#ifndef ANTUTU_RENDER_FRUSTUM_CULLER_HPP
+#define ANTUTU_RENDER_FRUSTUM_CULLER_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Math/BatchKernels.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace att::Render
+{
+    using CullHandle = uint32_t;
+    constexpr CullHandle InvalidCullHandle = UINT32_MAX;
+
+    struct CullingStats
+    {
+        uint32_t objectCount = 0;
+        uint32_t nodeCount = 0;
+        uint32_t tailCount = 0;
+        // per Cull call, summed over the views.
+        uint32_t leavesTested = 0;
+        uint32_t leavesInside = 0;
+        uint32_t visibleCount = 0;
+        uint32_t rebuilds = 0;
+    };
+
+    class ANTUTU_API FrustumCuller
+    {
+    public:
+        // objects per BVH leaf, a multiple of the widest kernel.
+        static constexpr uint32_t LeafSize = 128;
+        // the tail and the freed tree slots are merged once they reach this fraction of the objects.
+        static constexpr float TailRebuildRatio = 0.125f;
+        // ... or when refitting has grown the leaves' surface area by this factor.
+        static constexpr float RefitRebuildRatio = 2.0f;
+
+        CullHandle Add(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+        void Remove(CullHandle handle);
+        void SetBounds(CullHandle handle, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+        // call once per frame after the bounds changed and before Cull.
+        void Refit();
+        // full top-down rebuild, Refit calls it when needed.
+        void Rebuild();
+
+        // visible[i] receives the handles inside views[i], in no particular order.
+        void Cull(const Math::FrustumPlanes* views, uint32_t viewCount, std::vector<CullHandle>* visible);
+
+        uint32_t GetCount() const { return m_liveCount; }
+        const CullingStats& GetStats() const { return m_stats; }
+
+    private:
+        struct Node
+        {
+            glm::vec3 min;
+            // interior: index of the first of two children, leaf: first slot.
+            uint32_t first;
+            glm::vec3 max;
+            // 0 for interior nodes.
+            uint32_t count;
+        };
+
+        // one leaf (or the tail) to process for one view.
+        struct LeafTask
+        {
+            uint32_t view;
+            uint32_t first;
+            uint32_t count;
+            bool inside;
+            // into m_scratch, count entries are reserved.
+            uint32_t output;
+        };
+
+        uint32_t AllocateSlot();
+        void WriteSlot(uint32_t slot, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+        void ParkSlot(uint32_t slot);
+        void BuildNode(uint32_t node, uint32_t first, uint32_t count, std::vector<uint32_t>& order, const std::vector<glm::vec3>& centers);
+        void RefitLeaf(Node& leaf) const;
+        void RefitInterior();
+        float GetLeafArea() const;
+        void CollectLeaves(uint32_t view, const Math::FrustumPlanes& frustum, std::vector<LeafTask>& tasks) const;
+
+        // SoA bounds, slots [0, m_treeSlots) are owned by leaves, the rest is the tail.
+        std::vector<float> m_centerX, m_centerY, m_centerZ;
+        std::vector<float> m_extentX, m_extentY, m_extentZ;
+        std::vector<CullHandle> m_slotHandle;
+        std::vector<uint32_t> m_slotLeaf;
+        uint32_t m_treeSlots = 0;
+
+        std::vector<uint32_t> m_handleSlot;
+        std::vector<CullHandle> m_freeHandles;
+        // freed tail slots only.
+        std::vector<uint32_t> m_freeSlots;
+        uint32_t m_deadTreeSlots = 0;
+        uint32_t m_liveCount = 0;
+
+        // parents before children, node 0 is the root.
+        std::vector<Node> m_nodes;
+        std::vector<uint32_t> m_dirtyLeaves;
+        std::vector<uint8_t> m_leafDirty;
+        float m_builtLeafArea = 0.0f;
+
+        std::vector<std::vector<LeafTask>> m_viewTasks;
+        std::vector<LeafTask> m_tasks;
+        // tasks of view v are [m_viewTaskStart[v], m_viewTaskStart[v + 1]).
+        std::vector<uint32_t> m_viewTaskStart;
+        std::vector<uint32_t> m_taskVisible;
+        std::vector<uint32_t> m_scratch;
+        CullingStats m_stats;
+    };
+}
+
+#endif // ANTUTU_RENDER_FRUSTUM_CULLER_HPP
@@ -0,0 +1,79 @@
+/*
+ * GpuCullingReference.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: CPU reference implementation of the GPU-driven culling pass
+ * (AntutuCore/shaders/GpuCulling.comp and HiZBuild.comp). It follows the
+ * shaders line by line so the culling results can be validated and
+ * debugged on machines without a GPU.
+ *
+ * Depth convention: 0 = near, 1 = far. The pyramid keeps the farthest depth
+ * of every footprint, an object is occluded when its nearest depth is
+ * behind that value.
+ */
+
+#ifndef ANTUTU_RENDER_GPU_CULLING_REFERENCE_HPP
+#define ANTUTU_RENDER_GPU_CULLING_REFERENCE_HPP
+
+#include <ANTUTU/Render/GpuDrivenTypes.hpp>
+
+#include <vector>
+
+namespace att::Render
+{
+    ////////////////////////////////////////////////////////////////////////////
+    /// Hierarchical max-depth pyramid, mirrors HiZBuild.comp.
+    ////////////////////////////////////////////////////////////////////////////
+    class ANTUTU_API HiZPyramid
+    {
+    public:
+        // mip 0 is the largest power of two that fits in the depth buffer.
+        void Build(const float* depth, uint32_t width, uint32_t height);
+
+        uint32_t GetWidth(uint32_t mip = 0) const;
+
+        uint32_t GetHeight(uint32_t mip = 0) const;
+
+        uint32_t GetMipCount() const { return static_cast<uint32_t>(m_mips.size()); }
+
+        // clamped fetch.
+        float Fetch(uint32_t mip, int32_t x, int32_t y) const;
+
+    private:
+        std::vector<std::vector<float>> m_mips;
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Culling of a whole instance buffer, mirrors GpuCulling.comp.
+    ////////////////////////////////////////////////////////////////////////////
+    class ANTUTU_API GpuCullingReference
+    {
+    public:
+        // returns the draw count. With params.compactOutput only visible instances are written,
+        // otherwise outCommands has one entry per instance and culled ones have instanceCount 0.
+        static uint32_t Cull(const GpuCullingParams& params,
+                             const GpuInstanceData* instances,
+                             const GpuMeshData* meshes,
+                             const HiZPyramid* hiz,
+                             std::vector<GpuDrawCommand>& outCommands,
+                             GpuCullingStats* stats = nullptr);
+
+        // world space sphere against the six frustum planes.
+        static bool IsSphereInFrustum(const glm::vec4 planes[6], const glm::vec3& center, float radius);
+
+        // view space sphere (camera looks down -Z) against the depth pyramid.
+        static bool IsSphereOccluded(const GpuCullingParams& params, const HiZPyramid& hiz,
+                                     const glm::vec3& viewCenter, float radius);
+
+        // screen space bounds (uv, [0, 1]) of a view space sphere.
+        // returns false when the sphere crosses the near plane.
+        static bool ProjectSphere(const glm::vec3& viewCenter, float radius, float nearPlane,
+                                  float p00, float p11, glm::vec4& outUvRect);
+    };
+}
+
+#endif // ANTUTU_RENDER_GPU_CULLING_REFERENCE_HPP
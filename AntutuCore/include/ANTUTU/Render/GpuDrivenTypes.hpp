@@ -0,0 +1,96 @@
+/*
+ * GpuDrivenTypes.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Data layouts shared between the CPU and the GPU culling
+ * shaders (std430). Any change here must be mirrored in
+ * AntutuCore/shaders/GpuCulling.comp.
+ */
+
+#ifndef ANTUTU_RENDER_GPU_DRIVEN_TYPES_HPP
+#define ANTUTU_RENDER_GPU_DRIVEN_TYPES_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace att::Render
+{
+    // one per object, lives in the instance buffer.
+    struct alignas(16) GpuInstanceData
+    {
+        glm::mat4 model;
+        uint32_t meshId;
+        uint32_t materialId;
+        uint32_t padding[2];
+    };
+    static_assert(sizeof(GpuInstanceData) == 80, "GpuInstanceData must match the std430 layout");
+
+    // one per mesh, lives in the mesh buffer. The sphere is in mesh local space.
+    struct alignas(16) GpuMeshData
+    {
+        glm::vec4 boundingSphere;   // xyz = center, w = radius
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        int32_t vertexOffset;
+        uint32_t padding;
+    };
+    static_assert(sizeof(GpuMeshData) == 32, "GpuMeshData must match the std430 layout");
+
+    // same layout as VkDrawIndexedIndirectCommand, kept here so the CPU reference
+    // does not depend on vulkan headers.
+    struct GpuDrawCommand
+    {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t vertexOffset;
+        uint32_t firstInstance;
+    };
+    static_assert(sizeof(GpuDrawCommand) == 20, "GpuDrawCommand must match VkDrawIndexedIndirectCommand");
+
+    // uniform data of the culling dispatch.
+    struct alignas(16) GpuCullingParams
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 frustumPlanes[6];     // world space, xyz = normal (pointing inside), w = distance
+        glm::vec2 hizSize;              // size of mip 0 of the depth pyramid
+        uint32_t hizMipCount;
+        uint32_t instanceCount;
+        float nearPlane;
+        uint32_t enableOcclusion;
+        uint32_t compactOutput;         // 0 = one command per instance, culled ones get instanceCount 0
+        uint32_t padding;
+    };
+
+    // counters written by the culling pass, read back for stats.
+    struct GpuCullingStats
+    {
+        uint32_t visibleCount = 0;
+        uint32_t frustumCulled = 0;
+        uint32_t occlusionCulled = 0;
+    };
+
+    // extracts normalized world space frustum planes from viewProjection (Vulkan clip space, z in [0, 1]).
+    inline void ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6])
+    {
+        const glm::mat4 m = glm::transpose(viewProjection);
+        planes[0] = m[3] + m[0];    // left
+        planes[1] = m[3] - m[0];    // right
+        planes[2] = m[3] + m[1];    // bottom
+        planes[3] = m[3] - m[1];    // top
+        planes[4] = m[2];           // near
+        planes[5] = m[3] - m[2];    // far
+
+        for (int i = 0; i < 6; i++)
+        {
+            planes[i] /= glm::length(glm::vec3(planes[i]));
+        }
+    }
+}
+
+#endif // ANTUTU_RENDER_GPU_DRIVEN_TYPES_HPP
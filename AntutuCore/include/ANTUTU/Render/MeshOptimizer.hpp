@@ -0,0 +1,75 @@
+/*
+ * MeshOptimizer.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Index and vertex reordering for the offline mesh cooker,
+ * usable at runtime on generated geometry too. The usual order is
+ *
+ *      OptimizeVertexCache     triangles in post-transform cache order (Forsyth)
+ *      OptimizeOverdraw        clusters of that order sorted outside-in (Sander et al.),
+ *                              keeping the cache efficiency within a threshold
+ *      Simplify                the LODs, edge collapses onto existing vertices so
+ *                              every LOD indexes the same vertex buffer
+ *      OptimizeVertexFetch     vertices in first use order over all the LODs
+ *
+ * Indices are 32-bit triangle lists, positions are read like MeshletBuilder
+ * does: float x, y, z at the start of every positionStride bytes.
+ */
+
+#ifndef ANTUTU_RENDER_MESH_OPTIMIZER_HPP
+#define ANTUTU_RENDER_MESH_OPTIMIZER_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace att::Render
+{
+    struct VertexCacheStatistics
+    {
+        // vertex shader invocations per triangle: 0.5 is ideal on a regular grid, 3 is no reuse.
+        float acmr = 0.0f;
+        // invocations per referenced vertex, 1 is ideal.
+        float atvr = 0.0f;
+        uint32_t invocations = 0;
+    };
+
+    class ANTUTU_API MeshOptimizer
+    {
+    public:
+        static void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+        // expects OptimizeVertexCache output. threshold: how much worse the ACMR may get
+        // (1.05 = 5%) in exchange for the outside-in order.
+        static void OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+                                     const float* positions, size_t vertexCount, size_t positionStride,
+                                     float threshold = 1.05f);
+
+        // rewrites the indices so vertices are fetched in order. Returns the remap table
+        // (old index -> new index) to apply to the vertex buffer; vertices no index uses
+        // are dropped: they map to ~0u and outVertexCount receives the vertices kept.
+        static std::vector<uint32_t> OptimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                                         size_t* outVertexCount);
+
+        // collapses edges until at most targetIndexCount indices are left or the next
+        // collapse would move the surface by more than targetError (a fraction of the mesh
+        // extent). Open borders and attribute seams stay in place. destination may alias
+        // indices; returns the index count written, outError receives the error reached.
+        static size_t Simplify(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                               const float* positions, size_t vertexCount, size_t positionStride,
+                               size_t targetIndexCount, float targetError, float* outError = nullptr);
+
+        // the largest dimension of the bounding box, what Simplify's errors are relative to.
+        static float GetMeshExtent(const float* positions, size_t vertexCount, size_t positionStride);
+
+        // FIFO cache of cacheSize entries, like most desktop GPUs behave.
+        static VertexCacheStatistics AnalyzeVertexCache(const uint32_t* indices, size_t indexCount,
+                                                        size_t vertexCount, uint32_t cacheSize = 16);
+    };
+}
+
+#endif // ANTUTU_RENDER_MESH_OPTIMIZER_HPP
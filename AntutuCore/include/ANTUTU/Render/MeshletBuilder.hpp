@@ -0,0 +1,93 @@
+/*
+ * MeshletBuilder.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Splits an indexed triangle list into meshlets of at most
+ * 64 vertices and 124 triangles (VK_EXT_mesh_shader friendly limits).
+ * Every meshlet carries a bounding sphere and a normal cone used for
+ * per-meshlet frustum and backface culling in the task shader
+ * (shaders/Meshlet.task) or the compute fallback (shaders/MeshletExpand.comp).
+ *
+ * Works both offline (Serialize / Deserialize to a blob stored with the
+ * mesh) and at runtime (Build on freshly loaded geometry).
+ */
+
+#ifndef ANTUTU_RENDER_MESHLET_BUILDER_HPP
+#define ANTUTU_RENDER_MESHLET_BUILDER_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Render/MeshletLimits.h>
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace att::Render
+{
+    // the mesh shader output limits, Build never exceeds them.
+    inline constexpr uint32_t MeshletMaxVertices = ANTUTU_MESHLET_MAX_VERTICES;
+    inline constexpr uint32_t MeshletMaxTriangles = ANTUTU_MESHLET_MAX_TRIANGLES;
+
+    // std430 compatible, mirrored in the meshlet shaders.
+    struct Meshlet
+    {
+        uint32_t vertexOffset;      // into MeshletData::vertices
+        uint32_t triangleOffset;    // into MeshletData::triangles, in bytes, 4 byte aligned
+        uint32_t vertexCount;
+        uint32_t triangleCount;
+    };
+    static_assert(sizeof(Meshlet) == 16, "Meshlet must match the std430 layout");
+
+    struct alignas(16) MeshletBounds
+    {
+        glm::vec4 sphere;           // xyz = center, w = radius
+        glm::vec4 coneApex;         // xyz = apex, w unused
+        glm::vec4 coneAxis;         // xyz = axis, w = cutoff (cos of the cone half angle, > 1 disables cone culling)
+    };
+    static_assert(sizeof(MeshletBounds) == 48, "MeshletBounds must match the std430 layout");
+
+    struct ANTUTU_API MeshletData
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshletBounds> bounds;
+        std::vector<uint32_t> vertices;     // meshlet local vertex -> mesh vertex
+        std::vector<uint8_t> triangles;     // 3 local indices per triangle
+    };
+
+    class ANTUTU_API MeshletBuilder
+    {
+    public:
+        // positions are read with positionStride bytes between vertices (float x, y, z first).
+        static MeshletData Build(const uint32_t* indices, size_t indexCount,
+                                 const float* positions, size_t vertexCount, size_t positionStride,
+                                 uint32_t maxVertices = MeshletMaxVertices,
+                                 uint32_t maxTriangles = MeshletMaxTriangles);
+
+        // reorders the mesh vertices in meshlet order so vertex fetch is sequential.
+        // Returns the remap table (old index -> new index) to apply to the vertex buffer,
+        // MeshletData::vertices is rewritten accordingly.
+        static std::vector<uint32_t> OptimizeVertexLocality(MeshletData& data, size_t vertexCount);
+
+        // reference of the compute fallback: expands the meshlets back to a plain index buffer.
+        static std::vector<uint32_t> ExpandIndices(const MeshletData& data);
+
+        // true when the meshlet is entirely back facing or outside the frustum.
+        static bool IsMeshletCulled(const MeshletBounds& bounds, const glm::vec4 frustumPlanes[6],
+                                    const glm::vec3& cameraPosition);
+
+        // offline cooking, little endian blob.
+        static void Serialize(const MeshletData& data, std::vector<uint8_t>& outBlob);
+
+        // false on a malformed blob, including meshlets that overrun the vertex or triangle
+        // arrays or exceed the limits above.
+        static bool Deserialize(const uint8_t* blob, size_t size, MeshletData& outData);
+
+    private:
+        static MeshletBounds ComputeBounds(const MeshletData& data, const Meshlet& meshlet,
+                                           const float* positions, size_t positionStride);
+    };
+}
+
+#endif // ANTUTU_RENDER_MESHLET_BUILDER_HPP
@@ -0,0 +1,18 @@
+/*
+ * MeshletLimits.h
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Meshlet size limits, included by both MeshletBuilder.hpp and
+ * the meshlet shaders (max_vertices / max_primitives of shaders/Meshlet.mesh),
+ * so it must stay plain preprocessor defines.
+ */
+
+#ifndef ANTUTU_RENDER_MESHLET_LIMITS_H
+#define ANTUTU_RENDER_MESHLET_LIMITS_H
+
+#define ANTUTU_MESHLET_MAX_VERTICES 64
+#define ANTUTU_MESHLET_MAX_TRIANGLES 124
+
+#endif // ANTUTU_RENDER_MESHLET_LIMITS_H
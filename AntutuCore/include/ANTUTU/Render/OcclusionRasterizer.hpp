@@ -0,0 +1,134 @@
+/*
+ * OcclusionRasterizer.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: CPU occlusion culling stage. A handful of simplified
+ * occluder meshes (walls, terrain chunks, building shells) are rasterized
+ * into a small depth buffer, reduced into the same max depth pyramid the
+ * GPU Hi-Z path uses, and the bounding boxes of the occludees are tested
+ * against it before their draws are submitted.
+ *
+ * Triangles are transformed and set up per occluder, binned into screen
+ * tiles and every tile is rasterized by one job. Vertices are snapped to
+ * 1/256 pixel and the edge functions are evaluated in integers with a
+ * top-left fill rule, so triangles sharing an edge leave no gaps along it;
+ * depth is an interpolated float plane. Only the nearest depth is
+ * kept per pixel, so the result is conservative: an occludee is rejected
+ * only when every texel it covers holds an occluder closer than its nearest
+ * corner.
+ *
+ * Depth follows the projection: smaller is closer, the buffer is cleared to
+ * 1. Triangles crossing the near plane are dropped rather than clipped,
+ * which can only lose occlusion.
+ */
+
+#ifndef ANTUTU_RENDER_OCCLUSION_RASTERIZER_HPP
+#define ANTUTU_RENDER_OCCLUSION_RASTERIZER_HPP
+
+#include <ANTUTU/Config.hpp>
+#include <ANTUTU/Render/GpuCullingReference.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace att::Render
+{
+    struct OcclusionStats
+    {
+        uint32_t occluderCount = 0;
+        uint32_t trianglesSubmitted = 0;
+        // after near plane, frustum and back area rejection.
+        uint32_t trianglesRasterized = 0;
+        uint32_t occludeesTested = 0;
+        uint32_t occludeesCulled = 0;
+    };
+
+    class ANTUTU_API OcclusionRasterizer
+    {
+    public:
+        static constexpr uint32_t TileWidth = 64;
+        static constexpr uint32_t TileHeight = 32;
+
+        // width is rounded up to a multiple of 4. A power of two size keeps the
+        // pyramid's mip 0 identical to the buffer.
+        void Initialize(uint32_t width = 256, uint32_t height = 128);
+
+        // forgets last frame's occluders and clears the depth buffer.
+        void BeginFrame(const glm::mat4& viewProjection);
+
+        // the vertex and index data must stay alive until Rasterize returns.
+        void AddOccluder(const glm::vec3* vertices, uint32_t vertexCount,
+                         const uint32_t* indices, uint32_t indexCount, const glm::mat4& model);
+
+        // rasterizes every occluder added since BeginFrame and builds the pyramid.
+        void Rasterize();
+
+        // world space box, only valid after Rasterize.
+        bool IsOccluded(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+
+        // keeps the entries of indices whose bounds (boundsMin[index], boundsMax[index])
+        // are not occluded, in order. Returns the new count.
+        uint32_t FilterVisible(const glm::vec3* boundsMin, const glm::vec3* boundsMax,
+                               uint32_t* indices, uint32_t count);
+
+        uint32_t GetWidth() const { return m_width; }
+        uint32_t GetHeight() const { return m_height; }
+        const float* GetDepth() const { return m_depth.data(); }
+        const HiZPyramid& GetPyramid() const { return m_pyramid; }
+        const OcclusionStats& GetStats() const { return m_stats; }
+
+    private:
+        struct Occluder
+        {
+            const glm::vec3* vertices;
+            const uint32_t* indices;
+            uint32_t vertexCount;
+            uint32_t indexCount;
+            glm::mat4 model;
+            // into m_clip and m_triangles.
+            uint32_t firstVertex;
+            uint32_t firstTriangle;
+        };
+
+        // screen space. Edges as a * x + b * y + c in subpixels, top-left bias folded into c,
+        // depth plane in pixels, both evaluated at pixel centers.
+        struct Triangle
+        {
+            int64_t edgeA[3];
+            int64_t edgeB[3];
+            int64_t edgeC[3];
+            float depthA, depthB, depthC;
+            // pixel rect, max exclusive.
+            uint16_t minX, minY, maxX, maxY;
+        };
+
+        void SetupOccluder(const Occluder& occluder, uint32_t& outCount);
+        void RasterizeTile(uint32_t tile);
+
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+        uint32_t m_tilesX = 0;
+        uint32_t m_tilesY = 0;
+        glm::mat4 m_viewProjection{ 1.0f };
+
+        std::vector<float> m_depth;
+        HiZPyramid m_pyramid;
+
+        std::vector<Occluder> m_occluders;
+        std::vector<glm::vec4> m_clip;
+        // every occluder owns indexCount / 3 entries, setup fills a prefix of them.
+        std::vector<Triangle> m_triangles;
+        std::vector<uint32_t> m_triangleCount;
+        // triangles overlapping tile t are m_binned[m_binStart[t], m_binStart[t + 1]).
+        std::vector<uint32_t> m_binStart;
+        std::vector<uint32_t> m_binned;
+        std::vector<uint8_t> m_visible;
+        OcclusionStats m_stats;
+    };
+}
+
+#endif // ANTUTU_RENDER_OCCLUSION_RASTERIZER_HPP
@@ -0,0 +1,99 @@
+/*
+ * TransformHierarchy.hpp
+ *
+ *  Created on: 10/19/2026
+ *      Author: Quangnam1423
+ *
+ *  Description: Parent / child transforms stored as flat arrays in
+ * breadth-first order: every depth level is one contiguous range and a
+ * parent always comes before its children. Update walks the levels in
+ * order, so a parent's world matrix is final before any child reads it;
+ * inside a level the nodes are independent and are split across the job
+ * system.
+ *
+ * SetLocal only flags the node. Update recomputes the flagged nodes and
+ * their descendants, levels without any dirty node or dirty parent are
+ * skipped entirely. Handles stay valid across the reordering done by
+ * Create / SetParent / Destroy.
+ */
+
+#ifndef ANTUTU_SCENE_TRANSFORM_HIERARCHY_HPP
+#define ANTUTU_SCENE_TRANSFORM_HIERARCHY_HPP
+
+#include <ANTUTU/Config.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace att::Scene
+{
+    using TransformHandle = uint32_t;
+    constexpr TransformHandle InvalidTransform = UINT32_MAX;
+
+    struct Transform
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+    };
+
+    class ANTUTU_API TransformHierarchy
+    {
+    public:
+        // nodes per job inside one level.
+        static constexpr uint32_t NodesPerJob = 512;
+
+        TransformHandle Create(TransformHandle parent = InvalidTransform, const Transform& local = Transform{});
+        // destroys the whole subtree.
+        void Destroy(TransformHandle handle);
+        // false when it would create a cycle.
+        bool SetParent(TransformHandle handle, TransformHandle parent);
+
+        void SetLocal(TransformHandle handle, const Transform& local);
+        const Transform& GetLocal(TransformHandle handle) const { return m_local[m_dense[handle]]; }
+        // valid after Update.
+        const glm::mat4& GetWorld(TransformHandle handle) const { return m_world[m_dense[handle]]; }
+        TransformHandle GetParent(TransformHandle handle) const;
+        uint32_t GetDepth(TransformHandle handle) const { return m_depth[m_dense[handle]]; }
+
+        bool IsValid(TransformHandle handle) const;
+        uint32_t GetCount() const { return static_cast<uint32_t>(m_local.size()); }
+        uint32_t GetLevelCount() const { return m_levelStart.empty() ? 0 : static_cast<uint32_t>(m_levelStart.size() - 1); }
+
+        void Update();
+
+        // nodes recomputed by the last Update.
+        uint32_t GetLastUpdateCount() const { return m_lastUpdateCount; }
+
+    private:
+        static constexpr uint32_t NoParent = UINT32_MAX;
+
+        void MarkDirty(uint32_t index);
+        void Reorder();
+        void RebuildLevels();
+        uint32_t UpdateLevel(uint32_t begin, uint32_t end);
+
+        // dense, breadth-first.
+        std::vector<Transform> m_local;
+        std::vector<glm::mat4> m_world;
+        std::vector<uint32_t> m_parent;
+        std::vector<uint32_t> m_depth;
+        std::vector<uint8_t> m_dirty;
+        std::vector<TransformHandle> m_handle;
+
+        // handle -> dense index, UINT32_MAX when free.
+        std::vector<uint32_t> m_dense;
+        std::vector<TransformHandle> m_freeHandles;
+
+        // level d is [m_levelStart[d], m_levelStart[d + 1]).
+        std::vector<uint32_t> m_levelStart;
+        std::vector<uint32_t> m_levelDirty;
+        bool m_orderDirty = false;
+        uint32_t m_lastUpdateCount = 0;
+    };
+}
+
+#endif // ANTUTU_SCENE_TRANSFORM_HIERARCHY_HPP
@@ -45,8 +45,11 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
     #endif
 
 #elif defined(ANTUTU_SYSTEM_LINUX)
-    #define VK_USE_PLATFORM_XLIB_KHR        // for Display*, windows using Xlib ubuntu.
-    #include <X11/Xlib.h>               // for Display* get from Xlib.
+    // headless builds run on machines without X11 headers.
+    #if !defined(ANTUTU_HEADLESS)
+        #define VK_USE_PLATFORM_XLIB_KHR        // for Display*, windows using Xlib ubuntu.
+        #include <X11/Xlib.h>               // for Display* get from Xlib.
+    #endif
     // include vulkan headers for linux platform.
     #if defined(__INTELLISENSE__) || !defined(USE_CPP20_MODULES)
         #include <vulkan/vulkan_raii.hpp>
@@ -70,6 +73,10 @@ namespace att::Config
 
     inline constexpr bool EnableValidationLayers = 
         ANTUTU_ENABLE_VALIDATION_LAYERS == 1;
+
+    // number of frames the CPU may record ahead of the GPU.
+    // every per-frame resource (descriptor pools, query pools, ...) is sized by this.
+    inline constexpr uint32_t MaxFramesInFlight = 2;
 }
 
 #endif
\ No newline at end of file
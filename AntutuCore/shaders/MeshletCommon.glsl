@@ -0,0 +1,53 @@
+// Shared meshlet layouts, mirrors AntutuCore/include/ANTUTU/Render/MeshletBuilder.hpp
+
+struct Meshlet
+{
+    uint vertexOffset;
+    uint triangleOffset;
+    uint vertexCount;
+    uint triangleCount;
+};
+
+struct MeshletBounds
+{
+    vec4 sphere;
+    vec4 coneApex;
+    vec4 coneAxis;      // w = cutoff
+};
+
+layout(set = 0, binding = 0) uniform MeshletView
+{
+    mat4 viewProjection;
+    mat4 model;
+    vec4 frustumPlanes[6];      // world space
+    vec4 cameraPosition;        // model space, xyz
+    uint meshletCount;
+    uint padding[3];
+} view;
+
+layout(set = 0, binding = 1, std430) readonly buffer Meshlets { Meshlet meshlets[]; };
+layout(set = 0, binding = 2, std430) readonly buffer Bounds { MeshletBounds bounds[]; };
+layout(set = 0, binding = 3, std430) readonly buffer MeshletVertices { uint meshletVertices[]; };
+layout(set = 0, binding = 4, std430) readonly buffer MeshletTriangles { uint meshletTriangles[]; };
+
+uint loadTriangleIndex(uint byteOffset)
+{
+    return (meshletTriangles[byteOffset >> 2] >> ((byteOffset & 3) * 8)) & 0xff;
+}
+
+// same test as MeshletBuilder::IsMeshletCulled.
+bool isMeshletCulled(uint index)
+{
+    MeshletBounds b = bounds[index];
+
+    vec3 center = (view.model * vec4(b.sphere.xyz, 1.0)).xyz;
+    float scale = max(length(view.model[0].xyz), max(length(view.model[1].xyz), length(view.model[2].xyz)));
+    float radius = b.sphere.w * scale;
+    for (int i = 0; i < 6; i++)
+        if (dot(view.frustumPlanes[i].xyz, center) + view.frustumPlanes[i].w < -radius)
+            return true;
+
+    vec3 toApex = b.coneApex.xyz - view.cameraPosition.xyz;
+    float distance = length(toApex);
+    return distance > 0.0 && dot(toApex / distance, b.coneAxis.xyz) >= b.coneAxis.w;
+}
@@ -0,0 +1,35 @@
+// Cooked mesh vertex decoding, mirrors AntutuCore/src/ANTUTU/Asset/MeshFormat.cpp
+//
+// With the vertex input formats from MeshFormat.hpp the fetch already gives
+//      position    vec4, unorm in the mesh bounds
+//      normal      vec4, A2B10G10R10_UNORM
+//      uv          vec2, half floats
+
+vec3 decodePosition(vec4 position, vec3 positionOffset, vec3 positionScale)
+{
+    return positionOffset + position.xyz * positionScale;
+}
+
+vec3 decodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec3 decodeNormal(vec4 packed)
+{
+    return decodeOctahedral(packed.xy * 2.0 - 1.0);
+}
+
+// w: bitangent sign, bitangent = cross(normal, tangent.xyz) * tangent.w.
+vec4 decodeTangent(vec4 packed, vec3 normal)
+{
+    vec3 referenceTangent = normalize(abs(normal.x) > abs(normal.z) ? vec3(-normal.y, normal.x, 0.0)
+                                                                    : vec3(0.0, -normal.z, normal.y));
+    vec3 referenceBitangent = cross(normal, referenceTangent);
+    float angle = (packed.z - 0.5) * 6.28318530718;
+    return vec4(referenceTangent * cos(angle) + referenceBitangent * sin(angle), packed.w * 2.0 - 1.0);
+}
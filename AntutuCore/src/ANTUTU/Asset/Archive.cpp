@@ -0,0 +1,172 @@
+#include <ANTUTU/Asset/Archive.hpp>
+#include <ANTUTU/Asset/Compression.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <algorithm>
+
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace att::Asset
+{
+    Archive::~Archive()
+    {
+        Close();
+    }
+
+    bool Archive::Open(const char* path)
+    {
+        Close();
+
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER size;
+        HANDLE mapping = GetFileSizeEx(file, &size) && size.QuadPart > 0
+            ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+            : nullptr;
+        void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr)
+        {
+            if (mapping != nullptr)
+            {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            return false;
+        }
+        m_file = file;
+        m_mapping = mapping;
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<uint64_t>(size.QuadPart);
+#else
+        const int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat info;
+        void* view = fstat(fd, &info) == 0 && info.st_size > 0
+            ? mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0)
+            : MAP_FAILED;
+        // the mapping keeps the file alive.
+        close(fd);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<uint64_t>(info.st_size);
+#endif
+
+        const ArchiveHeader& header = GetHeader();
+        const bool headerValid = m_size >= sizeof(ArchiveHeader) && header.magic == ArchiveMagic &&
+                                 header.version == ArchiveVersion && header.fileSize == m_size &&
+                                 header.tocOffset % alignof(ArchiveEntry) == 0 &&
+                                 header.tocOffset <= m_size && header.entryCount <= (m_size - header.tocOffset) / sizeof(ArchiveEntry) &&
+                                 header.stringsOffset <= m_size && header.stringsSize <= m_size - header.stringsOffset;
+        if (!headerValid)
+        {
+            LOG_ERROR("Archive: {} is not a valid version {} archive", path, ArchiveVersion);
+            Close();
+            return false;
+        }
+
+        m_entries = reinterpret_cast<const ArchiveEntry*>(m_data + header.tocOffset);
+        m_entryCount = header.entryCount;
+        for (uint32_t i = 0; i < m_entryCount; i++)
+        {
+            const ArchiveEntry& entry = m_entries[i];
+            const bool entryValid = entry.offset <= m_size && entry.size <= m_size - entry.offset &&
+                                    static_cast<uint64_t>(entry.pathOffset) + entry.pathLength <= header.stringsSize &&
+                                    (entry.compression != ArchiveCompression::None || entry.size == entry.rawSize) &&
+                                    (i == 0 || m_entries[i - 1].pathHash < entry.pathHash);
+            if (!entryValid)
+            {
+                LOG_ERROR("Archive: {} has a corrupt table of contents (entry {})", path, i);
+                Close();
+                return false;
+            }
+            if (!IsCompressionSupported(entry.compression))
+            {
+                LOG_WARN("Archive: {} in {} is {} compressed, this build can't read it",
+                         GetPath(entry), path, GetCompressionName(entry.compression));
+            }
+        }
+        return true;
+    }
+
+    void Archive::Close()
+    {
+        if (m_data == nullptr)
+        {
+            return;
+        }
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        m_mapping = nullptr;
+        m_file = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_entries = nullptr;
+        m_entryCount = 0;
+    }
+
+    const ArchiveEntry* Archive::Find(uint64_t pathHash) const
+    {
+        const ArchiveEntry* end = m_entries + m_entryCount;
+        const ArchiveEntry* entry = std::lower_bound(m_entries, end, pathHash, [](const ArchiveEntry& a, uint64_t hash)
+        {
+            return a.pathHash < hash;
+        });
+        return entry != end && entry->pathHash == pathHash ? entry : nullptr;
+    }
+
+    bool Archive::Read(const ArchiveEntry& entry, void* destination) const
+    {
+        return Decompress(entry.compression, GetData(entry), entry.size, destination, entry.rawSize);
+    }
+
+    void Archive::Prefetch(const ArchiveEntry& entry, uint64_t offset, uint64_t size) const
+    {
+        if (entry.compression != ArchiveCompression::None || offset > entry.size)
+        {
+            offset = 0;
+            size = entry.size;
+        }
+        size = std::min(size, entry.size - offset);
+        if (size == 0)
+        {
+            return;
+        }
+        // madvise wants a page aligned start, blobs are unless the archive was written with
+        // a smaller alignment.
+        const uint64_t begin = (entry.offset + offset) & ~static_cast<uint64_t>(ArchiveSmallAlignment - 1);
+        const uint64_t end = entry.offset + offset + size;
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        WIN32_MEMORY_RANGE_ENTRY range = { const_cast<uint8_t*>(m_data + begin), static_cast<SIZE_T>(end - begin) };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        madvise(const_cast<uint8_t*>(m_data + begin), static_cast<size_t>(end - begin), MADV_WILLNEED);
+#endif
+    }
+
+    std::string_view Archive::GetPath(const ArchiveEntry& entry) const
+    {
+        return { reinterpret_cast<const char*>(m_data + GetHeader().stringsOffset + entry.pathOffset), entry.pathLength };
+    }
+}
@@ -0,0 +1,147 @@
+#include <ANTUTU/Asset/ArchiveWriter.hpp>
+#include <ANTUTU/Asset/Compression.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace att::Asset
+{
+    ArchiveWriter::~ArchiveWriter()
+    {
+        if (m_file != nullptr)
+        {
+            fclose(m_file);
+            remove(m_path.c_str());
+        }
+    }
+
+    bool ArchiveWriter::Open(const std::string& path, uint32_t alignment)
+    {
+        assert(m_file == nullptr && "already open");
+        assert(alignment >= alignof(ArchiveEntry) && (alignment & (alignment - 1)) == 0);
+
+        m_file = fopen(path.c_str(), "wb");
+        if (m_file == nullptr)
+        {
+            return false;
+        }
+        m_path = path;
+        m_alignment = alignment;
+        m_offset = 0;
+        m_rawBytes = 0;
+        m_entries.clear();
+        m_hashes.clear();
+        m_strings.clear();
+
+        // rewritten by Finish.
+        const ArchiveHeader header = {};
+        return Write(&header, sizeof(header)) && Pad(m_alignment);
+    }
+
+    bool ArchiveWriter::Add(std::string_view path, const void* data, uint64_t size,
+                            ArchiveCompression compression, int level, float minSaving)
+    {
+        assert(m_file != nullptr);
+
+        std::string normalized(path);
+        std::replace(normalized.begin(), normalized.end(), '\\', '/');
+        const uint64_t hash = HashAssetPath(normalized);
+        if (m_hashes.count(hash) != 0)
+        {
+            return false;
+        }
+
+        const void* stored = data;
+        uint64_t storedSize = size;
+        ArchiveCompression storedCompression = ArchiveCompression::None;
+        const uint64_t bound = compression != ArchiveCompression::None ? GetCompressBound(compression, size) : 0;
+        if (bound > 0 && size > 0)
+        {
+            m_scratch.resize(bound);
+            const uint64_t compressed = Compress(compression, data, size, m_scratch.data(), bound, level);
+            if (compressed > 0 && static_cast<double>(compressed) <= static_cast<double>(size) * (1.0 - minSaving))
+            {
+                stored = m_scratch.data();
+                storedSize = compressed;
+                storedCompression = compression;
+            }
+        }
+
+        ArchiveEntry entry = {};
+        entry.pathHash = hash;
+        entry.offset = m_offset;
+        entry.size = storedSize;
+        entry.rawSize = size;
+        entry.pathOffset = static_cast<uint32_t>(m_strings.size());
+        entry.pathLength = static_cast<uint32_t>(normalized.size());
+        entry.compression = storedCompression;
+        if (!Write(stored, storedSize) || !Pad(m_alignment))
+        {
+            return false;
+        }
+
+        m_strings += normalized;
+        m_entries.push_back(entry);
+        m_hashes.insert(hash);
+        m_rawBytes += size;
+        return true;
+    }
+
+    bool ArchiveWriter::Finish()
+    {
+        assert(m_file != nullptr);
+
+        std::sort(m_entries.begin(), m_entries.end(), [](const ArchiveEntry& a, const ArchiveEntry& b)
+        {
+            return a.pathHash < b.pathHash;
+        });
+
+        ArchiveHeader header = {};
+        header.magic = ArchiveMagic;
+        header.version = ArchiveVersion;
+        header.entryCount = static_cast<uint32_t>(m_entries.size());
+        header.alignment = m_alignment;
+        header.tocOffset = m_offset;
+        bool written = Write(m_entries.data(), m_entries.size() * sizeof(ArchiveEntry));
+        header.stringsOffset = m_offset;
+        header.stringsSize = m_strings.size();
+        written = written && Write(m_strings.data(), m_strings.size());
+        header.fileSize = m_offset;
+
+        written = written && fseek(m_file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, m_file) == 1;
+        written = fclose(m_file) == 0 && written;
+        m_file = nullptr;
+        if (!written)
+        {
+            remove(m_path.c_str());
+        }
+        return written;
+    }
+
+    bool ArchiveWriter::Write(const void* data, uint64_t size)
+    {
+        if (size == 0)
+        {
+            return true;
+        }
+        m_offset += size;
+        return fwrite(data, 1, static_cast<size_t>(size), m_file) == size;
+    }
+
+    bool ArchiveWriter::Pad(uint64_t alignment)
+    {
+        static const uint8_t zeros[ArchiveLargeAlignment] = {};
+        uint64_t padding = (alignment - m_offset % alignment) % alignment;
+        while (padding > 0)
+        {
+            const uint64_t chunk = std::min<uint64_t>(padding, sizeof(zeros));
+            if (!Write(zeros, chunk))
+            {
+                return false;
+            }
+            padding -= chunk;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,327 @@
+#include <ANTUTU/Asset/AssetCache.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Stats.h>
+#include <Common/Profiler/Tracer.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace att::Asset
+{
+    static void HashBytes(uint64_t& hash, const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    AssetKey MakeAssetKey(std::string_view path, uint32_t assetType, uint64_t settings)
+    {
+        uint64_t hash = HashAssetPath(path);
+        HashBytes(hash, &assetType, sizeof(assetType));
+        HashBytes(hash, &settings, sizeof(settings));
+        return hash;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// AssetRef
+    ////////////////////////////////////////////////////////////////////////////
+
+    AssetRef::AssetRef(const AssetRef& other)
+        : m_entry(other.m_entry)
+    {
+        if (m_entry != nullptr)
+        {
+            m_entry->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    AssetRef& AssetRef::operator=(const AssetRef& other)
+    {
+        if (m_entry != other.m_entry)
+        {
+            AssetRef copy(other);
+            std::swap(m_entry, copy.m_entry);
+        }
+        return *this;
+    }
+
+    AssetRef& AssetRef::operator=(AssetRef&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            m_entry = other.m_entry;
+            other.m_entry = nullptr;
+        }
+        return *this;
+    }
+
+    void AssetRef::Reset()
+    {
+        if (m_entry == nullptr)
+        {
+            return;
+        }
+        // only the last reference goes through the cache's mutex, the others are a plain CAS.
+        uint32_t references = m_entry->references.load(std::memory_order_relaxed);
+        while (true)
+        {
+            if (references == 1)
+            {
+                m_entry->cache->ReleaseLastReference(m_entry);
+                break;
+            }
+            if (m_entry->references.compare_exchange_weak(references, references - 1, std::memory_order_acq_rel,
+                                                          std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        m_entry = nullptr;
+    }
+
+    AssetState AssetRef::GetState() const
+    {
+        return m_entry != nullptr ? m_entry->cache->m_streamer->GetState(m_entry->handle) : AssetState::None;
+    }
+
+    void* AssetRef::Get() const
+    {
+        return m_entry != nullptr ? m_entry->cache->m_streamer->GetAsset(m_entry->handle) : nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// AssetCache
+    ////////////////////////////////////////////////////////////////////////////
+
+    AssetCache::~AssetCache()
+    {
+        Shutdown();
+    }
+
+    void AssetCache::Initialize(AssetStreamer& streamer, uint64_t memoryBudget)
+    {
+        assert(m_streamer == nullptr && "already initialized");
+        m_streamer = &streamer;
+        m_memoryBudget = memoryBudget;
+        m_stats = {};
+    }
+
+    void AssetCache::Shutdown()
+    {
+        if (m_streamer == nullptr)
+        {
+            return;
+        }
+
+        for (auto& [key, entry] : m_entries)
+        {
+            m_streamer->Unload(entry->handle);
+        }
+        m_entries.clear();
+        m_loading.clear();
+        m_unreferenced.clear();
+        m_lruHead = nullptr;
+        m_lruTail = nullptr;
+        m_stats = {};
+        m_streamer = nullptr;
+    }
+
+    AssetRef AssetCache::Acquire(const std::string& path, uint32_t assetType, uint64_t settings, float priority)
+    {
+        assert(m_streamer != nullptr);
+        const AssetKey key = MakeAssetKey(path, assetType, settings);
+
+        // checked before Find, which would count a hit and revive the other asset.
+        const auto it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            const Detail::CacheEntry& found = *it->second;
+            if (found.path != path || found.assetType != assetType || found.settings != settings)
+            {
+                LOG_ERROR("Asset key {0:x} of \"{1}\" (type {2}, settings {3:x}) collides with \"{4}\" (type {5}, settings {6:x}), not loaded.",
+                          key, path, assetType, settings, found.path, found.assetType, found.settings);
+                return {};
+            }
+        }
+
+        AssetRef ref = Find(key);
+        if (ref.IsValid())
+        {
+            return ref;
+        }
+
+        auto entry = std::make_unique<Detail::CacheEntry>();
+        entry->cache = this;
+        entry->references.store(1, std::memory_order_relaxed);
+        entry->key = key;
+        entry->handle = m_streamer->Load(path, assetType, priority, settings);
+        entry->path = path;
+        entry->assetType = assetType;
+        entry->settings = settings;
+        m_loading.push_back(entry.get());
+        m_stats.misses++;
+
+        Detail::CacheEntry* created = entry.get();
+        m_entries.emplace(key, std::move(entry));
+        return AssetRef(created);
+    }
+
+    AssetRef AssetCache::Find(AssetKey key)
+    {
+        const auto it = m_entries.find(key);
+        if (it == m_entries.end())
+        {
+            return {};
+        }
+
+        Detail::CacheEntry* entry = it->second.get();
+        // only this thread takes an entry from 0, so no one can evict it in between.
+        if (entry->references.fetch_add(1, std::memory_order_relaxed) == 0 && entry->inLru)
+        {
+            UnlinkLru(entry);
+            m_stats.revived++;
+        }
+        else
+        {
+            m_stats.hits++;
+        }
+        return AssetRef(entry);
+    }
+
+    void AssetCache::Update()
+    {
+        TRACE_FUNCTION();
+        assert(m_streamer != nullptr);
+
+        std::erase_if(m_loading, [this](Detail::CacheEntry* entry)
+        {
+            const AssetState state = m_streamer->GetState(entry->handle);
+            if (state == AssetState::Ready)
+            {
+                entry->size = m_streamer->GetSize(entry->handle);
+                entry->resident = true;
+                m_stats.residentBytes += entry->size;
+                return true;
+            }
+            // failed, stays referenced as such until dropped.
+            return state != AssetState::Queued && state != AssetState::Reading &&
+                   state != AssetState::Decoding && state != AssetState::Uploading;
+        });
+
+        {
+            // the count only reaches 0 under this mutex and only this thread raises it again,
+            // so an entry at 0 here stays unreferenced, and nobody else touches it, below.
+            std::lock_guard<std::mutex> lock(m_unreferencedMutex);
+            m_unreferencedScratch.swap(m_unreferenced);
+            std::erase_if(m_unreferencedScratch, [](Detail::CacheEntry* entry)
+            {
+                entry->listed = false;
+                return entry->references.load(std::memory_order_acquire) != 0;
+            });
+        }
+        for (Detail::CacheEntry* entry : m_unreferencedScratch)
+        {
+            if (entry->resident)
+            {
+                LinkLru(entry);
+            }
+            else
+            {
+                // still loading (cancelled) or failed: nothing worth keeping.
+                Evict(entry);
+            }
+        }
+        m_unreferencedScratch.clear();
+
+        TrimToBudget(m_memoryBudget);
+        m_stats.entries = static_cast<uint32_t>(m_entries.size());
+        STATS_SET(Common::Stats::AssetCacheBytes, m_stats.residentBytes);
+    }
+
+    void AssetCache::Purge()
+    {
+        Update();
+        TrimToBudget(0);
+        m_stats.entries = static_cast<uint32_t>(m_entries.size());
+        STATS_SET(Common::Stats::AssetCacheBytes, m_stats.residentBytes);
+    }
+
+    void AssetCache::ReleaseLastReference(Detail::CacheEntry* entry)
+    {
+        std::lock_guard<std::mutex> lock(m_unreferencedMutex);
+        // the owner thread may have taken a new reference since the caller looked.
+        if (entry->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+        // listed at most once, Update may free it.
+        if (!entry->listed)
+        {
+            entry->listed = true;
+            m_unreferenced.push_back(entry);
+        }
+    }
+
+    void AssetCache::LinkLru(Detail::CacheEntry* entry)
+    {
+        if (entry->inLru)
+        {
+            UnlinkLru(entry);
+        }
+        entry->lruPrevious = nullptr;
+        entry->lruNext = m_lruHead;
+        if (m_lruHead != nullptr)
+        {
+            m_lruHead->lruPrevious = entry;
+        }
+        m_lruHead = entry;
+        if (m_lruTail == nullptr)
+        {
+            m_lruTail = entry;
+        }
+        entry->inLru = true;
+        m_stats.unusedBytes += entry->size;
+    }
+
+    void AssetCache::UnlinkLru(Detail::CacheEntry* entry)
+    {
+        (entry->lruPrevious != nullptr ? entry->lruPrevious->lruNext : m_lruHead) = entry->lruNext;
+        (entry->lruNext != nullptr ? entry->lruNext->lruPrevious : m_lruTail) = entry->lruPrevious;
+        entry->lruPrevious = nullptr;
+        entry->lruNext = nullptr;
+        entry->inLru = false;
+        m_stats.unusedBytes -= entry->size;
+    }
+
+    void AssetCache::Evict(Detail::CacheEntry* entry)
+    {
+        if (entry->inLru)
+        {
+            UnlinkLru(entry);
+        }
+        if (entry->resident)
+        {
+            m_stats.residentBytes -= entry->size;
+            m_stats.evicted++;
+        }
+        else
+        {
+            std::erase(m_loading, entry);
+        }
+        m_streamer->Unload(entry->handle);
+        m_entries.erase(entry->key);
+    }
+
+    void AssetCache::TrimToBudget(uint64_t budget)
+    {
+        while (m_stats.residentBytes > budget && m_lruTail != nullptr)
+        {
+            Evict(m_lruTail);
+        }
+    }
+}
@@ -0,0 +1,661 @@
+#include <ANTUTU/Asset/AssetStreamer.hpp>
+#include <Common/Event/Events.h>
+#include <Common/Profiler/Stats.h>
+#include <Common/Profiler/Tracer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cfloat>
+
+namespace att::Asset
+{
+    static uint32_t SlotOf(AssetHandle handle)
+    {
+        return static_cast<uint32_t>(handle);
+    }
+
+    static AssetHandle MakeHandle(uint32_t slot, uint32_t generation)
+    {
+        return (static_cast<uint64_t>(generation) << 32) | slot;
+    }
+
+    AssetStreamer::~AssetStreamer()
+    {
+        Shutdown();
+    }
+
+    bool AssetStreamer::Initialize(const StreamerConfig& config)
+    {
+        assert(!m_thread.joinable() && "already initialized");
+        assert(config.queueDepth > 0 && config.chunkSize > 0);
+
+        m_config = config;
+        m_owner = std::this_thread::get_id();
+        m_reader.Initialize(config.queueDepth, config.allowIoUring);
+
+        const uint32_t depth = m_reader.GetQueueDepth();
+        m_chunks.resize(depth);
+        m_freeChunks.clear();
+        for (uint32_t i = depth; i > 0; i--)
+        {
+            m_freeChunks.push_back(i - 1);
+        }
+
+        m_stats = {};
+        m_running.store(true, std::memory_order_release);
+        m_thread = std::thread(&AssetStreamer::IoThread, this);
+        return true;
+    }
+
+    void AssetStreamer::Shutdown()
+    {
+        if (!m_thread.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            for (Request& request : m_requests)
+            {
+                request.cancelled.store(true, std::memory_order_relaxed);
+            }
+            m_running.store(false, std::memory_order_release);
+        }
+        m_queueWakeup.notify_all();
+        m_thread.join();
+        Common::JobSystem::Get().Wait(m_decodeJobs);
+        m_reader.Shutdown();
+
+        // every request is back on this thread now.
+        for (Request& request : m_requests)
+        {
+            if (request.asset != nullptr && m_loaders[request.type].release != nullptr)
+            {
+                m_loaders[request.type].release(m_loaders[request.type].context, request.asset);
+            }
+            AsyncFileReader::Close(request.file);
+        }
+        m_requests.clear();
+        m_freeSlots.clear();
+        m_archives.clear();
+        m_uploads.clear();
+        m_queue.clear();
+        m_completed.clear();
+        m_buffers.clear();
+        m_bufferBytes = 0;
+        m_stats.pending = 0;
+    }
+
+    void AssetStreamer::Mount(const Archive& archive)
+    {
+        assert(std::this_thread::get_id() == m_owner);
+        assert(archive.IsOpen());
+        m_archives.push_back(&archive);
+    }
+
+    void AssetStreamer::RegisterLoader(uint32_t assetType, const AssetLoader& loader)
+    {
+        assert(assetType < MaxAssetTypes && loader.decode != nullptr);
+        m_loaders[assetType] = loader;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Requests (owner thread)
+    ////////////////////////////////////////////////////////////////////////////
+
+    AssetHandle AssetStreamer::Load(const std::string& path, uint32_t assetType, float priority, uint64_t settings)
+    {
+        return LoadRange(path, assetType, 0, UINT64_MAX, priority, settings);
+    }
+
+    AssetHandle AssetStreamer::LoadRange(const std::string& path, uint32_t assetType, uint64_t offset, uint64_t size,
+                                         float priority, uint64_t settings)
+    {
+        assert(std::this_thread::get_id() == m_owner);
+        assert(assetType < MaxAssetTypes && m_loaders[assetType].decode != nullptr && "no loader for this type");
+
+        uint32_t slot;
+        if (!m_freeSlots.empty())
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_requests.size());
+            m_requests.emplace_back();
+        }
+
+        Request& request = m_requests[slot];
+        request.streamer = this;
+        request.slot = slot;
+        request.path = path;
+        request.type = assetType;
+        request.settings = settings;
+        request.rangeOffset = offset;
+        request.rangeSize = size;
+        request.priority = priority;
+        request.archive = nullptr;
+        request.entry = nullptr;
+        const uint64_t pathHash = HashAssetPath(path);
+        for (auto it = m_archives.rbegin(); it != m_archives.rend() && request.entry == nullptr; ++it)
+        {
+            request.archive = *it;
+            request.entry = (*it)->Find(pathHash);
+        }
+        request.state.store(AssetState::Queued, std::memory_order_relaxed);
+        request.cancelled.store(false, std::memory_order_relaxed);
+        request.returned = false;
+
+        if (m_stats.pending++ == 0 && !m_batchOpen)
+        {
+            m_batchStart = std::chrono::steady_clock::now();
+            m_batchOpen = true;
+        }
+        Push(request, priority, false);
+        return MakeHandle(slot, request.generation);
+    }
+
+    void AssetStreamer::SetPriority(AssetHandle handle, float priority)
+    {
+        Request* request = Find(handle);
+        if (request == nullptr || request->priority == priority)
+        {
+            return;
+        }
+        request->priority = priority;
+        // once reading started only the upload order can still change.
+        Push(*request, priority, true);
+    }
+
+    void AssetStreamer::Cancel(AssetHandle handle)
+    {
+        Request* request = Find(handle);
+        if (request == nullptr || request->cancelled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        if (request->returned)
+        {
+            if (request->state.load(std::memory_order_relaxed) == AssetState::Uploading)
+            {
+                std::erase(m_uploads, request->slot);
+                m_stats.cancelled++;
+                m_stats.pending--;
+            }
+            Release(*request);
+            return;
+        }
+
+        // the worker side still owns it, Update frees it once handed back. Requeued on
+        // top so a queued request leaves the queue right away.
+        request->cancelled.store(true, std::memory_order_relaxed);
+        Push(*request, FLT_MAX, true);
+    }
+
+    void AssetStreamer::Unload(AssetHandle handle)
+    {
+        Request* request = Find(handle);
+        if (request == nullptr)
+        {
+            return;
+        }
+        const AssetState state = request->state.load(std::memory_order_relaxed);
+        if (request->returned && (state == AssetState::Ready || state == AssetState::Failed))
+        {
+            Release(*request);
+        }
+        else
+        {
+            Cancel(handle);
+        }
+    }
+
+    AssetState AssetStreamer::GetState(AssetHandle handle) const
+    {
+        const Request* request = Find(handle);
+        if (request == nullptr)
+        {
+            return AssetState::None;
+        }
+        return request->cancelled.load(std::memory_order_relaxed) ? AssetState::Cancelled
+                                                                 : request->state.load(std::memory_order_acquire);
+    }
+
+    void* AssetStreamer::GetAsset(AssetHandle handle) const
+    {
+        const Request* request = Find(handle);
+        return request != nullptr && request->returned && request->state.load(std::memory_order_relaxed) == AssetState::Ready
+            ? request->asset
+            : nullptr;
+    }
+
+    uint64_t AssetStreamer::GetSize(AssetHandle handle) const
+    {
+        const Request* request = Find(handle);
+        return request != nullptr && request->returned && request->state.load(std::memory_order_relaxed) == AssetState::Ready
+            ? request->residentSize
+            : 0;
+    }
+
+    AssetStreamer::Request* AssetStreamer::Find(AssetHandle handle) const
+    {
+        const uint32_t slot = SlotOf(handle);
+        if (slot >= m_requests.size())
+        {
+            return nullptr;
+        }
+        const Request& request = m_requests[slot];
+        if (request.generation != static_cast<uint32_t>(handle >> 32) ||
+            request.state.load(std::memory_order_relaxed) == AssetState::None)
+        {
+            return nullptr;
+        }
+        return const_cast<Request*>(&request);
+    }
+
+    void AssetStreamer::Push(Request& request, float priority, bool requeue)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (requeue && !request.queued)
+            {
+                // the I/O thread already took it.
+                return;
+            }
+            request.queued = true;
+            m_queue.push_back({ priority, &request, ++request.queueVersion });
+            std::push_heap(m_queue.begin(), m_queue.end());
+        }
+        m_queueWakeup.notify_one();
+    }
+
+    void AssetStreamer::Release(Request& request)
+    {
+        const AssetLoader& loader = m_loaders[request.type];
+        if (request.asset != nullptr && loader.release != nullptr)
+        {
+            loader.release(loader.context, request.asset);
+        }
+
+        request.asset = nullptr;
+        request.residentSize = 0;
+        request.path.clear();
+        request.state.store(AssetState::None, std::memory_order_relaxed);
+        request.cancelled.store(false, std::memory_order_relaxed);
+        request.returned = false;
+        // 0 would make MakeHandle return InvalidAsset for slot 0.
+        request.generation = request.generation + 1 == 0 ? 1 : request.generation + 1;
+        m_freeSlots.push_back(request.slot);
+    }
+
+    void AssetStreamer::Update()
+    {
+        TRACE_FUNCTION();
+        assert(std::this_thread::get_id() == m_owner);
+
+        {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_completedScratch.swap(m_completed);
+        }
+
+        Common::EventBus& events = Common::EventBus::Get();
+        for (uint32_t slot : m_completedScratch)
+        {
+            Request& request = m_requests[slot];
+            request.returned = true;
+            if (request.cancelled.load(std::memory_order_relaxed))
+            {
+                m_stats.cancelled++;
+                m_stats.pending--;
+                Release(request);
+            }
+            else if (request.asset == nullptr)
+            {
+                request.state.store(AssetState::Failed, std::memory_order_relaxed);
+                m_stats.failed++;
+                m_stats.pending--;
+                events.Post(Common::AssetReadyEvent{ MakeHandle(slot, request.generation), request.type, false });
+            }
+            else
+            {
+                m_uploads.push_back(slot);
+            }
+        }
+        m_completedScratch.clear();
+
+        // highest priority first, at least one per frame.
+        std::stable_sort(m_uploads.begin(), m_uploads.end(), [this](uint32_t a, uint32_t b)
+        {
+            return m_requests[a].priority > m_requests[b].priority;
+        });
+        uint64_t uploaded = 0;
+        size_t done = 0;
+        for (; done < m_uploads.size() && (done == 0 || uploaded < m_config.uploadBudget); done++)
+        {
+            Request& request = m_requests[m_uploads[done]];
+            const AssetLoader& loader = m_loaders[request.type];
+            if (loader.upload != nullptr)
+            {
+                request.residentSize = loader.upload(loader.context, request.asset);
+                uploaded += request.residentSize;
+            }
+            else
+            {
+                request.residentSize = request.size;
+            }
+            request.state.store(AssetState::Ready, std::memory_order_relaxed);
+            m_stats.loaded++;
+            m_stats.pending--;
+            events.Post(Common::AssetReadyEvent{ MakeHandle(request.slot, request.generation), request.type, true });
+        }
+        m_uploads.erase(m_uploads.begin(), m_uploads.begin() + static_cast<ptrdiff_t>(done));
+
+        m_stats.uploadedLastUpdate = uploaded;
+        m_stats.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+        const uint64_t readNanoseconds = m_readNanoseconds.load(std::memory_order_relaxed);
+        m_stats.throughputMBps = readNanoseconds > 0
+            ? static_cast<double>(m_stats.bytesRead) / (1024.0 * 1024.0) / (static_cast<double>(readNanoseconds) * 1e-9)
+            : 0.0;
+        if (m_stats.pending == 0 && m_batchOpen)
+        {
+            m_stats.lastBatchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_batchStart).count();
+            m_batchOpen = false;
+        }
+        STATS_SET(Common::Stats::AssetPending, m_stats.pending);
+    }
+
+    void AssetStreamer::Flush()
+    {
+        TRACE_FUNCTION();
+        Update();
+        while (m_stats.pending > 0)
+        {
+            std::this_thread::yield();
+            Update();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// I/O thread
+    ////////////////////////////////////////////////////////////////////////////
+
+    void AssetStreamer::IoThread()
+    {
+        TRACE_THREAD_NAME("Asset I/O");
+
+        std::vector<FileReadResult> results(m_reader.GetQueueDepth());
+        for (;;)
+        {
+            // keep the queue full: the files already open first, then the next by priority.
+            while (m_reader.GetInFlight() < m_reader.GetQueueDepth() && (SubmitNextChunk() || StartNext()))
+            {
+            }
+            m_reader.Flush();
+
+            if (m_reader.GetInFlight() == 0)
+            {
+                if (!m_reading.empty())
+                {
+                    // cancelled while waiting to submit, SubmitNextChunk finishes them.
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                if (!m_running.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+                m_queueWakeup.wait(lock, [this]()
+                {
+                    return !m_queue.empty() || !m_running.load(std::memory_order_acquire);
+                });
+                continue;
+            }
+
+            const auto begin = std::chrono::steady_clock::now();
+            const uint32_t count = m_reader.Reap(results.data(), static_cast<uint32_t>(results.size()), true);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                OnChunkDone(static_cast<uint32_t>(results[i].userData), results[i].result);
+            }
+            m_readNanoseconds.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count()), std::memory_order_relaxed);
+        }
+    }
+
+    bool AssetStreamer::StartNext()
+    {
+        Request* request = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (!m_running.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            while (!m_queue.empty() && request == nullptr)
+            {
+                std::pop_heap(m_queue.begin(), m_queue.end());
+                const QueueEntry entry = m_queue.back();
+                m_queue.pop_back();
+                if (entry.request->queued && entry.version == entry.request->queueVersion)
+                {
+                    request = entry.request;
+                    request->queued = false;
+                }
+            }
+        }
+        if (request == nullptr)
+        {
+            return false;
+        }
+
+        if (request->cancelled.load(std::memory_order_relaxed))
+        {
+            Complete(*request);
+            return true;
+        }
+
+        if (request->entry != nullptr)
+        {
+            if (request->rangeOffset > request->entry->rawSize)
+            {
+                Complete(*request);
+                return true;
+            }
+            // mapped, nothing to read: the page-in overlaps with the decodes queued before.
+            request->size = std::min(request->rangeSize, request->entry->rawSize - request->rangeOffset);
+            request->archive->Prefetch(*request->entry, request->rangeOffset, request->size);
+            request->state.store(AssetState::Decoding, std::memory_order_relaxed);
+            Common::JobSystem::Get().Schedule({ &AssetStreamer::DecodeJob, request, &m_decodeJobs });
+            return true;
+        }
+
+        request->state.store(AssetState::Reading, std::memory_order_relaxed);
+        uint64_t fileSize = 0;
+        request->file = AsyncFileReader::Open(request->path.c_str(), &fileSize);
+        request->submitted = 0;
+        request->chunksInFlight = 0;
+        request->readFailed = request->file == InvalidFile || request->rangeOffset > fileSize;
+        request->size = request->readFailed ? 0 : std::min(request->rangeSize, fileSize - request->rangeOffset);
+        if (request->readFailed || request->size == 0)
+        {
+            FinishRead(*request);
+            return true;
+        }
+
+        AcquireBuffer(request->data, request->size);
+        m_reading.push_back(request);
+        return SubmitNextChunk();
+    }
+
+    bool AssetStreamer::SubmitNextChunk()
+    {
+        for (size_t i = 0; i < m_reading.size(); i++)
+        {
+            Request& request = *m_reading[i];
+            const bool stopped = request.cancelled.load(std::memory_order_relaxed) || request.readFailed;
+            if (stopped || request.submitted == request.size)
+            {
+                m_reading.erase(m_reading.begin() + static_cast<ptrdiff_t>(i--));
+                if (stopped && request.chunksInFlight == 0)
+                {
+                    FinishRead(request);
+                }
+                continue;
+            }
+
+            const uint32_t size = static_cast<uint32_t>(std::min<uint64_t>(m_config.chunkSize, request.size - request.submitted));
+            SubmitChunk(request, request.submitted, size);
+            request.submitted += size;
+            if (request.submitted == request.size)
+            {
+                m_reading.erase(m_reading.begin() + static_cast<ptrdiff_t>(i));
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void AssetStreamer::SubmitChunk(Request& request, uint64_t offset, uint32_t size)
+    {
+        assert(!m_freeChunks.empty());
+        const uint32_t chunk = m_freeChunks.back();
+        m_freeChunks.pop_back();
+        m_chunks[chunk] = { &request, offset, size };
+        request.chunksInFlight++;
+
+        [[maybe_unused]] const bool queued = m_reader.Submit({ request.file, request.rangeOffset + offset, request.data.data() + offset, size, chunk });
+        assert(queued);
+    }
+
+    void AssetStreamer::OnChunkDone(uint32_t chunk, int64_t result)
+    {
+        const Chunk done = m_chunks[chunk];
+        m_freeChunks.push_back(chunk);
+        Request& request = *done.request;
+        request.chunksInFlight--;
+
+        if (result > 0)
+        {
+            m_bytesRead.fetch_add(static_cast<uint64_t>(result), std::memory_order_relaxed);
+            STATS_INCREMENT(Common::Stats::AssetBytesRead, static_cast<uint64_t>(result));
+        }
+
+        const bool stopped = request.cancelled.load(std::memory_order_relaxed) || request.readFailed;
+        if (!stopped && result > 0 && static_cast<uint64_t>(result) < done.size)
+        {
+            // short read, the slot this one freed takes the rest.
+            SubmitChunk(request, done.offset + static_cast<uint64_t>(result), done.size - static_cast<uint32_t>(result));
+            return;
+        }
+        if (!stopped && (result == -EINTR || result == -EAGAIN))
+        {
+            SubmitChunk(request, done.offset, done.size);
+            return;
+        }
+        if (result <= 0)
+        {
+            // 0: the file shrank since it was opened.
+            request.readFailed = true;
+        }
+
+        const bool submittedAll = request.submitted == request.size || request.readFailed ||
+                                  request.cancelled.load(std::memory_order_relaxed);
+        if (request.chunksInFlight == 0 && submittedAll &&
+            std::find(m_reading.begin(), m_reading.end(), &request) == m_reading.end())
+        {
+            FinishRead(request);
+        }
+    }
+
+    void AssetStreamer::FinishRead(Request& request)
+    {
+        AsyncFileReader::Close(request.file);
+        request.file = InvalidFile;
+
+        if (request.readFailed || request.cancelled.load(std::memory_order_relaxed))
+        {
+            RecycleBuffer(request.data);
+            Complete(request);
+            return;
+        }
+
+        request.state.store(AssetState::Decoding, std::memory_order_relaxed);
+        Common::JobSystem::Get().Schedule({ &AssetStreamer::DecodeJob, &request, &m_decodeJobs });
+    }
+
+    void AssetStreamer::DecodeJob(void* data)
+    {
+        Request& request = *static_cast<Request*>(data);
+        AssetStreamer& streamer = *request.streamer;
+        TRACE_SCOPE("AssetStreamer::Decode");
+
+        if (!request.cancelled.load(std::memory_order_relaxed))
+        {
+            const uint8_t* data = request.data.data();
+            if (request.entry != nullptr && request.entry->compression == ArchiveCompression::None)
+            {
+                data = request.archive->GetData(*request.entry) + request.rangeOffset;
+            }
+            else if (request.entry != nullptr)
+            {
+                streamer.AcquireBuffer(request.data, request.entry->rawSize);
+                data = request.archive->Read(*request.entry, request.data.data()) ? request.data.data() + request.rangeOffset : nullptr;
+            }
+
+            const AssetLoader& loader = streamer.m_loaders[request.type];
+            request.asset = data != nullptr ? loader.decode(loader.context, data, request.size, request.settings) : nullptr;
+            request.state.store(request.asset != nullptr ? AssetState::Uploading : AssetState::Failed, std::memory_order_relaxed);
+        }
+        streamer.RecycleBuffer(request.data);
+        streamer.Complete(request);
+    }
+
+    void AssetStreamer::AcquireBuffer(std::vector<uint8_t>& buffer, uint64_t size)
+    {
+        {
+            // the smallest pooled buffer that fits.
+            std::lock_guard<std::mutex> lock(m_bufferMutex);
+            size_t best = m_buffers.size();
+            for (size_t i = 0; i < m_buffers.size(); i++)
+            {
+                const size_t capacity = m_buffers[i].capacity();
+                if (capacity >= size && (best == m_buffers.size() || capacity < m_buffers[best].capacity()))
+                {
+                    best = i;
+                }
+            }
+            if (best < m_buffers.size())
+            {
+                m_bufferBytes -= m_buffers[best].capacity();
+                buffer.swap(m_buffers[best]);
+                m_buffers[best].swap(m_buffers.back());
+                m_buffers.pop_back();
+            }
+        }
+        buffer.resize(size);
+    }
+
+    void AssetStreamer::RecycleBuffer(std::vector<uint8_t>& buffer)
+    {
+        std::vector<uint8_t> recycled;
+        recycled.swap(buffer);
+        recycled.clear();
+
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        if (recycled.capacity() > 0 && m_bufferBytes + recycled.capacity() <= m_config.bufferPoolSize)
+        {
+            m_bufferBytes += recycled.capacity();
+            m_buffers.push_back(std::move(recycled));
+        }
+    }
+
+    void AssetStreamer::Complete(Request& request)
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_completed.push_back(request.slot);
+    }
+}
@@ -0,0 +1,394 @@
+#include <ANTUTU/Asset/AsyncFileReader.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Android has the header too, but its seccomp policy rejects the syscalls.
+#if defined(ANTUTU_SYSTEM_LINUX) && __has_include(<linux/io_uring.h>)
+    #define ANTUTU_IO_URING 1
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <atomic>
+#else
+    #define ANTUTU_IO_URING 0
+#endif
+
+namespace att::Asset
+{
+    ////////////////////////////////////////////////////////////////////////////
+    /// io_uring
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct AsyncFileReader::Ring
+    {
+#if ANTUTU_IO_URING
+        int fd = -1;
+        void* sqMap = MAP_FAILED;
+        size_t sqMapSize = 0;
+        void* cqMap = MAP_FAILED;
+        size_t cqMapSize = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        size_t sqesSize = 0;
+
+        // shared with the kernel: we produce the sq tail and consume the cq head.
+        uint32_t* sqHead = nullptr;
+        uint32_t* sqTail = nullptr;
+        uint32_t* sqArray = nullptr;
+        uint32_t sqMask = 0;
+        uint32_t sqEntries = 0;
+        uint32_t* cqHead = nullptr;
+        uint32_t* cqTail = nullptr;
+        io_uring_cqe* cqes = nullptr;
+        uint32_t cqMask = 0;
+
+        ~Ring()
+        {
+            if (sqes != MAP_FAILED)
+            {
+                munmap(sqes, sqesSize);
+            }
+            if (cqMap != MAP_FAILED && cqMap != sqMap)
+            {
+                munmap(cqMap, cqMapSize);
+            }
+            if (sqMap != MAP_FAILED)
+            {
+                munmap(sqMap, sqMapSize);
+            }
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+
+        int Enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags) const
+        {
+            return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+        }
+#endif
+    };
+
+    AsyncFileReader::AsyncFileReader() = default;
+
+    AsyncFileReader::~AsyncFileReader()
+    {
+        Shutdown();
+    }
+
+    bool AsyncFileReader::Initialize(uint32_t queueDepth, bool allowIoUring)
+    {
+        assert(queueDepth > 0);
+        Shutdown();
+        m_queueDepth = queueDepth;
+        if (!allowIoUring || !CreateRing(queueDepth))
+        {
+            m_ring.reset();
+            m_pending.reserve(queueDepth);
+            m_completed.reserve(queueDepth);
+        }
+        return true;
+    }
+
+    void AsyncFileReader::Shutdown()
+    {
+        // the kernel may still be writing into the buffers of reads in flight.
+        FileReadResult results[32];
+        while (m_inFlight > 0 && Reap(results, 32, true) > 0)
+        {
+        }
+        m_ring.reset();
+        m_pending.clear();
+        m_completed.clear();
+        m_unflushed = 0;
+    }
+
+    bool AsyncFileReader::CreateRing(uint32_t queueDepth)
+    {
+#if ANTUTU_IO_URING
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        const int fd = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        auto ring = std::make_unique<Ring>();
+        ring->fd = fd;
+        // FAST_POLL came with 5.7, one release after IORING_OP_READ.
+        if ((params.features & IORING_FEAT_FAST_POLL) == 0)
+        {
+            return false;
+        }
+
+        ring->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        ring->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap)
+        {
+            ring->sqMapSize = ring->cqMapSize = std::max(ring->sqMapSize, ring->cqMapSize);
+        }
+
+        ring->sqMap = mmap(nullptr, ring->sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (ring->sqMap == MAP_FAILED)
+        {
+            return false;
+        }
+        ring->cqMap = singleMap
+            ? ring->sqMap
+            : mmap(nullptr, ring->cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cqMap == MAP_FAILED)
+        {
+            return false;
+        }
+        ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe*>(
+            mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (ring->sqes == MAP_FAILED)
+        {
+            return false;
+        }
+
+        uint8_t* sq = static_cast<uint8_t*>(ring->sqMap);
+        uint8_t* cq = static_cast<uint8_t*>(ring->cqMap);
+        ring->sqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+        ring->sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        ring->sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+        ring->sqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        ring->sqEntries = params.sq_entries;
+        ring->cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        ring->cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        ring->cqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+
+        // the sq may be rounded up, never keep more in flight than the cq holds.
+        m_queueDepth = std::min(queueDepth, params.sq_entries);
+        m_ring = std::move(ring);
+        return true;
+#else
+        (void)queueDepth;
+        return false;
+#endif
+    }
+
+    const char* AsyncFileReader::GetBackendName() const
+    {
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        return "ReadFile";
+#else
+        return m_ring ? "io_uring" : "pread";
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Files
+    ////////////////////////////////////////////////////////////////////////////
+
+    FileHandle AsyncFileReader::Open(const char* path, uint64_t* outSize)
+    {
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return InvalidFile;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return InvalidFile;
+        }
+        if (outSize != nullptr)
+        {
+            *outSize = static_cast<uint64_t>(size.QuadPart);
+        }
+        return reinterpret_cast<FileHandle>(file);
+#else
+        const int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return InvalidFile;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            close(fd);
+            return InvalidFile;
+        }
+        if (outSize != nullptr)
+        {
+            *outSize = static_cast<uint64_t>(info.st_size);
+        }
+        return fd;
+#endif
+    }
+
+    void AsyncFileReader::Close(FileHandle file)
+    {
+        if (file == InvalidFile)
+        {
+            return;
+        }
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        CloseHandle(reinterpret_cast<HANDLE>(file));
+#else
+        close(static_cast<int>(file));
+#endif
+    }
+
+    static int64_t ReadAt(const FileRead& read)
+    {
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(read.offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(read.offset >> 32);
+        DWORD bytes = 0;
+        if (!ReadFile(reinterpret_cast<HANDLE>(read.file), read.buffer, read.size, &bytes, &overlapped))
+        {
+            const DWORD error = GetLastError();
+            return error == ERROR_HANDLE_EOF ? 0 : -static_cast<int64_t>(error);
+        }
+        return bytes;
+#else
+        for (;;)
+        {
+            const ssize_t bytes = pread(static_cast<int>(read.file), read.buffer, read.size, static_cast<off_t>(read.offset));
+            if (bytes >= 0 || errno != EINTR)
+            {
+                return bytes >= 0 ? bytes : -errno;
+            }
+        }
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Reads
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool AsyncFileReader::Submit(const FileRead& read)
+    {
+        if (m_inFlight >= m_queueDepth)
+        {
+            return false;
+        }
+
+#if ANTUTU_IO_URING
+        if (m_ring)
+        {
+            Ring& ring = *m_ring;
+            const uint32_t tail = *ring.sqTail;
+            const uint32_t index = tail & ring.sqMask;
+            io_uring_sqe& sqe = ring.sqes[index];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = static_cast<int>(read.file);
+            sqe.off = read.offset;
+            sqe.addr = reinterpret_cast<uint64_t>(read.buffer);
+            sqe.len = read.size;
+            sqe.user_data = read.userData;
+            ring.sqArray[index] = index;
+            // publishes the entry to the kernel.
+            std::atomic_ref<uint32_t>(*ring.sqTail).store(tail + 1, std::memory_order_release);
+            m_unflushed++;
+            m_inFlight++;
+            return true;
+        }
+#endif
+
+        m_pending.push_back(read);
+        m_inFlight++;
+        return true;
+    }
+
+    void AsyncFileReader::Flush()
+    {
+#if ANTUTU_IO_URING
+        if (m_ring)
+        {
+            while (m_unflushed > 0)
+            {
+                const int submitted = m_ring->Enter(m_unflushed, 0, 0);
+                if (submitted < 0)
+                {
+                    // EAGAIN / EBUSY: out of kernel resources, the next Flush retries.
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return;
+                }
+                m_unflushed -= static_cast<uint32_t>(submitted);
+            }
+            return;
+        }
+#endif
+
+        for (const FileRead& read : m_pending)
+        {
+            m_completed.push_back({ read.userData, ReadAt(read) });
+        }
+        m_pending.clear();
+    }
+
+    uint32_t AsyncFileReader::Reap(FileReadResult* out, uint32_t capacity, bool wait)
+    {
+#if ANTUTU_IO_URING
+        if (m_ring)
+        {
+            Ring& ring = *m_ring;
+            uint32_t count = 0;
+            for (;;)
+            {
+                uint32_t head = *ring.cqHead;
+                const uint32_t tail = std::atomic_ref<uint32_t>(*ring.cqTail).load(std::memory_order_acquire);
+                for (; head != tail && count < capacity; head++)
+                {
+                    const io_uring_cqe& cqe = ring.cqes[head & ring.cqMask];
+                    out[count++] = { cqe.user_data, cqe.res };
+                }
+                std::atomic_ref<uint32_t>(*ring.cqHead).store(head, std::memory_order_release);
+
+                if (count > 0 || !wait || m_inFlight == 0)
+                {
+                    break;
+                }
+                // also submits whatever Submit queued since the last Flush.
+                const int submitted = ring.Enter(m_unflushed, 1, IORING_ENTER_GETEVENTS);
+                if (submitted > 0)
+                {
+                    m_unflushed -= static_cast<uint32_t>(submitted);
+                }
+                else if (submitted < 0 && errno != EINTR && m_unflushed == m_inFlight)
+                {
+                    // nothing reached the kernel and it won't take it, don't spin forever.
+                    break;
+                }
+            }
+            m_inFlight -= count;
+            return count;
+        }
+#endif
+
+        if (wait && m_completed.empty())
+        {
+            Flush();
+        }
+        const uint32_t count = std::min(capacity, static_cast<uint32_t>(m_completed.size()));
+        std::copy(m_completed.begin(), m_completed.begin() + count, out);
+        m_completed.erase(m_completed.begin(), m_completed.begin() + count);
+        m_inFlight -= count;
+        return count;
+    }
+}
@@ -0,0 +1,134 @@
+#include <ANTUTU/Asset/Compression.hpp>
+
+#include <climits>
+#include <cstring>
+
+#if defined(ANTUTU_LZ4)
+    #include <lz4.h>
+    #include <lz4hc.h>
+#endif
+#if defined(ANTUTU_ZSTD)
+    #include <zstd.h>
+#endif
+
+namespace att::Asset
+{
+    const char* GetCompressionName(ArchiveCompression compression)
+    {
+        switch (compression)
+        {
+        case ArchiveCompression::None: return "none";
+        case ArchiveCompression::LZ4: return "lz4";
+        case ArchiveCompression::Zstd: return "zstd";
+        }
+        return "unknown";
+    }
+
+    bool IsCompressionSupported(ArchiveCompression compression)
+    {
+        switch (compression)
+        {
+        case ArchiveCompression::None: return true;
+#if defined(ANTUTU_LZ4)
+        case ArchiveCompression::LZ4: return true;
+#endif
+#if defined(ANTUTU_ZSTD)
+        case ArchiveCompression::Zstd: return true;
+#endif
+        default: return false;
+        }
+    }
+
+    uint64_t GetCompressBound(ArchiveCompression compression, uint64_t size)
+    {
+        switch (compression)
+        {
+        case ArchiveCompression::None:
+            return size;
+#if defined(ANTUTU_LZ4)
+        case ArchiveCompression::LZ4:
+            return size <= LZ4_MAX_INPUT_SIZE ? static_cast<uint64_t>(LZ4_compressBound(static_cast<int>(size))) : 0;
+#endif
+#if defined(ANTUTU_ZSTD)
+        case ArchiveCompression::Zstd:
+            return ZSTD_compressBound(static_cast<size_t>(size));
+#endif
+        default:
+            return 0;
+        }
+    }
+
+    uint64_t Compress(ArchiveCompression compression, const void* source, uint64_t size,
+                      void* destination, uint64_t capacity, [[maybe_unused]] int level)
+    {
+        switch (compression)
+        {
+        case ArchiveCompression::None:
+            if (capacity < size)
+            {
+                return 0;
+            }
+            if (size > 0)
+            {
+                memcpy(destination, source, size);
+            }
+            return size;
+#if defined(ANTUTU_LZ4)
+        case ArchiveCompression::LZ4:
+        {
+            if (size > LZ4_MAX_INPUT_SIZE)
+            {
+                return 0;
+            }
+            const int written = LZ4_compress_HC(static_cast<const char*>(source), static_cast<char*>(destination),
+                                                static_cast<int>(size), static_cast<int>(capacity < INT_MAX ? capacity : INT_MAX),
+                                                level > 0 ? level : LZ4HC_CLEVEL_DEFAULT);
+            return written > 0 ? static_cast<uint64_t>(written) : 0;
+        }
+#endif
+#if defined(ANTUTU_ZSTD)
+        case ArchiveCompression::Zstd:
+        {
+            const size_t written = ZSTD_compress(destination, static_cast<size_t>(capacity), source, static_cast<size_t>(size),
+                                                 level > 0 ? level : 19);
+            return ZSTD_isError(written) ? 0 : written;
+        }
+#endif
+        default:
+            return 0;
+        }
+    }
+
+    bool Decompress(ArchiveCompression compression, const void* source, uint64_t size,
+                    void* destination, uint64_t rawSize)
+    {
+        switch (compression)
+        {
+        case ArchiveCompression::None:
+            if (size != rawSize)
+            {
+                return false;
+            }
+            if (size > 0)
+            {
+                memcpy(destination, source, size);
+            }
+            return true;
+#if defined(ANTUTU_LZ4)
+        case ArchiveCompression::LZ4:
+            return size <= INT_MAX && rawSize <= INT_MAX &&
+                   LZ4_decompress_safe(static_cast<const char*>(source), static_cast<char*>(destination),
+                                       static_cast<int>(size), static_cast<int>(rawSize)) == static_cast<int>(rawSize);
+#endif
+#if defined(ANTUTU_ZSTD)
+        case ArchiveCompression::Zstd:
+        {
+            const size_t written = ZSTD_decompress(destination, static_cast<size_t>(rawSize), source, static_cast<size_t>(size));
+            return !ZSTD_isError(written) && written == rawSize;
+        }
+#endif
+        default:
+            return false;
+        }
+    }
+}
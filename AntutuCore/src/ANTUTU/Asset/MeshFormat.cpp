@@ -0,0 +1,119 @@
+#include <ANTUTU/Asset/MeshFormat.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace att::Asset
+{
+    static constexpr float Pi = 3.14159265358979f;
+
+    bool ParseCookedMesh(const void* data, uint64_t size, CookedMeshView& view)
+    {
+        view = {};
+        if (data == nullptr || size < sizeof(CookedMeshHeader))
+        {
+            return false;
+        }
+
+        const CookedMeshHeader* header = static_cast<const CookedMeshHeader*>(data);
+        if (header->magic != CookedMeshMagic || header->version != CookedMeshVersion ||
+            header->lodCount == 0 || header->lodCount > CookedMeshMaxLods)
+        {
+            return false;
+        }
+
+        const uint64_t indexSize = (header->flags & CookedMeshIndex16) != 0 ? 2 : 4;
+        const uint64_t vertexBytes = static_cast<uint64_t>(header->vertexCount) * sizeof(PackedVertex);
+        const uint64_t indexBytes = static_cast<uint64_t>(header->indexCount) * indexSize;
+        if (header->vertexOffset % alignof(PackedVertex) != 0 || header->indexOffset % indexSize != 0 ||
+            header->vertexOffset < sizeof(CookedMeshHeader) || header->vertexOffset > size ||
+            vertexBytes > size - header->vertexOffset ||
+            header->indexOffset > size || indexBytes > size - header->indexOffset)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < header->lodCount; i++)
+        {
+            const CookedMeshLod& lod = header->lods[i];
+            if (lod.indexCount % 3 != 0 || lod.indexOffset > header->indexCount ||
+                lod.indexCount > header->indexCount - lod.indexOffset)
+            {
+                return false;
+            }
+        }
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        view.header = header;
+        view.vertices = reinterpret_cast<const PackedVertex*>(bytes + header->vertexOffset);
+        view.indices = bytes + header->indexOffset;
+        view.vertexBytes = vertexBytes;
+        view.indexBytes = indexBytes;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Normal packing, mirrored by shaders/PackedVertex.glsl
+    ////////////////////////////////////////////////////////////////////////////
+
+    static glm::vec3 OctDecode(glm::vec2 e)
+    {
+        glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        const float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    // the reference the tangent angle is measured from, a function of the normal alone.
+    static void GetTangentBasis(const glm::vec3& normal, glm::vec3& tangent, glm::vec3& bitangent)
+    {
+        tangent = std::abs(normal.x) > std::abs(normal.z) ? glm::vec3(-normal.y, normal.x, 0.0f)
+                                                          : glm::vec3(0.0f, -normal.z, normal.y);
+        tangent = glm::normalize(tangent);
+        bitangent = glm::cross(normal, tangent);
+    }
+
+    static uint32_t QuantizeUnorm(float value, uint32_t maximum)
+    {
+        return static_cast<uint32_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * static_cast<float>(maximum)));
+    }
+
+    uint32_t PackNormalTangent(const glm::vec3& normal, const glm::vec3& tangent, float bitangentSign)
+    {
+        const glm::vec3 n = normal / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+        glm::vec2 e(n.x, n.y);
+        if (n.z < 0.0f)
+        {
+            e = glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+        }
+        const uint32_t x = QuantizeUnorm(e.x * 0.5f + 0.5f, 1023);
+        const uint32_t y = QuantizeUnorm(e.y * 0.5f + 0.5f, 1023);
+
+        // the angle around the normal the decoder will see, not the exact one.
+        const glm::vec3 decoded = OctDecode(glm::vec2(x, y) / 1023.0f * 2.0f - 1.0f);
+        glm::vec3 referenceTangent, referenceBitangent;
+        GetTangentBasis(decoded, referenceTangent, referenceBitangent);
+        const float angle = std::atan2(glm::dot(tangent, referenceBitangent), glm::dot(tangent, referenceTangent));
+        const uint32_t a = QuantizeUnorm(angle / (2.0f * Pi) + 0.5f, 1023);
+        const uint32_t w = bitangentSign < 0.0f ? 0 : 3;
+
+        return x | (y << 10) | (a << 20) | (w << 30);
+    }
+
+    glm::vec3 UnpackNormal(uint32_t packed)
+    {
+        const glm::vec2 e(static_cast<float>(packed & 1023), static_cast<float>((packed >> 10) & 1023));
+        return OctDecode(e / 1023.0f * 2.0f - 1.0f);
+    }
+
+    glm::vec4 UnpackTangent(uint32_t packed)
+    {
+        const glm::vec3 normal = UnpackNormal(packed);
+        glm::vec3 referenceTangent, referenceBitangent;
+        GetTangentBasis(normal, referenceTangent, referenceBitangent);
+        const float angle = (static_cast<float>((packed >> 20) & 1023) / 1023.0f - 0.5f) * 2.0f * Pi;
+        const glm::vec3 tangent = referenceTangent * std::cos(angle) + referenceBitangent * std::sin(angle);
+        return glm::vec4(tangent, (packed >> 30) != 0 ? 1.0f : -1.0f);
+    }
+}
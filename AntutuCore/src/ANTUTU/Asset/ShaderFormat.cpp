@@ -0,0 +1,72 @@
+#include <ANTUTU/Asset/ShaderFormat.hpp>
+
+#include <cstring>
+
+namespace att::Asset
+{
+    static constexpr uint32_t SpirvMagic = 0x07230203;
+
+    const char* GetShaderStageName(uint32_t stage)
+    {
+        switch (stage)
+        {
+        case ShaderStageVertex:
+            return "vertex";
+        case ShaderStageTessControl:
+            return "tess control";
+        case ShaderStageTessEvaluation:
+            return "tess evaluation";
+        case ShaderStageGeometry:
+            return "geometry";
+        case ShaderStageFragment:
+            return "fragment";
+        case ShaderStageCompute:
+            return "compute";
+        case ShaderStageTask:
+            return "task";
+        case ShaderStageMesh:
+            return "mesh";
+        case ShaderStageRayGen:
+            return "ray generation";
+        case ShaderStageAnyHit:
+            return "any hit";
+        case ShaderStageClosestHit:
+            return "closest hit";
+        case ShaderStageMiss:
+            return "miss";
+        case ShaderStageIntersection:
+            return "intersection";
+        case ShaderStageCallable:
+            return "callable";
+        default:
+            return "unknown";
+        }
+    }
+
+    const CookedShaderHeader* ParseCookedShader(const void* data, uint64_t size)
+    {
+        if (data == nullptr || size < sizeof(CookedShaderHeader) || reinterpret_cast<uintptr_t>(data) % 16 != 0)
+        {
+            return nullptr;
+        }
+
+        const CookedShaderHeader* header = static_cast<const CookedShaderHeader*>(data);
+        if (header->magic != CookedShaderMagic || header->version != CookedShaderVersion ||
+            header->stage == 0 || (header->stage & (header->stage - 1)) != 0 ||
+            memchr(header->entryPoint, 0, CookedShaderMaxEntryPoint) == nullptr)
+        {
+            return nullptr;
+        }
+
+        // the tables, then the code after them.
+        const uint64_t tablesEnd = sizeof(CookedShaderHeader) + uint64_t(header->bindingCount) * sizeof(CookedShaderBinding) +
+                                   uint64_t(header->vertexInputCount) * sizeof(CookedShaderVertexInput);
+        if (header->codeOffset % 16 != 0 || header->codeOffset < tablesEnd || header->codeSize < 20 ||
+            header->codeSize % 4 != 0 || uint64_t(header->codeOffset) + header->codeSize > size ||
+            GetShaderCode(*header)[0] != SpirvMagic)
+        {
+            return nullptr;
+        }
+        return header;
+    }
+}
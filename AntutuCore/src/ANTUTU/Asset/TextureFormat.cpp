@@ -0,0 +1,86 @@
+#include <ANTUTU/Asset/TextureFormat.hpp>
+
+#include <algorithm>
+
+namespace att::Asset
+{
+    uint32_t GetTextureBlockSize(TextureFormat format)
+    {
+        return format == TextureFormat::RGBA8 || format == TextureFormat::RGBA8Srgb ? 1 : 4;
+    }
+
+    uint32_t GetTextureBlockBytes(TextureFormat format)
+    {
+        switch (format)
+        {
+        case TextureFormat::RGBA8:
+        case TextureFormat::RGBA8Srgb:
+            return 4;
+        case TextureFormat::BC1:
+        case TextureFormat::BC1Srgb:
+            return 8;
+        default:
+            return 16;
+        }
+    }
+
+    uint64_t GetTextureMipBytes(TextureFormat format, uint32_t width, uint32_t height)
+    {
+        const uint32_t block = GetTextureBlockSize(format);
+        const uint64_t blocksX = (width + block - 1) / block;
+        const uint64_t blocksY = (height + block - 1) / block;
+        return blocksX * blocksY * GetTextureBlockBytes(format);
+    }
+
+    bool IsTextureFormatSrgb(TextureFormat format)
+    {
+        return format == TextureFormat::RGBA8Srgb || format == TextureFormat::BC1Srgb || format == TextureFormat::BC3Srgb ||
+               format == TextureFormat::BC7Srgb || format == TextureFormat::ASTC4x4Srgb;
+    }
+
+    const char* GetTextureFormatName(TextureFormat format)
+    {
+        static const char* names[] = {
+            "RGBA8", "RGBA8_SRGB", "BC1", "BC1_SRGB", "BC3", "BC3_SRGB", "BC5", "BC7", "BC7_SRGB", "ASTC4x4", "ASTC4x4_SRGB"
+        };
+        static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(TextureFormat::Count));
+        return format < TextureFormat::Count ? names[static_cast<uint32_t>(format)] : "unknown";
+    }
+
+    const CookedTextureHeader* ParseCookedTexture(const void* data, uint64_t size)
+    {
+        if (data == nullptr || size < sizeof(CookedTextureHeader))
+        {
+            return nullptr;
+        }
+
+        const CookedTextureHeader* header = static_cast<const CookedTextureHeader*>(data);
+        if (header->magic != CookedTextureMagic || header->version != CookedTextureVersion ||
+            header->format >= TextureFormat::Count || header->mipCount == 0 || header->mipCount > CookedTextureMaxMips ||
+            header->tailMip >= header->mipCount || header->width == 0 || header->height == 0 ||
+            header->width > (1u << (CookedTextureMaxMips - 1)) || header->height > (1u << (CookedTextureMaxMips - 1)))
+        {
+            return nullptr;
+        }
+
+        // smallest first, every mip after the previous one.
+        uint64_t end = sizeof(CookedTextureHeader);
+        for (uint32_t i = header->mipCount; i > 0; i--)
+        {
+            const CookedTextureMip& mip = header->mips[i - 1];
+            const uint32_t width = std::max(header->width >> (i - 1), 1u);
+            const uint32_t height = std::max(header->height >> (i - 1), 1u);
+            if (mip.width != width || mip.height != height || mip.offset % 16 != 0 || mip.offset < end ||
+                mip.size != GetTextureMipBytes(header->format, width, height))
+            {
+                return nullptr;
+            }
+            end = mip.offset + mip.size;
+            if (i - 1 == header->tailMip && end != header->tailSize)
+            {
+                return nullptr;
+            }
+        }
+        return header->tailSize <= size ? header : nullptr;
+    }
+}
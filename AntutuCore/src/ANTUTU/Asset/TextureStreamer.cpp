@@ -0,0 +1,477 @@
+#include <ANTUTU/Asset/TextureStreamer.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Stats.h>
+#include <Common/Profiler/Tracer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace att::Asset
+{
+    // the first read of a texture: header and tail of most formats, 128x128 and below is
+    // 22 KB in BC7. A larger tail takes a second read.
+    static constexpr uint64_t InitialReadSize = 64 * 1024;
+    static constexpr uint64_t MaxHeadSize = 16ull << 20;
+    // StreamedData::mip of the header read.
+    static constexpr uint32_t HeadRead = CookedTextureMaxMips;
+
+    static uint32_t SlotOf(TextureHandle handle)
+    {
+        return static_cast<uint32_t>(handle);
+    }
+
+    static TextureHandle MakeHandle(uint32_t slot, uint32_t generation)
+    {
+        return (static_cast<uint64_t>(generation) << 32) | slot;
+    }
+
+    // AssetLoader settings of a read: generation, slot and mip.
+    static uint64_t PackRead(uint32_t slot, uint32_t generation, uint32_t mip)
+    {
+        return (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(slot) << 5) | mip;
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        Shutdown();
+    }
+
+    void TextureStreamer::Initialize(AssetStreamer& streamer, uint32_t assetType, const TextureStreamingCallbacks& callbacks,
+                                     const TextureStreamerConfig& config)
+    {
+        assert(callbacks.create != nullptr && callbacks.upload != nullptr && callbacks.evict != nullptr);
+        m_streamer = &streamer;
+        m_assetType = assetType;
+        m_callbacks = callbacks;
+        m_config = config;
+        m_config.maxRequests = std::max(m_config.maxRequests, 1u);
+        m_frame = 0;
+        m_stats = {};
+        streamer.RegisterLoader(assetType, { &TextureStreamer::DecodeRead, &TextureStreamer::UploadRead,
+                                             &TextureStreamer::ReleaseRead, this });
+    }
+
+    void TextureStreamer::Shutdown()
+    {
+        for (Texture& texture : m_textures)
+        {
+            if (texture.state != TextureState::None)
+            {
+                Destroy(texture);
+            }
+        }
+        m_textures.clear();
+        m_freeSlots.clear();
+        m_streamer = nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Textures (owner thread)
+    ////////////////////////////////////////////////////////////////////////////
+
+    TextureHandle TextureStreamer::Open(const std::string& path, float priority)
+    {
+        assert(m_streamer != nullptr);
+
+        uint32_t slot;
+        if (!m_freeSlots.empty())
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_textures.size());
+            assert(slot < (1u << 27) && "slot doesn't fit the read settings");
+            m_textures.emplace_back();
+        }
+
+        Texture& texture = m_textures[slot];
+        const uint32_t generation = texture.generation;
+        texture = {};
+        texture.path = path;
+        texture.generation = generation;
+        texture.state = TextureState::LoadingHead;
+        texture.priority = priority;
+        texture.pending = m_streamer->LoadRange(path, m_assetType, 0, InitialReadSize, priority, PackRead(slot, generation, HeadRead));
+        texture.pendingMip = HeadRead;
+        m_stats.textures++;
+        return MakeHandle(slot, generation);
+    }
+
+    void TextureStreamer::Close(TextureHandle handle)
+    {
+        if (Texture* texture = Find(handle))
+        {
+            Destroy(*texture);
+        }
+    }
+
+    void TextureStreamer::ReportScreenSize(TextureHandle handle, float pixels)
+    {
+        Texture* texture = Find(handle);
+        if (texture == nullptr || texture->state != TextureState::Ready || !(pixels > 0.0f))
+        {
+            return;
+        }
+        const float size = static_cast<float>(std::max(texture->header.width, texture->header.height));
+        const float mip = std::floor(std::log2(size / pixels) + m_config.mipBias);
+        texture->frameMip = std::min(texture->frameMip, static_cast<uint32_t>(std::clamp(mip, 0.0f, static_cast<float>(CookedTextureMaxMips))));
+    }
+
+    void TextureStreamer::ReportMip(TextureHandle handle, uint32_t mip)
+    {
+        if (Texture* texture = Find(handle))
+        {
+            texture->frameMip = std::min(texture->frameMip, mip);
+        }
+    }
+
+    void* TextureStreamer::GetTexture(TextureHandle handle) const
+    {
+        const Texture* texture = Find(handle);
+        return texture != nullptr && texture->state == TextureState::Ready ? texture->texture : nullptr;
+    }
+
+    const CookedTextureHeader* TextureStreamer::GetHeader(TextureHandle handle) const
+    {
+        const Texture* texture = Find(handle);
+        return texture != nullptr && texture->state == TextureState::Ready ? &texture->header : nullptr;
+    }
+
+    uint32_t TextureStreamer::GetResidentMip(TextureHandle handle) const
+    {
+        const Texture* texture = Find(handle);
+        return texture != nullptr ? texture->residentMip : CookedTextureMaxMips;
+    }
+
+    uint32_t TextureStreamer::GetWantedMip(TextureHandle handle) const
+    {
+        const Texture* texture = Find(handle);
+        return texture != nullptr && texture->state == TextureState::Ready
+            ? std::clamp(texture->wantedMip, texture->minMip, texture->header.tailMip)
+            : CookedTextureMaxMips;
+    }
+
+    TextureStreamer::Texture* TextureStreamer::Find(TextureHandle handle) const
+    {
+        const uint32_t slot = SlotOf(handle);
+        if (slot >= m_textures.size())
+        {
+            return nullptr;
+        }
+        const Texture& texture = m_textures[slot];
+        if (texture.generation != static_cast<uint32_t>(handle >> 32) || texture.state == TextureState::None)
+        {
+            return nullptr;
+        }
+        return const_cast<Texture*>(&texture);
+    }
+
+    void TextureStreamer::Destroy(Texture& texture)
+    {
+        if (texture.pending != InvalidAsset)
+        {
+            // the streamer releases the data once the read comes back.
+            m_streamer->Unload(texture.pending);
+            if (texture.pendingMip != HeadRead)
+            {
+                m_pendingBytes -= texture.header.mips[texture.pendingMip].size;
+            }
+        }
+        if (texture.texture != nullptr && m_callbacks.destroy != nullptr)
+        {
+            m_callbacks.destroy(m_callbacks.context, texture.texture);
+        }
+        m_stats.residentBytes -= texture.residentBytes;
+        m_stats.textures--;
+
+        const uint32_t slot = static_cast<uint32_t>(&texture - m_textures.data());
+        const uint32_t generation = texture.generation + 1 == 0 ? 1 : texture.generation + 1;
+        texture = {};
+        texture.generation = generation;
+        m_freeSlots.push_back(slot);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Streaming
+    ////////////////////////////////////////////////////////////////////////////
+
+    void TextureStreamer::Update()
+    {
+        TRACE_FUNCTION();
+        m_frame++;
+
+        // the reads that came back, what every texture wants now; mips not wanted any
+        // more go first so the loads below see the memory they freed.
+        for (Texture& texture : m_textures)
+        {
+            if (texture.state == TextureState::None)
+            {
+                continue;
+            }
+            Poll(texture);
+            if (texture.state != TextureState::Ready)
+            {
+                continue;
+            }
+            UpdateWanted(texture);
+
+            const uint32_t target = std::clamp(texture.wantedMip, texture.minMip, texture.header.tailMip);
+            if (texture.pending != InvalidAsset && texture.pendingMip < target)
+            {
+                m_streamer->Unload(texture.pending);
+                m_pendingBytes -= texture.header.mips[texture.pendingMip].size;
+                texture.pending = InvalidAsset;
+            }
+            while (texture.residentMip < target)
+            {
+                EvictOne(texture);
+            }
+        }
+
+        // the textures furthest from what the screen asks for first, weighted by their priority.
+        m_candidates.clear();
+        uint32_t inFlight = 0;
+        for (uint32_t slot = 0; slot < m_textures.size(); slot++)
+        {
+            const Texture& texture = m_textures[slot];
+            inFlight += texture.pending != InvalidAsset ? 1 : 0;
+            if (texture.state != TextureState::Ready || texture.pending != InvalidAsset)
+            {
+                continue;
+            }
+            const uint32_t target = std::clamp(texture.wantedMip, texture.minMip, texture.header.tailMip);
+            if (texture.residentMip > target)
+            {
+                m_candidates.emplace_back(static_cast<float>(texture.residentMip - target) * texture.priority, slot);
+            }
+        }
+        std::sort(m_candidates.begin(), m_candidates.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        m_stats.starved = 0;
+        for (const auto& [score, slot] : m_candidates)
+        {
+            Texture& texture = m_textures[slot];
+            const uint32_t mip = texture.residentMip - 1;
+            const CookedTextureMip& range = texture.header.mips[mip];
+            if (inFlight >= m_config.maxRequests ||
+                (m_stats.residentBytes + m_pendingBytes + range.size > m_config.memoryBudget && !MakeRoom(range.size, score, texture)))
+            {
+                m_stats.starved++;
+                continue;
+            }
+
+            texture.pending = m_streamer->LoadRange(texture.path, m_assetType, range.offset, range.size, score,
+                                                    PackRead(slot, texture.generation, mip));
+            texture.pendingMip = mip;
+            m_pendingBytes += range.size;
+            m_stats.requests++;
+            inFlight++;
+        }
+
+        m_stats.requestsInFlight = inFlight;
+        STATS_SET(Common::Stats::TextureStreamedBytes, m_stats.residentBytes);
+    }
+
+    void TextureStreamer::Poll(Texture& texture)
+    {
+        if (texture.pending == InvalidAsset)
+        {
+            return;
+        }
+        const AssetState state = m_streamer->GetState(texture.pending);
+        if (state != AssetState::Ready && state != AssetState::Failed)
+        {
+            return;
+        }
+
+        // the upload callback already did the work, the data can go.
+        m_streamer->Unload(texture.pending);
+        texture.pending = InvalidAsset;
+        const bool head = texture.pendingMip == HeadRead;
+        if (!head)
+        {
+            m_pendingBytes -= texture.header.mips[texture.pendingMip].size;
+        }
+
+        if (state == AssetState::Failed)
+        {
+            if (head)
+            {
+                LOG_WARN("TextureStreamer: can't read {}", texture.path);
+                texture.state = TextureState::Failed;
+            }
+            else
+            {
+                LOG_WARN("TextureStreamer: can't read mip {} of {}", texture.pendingMip, texture.path);
+                texture.minMip = texture.pendingMip + 1;
+            }
+        }
+        else if (head && texture.headIncomplete)
+        {
+            texture.pending = m_streamer->LoadRange(texture.path, m_assetType, 0, texture.header.tailSize, texture.priority,
+                                                    PackRead(static_cast<uint32_t>(&texture - m_textures.data()), texture.generation, HeadRead));
+        }
+    }
+
+    void TextureStreamer::UpdateWanted(Texture& texture)
+    {
+        // finer right away, coarser once nothing asked for the finer mip during keepFrames.
+        if (texture.frameMip <= texture.wantedMip || m_frame - texture.wantedFrame >= m_config.keepFrames)
+        {
+            texture.wantedMip = texture.frameMip;
+            texture.wantedFrame = m_frame;
+        }
+        texture.frameMip = CookedTextureMaxMips;
+    }
+
+    void TextureStreamer::EvictOne(Texture& texture)
+    {
+        assert(texture.residentMip < texture.header.tailMip && texture.pending == InvalidAsset);
+        const uint64_t bytes = texture.header.mips[texture.residentMip].size;
+        texture.residentMip++;
+        texture.residentBytes -= bytes;
+        m_stats.residentBytes -= bytes;
+        m_stats.evictions++;
+        m_callbacks.evict(m_callbacks.context, texture.texture, texture.residentMip);
+    }
+
+    bool TextureStreamer::MakeRoom(uint64_t bytes, float score, const Texture& requester)
+    {
+        // from the texture that would be least short without its finest mip, as long as it
+        // stays less short than the requester: the two don't take the memory back and forth.
+        while (m_stats.residentBytes + m_pendingBytes + bytes > m_config.memoryBudget)
+        {
+            Texture* victim = nullptr;
+            float victimScore = score;
+            for (Texture& texture : m_textures)
+            {
+                if (&texture == &requester || texture.state != TextureState::Ready || texture.pending != InvalidAsset ||
+                    texture.residentMip >= texture.header.tailMip)
+                {
+                    continue;
+                }
+                const uint32_t target = std::clamp(texture.wantedMip, texture.minMip, texture.header.tailMip);
+                const float after = static_cast<float>(texture.residentMip + 1 - std::min(target, texture.residentMip + 1)) * texture.priority;
+                if (after < victimScore)
+                {
+                    victim = &texture;
+                    victimScore = after;
+                }
+            }
+            if (victim == nullptr)
+            {
+                return false;
+            }
+            EvictOne(*victim);
+        }
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// AssetLoader of the reads
+    ////////////////////////////////////////////////////////////////////////////
+
+    void* TextureStreamer::DecodeRead(void*, const uint8_t* data, uint64_t size, uint64_t settings)
+    {
+        // the blocks are what the GPU takes, only the copy out of the read buffer is left.
+        StreamedData* read = new StreamedData();
+        read->generation = static_cast<uint32_t>(settings >> 32);
+        read->slot = static_cast<uint32_t>(settings) >> 5;
+        read->mip = static_cast<uint32_t>(settings) & 31;
+        read->bytes.assign(data, data + size);
+        return read;
+    }
+
+    uint64_t TextureStreamer::UploadRead(void* context, void* asset)
+    {
+        return static_cast<TextureStreamer*>(context)->Upload(*static_cast<StreamedData*>(asset));
+    }
+
+    void TextureStreamer::ReleaseRead(void*, void* asset)
+    {
+        delete static_cast<StreamedData*>(asset);
+    }
+
+    uint64_t TextureStreamer::Upload(StreamedData& read)
+    {
+        if (read.slot >= m_textures.size())
+        {
+            return 0;
+        }
+        Texture& texture = m_textures[read.slot];
+        if (texture.generation != read.generation)
+        {
+            return 0;
+        }
+
+        if (read.mip != HeadRead)
+        {
+            if (texture.state != TextureState::Ready || read.mip + 1 != texture.residentMip)
+            {
+                return 0;
+            }
+            if (read.bytes.size() != texture.header.mips[read.mip].size)
+            {
+                // short read (truncated or replaced file): treated like a failed read of the mip.
+                LOG_WARN("TextureStreamer: mip {} of {} is {} bytes, expected {}", read.mip, texture.path,
+                         read.bytes.size(), texture.header.mips[read.mip].size);
+                texture.minMip = read.mip + 1;
+                return 0;
+            }
+            const uint64_t uploaded = m_callbacks.upload(m_callbacks.context, texture.texture, read.mip, read.bytes.data(), read.bytes.size());
+            texture.residentMip = read.mip;
+            texture.residentBytes += read.bytes.size();
+            m_stats.residentBytes += read.bytes.size();
+            return uploaded;
+        }
+
+        if (texture.state != TextureState::LoadingHead)
+        {
+            return 0;
+        }
+        const CookedTextureHeader* header = ParseCookedTexture(read.bytes.data(), read.bytes.size());
+        if (header == nullptr)
+        {
+            // a tail larger than the first read, Poll reads it whole.
+            CookedTextureHeader partial;
+            if (!texture.headIncomplete && read.bytes.size() >= sizeof(partial))
+            {
+                memcpy(&partial, read.bytes.data(), sizeof(partial));
+                if (partial.magic == CookedTextureMagic && partial.tailSize > read.bytes.size() && partial.tailSize <= MaxHeadSize)
+                {
+                    texture.headIncomplete = true;
+                    texture.header.tailSize = partial.tailSize;
+                    return 0;
+                }
+            }
+            LOG_WARN("TextureStreamer: {} isn't a version {} cooked texture", texture.path, CookedTextureVersion);
+            texture.state = TextureState::Failed;
+            return 0;
+        }
+
+        texture.headIncomplete = false;
+        texture.header = *header;
+        texture.texture = m_callbacks.create(m_callbacks.context, texture.header);
+        if (texture.texture == nullptr)
+        {
+            texture.state = TextureState::Failed;
+            return 0;
+        }
+
+        uint64_t uploaded = 0;
+        for (uint32_t mip = header->mipCount; mip > header->tailMip; mip--)
+        {
+            const CookedTextureMip& range = header->mips[mip - 1];
+            uploaded += m_callbacks.upload(m_callbacks.context, texture.texture, mip - 1, read.bytes.data() + range.offset, range.size);
+        }
+        texture.residentMip = header->tailMip;
+        texture.wantedMip = header->tailMip;
+        texture.wantedFrame = m_frame;
+        texture.state = TextureState::Ready;
+        return uploaded;
+    }
+}
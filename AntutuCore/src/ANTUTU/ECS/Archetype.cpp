@@ -0,0 +1,135 @@
+#include <ANTUTU/ECS/Archetype.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <new>
+
+namespace att::ECS
+{
+    static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// ChunkPool
+    ////////////////////////////////////////////////////////////////////////////
+    ChunkPool::~ChunkPool()
+    {
+        for (std::byte* data : m_free)
+        {
+            ::operator delete(data, std::align_val_t(ChunkColumnAlignment));
+        }
+    }
+
+    std::byte* ChunkPool::Acquire()
+    {
+        if (!m_free.empty())
+        {
+            std::byte* data = m_free.back();
+            m_free.pop_back();
+            return data;
+        }
+        return static_cast<std::byte*>(::operator new(ChunkSize, std::align_val_t(ChunkColumnAlignment)));
+    }
+
+    void ChunkPool::Release(std::byte* data)
+    {
+        m_free.push_back(data);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Archetype
+    ////////////////////////////////////////////////////////////////////////////
+    Archetype::Archetype(std::vector<ComponentInfo> components)
+        : m_components(std::move(components))
+    {
+        uint32_t rowSize = sizeof(Entity);
+        for (const ComponentInfo& info : m_components)
+        {
+            assert(info.alignment <= ChunkColumnAlignment);
+            m_signature.push_back(info.id);
+            rowSize += info.size;
+        }
+
+        // largest row count whose aligned columns still fit in one chunk.
+        m_offsets.resize(m_components.size());
+        for (m_capacity = ChunkSize / rowSize; m_capacity > 0; m_capacity--)
+        {
+            uint32_t offset = m_capacity * sizeof(Entity);
+            for (size_t i = 0; i < m_components.size(); i++)
+            {
+                offset = AlignUp(offset, ChunkColumnAlignment);
+                m_offsets[i] = offset;
+                offset += m_capacity * m_components[i].size;
+            }
+            if (offset <= ChunkSize)
+            {
+                break;
+            }
+        }
+        assert(m_capacity > 0 && "component set too large for one chunk");
+    }
+
+    int32_t Archetype::FindColumn(ComponentId id) const
+    {
+        // a handful of columns: a linear scan beats a binary search here.
+        for (size_t i = 0; i < m_signature.size(); i++)
+        {
+            if (m_signature[i] == id)
+            {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    RowLocation Archetype::AllocateRow(Entity entity, ChunkPool& pool, uint32_t version)
+    {
+        if (m_chunks.empty() || m_chunks.back().count == m_capacity)
+        {
+            Chunk chunk;
+            chunk.data = pool.Acquire();
+            chunk.versions.assign(m_components.size(), version);
+            m_chunks.push_back(std::move(chunk));
+        }
+
+        Chunk& chunk = m_chunks.back();
+        const uint32_t row = chunk.count++;
+        GetEntities(chunk)[row] = entity;
+        std::fill(chunk.versions.begin(), chunk.versions.end(), version);
+        m_entityCount++;
+        return { static_cast<uint32_t>(m_chunks.size() - 1), row };
+    }
+
+    Entity Archetype::RemoveRow(RowLocation location, ChunkPool& pool, uint32_t version)
+    {
+        Chunk& last = m_chunks.back();
+        const uint32_t lastRow = last.count - 1;
+        const uint32_t lastChunk = static_cast<uint32_t>(m_chunks.size() - 1);
+
+        Entity moved = NullEntity;
+        if (location.chunk != lastChunk || location.row != lastRow)
+        {
+            Chunk& target = m_chunks[location.chunk];
+            moved = GetEntities(last)[lastRow];
+            GetEntities(target)[location.row] = moved;
+            for (uint32_t column = 0; column < m_components.size(); column++)
+            {
+                std::memcpy(GetComponentData(target, column, location.row),
+                            GetComponentData(last, column, lastRow),
+                            m_components[column].size);
+            }
+            std::fill(target.versions.begin(), target.versions.end(), version);
+        }
+
+        last.count--;
+        m_entityCount--;
+        if (last.count == 0)
+        {
+            pool.Release(last.data);
+            m_chunks.pop_back();
+        }
+        return moved;
+    }
+}
@@ -0,0 +1,331 @@
+#include <ANTUTU/ECS/CommandBuffer.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace att::ECS
+{
+    // slots go back to the free list when their thread exits, so only MaxThreads
+    // threads recording at the same time can run out, not a pool that comes and goes.
+    struct RecordingSlots
+    {
+        std::mutex mutex;
+        std::vector<uint32_t> free;
+        uint32_t next = 0;
+
+        static RecordingSlots& Get()
+        {
+            static RecordingSlots slots;
+            return slots;
+        }
+
+        // MaxThreads when every slot is taken.
+        uint32_t Acquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!free.empty())
+            {
+                const uint32_t slot = free.back();
+                free.pop_back();
+                return slot;
+            }
+            return next < CommandQueue::MaxThreads ? next++ : CommandQueue::MaxThreads;
+        }
+
+        void Release(uint32_t slot)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            free.push_back(slot);
+        }
+    };
+
+    // the buffer of a released slot keeps its commands, the next thread appends to it.
+    struct RecordingThreadSlot
+    {
+        uint32_t slot = RecordingSlots::Get().Acquire();
+
+        ~RecordingThreadSlot()
+        {
+            if (slot < CommandQueue::MaxThreads)
+            {
+                RecordingSlots::Get().Release(slot);
+            }
+        }
+    };
+
+    // real entities sort by index, placeholders after them by (buffer, creation order).
+    static uint64_t SortKey(Entity entity)
+    {
+        if (CommandBuffer::IsPlaceholder(entity))
+        {
+            return (1ull << 63) | (static_cast<uint64_t>(entity.generation) << 32) |
+                   (entity.index & ~CommandBuffer::PlaceholderBit);
+        }
+        return entity.index;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// CommandBuffer
+    ////////////////////////////////////////////////////////////////////////////
+    CommandBuffer::~CommandBuffer()
+    {
+        for (std::byte* block : m_blocks)
+        {
+            ::operator delete(block, std::align_val_t(16));
+        }
+    }
+
+    std::byte* CommandBuffer::Push(CommandType type, Entity entity, const ComponentInfo& info)
+    {
+        const size_t size = RecordSize(info.size);
+        assert(size <= BlockSize);
+
+        if (m_blocks.empty() || m_offset + size > BlockSize)
+        {
+            if (!m_blocks.empty())
+            {
+                m_blockEnds[m_currentBlock] = m_offset;
+                m_currentBlock++;
+            }
+            if (m_currentBlock == m_blocks.size())
+            {
+                m_blocks.push_back(static_cast<std::byte*>(::operator new(BlockSize, std::align_val_t(16))));
+                m_blockEnds.push_back(0);
+            }
+            m_offset = 0;
+        }
+
+        std::byte* record = m_blocks[m_currentBlock] + m_offset;
+        new (record) Command{ type, entity, info };
+        m_offset += size;
+        m_commandCount++;
+        return record + sizeof(Command);
+    }
+
+    Entity CommandBuffer::Create()
+    {
+        const Entity entity{ PlaceholderBit | m_nextPlaceholder++, m_id };
+        Push(CommandType::Create, entity, ComponentInfo{});
+        return entity;
+    }
+
+    void CommandBuffer::Destroy(Entity entity)
+    {
+        Push(CommandType::Destroy, entity, ComponentInfo{});
+    }
+
+    void CommandBuffer::AddComponent(Entity entity, const ComponentInfo& info, const void* data)
+    {
+        std::byte* dst = Push(CommandType::Add, entity, info);
+        if (data != nullptr)
+        {
+            std::memcpy(dst, data, info.size);
+        }
+        else
+        {
+            std::memset(dst, 0, info.size);
+        }
+    }
+
+    void CommandBuffer::RemoveComponent(Entity entity, ComponentId id)
+    {
+        Push(CommandType::Remove, entity, ComponentInfo{ id, 0, 0, nullptr });
+    }
+
+    void CommandBuffer::Clear()
+    {
+        m_currentBlock = 0;
+        m_offset = 0;
+        m_commandCount = 0;
+        m_nextPlaceholder = 0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// CommandQueue
+    ////////////////////////////////////////////////////////////////////////////
+    CommandQueue::~CommandQueue()
+    {
+        for (auto& buffer : m_buffers)
+        {
+            delete buffer.load(std::memory_order_relaxed);
+        }
+    }
+
+    CommandBuffer& CommandQueue::GetLocal()
+    {
+        thread_local RecordingThreadSlot t_slot;
+        const uint32_t slot = t_slot.slot;
+        if (slot >= MaxThreads)
+        {
+            LOG_CRITICAL("More than {0} threads record ECS commands at once, raise CommandQueue::MaxThreads.", MaxThreads);
+            std::abort();
+        }
+
+        // only this thread creates its buffer, no race on first use.
+        CommandBuffer* buffer = m_buffers[slot].load(std::memory_order_acquire);
+        if (buffer == nullptr)
+        {
+            buffer = new CommandBuffer(slot);
+            m_buffers[slot].store(buffer, std::memory_order_release);
+        }
+        return *buffer;
+    }
+
+    void CommandQueue::Playback(World& world)
+    {
+        using CommandType = CommandBuffer::CommandType;
+
+        m_pending.clear();
+        m_created.clear();
+        uint32_t sequence = 0;
+        for (auto& slot : m_buffers)
+        {
+            CommandBuffer* buffer = slot.load(std::memory_order_acquire);
+            if (buffer == nullptr || buffer->IsEmpty())
+            {
+                continue;
+            }
+            buffer->ForEach([&](const CommandBuffer::Command& command, const std::byte* data)
+            {
+                m_pending.push_back({ SortKey(command.entity), sequence++, &command, data });
+            });
+        }
+        if (m_pending.empty())
+        {
+            return;
+        }
+
+        // group per entity, recording order inside the group.
+        std::sort(m_pending.begin(), m_pending.end(), [](const PendingCommand& a, const PendingCommand& b)
+        {
+            return a.key != b.key ? a.key < b.key : a.sequence < b.sequence;
+        });
+
+        // fold every entity's commands into its final archetype, through the cached edges.
+        Archetype* empty = world.GetOrCreateArchetype(nullptr, 0);
+        m_plans.clear();
+        for (uint32_t first = 0; first < m_pending.size();)
+        {
+            uint32_t last = first;
+            while (last < m_pending.size() && m_pending[last].key == m_pending[first].key)
+            {
+                last++;
+            }
+
+            const Entity entity = m_pending[first].command->entity;
+            const bool placeholder = CommandBuffer::IsPlaceholder(entity);
+            if (placeholder || world.IsAlive(entity))
+            {
+                EntityPlan plan{ m_pending[first].key, entity, nullptr, nullptr, false, first, last - first };
+                plan.from = placeholder ? nullptr : world.GetArchetype(entity);
+
+                Archetype* archetype = placeholder ? empty : plan.from;
+                for (uint32_t i = first; i < last; i++)
+                {
+                    const CommandBuffer::Command& command = *m_pending[i].command;
+                    if (command.type == CommandType::Add && !archetype->Has(command.info.id))
+                    {
+                        archetype = world.GetArchetypeWith(archetype, command.info);
+                    }
+                    else if (command.type == CommandType::Remove && archetype->Has(command.info.id))
+                    {
+                        archetype = world.GetArchetypeWithout(archetype, command.info.id);
+                    }
+                    else if (command.type == CommandType::Destroy)
+                    {
+                        plan.destroyed = true;
+                    }
+                }
+                plan.to = archetype;
+
+                // created and destroyed in the same frame: nothing to do.
+                if (!(placeholder && plan.destroyed))
+                {
+                    m_plans.push_back(plan);
+                }
+            }
+            first = last;
+        }
+
+        // rows moving between the same two archetypes are handled back to back, destroys last.
+        std::sort(m_plans.begin(), m_plans.end(), [](const EntityPlan& a, const EntityPlan& b)
+        {
+            if (a.destroyed != b.destroyed)
+            {
+                return b.destroyed;
+            }
+            if (a.from != b.from)
+            {
+                return std::less<Archetype*>()(a.from, b.from);
+            }
+            if (a.to != b.to)
+            {
+                return std::less<Archetype*>()(a.to, b.to);
+            }
+            return a.key < b.key;
+        });
+
+        for (const EntityPlan& plan : m_plans)
+        {
+            if (plan.destroyed)
+            {
+                world.Destroy(plan.entity);
+                continue;
+            }
+
+            Entity entity = plan.entity;
+            if (plan.from == nullptr)
+            {
+                entity = world.CreateEntity(plan.to);
+                m_created.push_back({ plan.key, entity });
+            }
+            else if (plan.from != plan.to)
+            {
+                world.MoveEntity(entity, plan.to);
+            }
+
+            // in recording order, so the last Add of a component wins.
+            for (uint32_t i = plan.firstCommand; i < plan.firstCommand + plan.commandCount; i++)
+            {
+                const CommandBuffer::Command& command = *m_pending[i].command;
+                if (command.type == CommandType::Add && plan.to->Has(command.info.id))
+                {
+                    std::memcpy(world.WriteComponent(entity, command.info.id), m_pending[i].data, command.info.size);
+                }
+            }
+        }
+
+        // by placeholder key for Resolve.
+        std::sort(m_created.begin(), m_created.end(), [](const CreatedEntity& a, const CreatedEntity& b)
+        {
+            return a.key < b.key;
+        });
+
+        for (auto& slot : m_buffers)
+        {
+            if (CommandBuffer* buffer = slot.load(std::memory_order_acquire))
+            {
+                buffer->Clear();
+            }
+        }
+    }
+
+    Entity CommandQueue::Resolve(Entity placeholder) const
+    {
+        if (!CommandBuffer::IsPlaceholder(placeholder))
+        {
+            return placeholder;
+        }
+        const uint64_t key = SortKey(placeholder);
+        auto it = std::lower_bound(m_created.begin(), m_created.end(), key, [](const CreatedEntity& created, uint64_t value)
+        {
+            return created.key < value;
+        });
+        return it != m_created.end() && it->key == key ? it->entity : NullEntity;
+    }
+}
@@ -0,0 +1,33 @@
+#include <ANTUTU/ECS/Component.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <cassert>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace att::ECS
+{
+    struct RegisteredComponent
+    {
+        std::string name;
+        uint32_t size;
+    };
+
+    bool RegisterComponentInfo(const ComponentInfo& info)
+    {
+        static std::mutex mutex;
+        static std::unordered_map<ComponentId, RegisteredComponent> registry;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto [it, added] = registry.try_emplace(info.id, RegisteredComponent{ info.name, info.size });
+        if (added || (it->second.name == info.name && it->second.size == info.size))
+        {
+            return true;
+        }
+        LOG_ERROR("Component {0} ({1} bytes) has the id {2:x} of {3} ({4} bytes), rename one of them.",
+                  info.name, info.size, info.id, it->second.name, it->second.size);
+        assert(false && "component id collision");
+        return false;
+    }
+}
@@ -0,0 +1,248 @@
+#include <ANTUTU/ECS/SystemScheduler.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Tracer.h>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace att::ECS
+{
+    static bool Intersects(const std::vector<ComponentId>& a, const std::vector<ComponentId>& b)
+    {
+        for (ComponentId id : a)
+        {
+            if (std::find(b.begin(), b.end(), id) != b.end())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static double MillisecondsSince(std::chrono::steady_clock::time_point start,
+                                    std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    SystemScheduler::SystemScheduler(World& world)
+        : m_world(world)
+    {
+    }
+
+    SystemScheduler::~SystemScheduler() = default;
+
+    ISystem* SystemScheduler::AddSystem(std::unique_ptr<ISystem> system)
+    {
+        m_systems.push_back(std::move(system));
+        m_graphDirty = true;
+        return m_systems.back().get();
+    }
+
+    void SystemScheduler::RemoveSystem(ISystem* system)
+    {
+        std::erase_if(m_systems, [system](const std::unique_ptr<ISystem>& s) { return s.get() == system; });
+        m_graphDirty = true;
+    }
+
+    bool SystemScheduler::Conflicts(const SystemAccess& a, const SystemAccess& b)
+    {
+        return a.exclusive || b.exclusive ||
+               Intersects(a.writes, b.writes) ||
+               Intersects(a.writes, b.reads) ||
+               Intersects(a.reads, b.writes);
+    }
+
+    void SystemScheduler::BuildGraph()
+    {
+        m_nodes.clear();
+        m_nodes.reserve(m_systems.size());
+        for (auto& system : m_systems)
+        {
+            Node node{ system.get(), {}, {}, {} };
+            system->DeclareAccess(node.access);
+            m_nodes.push_back(std::move(node));
+        }
+
+        // edges only go forward, registration order is a topological order.
+        for (uint32_t later = 0; later < m_nodes.size(); later++)
+        {
+            for (uint32_t earlier = 0; earlier < later; earlier++)
+            {
+                if (Conflicts(m_nodes[earlier].access, m_nodes[later].access))
+                {
+                    m_nodes[later].predecessors.push_back(earlier);
+                    m_nodes[earlier].dependents.push_back(later);
+                }
+            }
+        }
+
+        m_jobs.resize(m_nodes.size());
+        for (uint32_t i = 0; i < m_nodes.size(); i++)
+        {
+            m_jobs[i] = { this, i };
+        }
+        m_remaining = std::make_unique<std::atomic<uint32_t>[]>(m_nodes.size());
+        m_stats.systems.assign(m_nodes.size(), SystemTiming{});
+        m_graphDirty = false;
+    }
+
+    void SystemScheduler::Update(float deltaTime)
+    {
+        TRACE_SCOPE("SystemScheduler::Update");
+
+        if (m_graphDirty)
+        {
+            BuildGraph();
+        }
+
+        m_deltaTime = deltaTime;
+        m_frameStart = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < m_nodes.size(); i++)
+        {
+            m_remaining[i].store(static_cast<uint32_t>(m_nodes[i].predecessors.size()), std::memory_order_relaxed);
+        }
+
+        Common::JobCounter counter;
+        m_frameCounter = &counter;
+        for (uint32_t i = 0; i < m_nodes.size(); i++)
+        {
+            if (m_nodes[i].predecessors.empty())
+            {
+                Launch(i);
+            }
+        }
+        Common::JobSystem::Get().Wait(counter);
+        m_frameCounter = nullptr;
+
+        {
+            TRACE_SCOPE("CommandQueue::Playback");
+            m_commands.Playback(m_world);
+        }
+
+        ComputeStats(MillisecondsSince(m_frameStart, std::chrono::steady_clock::now()));
+
+        m_frameIndex++;
+        if (m_reportInterval != 0 && m_frameIndex % m_reportInterval == 0)
+        {
+            LOG_INFO("ECS schedule:\n{0}", FormatReport());
+        }
+    }
+
+    void SystemScheduler::Launch(uint32_t index)
+    {
+        Common::JobSystem::Get().Schedule({
+            [](void* data)
+            {
+                const NodeJob* job = static_cast<const NodeJob*>(data);
+                job->scheduler->RunNode(job->index);
+            },
+            &m_jobs[index],
+            m_frameCounter });
+    }
+
+    void SystemScheduler::RunNode(uint32_t index)
+    {
+        Node& node = m_nodes[index];
+
+        const auto begin = std::chrono::steady_clock::now();
+        {
+            TRACE_SCOPE(node.system->GetName());
+            node.system->Update(m_world, m_commands, m_deltaTime);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        SystemTiming& timing = m_stats.systems[index];
+        timing.name = node.system->GetName();
+        timing.startMs = MillisecondsSince(m_frameStart, begin);
+        timing.durationMs = MillisecondsSince(begin, end);
+
+        // launched before this job retires, so the frame counter never drops to zero early.
+        for (uint32_t dependent : node.dependents)
+        {
+            if (m_remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                Launch(dependent);
+            }
+        }
+    }
+
+    void SystemScheduler::ComputeStats(double wallMs)
+    {
+        m_stats.wallMs = wallMs;
+        m_stats.totalWorkMs = 0.0;
+        m_stats.criticalPathMs = 0.0;
+        m_stats.bottleneck = nullptr;
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        // longest finish time through the graph, with the measured durations.
+        std::vector<double> finish(m_nodes.size(), 0.0);
+        std::vector<int32_t> previous(m_nodes.size(), -1);
+        uint32_t last = 0;
+        for (uint32_t i = 0; i < m_nodes.size(); i++)
+        {
+            double start = 0.0;
+            for (uint32_t predecessor : m_nodes[i].predecessors)
+            {
+                if (finish[predecessor] > start)
+                {
+                    start = finish[predecessor];
+                    previous[i] = static_cast<int32_t>(predecessor);
+                }
+            }
+            finish[i] = start + m_stats.systems[i].durationMs;
+            m_stats.totalWorkMs += m_stats.systems[i].durationMs;
+            m_stats.systems[i].onCriticalPath = false;
+            if (finish[i] > finish[last])
+            {
+                last = i;
+            }
+        }
+
+        m_stats.criticalPathMs = finish[last];
+        double longest = -1.0;
+        for (int32_t i = static_cast<int32_t>(last); i >= 0; i = previous[i])
+        {
+            SystemTiming& timing = m_stats.systems[i];
+            timing.onCriticalPath = true;
+            if (timing.durationMs > longest)
+            {
+                longest = timing.durationMs;
+                m_stats.bottleneck = timing.name;
+            }
+        }
+
+        TRACE_COUNTER("ECS parallelism", m_stats.GetParallelism());
+    }
+
+    std::string SystemScheduler::FormatReport() const
+    {
+        std::string report;
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "wall %.3f ms, work %.3f ms, critical path %.3f ms, parallelism %.2fx, bottleneck %s\n",
+                      m_stats.wallMs, m_stats.totalWorkMs, m_stats.criticalPathMs, m_stats.GetParallelism(),
+                      m_stats.bottleneck ? m_stats.bottleneck : "-");
+        report += line;
+
+        for (uint32_t i = 0; i < m_nodes.size() && i < m_stats.systems.size(); i++)
+        {
+            const SystemTiming& timing = m_stats.systems[i];
+            std::string after;
+            for (uint32_t predecessor : m_nodes[i].predecessors)
+            {
+                after += after.empty() ? "" : ", ";
+                after += m_nodes[predecessor].system->GetName();
+            }
+            std::snprintf(line, sizeof(line), "  %c %-32s start %8.3f ms  %8.3f ms  after: %s\n",
+                          timing.onCriticalPath ? '*' : ' ', m_nodes[i].system->GetName(),
+                          timing.startMs, timing.durationMs, after.empty() ? "-" : after.c_str());
+            report += line;
+        }
+        return report;
+    }
+}
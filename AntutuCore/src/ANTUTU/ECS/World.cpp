@@ -0,0 +1,339 @@
+#include <ANTUTU/ECS/World.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace att::ECS
+{
+    static uint64_t HashSignature(const ComponentInfo* infos, uint32_t count)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            hash ^= infos[i].id;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    World::World()
+    {
+        // archetype 0: entities without components.
+        GetOrCreateArchetype(nullptr, 0);
+    }
+
+    World::~World()
+    {
+        for (auto& archetype : m_archetypes)
+        {
+            for (Chunk& chunk : archetype->GetChunks())
+            {
+                m_chunkPool.Release(chunk.data);
+            }
+            archetype->GetChunks().clear();
+        }
+    }
+
+    const World::EntityRecord* World::FindRecord(Entity entity) const
+    {
+        if (entity.index >= m_records.size())
+        {
+            return nullptr;
+        }
+        const EntityRecord& record = m_records[entity.index];
+        return (record.archetype != nullptr && record.generation == entity.generation) ? &record : nullptr;
+    }
+
+    bool World::IsAlive(Entity entity) const
+    {
+        return FindRecord(entity) != nullptr;
+    }
+
+    Archetype* World::GetArchetype(Entity entity) const
+    {
+        const EntityRecord* record = FindRecord(entity);
+        return record ? record->archetype : nullptr;
+    }
+
+    Entity World::AllocateEntity()
+    {
+        uint32_t index;
+        if (!m_freeIndices.empty())
+        {
+            index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_records.size());
+            m_records.emplace_back();
+        }
+        m_entityCount++;
+        return { index, m_records[index].generation };
+    }
+
+    void World::Place(Entity entity, Archetype* archetype)
+    {
+        EntityRecord& record = m_records[entity.index];
+        record.archetype = archetype;
+        record.location = archetype->AllocateRow(entity, m_chunkPool, IncrementVersion());
+    }
+
+    Entity World::CreateEntity(const ComponentInfo* infos, const void* const* data, uint32_t count)
+    {
+        if (count > MaxCreateComponents)
+        {
+            LOG_ERROR("CreateEntity with {0} components, at most {1} are supported.", count, MaxCreateComponents);
+            return NullEntity;
+        }
+
+        // signature order, the data pointers follow their component.
+        uint32_t order[MaxCreateComponents] = {};
+        for (uint32_t i = 0; i < count; i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order, order + count, [infos](uint32_t a, uint32_t b) { return infos[a].id < infos[b].id; });
+
+        ComponentInfo sorted[MaxCreateComponents] = {};
+        for (uint32_t i = 0; i < count; i++)
+        {
+            sorted[i] = infos[order[i]];
+        }
+
+        Archetype* archetype = GetOrCreateArchetype(sorted, count);
+        const Entity entity = AllocateEntity();
+        Place(entity, archetype);
+
+        const EntityRecord& record = m_records[entity.index];
+        const Chunk& chunk = archetype->GetChunks()[record.location.chunk];
+        for (uint32_t i = 0; i < count; i++)
+        {
+            std::byte* dst = archetype->GetComponentData(chunk, i, record.location.row);
+            const void* src = data[order[i]];
+            if (src != nullptr)
+            {
+                std::memcpy(dst, src, sorted[i].size);
+            }
+            else
+            {
+                std::memset(dst, 0, sorted[i].size);
+            }
+        }
+        return entity;
+    }
+
+    Entity World::CreateEntity(Archetype* archetype)
+    {
+        const Entity entity = AllocateEntity();
+        Place(entity, archetype);
+
+        const EntityRecord& record = m_records[entity.index];
+        const Chunk& chunk = archetype->GetChunks()[record.location.chunk];
+        for (uint32_t column = 0; column < archetype->GetColumnCount(); column++)
+        {
+            std::memset(archetype->GetComponentData(chunk, column, record.location.row), 0,
+                        archetype->GetColumnInfo(column).size);
+        }
+        return entity;
+    }
+
+    void World::Destroy(Entity entity)
+    {
+        const EntityRecord* found = FindRecord(entity);
+        if (found == nullptr)
+        {
+            return;
+        }
+
+        EntityRecord& record = m_records[entity.index];
+        const Entity moved = record.archetype->RemoveRow(record.location, m_chunkPool, IncrementVersion());
+        if (moved.IsValid())
+        {
+            m_records[moved.index].location = record.location;
+        }
+
+        record.archetype = nullptr;
+        record.generation++;
+        m_freeIndices.push_back(entity.index);
+        m_entityCount--;
+    }
+
+    Archetype* World::GetOrCreateArchetype(const ComponentInfo* infos, uint32_t count)
+    {
+        const uint64_t hash = HashSignature(infos, count);
+        std::vector<Archetype*>& candidates = m_archetypeLookup[hash];
+        for (Archetype* candidate : candidates)
+        {
+            const auto& signature = candidate->GetSignature();
+            if (signature.size() == count &&
+                std::equal(signature.begin(), signature.end(), infos,
+                           [](ComponentId id, const ComponentInfo& info) { return id == info.id; }))
+            {
+                return candidate;
+            }
+        }
+
+        m_archetypes.push_back(std::make_unique<Archetype>(std::vector<ComponentInfo>(infos, infos + count)));
+        candidates.push_back(m_archetypes.back().get());
+        return m_archetypes.back().get();
+    }
+
+    Archetype* World::GetArchetypeWith(Archetype* from, const ComponentInfo& info)
+    {
+        auto edge = from->addEdges.find(info.id);
+        if (edge != from->addEdges.end())
+        {
+            return edge->second;
+        }
+
+        std::vector<ComponentInfo> infos;
+        infos.reserve(from->GetColumnCount() + 1);
+        for (uint32_t i = 0; i < from->GetColumnCount(); i++)
+        {
+            infos.push_back(from->GetColumnInfo(i));
+        }
+        infos.insert(std::upper_bound(infos.begin(), infos.end(), info.id,
+                                      [](ComponentId id, const ComponentInfo& other) { return id < other.id; }),
+                     info);
+
+        Archetype* to = GetOrCreateArchetype(infos.data(), static_cast<uint32_t>(infos.size()));
+        from->addEdges[info.id] = to;
+        to->removeEdges[info.id] = from;
+        return to;
+    }
+
+    Archetype* World::GetArchetypeWithout(Archetype* from, ComponentId id)
+    {
+        auto edge = from->removeEdges.find(id);
+        if (edge != from->removeEdges.end())
+        {
+            return edge->second;
+        }
+
+        std::vector<ComponentInfo> infos;
+        infos.reserve(from->GetColumnCount());
+        for (uint32_t i = 0; i < from->GetColumnCount(); i++)
+        {
+            if (from->GetColumnInfo(i).id != id)
+            {
+                infos.push_back(from->GetColumnInfo(i));
+            }
+        }
+
+        Archetype* to = GetOrCreateArchetype(infos.data(), static_cast<uint32_t>(infos.size()));
+        from->removeEdges[id] = to;
+        to->addEdges[id] = from;
+        return to;
+    }
+
+    void World::MoveEntity(Entity entity, Archetype* to)
+    {
+        EntityRecord& record = m_records[entity.index];
+        Archetype* from = record.archetype;
+        if (from == to)
+        {
+            return;
+        }
+
+        const RowLocation source = record.location;
+        const RowLocation target = to->AllocateRow(entity, m_chunkPool, IncrementVersion());
+
+        const Chunk& sourceChunk = from->GetChunks()[source.chunk];
+        const Chunk& targetChunk = to->GetChunks()[target.chunk];
+        for (uint32_t column = 0; column < to->GetColumnCount(); column++)
+        {
+            const ComponentInfo& info = to->GetColumnInfo(column);
+            std::byte* dst = to->GetComponentData(targetChunk, column, target.row);
+            const int32_t sourceColumn = from->FindColumn(info.id);
+            if (sourceColumn >= 0)
+            {
+                std::memcpy(dst, from->GetComponentData(sourceChunk, static_cast<uint32_t>(sourceColumn), source.row), info.size);
+            }
+            else
+            {
+                std::memset(dst, 0, info.size);
+            }
+        }
+
+        const Entity moved = from->RemoveRow(source, m_chunkPool, IncrementVersion());
+        if (moved.IsValid())
+        {
+            m_records[moved.index].location = source;
+        }
+        record.archetype = to;
+        record.location = target;
+    }
+
+    void World::AddComponent(Entity entity, const ComponentInfo& info, const void* data)
+    {
+        if (FindRecord(entity) == nullptr)
+        {
+            return;
+        }
+
+        EntityRecord& record = m_records[entity.index];
+        if (!record.archetype->Has(info.id))
+        {
+            MoveEntity(entity, GetArchetypeWith(record.archetype, info));
+        }
+
+        std::byte* dst = WriteComponent(entity, info.id);
+        if (data != nullptr)
+        {
+            std::memcpy(dst, data, info.size);
+        }
+    }
+
+    void World::RemoveComponent(Entity entity, ComponentId id)
+    {
+        const EntityRecord* record = FindRecord(entity);
+        if (record == nullptr || !record->archetype->Has(id))
+        {
+            return;
+        }
+        MoveEntity(entity, GetArchetypeWithout(record->archetype, id));
+    }
+
+    bool World::HasComponent(Entity entity, ComponentId id) const
+    {
+        const EntityRecord* record = FindRecord(entity);
+        return record != nullptr && record->archetype->Has(id);
+    }
+
+    std::byte* World::WriteComponent(Entity entity, ComponentId id)
+    {
+        const EntityRecord* record = FindRecord(entity);
+        if (record == nullptr)
+        {
+            return nullptr;
+        }
+
+        const int32_t column = record->archetype->FindColumn(id);
+        if (column < 0)
+        {
+            return nullptr;
+        }
+        Chunk& chunk = record->archetype->GetChunks()[record->location.chunk];
+        chunk.versions[column] = IncrementVersion();
+        return record->archetype->GetComponentData(chunk, static_cast<uint32_t>(column), record->location.row);
+    }
+
+    const std::byte* World::ReadComponent(Entity entity, ComponentId id) const
+    {
+        const EntityRecord* record = FindRecord(entity);
+        if (record == nullptr)
+        {
+            return nullptr;
+        }
+
+        const int32_t column = record->archetype->FindColumn(id);
+        if (column < 0)
+        {
+            return nullptr;
+        }
+        const Chunk& chunk = record->archetype->GetChunks()[record->location.chunk];
+        return record->archetype->GetComponentData(chunk, static_cast<uint32_t>(column), record->location.row);
+    }
+}
@@ -0,0 +1,480 @@
+#include <ANTUTU/Math/BatchKernels.hpp>
+#include <ANTUTU/Math/SimdTypes.hpp>
+
+#include <atomic>
+#include <cmath>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+namespace att::Math
+{
+    ////////////////////////////////////////////////////////////////////////////
+    /// Scalar
+    ////////////////////////////////////////////////////////////////////////////
+
+    namespace Scalar
+    {
+        static void TransformPoints(const float* m, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const float x = in.x[i], y = in.y[i], z = in.z[i];
+                out.x[i] = m[0] * x + m[4] * y + m[8] * z + m[12];
+                out.y[i] = m[1] * x + m[5] * y + m[9] * z + m[13];
+                out.z[i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+            }
+        }
+
+        static void TransformNormals(const float* m, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const float x = in.x[i], y = in.y[i], z = in.z[i];
+                const float nx = m[0] * x + m[4] * y + m[8] * z;
+                const float ny = m[1] * x + m[5] * y + m[9] * z;
+                const float nz = m[2] * x + m[6] * y + m[10] * z;
+                const float inverseLength = 1.0f / std::sqrt(nx * nx + ny * ny + nz * nz);
+                out.x[i] = nx * inverseLength;
+                out.y[i] = ny * inverseLength;
+                out.z[i] = nz * inverseLength;
+            }
+        }
+
+        static void TransformAabbs(const float* m, SoAConstAabbs in, SoAAabbs out, uint32_t count)
+        {
+            float a[12];
+            for (int column = 0; column < 3; column++)
+            {
+                for (int row = 0; row < 3; row++)
+                {
+                    a[column * 4 + row] = std::fabs(m[column * 4 + row]);
+                }
+            }
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const float cx = (in.min.x[i] + in.max.x[i]) * 0.5f, ex = (in.max.x[i] - in.min.x[i]) * 0.5f;
+                const float cy = (in.min.y[i] + in.max.y[i]) * 0.5f, ey = (in.max.y[i] - in.min.y[i]) * 0.5f;
+                const float cz = (in.min.z[i] + in.max.z[i]) * 0.5f, ez = (in.max.z[i] - in.min.z[i]) * 0.5f;
+
+                const float tx = m[0] * cx + m[4] * cy + m[8] * cz + m[12];
+                const float ty = m[1] * cx + m[5] * cy + m[9] * cz + m[13];
+                const float tz = m[2] * cx + m[6] * cy + m[10] * cz + m[14];
+                const float rx = a[0] * ex + a[4] * ey + a[8] * ez;
+                const float ry = a[1] * ex + a[5] * ey + a[9] * ez;
+                const float rz = a[2] * ex + a[6] * ey + a[10] * ez;
+
+                out.min.x[i] = tx - rx; out.max.x[i] = tx + rx;
+                out.min.y[i] = ty - ry; out.max.y[i] = ty + ry;
+                out.min.z[i] = tz - rz; out.max.z[i] = tz + rz;
+            }
+        }
+
+        static uint32_t CullSpheres(const float* planes, SoASpheres spheres, uint32_t count, uint32_t* visible)
+        {
+            uint32_t visibleCount = 0;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const float x = spheres.center.x[i], y = spheres.center.y[i], z = spheres.center.z[i];
+                const float r = spheres.radius[i];
+                bool inside = true;
+                for (int p = 0; p < 6 && inside; p++)
+                {
+                    const float* plane = planes + p * 4;
+                    inside = plane[0] * x + plane[1] * y + plane[2] * z + plane[3] >= -r;
+                }
+                if (inside)
+                {
+                    visible[visibleCount++] = i;
+                }
+            }
+            return visibleCount;
+        }
+
+        static uint32_t CullBoxes(const float* planes, SoABoxes boxes, uint32_t count, uint32_t* visible)
+        {
+            uint32_t visibleCount = 0;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const float x = boxes.center.x[i], y = boxes.center.y[i], z = boxes.center.z[i];
+                const float ex = boxes.extent.x[i], ey = boxes.extent.y[i], ez = boxes.extent.z[i];
+                bool inside = true;
+                for (int p = 0; p < 6 && inside; p++)
+                {
+                    const float* plane = planes + p * 4;
+                    const float r = std::fabs(plane[0]) * ex + std::fabs(plane[1]) * ey + std::fabs(plane[2]) * ez;
+                    inside = plane[0] * x + plane[1] * y + plane[2] * z + plane[3] >= -r;
+                }
+                if (inside)
+                {
+                    visible[visibleCount++] = i;
+                }
+            }
+            return visibleCount;
+        }
+
+        static const BatchKernelTable Kernels = {
+            SimdLevel::Scalar, "Scalar",
+            TransformPoints, TransformNormals, TransformAabbs, CullSpheres, CullBoxes
+        };
+    }
+
+    const BatchKernelTable& Detail::GetScalarKernels()
+    {
+        return Scalar::Kernels;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Simd4 (SSE4.1 / NEON)
+    ////////////////////////////////////////////////////////////////////////////
+
+#if defined(ANTUTU_MATH_SSE) || defined(ANTUTU_MATH_NEON)
+    namespace Simd4
+    {
+        using namespace Simd;
+
+        static SoAConstVec3 Offset(SoAConstVec3 v, uint32_t i) { return { v.x + i, v.y + i, v.z + i }; }
+        static SoAVec3 Offset(SoAVec3 v, uint32_t i) { return { v.x + i, v.y + i, v.z + i }; }
+
+        static void TransformPoints(const float* m, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+        {
+            const Float4 m0 = Splat(m[0]), m1 = Splat(m[1]), m2 = Splat(m[2]);
+            const Float4 m4 = Splat(m[4]), m5 = Splat(m[5]), m6 = Splat(m[6]);
+            const Float4 m8 = Splat(m[8]), m9 = Splat(m[9]), m10 = Splat(m[10]);
+            const Float4 m12 = Splat(m[12]), m13 = Splat(m[13]), m14 = Splat(m[14]);
+
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const Float4 x = Load(in.x + i), y = Load(in.y + i), z = Load(in.z + i);
+                Store(out.x + i, MulAdd(m8, z, MulAdd(m4, y, MulAdd(m0, x, m12))));
+                Store(out.y + i, MulAdd(m9, z, MulAdd(m5, y, MulAdd(m1, x, m13))));
+                Store(out.z + i, MulAdd(m10, z, MulAdd(m6, y, MulAdd(m2, x, m14))));
+            }
+            Scalar::TransformPoints(m, Offset(in, i), Offset(out, i), count - i);
+        }
+
+        static void TransformNormals(const float* m, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+        {
+            const Float4 m0 = Splat(m[0]), m1 = Splat(m[1]), m2 = Splat(m[2]);
+            const Float4 m4 = Splat(m[4]), m5 = Splat(m[5]), m6 = Splat(m[6]);
+            const Float4 m8 = Splat(m[8]), m9 = Splat(m[9]), m10 = Splat(m[10]);
+            const Float4 one = Splat(1.0f);
+
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const Float4 x = Load(in.x + i), y = Load(in.y + i), z = Load(in.z + i);
+                const Float4 nx = MulAdd(m8, z, MulAdd(m4, y, Mul(m0, x)));
+                const Float4 ny = MulAdd(m9, z, MulAdd(m5, y, Mul(m1, x)));
+                const Float4 nz = MulAdd(m10, z, MulAdd(m6, y, Mul(m2, x)));
+                const Float4 inverseLength = Div(one, Sqrt(MulAdd(nz, nz, MulAdd(ny, ny, Mul(nx, nx)))));
+                Store(out.x + i, Mul(nx, inverseLength));
+                Store(out.y + i, Mul(ny, inverseLength));
+                Store(out.z + i, Mul(nz, inverseLength));
+            }
+            Scalar::TransformNormals(m, Offset(in, i), Offset(out, i), count - i);
+        }
+
+        static void TransformAabbs(const float* m, SoAConstAabbs in, SoAAabbs out, uint32_t count)
+        {
+            const Float4 m0 = Splat(m[0]), m1 = Splat(m[1]), m2 = Splat(m[2]);
+            const Float4 m4 = Splat(m[4]), m5 = Splat(m[5]), m6 = Splat(m[6]);
+            const Float4 m8 = Splat(m[8]), m9 = Splat(m[9]), m10 = Splat(m[10]);
+            const Float4 m12 = Splat(m[12]), m13 = Splat(m[13]), m14 = Splat(m[14]);
+            const Float4 a0 = Splat(std::fabs(m[0])), a1 = Splat(std::fabs(m[1])), a2 = Splat(std::fabs(m[2]));
+            const Float4 a4 = Splat(std::fabs(m[4])), a5 = Splat(std::fabs(m[5])), a6 = Splat(std::fabs(m[6]));
+            const Float4 a8 = Splat(std::fabs(m[8])), a9 = Splat(std::fabs(m[9])), a10 = Splat(std::fabs(m[10]));
+            const Float4 half = Splat(0.5f);
+
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const Float4 minX = Load(in.min.x + i), minY = Load(in.min.y + i), minZ = Load(in.min.z + i);
+                const Float4 maxX = Load(in.max.x + i), maxY = Load(in.max.y + i), maxZ = Load(in.max.z + i);
+                const Float4 cx = Mul(Add(minX, maxX), half), ex = Mul(Sub(maxX, minX), half);
+                const Float4 cy = Mul(Add(minY, maxY), half), ey = Mul(Sub(maxY, minY), half);
+                const Float4 cz = Mul(Add(minZ, maxZ), half), ez = Mul(Sub(maxZ, minZ), half);
+
+                const Float4 tx = MulAdd(m8, cz, MulAdd(m4, cy, MulAdd(m0, cx, m12)));
+                const Float4 ty = MulAdd(m9, cz, MulAdd(m5, cy, MulAdd(m1, cx, m13)));
+                const Float4 tz = MulAdd(m10, cz, MulAdd(m6, cy, MulAdd(m2, cx, m14)));
+                const Float4 rx = MulAdd(a8, ez, MulAdd(a4, ey, Mul(a0, ex)));
+                const Float4 ry = MulAdd(a9, ez, MulAdd(a5, ey, Mul(a1, ex)));
+                const Float4 rz = MulAdd(a10, ez, MulAdd(a6, ey, Mul(a2, ex)));
+
+                Store(out.min.x + i, Sub(tx, rx)); Store(out.max.x + i, Add(tx, rx));
+                Store(out.min.y + i, Sub(ty, ry)); Store(out.max.y + i, Add(ty, ry));
+                Store(out.min.z + i, Sub(tz, rz)); Store(out.max.z + i, Add(tz, rz));
+            }
+            Scalar::TransformAabbs(m, { Offset(in.min, i), Offset(in.max, i) }, { Offset(out.min, i), Offset(out.max, i) }, count - i);
+        }
+
+        static uint32_t CullSpheres(const float* planes, SoASpheres spheres, uint32_t count, uint32_t* visible)
+        {
+            Float4 nx[6], ny[6], nz[6], d[6];
+            for (int p = 0; p < 6; p++)
+            {
+                nx[p] = Splat(planes[p * 4 + 0]);
+                ny[p] = Splat(planes[p * 4 + 1]);
+                nz[p] = Splat(planes[p * 4 + 2]);
+                d[p] = Splat(planes[p * 4 + 3]);
+            }
+
+            uint32_t visibleCount = 0;
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const Float4 x = Load(spheres.center.x + i), y = Load(spheres.center.y + i), z = Load(spheres.center.z + i);
+                const Float4 r = Load(spheres.radius + i);
+
+                // smallest signed distance plus radius over the six planes, inside when >= 0.
+                Float4 closest = Add(MulAdd(nz[0], z, MulAdd(ny[0], y, MulAdd(nx[0], x, d[0]))), r);
+                for (int p = 1; p < 6; p++)
+                {
+                    closest = Min(closest, Add(MulAdd(nz[p], z, MulAdd(ny[p], y, MulAdd(nx[p], x, d[p]))), r));
+                }
+
+                alignas(16) float lanes[4];
+                Store(lanes, closest);
+                for (uint32_t lane = 0; lane < 4; lane++)
+                {
+                    visible[visibleCount] = i + lane;
+                    visibleCount += lanes[lane] >= 0.0f;
+                }
+            }
+
+            const uint32_t tail = Scalar::CullSpheres(planes,
+                { Offset(spheres.center, i), spheres.radius + i }, count - i, visible + visibleCount);
+            for (uint32_t t = 0; t < tail; t++)
+            {
+                visible[visibleCount + t] += i;
+            }
+            return visibleCount + tail;
+        }
+
+        static uint32_t CullBoxes(const float* planes, SoABoxes boxes, uint32_t count, uint32_t* visible)
+        {
+            Float4 nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+            for (int p = 0; p < 6; p++)
+            {
+                nx[p] = Splat(planes[p * 4 + 0]);
+                ny[p] = Splat(planes[p * 4 + 1]);
+                nz[p] = Splat(planes[p * 4 + 2]);
+                ax[p] = Splat(std::fabs(planes[p * 4 + 0]));
+                ay[p] = Splat(std::fabs(planes[p * 4 + 1]));
+                az[p] = Splat(std::fabs(planes[p * 4 + 2]));
+                d[p] = Splat(planes[p * 4 + 3]);
+            }
+
+            uint32_t visibleCount = 0;
+            uint32_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const Float4 x = Load(boxes.center.x + i), y = Load(boxes.center.y + i), z = Load(boxes.center.z + i);
+                const Float4 ex = Load(boxes.extent.x + i), ey = Load(boxes.extent.y + i), ez = Load(boxes.extent.z + i);
+
+                // distance of the center plus the box's projected radius on the normal.
+                Float4 closest = Add(MulAdd(nz[0], z, MulAdd(ny[0], y, MulAdd(nx[0], x, d[0]))),
+                    MulAdd(az[0], ez, MulAdd(ay[0], ey, Mul(ax[0], ex))));
+                for (int p = 1; p < 6; p++)
+                {
+                    closest = Min(closest, Add(MulAdd(nz[p], z, MulAdd(ny[p], y, MulAdd(nx[p], x, d[p]))),
+                        MulAdd(az[p], ez, MulAdd(ay[p], ey, Mul(ax[p], ex)))));
+                }
+
+                alignas(16) float lanes[4];
+                Store(lanes, closest);
+                for (uint32_t lane = 0; lane < 4; lane++)
+                {
+                    visible[visibleCount] = i + lane;
+                    visibleCount += lanes[lane] >= 0.0f;
+                }
+            }
+
+            const uint32_t tail = Scalar::CullBoxes(planes,
+                { Offset(boxes.center, i), Offset(boxes.extent, i) }, count - i, visible + visibleCount);
+            for (uint32_t t = 0; t < tail; t++)
+            {
+                visible[visibleCount + t] += i;
+            }
+            return visibleCount + tail;
+        }
+
+        static const BatchKernelTable Kernels = {
+            SimdLevel::Simd4,
+#if defined(ANTUTU_MATH_SSE)
+            "SSE4.1",
+#else
+            "NEON",
+#endif
+            TransformPoints, TransformNormals, TransformAabbs, CullSpheres, CullBoxes
+        };
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Dispatch
+    ////////////////////////////////////////////////////////////////////////////
+
+#if _ANTUTU_SIMD_ENABLED && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_AMD64))
+    static bool CpuSupports(SimdLevel level)
+    {
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        if (!osxsave)
+        {
+            return false;
+        }
+        const unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        if (level == SimdLevel::Avx2)
+        {
+            return fma && (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+        }
+        // AVX-512 also needs the opmask and upper zmm state enabled by the OS.
+        return (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+    #else
+        // libgcc checks XCR0 as well, so an OS without AVX state reports false here.
+        __builtin_cpu_init();
+        if (level == SimdLevel::Avx2)
+        {
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        }
+        return __builtin_cpu_supports("avx512f");
+    #endif
+    }
+#else
+    static bool CpuSupports(SimdLevel)
+    {
+        return false;
+    }
+#endif
+
+    static const BatchKernelTable* GetKernels(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Avx512:
+            return CpuSupports(level) ? Detail::GetAvx512Kernels() : nullptr;
+        case SimdLevel::Avx2:
+            return CpuSupports(level) ? Detail::GetAvx2Kernels() : nullptr;
+        case SimdLevel::Simd4:
+#if defined(ANTUTU_MATH_SSE) || defined(ANTUTU_MATH_NEON)
+            return &Simd4::Kernels;
+#else
+            return nullptr;
+#endif
+        default:
+            return &Scalar::Kernels;
+        }
+    }
+
+    SimdLevel GetSupportedSimdLevel()
+    {
+        static const SimdLevel supported = []()
+        {
+            for (SimdLevel level : { SimdLevel::Avx512, SimdLevel::Avx2, SimdLevel::Simd4 })
+            {
+                if (GetKernels(level) != nullptr)
+                {
+                    return level;
+                }
+            }
+            return SimdLevel::Scalar;
+        }();
+        return supported;
+    }
+
+    static std::atomic<const BatchKernelTable*>& ActiveKernels()
+    {
+        // no logging here, the kernels can run before the LogManager is up.
+        static std::atomic<const BatchKernelTable*> active{ GetKernels(GetSupportedSimdLevel()) };
+        return active;
+    }
+
+    SimdLevel GetSimdLevel()
+    {
+        return GetBatchKernels().level;
+    }
+
+    SimdLevel SetSimdLevel(SimdLevel level)
+    {
+        const BatchKernelTable* kernels = nullptr;
+        for (int l = static_cast<int>(level); kernels == nullptr; l--)
+        {
+            kernels = GetKernels(static_cast<SimdLevel>(l));
+        }
+        ActiveKernels().store(kernels, std::memory_order_relaxed);
+        return kernels->level;
+    }
+
+    const char* GetSimdLevelName(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Simd4: return "Simd4";
+        case SimdLevel::Avx2: return "AVX2";
+        case SimdLevel::Avx512: return "AVX-512";
+        default: return "Scalar";
+        }
+    }
+
+    const BatchKernelTable& GetBatchKernels()
+    {
+        return *ActiveKernels().load(std::memory_order_relaxed);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Public entry points
+    ////////////////////////////////////////////////////////////////////////////
+
+    FrustumPlanes FrustumPlanes::FromViewProjection(const glm::mat4& viewProjection)
+    {
+        const glm::mat4 m = glm::transpose(viewProjection);
+        FrustumPlanes frustum;
+        frustum.planes[0] = m[3] + m[0];	// left
+        frustum.planes[1] = m[3] - m[0];	// right
+        frustum.planes[2] = m[3] + m[1];	// bottom
+        frustum.planes[3] = m[3] - m[1];	// top
+        frustum.planes[4] = m[2];			// near (0..1 depth)
+        frustum.planes[5] = m[3] - m[2];	// far
+        for (glm::vec4& plane : frustum.planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+        return frustum;
+    }
+
+    void TransformPoints(const glm::mat4& matrix, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+    {
+        GetBatchKernels().transformPoints(&matrix[0][0], in, out, count);
+    }
+
+    void TransformNormals(const glm::mat4& matrix, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+    {
+        const glm::mat4 normalMatrix(glm::transpose(glm::inverse(glm::mat3(matrix))));
+        GetBatchKernels().transformNormals(&normalMatrix[0][0], in, out, count);
+    }
+
+    void TransformAabbs(const glm::mat4& matrix, SoAConstAabbs in, SoAAabbs out, uint32_t count)
+    {
+        GetBatchKernels().transformAabbs(&matrix[0][0], in, out, count);
+    }
+
+    uint32_t CullSpheres(const FrustumPlanes& frustum, SoASpheres spheres, uint32_t count, uint32_t* visible)
+    {
+        return GetBatchKernels().cullSpheres(&frustum.planes[0].x, spheres, count, visible);
+    }
+
+    uint32_t CullBoxes(const FrustumPlanes& frustum, SoABoxes boxes, uint32_t count, uint32_t* visible)
+    {
+        return GetBatchKernels().cullBoxes(&frustum.planes[0].x, boxes, count, visible);
+    }
+}
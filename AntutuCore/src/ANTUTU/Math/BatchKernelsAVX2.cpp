@@ -0,0 +1,209 @@
+// Compiled with -mavx2 -mfma (/arch:AVX2). Only called after the CPU check in
+// BatchKernels.cpp, and includes nothing but intrinsics and BatchTypes.hpp so
+// no shared inline function gets an AVX2 body.
+#include <ANTUTU/Math/BatchTypes.hpp>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+namespace att::Math
+{
+#if defined(__AVX2__)
+    namespace Avx2
+    {
+        static SoAConstVec3 Offset(SoAConstVec3 v, uint32_t i) { return { v.x + i, v.y + i, v.z + i }; }
+        static SoAVec3 Offset(SoAVec3 v, uint32_t i) { return { v.x + i, v.y + i, v.z + i }; }
+
+        static __m256 Abs(float value)
+        {
+            return _mm256_set1_ps(value < 0.0f ? -value : value);
+        }
+
+        static void TransformPoints(const float* m, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+        {
+            const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+            const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+            const __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+            const __m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+
+            uint32_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 x = _mm256_loadu_ps(in.x + i), y = _mm256_loadu_ps(in.y + i), z = _mm256_loadu_ps(in.z + i);
+                _mm256_storeu_ps(out.x + i, _mm256_fmadd_ps(m8, z, _mm256_fmadd_ps(m4, y, _mm256_fmadd_ps(m0, x, m12))));
+                _mm256_storeu_ps(out.y + i, _mm256_fmadd_ps(m9, z, _mm256_fmadd_ps(m5, y, _mm256_fmadd_ps(m1, x, m13))));
+                _mm256_storeu_ps(out.z + i, _mm256_fmadd_ps(m10, z, _mm256_fmadd_ps(m6, y, _mm256_fmadd_ps(m2, x, m14))));
+            }
+            Detail::GetScalarKernels().transformPoints(m, Offset(in, i), Offset(out, i), count - i);
+        }
+
+        static void TransformNormals(const float* m, SoAConstVec3 in, SoAVec3 out, uint32_t count)
+        {
+            const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+            const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+            const __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+            const __m256 one = _mm256_set1_ps(1.0f);
+
+            uint32_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 x = _mm256_loadu_ps(in.x + i), y = _mm256_loadu_ps(in.y + i), z = _mm256_loadu_ps(in.z + i);
+                const __m256 nx = _mm256_fmadd_ps(m8, z, _mm256_fmadd_ps(m4, y, _mm256_mul_ps(m0, x)));
+                const __m256 ny = _mm256_fmadd_ps(m9, z, _mm256_fmadd_ps(m5, y, _mm256_mul_ps(m1, x)));
+                const __m256 nz = _mm256_fmadd_ps(m10, z, _mm256_fmadd_ps(m6, y, _mm256_mul_ps(m2, x)));
+                const __m256 lengthSq = _mm256_fmadd_ps(nz, nz, _mm256_fmadd_ps(ny, ny, _mm256_mul_ps(nx, nx)));
+                const __m256 inverseLength = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSq));
+                _mm256_storeu_ps(out.x + i, _mm256_mul_ps(nx, inverseLength));
+                _mm256_storeu_ps(out.y + i, _mm256_mul_ps(ny, inverseLength));
+                _mm256_storeu_ps(out.z + i, _mm256_mul_ps(nz, inverseLength));
+            }
+            Detail::GetScalarKernels().transformNormals(m, Offset(in, i), Offset(out, i), count - i);
+        }
+
+        static void TransformAabbs(const float* m, SoAConstAabbs in, SoAAabbs out, uint32_t count)
+        {
+            const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+            const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+            const __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+            const __m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+            const __m256 a0 = Abs(m[0]), a1 = Abs(m[1]), a2 = Abs(m[2]);
+            const __m256 a4 = Abs(m[4]), a5 = Abs(m[5]), a6 = Abs(m[6]);
+            const __m256 a8 = Abs(m[8]), a9 = Abs(m[9]), a10 = Abs(m[10]);
+            const __m256 half = _mm256_set1_ps(0.5f);
+
+            uint32_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 minX = _mm256_loadu_ps(in.min.x + i), maxX = _mm256_loadu_ps(in.max.x + i);
+                const __m256 minY = _mm256_loadu_ps(in.min.y + i), maxY = _mm256_loadu_ps(in.max.y + i);
+                const __m256 minZ = _mm256_loadu_ps(in.min.z + i), maxZ = _mm256_loadu_ps(in.max.z + i);
+                const __m256 cx = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half), ex = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+                const __m256 cy = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half), ey = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+                const __m256 cz = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half), ez = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+                const __m256 tx = _mm256_fmadd_ps(m8, cz, _mm256_fmadd_ps(m4, cy, _mm256_fmadd_ps(m0, cx, m12)));
+                const __m256 ty = _mm256_fmadd_ps(m9, cz, _mm256_fmadd_ps(m5, cy, _mm256_fmadd_ps(m1, cx, m13)));
+                const __m256 tz = _mm256_fmadd_ps(m10, cz, _mm256_fmadd_ps(m6, cy, _mm256_fmadd_ps(m2, cx, m14)));
+                const __m256 rx = _mm256_fmadd_ps(a8, ez, _mm256_fmadd_ps(a4, ey, _mm256_mul_ps(a0, ex)));
+                const __m256 ry = _mm256_fmadd_ps(a9, ez, _mm256_fmadd_ps(a5, ey, _mm256_mul_ps(a1, ex)));
+                const __m256 rz = _mm256_fmadd_ps(a10, ez, _mm256_fmadd_ps(a6, ey, _mm256_mul_ps(a2, ex)));
+
+                _mm256_storeu_ps(out.min.x + i, _mm256_sub_ps(tx, rx)); _mm256_storeu_ps(out.max.x + i, _mm256_add_ps(tx, rx));
+                _mm256_storeu_ps(out.min.y + i, _mm256_sub_ps(ty, ry)); _mm256_storeu_ps(out.max.y + i, _mm256_add_ps(ty, ry));
+                _mm256_storeu_ps(out.min.z + i, _mm256_sub_ps(tz, rz)); _mm256_storeu_ps(out.max.z + i, _mm256_add_ps(tz, rz));
+            }
+            Detail::GetScalarKernels().transformAabbs(m, { Offset(in.min, i), Offset(in.max, i) },
+                { Offset(out.min, i), Offset(out.max, i) }, count - i);
+        }
+
+        static uint32_t CullSpheres(const float* planes, SoASpheres spheres, uint32_t count, uint32_t* visible)
+        {
+            __m256 nx[6], ny[6], nz[6], d[6];
+            for (int p = 0; p < 6; p++)
+            {
+                nx[p] = _mm256_set1_ps(planes[p * 4 + 0]);
+                ny[p] = _mm256_set1_ps(planes[p * 4 + 1]);
+                nz[p] = _mm256_set1_ps(planes[p * 4 + 2]);
+                d[p] = _mm256_set1_ps(planes[p * 4 + 3]);
+            }
+            const __m256 zero = _mm256_setzero_ps();
+
+            uint32_t visibleCount = 0;
+            uint32_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 x = _mm256_loadu_ps(spheres.center.x + i);
+                const __m256 y = _mm256_loadu_ps(spheres.center.y + i);
+                const __m256 z = _mm256_loadu_ps(spheres.center.z + i);
+                const __m256 r = _mm256_loadu_ps(spheres.radius + i);
+
+                __m256 closest = _mm256_add_ps(_mm256_fmadd_ps(nz[0], z, _mm256_fmadd_ps(ny[0], y, _mm256_fmadd_ps(nx[0], x, d[0]))), r);
+                for (int p = 1; p < 6; p++)
+                {
+                    closest = _mm256_min_ps(closest,
+                        _mm256_add_ps(_mm256_fmadd_ps(nz[p], z, _mm256_fmadd_ps(ny[p], y, _mm256_fmadd_ps(nx[p], x, d[p]))), r));
+                }
+
+                // branchless append: every lane writes, only visible ones advance the cursor.
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(closest, zero, _CMP_GE_OQ)));
+                for (uint32_t lane = 0; lane < 8; lane++)
+                {
+                    visible[visibleCount] = i + lane;
+                    visibleCount += (mask >> lane) & 1u;
+                }
+            }
+
+            const uint32_t tail = Detail::GetScalarKernels().cullSpheres(planes,
+                { Offset(spheres.center, i), spheres.radius + i }, count - i, visible + visibleCount);
+            for (uint32_t t = 0; t < tail; t++)
+            {
+                visible[visibleCount + t] += i;
+            }
+            return visibleCount + tail;
+        }
+
+        static uint32_t CullBoxes(const float* planes, SoABoxes boxes, uint32_t count, uint32_t* visible)
+        {
+            __m256 nx[6], ny[6], nz[6], ax[6], ay[6], az[6], d[6];
+            for (int p = 0; p < 6; p++)
+            {
+                nx[p] = _mm256_set1_ps(planes[p * 4 + 0]);
+                ny[p] = _mm256_set1_ps(planes[p * 4 + 1]);
+                nz[p] = _mm256_set1_ps(planes[p * 4 + 2]);
+                ax[p] = Abs(planes[p * 4 + 0]);
+                ay[p] = Abs(planes[p * 4 + 1]);
+                az[p] = Abs(planes[p * 4 + 2]);
+                d[p] = _mm256_set1_ps(planes[p * 4 + 3]);
+            }
+            const __m256 zero = _mm256_setzero_ps();
+
+            uint32_t visibleCount = 0;
+            uint32_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 x = _mm256_loadu_ps(boxes.center.x + i), y = _mm256_loadu_ps(boxes.center.y + i), z = _mm256_loadu_ps(boxes.center.z + i);
+                const __m256 ex = _mm256_loadu_ps(boxes.extent.x + i), ey = _mm256_loadu_ps(boxes.extent.y + i), ez = _mm256_loadu_ps(boxes.extent.z + i);
+
+                __m256 closest = _mm256_add_ps(_mm256_fmadd_ps(nz[0], z, _mm256_fmadd_ps(ny[0], y, _mm256_fmadd_ps(nx[0], x, d[0]))),
+                    _mm256_fmadd_ps(az[0], ez, _mm256_fmadd_ps(ay[0], ey, _mm256_mul_ps(ax[0], ex))));
+                for (int p = 1; p < 6; p++)
+                {
+                    closest = _mm256_min_ps(closest, _mm256_add_ps(_mm256_fmadd_ps(nz[p], z, _mm256_fmadd_ps(ny[p], y, _mm256_fmadd_ps(nx[p], x, d[p]))),
+                        _mm256_fmadd_ps(az[p], ez, _mm256_fmadd_ps(ay[p], ey, _mm256_mul_ps(ax[p], ex)))));
+                }
+
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(closest, zero, _CMP_GE_OQ)));
+                for (uint32_t lane = 0; lane < 8; lane++)
+                {
+                    visible[visibleCount] = i + lane;
+                    visibleCount += (mask >> lane) & 1u;
+                }
+            }
+
+            const uint32_t tail = Detail::GetScalarKernels().cullBoxes(planes,
+                { Offset(boxes.center, i), Offset(boxes.extent, i) }, count - i, visible + visibleCount);
+            for (uint32_t t = 0; t < tail; t++)
+            {
+                visible[visibleCount + t] += i;
+            }
+            return visibleCount + tail;
+        }
+
+        static const BatchKernelTable Kernels = {
+            SimdLevel::Avx2, "AVX2",
+            TransformPoints, TransformNormals, TransformAabbs, CullSpheres, CullBoxes
+        };
+    }
+
+    const BatchKernelTable* Detail::GetAvx2Kernels()
+    {
+        return &Avx2::Kernels;
+    }
+#else
+    const BatchKernelTable* Detail::GetAvx2Kernels()
+    {
+        return nullptr;
+    }
+#endif
+}
@@ -0,0 +1,197 @@
+#include <ANTUTU/PlatformInfo/VulkanDeviceInfo.h>
+
+#include <mutex>
+#include <cstring>
+#include <unordered_map>
+
+namespace att::PlatformInfo
+{
+    static std::mutex s_cacheMutex;
+    static std::unordered_map<VkPhysicalDevice, VulkanDeviceInfo> s_cache;
+
+    bool VulkanDeviceInfo::HasExtension(std::string_view name) const
+    {
+        for (const auto& extension : extensions)
+        {
+            if (name == extension.extensionName)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int32_t VulkanDeviceInfo::FindQueueFamily(VkQueueFlags flags) const
+    {
+        for (size_t i = 0; i < queueFamilies.size(); i++)
+        {
+            if ((queueFamilies[i].queueFlags & flags) == flags && queueFamilies[i].queueCount > 0)
+            {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    int32_t VulkanDeviceInfo::FindDedicatedQueueFamily(VkQueueFlags flags, VkQueueFlags excluded) const
+    {
+        for (size_t i = 0; i < queueFamilies.size(); i++)
+        {
+            if ((queueFamilies[i].queueFlags & flags) == flags &&
+                (queueFamilies[i].queueFlags & excluded) == 0 &&
+                queueFamilies[i].queueCount > 0)
+            {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    VkDeviceSize VulkanDeviceInfo::GetDeviceLocalMemory() const
+    {
+        VkDeviceSize total = 0;
+        for (uint32_t i = 0; i < memory.memoryHeapCount; i++)
+        {
+            if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            {
+                total += memory.memoryHeaps[i].size;
+            }
+        }
+        return total;
+    }
+
+    static VulkanDeviceInfo QueryUncached(VkPhysicalDevice device, uint32_t instanceApiVersion)
+    {
+        VulkanDeviceInfo info;
+        info.device = device;
+        info.instanceApiVersion = instanceApiVersion;
+
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+        info.extensions.resize(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, info.extensions.data());
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+        info.queueFamilies.resize(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, info.queueFamilies.data());
+
+        vkGetPhysicalDeviceMemoryProperties(device, &info.memory);
+
+        // the core version usable through the instance decides which chain members may be queried.
+        vkGetPhysicalDeviceProperties(device, &info.properties);
+        const uint32_t apiVersion = info.GetApiVersion();
+        const bool hasMeshShader = info.HasExtension(VK_EXT_MESH_SHADER_EXTENSION_NAME);
+
+        // properties chain
+        VkPhysicalDeviceProperties2 properties2{};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        void** nextProperty = &properties2.pNext;
+
+        info.properties11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_PROPERTIES;
+        info.properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+        info.properties13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_PROPERTIES;
+        info.meshShaderProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
+
+        if (apiVersion >= VK_API_VERSION_1_2)
+        {
+            *nextProperty = &info.properties11;
+            nextProperty = &info.properties11.pNext;
+            *nextProperty = &info.properties12;
+            nextProperty = &info.properties12.pNext;
+        }
+        if (apiVersion >= VK_API_VERSION_1_3)
+        {
+            *nextProperty = &info.properties13;
+            nextProperty = &info.properties13.pNext;
+        }
+        if (hasMeshShader)
+        {
+            *nextProperty = &info.meshShaderProperties;
+            nextProperty = &info.meshShaderProperties.pNext;
+        }
+
+        // features chain
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        void** nextFeature = &features2.pNext;
+
+        info.features11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+        info.features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        info.features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        info.meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+        info.presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+        info.presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+        if (apiVersion >= VK_API_VERSION_1_2)
+        {
+            *nextFeature = &info.features11;
+            nextFeature = &info.features11.pNext;
+            *nextFeature = &info.features12;
+            nextFeature = &info.features12.pNext;
+        }
+        if (apiVersion >= VK_API_VERSION_1_3)
+        {
+            *nextFeature = &info.features13;
+            nextFeature = &info.features13.pNext;
+        }
+        if (hasMeshShader)
+        {
+            *nextFeature = &info.meshShaderFeatures;
+            nextFeature = &info.meshShaderFeatures.pNext;
+        }
+        if (info.HasExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME))
+        {
+            *nextFeature = &info.presentIdFeatures;
+            nextFeature = &info.presentIdFeatures.pNext;
+        }
+        if (info.HasExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+        {
+            *nextFeature = &info.presentWaitFeatures;
+            nextFeature = &info.presentWaitFeatures.pNext;
+        }
+
+        if (apiVersion >= VK_API_VERSION_1_1)
+        {
+            vkGetPhysicalDeviceProperties2(device, &properties2);
+            vkGetPhysicalDeviceFeatures2(device, &features2);
+            info.properties = properties2.properties;
+            info.features = features2.features;
+        }
+        else
+        {
+            vkGetPhysicalDeviceFeatures(device, &info.features);
+        }
+
+        // flatten: the chain pointers refer to this local object and must not survive copies.
+        info.properties11.pNext = nullptr;
+        info.properties12.pNext = nullptr;
+        info.properties13.pNext = nullptr;
+        info.meshShaderProperties.pNext = nullptr;
+        info.features11.pNext = nullptr;
+        info.features12.pNext = nullptr;
+        info.features13.pNext = nullptr;
+        info.meshShaderFeatures.pNext = nullptr;
+        info.presentIdFeatures.pNext = nullptr;
+        info.presentWaitFeatures.pNext = nullptr;
+
+        return info;
+    }
+
+    VulkanDeviceInfo QueryVulkanDeviceInfo(VkPhysicalDevice device, uint32_t instanceApiVersion)
+    {
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        auto it = s_cache.find(device);
+        if (it != s_cache.end() && it->second.instanceApiVersion == instanceApiVersion)
+        {
+            return it->second;
+        }
+        return s_cache.insert_or_assign(device, QueryUncached(device, instanceApiVersion)).first->second;
+    }
+
+    void ClearVulkanDeviceInfoCache()
+    {
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        s_cache.clear();
+    }
+}
@@ -0,0 +1,65 @@
+#include <ANTUTU/RHI/HeadlessSurfaceProvider.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <cstring>
+
+namespace att::RHI
+{
+    HeadlessSurfaceProvider::HeadlessSurfaceProvider(bool useHeadlessSurface)
+        : m_useHeadlessSurface(useHeadlessSurface && IsHeadlessSurfaceSupported())
+    {
+    }
+
+    VkSurfaceKHR* HeadlessSurfaceProvider::CreateSurface(VkInstance instance) const
+    {
+        if (!m_useHeadlessSurface)
+        {
+            return nullptr;
+        }
+
+        auto createHeadlessSurface = reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(
+            vkGetInstanceProcAddr(instance, "vkCreateHeadlessSurfaceEXT"));
+        if (createHeadlessSurface == nullptr)
+        {
+            LOG_WARN("vkCreateHeadlessSurfaceEXT not found, rendering offscreen.");
+            return nullptr;
+        }
+
+        VkHeadlessSurfaceCreateInfoEXT createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+        m_surface = VK_NULL_HANDLE;
+        if (createHeadlessSurface(instance, &createInfo, nullptr, &m_surface) != VK_SUCCESS)
+        {
+            LOG_WARN("Failed to create a headless surface, rendering offscreen.");
+            return nullptr;
+        }
+        return &m_surface;
+    }
+
+    std::vector<const char*> HeadlessSurfaceProvider::GetRequiredExtensions() const
+    {
+        if (!m_useHeadlessSurface)
+        {
+            return {};
+        }
+        return { VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME };
+    }
+
+    bool HeadlessSurfaceProvider::IsHeadlessSurfaceSupported()
+    {
+        uint32_t extensionCount = 0;
+        vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, extensions.data());
+
+        for (const auto& extension : extensions)
+        {
+            if (strcmp(extension.extensionName, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
@@ -0,0 +1,137 @@
+#include <ANTUTU/RHI/VulkanBuffer.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Stats.h>
+
+namespace att::RHI
+{
+    VulkanBuffer::~VulkanBuffer()
+    {
+        Destroy();
+    }
+
+    VulkanBuffer::VulkanBuffer(VulkanBuffer&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    VulkanBuffer& VulkanBuffer::operator=(VulkanBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Destroy();
+            m_device = other.m_device;
+            m_buffer = other.m_buffer;
+            m_memory = other.m_memory;
+            m_size = other.m_size;
+            m_mapped = other.m_mapped;
+
+            other.m_device = VK_NULL_HANDLE;
+            other.m_buffer = VK_NULL_HANDLE;
+            other.m_memory = VK_NULL_HANDLE;
+            other.m_size = 0;
+            other.m_mapped = nullptr;
+        }
+        return *this;
+    }
+
+    bool VulkanBuffer::Initialize(VkPhysicalDevice physicalDevice, VkDevice device,
+                                  VkDeviceSize size, VkBufferUsageFlags usage,
+                                  VkMemoryPropertyFlags properties)
+    {
+        m_device = device;
+        m_size = size;
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &m_buffer) != VK_SUCCESS)
+        {
+            LOG_ERROR("Failed to create buffer of {0} bytes.", static_cast<uint64_t>(size));
+            return false;
+        }
+
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(m_device, m_buffer, &requirements);
+
+        uint32_t memoryType = FindMemoryType(physicalDevice, requirements.memoryTypeBits, properties);
+        if (memoryType == UINT32_MAX)
+        {
+            LOG_ERROR("No memory type matches the requested buffer properties.");
+            Destroy();
+            return false;
+        }
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = requirements.size;
+        allocInfo.memoryTypeIndex = memoryType;
+
+        if (vkAllocateMemory(m_device, &allocInfo, nullptr, &m_memory) != VK_SUCCESS)
+        {
+            LOG_ERROR("Failed to allocate {0} bytes of buffer memory.", static_cast<uint64_t>(requirements.size));
+            Destroy();
+            return false;
+        }
+        vkBindBufferMemory(m_device, m_buffer, m_memory, 0);
+        m_allocationSize = requirements.size;
+        STATS_ADJUST(Common::Stats::GpuMemory, m_allocationSize);
+
+        if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
+            if (vkMapMemory(m_device, m_memory, 0, VK_WHOLE_SIZE, 0, &m_mapped) != VK_SUCCESS)
+            {
+                LOG_ERROR("Failed to map buffer memory.");
+                Destroy();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void VulkanBuffer::Destroy()
+    {
+        if (m_device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        if (m_mapped != nullptr)
+        {
+            vkUnmapMemory(m_device, m_memory);
+            m_mapped = nullptr;
+        }
+        if (m_buffer != VK_NULL_HANDLE)
+        {
+            vkDestroyBuffer(m_device, m_buffer, nullptr);
+            m_buffer = VK_NULL_HANDLE;
+        }
+        if (m_memory != VK_NULL_HANDLE)
+        {
+            vkFreeMemory(m_device, m_memory, nullptr);
+            m_memory = VK_NULL_HANDLE;
+            STATS_ADJUST(Common::Stats::GpuMemory, -static_cast<double>(m_allocationSize));
+        }
+        m_size = 0;
+        m_allocationSize = 0;
+    }
+
+    uint32_t VulkanBuffer::FindMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter,
+                                          VkMemoryPropertyFlags properties)
+    {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+        {
+            if ((typeFilter & (1u << i)) &&
+                (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            {
+                return i;
+            }
+        }
+        return UINT32_MAX;
+    }
+};
@@ -0,0 +1,48 @@
+#include <ANTUTU/RHI/VulkanDeletionQueue.hpp>
+
+#include <vector>
+
+namespace att::RHI
+{
+    VulkanDeletionQueue::~VulkanDeletionQueue()
+    {
+        FlushAll();
+    }
+
+    void VulkanDeletionQueue::Push(uint64_t frameNumber, Deleter deleter)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.push_back({ frameNumber, std::move(deleter) });
+    }
+
+    void VulkanDeletionQueue::Flush(uint64_t completedFrameNumber)
+    {
+        // deleters run outside the lock, they may retire further resources.
+        std::vector<Deleter> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // frame numbers are pushed in increasing order.
+            while (!m_entries.empty() && m_entries.front().frameNumber <= completedFrameNumber)
+            {
+                ready.push_back(std::move(m_entries.front().deleter));
+                m_entries.pop_front();
+            }
+        }
+
+        for (Deleter& deleter : ready)
+        {
+            deleter();
+        }
+    }
+
+    void VulkanDeletionQueue::FlushAll()
+    {
+        Flush(UINT64_MAX);
+    }
+
+    size_t VulkanDeletionQueue::GetPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+};
@@ -0,0 +1,291 @@
+#include <ANTUTU/RHI/VulkanDescriptorAllocator.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Stats.h>
+
+#include <algorithm>
+
+namespace att::RHI
+{
+    // pools grow by 1.5x every time a chain runs dry, up to this many sets per pool.
+    static constexpr uint32_t MaxSetsPerPool = 4096;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// DescriptorPoolChain
+    ////////////////////////////////////////////////////////////////////////////
+    DescriptorPoolChain::~DescriptorPoolChain()
+    {
+        Destroy();
+    }
+
+    DescriptorPoolChain::DescriptorPoolChain(DescriptorPoolChain&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    DescriptorPoolChain& DescriptorPoolChain::operator=(DescriptorPoolChain&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Destroy();
+            m_device = other.m_device;
+            m_ratios = std::move(other.m_ratios);
+            m_readyPools = std::move(other.m_readyPools);
+            m_fullPools = std::move(other.m_fullPools);
+            m_setsPerPool = other.m_setsPerPool;
+
+            other.m_device = VK_NULL_HANDLE;
+            other.m_readyPools.clear();
+            other.m_fullPools.clear();
+        }
+        return *this;
+    }
+
+    bool DescriptorPoolChain::Initialize(VkDevice device, uint32_t initialSets,
+                                         const std::vector<DescriptorPoolSizeRatio>& ratios)
+    {
+        m_device = device;
+        m_ratios = ratios;
+        m_setsPerPool = std::max(initialSets, 1u);
+
+        VkDescriptorPool pool = CreatePool(m_setsPerPool);
+        if (pool == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+        m_readyPools.push_back(pool);
+        return true;
+    }
+
+    void DescriptorPoolChain::Destroy()
+    {
+        if (m_device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        for (VkDescriptorPool pool : m_readyPools)
+        {
+            vkDestroyDescriptorPool(m_device, pool, nullptr);
+        }
+        for (VkDescriptorPool pool : m_fullPools)
+        {
+            vkDestroyDescriptorPool(m_device, pool, nullptr);
+        }
+        STATS_ADJUST(Common::Stats::DescriptorPools, -static_cast<double>(m_readyPools.size() + m_fullPools.size()));
+        m_readyPools.clear();
+        m_fullPools.clear();
+        m_device = VK_NULL_HANDLE;
+    }
+
+    VkDescriptorSet DescriptorPoolChain::Allocate(VkDescriptorSetLayout layout, const void* pNext)
+    {
+        VkDescriptorPool pool = GetPool();
+        if (pool == VK_NULL_HANDLE)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext = pNext;
+        allocInfo.descriptorPool = pool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        VkResult result = vkAllocateDescriptorSets(m_device, &allocInfo, &set);
+
+        // the pool is exhausted: retire it and retry once with a fresh pool.
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL)
+        {
+            m_fullPools.push_back(pool);
+            m_readyPools.pop_back();
+
+            pool = GetPool();
+            if (pool == VK_NULL_HANDLE)
+            {
+                return VK_NULL_HANDLE;
+            }
+            allocInfo.descriptorPool = pool;
+            result = vkAllocateDescriptorSets(m_device, &allocInfo, &set);
+        }
+
+        if (result != VK_SUCCESS)
+        {
+            LOG_ERROR("Failed to allocate descriptor set: {0}", static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+        return set;
+    }
+
+    void DescriptorPoolChain::Reset()
+    {
+        for (VkDescriptorPool pool : m_readyPools)
+        {
+            vkResetDescriptorPool(m_device, pool, 0);
+        }
+        for (VkDescriptorPool pool : m_fullPools)
+        {
+            vkResetDescriptorPool(m_device, pool, 0);
+            m_readyPools.push_back(pool);
+        }
+        m_fullPools.clear();
+    }
+
+    VkDescriptorPool DescriptorPoolChain::GetPool()
+    {
+        if (!m_readyPools.empty())
+        {
+            return m_readyPools.back();
+        }
+
+        m_setsPerPool = std::min(m_setsPerPool + m_setsPerPool / 2, MaxSetsPerPool);
+        VkDescriptorPool pool = CreatePool(m_setsPerPool);
+        if (pool != VK_NULL_HANDLE)
+        {
+            m_readyPools.push_back(pool);
+        }
+        return pool;
+    }
+
+    VkDescriptorPool DescriptorPoolChain::CreatePool(uint32_t setCount)
+    {
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        poolSizes.reserve(m_ratios.size());
+        for (const DescriptorPoolSizeRatio& ratio : m_ratios)
+        {
+            uint32_t count = static_cast<uint32_t>(ratio.ratio * static_cast<float>(setCount));
+            poolSizes.push_back({ ratio.type, std::max(count, 1u) });
+        }
+
+        // no FREE_DESCRIPTOR_SET_BIT: sets are only ever released by resetting the pool.
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = 0;
+        poolInfo.maxSets = setCount;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        if (vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+        {
+            LOG_ERROR("Failed to create descriptor pool with {0} sets.", setCount);
+            return VK_NULL_HANDLE;
+        }
+        STATS_ADJUST(Common::Stats::DescriptorPools, 1);
+        return pool;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// VulkanDescriptorAllocator
+    ////////////////////////////////////////////////////////////////////////////
+    VulkanDescriptorAllocator::~VulkanDescriptorAllocator()
+    {
+        Destroy();
+    }
+
+    bool VulkanDescriptorAllocator::Initialize(VkDevice device,
+                                               uint32_t threadCount,
+                                               uint32_t framesInFlight,
+                                               const std::vector<DescriptorPoolSizeRatio>& ratios)
+    {
+        if (device == VK_NULL_HANDLE || threadCount == 0 || framesInFlight == 0)
+        {
+            LOG_ERROR("Invalid parameters for descriptor allocator creation.");
+            return false;
+        }
+
+        m_device = device;
+        m_threadCount = threadCount;
+        m_framesInFlight = framesInFlight;
+        m_ratios = ratios;
+
+        m_frameChains.resize(static_cast<size_t>(threadCount) * framesInFlight);
+        for (DescriptorPoolChain& chain : m_frameChains)
+        {
+            if (!chain.Initialize(device, DefaultSetsPerPool, ratios))
+            {
+                Destroy();
+                return false;
+            }
+        }
+
+        if (!m_immutableChain.Initialize(device, DefaultSetsPerPool, ratios))
+        {
+            Destroy();
+            return false;
+        }
+
+        LOG_INFO("Descriptor allocator created: {0} frames x {1} threads.", framesInFlight, threadCount);
+        return true;
+    }
+
+    void VulkanDescriptorAllocator::Destroy()
+    {
+        m_immutableSets.clear();
+        m_immutableChain.Destroy();
+        m_frameChains.clear();
+        m_device = VK_NULL_HANDLE;
+    }
+
+    void VulkanDescriptorAllocator::BeginFrame(uint32_t frameIndex)
+    {
+        for (uint32_t thread = 0; thread < m_threadCount; ++thread)
+        {
+            GetChain(frameIndex, thread).Reset();
+        }
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::Allocate(uint32_t frameIndex, uint32_t threadIndex,
+                                                        VkDescriptorSetLayout layout)
+    {
+        return GetChain(frameIndex, threadIndex).Allocate(layout);
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::GetOrCreateImmutable(VkDescriptorSetLayout layout, uint64_t key,
+                                                                    const WriteCallback& writer)
+    {
+        std::lock_guard<std::mutex> lock(m_immutableMutex);
+
+        const ImmutableKey cacheKey{ layout, key };
+        auto it = m_immutableSets.find(cacheKey);
+        if (it != m_immutableSets.end())
+        {
+            return it->second;
+        }
+
+        VkDescriptorSet set = m_immutableChain.Allocate(layout);
+        if (set == VK_NULL_HANDLE)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        if (writer)
+        {
+            writer(set);
+        }
+        m_immutableSets.emplace(cacheKey, set);
+        return set;
+    }
+
+    void VulkanDescriptorAllocator::ClearImmutableCache()
+    {
+        std::lock_guard<std::mutex> lock(m_immutableMutex);
+        m_immutableSets.clear();
+        m_immutableChain.Reset();
+    }
+
+    const std::vector<DescriptorPoolSizeRatio>& VulkanDescriptorAllocator::GetDefaultRatios()
+    {
+        static const std::vector<DescriptorPoolSizeRatio> ratios = {
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,          2.0f },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,  1.0f },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,          2.0f },
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,  4.0f },
+            { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,           1.0f },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,           1.0f },
+            { VK_DESCRIPTOR_TYPE_SAMPLER,                 0.5f },
+        };
+        return ratios;
+    }
+};
@@ -0,0 +1,178 @@
+#include <ANTUTU/RHI/VulkanDeviceCapabilities.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <cstring>
+
+namespace att::RHI
+{
+    static DeviceCapabilities s_capabilities;
+
+    const DeviceCapabilities& GetDeviceCapabilities()
+    {
+        return s_capabilities;
+    }
+
+    void SetDeviceCapabilities(const DeviceCapabilities& capabilities)
+    {
+        s_capabilities = capabilities;
+    }
+
+    void VulkanDeviceFeatureSet::AddExtension(const PlatformInfo::VulkanDeviceInfo& info, const char* name, bool* enabled)
+    {
+        const bool supported = info.HasExtension(name);
+        if (supported)
+        {
+            bool listed = false;
+            for (const char* extension : m_extensions)
+            {
+                listed = listed || strcmp(extension, name) == 0;
+            }
+            if (!listed)
+            {
+                m_extensions.push_back(name);
+            }
+        }
+        if (enabled != nullptr)
+        {
+            *enabled = supported;
+        }
+    }
+
+    void VulkanDeviceFeatureSet::Build(const PlatformInfo::VulkanDeviceInfo& info,
+                                       const std::vector<const char*>& requiredExtensions)
+    {
+        m_extensions = requiredExtensions;
+        m_capabilities = DeviceCapabilities{};
+
+        m_features2 = VkPhysicalDeviceFeatures2{};
+        m_features11 = VkPhysicalDeviceVulkan11Features{};
+        m_features12 = VkPhysicalDeviceVulkan12Features{};
+        m_features13 = VkPhysicalDeviceVulkan13Features{};
+        m_meshShaderFeatures = VkPhysicalDeviceMeshShaderFeaturesEXT{};
+        m_presentIdFeatures = VkPhysicalDevicePresentIdFeaturesKHR{};
+        m_presentWaitFeatures = VkPhysicalDevicePresentWaitFeaturesKHR{};
+
+        m_features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        m_features11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+        m_features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        m_features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        m_meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+        m_presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+        m_presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+
+        DeviceCapabilities& caps = m_capabilities;
+        const uint32_t apiVersion = info.GetApiVersion();
+
+        // core 1.0 features
+        m_features2.features.multiDrawIndirect = info.features.multiDrawIndirect;
+        m_features2.features.drawIndirectFirstInstance = info.features.drawIndirectFirstInstance;
+        m_features2.features.samplerAnisotropy = info.features.samplerAnisotropy;
+        m_features2.features.pipelineStatisticsQuery = info.features.pipelineStatisticsQuery;
+        m_features2.features.shaderInt16 = info.features.shaderInt16;
+        m_features2.features.textureCompressionBC = info.features.textureCompressionBC;
+        m_features2.features.textureCompressionASTC_LDR = info.features.textureCompressionASTC_LDR;
+        caps.multiDrawIndirect = info.features.multiDrawIndirect == VK_TRUE;
+        caps.pipelineStatistics = info.features.pipelineStatisticsQuery == VK_TRUE;
+
+        void** next = &m_features2.pNext;
+
+        if (apiVersion >= VK_API_VERSION_1_2)
+        {
+            m_features11.shaderDrawParameters = info.features11.shaderDrawParameters;
+            m_features11.storageBuffer16BitAccess = info.features11.storageBuffer16BitAccess;
+
+            m_features12.drawIndirectCount = info.features12.drawIndirectCount;
+            m_features12.descriptorIndexing = info.features12.descriptorIndexing;
+            m_features12.runtimeDescriptorArray = info.features12.runtimeDescriptorArray;
+            m_features12.descriptorBindingPartiallyBound = info.features12.descriptorBindingPartiallyBound;
+            m_features12.shaderSampledImageArrayNonUniformIndexing = info.features12.shaderSampledImageArrayNonUniformIndexing;
+            m_features12.bufferDeviceAddress = info.features12.bufferDeviceAddress;
+            m_features12.timelineSemaphore = info.features12.timelineSemaphore;
+            m_features12.hostQueryReset = info.features12.hostQueryReset;
+            m_features12.samplerFilterMinmax = info.features12.samplerFilterMinmax;
+            m_features12.shaderInt8 = info.features12.shaderInt8;
+            m_features12.storageBuffer8BitAccess = info.features12.storageBuffer8BitAccess;
+
+            caps.drawIndirectCount = info.features12.drawIndirectCount == VK_TRUE;
+            caps.descriptorIndexing = info.features12.descriptorIndexing == VK_TRUE;
+            caps.bufferDeviceAddress = info.features12.bufferDeviceAddress == VK_TRUE;
+            caps.timelineSemaphore = info.features12.timelineSemaphore == VK_TRUE;
+            caps.hostQueryReset = info.features12.hostQueryReset == VK_TRUE;
+            caps.samplerFilterMinmax = info.features12.samplerFilterMinmax == VK_TRUE;
+
+            *next = &m_features11;
+            next = &m_features11.pNext;
+            *next = &m_features12;
+            next = &m_features12.pNext;
+        }
+
+        if (apiVersion >= VK_API_VERSION_1_3)
+        {
+            m_features13.synchronization2 = info.features13.synchronization2;
+            m_features13.dynamicRendering = info.features13.dynamicRendering;
+            m_features13.maintenance4 = info.features13.maintenance4;
+
+            caps.synchronization2 = info.features13.synchronization2 == VK_TRUE;
+            caps.dynamicRendering = info.features13.dynamicRendering == VK_TRUE;
+
+            *next = &m_features13;
+            next = &m_features13.pNext;
+        }
+
+        // extension features, only chained when the extension is enabled.
+        bool meshShaderExtension = false;
+        if (info.meshShaderFeatures.taskShader && info.meshShaderFeatures.meshShader)
+        {
+            AddExtension(info, VK_EXT_MESH_SHADER_EXTENSION_NAME, &meshShaderExtension);
+        }
+        if (meshShaderExtension)
+        {
+            m_meshShaderFeatures.taskShader = VK_TRUE;
+            m_meshShaderFeatures.meshShader = VK_TRUE;
+            caps.meshShader = true;
+            *next = &m_meshShaderFeatures;
+            next = &m_meshShaderFeatures.pNext;
+        }
+
+        // present id / wait extend VK_KHR_swapchain, headless devices don't have one.
+        bool swapchain = false;
+        for (const char* extension : requiredExtensions)
+        {
+            swapchain = swapchain || strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0;
+        }
+        bool presentIdExtension = false;
+        bool presentWaitExtension = false;
+        if (swapchain && info.presentIdFeatures.presentId && info.presentWaitFeatures.presentWait)
+        {
+            AddExtension(info, VK_KHR_PRESENT_ID_EXTENSION_NAME, &presentIdExtension);
+            AddExtension(info, VK_KHR_PRESENT_WAIT_EXTENSION_NAME, &presentWaitExtension);
+        }
+        if (presentIdExtension && presentWaitExtension)
+        {
+            m_presentIdFeatures.presentId = VK_TRUE;
+            m_presentWaitFeatures.presentWait = VK_TRUE;
+            caps.presentId = true;
+            caps.presentWait = true;
+            *next = &m_presentIdFeatures;
+            next = &m_presentIdFeatures.pNext;
+            *next = &m_presentWaitFeatures;
+            next = &m_presentWaitFeatures.pNext;
+        }
+
+        // queues and limits
+        caps.graphicsFamily = info.FindQueueFamily(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        caps.computeFamily = info.FindDedicatedQueueFamily(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+        caps.transferFamily = info.FindDedicatedQueueFamily(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        caps.timestampPeriod = info.properties.limits.timestampPeriod;
+        if (caps.graphicsFamily >= 0)
+        {
+            caps.timestampValidBits = info.queueFamilies[caps.graphicsFamily].timestampValidBits;
+        }
+        caps.deviceLocalMemory = info.GetDeviceLocalMemory();
+
+        LOG_INFO("Device features: meshShader {0}, drawIndirectCount {1}, descriptorIndexing {2}, "
+                 "timelineSemaphore {3}, synchronization2 {4}, presentWait {5}, pipelineStatistics {6}.",
+                 caps.meshShader, caps.drawIndirectCount, caps.descriptorIndexing,
+                 caps.timelineSemaphore, caps.synchronization2, caps.presentWait, caps.pipelineStatistics);
+    }
+};
@@ -0,0 +1,207 @@
+#include <ANTUTU/RHI/VulkanDeviceSelector.hpp>
+
+#include <algorithm>
+
+namespace att::RHI
+{
+    static const char* DeviceTypeName(VkPhysicalDeviceType type)
+    {
+        switch (type)
+        {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   return "discrete";
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    return "virtual";
+            case VK_PHYSICAL_DEVICE_TYPE_CPU:            return "cpu";
+            default:                                     return "other";
+        }
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::Require(std::string name, Predicate predicate)
+    {
+        m_requirements.push_back({ std::move(name), std::move(predicate) });
+        return *this;
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::RequireExtension(const char* extension)
+    {
+        return Require(std::string("extension ") + extension,
+                       [extension](const PlatformInfo::VulkanDeviceInfo& info) { return info.HasExtension(extension); });
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::RequireApiVersion(uint32_t apiVersion)
+    {
+        return Require("api version " + std::to_string(VK_API_VERSION_MAJOR(apiVersion)) + "." +
+                       std::to_string(VK_API_VERSION_MINOR(apiVersion)),
+                       [apiVersion](const PlatformInfo::VulkanDeviceInfo& info) { return info.GetApiVersion() >= apiVersion; });
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::RequireQueue(VkQueueFlags flags)
+    {
+        return Require("queue flags " + std::to_string(flags),
+                       [flags](const PlatformInfo::VulkanDeviceInfo& info) { return info.FindQueueFamily(flags) >= 0; });
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::RequirePresent(VkSurfaceKHR surface)
+    {
+        return Require("present support", [surface](const PlatformInfo::VulkanDeviceInfo& info)
+        {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(info.queueFamilies.size()); i++)
+            {
+                VkBool32 presentSupport = VK_FALSE;
+                vkGetPhysicalDeviceSurfaceSupportKHR(info.device, i, surface, &presentSupport);
+                if (presentSupport)
+                {
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::Prefer(std::string name, int64_t weight, Predicate predicate)
+    {
+        m_preferences.push_back({ std::move(name), [weight, predicate = std::move(predicate)](const PlatformInfo::VulkanDeviceInfo& info)
+        {
+            return predicate(info) ? weight : int64_t(0);
+        }});
+        return *this;
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::PreferExtension(const char* extension, int64_t weight)
+    {
+        return Prefer(std::string("extension ") + extension, weight,
+                      [extension](const PlatformInfo::VulkanDeviceInfo& info) { return info.HasExtension(extension); });
+    }
+
+    VulkanDeviceSelector& VulkanDeviceSelector::PreferScore(std::string name, Scorer scorer)
+    {
+        m_preferences.push_back({ std::move(name), std::move(scorer) });
+        return *this;
+    }
+
+    VulkanDeviceSelector VulkanDeviceSelector::CreateDefault(VkSurfaceKHR surface)
+    {
+        using Info = PlatformInfo::VulkanDeviceInfo;
+
+        VulkanDeviceSelector selector;
+        selector.RequireApiVersion(VK_API_VERSION_1_1)
+                .RequireQueue(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+
+        if (surface != VK_NULL_HANDLE)
+        {
+            selector.RequireExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME)
+                    .RequirePresent(surface);
+        }
+
+        selector.PreferScore("device type", [](const Info& info) -> int64_t
+                {
+                    switch (info.properties.deviceType)
+                    {
+                        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   return 10000;
+                        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return 1000;
+                        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    return 100;
+                        default:                                     return 0;
+                    }
+                })
+                // 1 point per 4 MiB of VRAM, capped at 16 GiB so memory can't outweigh the device type.
+                .PreferScore("device local memory", [](const Info& info) -> int64_t
+                {
+                    const VkDeviceSize cap = VkDeviceSize(16) << 30;
+                    return static_cast<int64_t>(std::min(info.GetDeviceLocalMemory(), cap) >> 22);
+                })
+                .Prefer("mesh shader", 2000, [](const Info& info)
+                {
+                    return info.meshShaderFeatures.taskShader && info.meshShaderFeatures.meshShader;
+                })
+                .Prefer("draw indirect count", 1500, [](const Info& info) { return info.features12.drawIndirectCount == VK_TRUE; })
+                .Prefer("multi draw indirect", 500, [](const Info& info) { return info.features.multiDrawIndirect == VK_TRUE; })
+                .Prefer("descriptor indexing", 500, [](const Info& info) { return info.features12.descriptorIndexing == VK_TRUE; })
+                .Prefer("timeline semaphore", 300, [](const Info& info) { return info.features12.timelineSemaphore == VK_TRUE; })
+                .Prefer("synchronization2", 200, [](const Info& info) { return info.features13.synchronization2 == VK_TRUE; })
+                .Prefer("dedicated compute queue", 500, [](const Info& info)
+                {
+                    return info.FindDedicatedQueueFamily(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT) >= 0;
+                })
+                .Prefer("dedicated transfer queue", 300, [](const Info& info)
+                {
+                    return info.FindDedicatedQueueFamily(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT) >= 0;
+                })
+                .Prefer("timestamps", 100, [](const Info& info) { return info.properties.limits.timestampComputeAndGraphics == VK_TRUE; })
+                .Prefer("present wait", 100, [](const Info& info)
+                {
+                    return info.presentIdFeatures.presentId && info.presentWaitFeatures.presentWait;
+                })
+                .Prefer("geometry shader", 100, [](const Info& info) { return info.features.geometryShader == VK_TRUE; });
+
+        return selector;
+    }
+
+    bool VulkanDeviceSelector::Select(VkInstance instance, uint32_t instanceApiVersion, DeviceSelection& selection)
+    {
+        m_report.clear();
+
+        uint32_t deviceCount = 0;
+        vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+        std::vector<VkPhysicalDevice> devices(deviceCount);
+        vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+
+        if (deviceCount == 0)
+        {
+            m_report = "No Vulkan capable device found.\n";
+            return false;
+        }
+
+        bool found = false;
+        for (VkPhysicalDevice device : devices)
+        {
+            PlatformInfo::VulkanDeviceInfo info = PlatformInfo::QueryVulkanDeviceInfo(device, instanceApiVersion);
+
+            m_report += "Device '";
+            m_report += info.properties.deviceName;
+            m_report += "' (";
+            m_report += DeviceTypeName(info.properties.deviceType);
+            m_report += ", Vulkan " + std::to_string(VK_API_VERSION_MAJOR(info.GetApiVersion())) + "." +
+                        std::to_string(VK_API_VERSION_MINOR(info.GetApiVersion())) + ")\n";
+
+            bool suitable = true;
+            for (const Requirement& requirement : m_requirements)
+            {
+                const bool passed = requirement.predicate(info);
+                suitable = suitable && passed;
+                m_report += passed ? "  [pass] " : "  [FAIL] ";
+                m_report += requirement.name + "\n";
+            }
+
+            int64_t score = 0;
+            for (const Preference& preference : m_preferences)
+            {
+                const int64_t points = preference.scorer(info);
+                score += points;
+                m_report += "  [+" + std::to_string(points) + "] " + preference.name + "\n";
+            }
+
+            if (!suitable)
+            {
+                m_report += "  => rejected\n";
+                continue;
+            }
+
+            m_report += "  => score " + std::to_string(score) + "\n";
+            if (!found || score > selection.score)
+            {
+                selection.device = device;
+                selection.info = std::move(info);
+                selection.score = score;
+                found = true;
+            }
+        }
+
+        if (found)
+        {
+            m_report += "Selected '";
+            m_report += selection.info.properties.deviceName;
+            m_report += "'\n";
+        }
+        return found;
+    }
+};
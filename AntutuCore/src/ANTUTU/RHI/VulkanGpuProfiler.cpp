@@ -0,0 +1,308 @@
+#include <ANTUTU/RHI/VulkanGpuProfiler.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <cstdio>
+#include <algorithm>
+
+namespace att::RHI
+{
+    static constexpr uint32_t StatisticsCount = static_cast<uint32_t>(GpuPipelineStatistic::Count);
+
+    // order matches GpuPipelineStatistic, Vulkan returns the values in bit order.
+    static constexpr VkQueryPipelineStatisticFlags StatisticsFlags =
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+    static constexpr uint32_t InvalidScope = UINT32_MAX;
+
+    VulkanGpuProfiler::~VulkanGpuProfiler()
+    {
+        Destroy();
+    }
+
+    bool VulkanGpuProfiler::Initialize(VkDevice device, const DeviceCapabilities& capabilities, uint32_t maxScopesPerFrame)
+    {
+        if (capabilities.timestampValidBits == 0 || capabilities.timestampPeriod <= 0.0f)
+        {
+            LOG_WARN("Graphics queue has no timestamp support, GPU profiler disabled.");
+            return false;
+        }
+
+        m_device = device;
+        m_maxScopes = maxScopesPerFrame;
+        m_nsPerTick = static_cast<double>(capabilities.timestampPeriod);
+        m_timestampMask = capabilities.timestampValidBits >= 64
+            ? UINT64_MAX
+            : (uint64_t(1) << capabilities.timestampValidBits) - 1;
+        m_statisticsSupported = capabilities.pipelineStatistics;
+
+        for (FrameQueries& frame : m_frames)
+        {
+            VkQueryPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            poolInfo.queryCount = m_maxScopes * 2;
+            if (vkCreateQueryPool(m_device, &poolInfo, nullptr, &frame.timestampPool) != VK_SUCCESS)
+            {
+                LOG_ERROR("Failed to create timestamp query pool.");
+                Destroy();
+                return false;
+            }
+
+            if (m_statisticsSupported)
+            {
+                poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+                poolInfo.queryCount = m_maxScopes;
+                poolInfo.pipelineStatistics = StatisticsFlags;
+                if (vkCreateQueryPool(m_device, &poolInfo, nullptr, &frame.statisticsPool) != VK_SUCCESS)
+                {
+                    LOG_WARN("Failed to create pipeline statistics pool, statistics disabled.");
+                    m_statisticsSupported = false;
+                }
+            }
+        }
+
+        LOG_INFO("GPU profiler: {0} scopes per frame, {1} ns per tick, pipeline statistics {2}.",
+                 m_maxScopes, m_nsPerTick, m_statisticsSupported);
+        return true;
+    }
+
+    void VulkanGpuProfiler::Destroy()
+    {
+        if (m_device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        for (FrameQueries& frame : m_frames)
+        {
+            if (frame.timestampPool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(m_device, frame.timestampPool, nullptr);
+            }
+            if (frame.statisticsPool != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(m_device, frame.statisticsPool, nullptr);
+            }
+            frame = FrameQueries{};
+        }
+        m_current = nullptr;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    void VulkanGpuProfiler::BeginFrame(VkCommandBuffer cmd, uint64_t frameNumber)
+    {
+        if (m_device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        FrameQueries& frame = m_frames[frameNumber % Config::MaxFramesInFlight];
+        if (frame.recorded)
+        {
+            // the caller waited on this slot's fence, the queries are complete.
+            Resolve(frame);
+        }
+
+        vkCmdResetQueryPool(cmd, frame.timestampPool, 0, m_maxScopes * 2);
+        if (frame.statisticsPool != VK_NULL_HANDLE)
+        {
+            vkCmdResetQueryPool(cmd, frame.statisticsPool, 0, m_maxScopes);
+        }
+
+        frame.scopes.clear();
+        frame.statisticsCount = 0;
+        frame.frameNumber = frameNumber;
+        frame.recorded = true;
+
+        m_current = &frame;
+        m_openStack.clear();
+        m_openStatistics = -1;
+    }
+
+    uint32_t VulkanGpuProfiler::BeginScope(VkCommandBuffer cmd, const char* name, bool statistics)
+    {
+        if (m_current == nullptr || m_current->scopes.size() >= m_maxScopes)
+        {
+            return InvalidScope;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(m_current->scopes.size());
+        Scope scope{ name, static_cast<uint32_t>(m_openStack.size()), -1 };
+
+        // statistics queries can't nest, only the outermost requesting scope gets one.
+        if (statistics && m_statisticsSupported && m_openStatistics < 0)
+        {
+            scope.statisticsQuery = static_cast<int32_t>(m_current->statisticsCount++);
+            vkCmdBeginQuery(cmd, m_current->statisticsPool, static_cast<uint32_t>(scope.statisticsQuery), 0);
+            m_openStatistics = static_cast<int32_t>(index);
+        }
+
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_current->timestampPool, index * 2);
+
+        m_current->scopes.push_back(scope);
+        m_openStack.push_back(index);
+        return index;
+    }
+
+    void VulkanGpuProfiler::EndScope(VkCommandBuffer cmd, uint32_t scope)
+    {
+        if (scope == InvalidScope || m_current == nullptr)
+        {
+            return;
+        }
+
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_current->timestampPool, scope * 2 + 1);
+
+        const Scope& entry = m_current->scopes[scope];
+        if (entry.statisticsQuery >= 0)
+        {
+            vkCmdEndQuery(cmd, m_current->statisticsPool, static_cast<uint32_t>(entry.statisticsQuery));
+            m_openStatistics = -1;
+        }
+
+        if (!m_openStack.empty())
+        {
+            m_openStack.pop_back();
+        }
+    }
+
+    std::string VulkanGpuProfiler::FormatPassTable() const
+    {
+        std::string table;
+        char line[160];
+
+        snprintf(line, sizeof(line), "%-32s %9s %9s %9s %12s %12s\n",
+                 "pass", "last ms", "avg ms", "max ms", "primitives", "fragments");
+        table += line;
+
+        for (const GpuPassStats& pass : m_passStats)
+        {
+            snprintf(line, sizeof(line), "%-32s %9.3f %9.3f %9.3f %12llu %12llu\n",
+                     pass.name.c_str(), pass.lastMs, pass.averageMs, pass.maxMs,
+                     static_cast<unsigned long long>(pass.statistics[static_cast<uint32_t>(GpuPipelineStatistic::ClippingPrimitives)]),
+                     static_cast<unsigned long long>(pass.statistics[static_cast<uint32_t>(GpuPipelineStatistic::FragmentShaderInvocations)]));
+            table += line;
+        }
+
+        snprintf(line, sizeof(line), "%-32s %9.3f\n", "frame", m_lastFrameMs);
+        table += line;
+        return table;
+    }
+
+    void VulkanGpuProfiler::Resolve(FrameQueries& frame)
+    {
+        frame.recorded = false;
+        const uint32_t scopeCount = static_cast<uint32_t>(frame.scopes.size());
+        if (scopeCount == 0)
+        {
+            return;
+        }
+
+        // [value, availability] pairs. No WAIT_BIT: the fence already signalled,
+        // anything still unavailable (an unclosed scope) is skipped instead of stalling.
+        std::vector<uint64_t> timestamps(size_t(scopeCount) * 2 * 2);
+        vkGetQueryPoolResults(m_device, frame.timestampPool, 0, scopeCount * 2,
+                              timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t) * 2,
+                              VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        std::vector<uint64_t> statistics;
+        if (frame.statisticsCount > 0)
+        {
+            statistics.resize(size_t(frame.statisticsCount) * (StatisticsCount + 1));
+            vkGetQueryPoolResults(m_device, frame.statisticsPool, 0, frame.statisticsCount,
+                                  statistics.size() * sizeof(uint64_t), statistics.data(),
+                                  sizeof(uint64_t) * (StatisticsCount + 1),
+                                  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        }
+
+        uint64_t frameBegin = UINT64_MAX;
+        for (uint32_t i = 0; i < scopeCount; i++)
+        {
+            if (timestamps[i * 4 + 1] != 0)
+            {
+                frameBegin = std::min(frameBegin, timestamps[i * 4] & m_timestampMask);
+            }
+        }
+
+        m_lastFrame.clear();
+        double frameEndMs = 0.0;
+        for (uint32_t i = 0; i < scopeCount; i++)
+        {
+            const bool available = timestamps[i * 4 + 1] != 0 && timestamps[i * 4 + 3] != 0;
+            if (!available)
+            {
+                continue;
+            }
+
+            const uint64_t begin = timestamps[i * 4] & m_timestampMask;
+            const uint64_t end = timestamps[i * 4 + 2] & m_timestampMask;
+
+            GpuScopeResult result;
+            result.name = frame.scopes[i].name;
+            result.depth = frame.scopes[i].depth;
+            result.beginMs = static_cast<double>(begin - frameBegin) * m_nsPerTick * 1e-6;
+            result.endMs = static_cast<double>(std::max(begin, end) - frameBegin) * m_nsPerTick * 1e-6;
+
+            const int32_t query = frame.scopes[i].statisticsQuery;
+            if (query >= 0 && statistics[size_t(query) * (StatisticsCount + 1) + StatisticsCount] != 0)
+            {
+                result.hasStatistics = true;
+                for (uint32_t s = 0; s < StatisticsCount; s++)
+                {
+                    result.statistics[s] = statistics[size_t(query) * (StatisticsCount + 1) + s];
+                }
+            }
+
+            frameEndMs = std::max(frameEndMs, result.endMs);
+            Accumulate(result);
+            m_lastFrame.push_back(result);
+        }
+        m_lastFrameMs = frameEndMs;
+
+        if (m_frameCallback)
+        {
+            m_frameCallback(frame.frameNumber, m_lastFrame);
+        }
+    }
+
+    void VulkanGpuProfiler::Accumulate(const GpuScopeResult& result)
+    {
+        auto it = m_passIndex.find(result.name);
+        if (it == m_passIndex.end())
+        {
+            it = m_passIndex.emplace(result.name, m_passStats.size()).first;
+            m_passStats.emplace_back();
+            m_passStats.back().name = result.name;
+            m_passHistory.emplace_back();
+        }
+
+        GpuPassStats& pass = m_passStats[it->second];
+        PassHistory& history = m_passHistory[it->second];
+
+        const double duration = result.GetDurationMs();
+        history.samples[history.cursor] = duration;
+        history.cursor = (history.cursor + 1) % RollingWindow;
+        history.count = std::min(history.count + 1, RollingWindow);
+
+        double sum = 0.0;
+        double maximum = 0.0;
+        for (uint32_t i = 0; i < history.count; i++)
+        {
+            sum += history.samples[i];
+            maximum = std::max(maximum, history.samples[i]);
+        }
+
+        pass.lastMs = duration;
+        pass.averageMs = sum / history.count;
+        pass.maxMs = maximum;
+        pass.samples++;
+        if (result.hasStatistics)
+        {
+            std::copy(std::begin(result.statistics), std::end(result.statistics), std::begin(pass.statistics));
+        }
+    }
+};
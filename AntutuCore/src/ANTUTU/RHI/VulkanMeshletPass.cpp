@@ -0,0 +1,219 @@
+#include <ANTUTU/RHI/VulkanMeshletPass.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Stats.h>
+
+#include <cstring>
+#include <algorithm>
+
+namespace att::RHI
+{
+    template<typename T>
+    static VkDeviceSize ByteSize(const std::vector<T>& array)
+    {
+        // zero sized buffers are invalid.
+        return std::max<VkDeviceSize>(sizeof(T) * array.size(), 16);
+    }
+
+    VulkanMeshletPass::~VulkanMeshletPass()
+    {
+        Destroy();
+    }
+
+    bool VulkanMeshletPass::Initialize(VkPhysicalDevice physicalDevice, VkDevice device,
+                                       const Render::MeshletData& meshlets, bool useMeshShader)
+    {
+        if (useMeshShader)
+        {
+            // Meshlet.mesh declares its outputs with these limits, larger meshlets would be cut off.
+            for (const Render::Meshlet& meshlet : meshlets.meshlets)
+            {
+                if (meshlet.vertexCount > Render::MeshletMaxVertices || meshlet.triangleCount > Render::MeshletMaxTriangles)
+                {
+                    LOG_ERROR("Meshlet with {0} vertices and {1} triangles exceeds the mesh shader limits ({2}, {3}).",
+                              meshlet.vertexCount, meshlet.triangleCount,
+                              Render::MeshletMaxVertices, Render::MeshletMaxTriangles);
+                    return false;
+                }
+            }
+        }
+
+        m_device = device;
+        m_useMeshShader = useMeshShader;
+        m_meshletCount = static_cast<uint32_t>(meshlets.meshlets.size());
+
+        if (m_useMeshShader)
+        {
+            m_cmdDrawMeshTasks = reinterpret_cast<PFN_vkCmdDrawMeshTasksEXT>(
+                vkGetDeviceProcAddr(device, "vkCmdDrawMeshTasksEXT"));
+            if (m_cmdDrawMeshTasks == nullptr)
+            {
+                LOG_WARN("vkCmdDrawMeshTasksEXT not found, using the compute expansion fallback.");
+                m_useMeshShader = false;
+            }
+        }
+
+        const VkBufferUsageFlags storage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        const VkMemoryPropertyFlags deviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+        const VkDeviceSize meshletSize = ByteSize(meshlets.meshlets);
+        const VkDeviceSize boundsSize = ByteSize(meshlets.bounds);
+        const VkDeviceSize vertexSize = ByteSize(meshlets.vertices);
+        const VkDeviceSize triangleSize = ByteSize(meshlets.triangles);
+
+        bool ok =
+            m_meshletBuffer.Initialize(physicalDevice, device, meshletSize, storage, deviceLocal) &&
+            m_boundsBuffer.Initialize(physicalDevice, device, boundsSize, storage, deviceLocal) &&
+            m_vertexBuffer.Initialize(physicalDevice, device, vertexSize, storage, deviceLocal) &&
+            m_triangleBuffer.Initialize(physicalDevice, device, triangleSize, storage, deviceLocal) &&
+            m_stagingBuffer.Initialize(physicalDevice, device,
+                                       meshletSize + boundsSize + vertexSize + triangleSize,
+                                       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        if (ok && !m_useMeshShader)
+        {
+            for (const Render::Meshlet& meshlet : meshlets.meshlets)
+            {
+                m_maxIndexCount += meshlet.triangleCount * 3;
+            }
+            ok = m_expandedIndexBuffer.Initialize(physicalDevice, device,
+                                                  std::max<VkDeviceSize>(sizeof(uint32_t) * m_maxIndexCount, 16),
+                                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                                  deviceLocal) &&
+                 m_drawCommandBuffer.Initialize(physicalDevice, device, sizeof(VkDrawIndexedIndirectCommand),
+                                                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                deviceLocal);
+        }
+
+        if (!ok)
+        {
+            LOG_ERROR("Failed to create meshlet buffers for {0} meshlets.", m_meshletCount);
+            Destroy();
+            return false;
+        }
+
+        uint8_t* staging = static_cast<uint8_t*>(m_stagingBuffer.GetMappedData());
+        std::memcpy(staging, meshlets.meshlets.data(), sizeof(Render::Meshlet) * meshlets.meshlets.size());
+        staging += meshletSize;
+        std::memcpy(staging, meshlets.bounds.data(), sizeof(Render::MeshletBounds) * meshlets.bounds.size());
+        staging += boundsSize;
+        std::memcpy(staging, meshlets.vertices.data(), sizeof(uint32_t) * meshlets.vertices.size());
+        staging += vertexSize;
+        std::memcpy(staging, meshlets.triangles.data(), meshlets.triangles.size());
+
+        LOG_INFO("Meshlet pass created: {0} meshlets, {1} path.", m_meshletCount,
+                 m_useMeshShader ? "mesh shader" : "compute expansion");
+        return true;
+    }
+
+    void VulkanMeshletPass::Destroy()
+    {
+        m_drawCommandBuffer.Destroy();
+        m_expandedIndexBuffer.Destroy();
+        m_stagingBuffer.Destroy();
+        m_triangleBuffer.Destroy();
+        m_vertexBuffer.Destroy();
+        m_boundsBuffer.Destroy();
+        m_meshletBuffer.Destroy();
+        m_device = VK_NULL_HANDLE;
+    }
+
+    void VulkanMeshletPass::RecordUpload(VkCommandBuffer cmd)
+    {
+        VkDeviceSize offset = 0;
+        for (VulkanBuffer* destination : { &m_meshletBuffer, &m_boundsBuffer, &m_vertexBuffer, &m_triangleBuffer })
+        {
+            VkBufferCopy region{ offset, 0, destination->GetSize() };
+            vkCmdCopyBuffer(cmd, m_stagingBuffer.GetHandle(), destination->GetHandle(), 1, &region);
+            offset += destination->GetSize();
+        }
+
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanMeshletPass::ReleaseStaging()
+    {
+        m_stagingBuffer.Destroy();
+    }
+
+    void VulkanMeshletPass::WriteDescriptors(VkDescriptorSet set, VkBuffer viewParams, VkBuffer positions) const
+    {
+        const VkDescriptorBufferInfo infos[7] = {
+            { viewParams, 0, VK_WHOLE_SIZE },
+            { m_meshletBuffer.GetHandle(), 0, VK_WHOLE_SIZE },
+            { m_boundsBuffer.GetHandle(), 0, VK_WHOLE_SIZE },
+            { m_vertexBuffer.GetHandle(), 0, VK_WHOLE_SIZE },
+            { m_triangleBuffer.GetHandle(), 0, VK_WHOLE_SIZE },
+            // mesh path: vertex positions, fallback: draw command + expanded indices.
+            { m_useMeshShader ? positions : m_drawCommandBuffer.GetHandle(), 0, VK_WHOLE_SIZE },
+            { m_expandedIndexBuffer.GetHandle(), 0, VK_WHOLE_SIZE },
+        };
+
+        const uint32_t count = m_useMeshShader ? 6 : 7;
+        VkWriteDescriptorSet writes[7]{};
+        for (uint32_t i = 0; i < count; i++)
+        {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = set;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &infos[i];
+        }
+        vkUpdateDescriptorSets(m_device, count, writes, 0, nullptr);
+    }
+
+    void VulkanMeshletPass::RecordExpand(VkCommandBuffer cmd, VkPipeline expandPipeline,
+                                         VkPipelineLayout layout, VkDescriptorSet set)
+    {
+        if (m_useMeshShader)
+        {
+            return;
+        }
+
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        const VkDrawIndexedIndirectCommand reset{ 0, 1, 0, 0, 0 };
+        vkCmdUpdateBuffer(cmd, m_drawCommandBuffer.GetHandle(), 0, sizeof(reset), &reset);
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, expandPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, layout, 0, 1, &set, 0, nullptr);
+        vkCmdDispatch(cmd, (m_meshletCount + ExpandGroupSize - 1) / ExpandGroupSize, 1, 1);
+
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanMeshletPass::RecordDraw(VkCommandBuffer cmd) const
+    {
+        STATS_INCREMENT(Common::Stats::DrawCalls, 1);
+        if (m_useMeshShader)
+        {
+            m_cmdDrawMeshTasks(cmd, (m_meshletCount + TaskGroupSize - 1) / TaskGroupSize, 1, 1);
+        }
+        else
+        {
+            vkCmdBindIndexBuffer(cmd, m_expandedIndexBuffer.GetHandle(), 0, VK_INDEX_TYPE_UINT32);
+            vkCmdDrawIndexedIndirect(cmd, m_drawCommandBuffer.GetHandle(), 0, 1, sizeof(VkDrawIndexedIndirectCommand));
+        }
+    }
+};
@@ -0,0 +1,233 @@
+#include <ANTUTU/RHI/VulkanOffscreenRing.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Stats.h>
+
+#include <memory>
+#include <cstring>
+
+#if defined(__GNUC__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#endif
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_STATIC
+#include <stb_image_write.h>
+#if defined(__GNUC__)
+    #pragma GCC diagnostic pop
+#endif
+
+namespace att::RHI
+{
+    VulkanOffscreenRing::~VulkanOffscreenRing()
+    {
+        Destroy();
+    }
+
+    bool VulkanOffscreenRing::Initialize(const OffscreenRingDesc& desc, VulkanDeletionQueue* deletionQueue,
+                                         uint32_t width, uint32_t height)
+    {
+        m_desc = desc;
+        m_deletionQueue = deletionQueue;
+
+        if (m_desc.format != VK_FORMAT_R8G8B8A8_UNORM && m_desc.format != VK_FORMAT_R8G8B8A8_SRGB &&
+            m_desc.format != VK_FORMAT_B8G8R8A8_UNORM && m_desc.format != VK_FORMAT_B8G8R8A8_SRGB)
+        {
+            LOG_ERROR("Offscreen ring only supports 8 bit RGBA / BGRA formats.");
+            return false;
+        }
+        return Create(width, height);
+    }
+
+    void VulkanOffscreenRing::Destroy()
+    {
+        if (m_desc.device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+        DestroySlots(m_desc.device, m_slots);
+        m_desc.device = VK_NULL_HANDLE;
+    }
+
+    bool VulkanOffscreenRing::Recreate(uint32_t width, uint32_t height, uint64_t frameNumber)
+    {
+        auto retired = std::make_shared<std::vector<Slot>>(std::move(m_slots));
+        m_slots.clear();
+
+        VkDevice device = m_desc.device;
+        if (m_deletionQueue != nullptr)
+        {
+            m_deletionQueue->Push(frameNumber, [device, retired]() { DestroySlots(device, *retired); });
+        }
+        else
+        {
+            DestroySlots(device, *retired);
+        }
+
+        return Create(width, height);
+    }
+
+    uint32_t VulkanOffscreenRing::AcquireNextImage()
+    {
+        const uint32_t index = m_next;
+        m_next = (m_next + 1) % GetImageCount();
+        return index;
+    }
+
+    void VulkanOffscreenRing::RecordReadback(VkCommandBuffer cmd, uint32_t index) const
+    {
+        if (!m_desc.readback)
+        {
+            return;
+        }
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = 0;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = { m_extent.width, m_extent.height, 1 };
+        vkCmdCopyImageToBuffer(cmd, m_slots[index].image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               m_slots[index].readback.GetHandle(), 1, &region);
+
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    const void* VulkanOffscreenRing::GetReadbackData(uint32_t index) const
+    {
+        return m_desc.readback ? m_slots[index].readback.GetMappedData() : nullptr;
+    }
+
+    bool VulkanOffscreenRing::WritePng(uint32_t index, const std::string& path) const
+    {
+        const uint8_t* pixels = static_cast<const uint8_t*>(GetReadbackData(index));
+        if (pixels == nullptr)
+        {
+            LOG_ERROR("Offscreen ring was created without readback, can't write {0}.", path);
+            return false;
+        }
+
+        const size_t pixelCount = size_t(m_extent.width) * m_extent.height;
+        std::vector<uint8_t> rgba(pixels, pixels + pixelCount * 4);
+
+        if (m_desc.format == VK_FORMAT_B8G8R8A8_UNORM || m_desc.format == VK_FORMAT_B8G8R8A8_SRGB)
+        {
+            for (size_t i = 0; i < pixelCount; i++)
+            {
+                std::swap(rgba[i * 4 + 0], rgba[i * 4 + 2]);
+            }
+        }
+
+        if (stbi_write_png(path.c_str(), static_cast<int>(m_extent.width), static_cast<int>(m_extent.height),
+                           4, rgba.data(), static_cast<int>(m_extent.width * 4)) == 0)
+        {
+            LOG_ERROR("Failed to write {0}.", path);
+            return false;
+        }
+        return true;
+    }
+
+    bool VulkanOffscreenRing::Create(uint32_t width, uint32_t height)
+    {
+        m_extent = { width, height };
+        m_next = 0;
+        if (width == 0 || height == 0)
+        {
+            return true;
+        }
+
+        m_slots.resize(m_desc.imageCount);
+        for (Slot& slot : m_slots)
+        {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.format = m_desc.format;
+            imageInfo.extent = { width, height, 1 };
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                              VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            if (vkCreateImage(m_desc.device, &imageInfo, nullptr, &slot.image) != VK_SUCCESS)
+            {
+                LOG_ERROR("Failed to create offscreen image {0}x{1}.", width, height);
+                return false;
+            }
+
+            VkMemoryRequirements requirements;
+            vkGetImageMemoryRequirements(m_desc.device, slot.image, &requirements);
+
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = requirements.size;
+            allocInfo.memoryTypeIndex = VulkanBuffer::FindMemoryType(m_desc.physicalDevice, requirements.memoryTypeBits,
+                                                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            if (allocInfo.memoryTypeIndex == UINT32_MAX ||
+                vkAllocateMemory(m_desc.device, &allocInfo, nullptr, &slot.memory) != VK_SUCCESS ||
+                vkBindImageMemory(m_desc.device, slot.image, slot.memory, 0) != VK_SUCCESS)
+            {
+                LOG_ERROR("Failed to allocate offscreen image memory.");
+                return false;
+            }
+            slot.allocationSize = requirements.size;
+            STATS_ADJUST(Common::Stats::GpuMemory, slot.allocationSize);
+
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = slot.image;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = m_desc.format;
+            viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            if (vkCreateImageView(m_desc.device, &viewInfo, nullptr, &slot.view) != VK_SUCCESS)
+            {
+                LOG_ERROR("Failed to create offscreen image view.");
+                return false;
+            }
+
+            if (m_desc.readback &&
+                !slot.readback.Initialize(m_desc.physicalDevice, m_desc.device, VkDeviceSize(width) * height * 4,
+                                          VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+            {
+                LOG_ERROR("Failed to create offscreen readback buffer.");
+                return false;
+            }
+        }
+
+        LOG_INFO("Offscreen ring {0}x{1}, {2} images{3}.", width, height, m_desc.imageCount,
+                 m_desc.readback ? ", readback" : "");
+        return true;
+    }
+
+    void VulkanOffscreenRing::DestroySlots(VkDevice device, std::vector<Slot>& slots)
+    {
+        for (Slot& slot : slots)
+        {
+            slot.readback.Destroy();
+            if (slot.view != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(device, slot.view, nullptr);
+            }
+            if (slot.image != VK_NULL_HANDLE)
+            {
+                vkDestroyImage(device, slot.image, nullptr);
+            }
+            if (slot.memory != VK_NULL_HANDLE)
+            {
+                vkFreeMemory(device, slot.memory, nullptr);
+                STATS_ADJUST(Common::Stats::GpuMemory, -static_cast<double>(slot.allocationSize));
+            }
+        }
+        slots.clear();
+    }
+};
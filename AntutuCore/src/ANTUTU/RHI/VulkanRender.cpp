@@ -1,14 +1,36 @@
 #include <ANTUTU/RHI/VulkanRender.hpp>
+#include <Common/Profiler/Tracer.h>
+#include <Common/Profiler/Stats.h>
+#include <Common/Job/JobSystem.h>
 
-#include <map>
+#include <cstring>
 #include <set>
 #include <vector>
 #include <iostream>
 
+// window surfaces only, headless builds have neither GLFW nor a display.
+#if !defined(ANTUTU_HEADLESS)
+    #define GLFW_INCLUDE_NONE
+    #include <GLFW/glfw3.h>
+#endif
+
 
 namespace att::RHI
 {
-    bool VulkanRender::Initialize(const WindowHandle &windowHandle, uint32_t width, uint32_t height)
+    // instance version, the device features are capped to it.
+    static constexpr uint32_t ApiVersion = VK_API_VERSION_1_2;
+
+    void VulkanRender::RequireDevice(std::string name, VulkanDeviceSelector::Predicate predicate)
+    {
+        m_deviceRequirements.emplace_back(std::move(name), std::move(predicate));
+    }
+
+    void VulkanRender::SetUseHeadlessSurface(bool useHeadlessSurface)
+    {
+        m_headlessProvider = HeadlessSurfaceProvider(useHeadlessSurface);
+    }
+
+    bool VulkanRender::Initialize(const PlatformInfo::WindowHandle &windowHandle, uint32_t width, uint32_t height)
     {
         if (!CreateInstance(windowHandle)) {
             std::cerr << "Failed to create Vulkan instance." << std::endl;
@@ -35,33 +57,222 @@ namespace att::RHI
             return false;
         }
 
+        if (!CreateFrameResources()) {
+            std::cerr << "Failed to create frame resources." << std::endl;
+            return false;
+        }
+
         // Additional initialization like command buffers, pipelines, etc. would go here.
 
         return true;
     }
 
-    std::vector<const char*> GetRequiredExtensions(std::vector<const char*> &additionalExtensions)
+    void VulkanRender::RenderFrame()
     {
-        std::vector<const char*> result = additionalExtensions;
+        TRACE_SCOPE("RenderFrame");
+        FrameResources& frame = m_frames[m_frameNumber % Config::MaxFramesInFlight];
+
+        {
+            TRACE_SCOPE("WaitForFrameFence");
+            vkWaitForFences(m_device, 1, &frame.inFlight, VK_TRUE, UINT64_MAX);
+        }
+
+        // the fence of this slot covers every frame up to m_frameNumber - MaxFramesInFlight.
+        if (m_frameNumber >= Config::MaxFramesInFlight)
+        {
+            m_deletionQueue.Flush(m_frameNumber - Config::MaxFramesInFlight);
+        }
+        ResolveCapture(frame);
+
+        // minimized: no recreate and no present until a non-zero size comes in, the pending
+        // resize is kept for the restore.
+        if (m_width == 0 || m_height == 0)
+        {
+            return;
+        }
+
+        // no surface (headless without VK_EXT_headless_surface): render into the offscreen ring.
+        const bool offscreen = m_surface == VK_NULL_HANDLE;
+
+        if (m_resizePending || (!offscreen && m_swapchain.NeedsRecreate()))
+        {
+            // the old images are retired with this frame number, nothing waits for the device.
+            m_resizePending = false;
+            if (offscreen)
+            {
+                m_offscreen.Recreate(m_width, m_height, m_frameNumber);
+            }
+            else
+            {
+                m_swapchain.Recreate(m_width, m_height, m_frameNumber);
+            }
+        }
+        if (offscreen ? !m_offscreen.IsValid() : !m_swapchain.IsValid())
+        {
+            // minimized
+            return;
+        }
 
-        
+        uint32_t imageIndex = 0;
+        if (offscreen)
+        {
+            imageIndex = m_offscreen.AcquireNextImage();
+        }
+        else
+        {
+            // keep the CPU at most the policy latency ahead of the display.
+            m_swapchain.WaitForPacing(50'000'000);
+
+            VkResult result = m_swapchain.AcquireNextImage(frame.imageAvailable, imageIndex);
+            if (result == VK_ERROR_OUT_OF_DATE_KHR)
+            {
+                return;
+            }
+            if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+            {
+                std::cerr << "Failed to acquire swapchain image: " << result << std::endl;
+                return;
+            }
+        }
+
+        const bool capture = offscreen && !m_capturePath.empty() && m_offscreen.HasReadback();
+
+        vkResetFences(m_device, 1, &frame.inFlight);
+        vkResetCommandBuffer(frame.commandBuffer, 0);
+        RecordFrame(frame.commandBuffer, imageIndex, capture);
+
+        VkSemaphore presentSemaphore = offscreen ? VK_NULL_HANDLE : m_swapchain.GetPresentSemaphore(imageIndex);
+        VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+        // the offscreen ring has no acquire / present, the frame fences order image reuse.
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = offscreen ? 0 : 1;
+        submitInfo.pWaitSemaphores = &frame.imageAvailable;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &frame.commandBuffer;
+        submitInfo.signalSemaphoreCount = offscreen ? 0 : 1;
+        submitInfo.pSignalSemaphores = &presentSemaphore;
+
+        frame.submitTicks = Common::Tracer::ReadTicks();
+        if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, frame.inFlight) != VK_SUCCESS)
+        {
+            std::cerr << "Failed to submit frame " << m_frameNumber << std::endl;
+            return;
+        }
+
+        if (capture)
+        {
+            // written once this slot's fence is waited on again.
+            frame.capturePath = std::move(m_capturePath);
+            frame.captureImage = static_cast<int32_t>(imageIndex);
+            m_capturePath.clear();
+        }
+
+        if (!offscreen)
+        {
+            m_swapchain.Present(m_presentQueue, imageIndex);
+        }
+        m_frameNumber++;
+
+        TRACE_FRAME_MARK();
+#if _ANTUTU_TRACING_ENABLED
+        Common::Tracer::Get().Collect();
+#endif
+
+        // present to present interval, the first frame has nothing to measure against.
+        const auto now = std::chrono::steady_clock::now();
+        if (m_lastFrameTime.time_since_epoch().count() != 0)
+        {
+            const double frameMs = std::chrono::duration<double, std::milli>(now - m_lastFrameTime).count();
+            STATS_SAMPLE(Common::Stats::FrameTime, frameMs);
+        }
+        m_lastFrameTime = now;
+        Common::JobSystem::Get().ReportUtilization();
+        STATS_END_FRAME();
     }
 
-    void VulkanRender::RenderFrame()
+    void VulkanRender::CaptureNextFrame(const std::string& path)
     {
+        if (m_surface != VK_NULL_HANDLE)
+        {
+            std::cerr << "Frame capture is only available in offscreen rendering." << std::endl;
+            return;
+        }
+        m_capturePath = path;
+    }
+
+    void VulkanRender::ResolveCapture(FrameResources& frame)
+    {
+        if (frame.captureImage < 0)
+        {
+            return;
+        }
+        m_offscreen.WritePng(static_cast<uint32_t>(frame.captureImage), frame.capturePath);
+        frame.captureImage = -1;
+        frame.capturePath.clear();
     }
 
     void VulkanRender::Resize(uint32_t width, uint32_t height)
     {
+        // same size still rebuilds a swapchain left invalid by a zero sized surface.
+        if (width == m_width && height == m_height && (m_surface == VK_NULL_HANDLE || m_swapchain.IsValid()))
+        {
+            return;
+        }
+        m_width = width;
+        m_height = height;
+        // the next RenderFrame recreates through oldSwapchain, a drag resize collapses into one rebuild.
+        m_resizePending = true;
+    }
+
+    void VulkanRender::SetPresentPolicy(PresentPolicy policy)
+    {
+        // only flags a recreate when present mode or image count actually change.
+        m_swapchain.SetPresentPolicy(policy);
     }
 
     void VulkanRender::Cleanup()
     {
+        if (m_device != VK_NULL_HANDLE)
+        {
+            // shutdown is the one place the device is idled.
+            vkDeviceWaitIdle(m_device);
+
+            for (FrameResources& frame : m_frames)
+            {
+                ResolveCapture(frame);
+                vkDestroyFence(m_device, frame.inFlight, nullptr);
+                vkDestroySemaphore(m_device, frame.imageAvailable, nullptr);
+                frame = FrameResources{};
+            }
+            vkDestroyCommandPool(m_device, m_commandPool, nullptr);
+            m_commandPool = VK_NULL_HANDLE;
+
+            m_gpuProfiler.Destroy();
+            m_swapchain.Destroy();
+            m_offscreen.Destroy();
+            m_deletionQueue.FlushAll();
+
+            vkDestroyDevice(m_device, nullptr);
+            m_device = VK_NULL_HANDLE;
+        }
+        if (m_surface != VK_NULL_HANDLE)
+        {
+            vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+            m_surface = VK_NULL_HANDLE;
+        }
+        if (m_instance != VK_NULL_HANDLE)
+        {
+            vkDestroyInstance(m_instance, nullptr);
+            m_instance = VK_NULL_HANDLE;
+        }
     }
 
-    bool VulkanRender::CreateInstance(const WindowHandle& handle)
+    bool VulkanRender::CreateInstance(const PlatformInfo::WindowHandle& handle)
     {
-        if (enableValidationLayers && !CheckValidationLayerSupport()) {
+        if (Config::EnableValidationLayers && !CheckValidationLayerSupport()) {
             std::cerr << "Validation layers requested, but not available!" << std::endl;
             return false;
         }
@@ -72,7 +283,7 @@ namespace att::RHI
         appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
         appInfo.pEngineName = "ANTUTU Engine";
         appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-        appInfo.apiVersion = VK_API_VERSION_1_2;
+        appInfo.apiVersion = ApiVersion;
 
         VkInstanceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -80,23 +291,39 @@ namespace att::RHI
 
         // Get required extensions based on the window system type.
         std::vector<const char*> extensions;
-        // All platforms require the surface extension for creating surfaces.
-        extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+        // All platforms except headless require the surface extension for creating surfaces.
+        if (handle.systemType != PlatformInfo::WindowSystemType::HEADLESS)
+        {
+            extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+        }
 
         // Add platform-specific extensions for surface creation.
         switch (handle.systemType)
         {
-            case WindowSystemType::WINDOWS:
+            case PlatformInfo::WindowSystemType::HEADLESS:
+            {
+                // VK_KHR_surface + VK_EXT_headless_surface when the loader has them, else nothing.
+                for (const char* extension : m_headlessProvider.GetRequiredExtensions()) {
+                    extensions.push_back(extension);
+                }
+                break;
+            }
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+            case PlatformInfo::WindowSystemType::WINDOWS:
             {
                 extensions.push_back("VK_KHR_win32_surface");
                 break;
             }
-            case WindowSystemType::X11:
+#endif
+#if defined(VK_USE_PLATFORM_XLIB_KHR)
+            case PlatformInfo::WindowSystemType::X11:
             {
                 extensions.push_back("VK_KHR_xlib_surface");
                 break;
             }
-            case WindowSystemType::GLFW:
+#endif
+#if !defined(ANTUTU_HEADLESS)
+            case PlatformInfo::WindowSystemType::GLFW:
             {
                 uint32_t glfwExtensionCount = 0;
                 const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
@@ -105,6 +332,7 @@ namespace att::RHI
                 }
                 break;
             }
+#endif
             default:
                 std::cerr << "Unsupported window system type!" << std::endl;
                 return false;
@@ -112,7 +340,7 @@ namespace att::RHI
         // handle extensions and layers as needed, 
         // for now we will just create a basic instance with the required extensions 
         // for surface creation.
-        if (enableValidationLayers) 
+        if (Config::EnableValidationLayers) 
         {
             extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
         }
@@ -120,10 +348,10 @@ namespace att::RHI
         createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
         createInfo.ppEnabledExtensionNames = extensions.data();
 
-        if (enableValidationLayers)
+        if (Config::EnableValidationLayers)
         {
-            createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
-            createInfo.ppEnabledLayerNames = validationLayers.data();
+            createInfo.enabledLayerCount = static_cast<uint32_t>(Config::validationLayers.size());
+            createInfo.ppEnabledLayerNames = Config::validationLayers.data();
         } else {
             createInfo.enabledLayerCount = 0;
         }
@@ -137,12 +365,14 @@ namespace att::RHI
         return true;
     }
 
-    bool VulkanRender::CreateSurface(const WindowHandle &handle)
+    bool VulkanRender::CreateSurface(const PlatformInfo::WindowHandle &handle)
     {
-        VkResult err;
+        VkResult err = VK_ERROR_INITIALIZATION_FAILED;
 
+        // window systems of other platforms, and GLFW in headless builds, aren't compiled in.
         switch (handle.systemType) {
-            case WindowSystemType::WINDOWS: 
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+            case PlatformInfo::WindowSystemType::WINDOWS: 
             {
                 VkWin32SurfaceCreateInfoKHR createInfo{};
                 createInfo.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
@@ -151,16 +381,34 @@ namespace att::RHI
                 err = vkCreateWin32SurfaceKHR(m_instance, &createInfo, nullptr, &m_surface);
                 break;
             }
-            case WindowSystemType::X11:
-                // Create X11 surface, for now we will focus on Windows and GLFW, 
-                // so we can leave this unimplemented.
+#endif
+#if defined(VK_USE_PLATFORM_XLIB_KHR)
+            case PlatformInfo::WindowSystemType::X11:
+            {
+                VkXlibSurfaceCreateInfoKHR createInfo{};
+                createInfo.sType = VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR;
+                createInfo.dpy = static_cast<Display*>(handle.x11.display);
+                createInfo.window = static_cast<Window>(reinterpret_cast<uintptr_t>(handle.x11.window));
+                err = vkCreateXlibSurfaceKHR(m_instance, &createInfo, nullptr, &m_surface);
+                break;
+            }
+#endif
+            case PlatformInfo::WindowSystemType::HEADLESS:
+            {
+                // no surface at all is valid, the renderer then draws offscreen.
+                VkSurfaceKHR* surface = m_headlessProvider.CreateSurface(m_instance);
+                m_surface = surface != nullptr ? *surface : VK_NULL_HANDLE;
+                err = VK_SUCCESS;
                 break;
-            case WindowSystemType::GLFW:
+            }
+#if !defined(ANTUTU_HEADLESS)
+            case PlatformInfo::WindowSystemType::GLFW:
                 err = glfwCreateWindowSurface(m_instance, 
                                                 static_cast<GLFWwindow*>(handle.glfw.window), 
                                                 nullptr, 
                                                 &m_surface);
                 break;
+#endif
             default:
                 return false;
         }
@@ -170,39 +418,26 @@ namespace att::RHI
 
     bool VulkanRender::PickPhysicalDevice()
     {
-        uint32_t deviceCount = 0;
-        vkEnumeratePhysicalDevices(m_instance, &deviceCount, nullptr);
-
-        if (deviceCount == 0)
+        VulkanDeviceSelector selector = VulkanDeviceSelector::CreateDefault(m_surface);
+        for (const auto& [name, predicate] : m_deviceRequirements)
         {
-            std::cerr << "Failed to find GPUs with Vulkan support!" << std::endl;
-            return false;
+            selector.Require(name, predicate);
         }
 
-        std::vector<VkPhysicalDevice> devices(deviceCount);
-        vkEnumeratePhysicalDevices(m_instance, &deviceCount, devices.data());
-        std::multimap<int, VkPhysicalDevice> candidates;
-
-        for (const auto& device : devices)
-        {
-            int score = RateDeviceSuitability(device);
-            candidates.insert({score, device});
-        }
+        DeviceSelection selection;
+        const bool found = selector.Select(m_instance, ApiVersion, selection);
+        std::cout << selector.GetReport();
 
-        if (candidates.rbegin()->first > 0)
-        {
-            m_physicalDevice = candidates.rbegin()->second;
-            VkPhysicalDeviceProperties properties;
-            vkGetPhysicalDeviceProperties(m_physicalDevice, &properties);
-
-            std::cout << "Selected GPU: " << properties.deviceName << " with score "
-                        << candidates.rbegin()->first << std::endl;
-        }
-        else
+        if (!found)
         {
             std::cerr << "Failed to find a suitable GPU!" << std::endl;
             return false;
         }
+
+        m_physicalDevice = selection.device;
+        m_deviceInfo = std::move(selection.info);
+        std::cout << "Selected GPU: " << m_deviceInfo.properties.deviceName << " with score "
+                    << selection.score << std::endl;
         return true;
     }
 
@@ -233,23 +468,29 @@ namespace att::RHI
             queueCreateInfos.push_back(queueCreateInfo);
         }
 
-        VkPhysicalDeviceFeatures deviceFeature{};
+        // optional features are enabled only when the device reports them.
+        std::vector<const char*> requiredExtensions;
+        if (m_surface != VK_NULL_HANDLE)
+        {
+            requiredExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+        m_featureSet.Build(m_deviceInfo, requiredExtensions);
+
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        createInfo.pNext = m_featureSet.GetFeatureChain();
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
-        createInfo.pEnabledFeatures = &deviceFeature;
+        createInfo.pEnabledFeatures = nullptr;
 
-        const std::vector<const char*> deviceExtensions = {
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME
-        };
+        const std::vector<const char*>& deviceExtensions = m_featureSet.GetExtensions();
         createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
         createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
-        if (enableValidationLayers) 
+        if (Config::EnableValidationLayers) 
         {
-            createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
-            createInfo.ppEnabledLayerNames = validationLayers.data();
+            createInfo.enabledLayerCount = static_cast<uint32_t>(Config::validationLayers.size());
+            createInfo.ppEnabledLayerNames = Config::validationLayers.data();
         } else 
         {
             createInfo.enabledLayerCount = 0;
@@ -259,6 +500,25 @@ namespace att::RHI
             std::cerr << "Failed to create logical device!" << std::endl;
             return false;
         }
+        SetDeviceCapabilities(m_featureSet.GetCapabilities());
+        // optional, timings are simply missing when the queue has no timestamps.
+        m_gpuProfiler.Initialize(m_device, m_featureSet.GetCapabilities());
+#if _ANTUTU_TRACING_ENABLED
+        const uint32_t gpuTrack = Common::Tracer::Get().RegisterTrack("GPU");
+        m_gpuProfiler.SetFrameCallback([this, gpuTrack](uint64_t frameNumber, const std::vector<GpuScopeResult>& scopes)
+        {
+            // GPU and CPU clocks aren't correlated, each GPU frame is anchored at its submit.
+            Common::Tracer& tracer = Common::Tracer::Get();
+            const uint64_t submitTicks = m_frames[frameNumber % Config::MaxFramesInFlight].submitTicks;
+            const double ticksPerUs = tracer.GetTicksPerMicrosecond();
+            for (const GpuScopeResult& scope : scopes)
+            {
+                const uint64_t beginTicks = submitTicks + static_cast<uint64_t>(scope.beginMs * 1000.0 * ticksPerUs);
+                tracer.SubmitZone(gpuTrack, scope.name, beginTicks, scope.GetDurationMs() * 1000.0);
+            }
+        });
+#endif
+
         vkGetDeviceQueue(m_device, indices.graphicsFamily.value(), 0, &m_graphicsQueue);
         vkGetDeviceQueue(m_device, indices.presentFamily.value(), 0, &m_presentQueue);
 
@@ -267,84 +527,128 @@ namespace att::RHI
 
     bool VulkanRender::CreateSwapchain(uint32_t width, uint32_t height)
     {
-        SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport(m_physicalDevice);
-        VkSurfaceFormatKHR surfaceFormat = ChooseSwapSurfaceFormat(swapChainSupport.formats);
-        VkPresentModeKHR presentMode = ChooseSwapPresentMode(swapChainSupport.presentModes);
-        VkExtent2D extent = ChooseSwapExtent(swapChainSupport.capabilities, width, height);
+        QueueFamilyIndices indices = FindQueueFamilies(m_physicalDevice);
 
-        uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
+        m_width = width;
+        m_height = height;
 
-        if (swapChainSupport.capabilities.maxImageCount > 0 && 
-            imageCount > swapChainSupport.capabilities.maxImageCount
-        ) {
-            imageCount = swapChainSupport.capabilities.maxImageCount;
+        if (m_surface == VK_NULL_HANDLE)
+        {
+            OffscreenRingDesc desc{};
+            desc.physicalDevice = m_physicalDevice;
+            desc.device = m_device;
+            desc.readback = true;
+            if (!m_offscreen.Initialize(desc, &m_deletionQueue, width, height)) {
+                std::cerr << "Failed to create offscreen targets!" << std::endl;
+                return false;
+            }
+            return true;
         }
 
-        VkSwapchainCreateInfoKHR createInfo{};
-        createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-        createInfo.surface = m_surface;
-        createInfo.minImageCount = imageCount;
-        createInfo.imageFormat = surfaceFormat.format;
-        createInfo.imageColorSpace = surfaceFormat.colorSpace;
-        createInfo.imageExtent = extent;
-        createInfo.imageArrayLayers = 1;
-        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        SwapchainDesc desc{};
+        desc.physicalDevice = m_physicalDevice;
+        desc.device = m_device;
+        desc.surface = m_surface;
+        desc.graphicsFamily = indices.graphicsFamily.value();
+        desc.presentFamily = indices.presentFamily.value();
+        desc.policy = PresentPolicy::Vsync;
+        desc.presentWait = GetDeviceCapabilities().presentWait;
 
-        QueueFamilyIndices indices = FindQueueFamilies(m_physicalDevice);
-        uint32_t queueFamilyIndices[] = {indices.graphicsFamily.value(), indices.presentFamily.value()};
-
-        if (indices.graphicsFamily != indices.presentFamily) {
-            createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
-            createInfo.queueFamilyIndexCount = 2;
-            createInfo.pQueueFamilyIndices = queueFamilyIndices;
-        } else {
-            createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (!m_swapchain.Initialize(desc, &m_deletionQueue, width, height)) {
+            std::cerr << "Failed to create swapchain!" << std::endl;
+            return false;
         }
+        return true;
+    }
 
-        createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
-        createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-        createInfo.presentMode = presentMode;
-        createInfo.clipped = VK_TRUE;
-        createInfo.oldSwapchain = VK_NULL_HANDLE;
+    bool VulkanRender::CreateFrameResources()
+    {
+        QueueFamilyIndices indices = FindQueueFamilies(m_physicalDevice);
 
-        if (vkCreateSwapchainKHR(m_device, &createInfo, nullptr, &m_swapchain) != VK_SUCCESS) {
-            std::cerr << "Failed to create swapchain!" << std::endl;
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = indices.graphicsFamily.value();
+        if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool) != VK_SUCCESS) {
             return false;
         }
 
-        m_swapchainImageFormat = surfaceFormat.format;
-        m_swapchainExtent = extent;
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-        vkGetSwapchainImagesKHR(m_device, m_swapchain, &imageCount, nullptr);
-        m_swapchainImages.resize(imageCount);
-        vkGetSwapchainImagesKHR(m_device, m_swapchain, &imageCount, m_swapchainImages.data());
+        for (FrameResources& frame : m_frames)
+        {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = m_commandPool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount = 1;
+
+            if (vkAllocateCommandBuffers(m_device, &allocInfo, &frame.commandBuffer) != VK_SUCCESS ||
+                vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &frame.imageAvailable) != VK_SUCCESS ||
+                vkCreateFence(m_device, &fenceInfo, nullptr, &frame.inFlight) != VK_SUCCESS) {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        m_swapchainImageViews.resize(m_swapchainImages.size());
+    void VulkanRender::RecordFrame(VkCommandBuffer cmd, uint32_t imageIndex, bool readback)
+    {
+        const bool offscreen = m_surface == VK_NULL_HANDLE;
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(cmd, &beginInfo);
+
+        // this slot's fence was waited on, its timings from MaxFramesInFlight frames ago are ready.
+        m_gpuProfiler.BeginFrame(cmd, m_frameNumber);
+        const uint32_t frameScope = m_gpuProfiler.BeginScope(cmd, "Frame");
+
+        VkImageSubresourceRange range{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = offscreen ? m_offscreen.GetImage(imageIndex) : m_swapchain.GetImage(imageIndex);
+        barrier.subresourceRange = range;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        // render passes are recorded here once pipelines exist, for now the image is cleared.
+        {
+            GpuProfileScope clearScope(m_gpuProfiler, cmd, "Clear", true);
+            VkClearColorValue clearColor{ { 0.02f, 0.02f, 0.03f, 1.0f } };
+            vkCmdClearColorImage(cmd, barrier.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &range);
+        }
 
-        for (size_t i = 0; i < m_swapchainImages.size(); i++) {
-            VkImageViewCreateInfo viewInfo{};
-            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-            viewInfo.image = m_swapchainImages[i];
-            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-            viewInfo.format = m_swapchainImageFormat;
-            viewInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-            viewInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-            viewInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-            viewInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            viewInfo.subresourceRange.baseMipLevel = 0;
-            viewInfo.subresourceRange.levelCount = 1;
-            viewInfo.subresourceRange.baseArrayLayer = 0;
-            viewInfo.subresourceRange.layerCount = 1;
+        // offscreen images end in TRANSFER_SRC so they can be read back.
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = offscreen ? VK_ACCESS_TRANSFER_READ_BIT : 0;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = offscreen ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             offscreen ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
 
-            if (vkCreateImageView(m_device, &viewInfo, nullptr, &m_swapchainImageViews[i]) != VK_SUCCESS) {
-                std::cerr << "Failed to create image view!" << std::endl;
-                return false;
-            }
+        if (readback)
+        {
+            GpuProfileScope readbackScope(m_gpuProfiler, cmd, "Readback");
+            m_offscreen.RecordReadback(cmd, imageIndex);
         }
 
-        return true;
+        m_gpuProfiler.EndScope(cmd, frameScope);
+        vkEndCommandBuffer(cmd);
     }
 
     bool VulkanRender::CheckValidationLayerSupport()
@@ -355,7 +659,7 @@ namespace att::RHI
         std::vector<VkLayerProperties> availableLayers(layerCount);
         vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
 
-        for (const char* layerName : validationLayers) {
+        for (const char* layerName : Config::validationLayers) {
             bool layerFound = false;
 
             for (const auto& layerProperties : availableLayers) {
@@ -374,67 +678,6 @@ namespace att::RHI
     }
 
 
-    // For now we will just return a dummy score, 
-    // in a real implementation we would check for various features and properties 
-    // of the device to determine how suitable it is for our needs.
-
-    /**
-     * TODO: Implement a proper scoring system based on device properties and features,
-     * such as checking for discrete GPU, supported features, queue families, etc.
-     * For example:
-     * VkPhysicalDeviceProperties deviceProperties;
-     * vkGetPhysicalDeviceProperties(device, &deviceProperties);
-     * if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
-     *   score += 1000;
-     * }
-     * 1. Graphics Queue vaf Present Queue support
-     * 2. Device features (e.g. geometry shader, tessellation shader, etc
-     * 3. Swapchain support (formats, present modes, etc.)
-     * 4. present mode support (e.g. VK_PRESENT_MODE_MAILBOX_KHR is better than VK_PRESENT_MODE_FIFO_KHR)
-     * 5. Memory and performance characteristics (e.g. dedicated video memory size)
-     */
-    int VulkanRender::RateDeviceSuitability(VkPhysicalDevice device)
-    {
-        int score = 0;
-        VkPhysicalDeviceProperties deviceProperties;
-        vkGetPhysicalDeviceProperties(device, &deviceProperties);
-
-        VkPhysicalDeviceFeatures deviceFeatures;
-        vkGetPhysicalDeviceFeatures(device, &deviceFeatures);
-
-        switch (deviceProperties.deviceType)
-        {
-            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
-                score += 10000;
-                break;
-            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
-                score += 1000;
-                break;
-            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
-                score += 100;
-                break;
-            case VK_PHYSICAL_DEVICE_TYPE_CPU:
-                score += 100;
-                break;
-            default:
-                break;
-        }
-
-        score += deviceProperties.limits.maxImageDimension2D;
-
-        if (deviceFeatures.geometryShader) 
-        {
-            score += 500;
-        }
-        else 
-        {
-            return 0;
-        }
-
-        return score;
-    }
-
-
     QueueFamilyIndices VulkanRender::FindQueueFamilies(VkPhysicalDevice device)
     {
         QueueFamilyIndices indices;
@@ -451,8 +694,13 @@ namespace att::RHI
                 indices.graphicsFamily = i;
             }
 
+            // offscreen rendering presents nothing, the graphics queue stands in.
             VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+            if (m_surface != VK_NULL_HANDLE) {
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+            } else {
+                presentSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+            }
 
             if (presentSupport) {
                 indices.presentFamily = i;
@@ -468,78 +716,4 @@ namespace att::RHI
         return indices;
     }
 
-    SwapChainSupportDetails VulkanRender::QuerySwapChainSupport(VkPhysicalDevice device)
-    {
-        SwapChainSupportDetails details;
-        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, m_surface, &details.capabilities);
-
-        uint32_t formatCount;
-        vkGetPhysicalDeviceSurfaceFormatsKHR(device, m_surface, &formatCount, nullptr);
-        if (formatCount != 0)
-        {
-            details.formats.resize(formatCount);
-            vkGetPhysicalDeviceSurfaceFormatsKHR(device, m_surface, &formatCount, details.formats.data());
-        }
-
-        uint32_t presentModeCount;
-        vkGetPhysicalDeviceSurfacePresentModesKHR(device, m_surface, &presentModeCount, nullptr);
-        if (presentModeCount != 0)
-        {
-            details.presentModes.resize(presentModeCount);
-            vkGetPhysicalDeviceSurfacePresentModesKHR(device, m_surface, &presentModeCount, details.presentModes.data());
-        }
-
-        return details;
-    }
-
-    VkSurfaceFormatKHR VulkanRender::ChooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
-    {
-        for (const auto& availableFormat : availableFormats)
-        {
-            if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && 
-                availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) 
-            {
-                return availableFormat;
-            }
-        }
-        return availableFormats[0];
-    }
-
-
-    VkPresentModeKHR VulkanRender::ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
-    {
-        for (const auto& availablePresentMode : availablePresentModes)
-        {
-            if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) 
-            {
-                return availablePresentMode;
-            }
-        }
-        return VK_PRESENT_MODE_FIFO_KHR;
-    }
-
-
-    VkExtent2D VulkanRender::ChooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities, uint32_t width, uint32_t height)
-    {
-        if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max())
-        {
-            return capabilities.currentExtent;
-        }
-        else 
-        {
-            VkExtent2D actualExtent = {width, height};
-
-            actualExtent.width = std::clamp(actualExtent.width, 
-                                            capabilities.minImageExtent.width, 
-                                            capabilities.maxImageExtent.width);
-
-            actualExtent.height = std::clamp(actualExtent.height, 
-                                            capabilities.minImageExtent.height, 
-                                            capabilities.maxImageExtent.height);
-
-            return actualExtent;
-        }
-    }
-
-
 };
@@ -0,0 +1,245 @@
+#include <ANTUTU/RHI/VulkanShaderLayout.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <algorithm>
+
+namespace att::RHI
+{
+    // more than any device's maxBoundDescriptorSets, a guard against broken tables.
+    static constexpr uint32_t MaxDescriptorSets = 32;
+
+    // byte size of the formats the ShaderCompiler reflects: 16, 32 and 64-bit UINT, SINT
+    // and SFLOAT vectors.
+    static uint32_t GetVertexFormatSize(uint32_t format)
+    {
+        if (format >= VK_FORMAT_R16_UINT && format <= VK_FORMAT_R16G16B16A16_SFLOAT)
+        {
+            return 2 * ((format - VK_FORMAT_R16_UINT) / 7 + 1);
+        }
+        if (format >= VK_FORMAT_R32_UINT && format <= VK_FORMAT_R32G32B32A32_SFLOAT)
+        {
+            return 4 * ((format - VK_FORMAT_R32_UINT) / 3 + 1);
+        }
+        if (format >= VK_FORMAT_R64_UINT && format <= VK_FORMAT_R64G64B64A64_SFLOAT)
+        {
+            return 8 * ((format - VK_FORMAT_R64_UINT) / 3 + 1);
+        }
+        return 0;
+    }
+
+    VulkanShaderLayout::~VulkanShaderLayout()
+    {
+        Destroy();
+    }
+
+    bool VulkanShaderLayout::Initialize(VkDevice device, const Asset::CookedShaderHeader* const* shaders,
+                                        uint32_t shaderCount, uint32_t runtimeArraySize)
+    {
+        m_device = device;
+
+        struct SetBinding
+        {
+            uint32_t set;
+            VkDescriptorSetLayoutBinding layout;
+            VkDescriptorBindingFlags flags;
+        };
+        std::vector<SetBinding> bindings;
+        uint32_t setCount = 0;
+        uint32_t pushConstantBegin = UINT32_MAX;
+        uint32_t pushConstantEnd = 0;
+
+        for (uint32_t i = 0; i < shaderCount; i++)
+        {
+            const Asset::CookedShaderHeader& shader = *shaders[i];
+            for (uint32_t b = 0; b < shader.bindingCount; b++)
+            {
+                const Asset::CookedShaderBinding& binding = Asset::GetShaderBindings(shader)[b];
+                if (binding.set >= MaxDescriptorSets)
+                {
+                    LOG_ERROR("Shader \"{0}\" uses descriptor set {1}.", shader.entryPoint, binding.set);
+                    Destroy();
+                    return false;
+                }
+                if (binding.count == 0 && runtimeArraySize == 0)
+                {
+                    LOG_ERROR("Shader \"{0}\" set {1} binding {2} is a runtime array without a runtime array size.",
+                              shader.entryPoint, binding.set, binding.binding);
+                    Destroy();
+                    return false;
+                }
+
+                const uint32_t count = binding.count == 0 ? runtimeArraySize : binding.count;
+                const VkDescriptorType type = static_cast<VkDescriptorType>(binding.type);
+                auto it = std::find_if(bindings.begin(), bindings.end(), [&](const SetBinding& existing)
+                {
+                    return existing.set == binding.set && existing.layout.binding == binding.binding;
+                });
+
+                if (it == bindings.end())
+                {
+                    SetBinding added{};
+                    added.set = binding.set;
+                    added.layout.binding = binding.binding;
+                    added.layout.descriptorType = type;
+                    added.layout.descriptorCount = count;
+                    added.layout.stageFlags = shader.stage;
+                    added.flags = binding.count == 0 ? VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT : 0;
+                    bindings.push_back(added);
+                }
+                else if (it->layout.descriptorType != type)
+                {
+                    LOG_ERROR("Set {0} binding {1} has a different descriptor type in {2} shader \"{3}\".",
+                              binding.set, binding.binding, Asset::GetShaderStageName(shader.stage), shader.entryPoint);
+                    Destroy();
+                    return false;
+                }
+                else
+                {
+                    it->layout.stageFlags |= shader.stage;
+                    it->layout.descriptorCount = std::max(it->layout.descriptorCount, count);
+                    it->flags |= binding.count == 0 ? VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT : 0;
+                }
+                setCount = std::max(setCount, binding.set + 1);
+            }
+
+            if (shader.pushConstantSize != 0)
+            {
+                pushConstantBegin = std::min(pushConstantBegin, shader.pushConstantOffset);
+                pushConstantEnd = std::max(pushConstantEnd, shader.pushConstantOffset + shader.pushConstantSize);
+                m_pushConstantStages |= shader.stage;
+            }
+        }
+
+        m_setLayouts.resize(setCount, VK_NULL_HANDLE);
+        std::vector<VkDescriptorSetLayoutBinding> setBindings;
+        std::vector<VkDescriptorBindingFlags> setFlags;
+        for (uint32_t set = 0; set < setCount; set++)
+        {
+            setBindings.clear();
+            setFlags.clear();
+            bool partiallyBound = false;
+            for (const SetBinding& binding : bindings)
+            {
+                if (binding.set == set)
+                {
+                    setBindings.push_back(binding.layout);
+                    setFlags.push_back(binding.flags);
+                    partiallyBound = partiallyBound || binding.flags != 0;
+                }
+            }
+
+            VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+            flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            flagsInfo.bindingCount = static_cast<uint32_t>(setFlags.size());
+            flagsInfo.pBindingFlags = setFlags.data();
+
+            VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+            setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            setLayoutInfo.pNext = partiallyBound ? &flagsInfo : nullptr;
+            setLayoutInfo.bindingCount = static_cast<uint32_t>(setBindings.size());
+            setLayoutInfo.pBindings = setBindings.data();
+            if (vkCreateDescriptorSetLayout(m_device, &setLayoutInfo, nullptr, &m_setLayouts[set]) != VK_SUCCESS)
+            {
+                LOG_ERROR("Failed to create descriptor set layout {0} from shader reflection.", set);
+                Destroy();
+                return false;
+            }
+        }
+
+        // one range over the blocks of every stage: they share the block declaration.
+        VkPushConstantRange pushConstants{};
+        pushConstants.stageFlags = m_pushConstantStages;
+        pushConstants.offset = m_pushConstantStages != 0 ? pushConstantBegin : 0;
+        pushConstants.size = m_pushConstantStages != 0 ? pushConstantEnd - pushConstantBegin : 0;
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = setCount;
+        layoutInfo.pSetLayouts = m_setLayouts.data();
+        layoutInfo.pushConstantRangeCount = m_pushConstantStages != 0 ? 1 : 0;
+        layoutInfo.pPushConstantRanges = &pushConstants;
+        if (vkCreatePipelineLayout(m_device, &layoutInfo, nullptr, &m_pipelineLayout) != VK_SUCCESS)
+        {
+            LOG_ERROR("Failed to create pipeline layout from shader reflection.");
+            Destroy();
+            return false;
+        }
+        return true;
+    }
+
+    void VulkanShaderLayout::Destroy()
+    {
+        if (m_device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        if (m_pipelineLayout != VK_NULL_HANDLE)
+        {
+            vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+            m_pipelineLayout = VK_NULL_HANDLE;
+        }
+        for (VkDescriptorSetLayout setLayout : m_setLayouts)
+        {
+            if (setLayout != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorSetLayout(m_device, setLayout, nullptr);
+            }
+        }
+        m_setLayouts.clear();
+        m_pushConstantStages = 0;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    VkShaderModule CreateShaderModule(VkDevice device, const Asset::CookedShaderHeader& shader)
+    {
+        VkShaderModuleCreateInfo moduleInfo{};
+        moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = shader.codeSize;
+        moduleInfo.pCode = Asset::GetShaderCode(shader);
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        if (vkCreateShaderModule(device, &moduleInfo, nullptr, &module) != VK_SUCCESS)
+        {
+            LOG_ERROR("Failed to create {0} shader module \"{1}\".", Asset::GetShaderStageName(shader.stage), shader.entryPoint);
+            return VK_NULL_HANDLE;
+        }
+        return module;
+    }
+
+    VkPipelineShaderStageCreateInfo GetShaderStageInfo(const Asset::CookedShaderHeader& shader, VkShaderModule module)
+    {
+        VkPipelineShaderStageCreateInfo stageInfo{};
+        stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage = static_cast<VkShaderStageFlagBits>(shader.stage);
+        stageInfo.module = module;
+        stageInfo.pName = shader.entryPoint;
+        return stageInfo;
+    }
+
+    uint32_t GetVertexAttributes(const Asset::CookedShaderHeader& vertexShader, uint32_t binding,
+                                 std::vector<VkVertexInputAttributeDescription>& attributes)
+    {
+        attributes.clear();
+        uint32_t offset = 0;
+        uint32_t strideAlignment = 4;
+        for (uint32_t i = 0; i < vertexShader.vertexInputCount; i++)
+        {
+            const Asset::CookedShaderVertexInput& input = Asset::GetShaderVertexInputs(vertexShader)[i];
+            const uint32_t size = GetVertexFormatSize(input.format);
+            // 64-bit attributes are 8-byte aligned, the rest 4-byte.
+            const uint32_t alignment = input.format >= VK_FORMAT_R64_UINT ? 8 : 4;
+            strideAlignment = std::max(strideAlignment, alignment);
+            offset = (offset + alignment - 1) & ~(alignment - 1);
+
+            VkVertexInputAttributeDescription attribute{};
+            attribute.location = input.location;
+            attribute.binding = binding;
+            attribute.format = static_cast<VkFormat>(input.format);
+            attribute.offset = offset;
+            attributes.push_back(attribute);
+            offset += size;
+        }
+        return (offset + strideAlignment - 1) & ~(strideAlignment - 1);
+    }
+};
@@ -0,0 +1,416 @@
+#include <ANTUTU/RHI/VulkanSwapchain.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <limits>
+#include <algorithm>
+
+namespace att::RHI
+{
+    VulkanSwapchain::~VulkanSwapchain()
+    {
+        Destroy();
+    }
+
+    bool VulkanSwapchain::Initialize(const SwapchainDesc& desc, VulkanDeletionQueue* deletionQueue,
+                                     uint32_t width, uint32_t height)
+    {
+        m_desc = desc;
+        m_deletionQueue = deletionQueue;
+        m_policy = desc.policy;
+
+        if (m_desc.presentWait)
+        {
+            m_waitForPresent = reinterpret_cast<PFN_vkWaitForPresentKHR>(
+                vkGetDeviceProcAddr(m_desc.device, "vkWaitForPresentKHR"));
+            if (m_waitForPresent == nullptr)
+            {
+                LOG_WARN("vkWaitForPresentKHR not found, frame pacing disabled.");
+                m_desc.presentWait = false;
+            }
+        }
+
+        return Create(width, height, VK_NULL_HANDLE);
+    }
+
+    void VulkanSwapchain::Destroy()
+    {
+        if (m_desc.device == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        for (VkSemaphore semaphore : m_presentSemaphores)
+        {
+            vkDestroySemaphore(m_desc.device, semaphore, nullptr);
+        }
+        for (VkImageView view : m_imageViews)
+        {
+            vkDestroyImageView(m_desc.device, view, nullptr);
+        }
+        if (m_swapchain != VK_NULL_HANDLE)
+        {
+            vkDestroySwapchainKHR(m_desc.device, m_swapchain, nullptr);
+        }
+
+        m_presentSemaphores.clear();
+        m_imageViews.clear();
+        m_images.clear();
+        m_swapchain = VK_NULL_HANDLE;
+        m_desc.device = VK_NULL_HANDLE;
+    }
+
+    bool VulkanSwapchain::Recreate(uint32_t width, uint32_t height, uint64_t frameNumber)
+    {
+        m_needsRecreate = false;
+
+        VkSwapchainKHR oldSwapchain = m_swapchain;
+        std::vector<VkImageView> oldViews = std::move(m_imageViews);
+        std::vector<VkSemaphore> oldSemaphores = std::move(m_presentSemaphores);
+        m_imageViews.clear();
+        m_presentSemaphores.clear();
+        m_images.clear();
+        m_swapchain = VK_NULL_HANDLE;
+
+        const bool created = Create(width, height, oldSwapchain);
+        if (oldSwapchain == VK_NULL_HANDLE)
+        {
+            // nothing to retire, e.g. still minimized.
+            return created;
+        }
+
+        // the old swapchain is retired even when creation failed, it may still have
+        // presents in flight from the frames that are not complete yet.
+        VkDevice device = m_desc.device;
+        VulkanDeletionQueue::Deleter deleter = [device, oldSwapchain, oldViews, oldSemaphores]()
+        {
+            for (VkSemaphore semaphore : oldSemaphores)
+            {
+                vkDestroySemaphore(device, semaphore, nullptr);
+            }
+            for (VkImageView view : oldViews)
+            {
+                vkDestroyImageView(device, view, nullptr);
+            }
+            vkDestroySwapchainKHR(device, oldSwapchain, nullptr);
+        };
+
+        if (m_deletionQueue != nullptr)
+        {
+            m_deletionQueue->Push(frameNumber, std::move(deleter));
+        }
+        else
+        {
+            deleter();
+        }
+
+        return created;
+    }
+
+    void VulkanSwapchain::SetPresentPolicy(PresentPolicy policy)
+    {
+        if (policy == m_policy)
+        {
+            return;
+        }
+
+        const SwapChainSupportDetails support = QuerySupport(m_desc.physicalDevice, m_desc.surface);
+        const VkPresentModeKHR mode = ChoosePresentMode(policy, support.presentModes);
+        const bool sameImages = ChooseImageCount(policy, mode, support.capabilities) == GetImageCount();
+
+        m_policy = policy;
+        // pacing alone changes nothing in the swapchain, only recreate for mode / count changes.
+        if (mode != m_presentMode || !sameImages)
+        {
+            m_needsRecreate = true;
+        }
+    }
+
+    void VulkanSwapchain::WaitForPacing(uint64_t timeoutNs)
+    {
+        const uint32_t latency = GetPacingLatency(m_policy);
+        if (!m_desc.presentWait || latency == 0 || m_swapchain == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // the next frame gets m_presentId + 1, allow `latency` frames between it and the display.
+        if (m_presentId + 1 <= latency)
+        {
+            return;
+        }
+        const uint64_t target = m_presentId + 1 - latency;
+
+        VkResult result = m_waitForPresent(m_desc.device, m_swapchain, target, timeoutNs);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        {
+            m_needsRecreate = true;
+        }
+        // VK_TIMEOUT: keep going, a missed pacing target must not stall the frame.
+    }
+
+    VkResult VulkanSwapchain::AcquireNextImage(VkSemaphore imageAvailable, uint32_t& imageIndex)
+    {
+        VkResult result = vkAcquireNextImageKHR(m_desc.device, m_swapchain, UINT64_MAX,
+                                                imageAvailable, VK_NULL_HANDLE, &imageIndex);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        {
+            m_needsRecreate = true;
+        }
+        return result;
+    }
+
+    VkResult VulkanSwapchain::Present(VkQueue queue, uint32_t imageIndex)
+    {
+        VkPresentInfoKHR presentInfo{};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pWaitSemaphores = &m_presentSemaphores[imageIndex];
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &m_swapchain;
+        presentInfo.pImageIndices = &imageIndex;
+
+        const uint64_t presentId = m_presentId + 1;
+        VkPresentIdKHR presentIdInfo{};
+        if (m_desc.presentWait)
+        {
+            presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+            presentIdInfo.swapchainCount = 1;
+            presentIdInfo.pPresentIds = &presentId;
+            presentInfo.pNext = &presentIdInfo;
+        }
+
+        VkResult result = vkQueuePresentKHR(queue, &presentInfo);
+        if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR)
+        {
+            m_presentId = presentId;
+        }
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+        {
+            m_needsRecreate = true;
+        }
+        return result;
+    }
+
+    SwapChainSupportDetails VulkanSwapchain::QuerySupport(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface)
+    {
+        SwapChainSupportDetails details;
+        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface, &details.capabilities);
+
+        uint32_t formatCount = 0;
+        vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr);
+        if (formatCount != 0)
+        {
+            details.formats.resize(formatCount);
+            vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, details.formats.data());
+        }
+
+        uint32_t presentModeCount = 0;
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, nullptr);
+        if (presentModeCount != 0)
+        {
+            details.presentModes.resize(presentModeCount);
+            vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, details.presentModes.data());
+        }
+
+        return details;
+    }
+
+    VkPresentModeKHR VulkanSwapchain::ChoosePresentMode(PresentPolicy policy, const std::vector<VkPresentModeKHR>& availableModes)
+    {
+        auto supports = [&availableModes](VkPresentModeKHR mode)
+        {
+            return std::find(availableModes.begin(), availableModes.end(), mode) != availableModes.end();
+        };
+
+        switch (policy)
+        {
+            case PresentPolicy::LowLatency:
+                if (supports(VK_PRESENT_MODE_MAILBOX_KHR))
+                {
+                    return VK_PRESENT_MODE_MAILBOX_KHR;
+                }
+                break;
+            case PresentPolicy::Uncapped:
+                if (supports(VK_PRESENT_MODE_IMMEDIATE_KHR))
+                {
+                    return VK_PRESENT_MODE_IMMEDIATE_KHR;
+                }
+                if (supports(VK_PRESENT_MODE_MAILBOX_KHR))
+                {
+                    return VK_PRESENT_MODE_MAILBOX_KHR;
+                }
+                break;
+            case PresentPolicy::Vsync:
+            default:
+                break;
+        }
+        // FIFO is the only mode every implementation must support.
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
+    uint32_t VulkanSwapchain::ChooseImageCount(PresentPolicy policy, VkPresentModeKHR mode,
+                                               const VkSurfaceCapabilitiesKHR& capabilities)
+    {
+        uint32_t count = 3;
+        if (mode == VK_PRESENT_MODE_IMMEDIATE_KHR)
+        {
+            count = 2;
+        }
+        else if (mode == VK_PRESENT_MODE_FIFO_KHR && policy == PresentPolicy::LowLatency)
+        {
+            // every extra FIFO image is a frame of latency.
+            count = 2;
+        }
+        // MAILBOX needs a spare image to replace, Vsync FIFO triple buffers to absorb spikes.
+
+        count = std::max(count, capabilities.minImageCount);
+        if (capabilities.maxImageCount > 0)
+        {
+            count = std::min(count, capabilities.maxImageCount);
+        }
+        return count;
+    }
+
+    uint32_t VulkanSwapchain::GetPacingLatency(PresentPolicy policy)
+    {
+        switch (policy)
+        {
+            case PresentPolicy::LowLatency: return 1;
+            case PresentPolicy::Vsync:      return 2;
+            case PresentPolicy::Uncapped:
+            default:                        return 0;
+        }
+    }
+
+    VkSurfaceFormatKHR VulkanSwapchain::ChooseSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
+    {
+        for (const auto& availableFormat : availableFormats)
+        {
+            if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB &&
+                availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+            {
+                return availableFormat;
+            }
+        }
+        return availableFormats[0];
+    }
+
+    VkExtent2D VulkanSwapchain::ChooseExtent(const VkSurfaceCapabilitiesKHR& capabilities, uint32_t width, uint32_t height)
+    {
+        if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max())
+        {
+            return capabilities.currentExtent;
+        }
+
+        VkExtent2D actualExtent = { width, height };
+        actualExtent.width = std::clamp(actualExtent.width,
+                                        capabilities.minImageExtent.width,
+                                        capabilities.maxImageExtent.width);
+        actualExtent.height = std::clamp(actualExtent.height,
+                                         capabilities.minImageExtent.height,
+                                         capabilities.maxImageExtent.height);
+        return actualExtent;
+    }
+
+    bool VulkanSwapchain::Create(uint32_t width, uint32_t height, VkSwapchainKHR oldSwapchain)
+    {
+        const SwapChainSupportDetails support = QuerySupport(m_desc.physicalDevice, m_desc.surface);
+        if (support.formats.empty())
+        {
+            LOG_ERROR("Surface reports no formats.");
+            return false;
+        }
+
+        const VkExtent2D extent = ChooseExtent(support.capabilities, width, height);
+        if (extent.width == 0 || extent.height == 0)
+        {
+            // minimized, the restore's resize recreates it. Not flagged, that would rebuild every frame.
+            m_extent = extent;
+            return true;
+        }
+
+        const VkSurfaceFormatKHR surfaceFormat = ChooseSurfaceFormat(support.formats);
+        const VkPresentModeKHR presentMode = ChoosePresentMode(m_policy, support.presentModes);
+        uint32_t imageCount = ChooseImageCount(m_policy, presentMode, support.capabilities);
+
+        VkSwapchainCreateInfoKHR createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+        createInfo.surface = m_desc.surface;
+        createInfo.minImageCount = imageCount;
+        createInfo.imageFormat = surfaceFormat.format;
+        createInfo.imageColorSpace = surfaceFormat.colorSpace;
+        createInfo.imageExtent = extent;
+        createInfo.imageArrayLayers = 1;
+        createInfo.imageUsage = m_desc.imageUsage & support.capabilities.supportedUsageFlags;
+
+        const uint32_t queueFamilyIndices[] = { m_desc.graphicsFamily, m_desc.presentFamily };
+        if (m_desc.graphicsFamily != m_desc.presentFamily)
+        {
+            createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = 2;
+            createInfo.pQueueFamilyIndices = queueFamilyIndices;
+        }
+        else
+        {
+            createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        }
+
+        createInfo.preTransform = support.capabilities.currentTransform;
+        createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        createInfo.presentMode = presentMode;
+        createInfo.clipped = VK_TRUE;
+        // lets the driver reuse resources and keep presenting the old images meanwhile.
+        createInfo.oldSwapchain = oldSwapchain;
+
+        if (vkCreateSwapchainKHR(m_desc.device, &createInfo, nullptr, &m_swapchain) != VK_SUCCESS)
+        {
+            LOG_ERROR("Failed to create swapchain {0}x{1}.", extent.width, extent.height);
+            m_swapchain = VK_NULL_HANDLE;
+            return false;
+        }
+
+        m_format = surfaceFormat.format;
+        m_extent = extent;
+        m_presentMode = presentMode;
+        m_presentId = 0;
+
+        vkGetSwapchainImagesKHR(m_desc.device, m_swapchain, &imageCount, nullptr);
+        m_images.resize(imageCount);
+        vkGetSwapchainImagesKHR(m_desc.device, m_swapchain, &imageCount, m_images.data());
+
+        m_imageViews.resize(imageCount, VK_NULL_HANDLE);
+        m_presentSemaphores.resize(imageCount, VK_NULL_HANDLE);
+
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        for (uint32_t i = 0; i < imageCount; i++)
+        {
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = m_images[i];
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = m_format;
+            viewInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+            viewInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+            viewInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+            viewInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewInfo.subresourceRange.baseMipLevel = 0;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount = 1;
+
+            if (vkCreateImageView(m_desc.device, &viewInfo, nullptr, &m_imageViews[i]) != VK_SUCCESS ||
+                vkCreateSemaphore(m_desc.device, &semaphoreInfo, nullptr, &m_presentSemaphores[i]) != VK_SUCCESS)
+            {
+                LOG_ERROR("Failed to create swapchain image view / semaphore {0}.", i);
+                return false;
+            }
+        }
+
+        LOG_INFO("Swapchain {0}x{1}, {2} images, present mode {3}.",
+                 m_extent.width, m_extent.height, imageCount, static_cast<int>(m_presentMode));
+        return true;
+    }
+};
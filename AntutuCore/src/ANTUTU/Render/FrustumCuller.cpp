@@ -0,0 +1,501 @@
+#include <ANTUTU/Render/FrustumCuller.hpp>
+#include <Common/Job/JobSystem.h>
+#include <Common/Profiler/Tracer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+
+namespace att::Render
+{
+    static constexpr uint32_t NoLeaf = UINT32_MAX;
+    // leaf tasks handed to one job.
+    static constexpr uint32_t TasksPerJob = 8;
+
+    static float SurfaceArea(const glm::vec3& min, const glm::vec3& max)
+    {
+        if (min.x > max.x)
+        {
+            return 0.0f;
+        }
+        const glm::vec3 size = max - min;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Objects
+    ////////////////////////////////////////////////////////////////////////////
+
+    CullHandle FrustumCuller::Add(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+    {
+        CullHandle handle;
+        if (!m_freeHandles.empty())
+        {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<CullHandle>(m_handleSlot.size());
+            m_handleSlot.push_back(UINT32_MAX);
+        }
+
+        const uint32_t slot = AllocateSlot();
+        m_slotHandle[slot] = handle;
+        m_handleSlot[handle] = slot;
+        WriteSlot(slot, boundsMin, boundsMax);
+        m_liveCount++;
+        return handle;
+    }
+
+    void FrustumCuller::Remove(CullHandle handle)
+    {
+        assert(handle < m_handleSlot.size() && m_handleSlot[handle] != UINT32_MAX);
+        const uint32_t slot = m_handleSlot[handle];
+        ParkSlot(slot);
+        m_slotHandle[slot] = InvalidCullHandle;
+        m_handleSlot[handle] = UINT32_MAX;
+        // a tree slot stays parked: reusing it for an object somewhere else would
+        // stretch its leaf across the scene.
+        if (slot >= m_treeSlots)
+        {
+            m_freeSlots.push_back(slot);
+        }
+        else
+        {
+            m_deadTreeSlots++;
+        }
+        m_freeHandles.push_back(handle);
+        m_liveCount--;
+    }
+
+    void FrustumCuller::SetBounds(CullHandle handle, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+    {
+        assert(handle < m_handleSlot.size() && m_handleSlot[handle] != UINT32_MAX);
+        WriteSlot(m_handleSlot[handle], boundsMin, boundsMax);
+    }
+
+    uint32_t FrustumCuller::AllocateSlot()
+    {
+        if (!m_freeSlots.empty())
+        {
+            const uint32_t slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            return slot;
+        }
+
+        // appended to the tail, tested linearly until the next rebuild.
+        const uint32_t slot = static_cast<uint32_t>(m_slotHandle.size());
+        m_centerX.push_back(0.0f);
+        m_centerY.push_back(0.0f);
+        m_centerZ.push_back(0.0f);
+        m_extentX.push_back(-FLT_MAX);
+        m_extentY.push_back(-FLT_MAX);
+        m_extentZ.push_back(-FLT_MAX);
+        m_slotHandle.push_back(InvalidCullHandle);
+        m_slotLeaf.push_back(NoLeaf);
+        return slot;
+    }
+
+    void FrustumCuller::WriteSlot(uint32_t slot, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+    {
+        const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        const glm::vec3 extent = (boundsMax - boundsMin) * 0.5f;
+        m_centerX[slot] = center.x;
+        m_centerY[slot] = center.y;
+        m_centerZ[slot] = center.z;
+        m_extentX[slot] = extent.x;
+        m_extentY[slot] = extent.y;
+        m_extentZ[slot] = extent.z;
+
+        const uint32_t leaf = m_slotLeaf[slot];
+        if (leaf != NoLeaf && !m_leafDirty[leaf])
+        {
+            m_leafDirty[leaf] = 1;
+            m_dirtyLeaves.push_back(leaf);
+        }
+    }
+
+    void FrustumCuller::ParkSlot(uint32_t slot)
+    {
+        // fails every plane test, the leaf shrinks on the next Refit.
+        WriteSlot(slot, glm::vec3(0.0f), glm::vec3(0.0f));
+        m_extentX[slot] = -FLT_MAX;
+        m_extentY[slot] = -FLT_MAX;
+        m_extentZ[slot] = -FLT_MAX;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Tree
+    ////////////////////////////////////////////////////////////////////////////
+
+    void FrustumCuller::RefitLeaf(Node& leaf) const
+    {
+        glm::vec3 min(FLT_MAX);
+        glm::vec3 max(-FLT_MAX);
+        for (uint32_t slot = leaf.first; slot < leaf.first + leaf.count; slot++)
+        {
+            if (m_slotHandle[slot] == InvalidCullHandle)
+            {
+                continue;
+            }
+            const glm::vec3 center(m_centerX[slot], m_centerY[slot], m_centerZ[slot]);
+            const glm::vec3 extent(m_extentX[slot], m_extentY[slot], m_extentZ[slot]);
+            min = glm::min(min, center - extent);
+            max = glm::max(max, center + extent);
+        }
+        leaf.min = min;
+        leaf.max = max;
+    }
+
+    void FrustumCuller::RefitInterior()
+    {
+        // children always follow their parent.
+        for (size_t i = m_nodes.size(); i-- > 0;)
+        {
+            Node& node = m_nodes[i];
+            if (node.count == 0)
+            {
+                const Node& left = m_nodes[node.first];
+                const Node& right = m_nodes[node.first + 1];
+                node.min = glm::min(left.min, right.min);
+                node.max = glm::max(left.max, right.max);
+            }
+        }
+    }
+
+    float FrustumCuller::GetLeafArea() const
+    {
+        float area = 0.0f;
+        for (const Node& node : m_nodes)
+        {
+            if (node.count != 0)
+            {
+                area += SurfaceArea(node.min, node.max);
+            }
+        }
+        return area;
+    }
+
+    void FrustumCuller::Refit()
+    {
+        TRACE_FUNCTION();
+
+        const uint32_t tailCount = static_cast<uint32_t>(m_slotHandle.size()) - m_treeSlots;
+        const float tailLimit = std::max(static_cast<float>(LeafSize), static_cast<float>(m_liveCount) * TailRebuildRatio);
+        if (static_cast<float>(tailCount + m_deadTreeSlots) > tailLimit)
+        {
+            Rebuild();
+            return;
+        }
+
+        if (m_dirtyLeaves.empty())
+        {
+            return;
+        }
+        for (uint32_t leaf : m_dirtyLeaves)
+        {
+            RefitLeaf(m_nodes[leaf]);
+            m_leafDirty[leaf] = 0;
+        }
+        m_dirtyLeaves.clear();
+        RefitInterior();
+
+        // objects drifted away from their build neighbours, leaves overlap more and more.
+        if (GetLeafArea() > m_builtLeafArea * RefitRebuildRatio)
+        {
+            Rebuild();
+        }
+    }
+
+    void FrustumCuller::BuildNode(uint32_t node, uint32_t first, uint32_t count,
+        std::vector<uint32_t>& order, const std::vector<glm::vec3>& centers)
+    {
+        if (count <= LeafSize)
+        {
+            m_nodes[node].first = first;
+            m_nodes[node].count = count;
+            return;
+        }
+
+        glm::vec3 min(FLT_MAX);
+        glm::vec3 max(-FLT_MAX);
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            min = glm::min(min, centers[order[i]]);
+            max = glm::max(max, centers[order[i]]);
+        }
+        const glm::vec3 size = max - min;
+        const int axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+
+        // split on whole leaves so only the last leaf of the tree can be partial.
+        const uint32_t leaves = (count + LeafSize - 1) / LeafSize;
+        const uint32_t leftCount = (leaves / 2) * LeafSize;
+        std::nth_element(order.begin() + first, order.begin() + first + leftCount, order.begin() + first + count,
+            [&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+
+        const uint32_t child = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back({});
+        m_nodes.push_back({});
+        m_nodes[node].first = child;
+        m_nodes[node].count = 0;
+        BuildNode(child, first, leftCount, order, centers);
+        BuildNode(child + 1, first + leftCount, count - leftCount, order, centers);
+    }
+
+    void FrustumCuller::Rebuild()
+    {
+        TRACE_FUNCTION();
+
+        // live objects only, freed slots are dropped here.
+        std::vector<uint32_t> live;
+        live.reserve(m_liveCount);
+        std::vector<glm::vec3> centers;
+        centers.reserve(m_liveCount);
+        for (uint32_t slot = 0; slot < m_slotHandle.size(); slot++)
+        {
+            if (m_slotHandle[slot] != InvalidCullHandle)
+            {
+                live.push_back(slot);
+                centers.emplace_back(m_centerX[slot], m_centerY[slot], m_centerZ[slot]);
+            }
+        }
+
+        const uint32_t count = static_cast<uint32_t>(live.size());
+        std::vector<uint32_t> order(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            order[i] = i;
+        }
+
+        m_nodes.clear();
+        if (count > 0)
+        {
+            m_nodes.reserve(2 * ((count + LeafSize - 1) / LeafSize));
+            m_nodes.push_back({});
+            BuildNode(0, 0, count, order, centers);
+        }
+
+        // leaves own consecutive slots in build order.
+        auto permute = [&](std::vector<float>& values)
+        {
+            std::vector<float> sorted(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                sorted[i] = values[live[order[i]]];
+            }
+            values = std::move(sorted);
+        };
+        permute(m_centerX);
+        permute(m_centerY);
+        permute(m_centerZ);
+        permute(m_extentX);
+        permute(m_extentY);
+        permute(m_extentZ);
+
+        std::vector<CullHandle> handles(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            handles[i] = m_slotHandle[live[order[i]]];
+            m_handleSlot[handles[i]] = i;
+        }
+        m_slotHandle = std::move(handles);
+
+        m_slotLeaf.assign(count, NoLeaf);
+        for (uint32_t n = 0; n < m_nodes.size(); n++)
+        {
+            Node& node = m_nodes[n];
+            if (node.count != 0)
+            {
+                std::fill(m_slotLeaf.begin() + node.first, m_slotLeaf.begin() + node.first + node.count, n);
+                RefitLeaf(node);
+            }
+        }
+        RefitInterior();
+
+        m_treeSlots = count;
+        m_freeSlots.clear();
+        m_deadTreeSlots = 0;
+        m_dirtyLeaves.clear();
+        m_leafDirty.assign(m_nodes.size(), 0);
+        m_builtLeafArea = GetLeafArea();
+        m_stats.rebuilds++;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Culling
+    ////////////////////////////////////////////////////////////////////////////
+
+    void FrustumCuller::CollectLeaves(uint32_t view, const Math::FrustumPlanes& frustum, std::vector<LeafTask>& tasks) const
+    {
+        tasks.clear();
+
+        struct Entry
+        {
+            uint32_t node;
+            // planes the node still straddles.
+            uint32_t planeMask;
+        };
+        Entry stack[64];
+        uint32_t top = 0;
+        if (!m_nodes.empty())
+        {
+            stack[top++] = { 0, 0x3F };
+        }
+
+        while (top > 0)
+        {
+            const Entry entry = stack[--top];
+            const Node& node = m_nodes[entry.node];
+            if (node.min.x > node.max.x)
+            {
+                continue;
+            }
+
+            const glm::vec3 center = (node.min + node.max) * 0.5f;
+            const glm::vec3 extent = (node.max - node.min) * 0.5f;
+            uint32_t planeMask = entry.planeMask;
+            bool outside = false;
+            for (uint32_t p = 0; p < 6 && !outside; p++)
+            {
+                if ((planeMask & (1u << p)) == 0)
+                {
+                    continue;
+                }
+                const glm::vec4& plane = frustum.planes[p];
+                const float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+                const float radius = glm::dot(glm::abs(glm::vec3(plane)), extent);
+                outside = distance + radius < 0.0f;
+                if (distance - radius >= 0.0f)
+                {
+                    planeMask &= ~(1u << p);
+                }
+            }
+            if (outside)
+            {
+                continue;
+            }
+
+            if (node.count != 0)
+            {
+                tasks.push_back({ view, node.first, node.count, planeMask == 0, 0 });
+            }
+            else
+            {
+                stack[top++] = { node.first, planeMask };
+                stack[top++] = { node.first + 1, planeMask };
+            }
+        }
+
+        // the tail in leaf sized pieces so it spreads over the jobs as well.
+        const uint32_t slotCount = static_cast<uint32_t>(m_slotHandle.size());
+        for (uint32_t first = m_treeSlots; first < slotCount; first += LeafSize)
+        {
+            tasks.push_back({ view, first, std::min(LeafSize, slotCount - first), false, 0 });
+        }
+    }
+
+    void FrustumCuller::Cull(const Math::FrustumPlanes* views, uint32_t viewCount, std::vector<CullHandle>* visible)
+    {
+        TRACE_FUNCTION();
+        Common::JobSystem& jobs = Common::JobSystem::Get();
+
+        // 1. tree traversal, one job per view.
+        m_viewTasks.resize(viewCount);
+        jobs.ParallelFor(viewCount, 1, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t v = begin; v < end; v++)
+            {
+                CollectLeaves(v, views[v], m_viewTasks[v]);
+            }
+        });
+
+        m_tasks.clear();
+        m_viewTaskStart.assign(viewCount + 1, 0);
+        uint32_t outputSize = 0;
+        m_stats.leavesTested = 0;
+        m_stats.leavesInside = 0;
+        for (uint32_t v = 0; v < viewCount; v++)
+        {
+            m_viewTaskStart[v] = static_cast<uint32_t>(m_tasks.size());
+            for (LeafTask task : m_viewTasks[v])
+            {
+                task.output = outputSize;
+                outputSize += task.count;
+                (task.inside ? m_stats.leavesInside : m_stats.leavesTested)++;
+                m_tasks.push_back(task);
+            }
+        }
+        m_viewTaskStart[viewCount] = static_cast<uint32_t>(m_tasks.size());
+        m_scratch.resize(outputSize);
+        m_taskVisible.resize(m_tasks.size());
+
+        // 2. leaves of every view in one pool, straddling ones through the batch kernel.
+        const Math::BatchKernelTable& kernels = Math::GetBatchKernels();
+        jobs.ParallelFor(static_cast<uint32_t>(m_tasks.size()), TasksPerJob, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t t = begin; t < end; t++)
+            {
+                const LeafTask& task = m_tasks[t];
+                uint32_t* out = m_scratch.data() + task.output;
+                if (task.inside)
+                {
+                    for (uint32_t i = 0; i < task.count; i++)
+                    {
+                        out[i] = task.first + i;
+                    }
+                    m_taskVisible[t] = task.count;
+                    continue;
+                }
+
+                const uint32_t f = task.first;
+                const Math::SoABoxes boxes = {
+                    { m_centerX.data() + f, m_centerY.data() + f, m_centerZ.data() + f },
+                    { m_extentX.data() + f, m_extentY.data() + f, m_extentZ.data() + f } };
+                const uint32_t count = kernels.cullBoxes(&views[task.view].planes[0].x, boxes, task.count, out);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    out[i] += f;
+                }
+                m_taskVisible[t] = count;
+            }
+        });
+
+        // 3. slots to handles, freed slots inside fully visible leaves are dropped here.
+        jobs.ParallelFor(viewCount, 1, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t v = begin; v < end; v++)
+            {
+                uint32_t capacity = 0;
+                for (uint32_t t = m_viewTaskStart[v]; t < m_viewTaskStart[v + 1]; t++)
+                {
+                    capacity += m_taskVisible[t];
+                }
+
+                std::vector<CullHandle>& result = visible[v];
+                result.resize(capacity);
+                uint32_t written = 0;
+                for (uint32_t t = m_viewTaskStart[v]; t < m_viewTaskStart[v + 1]; t++)
+                {
+                    const uint32_t* slots = m_scratch.data() + m_tasks[t].output;
+                    for (uint32_t i = 0; i < m_taskVisible[t]; i++)
+                    {
+                        const CullHandle handle = m_slotHandle[slots[i]];
+                        result[written] = handle;
+                        written += handle != InvalidCullHandle;
+                    }
+                }
+                result.resize(written);
+            }
+        });
+
+        m_stats.objectCount = m_liveCount;
+        m_stats.nodeCount = static_cast<uint32_t>(m_nodes.size());
+        m_stats.tailCount = static_cast<uint32_t>(m_slotHandle.size()) - m_treeSlots;
+        m_stats.visibleCount = 0;
+        for (uint32_t v = 0; v < viewCount; v++)
+        {
+            m_stats.visibleCount += static_cast<uint32_t>(visible[v].size());
+        }
+    }
+}
@@ -0,0 +1,268 @@
+#include <ANTUTU/Render/GpuCullingReference.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace att::Render
+{
+    static uint32_t PreviousPow2(uint32_t v)
+    {
+        uint32_t result = 1;
+        while (result * 2 <= v)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// HiZPyramid
+    ////////////////////////////////////////////////////////////////////////////
+    void HiZPyramid::Build(const float* depth, uint32_t width, uint32_t height)
+    {
+        m_mips.clear();
+        if (depth == nullptr || width == 0 || height == 0)
+        {
+            m_width = m_height = 0;
+            return;
+        }
+
+        m_width = PreviousPow2(width);
+        m_height = PreviousPow2(height);
+
+        // mip 0: farthest depth of the source footprint of every texel, a plain
+        // copy when the source already is a power of two.
+        std::vector<float> mip0(static_cast<size_t>(m_width) * m_height);
+        if (m_width == width && m_height == height)
+        {
+            std::copy(depth, depth + mip0.size(), mip0.begin());
+        }
+        else
+        {
+            for (uint32_t y = 0; y < m_height; y++)
+            {
+                const uint32_t sy0 = y * height / m_height;
+                const uint32_t sy1 = std::max((y + 1) * height / m_height, sy0 + 1);
+                for (uint32_t x = 0; x < m_width; x++)
+                {
+                    const uint32_t sx0 = x * width / m_width;
+                    const uint32_t sx1 = std::max((x + 1) * width / m_width, sx0 + 1);
+
+                    float maxDepth = 0.0f;
+                    for (uint32_t sy = sy0; sy < sy1; sy++)
+                    {
+                        for (uint32_t sx = sx0; sx < sx1; sx++)
+                        {
+                            maxDepth = std::max(maxDepth, depth[static_cast<size_t>(sy) * width + sx]);
+                        }
+                    }
+                    mip0[static_cast<size_t>(y) * m_width + x] = maxDepth;
+                }
+            }
+        }
+        m_mips.push_back(std::move(mip0));
+
+        // following mips: 2x2 max reduction. Sizes are powers of two, so only a
+        // dimension that is already 1 needs its second tap clamped.
+        uint32_t w = m_width;
+        uint32_t h = m_height;
+        while (w > 1 || h > 1)
+        {
+            const uint32_t nw = std::max(w / 2, 1u);
+            const uint32_t nh = std::max(h / 2, 1u);
+            const uint32_t stepX = w > 1 ? 1 : 0;
+            const size_t stepY = h > 1 ? w : 0;
+
+            const float* src = m_mips.back().data();
+            std::vector<float> next(static_cast<size_t>(nw) * nh);
+            for (uint32_t y = 0; y < nh; y++)
+            {
+                const float* row = src + static_cast<size_t>(y) * 2 * stepY;
+                for (uint32_t x = 0; x < nw; x++)
+                {
+                    const float* texel = row + x * 2 * stepX;
+                    next[static_cast<size_t>(y) * nw + x] = std::max(std::max(texel[0], texel[stepX]),
+                                                                     std::max(texel[stepY], texel[stepY + stepX]));
+                }
+            }
+            m_mips.push_back(std::move(next));
+            w = nw;
+            h = nh;
+        }
+    }
+
+    uint32_t HiZPyramid::GetWidth(uint32_t mip) const
+    {
+        return std::max(m_width >> mip, 1u);
+    }
+
+    uint32_t HiZPyramid::GetHeight(uint32_t mip) const
+    {
+        return std::max(m_height >> mip, 1u);
+    }
+
+    float HiZPyramid::Fetch(uint32_t mip, int32_t x, int32_t y) const
+    {
+        const int32_t w = static_cast<int32_t>(GetWidth(mip));
+        const int32_t h = static_cast<int32_t>(GetHeight(mip));
+        x = std::clamp(x, 0, w - 1);
+        y = std::clamp(y, 0, h - 1);
+        return m_mips[mip][static_cast<size_t>(y) * w + x];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// GpuCullingReference
+    ////////////////////////////////////////////////////////////////////////////
+    uint32_t GpuCullingReference::Cull(const GpuCullingParams& params,
+                                       const GpuInstanceData* instances,
+                                       const GpuMeshData* meshes,
+                                       const HiZPyramid* hiz,
+                                       std::vector<GpuDrawCommand>& outCommands,
+                                       GpuCullingStats* stats)
+    {
+        GpuCullingStats localStats;
+        outCommands.clear();
+        outCommands.reserve(params.instanceCount);
+
+        const bool useOcclusion = params.enableOcclusion != 0 && hiz != nullptr && hiz->GetMipCount() > 0;
+
+        for (uint32_t i = 0; i < params.instanceCount; i++)
+        {
+            const GpuInstanceData& instance = instances[i];
+            const GpuMeshData& mesh = meshes[instance.meshId];
+
+            const glm::vec3 center = glm::vec3(instance.model * glm::vec4(glm::vec3(mesh.boundingSphere), 1.0f));
+            const float scale = std::max(glm::length(glm::vec3(instance.model[0])),
+                                std::max(glm::length(glm::vec3(instance.model[1])),
+                                         glm::length(glm::vec3(instance.model[2]))));
+            const float radius = mesh.boundingSphere.w * scale;
+
+            bool visible = IsSphereInFrustum(params.frustumPlanes, center, radius);
+            if (!visible)
+            {
+                localStats.frustumCulled++;
+            }
+            else if (useOcclusion)
+            {
+                const glm::vec3 viewCenter = glm::vec3(params.view * glm::vec4(center, 1.0f));
+                if (IsSphereOccluded(params, *hiz, viewCenter, radius))
+                {
+                    visible = false;
+                    localStats.occlusionCulled++;
+                }
+            }
+
+            if (visible)
+            {
+                localStats.visibleCount++;
+            }
+
+            if (visible || params.compactOutput == 0)
+            {
+                GpuDrawCommand command{};
+                command.indexCount = mesh.indexCount;
+                command.instanceCount = visible ? 1u : 0u;
+                command.firstIndex = mesh.firstIndex;
+                command.vertexOffset = mesh.vertexOffset;
+                command.firstInstance = i;
+                outCommands.push_back(command);
+            }
+        }
+
+        if (stats != nullptr)
+        {
+            *stats = localStats;
+        }
+        return static_cast<uint32_t>(outCommands.size());
+    }
+
+    bool GpuCullingReference::IsSphereInFrustum(const glm::vec4 planes[6], const glm::vec3& center, float radius)
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            if (glm::dot(glm::vec3(planes[i]), center) + planes[i].w < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool GpuCullingReference::IsSphereOccluded(const GpuCullingParams& params, const HiZPyramid& hiz,
+                                               const glm::vec3& viewCenter, float radius)
+    {
+        glm::vec4 rect;
+        if (!ProjectSphere(viewCenter, radius, params.nearPlane,
+                           params.projection[0][0], params.projection[1][1], rect))
+        {
+            // crossing the near plane, can't be tested conservatively.
+            return false;
+        }
+
+        const float width = (rect.z - rect.x) * params.hizSize.x;
+        const float height = (rect.w - rect.y) * params.hizSize.y;
+        const float extent = std::max(std::max(width, height), 1.0f);
+
+        // pick the mip where the rect covers at most 2x2 texels.
+        uint32_t level = static_cast<uint32_t>(std::ceil(std::log2(extent)));
+        level = std::min(level, hiz.GetMipCount() - 1);
+
+        const float mipWidth = static_cast<float>(hiz.GetWidth(level));
+        const float mipHeight = static_cast<float>(hiz.GetHeight(level));
+        const int32_t x0 = static_cast<int32_t>(std::floor(rect.x * mipWidth));
+        const int32_t y0 = static_cast<int32_t>(std::floor(rect.y * mipHeight));
+        const int32_t x1 = static_cast<int32_t>(std::floor(rect.z * mipWidth));
+        const int32_t y1 = static_cast<int32_t>(std::floor(rect.w * mipHeight));
+
+        float occluderDepth = 0.0f;
+        for (int32_t y = y0; y <= y1; y++)
+        {
+            for (int32_t x = x0; x <= x1; x++)
+            {
+                occluderDepth = std::max(occluderDepth, hiz.Fetch(level, x, y));
+            }
+        }
+
+        // depth of the point of the sphere closest to the camera.
+        const glm::vec4 nearest = params.projection * glm::vec4(0.0f, 0.0f, viewCenter.z + radius, 1.0f);
+        const float sphereDepth = nearest.z / nearest.w;
+
+        return sphereDepth > occluderDepth;
+    }
+
+    // 2D Polyhedral Bounds of a Clipped, Perspective-Projected 3D Sphere. Mara & McGuire, 2013.
+    bool GpuCullingReference::ProjectSphere(const glm::vec3& viewCenter, float radius, float nearPlane,
+                                            float p00, float p11, glm::vec4& outUvRect)
+    {
+        // distance in front of the camera, the camera looks down -Z.
+        const float depth = -viewCenter.z;
+        if (depth < radius + nearPlane)
+        {
+            return false;
+        }
+
+        const float r2 = radius * radius;
+
+        const glm::vec2 cx(viewCenter.x, depth);
+        const glm::vec2 vx(std::sqrt(glm::dot(cx, cx) - r2), radius);
+        const glm::vec2 minX = glm::mat2(vx.x, vx.y, -vx.y, vx.x) * cx;
+        const glm::vec2 maxX = glm::mat2(vx.x, -vx.y, vx.y, vx.x) * cx;
+
+        const glm::vec2 cy(viewCenter.y, depth);
+        const glm::vec2 vy(std::sqrt(glm::dot(cy, cy) - r2), radius);
+        const glm::vec2 minY = glm::mat2(vy.x, vy.y, -vy.y, vy.x) * cy;
+        const glm::vec2 maxY = glm::mat2(vy.x, -vy.y, vy.y, vy.x) * cy;
+
+        // ndc, p11 is negative when the projection flips Y for Vulkan.
+        const float ndcX0 = minX.x / minX.y * p00;
+        const float ndcX1 = maxX.x / maxX.y * p00;
+        const float ndcY0 = minY.x / minY.y * p11;
+        const float ndcY1 = maxY.x / maxY.y * p11;
+
+        outUvRect = glm::vec4(std::min(ndcX0, ndcX1), std::min(ndcY0, ndcY1),
+                              std::max(ndcX0, ndcX1), std::max(ndcY0, ndcY1));
+        outUvRect = outUvRect * 0.5f + 0.5f;
+        outUvRect = glm::clamp(outUvRect, glm::vec4(0.0f), glm::vec4(1.0f));
+        return true;
+    }
+}
@@ -0,0 +1,656 @@
+#include <ANTUTU/Render/MeshOptimizer.hpp>
+#include <Common/Profiler/Tracer.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace att::Render
+{
+    static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    static glm::vec3 LoadPosition(const float* positions, size_t stride, uint32_t index)
+    {
+        const float* p = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + stride * index);
+        return glm::vec3(p[0], p[1], p[2]);
+    }
+
+    // vertex -> triangles (CSR), the counts stay separate so live lists can shrink.
+    static void BuildAdjacency(const uint32_t* indices, size_t triangleCount, size_t vertexCount,
+                               std::vector<uint32_t>& offsets, std::vector<uint32_t>& counts, std::vector<uint32_t>& triangles)
+    {
+        counts.assign(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            counts[indices[i]]++;
+        }
+        offsets.assign(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            offsets[v + 1] = offsets[v] + counts[v];
+        }
+        triangles.resize(triangleCount * 3);
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                triangles[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Vertex cache (Forsyth, "Linear-Speed Vertex Cache Optimisation")
+    ////////////////////////////////////////////////////////////////////////////
+
+    static constexpr uint32_t ForsythCacheSize = 32;
+    static constexpr uint32_t ForsythMaxValence = 64;
+
+    struct ForsythScores
+    {
+        float cache[ForsythCacheSize];
+        float valence[ForsythMaxValence];
+
+        ForsythScores()
+        {
+            for (uint32_t i = 0; i < ForsythCacheSize; i++)
+            {
+                // the last triangle's vertices get a fixed score so the next one doesn't
+                // just reuse its edge: strips thrash the cache on the way back.
+                cache[i] = i < 3 ? 0.75f : std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(ForsythCacheSize - 3), 1.5f);
+            }
+            valence[0] = 0.0f;
+            for (uint32_t i = 1; i < ForsythMaxValence; i++)
+            {
+                // vertices with few triangles left are finished first.
+                valence[i] = 2.0f / std::sqrt(static_cast<float>(i));
+            }
+        }
+
+        float Get(int32_t cachePosition, uint32_t liveTriangles) const
+        {
+            if (liveTriangles == 0)
+            {
+                return -1.0f;
+            }
+            return (cachePosition >= 0 ? cache[cachePosition] : 0.0f) + valence[std::min(liveTriangles, ForsythMaxValence - 1)];
+        }
+    };
+
+    void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount)
+    {
+        TRACE_FUNCTION();
+        static const ForsythScores scores;
+
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        std::vector<uint32_t> offsets, live, adjacency;
+        BuildAdjacency(indices, triangleCount, vertexCount, offsets, live, adjacency);
+
+        std::vector<int32_t> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            vertexScore[v] = scores.Get(-1, live[v]);
+        }
+        std::vector<float> triangleScore(triangleCount);
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        }
+
+        std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32_t> cache, nextCache;
+        cache.reserve(ForsythCacheSize + 3);
+        nextCache.reserve(ForsythCacheSize + 3);
+
+        uint32_t best = static_cast<uint32_t>(std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+        size_t cursor = 0;
+        for (size_t output = 0; output < triangleCount; output++)
+        {
+            const uint32_t* triangle = &source[best * 3];
+            std::copy(triangle, triangle + 3, indices + output * 3);
+            emitted[best] = true;
+
+            nextCache.assign(triangle, triangle + 3);
+            for (int k = 0; k < 3; k++)
+            {
+                const uint32_t v = triangle[k];
+                uint32_t* first = &adjacency[offsets[v]];
+                uint32_t* last = first + live[v];
+                *std::find(first, last, best) = *(last - 1);
+                live[v]--;
+            }
+            for (uint32_t v : cache)
+            {
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                {
+                    nextCache.push_back(v);
+                }
+            }
+
+            // rescore what is (or just fell out of) the cache and pick the next triangle among theirs.
+            best = InvalidIndex;
+            float bestScore = -1.0f;
+            for (size_t i = 0; i < nextCache.size(); i++)
+            {
+                const uint32_t v = nextCache[i];
+                const int32_t position = i < ForsythCacheSize ? static_cast<int32_t>(i) : -1;
+                cachePosition[v] = position;
+                const float score = scores.Get(position, live[v]);
+                const float delta = score - vertexScore[v];
+                vertexScore[v] = score;
+                for (uint32_t j = offsets[v]; j < offsets[v] + live[v]; j++)
+                {
+                    const uint32_t t = adjacency[j];
+                    triangleScore[t] += delta;
+                    if (triangleScore[t] > bestScore)
+                    {
+                        bestScore = triangleScore[t];
+                        best = t;
+                    }
+                }
+            }
+            if (nextCache.size() > ForsythCacheSize)
+            {
+                nextCache.resize(ForsythCacheSize);
+            }
+            cache.swap(nextCache);
+
+            if (best == InvalidIndex)
+            {
+                // nothing left around the cache: continue with the next untouched triangle.
+                while (cursor < triangleCount && emitted[cursor])
+                {
+                    cursor++;
+                }
+                best = static_cast<uint32_t>(cursor);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Overdraw (Sander, Nehab, Barczak, "Fast Triangle Reordering for Vertex
+    /// Locality and Reduced Overdraw")
+    ////////////////////////////////////////////////////////////////////////////
+
+    // FIFO cache through timestamps: a vertex is cached while fewer than cacheSize misses
+    // happened since it was loaded.
+    struct FifoCache
+    {
+        std::vector<uint32_t> timestamps;
+        uint32_t timestamp;
+        uint32_t size;
+
+        FifoCache(size_t vertexCount, uint32_t cacheSize)
+            : timestamps(vertexCount, 0), timestamp(cacheSize + 1), size(cacheSize)
+        {
+        }
+
+        uint32_t Misses(const uint32_t* triangle)
+        {
+            uint32_t misses = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                if (timestamp - timestamps[triangle[k]] > size)
+                {
+                    timestamps[triangle[k]] = timestamp++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+
+        void Flush() { timestamp += size + 1; }
+    };
+
+    void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+                                         const float* positions, size_t vertexCount, size_t positionStride,
+                                         float threshold)
+    {
+        TRACE_FUNCTION();
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2)
+        {
+            return;
+        }
+
+        // hard boundaries: where the cache order starts over (three misses in a row).
+        std::vector<uint32_t> hardClusters;
+        {
+            FifoCache cache(vertexCount, 16);
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                if (cache.Misses(&indices[t * 3]) == 3)
+                {
+                    hardClusters.push_back(static_cast<uint32_t>(t));
+                }
+            }
+        }
+        hardClusters.push_back(static_cast<uint32_t>(triangleCount));
+
+        // soft boundaries: cut a hard cluster as soon as its running ACMR is within the
+        // threshold of the whole cluster's, every cut starts with a cold cache.
+        std::vector<uint32_t> clusters;
+        FifoCache cache(vertexCount, 16);
+        for (size_t c = 0; c + 1 < hardClusters.size(); c++)
+        {
+            const uint32_t begin = hardClusters[c];
+            const uint32_t end = hardClusters[c + 1];
+
+            cache.Flush();
+            uint32_t clusterMisses = 0;
+            for (uint32_t t = begin; t < end; t++)
+            {
+                clusterMisses += cache.Misses(&indices[t * 3]);
+            }
+            const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+            cache.Flush();
+            uint32_t start = begin;
+            uint32_t misses = 0;
+            for (uint32_t t = begin; t < end; t++)
+            {
+                misses += cache.Misses(&indices[t * 3]);
+                if (static_cast<float>(misses) / static_cast<float>(t - start + 1) <= clusterThreshold)
+                {
+                    clusters.push_back(start);
+                    start = t + 1;
+                    misses = 0;
+                    cache.Flush();
+                }
+            }
+            if (start < end)
+            {
+                clusters.push_back(start);
+            }
+        }
+        clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+        // outward facing clusters far from the center first: they tend to occlude the rest.
+        glm::dvec3 meshCenter(0.0);
+        double meshArea = 0.0;
+        std::vector<glm::vec3> clusterCenters(clusters.size() - 1);
+        std::vector<glm::vec3> clusterNormals(clusters.size() - 1);
+        for (size_t c = 0; c + 1 < clusters.size(); c++)
+        {
+            glm::dvec3 center(0.0);
+            glm::dvec3 normal(0.0);
+            double area = 0.0;
+            for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++)
+            {
+                const glm::vec3 a = LoadPosition(positions, positionStride, indices[t * 3]);
+                const glm::vec3 b = LoadPosition(positions, positionStride, indices[t * 3 + 1]);
+                const glm::vec3 d = LoadPosition(positions, positionStride, indices[t * 3 + 2]);
+                const glm::dvec3 cross = glm::cross(glm::dvec3(b - a), glm::dvec3(d - a));
+                const double triangleArea = glm::length(cross);
+                center += glm::dvec3(a + b + d) * (triangleArea / 3.0);
+                normal += cross;
+                area += triangleArea;
+            }
+            meshCenter += center;
+            meshArea += area;
+            clusterCenters[c] = area > 0.0 ? glm::vec3(center / area) : LoadPosition(positions, positionStride, indices[clusters[c] * 3]);
+            const double length = glm::length(normal);
+            clusterNormals[c] = length > 0.0 ? glm::vec3(normal / length) : glm::vec3(0.0f);
+        }
+        if (meshArea > 0.0)
+        {
+            meshCenter /= meshArea;
+        }
+
+        std::vector<float> keys(clusters.size() - 1);
+        for (size_t c = 0; c < keys.size(); c++)
+        {
+            keys[c] = glm::dot(clusterCenters[c] - glm::vec3(meshCenter), clusterNormals[c]);
+        }
+        std::vector<uint32_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] > keys[b]; });
+
+        std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+        uint32_t* output = indices;
+        for (uint32_t c : order)
+        {
+            output = std::copy(source.begin() + clusters[c] * 3, source.begin() + clusters[c + 1] * 3, output);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Vertex fetch
+    ////////////////////////////////////////////////////////////////////////////
+
+    std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                                             size_t* outVertexCount)
+    {
+        std::vector<uint32_t> remap(vertexCount, InvalidIndex);
+        uint32_t next = 0;
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            uint32_t& index = indices[i];
+            if (remap[index] == InvalidIndex)
+            {
+                remap[index] = next++;
+            }
+            index = remap[index];
+        }
+        if (outVertexCount != nullptr)
+        {
+            *outVertexCount = next;
+        }
+        return remap;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Simplification (Garland, Heckbert, "Surface Simplification Using Quadric
+    /// Error Metrics"), collapses restricted to existing vertices
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct Quadric
+    {
+        // symmetric 4x4: a00 a01 a02 a11 a12 a22, b = a03 a13 a23, c = a33.
+        double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double weight = 0;
+
+        void AddPlane(const glm::dvec3& n, double d, double w)
+        {
+            a00 += w * n.x * n.x; a01 += w * n.x * n.y; a02 += w * n.x * n.z;
+            a11 += w * n.y * n.y; a12 += w * n.y * n.z; a22 += w * n.z * n.z;
+            b0 += w * n.x * d; b1 += w * n.y * d; b2 += w * n.z * d;
+            c += w * d * d;
+            weight += w;
+        }
+
+        void Add(const Quadric& q)
+        {
+            a00 += q.a00; a01 += q.a01; a02 += q.a02; a11 += q.a11; a12 += q.a12; a22 += q.a22;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2; c += q.c;
+            weight += q.weight;
+        }
+
+        // squared distance to the planes, averaged over their areas.
+        double Evaluate(const glm::dvec3& p) const
+        {
+            const double result = a00 * p.x * p.x + 2.0 * a01 * p.x * p.y + 2.0 * a02 * p.x * p.z
+                                + a11 * p.y * p.y + 2.0 * a12 * p.y * p.z + a22 * p.z * p.z
+                                + 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+            return weight > 0.0 ? std::max(result, 0.0) / weight : 0.0;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    float MeshOptimizer::GetMeshExtent(const float* positions, size_t vertexCount, size_t positionStride)
+    {
+        glm::vec3 minimum(std::numeric_limits<float>::max());
+        glm::vec3 maximum(-std::numeric_limits<float>::max());
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            const glm::vec3 p = LoadPosition(positions, positionStride, static_cast<uint32_t>(v));
+            minimum = glm::min(minimum, p);
+            maximum = glm::max(maximum, p);
+        }
+        const glm::vec3 size = maximum - minimum;
+        return vertexCount > 0 ? std::max(size.x, std::max(size.y, size.z)) : 0.0f;
+    }
+
+    size_t MeshOptimizer::Simplify(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                                   const float* positions, size_t vertexCount, size_t positionStride,
+                                   size_t targetIndexCount, float targetError, float* outError)
+    {
+        TRACE_FUNCTION();
+        std::vector<uint32_t> result(indices, indices + indexCount - indexCount % 3);
+        float reachedError = 0.0f;
+
+        // positions relative to the extent, so the errors are too.
+        const float extent = GetMeshExtent(positions, vertexCount, positionStride);
+        const double scale = extent > 0.0f ? 1.0 / extent : 1.0;
+        std::vector<glm::dvec3> points(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            points[v] = glm::dvec3(LoadPosition(positions, positionStride, static_cast<uint32_t>(v))) * scale;
+        }
+
+        // vertices sharing a position (attribute seams) are one point of the surface.
+        std::vector<uint32_t> welded(vertexCount);
+        std::vector<uint32_t> wedges(vertexCount, 0);
+        {
+            struct PositionHash
+            {
+                size_t operator()(const glm::vec3& p) const
+                {
+                    const uint32_t* bits = reinterpret_cast<const uint32_t*>(&p);
+                    return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+                }
+            };
+            std::unordered_map<glm::vec3, uint32_t, PositionHash> firsts;
+            std::vector<bool> referenced(vertexCount, false);
+            for (uint32_t index : result)
+            {
+                referenced[index] = true;
+            }
+            for (size_t v = 0; v < vertexCount; v++)
+            {
+                const glm::vec3 p = LoadPosition(positions, positionStride, static_cast<uint32_t>(v));
+                welded[v] = firsts.emplace(p, static_cast<uint32_t>(v)).first->second;
+                wedges[welded[v]] += referenced[v] ? 1 : 0;
+            }
+        }
+
+        // the source normal of every triangle left, a LOD triangle must keep facing its way:
+        // checking each collapse against the previous shape alone lets a triangle turn over
+        // across passes.
+        std::vector<Quadric> quadrics(vertexCount);
+        std::vector<glm::dvec3> normals(result.size() / 3, glm::dvec3(0.0));
+        for (size_t t = 0; t < result.size() / 3; t++)
+        {
+            const glm::dvec3& a = points[result[t * 3]];
+            const glm::dvec3 cross = glm::cross(points[result[t * 3 + 1]] - a, points[result[t * 3 + 2]] - a);
+            const double length = glm::length(cross);
+            if (length > 0.0)
+            {
+                const glm::dvec3 normal = cross / length;
+                normals[t] = normal;
+                Quadric plane;
+                plane.AddPlane(normal, -glm::dot(normal, a), length * 0.5);
+                for (int k = 0; k < 3; k++)
+                {
+                    quadrics[welded[result[t * 3 + k]]].Add(plane);
+                }
+            }
+        }
+
+        const double maxCost = static_cast<double>(targetError) * targetError;
+        std::vector<uint32_t> offsets, counts, adjacency;
+        std::vector<uint8_t> locked(vertexCount);
+        std::vector<bool> touched(vertexCount);
+        std::vector<uint32_t> remap(vertexCount);
+        std::unordered_map<uint64_t, uint32_t> edgeUses;
+        std::vector<Collapse> collapses;
+
+        while (result.size() > targetIndexCount)
+        {
+            const size_t triangleCount = result.size() / 3;
+            BuildAdjacency(result.data(), triangleCount, vertexCount, offsets, counts, adjacency);
+
+            // a vertex moves only if it is the sole vertex at its position and every edge
+            // around it has exactly two triangles: borders and non-manifold spots stay.
+            edgeUses.clear();
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    const uint64_t a = welded[result[t * 3 + k]];
+                    const uint64_t b = welded[result[t * 3 + (k + 1) % 3]];
+                    edgeUses[a < b ? (a << 32 | b) : (b << 32 | a)]++;
+                }
+            }
+            for (size_t v = 0; v < vertexCount; v++)
+            {
+                locked[v] = wedges[welded[v]] > 1 ? 1 : 0;
+            }
+            for (const auto& [edge, uses] : edgeUses)
+            {
+                if (uses != 2)
+                {
+                    // locks the welded ids, every wedge below maps to them.
+                    locked[edge >> 32] = 1;
+                    locked[edge & 0xffffffffu] = 1;
+                }
+            }
+
+            collapses.clear();
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    const uint32_t from = result[t * 3 + k];
+                    const uint32_t to = result[t * 3 + (k + 1) % 3];
+                    if (locked[from] || locked[welded[from]] || welded[from] == welded[to])
+                    {
+                        continue;
+                    }
+                    Quadric quadric = quadrics[welded[from]];
+                    quadric.Add(quadrics[welded[to]]);
+                    collapses.push_back({ from, to, quadric.Evaluate(points[to]) });
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+            // independent collapses, cheapest first, until the target is reached.
+            std::iota(remap.begin(), remap.end(), 0u);
+            std::fill(touched.begin(), touched.end(), false);
+            size_t removed = 0;
+            const size_t toRemove = (result.size() - targetIndexCount + 2) / 3;
+            for (const Collapse& collapse : collapses)
+            {
+                if (removed >= toRemove || collapse.cost > maxCost)
+                {
+                    break;
+                }
+                if (touched[collapse.from] || touched[collapse.to])
+                {
+                    continue;
+                }
+
+                // the triangles around from, moved onto to, must not flip or fold.
+                bool valid = true;
+                uint32_t shared = 0;
+                for (uint32_t j = offsets[collapse.from]; j < offsets[collapse.from] + counts[collapse.from] && valid; j++)
+                {
+                    const uint32_t* triangle = &result[adjacency[j] * 3];
+                    if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                    {
+                        shared++;
+                        continue;
+                    }
+                    glm::dvec3 corners[3];
+                    for (int k = 0; k < 3; k++)
+                    {
+                        corners[k] = points[triangle[k]];
+                    }
+                    const glm::dvec3 before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                    for (int k = 0; k < 3; k++)
+                    {
+                        corners[k] = triangle[k] == collapse.from ? points[collapse.to] : corners[k];
+                    }
+                    const glm::dvec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                    valid = glm::dot(before, after) > 0.25 * glm::length(before) * glm::length(after) &&
+                            glm::dot(normals[adjacency[j]], after) >= 0.0;
+                }
+                if (!valid || shared == 0)
+                {
+                    continue;
+                }
+
+                for (uint32_t j = offsets[collapse.from]; j < offsets[collapse.from] + counts[collapse.from]; j++)
+                {
+                    const uint32_t* triangle = &result[adjacency[j] * 3];
+                    for (int k = 0; k < 3; k++)
+                    {
+                        touched[triangle[k]] = true;
+                    }
+                }
+                remap[collapse.from] = collapse.to;
+                quadrics[welded[collapse.to]].Add(quadrics[welded[collapse.from]]);
+                reachedError = std::max(reachedError, static_cast<float>(std::sqrt(collapse.cost)));
+                removed += shared;
+            }
+            if (removed == 0)
+            {
+                break;
+            }
+
+            size_t write = 0;
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                const uint32_t a = remap[result[t * 3]];
+                const uint32_t b = remap[result[t * 3 + 1]];
+                const uint32_t c = remap[result[t * 3 + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    normals[write / 3] = normals[t];
+                    result[write++] = a;
+                    result[write++] = b;
+                    result[write++] = c;
+                }
+            }
+            result.resize(write);
+            normals.resize(write / 3);
+        }
+
+        std::copy(result.begin(), result.end(), destination);
+        if (outError != nullptr)
+        {
+            *outError = reachedError;
+        }
+        return result.size();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Analysis
+    ////////////////////////////////////////////////////////////////////////////
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, size_t indexCount,
+                                                            size_t vertexCount, uint32_t cacheSize)
+    {
+        VertexCacheStatistics statistics;
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0)
+        {
+            return statistics;
+        }
+
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<bool> referenced(vertexCount, false);
+        size_t uniqueVertices = 0;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            statistics.invocations += cache.Misses(&indices[t * 3]);
+            for (int k = 0; k < 3; k++)
+            {
+                uniqueVertices += referenced[indices[t * 3 + k]] ? 0 : 1;
+                referenced[indices[t * 3 + k]] = true;
+            }
+        }
+        statistics.acmr = static_cast<float>(statistics.invocations) / static_cast<float>(triangleCount);
+        statistics.atvr = static_cast<float>(statistics.invocations) / static_cast<float>(uniqueVertices);
+        return statistics;
+    }
+}
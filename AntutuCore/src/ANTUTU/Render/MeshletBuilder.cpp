@@ -0,0 +1,449 @@
+#include <ANTUTU/Render/MeshletBuilder.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace att::Render
+{
+    static constexpr uint32_t MeshletBlobMagic = 0x4C48534D; // "MSHL"
+    static constexpr uint32_t MeshletBlobVersion = 1;
+    static constexpr uint8_t InvalidSlot = 0xff;
+
+    static glm::vec3 LoadPosition(const float* positions, size_t stride, uint32_t index)
+    {
+        const float* p = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + stride * index);
+        return glm::vec3(p[0], p[1], p[2]);
+    }
+
+    MeshletData MeshletBuilder::Build(const uint32_t* indices, size_t indexCount,
+                                      const float* positions, size_t vertexCount, size_t positionStride,
+                                      uint32_t maxVertices, uint32_t maxTriangles)
+    {
+        MeshletData data;
+        maxVertices = std::clamp(maxVertices, 3u, MeshletMaxVertices);
+        maxTriangles = std::clamp(maxTriangles, 1u, MeshletMaxTriangles);
+
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0 || vertexCount == 0)
+        {
+            return data;
+        }
+
+        // vertex -> triangles adjacency (CSR).
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            adjacencyOffsets[indices[i] + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+                }
+            }
+        }
+
+        // triangles not emitted yet around each vertex. Finishing vertices with few live
+        // triangles first keeps meshlets compact instead of growing long strips.
+        std::vector<uint32_t> liveTriangles(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            liveTriangles[v] = adjacencyOffsets[v + 1] - adjacencyOffsets[v];
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint8_t> slots(vertexCount, InvalidSlot);
+        std::vector<uint32_t> meshletVertices;
+        std::vector<uint8_t> meshletTriangles;
+        meshletVertices.reserve(maxVertices);
+        meshletTriangles.reserve(maxTriangles * 3);
+        size_t seed = 0;
+
+        auto newVertexCount = [&](size_t t)
+        {
+            uint32_t count = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                count += slots[indices[t * 3 + k]] == InvalidSlot ? 1 : 0;
+            }
+            return count;
+        };
+
+        auto liveScore = [&](size_t t)
+        {
+            return liveTriangles[indices[t * 3 + 0]] +
+                   liveTriangles[indices[t * 3 + 1]] +
+                   liveTriangles[indices[t * 3 + 2]];
+        };
+
+        auto flush = [&]()
+        {
+            if (meshletTriangles.empty())
+            {
+                return;
+            }
+
+            Meshlet meshlet{};
+            meshlet.vertexOffset = static_cast<uint32_t>(data.vertices.size());
+            meshlet.triangleOffset = static_cast<uint32_t>(data.triangles.size());
+            meshlet.vertexCount = static_cast<uint32_t>(meshletVertices.size());
+            meshlet.triangleCount = static_cast<uint32_t>(meshletTriangles.size() / 3);
+
+            data.vertices.insert(data.vertices.end(), meshletVertices.begin(), meshletVertices.end());
+            data.triangles.insert(data.triangles.end(), meshletTriangles.begin(), meshletTriangles.end());
+            // keep every meshlet 4 byte aligned so shaders can read the triangles as uints.
+            data.triangles.resize((data.triangles.size() + 3) & ~size_t(3), 0);
+
+            data.meshlets.push_back(meshlet);
+
+            for (uint32_t v : meshletVertices)
+            {
+                slots[v] = InvalidSlot;
+            }
+            meshletVertices.clear();
+            meshletTriangles.clear();
+        };
+
+        for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+        {
+            // prefer the triangle adding the fewest new vertices to the current meshlet.
+            size_t best = triangleCount;
+            uint32_t bestExtra = 4;
+            uint32_t bestLive = 0;
+            for (uint32_t v : meshletVertices)
+            {
+                for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; a++)
+                {
+                    const uint32_t t = adjacency[a];
+                    if (emitted[t])
+                    {
+                        continue;
+                    }
+                    const uint32_t extra = newVertexCount(t);
+                    const uint32_t live = liveScore(t);
+                    if (extra < bestExtra || (extra == bestExtra && (live < bestLive || (live == bestLive && t < best))))
+                    {
+                        best = t;
+                        bestExtra = extra;
+                        bestLive = live;
+                    }
+                }
+            }
+
+            // nothing connected left: continue with the next triangle in index order.
+            if (best == triangleCount)
+            {
+                while (emitted[seed])
+                {
+                    seed++;
+                }
+                best = seed;
+                bestExtra = newVertexCount(best);
+            }
+
+            if (meshletVertices.size() + bestExtra > maxVertices ||
+                meshletTriangles.size() / 3 + 1 > maxTriangles)
+            {
+                flush();
+            }
+
+            for (int k = 0; k < 3; k++)
+            {
+                const uint32_t v = indices[best * 3 + k];
+                if (slots[v] == InvalidSlot)
+                {
+                    slots[v] = static_cast<uint8_t>(meshletVertices.size());
+                    meshletVertices.push_back(v);
+                }
+                meshletTriangles.push_back(slots[v]);
+                liveTriangles[v]--;
+            }
+            emitted[best] = true;
+        }
+        flush();
+
+        data.bounds.reserve(data.meshlets.size());
+        for (const Meshlet& meshlet : data.meshlets)
+        {
+            data.bounds.push_back(ComputeBounds(data, meshlet, positions, positionStride));
+        }
+        return data;
+    }
+
+    std::vector<uint32_t> MeshletBuilder::OptimizeVertexLocality(MeshletData& data, size_t vertexCount)
+    {
+        std::vector<uint32_t> remap(vertexCount, std::numeric_limits<uint32_t>::max());
+        uint32_t next = 0;
+
+        for (uint32_t& v : data.vertices)
+        {
+            if (remap[v] == std::numeric_limits<uint32_t>::max())
+            {
+                remap[v] = next++;
+            }
+            v = remap[v];
+        }
+
+        // vertices no meshlet references go to the end.
+        for (uint32_t& r : remap)
+        {
+            if (r == std::numeric_limits<uint32_t>::max())
+            {
+                r = next++;
+            }
+        }
+        return remap;
+    }
+
+    std::vector<uint32_t> MeshletBuilder::ExpandIndices(const MeshletData& data)
+    {
+        std::vector<uint32_t> result;
+        for (const Meshlet& meshlet : data.meshlets)
+        {
+            for (uint32_t i = 0; i < meshlet.triangleCount * 3; i++)
+            {
+                const uint8_t local = data.triangles[meshlet.triangleOffset + i];
+                result.push_back(data.vertices[meshlet.vertexOffset + local]);
+            }
+        }
+        return result;
+    }
+
+    bool MeshletBuilder::IsMeshletCulled(const MeshletBounds& bounds, const glm::vec4 frustumPlanes[6],
+                                         const glm::vec3& cameraPosition)
+    {
+        const glm::vec3 center = glm::vec3(bounds.sphere);
+        for (int i = 0; i < 6; i++)
+        {
+            if (glm::dot(glm::vec3(frustumPlanes[i]), center) + frustumPlanes[i].w < -bounds.sphere.w)
+            {
+                return true;
+            }
+        }
+
+        const glm::vec3 toApex = glm::vec3(bounds.coneApex) - cameraPosition;
+        const float distance = glm::length(toApex);
+        if (distance <= 0.0f)
+        {
+            return false;
+        }
+        return glm::dot(toApex / distance, glm::vec3(bounds.coneAxis)) >= bounds.coneAxis.w;
+    }
+
+    MeshletBounds MeshletBuilder::ComputeBounds(const MeshletData& data, const Meshlet& meshlet,
+                                                const float* positions, size_t positionStride)
+    {
+        MeshletBounds bounds{};
+        const uint32_t* vertices = data.vertices.data() + meshlet.vertexOffset;
+
+        // Ritter's bounding sphere.
+        glm::vec3 first = LoadPosition(positions, positionStride, vertices[0]);
+        glm::vec3 farthest = first;
+        float maxDistance = 0.0f;
+        for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+        {
+            const glm::vec3 p = LoadPosition(positions, positionStride, vertices[i]);
+            const float d = glm::dot(p - first, p - first);
+            if (d > maxDistance)
+            {
+                maxDistance = d;
+                farthest = p;
+            }
+        }
+        glm::vec3 opposite = farthest;
+        maxDistance = 0.0f;
+        for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+        {
+            const glm::vec3 p = LoadPosition(positions, positionStride, vertices[i]);
+            const float d = glm::dot(p - farthest, p - farthest);
+            if (d > maxDistance)
+            {
+                maxDistance = d;
+                opposite = p;
+            }
+        }
+
+        glm::vec3 center = (farthest + opposite) * 0.5f;
+        float radius = std::sqrt(maxDistance) * 0.5f;
+        for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+        {
+            const glm::vec3 p = LoadPosition(positions, positionStride, vertices[i]);
+            const float d = glm::length(p - center);
+            if (d > radius)
+            {
+                const float newRadius = (radius + d) * 0.5f;
+                center += (p - center) * ((newRadius - radius) / d);
+                radius = newRadius;
+            }
+        }
+        bounds.sphere = glm::vec4(center, radius);
+
+        // normal cone.
+        const uint8_t* triangles = data.triangles.data() + meshlet.triangleOffset;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec3> corners;
+        normals.reserve(meshlet.triangleCount);
+        corners.reserve(meshlet.triangleCount);
+
+        glm::vec3 axis(0.0f);
+        for (uint32_t t = 0; t < meshlet.triangleCount; t++)
+        {
+            const glm::vec3 p0 = LoadPosition(positions, positionStride, vertices[triangles[t * 3 + 0]]);
+            const glm::vec3 p1 = LoadPosition(positions, positionStride, vertices[triangles[t * 3 + 1]]);
+            const glm::vec3 p2 = LoadPosition(positions, positionStride, vertices[triangles[t * 3 + 2]]);
+
+            const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(n);
+            if (area <= 0.0f)
+            {
+                continue;
+            }
+            normals.push_back(n / area);
+            corners.push_back(p0);
+            axis += n / area;
+        }
+
+        // cutoff > 1 never culls.
+        bounds.coneApex = glm::vec4(center, 0.0f);
+        bounds.coneAxis = glm::vec4(0.0f, 0.0f, 1.0f, 2.0f);
+
+        const float axisLength = glm::length(axis);
+        if (normals.empty() || axisLength <= 0.0f)
+        {
+            return bounds;
+        }
+        axis /= axisLength;
+
+        float minDot = 1.0f;
+        for (const glm::vec3& n : normals)
+        {
+            minDot = std::min(minDot, glm::dot(axis, n));
+        }
+        // cone wider than ~84 degrees half angle, not worth testing.
+        if (minDot <= 0.1f)
+        {
+            bounds.coneAxis = glm::vec4(axis, 2.0f);
+            return bounds;
+        }
+
+        // move the apex back so the cone contains every triangle plane.
+        float maxT = 0.0f;
+        for (size_t i = 0; i < normals.size(); i++)
+        {
+            const float dc = glm::dot(center - corners[i], normals[i]);
+            const float dn = glm::dot(axis, normals[i]);
+            maxT = std::max(maxT, dc / dn);
+        }
+
+        bounds.coneApex = glm::vec4(center - axis * maxT, 0.0f);
+        bounds.coneAxis = glm::vec4(axis, std::sqrt(1.0f - minDot * minDot));
+        return bounds;
+    }
+
+    template<typename T>
+    static void AppendArray(std::vector<uint8_t>& blob, const std::vector<T>& array)
+    {
+        const uint32_t count = static_cast<uint32_t>(array.size());
+        const size_t offset = blob.size();
+        blob.resize(offset + sizeof(count) + sizeof(T) * array.size());
+        std::memcpy(blob.data() + offset, &count, sizeof(count));
+        if (!array.empty())
+        {
+            std::memcpy(blob.data() + offset + sizeof(count), array.data(), sizeof(T) * array.size());
+        }
+    }
+
+    template<typename T>
+    static bool ReadArray(const uint8_t*& cursor, const uint8_t* end, std::vector<T>& array)
+    {
+        uint32_t count = 0;
+        if (static_cast<size_t>(end - cursor) < sizeof(count))
+        {
+            return false;
+        }
+        std::memcpy(&count, cursor, sizeof(count));
+        cursor += sizeof(count);
+
+        if (static_cast<size_t>(end - cursor) < sizeof(T) * count)
+        {
+            return false;
+        }
+        array.resize(count);
+        if (count > 0)
+        {
+            std::memcpy(array.data(), cursor, sizeof(T) * count);
+        }
+        cursor += sizeof(T) * count;
+        return true;
+    }
+
+    void MeshletBuilder::Serialize(const MeshletData& data, std::vector<uint8_t>& outBlob)
+    {
+        outBlob.clear();
+        const uint32_t header[2] = { MeshletBlobMagic, MeshletBlobVersion };
+        outBlob.resize(sizeof(header));
+        std::memcpy(outBlob.data(), header, sizeof(header));
+
+        AppendArray(outBlob, data.meshlets);
+        AppendArray(outBlob, data.bounds);
+        AppendArray(outBlob, data.vertices);
+        AppendArray(outBlob, data.triangles);
+    }
+
+    bool MeshletBuilder::Deserialize(const uint8_t* blob, size_t size, MeshletData& outData)
+    {
+        uint32_t header[2] = {};
+        if (blob == nullptr || size < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(header, blob, sizeof(header));
+        if (header[0] != MeshletBlobMagic || header[1] != MeshletBlobVersion)
+        {
+            return false;
+        }
+
+        const uint8_t* cursor = blob + sizeof(header);
+        const uint8_t* end = blob + size;
+        if (!ReadArray(cursor, end, outData.meshlets) ||
+            !ReadArray(cursor, end, outData.bounds) ||
+            !ReadArray(cursor, end, outData.vertices) ||
+            !ReadArray(cursor, end, outData.triangles) ||
+            outData.bounds.size() != outData.meshlets.size())
+        {
+            return false;
+        }
+
+        // the shaders index with these unchecked.
+        for (const Meshlet& meshlet : outData.meshlets)
+        {
+            if (meshlet.vertexCount == 0 || meshlet.vertexCount > MeshletMaxVertices ||
+                meshlet.triangleCount == 0 || meshlet.triangleCount > MeshletMaxTriangles ||
+                (meshlet.triangleOffset & 3) != 0 ||
+                uint64_t(meshlet.vertexOffset) + meshlet.vertexCount > outData.vertices.size() ||
+                uint64_t(meshlet.triangleOffset) + uint64_t(meshlet.triangleCount) * 3 > outData.triangles.size())
+            {
+                return false;
+            }
+            const uint8_t* local = outData.triangles.data() + meshlet.triangleOffset;
+            for (uint32_t i = 0; i < meshlet.triangleCount * 3; i++)
+            {
+                if (local[i] >= meshlet.vertexCount)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,427 @@
+#include <ANTUTU/Render/OcclusionRasterizer.hpp>
+#include <ANTUTU/Math/SimdTypes.hpp>
+#include <Common/Job/JobSystem.h>
+#include <Common/Profiler/Tracer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace att::Render
+{
+    // vertices closer than this (clip w) are treated as crossing the near plane.
+    static constexpr float NearW = 1e-5f;
+    // vertices are snapped to 1 / 256 pixel, the edge functions are exact integers from there.
+    static constexpr int32_t SubpixelBits = 8;
+    static constexpr int64_t SubpixelOne = int64_t(1) << SubpixelBits;
+    // snapped coordinates stay below 2^29 so neither the area nor the int64 edge functions overflow,
+    // triangles reaching further off screen are dropped.
+    static constexpr float GuardBand = float(1 << (29 - SubpixelBits));
+    static constexpr uint32_t OccludersPerJob = 4;
+    static constexpr uint32_t OccludeesPerJob = 256;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Frame
+    ////////////////////////////////////////////////////////////////////////////
+
+    void OcclusionRasterizer::Initialize(uint32_t width, uint32_t height)
+    {
+        assert(width > 0 && height > 0 && width <= UINT16_MAX && height <= UINT16_MAX);
+        m_width = (width + 3) & ~3u;
+        m_height = height;
+        m_tilesX = (m_width + TileWidth - 1) / TileWidth;
+        m_tilesY = (m_height + TileHeight - 1) / TileHeight;
+        m_depth.assign(static_cast<size_t>(m_width) * m_height, 1.0f);
+        m_binStart.assign(m_tilesX * m_tilesY + 1, 0);
+    }
+
+    void OcclusionRasterizer::BeginFrame(const glm::mat4& viewProjection)
+    {
+        assert(m_width > 0 && "Initialize must be called first");
+        m_viewProjection = viewProjection;
+        m_occluders.clear();
+        m_stats = {};
+        std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+    }
+
+    void OcclusionRasterizer::AddOccluder(const glm::vec3* vertices, uint32_t vertexCount,
+                                          const uint32_t* indices, uint32_t indexCount, const glm::mat4& model)
+    {
+        if (vertexCount == 0 || indexCount < 3)
+        {
+            return;
+        }
+
+        Occluder occluder;
+        occluder.vertices = vertices;
+        occluder.indices = indices;
+        occluder.vertexCount = vertexCount;
+        occluder.indexCount = indexCount - indexCount % 3;
+        occluder.model = model;
+        occluder.firstVertex = m_occluders.empty() ? 0 : m_occluders.back().firstVertex + m_occluders.back().vertexCount;
+        occluder.firstTriangle = m_occluders.empty() ? 0 : m_occluders.back().firstTriangle + m_occluders.back().indexCount / 3;
+        m_occluders.push_back(occluder);
+
+        m_stats.occluderCount++;
+        m_stats.trianglesSubmitted += occluder.indexCount / 3;
+    }
+
+    void OcclusionRasterizer::Rasterize()
+    {
+        TRACE_FUNCTION();
+
+        const uint32_t occluderCount = static_cast<uint32_t>(m_occluders.size());
+        const uint32_t tileCount = m_tilesX * m_tilesY;
+        std::fill(m_binStart.begin(), m_binStart.end(), 0);
+
+        if (occluderCount > 0)
+        {
+            const Occluder& last = m_occluders.back();
+            m_clip.resize(last.firstVertex + last.vertexCount);
+            m_triangles.resize(last.firstTriangle + last.indexCount / 3);
+            m_triangleCount.assign(occluderCount, 0);
+
+            // transform and triangle setup, one occluder at a time.
+            Common::JobSystem::Get().ParallelFor(occluderCount, OccludersPerJob, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    SetupOccluder(m_occluders[i], m_triangleCount[i]);
+                }
+            });
+
+            // bin by tile: count, prefix sum, fill.
+            {
+                TRACE_SCOPE("Bin");
+                for (uint32_t pass = 0; pass < 2; pass++)
+                {
+                    for (uint32_t i = 0; i < occluderCount; i++)
+                    {
+                        const uint32_t first = m_occluders[i].firstTriangle;
+                        for (uint32_t t = first; t < first + m_triangleCount[i]; t++)
+                        {
+                            const Triangle& triangle = m_triangles[t];
+                            const uint32_t tileX0 = triangle.minX / TileWidth;
+                            const uint32_t tileX1 = (triangle.maxX - 1u) / TileWidth;
+                            const uint32_t tileY0 = triangle.minY / TileHeight;
+                            const uint32_t tileY1 = (triangle.maxY - 1u) / TileHeight;
+                            for (uint32_t ty = tileY0; ty <= tileY1; ty++)
+                            {
+                                for (uint32_t tx = tileX0; tx <= tileX1; tx++)
+                                {
+                                    const uint32_t tile = ty * m_tilesX + tx;
+                                    if (pass == 0)
+                                    {
+                                        m_binStart[tile + 1]++;
+                                    }
+                                    else
+                                    {
+                                        m_binned[m_binStart[tile]++] = t;
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    if (pass == 0)
+                    {
+                        for (uint32_t tile = 0; tile < tileCount; tile++)
+                        {
+                            m_binStart[tile + 1] += m_binStart[tile];
+                        }
+                        m_binned.resize(m_binStart[tileCount]);
+                    }
+                    else
+                    {
+                        // the fill advanced every start to the next tile's start.
+                        for (uint32_t tile = tileCount; tile > 0; tile--)
+                        {
+                            m_binStart[tile] = m_binStart[tile - 1];
+                        }
+                        m_binStart[0] = 0;
+                    }
+                }
+            }
+
+            for (uint32_t i = 0; i < occluderCount; i++)
+            {
+                m_stats.trianglesRasterized += m_triangleCount[i];
+            }
+
+            // tiles don't share pixels, each one is rasterized by a single job.
+            Common::JobSystem::Get().ParallelFor(tileCount, 1, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t tile = begin; tile < end; tile++)
+                {
+                    RasterizeTile(tile);
+                }
+            });
+        }
+
+        TRACE_SCOPE("BuildPyramid");
+        m_pyramid.Build(m_depth.data(), m_width, m_height);
+    }
+
+    void OcclusionRasterizer::SetupOccluder(const Occluder& occluder, uint32_t& outCount)
+    {
+        using namespace Math::Simd;
+
+        const Math::Mat4 modelViewProjection(m_viewProjection * occluder.model);
+        glm::vec4* clip = m_clip.data() + occluder.firstVertex;
+        for (uint32_t v = 0; v < occluder.vertexCount; v++)
+        {
+            Store(&clip[v].x, (modelViewProjection * Math::Vec4(occluder.vertices[v], 1.0f)).value);
+        }
+
+        const float width = static_cast<float>(m_width);
+        const float height = static_cast<float>(m_height);
+        Triangle* out = m_triangles.data() + occluder.firstTriangle;
+        uint32_t count = 0;
+
+        for (uint32_t i = 0; i < occluder.indexCount; i += 3)
+        {
+            assert(occluder.indices[i] < occluder.vertexCount && occluder.indices[i + 1] < occluder.vertexCount &&
+                   occluder.indices[i + 2] < occluder.vertexCount);
+            const glm::vec4 c[3] = { clip[occluder.indices[i]], clip[occluder.indices[i + 1]], clip[occluder.indices[i + 2]] };
+
+            // dropped instead of clipped: behind or crossing the near plane ([0, 1] depth).
+            if (c[0].w < NearW || c[1].w < NearW || c[2].w < NearW ||
+                c[0].z < 0.0f || c[1].z < 0.0f || c[2].z < 0.0f)
+            {
+                continue;
+            }
+            // trivially outside one frustum plane.
+            if ((c[0].x > c[0].w && c[1].x > c[1].w && c[2].x > c[2].w) ||
+                (c[0].x < -c[0].w && c[1].x < -c[1].w && c[2].x < -c[2].w) ||
+                (c[0].y > c[0].w && c[1].y > c[1].w && c[2].y > c[2].w) ||
+                (c[0].y < -c[0].w && c[1].y < -c[1].w && c[2].y < -c[2].w) ||
+                (c[0].z > c[0].w && c[1].z > c[1].w && c[2].z > c[2].w))
+            {
+                continue;
+            }
+
+            // snapped screen position, and the same position as float for the depth plane.
+            int64_t fixedX[3], fixedY[3];
+            float x[3], y[3], z[3];
+            bool outsideGuardBand = false;
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                const float invW = 1.0f / c[k].w;
+                const float screenX = (c[k].x * invW * 0.5f + 0.5f) * width;
+                const float screenY = (c[k].y * invW * 0.5f + 0.5f) * height;
+                outsideGuardBand = outsideGuardBand || !(std::fabs(screenX) < GuardBand && std::fabs(screenY) < GuardBand);
+                fixedX[k] = static_cast<int64_t>(std::llround(screenX * float(SubpixelOne)));
+                fixedY[k] = static_cast<int64_t>(std::llround(screenY * float(SubpixelOne)));
+                x[k] = static_cast<float>(fixedX[k]) / float(SubpixelOne);
+                y[k] = static_cast<float>(fixedY[k]) / float(SubpixelOne);
+                z[k] = c[k].z * invW;
+            }
+            if (outsideGuardBand)
+            {
+                continue;
+            }
+
+            int64_t fixedArea = (fixedX[1] - fixedX[0]) * (fixedY[2] - fixedY[0]) - (fixedX[2] - fixedX[0]) * (fixedY[1] - fixedY[0]);
+            if (fixedArea == 0)
+            {
+                continue;
+            }
+            // occluders are rasterized double sided, flip to a positive area.
+            if (fixedArea < 0)
+            {
+                std::swap(fixedX[1], fixedX[2]);
+                std::swap(fixedY[1], fixedY[2]);
+                std::swap(x[1], x[2]);
+                std::swap(y[1], y[2]);
+                std::swap(z[1], z[2]);
+                fixedArea = -fixedArea;
+            }
+
+            const float minX = std::max(std::floor(std::min(std::min(x[0], x[1]), x[2])), 0.0f);
+            const float maxX = std::min(std::ceil(std::max(std::max(x[0], x[1]), x[2])), width);
+            const float minY = std::max(std::floor(std::min(std::min(y[0], y[1]), y[2])), 0.0f);
+            const float maxY = std::min(std::ceil(std::max(std::max(y[0], y[1]), y[2])), height);
+            if (minX >= maxX || minY >= maxY)
+            {
+                continue;
+            }
+
+            Triangle& triangle = out[count++];
+            // edge k runs from vertex k to k + 1, inside is >= 0 for all three. Pixels exactly on
+            // an edge belong to its top-left side only, so two triangles sharing it cover every
+            // pixel along it once.
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                const uint32_t n = (k + 1) % 3;
+                const int64_t a = fixedY[k] - fixedY[n];
+                const int64_t b = fixedX[n] - fixedX[k];
+                const bool topLeft = a > 0 || (a == 0 && b < 0);
+                triangle.edgeA[k] = a;
+                triangle.edgeB[k] = b;
+                triangle.edgeC[k] = -(a * fixedX[k] + b * fixedY[k]) - (topLeft ? 0 : 1);
+            }
+
+            // barycentric weight of vertex k is edge (k + 1) / area, in pixel units here.
+            float depthEdgeA[3], depthEdgeB[3], depthEdgeC[3];
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                const uint32_t n = (k + 1) % 3;
+                depthEdgeA[k] = y[k] - y[n];
+                depthEdgeB[k] = x[n] - x[k];
+                depthEdgeC[k] = -(depthEdgeA[k] * x[k] + depthEdgeB[k] * y[k]);
+            }
+            const float invArea = float(SubpixelOne * SubpixelOne) / static_cast<float>(fixedArea);
+            triangle.depthA = (depthEdgeA[1] * z[0] + depthEdgeA[2] * z[1] + depthEdgeA[0] * z[2]) * invArea;
+            triangle.depthB = (depthEdgeB[1] * z[0] + depthEdgeB[2] * z[1] + depthEdgeB[0] * z[2]) * invArea;
+            triangle.depthC = (depthEdgeC[1] * z[0] + depthEdgeC[2] * z[1] + depthEdgeC[0] * z[2]) * invArea;
+
+            triangle.minX = static_cast<uint16_t>(minX);
+            triangle.maxX = static_cast<uint16_t>(maxX);
+            triangle.minY = static_cast<uint16_t>(minY);
+            triangle.maxY = static_cast<uint16_t>(maxY);
+        }
+
+        outCount = count;
+    }
+
+    void OcclusionRasterizer::RasterizeTile(uint32_t tile)
+    {
+        const uint32_t tileX0 = (tile % m_tilesX) * TileWidth;
+        const uint32_t tileY0 = (tile / m_tilesX) * TileHeight;
+        const uint32_t tileX1 = std::min(tileX0 + TileWidth, m_width);
+        const uint32_t tileY1 = std::min(tileY0 + TileHeight, m_height);
+
+        for (uint32_t b = m_binStart[tile]; b < m_binStart[tile + 1]; b++)
+        {
+            const Triangle& triangle = m_triangles[m_binned[b]];
+
+            const uint32_t x0 = std::max<uint32_t>(triangle.minX, tileX0);
+            const uint32_t x1 = std::min<uint32_t>(triangle.maxX, tileX1);
+            const uint32_t y0 = std::max<uint32_t>(triangle.minY, tileY0);
+            const uint32_t y1 = std::min<uint32_t>(triangle.maxY, tileY1);
+
+            // one pixel to the right, in subpixels.
+            const int64_t stepX0 = triangle.edgeA[0] * SubpixelOne;
+            const int64_t stepX1 = triangle.edgeA[1] * SubpixelOne;
+            const int64_t stepX2 = triangle.edgeA[2] * SubpixelOne;
+            const int64_t centerX0 = static_cast<int64_t>(x0) * SubpixelOne + SubpixelOne / 2;
+
+            for (uint32_t y = y0; y < y1; y++)
+            {
+                const int64_t centerY = static_cast<int64_t>(y) * SubpixelOne + SubpixelOne / 2;
+                int64_t e0 = triangle.edgeA[0] * centerX0 + triangle.edgeB[0] * centerY + triangle.edgeC[0];
+                int64_t e1 = triangle.edgeA[1] * centerX0 + triangle.edgeB[1] * centerY + triangle.edgeC[1];
+                int64_t e2 = triangle.edgeA[2] * centerX0 + triangle.edgeB[2] * centerY + triangle.edgeC[2];
+
+                const float rowDepth = triangle.depthB * (static_cast<float>(y) + 0.5f) + triangle.depthC;
+                float* depth = m_depth.data() + static_cast<size_t>(y) * m_width;
+
+                for (uint32_t x = x0; x < x1; x++)
+                {
+                    // all three >= 0: none has the sign bit set.
+                    if ((e0 | e1 | e2) >= 0)
+                    {
+                        const float z = triangle.depthA * (static_cast<float>(x) + 0.5f) + rowDepth;
+                        depth[x] = std::min(depth[x], z);
+                    }
+                    e0 += stepX0;
+                    e1 += stepX1;
+                    e2 += stepX2;
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Occludees
+    ////////////////////////////////////////////////////////////////////////////
+
+    bool OcclusionRasterizer::IsOccluded(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const
+    {
+        if (m_pyramid.GetMipCount() == 0)
+        {
+            return false;
+        }
+
+        const Math::Mat4 viewProjection(m_viewProjection);
+        glm::vec4 rect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        float nearest = FLT_MAX;
+        for (uint32_t corner = 0; corner < 8; corner++)
+        {
+            const glm::vec3 p((corner & 1) ? boundsMax.x : boundsMin.x,
+                              (corner & 2) ? boundsMax.y : boundsMin.y,
+                              (corner & 4) ? boundsMax.z : boundsMin.z);
+            const glm::vec4 clip = (viewProjection * Math::Vec4(p, 1.0f)).ToGlm();
+            if (clip.w < NearW || clip.z < 0.0f)
+            {
+                // crossing the near plane, can't be tested conservatively.
+                return false;
+            }
+
+            const float invW = 1.0f / clip.w;
+            const float u = clip.x * invW * 0.5f + 0.5f;
+            const float v = clip.y * invW * 0.5f + 0.5f;
+            rect = glm::vec4(std::min(rect.x, u), std::min(rect.y, v), std::max(rect.z, u), std::max(rect.w, v));
+            nearest = std::min(nearest, clip.z * invW);
+        }
+
+        // off screen is the frustum culler's call.
+        if (rect.z < 0.0f || rect.w < 0.0f || rect.x > 1.0f || rect.y > 1.0f)
+        {
+            return false;
+        }
+        rect = glm::clamp(rect, glm::vec4(0.0f), glm::vec4(1.0f));
+
+        const float width = (rect.z - rect.x) * static_cast<float>(m_pyramid.GetWidth());
+        const float height = (rect.w - rect.y) * static_cast<float>(m_pyramid.GetHeight());
+        const float extent = std::max(std::max(width, height), 1.0f);
+
+        // same mip choice as GpuCullingReference::IsSphereOccluded: at most 2x2 texels.
+        uint32_t level = static_cast<uint32_t>(std::ceil(std::log2(extent)));
+        level = std::min(level, m_pyramid.GetMipCount() - 1);
+
+        const float mipWidth = static_cast<float>(m_pyramid.GetWidth(level));
+        const float mipHeight = static_cast<float>(m_pyramid.GetHeight(level));
+        const int32_t x0 = static_cast<int32_t>(std::floor(rect.x * mipWidth));
+        const int32_t y0 = static_cast<int32_t>(std::floor(rect.y * mipHeight));
+        const int32_t x1 = static_cast<int32_t>(std::floor(rect.z * mipWidth));
+        const int32_t y1 = static_cast<int32_t>(std::floor(rect.w * mipHeight));
+
+        float occluderDepth = 0.0f;
+        for (int32_t y = y0; y <= y1; y++)
+        {
+            for (int32_t x = x0; x <= x1; x++)
+            {
+                occluderDepth = std::max(occluderDepth, m_pyramid.Fetch(level, x, y));
+            }
+        }
+        return nearest > occluderDepth;
+    }
+
+    uint32_t OcclusionRasterizer::FilterVisible(const glm::vec3* boundsMin, const glm::vec3* boundsMax,
+                                                uint32_t* indices, uint32_t count)
+    {
+        TRACE_FUNCTION();
+
+        m_visible.resize(count);
+        Common::JobSystem::Get().ParallelFor(count, OccludeesPerJob, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                m_visible[i] = !IsOccluded(boundsMin[indices[i]], boundsMax[indices[i]]);
+            }
+        });
+
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            indices[kept] = indices[i];
+            kept += m_visible[i];
+        }
+
+        m_stats.occludeesTested += count;
+        m_stats.occludeesCulled += count - kept;
+        return kept;
+    }
+}
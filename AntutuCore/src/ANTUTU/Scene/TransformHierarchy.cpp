@@ -0,0 +1,348 @@
+#include <ANTUTU/Scene/TransformHierarchy.hpp>
+#include <ANTUTU/Math/SimdTypes.hpp>
+#include <Common/Job/JobSystem.h>
+#include <Common/Profiler/Tracer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+namespace att::Scene
+{
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Nodes
+    ////////////////////////////////////////////////////////////////////////////
+
+    TransformHandle TransformHierarchy::Create(TransformHandle parent, const Transform& local)
+    {
+        assert(parent == InvalidTransform || IsValid(parent));
+
+        TransformHandle handle;
+        if (!m_freeHandles.empty())
+        {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        }
+        else
+        {
+            handle = static_cast<TransformHandle>(m_dense.size());
+            m_dense.push_back(InvalidIndex);
+        }
+
+        const uint32_t index = GetCount();
+        const uint32_t parentIndex = parent == InvalidTransform ? NoParent : m_dense[parent];
+        const uint32_t depth = parentIndex == NoParent ? 0 : m_depth[parentIndex] + 1;
+
+        m_local.push_back(local);
+        m_world.push_back(glm::mat4(1.0f));
+        m_parent.push_back(parentIndex);
+        m_depth.push_back(depth);
+        m_dirty.push_back(0);
+        m_handle.push_back(handle);
+        m_dense[handle] = index;
+
+        // appending to the deepest level (or opening the next one) keeps the order,
+        // anything shallower waits for the next Reorder.
+        const uint32_t levels = GetLevelCount();
+        if (!m_orderDirty && depth + 1 >= levels)
+        {
+            if (m_levelStart.empty())
+            {
+                m_levelStart.push_back(0);
+            }
+            if (depth == levels)
+            {
+                m_levelStart.push_back(index + 1);
+                m_levelDirty.push_back(0);
+            }
+            else
+            {
+                m_levelStart.back() = index + 1;
+            }
+        }
+        else
+        {
+            m_orderDirty = true;
+        }
+
+        MarkDirty(index);
+        return handle;
+    }
+
+    void TransformHierarchy::Destroy(TransformHandle handle)
+    {
+        assert(IsValid(handle));
+        if (m_orderDirty)
+        {
+            Reorder();
+        }
+
+        // parents come first, so one forward pass from the root of the subtree finds it all.
+        const uint32_t count = GetCount();
+        const uint32_t root = m_dense[handle];
+        std::vector<uint8_t> removed(count, 0);
+        removed[root] = 1;
+        for (uint32_t i = root + 1; i < count; i++)
+        {
+            removed[i] = m_parent[i] != NoParent && removed[m_parent[i]];
+        }
+
+        // stable compaction keeps the breadth-first order.
+        std::vector<uint32_t> remap(count, NoParent);
+        uint32_t write = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (removed[i])
+            {
+                m_dense[m_handle[i]] = InvalidIndex;
+                m_freeHandles.push_back(m_handle[i]);
+                continue;
+            }
+            remap[i] = write;
+            m_local[write] = m_local[i];
+            m_world[write] = m_world[i];
+            m_parent[write] = m_parent[i] == NoParent ? NoParent : remap[m_parent[i]];
+            m_depth[write] = m_depth[i];
+            m_dirty[write] = m_dirty[i];
+            m_handle[write] = m_handle[i];
+            m_dense[m_handle[write]] = write;
+            write++;
+        }
+
+        m_local.resize(write);
+        m_world.resize(write);
+        m_parent.resize(write);
+        m_depth.resize(write);
+        m_dirty.resize(write);
+        m_handle.resize(write);
+        RebuildLevels();
+    }
+
+    bool TransformHierarchy::SetParent(TransformHandle handle, TransformHandle parent)
+    {
+        assert(IsValid(handle) && (parent == InvalidTransform || IsValid(parent)));
+
+        const uint32_t index = m_dense[handle];
+        const uint32_t parentIndex = parent == InvalidTransform ? NoParent : m_dense[parent];
+        for (uint32_t ancestor = parentIndex; ancestor != NoParent; ancestor = m_parent[ancestor])
+        {
+            if (ancestor == index)
+            {
+                return false;
+            }
+        }
+
+        if (m_parent[index] == parentIndex)
+        {
+            return true;
+        }
+
+        // depths of the whole subtree change, Reorder recomputes them.
+        m_parent[index] = parentIndex;
+        m_orderDirty = true;
+        MarkDirty(index);
+        return true;
+    }
+
+    void TransformHierarchy::SetLocal(TransformHandle handle, const Transform& local)
+    {
+        assert(IsValid(handle));
+        const uint32_t index = m_dense[handle];
+        m_local[index] = local;
+        MarkDirty(index);
+    }
+
+    TransformHandle TransformHierarchy::GetParent(TransformHandle handle) const
+    {
+        const uint32_t parentIndex = m_parent[m_dense[handle]];
+        return parentIndex == NoParent ? InvalidTransform : m_handle[parentIndex];
+    }
+
+    bool TransformHierarchy::IsValid(TransformHandle handle) const
+    {
+        return handle < m_dense.size() && m_dense[handle] != InvalidIndex;
+    }
+
+    void TransformHierarchy::MarkDirty(uint32_t index)
+    {
+        if (m_dirty[index])
+        {
+            return;
+        }
+        m_dirty[index] = 1;
+        // recounted by RebuildLevels otherwise.
+        if (!m_orderDirty)
+        {
+            m_levelDirty[m_depth[index]]++;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Ordering
+    ////////////////////////////////////////////////////////////////////////////
+
+    void TransformHierarchy::Reorder()
+    {
+        TRACE_FUNCTION();
+        const uint32_t count = GetCount();
+
+        // depths from the parent links, each node is resolved once.
+        std::vector<uint32_t> depth(count, InvalidIndex);
+        std::vector<uint32_t> chain;
+        uint32_t levels = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t node = i;
+            while (depth[node] == InvalidIndex && m_parent[node] != NoParent)
+            {
+                chain.push_back(node);
+                node = m_parent[node];
+            }
+            if (depth[node] == InvalidIndex)
+            {
+                depth[node] = 0;
+            }
+            uint32_t d = depth[node];
+            while (!chain.empty())
+            {
+                depth[chain.back()] = ++d;
+                chain.pop_back();
+            }
+            levels = std::max(levels, depth[i] + 1);
+        }
+
+        // stable counting sort by depth.
+        std::vector<uint32_t> start(levels + 1, 0);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            start[depth[i] + 1]++;
+        }
+        for (uint32_t d = 0; d < levels; d++)
+        {
+            start[d + 1] += start[d];
+        }
+        std::vector<uint32_t> newIndex(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            newIndex[i] = start[depth[i]]++;
+        }
+
+        std::vector<Transform> local(count);
+        std::vector<glm::mat4> world(count);
+        std::vector<uint32_t> parent(count);
+        std::vector<uint8_t> dirty(count);
+        std::vector<TransformHandle> handles(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const uint32_t to = newIndex[i];
+            local[to] = m_local[i];
+            world[to] = m_world[i];
+            parent[to] = m_parent[i] == NoParent ? NoParent : newIndex[m_parent[i]];
+            dirty[to] = m_dirty[i];
+            handles[to] = m_handle[i];
+            m_dense[m_handle[i]] = to;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_depth[newIndex[i]] = depth[i];
+        }
+
+        m_local = std::move(local);
+        m_world = std::move(world);
+        m_parent = std::move(parent);
+        m_dirty = std::move(dirty);
+        m_handle = std::move(handles);
+        m_orderDirty = false;
+        RebuildLevels();
+    }
+
+    void TransformHierarchy::RebuildLevels()
+    {
+        const uint32_t count = GetCount();
+        m_levelStart.clear();
+        m_levelDirty.clear();
+        if (count == 0)
+        {
+            return;
+        }
+
+        const uint32_t levels = m_depth.back() + 1;
+        m_levelStart.assign(levels + 1, 0);
+        m_levelDirty.assign(levels, 0);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_levelStart[m_depth[i] + 1]++;
+            m_levelDirty[m_depth[i]] += m_dirty[i];
+        }
+        for (uint32_t d = 0; d < levels; d++)
+        {
+            m_levelStart[d + 1] += m_levelStart[d];
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// Update
+    ////////////////////////////////////////////////////////////////////////////
+
+    uint32_t TransformHierarchy::UpdateLevel(uint32_t begin, uint32_t end)
+    {
+        std::atomic<uint32_t> updated{ 0 };
+        Common::JobSystem::Get().ParallelFor(end - begin, NodesPerJob, [&](uint32_t first, uint32_t last)
+        {
+            uint32_t recomputed = 0;
+            for (uint32_t i = begin + first; i < begin + last; i++)
+            {
+                const uint32_t parent = m_parent[i];
+                const bool parentDirty = parent != NoParent && m_dirty[parent];
+                if (!m_dirty[i] && !parentDirty)
+                {
+                    continue;
+                }
+
+                const Transform& local = m_local[i];
+                const Math::Mat4 trs = Math::Mat4::FromTRS(local.position, local.rotation, local.scale);
+                m_world[i] = parent == NoParent ? trs.ToGlm() : (Math::Mat4(m_world[parent]) * trs).ToGlm();
+                // read by the next level only, no other writer touches this byte.
+                m_dirty[i] = 1;
+                recomputed++;
+            }
+            updated.fetch_add(recomputed, std::memory_order_relaxed);
+        });
+        return updated.load(std::memory_order_relaxed);
+    }
+
+    void TransformHierarchy::Update()
+    {
+        TRACE_FUNCTION();
+        if (m_orderDirty)
+        {
+            Reorder();
+        }
+
+        m_lastUpdateCount = 0;
+        const uint32_t levels = GetLevelCount();
+        uint32_t previousUpdated = 0;
+        uint32_t firstTouched = InvalidIndex;
+        for (uint32_t d = 0; d < levels; d++)
+        {
+            // nothing set here and no parent moved: the whole level is already correct.
+            if (m_levelDirty[d] == 0 && previousUpdated == 0)
+            {
+                continue;
+            }
+            firstTouched = std::min(firstTouched, d);
+            previousUpdated = UpdateLevel(m_levelStart[d], m_levelStart[d + 1]);
+            m_lastUpdateCount += previousUpdated;
+            m_levelDirty[d] = 0;
+        }
+
+        if (firstTouched != InvalidIndex)
+        {
+            const uint32_t begin = m_levelStart[firstTouched];
+            std::memset(m_dirty.data() + begin, 0, m_dirty.size() - begin);
+        }
+    }
+}
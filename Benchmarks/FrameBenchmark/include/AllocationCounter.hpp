@@ -0,0 +1,13 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace Bench
+{
+	// heap allocations through operator new in the whole process (the engine
+	// libraries resolve operator new to the benchmark's replacement).
+	uint64_t GetAllocationCount();
+}
+
+#endif	// ALLOCATION_COUNTER_H
@@ -0,0 +1,61 @@
+#ifndef FRAME_BENCHMARK_H
+#define FRAME_BENCHMARK_H
+
+#include <ANTUTU/RHI/VulkanRender.hpp>
+
+#include <map>
+#include <string>
+
+namespace Bench
+{
+	struct BenchmarkOptions
+	{
+		uint32_t frames = 600;
+		// not recorded, lets pipelines, caches and clocks settle.
+		uint32_t warmupFrames = 60;
+		uint32_t width = 1280;
+		uint32_t height = 720;
+		// only accept VK_PHYSICAL_DEVICE_TYPE_CPU (lavapipe / swiftshader).
+		bool requireCpuDevice = false;
+		std::string capturePath;
+	};
+
+	// every metric is "lower is better", checks must match the baseline exactly.
+	struct BenchmarkResults
+	{
+		std::string device;
+		uint32_t frames = 0;
+		std::map<std::string, double> metrics;
+		std::map<std::string, double> checks;
+	};
+
+	// Drives VulkanRender's headless frame loop for a fixed number of frames,
+	// offscreen so nothing paces it, and reports the GPU passes it records.
+	class FrameBenchmark
+	{
+	public:
+		FrameBenchmark() = default;
+		~FrameBenchmark();
+
+		FrameBenchmark(const FrameBenchmark&) = delete;
+		FrameBenchmark& operator=(const FrameBenchmark&) = delete;
+
+		bool Initialize(const BenchmarkOptions& options);
+		bool Run(BenchmarkResults& results);
+		void Shutdown();
+
+	private:
+		BenchmarkOptions m_options;
+		att::RHI::VulkanRender m_render;
+	};
+
+	bool WriteResults(const BenchmarkResults& results, const std::string& path);
+	bool ReadResults(const std::string& path, BenchmarkResults& results);
+
+	// tolerance per metric as a fraction (0.05 = 5% slower allowed), "*" is the default.
+	// Returns the number of regressions, every comparison is logged.
+	uint32_t CompareResults(const BenchmarkResults& current, const BenchmarkResults& baseline,
+		const std::map<std::string, double>& tolerances);
+}
+
+#endif	// FRAME_BENCHMARK_H
@@ -0,0 +1,50 @@
+#include <AllocationCounter.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Bench
+{
+	static std::atomic<uint64_t> s_allocationCount{ 0 };
+
+	uint64_t GetAllocationCount()
+	{
+		return s_allocationCount.load(std::memory_order_relaxed);
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	Bench::s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size == 0 ? 1 : size))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
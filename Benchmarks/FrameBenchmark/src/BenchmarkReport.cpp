@@ -0,0 +1,268 @@
+#include <FrameBenchmark.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace Bench
+{
+	// reader for the flat format WriteResults produces, not a general JSON parser.
+	class ResultsParser
+	{
+	public:
+		explicit ResultsParser(const std::string& text) : m_text(text) {}
+
+		bool Parse(BenchmarkResults& results)
+		{
+			if (!Accept('{'))
+			{
+				return false;
+			}
+			while (!Peek('}'))
+			{
+				std::string key;
+				if (!ParseString(key) || !Accept(':'))
+				{
+					return false;
+				}
+
+				if (key == "metrics" || key == "checks")
+				{
+					if (!ParseNumberMap(key == "metrics" ? results.metrics : results.checks))
+					{
+						return false;
+					}
+				}
+				else if (key == "device")
+				{
+					if (!ParseString(results.device))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					double value = 0.0;
+					if (!ParseNumber(value))
+					{
+						return false;
+					}
+					if (key == "frames")
+					{
+						results.frames = static_cast<uint32_t>(value);
+					}
+				}
+				Accept(',');
+			}
+			return Accept('}');
+		}
+
+	private:
+		bool ParseNumberMap(std::map<std::string, double>& values)
+		{
+			if (!Accept('{'))
+			{
+				return false;
+			}
+			while (!Peek('}'))
+			{
+				std::string key;
+				double value = 0.0;
+				if (!ParseString(key) || !Accept(':') || !ParseNumber(value))
+				{
+					return false;
+				}
+				values[key] = value;
+				Accept(',');
+			}
+			return Accept('}');
+		}
+
+		bool ParseString(std::string& out)
+		{
+			if (!Accept('"'))
+			{
+				return false;
+			}
+			out.clear();
+			while (m_pos < m_text.size() && m_text[m_pos] != '"')
+			{
+				if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size())
+				{
+					m_pos++;
+				}
+				out += m_text[m_pos++];
+			}
+			return Accept('"');
+		}
+
+		bool ParseNumber(double& out)
+		{
+			SkipWhitespace();
+			const char* begin = m_text.c_str() + m_pos;
+			char* end = nullptr;
+			out = std::strtod(begin, &end);
+			if (end == begin)
+			{
+				return false;
+			}
+			m_pos += static_cast<size_t>(end - begin);
+			return true;
+		}
+
+		void SkipWhitespace()
+		{
+			while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+			{
+				m_pos++;
+			}
+		}
+
+		bool Peek(char c)
+		{
+			SkipWhitespace();
+			return m_pos < m_text.size() && m_text[m_pos] == c;
+		}
+
+		bool Accept(char c)
+		{
+			if (Peek(c))
+			{
+				m_pos++;
+				return true;
+			}
+			return false;
+		}
+
+	private:
+		const std::string& m_text;
+		size_t m_pos = 0;
+	};
+
+	static void WriteEscaped(std::ofstream& out, const std::string& text)
+	{
+		out << '"';
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out << '\\';
+			}
+			out << c;
+		}
+		out << '"';
+	}
+
+	static void WriteNumberMap(std::ofstream& out, const std::map<std::string, double>& values)
+	{
+		out << "{";
+		bool first = true;
+		for (const auto& [name, value] : values)
+		{
+			out << (first ? "\n    " : ",\n    ");
+			WriteEscaped(out, name);
+			out << ": " << value;
+			first = false;
+		}
+		out << "\n  }";
+	}
+
+	bool WriteResults(const BenchmarkResults& results, const std::string& path)
+	{
+		std::ofstream out(path, std::ios::out | std::ios::trunc);
+		if (!out.is_open())
+		{
+			LOG_ERROR("Failed to open {0} for writing.", path);
+			return false;
+		}
+
+		out.precision(6);
+		out << "{\n  \"device\": ";
+		WriteEscaped(out, results.device);
+		out << ",\n  \"frames\": " << results.frames << ",\n  \"metrics\": ";
+		WriteNumberMap(out, results.metrics);
+		out << ",\n  \"checks\": ";
+		WriteNumberMap(out, results.checks);
+		out << "\n}\n";
+		return out.good();
+	}
+
+	bool ReadResults(const std::string& path, BenchmarkResults& results)
+	{
+		std::ifstream in(path);
+		if (!in.is_open())
+		{
+			LOG_ERROR("Failed to open {0}.", path);
+			return false;
+		}
+
+		std::stringstream buffer;
+		buffer << in.rdbuf();
+		const std::string text = buffer.str();
+		if (!ResultsParser(text).Parse(results))
+		{
+			LOG_ERROR("{0} is not a benchmark result file.", path);
+			return false;
+		}
+		return true;
+	}
+
+	uint32_t CompareResults(const BenchmarkResults& current, const BenchmarkResults& baseline,
+		const std::map<std::string, double>& tolerances)
+	{
+		auto toleranceOf = [&](const std::string& name)
+		{
+			auto it = tolerances.find(name);
+			if (it == tolerances.end())
+			{
+				it = tolerances.find("*");
+			}
+			return it != tolerances.end() ? it->second : 0.05;
+		};
+
+		if (current.device != baseline.device)
+		{
+			LOG_WARN("Baseline was recorded on '{0}', this run uses '{1}'.", baseline.device, current.device);
+		}
+
+		uint32_t regressions = 0;
+		for (const auto& [name, expected] : baseline.metrics)
+		{
+			auto it = current.metrics.find(name);
+			if (it == current.metrics.end())
+			{
+				LOG_WARN("{0}: missing in this run.", name);
+				continue;
+			}
+
+			const double tolerance = toleranceOf(name);
+			const double limit = expected * (1.0 + tolerance);
+			const double change = expected != 0.0 ? (it->second - expected) / expected * 100.0 : 0.0;
+			if (it->second > limit)
+			{
+				LOG_ERROR("REGRESSION {0}: {1} vs baseline {2} ({3:+.1f}%, tolerance {4:.1f}%)",
+					name, it->second, expected, change, tolerance * 100.0);
+				regressions++;
+			}
+			else
+			{
+				LOG_INFO("ok {0}: {1} vs baseline {2} ({3:+.1f}%)", name, it->second, expected, change);
+			}
+		}
+
+		for (const auto& [name, expected] : baseline.checks)
+		{
+			auto it = current.checks.find(name);
+			if (it == current.checks.end() || std::fabs(it->second - expected) > 0.5)
+			{
+				LOG_ERROR("MISMATCH {0}: {1} vs baseline {2}, the replay is not deterministic.",
+					name, it == current.checks.end() ? -1.0 : it->second, expected);
+				regressions++;
+			}
+		}
+		return regressions;
+	}
+}
@@ -0,0 +1,147 @@
+#include <FrameBenchmark.hpp>
+#include <AllocationCounter.hpp>
+#include <Common/Logger/LogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace Bench
+{
+	static double Percentile(std::vector<double> values, double fraction)
+	{
+		if (values.empty())
+		{
+			return 0.0;
+		}
+		const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * (values.size() - 1) + 0.5));
+		std::nth_element(values.begin(), values.begin() + index, values.end());
+		return values[index];
+	}
+
+	FrameBenchmark::~FrameBenchmark()
+	{
+		Shutdown();
+	}
+
+	bool FrameBenchmark::Initialize(const BenchmarkOptions& options)
+	{
+		m_options = options;
+
+		if (m_options.requireCpuDevice)
+		{
+			m_render.RequireDevice("software rasterizer", [](const att::PlatformInfo::VulkanDeviceInfo& info)
+			{
+				return info.properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+			});
+		}
+		// the offscreen ring has no present to wait on and is the only path that can capture.
+		m_render.SetUseHeadlessSurface(false);
+
+		att::PlatformInfo::WindowHandle handle{};
+		handle.systemType = att::PlatformInfo::WindowSystemType::HEADLESS;
+		if (!m_render.Initialize(handle, m_options.width, m_options.height))
+		{
+			LOG_ERROR("Failed to initialize the renderer.");
+			return false;
+		}
+		LOG_INFO("Benchmark device: {0}", m_render.GetDeviceInfo().properties.deviceName);
+
+		if (!m_render.GetGpuProfiler().IsEnabled())
+		{
+			LOG_WARN("No GPU timestamps on this device, GPU metrics are skipped.");
+		}
+		return true;
+	}
+
+	bool FrameBenchmark::Run(BenchmarkResults& results)
+	{
+		att::RHI::VulkanGpuProfiler& gpuProfiler = m_render.GetGpuProfiler();
+		const uint64_t firstFrame = m_render.GetFrameNumber() + m_options.warmupFrames;
+		const uint64_t endFrame = firstFrame + m_options.frames;
+
+		std::vector<double> cpuFrameMs;
+		std::vector<double> gpuFrameMs;
+		std::map<std::string, std::vector<double>> gpuPassMs;
+		cpuFrameMs.reserve(m_options.frames);
+		gpuFrameMs.reserve(m_options.frames);
+
+		// each resolved GPU frame belongs to a frame MaxFramesInFlight back, skip the warmup ones.
+		gpuProfiler.SetFrameCallback([&](uint64_t frameNumber, const std::vector<att::RHI::GpuScopeResult>& scopes)
+		{
+			if (frameNumber < firstFrame || frameNumber >= endFrame)
+			{
+				return;
+			}
+			for (const att::RHI::GpuScopeResult& scope : scopes)
+			{
+				gpuPassMs[scope.name].push_back(scope.GetDurationMs());
+			}
+			gpuFrameMs.push_back(gpuProfiler.GetLastFrameMs());
+		});
+
+		// MaxFramesInFlight more frames resolve the timings of the last recorded ones.
+		const uint64_t totalFrames = endFrame + att::Config::MaxFramesInFlight;
+		uint64_t allocationsAtStart = 0;
+		uint64_t allocations = 0;
+		auto previous = std::chrono::steady_clock::now();
+
+		while (m_render.GetFrameNumber() < totalFrames)
+		{
+			const uint64_t frameNumber = m_render.GetFrameNumber();
+			if (frameNumber == firstFrame)
+			{
+				allocationsAtStart = GetAllocationCount();
+			}
+			if (!m_options.capturePath.empty() && frameNumber + 1 == endFrame)
+			{
+				m_render.CaptureNextFrame(m_options.capturePath);
+			}
+
+			m_render.RenderFrame();
+			if (m_render.GetFrameNumber() == frameNumber)
+			{
+				LOG_ERROR("Frame {0} was not submitted.", frameNumber);
+				gpuProfiler.SetFrameCallback(nullptr);
+				return false;
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			if (frameNumber >= firstFrame && frameNumber < endFrame)
+			{
+				cpuFrameMs.push_back(std::chrono::duration<double, std::milli>(now - previous).count());
+			}
+			if (frameNumber + 1 == endFrame)
+			{
+				allocations = GetAllocationCount() - allocationsAtStart;
+			}
+			previous = now;
+		}
+		gpuProfiler.SetFrameCallback(nullptr);
+
+		results.device = m_render.GetDeviceInfo().properties.deviceName;
+		results.frames = m_options.frames;
+		results.metrics["cpu_frame_ms_p50"] = Percentile(cpuFrameMs, 0.50);
+		results.metrics["cpu_frame_ms_p95"] = Percentile(cpuFrameMs, 0.95);
+		results.metrics["cpu_frame_ms_p99"] = Percentile(cpuFrameMs, 0.99);
+		results.metrics["allocations_per_frame"] = m_options.frames > 0 ? double(allocations) / m_options.frames : 0.0;
+		if (!gpuFrameMs.empty())
+		{
+			results.metrics["gpu_frame_ms_p50"] = Percentile(gpuFrameMs, 0.50);
+			results.metrics["gpu_frame_ms_p95"] = Percentile(gpuFrameMs, 0.95);
+		}
+		for (const auto& [name, samples] : gpuPassMs)
+		{
+			results.metrics["gpu_pass_ms_p50." + name] = Percentile(samples, 0.50);
+		}
+		// every recorded frame must come back from the GPU profiler, a lost frame is a sync bug.
+		results.checks["gpu_frames_resolved"] = gpuProfiler.IsEnabled() ? static_cast<double>(gpuFrameMs.size()) : 0.0;
+		return true;
+	}
+
+	void FrameBenchmark::Shutdown()
+	{
+		// writes a pending capture, safe to call more than once.
+		m_render.Cleanup();
+	}
+}
@@ -0,0 +1,143 @@
+#include <FrameBenchmark.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Logger/GUIConsole.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Runs headless on any Linux box through a software ICD, e.g.:
+//   VK_DRIVER_FILES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json
+//   FrameBenchmark --cpu-device --baseline baseline.json --output results.json
+//
+// exit codes: 0 = within tolerance, 1 = regression, 2 = setup failure.
+
+static void PrintUsage()
+{
+	std::cout <<
+		"FrameBenchmark [options]\n"
+		"  --frames N              recorded frames (600)\n"
+		"  --warmup N              unrecorded frames first (60)\n"
+		"  --size WxH              render size (1280x720)\n"
+		"  --cpu-device            only accept a CPU (software) Vulkan device\n"
+		"  --output FILE           write the results as JSON\n"
+		"  --baseline FILE         compare against a stored result file\n"
+		"  --tolerance [NAME=]F    allowed slowdown as a fraction, default 0.05 for every metric\n"
+		"  --capture FILE.png      write the last frame\n";
+}
+
+int main(int argc, char** argv)
+{
+	Common::LogManager::Get().Init();
+	Common::LogManager::Get().AddObserver(std::make_shared<Common::GUIConsole>());
+
+	Bench::BenchmarkOptions options;
+	std::string outputPath;
+	std::string baselinePath;
+	std::map<std::string, double> tolerances;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		auto takesValue = [&]()
+		{
+			if (value == nullptr)
+			{
+				std::cerr << arg << " needs a value" << std::endl;
+				std::exit(2);
+			}
+			i++;
+			return value;
+		};
+
+		if (strcmp(arg, "--frames") == 0)
+		{
+			options.frames = static_cast<uint32_t>(std::strtoul(takesValue(), nullptr, 10));
+		}
+		else if (strcmp(arg, "--warmup") == 0)
+		{
+			options.warmupFrames = static_cast<uint32_t>(std::strtoul(takesValue(), nullptr, 10));
+		}
+		else if (strcmp(arg, "--size") == 0)
+		{
+			char* end = nullptr;
+			options.width = static_cast<uint32_t>(std::strtoul(takesValue(), &end, 10));
+			options.height = (end && *end == 'x') ? static_cast<uint32_t>(std::strtoul(end + 1, nullptr, 10)) : options.width;
+		}
+		else if (strcmp(arg, "--cpu-device") == 0)
+		{
+			options.requireCpuDevice = true;
+		}
+		else if (strcmp(arg, "--output") == 0)
+		{
+			outputPath = takesValue();
+		}
+		else if (strcmp(arg, "--baseline") == 0)
+		{
+			baselinePath = takesValue();
+		}
+		else if (strcmp(arg, "--tolerance") == 0)
+		{
+			const std::string text = takesValue();
+			const size_t equals = text.find('=');
+			if (equals == std::string::npos)
+			{
+				tolerances["*"] = std::strtod(text.c_str(), nullptr);
+			}
+			else
+			{
+				tolerances[text.substr(0, equals)] = std::strtod(text.c_str() + equals + 1, nullptr);
+			}
+		}
+		else if (strcmp(arg, "--capture") == 0)
+		{
+			options.capturePath = takesValue();
+		}
+		else
+		{
+			PrintUsage();
+			return strcmp(arg, "--help") == 0 ? EXIT_SUCCESS : 2;
+		}
+	}
+
+	Bench::BenchmarkResults results;
+	{
+		Bench::FrameBenchmark benchmark;
+		if (!benchmark.Initialize(options) || !benchmark.Run(results))
+		{
+			LOG_ERROR("Frame benchmark failed to run.");
+			spdlog::shutdown();
+			return 2;
+		}
+	}
+
+	for (const auto& [name, value] : results.metrics)
+	{
+		LOG_INFO("{0}: {1}", name, value);
+	}
+
+	int exitCode = EXIT_SUCCESS;
+	if (!outputPath.empty() && !Bench::WriteResults(results, outputPath))
+	{
+		exitCode = 2;
+	}
+
+	if (!baselinePath.empty())
+	{
+		Bench::BenchmarkResults baseline;
+		if (!Bench::ReadResults(baselinePath, baseline))
+		{
+			exitCode = 2;
+		}
+		else if (const uint32_t regressions = Bench::CompareResults(results, baseline, tolerances); regressions > 0)
+		{
+			LOG_ERROR("{0} regression(s) against {1}.", regressions, baselinePath);
+			exitCode = 1;
+		}
+	}
+
+	// flush the async logger before leaving.
+	spdlog::shutdown();
+	return exitCode;
+}
@@ -0,0 +1,203 @@
+#include <benchmark/benchmark.h>
+#include <ANTUTU/Asset/Archive.hpp>
+#include <ANTUTU/Asset/ArchiveWriter.hpp>
+#include <ANTUTU/Asset/AssetStreamer.hpp>
+#include <Common/Job/JobSystem.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+	struct AssetSet
+	{
+		// loose files, and the same files packed.
+		std::vector<std::string> files;
+		std::vector<std::string> names;
+		std::string archive;
+		uint64_t largest = 0;
+	};
+
+	// written once per process. Large: 256 files of 64 KB to 1 MB, like meshes and textures.
+	// Small: 2048 files of 4 to 16 KB, like materials, shaders and prefabs at startup.
+	static const AssetSet& GetAssetSet(bool small)
+	{
+		static AssetSet sets[2];
+		AssetSet& set = sets[small ? 1 : 0];
+		if (!set.files.empty())
+		{
+			return set;
+		}
+
+		const std::filesystem::path dir = std::filesystem::temp_directory_path() / (small ? "antutu_asset_bench_small" : "antutu_asset_bench");
+		std::filesystem::create_directories(dir);
+		std::vector<uint8_t> bytes(1u << 20);
+		for (size_t i = 0; i < bytes.size(); i++)
+		{
+			bytes[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+		}
+
+		att::Asset::ArchiveWriter writer;
+		set.archive = (dir / "assets.apak").string();
+		writer.Open(set.archive);
+		const uint32_t count = small ? 2048 : 256;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const size_t size = small ? (4u << 10) + (i * 7919u % 13u) * (1u << 10)
+									  : (64u << 10) + (i * 7919u % 16u) * (60u << 10);
+			const std::string name = "asset" + std::to_string(i) + ".bin";
+			const std::string path = (dir / name).string();
+			if (FILE* file = std::fopen(path.c_str(), "wb"))
+			{
+				std::fwrite(bytes.data(), 1, size, file);
+				std::fclose(file);
+				writer.Add(name, bytes.data(), size);
+				set.files.push_back(path);
+				set.names.push_back(name);
+				set.largest = std::max<uint64_t>(set.largest, size);
+			}
+		}
+		writer.Finish();
+		return set;
+	}
+
+	static void* DecodeChecksum(void*, const uint8_t* data, uint64_t size, uint64_t)
+	{
+		uint64_t sum = 0;
+		for (uint64_t i = 0; i < size; i += 4096)
+		{
+			sum += data[i];
+		}
+		return reinterpret_cast<void*>(static_cast<uintptr_t>(sum | 1));
+	}
+
+	static void ReleaseNothing(void*, void*) {}
+
+	// Args: io_uring (0 = pread), chunk size in KB. Every iteration streams the whole set
+	// (page cache warm after the first), the counters are the streamer's own stats.
+	static void BM_Asset_Stream(benchmark::State& state)
+	{
+		Common::JobSystem::Get().Shutdown();
+		Common::JobSystem::Get().Initialize(0);
+		const std::vector<std::string>& files = GetAssetSet(false).files;
+
+		att::Asset::StreamerConfig config;
+		config.allowIoUring = state.range(0) != 0;
+		config.chunkSize = static_cast<uint32_t>(state.range(1)) << 10;
+
+		att::Asset::AssetStreamer streamer;
+		streamer.Initialize(config);
+		streamer.RegisterLoader(0, { &DecodeChecksum, nullptr, &ReleaseNothing, nullptr });
+		state.SetLabel(streamer.GetBackendName());
+
+		std::vector<att::Asset::AssetHandle> handles;
+		for (auto _ : state)
+		{
+			for (uint32_t i = 0; i < files.size(); i++)
+			{
+				handles.push_back(streamer.Load(files[i], 0, static_cast<float>(i)));
+			}
+			streamer.Flush();
+
+			state.PauseTiming();
+			for (const att::Asset::AssetHandle handle : handles)
+			{
+				streamer.Unload(handle);
+			}
+			handles.clear();
+			state.ResumeTiming();
+		}
+		const uint64_t bytes = streamer.GetStats().bytesRead;
+
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+		state.counters["MBps_io"] = streamer.GetStats().throughputMBps;
+		state.counters["batch_ms"] = streamer.GetStats().lastBatchMs;
+		streamer.Shutdown();
+	}
+	BENCHMARK(BM_Asset_Stream)
+		->Args({ 0, 1024 })
+		->Args({ 1, 1024 })
+		->Args({ 1, 256 })
+		->Unit(benchmark::kMillisecond)
+		->UseRealTime();
+
+	// Arg: small files. Startup without the streamer: every asset into a staging buffer,
+	// an open / read / close per file.
+	static void BM_Asset_LooseRead(benchmark::State& state)
+	{
+		const AssetSet& set = GetAssetSet(state.range(0) != 0);
+		std::vector<uint8_t> staging(set.largest);
+		for (auto _ : state)
+		{
+			for (const std::string& path : set.files)
+			{
+				std::FILE* file = std::fopen(path.c_str(), "rb");
+				benchmark::DoNotOptimize(std::fread(staging.data(), 1, staging.size(), file));
+				std::fclose(file);
+			}
+		}
+		state.counters["files_opened"] = static_cast<double>(set.files.size());
+	}
+	BENCHMARK(BM_Asset_LooseRead)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	// Arg: small files. The same from the archive: one open and map, then a lookup and a
+	// memcpy per asset.
+	static void BM_Asset_ArchiveRead(benchmark::State& state)
+	{
+		const AssetSet& set = GetAssetSet(state.range(0) != 0);
+		std::vector<uint8_t> staging(set.largest);
+		for (auto _ : state)
+		{
+			att::Asset::Archive archive;
+			archive.Open(set.archive.c_str());
+			for (const std::string& name : set.names)
+			{
+				const att::Asset::ArchiveEntry* entry = archive.Find(name);
+				archive.Read(*entry, staging.data());
+				benchmark::DoNotOptimize(staging.data());
+			}
+		}
+		state.counters["files_opened"] = 1.0;
+	}
+	BENCHMARK(BM_Asset_ArchiveRead)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	// BM_Asset_Stream with the set mounted from the archive: no reads, the decode jobs
+	// work on the mapping.
+	static void BM_Asset_StreamArchive(benchmark::State& state)
+	{
+		Common::JobSystem::Get().Shutdown();
+		Common::JobSystem::Get().Initialize(0);
+		const AssetSet& set = GetAssetSet(false);
+
+		att::Asset::Archive archive;
+		archive.Open(set.archive.c_str());
+		att::Asset::AssetStreamer streamer;
+		streamer.Initialize();
+		streamer.RegisterLoader(0, { &DecodeChecksum, nullptr, &ReleaseNothing, nullptr });
+		streamer.Mount(archive);
+
+		std::vector<att::Asset::AssetHandle> handles;
+		for (auto _ : state)
+		{
+			for (uint32_t i = 0; i < set.names.size(); i++)
+			{
+				handles.push_back(streamer.Load(set.names[i], 0, static_cast<float>(i)));
+			}
+			streamer.Flush();
+
+			state.PauseTiming();
+			for (const att::Asset::AssetHandle handle : handles)
+			{
+				streamer.Unload(handle);
+			}
+			handles.clear();
+			state.ResumeTiming();
+		}
+		state.counters["batch_ms"] = streamer.GetStats().lastBatchMs;
+		streamer.Shutdown();
+	}
+	BENCHMARK(BM_Asset_StreamArchive)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include <Common/Base/ShareContainer.h>
+#include <Common/Base/ShareContextBase.h>
+#include <Common/Base/AnString.h>
+
+#include <queue>
+#include <stack>
+#include <string>
+
+namespace Bench
+{
+	// ShareContainer: every thread pushes then pops, so all of them fight for the one mutex.
+	template<typename Container>
+	static void BM_ShareContainer_PushPop(benchmark::State& state)
+	{
+		static Common::ShareContainer<Container> container;
+
+		int value = 0;
+		int popped = 0;
+		for (auto _ : state)
+		{
+			container.Push(value++);
+			container.TryPop(popped);
+			benchmark::DoNotOptimize(popped);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(BM_ShareContainer_PushPop, std::queue<int>)->ThreadRange(1, 16)->UseRealTime();
+	BENCHMARK_TEMPLATE(BM_ShareContainer_PushPop, std::stack<int>)->ThreadRange(1, 16)->UseRealTime();
+
+	// one producer (thread 0) against N - 1 consumers, the empty TryPop path included.
+	static void BM_ShareContainer_ProducerConsumer(benchmark::State& state)
+	{
+		static Common::ShareContainer<std::queue<int>> container;
+
+		const bool producer = state.thread_index() == 0;
+		int value = 0;
+		int64_t hits = 0;
+		for (auto _ : state)
+		{
+			if (producer)
+			{
+				container.Push(value++);
+			}
+			else
+			{
+				hits += container.TryPop(value) ? 1 : 0;
+			}
+		}
+		state.counters["pop_hit_rate"] = benchmark::Counter(static_cast<double>(hits),
+			benchmark::Counter::kAvgIterations);
+	}
+	BENCHMARK(BM_ShareContainer_ProducerConsumer)->ThreadRange(2, 16)->UseRealTime();
+
+	// ShareContextBase: readers only, the shared_lock cache line is the limit.
+	static void BM_ShareContextBase_Get(benchmark::State& state)
+	{
+		static Common::ShareContextBase<uint64_t> context(42);
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(context.GetValue());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_ShareContextBase_Get)->ThreadRange(1, 16)->UseRealTime();
+
+	// same with thread 0 writing every iteration.
+	static void BM_ShareContextBase_GetWithWriter(benchmark::State& state)
+	{
+		static Common::ShareContextBase<uint64_t> context(42);
+
+		const bool writer = state.thread_index() == 0;
+		uint64_t value = 0;
+		for (auto _ : state)
+		{
+			if (writer)
+			{
+				context.SetValue(value++);
+			}
+			else
+			{
+				benchmark::DoNotOptimize(context.GetValue());
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_ShareContextBase_GetWithWriter)->ThreadRange(2, 16)->UseRealTime();
+
+	// AnString is not copyable (it owns a shared_mutex), the copy that matters is the
+	// std::string GetValue hands out. 15 bytes and below stays in the small string buffer.
+	static void BM_AnString_GetValue(benchmark::State& state)
+	{
+		Common::AnString text(std::string(static_cast<size_t>(state.range(0)), 'a'));
+
+		for (auto _ : state)
+		{
+			std::string copy = text.GetValue();
+			benchmark::DoNotOptimize(copy.data());
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_AnString_GetValue)->RangeMultiplier(4)->Range(8, 4096);
+
+	static void BM_AnString_SetValue(benchmark::State& state)
+	{
+		Common::AnString text;
+		const std::string value(static_cast<size_t>(state.range(0)), 'a');
+
+		for (auto _ : state)
+		{
+			text.SetValue(value);
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_AnString_SetValue)->RangeMultiplier(4)->Range(8, 4096);
+
+	static void BM_AnString_GetValueContended(benchmark::State& state)
+	{
+		static Common::AnString text(std::string("antutu.frame.name"));
+
+		for (auto _ : state)
+		{
+			std::string copy = text.GetValue();
+			benchmark::DoNotOptimize(copy.data());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_AnString_GetValueContended)->ThreadRange(1, 16)->UseRealTime();
+}
@@ -0,0 +1,291 @@
+#include <benchmark/benchmark.h>
+#include <ANTUTU/Render/FrustumCuller.hpp>
+#include <ANTUTU/Render/OcclusionRasterizer.hpp>
+#include <Common/Job/JobSystem.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+namespace Bench
+{
+	// objects spread over a square world, small ones like props and foliage.
+	static void PopulateCuller(att::Render::FrustumCuller& culler, std::vector<att::Render::CullHandle>& handles,
+		std::vector<glm::vec3>& centers, uint32_t count)
+	{
+		std::mt19937 rng(1423);
+		const float half = std::sqrt(static_cast<float>(count)) * 2.0f;
+		std::uniform_real_distribution<float> position(-half, half);
+		std::uniform_real_distribution<float> height(0.0f, 20.0f);
+		std::uniform_real_distribution<float> size(0.2f, 2.0f);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const glm::vec3 center(position(rng), height(rng), position(rng));
+			const glm::vec3 extent(size(rng));
+			handles.push_back(culler.Add(center - extent, center + extent));
+			centers.push_back(center);
+		}
+		culler.Refit();
+	}
+
+	// the main camera plus shadow-cascade-like views along the same direction.
+	static std::vector<att::Math::FrustumPlanes> MakeViews(uint32_t viewCount, uint32_t objectCount)
+	{
+		const float far = std::sqrt(static_cast<float>(objectCount)) * 1.5f;
+		const glm::vec3 eye(0.0f, 10.0f, 0.0f);
+		const glm::mat4 view = glm::lookAt(eye, eye + glm::vec3(1.0f, -0.1f, 0.3f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		std::vector<att::Math::FrustumPlanes> views;
+		for (uint32_t v = 0; v < viewCount; v++)
+		{
+			const float cascadeFar = far * static_cast<float>(v + 1) / static_cast<float>(viewCount);
+			const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, cascadeFar);
+			views.push_back(att::Math::FrustumPlanes::FromViewProjection(projection * view));
+		}
+		return views;
+	}
+
+	static void SetWorkers(uint32_t workers)
+	{
+		Common::JobSystem::Get().Shutdown();
+		Common::JobSystem::Get().Initialize(workers);
+	}
+
+	// Args: object count, view count, worker count.
+	static void BM_Culling_Bvh(benchmark::State& state)
+	{
+		SetWorkers(static_cast<uint32_t>(state.range(2)));
+		const uint32_t count = static_cast<uint32_t>(state.range(0));
+		const uint32_t viewCount = static_cast<uint32_t>(state.range(1));
+
+		att::Render::FrustumCuller culler;
+		std::vector<att::Render::CullHandle> handles;
+		std::vector<glm::vec3> centers;
+		PopulateCuller(culler, handles, centers, count);
+		const std::vector<att::Math::FrustumPlanes> views = MakeViews(viewCount, count);
+		std::vector<std::vector<att::Render::CullHandle>> visible(viewCount);
+
+		for (auto _ : state)
+		{
+			culler.Cull(views.data(), viewCount, visible.data());
+			benchmark::DoNotOptimize(visible.data());
+		}
+		state.counters["visible"] = culler.GetStats().visibleCount;
+		state.counters["leaves"] = culler.GetStats().leavesTested;
+		state.counters["inside"] = culler.GetStats().leavesInside;
+		state.SetItemsProcessed(state.iterations() * count * viewCount);
+	}
+	BENCHMARK(BM_Culling_Bvh)
+		->ArgsProduct({ { 100000, 1000000 }, { 1, 4 }, { 0, 3 } })
+		->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+	// every object through the batch kernel, what the BVH saves us from.
+	static void BM_Culling_BruteForce(benchmark::State& state)
+	{
+		const uint32_t count = static_cast<uint32_t>(state.range(0));
+		std::mt19937 rng(1423);
+		const float half = std::sqrt(static_cast<float>(count)) * 2.0f;
+		std::uniform_real_distribution<float> position(-half, half);
+		std::uniform_real_distribution<float> height(0.0f, 20.0f);
+		std::uniform_real_distribution<float> size(0.2f, 2.0f);
+		std::vector<float> data[6];
+		for (uint32_t i = 0; i < count; i++)
+		{
+			data[0].push_back(position(rng));
+			data[1].push_back(height(rng));
+			data[2].push_back(position(rng));
+			const float extent = size(rng);
+			data[3].push_back(extent);
+			data[4].push_back(extent);
+			data[5].push_back(extent);
+		}
+
+		const att::Math::FrustumPlanes frustum = MakeViews(1, count)[0];
+		std::vector<uint32_t> visible(count);
+		uint32_t visibleCount = 0;
+		for (auto _ : state)
+		{
+			visibleCount = att::Math::CullBoxes(frustum,
+				{ { data[0].data(), data[1].data(), data[2].data() }, { data[3].data(), data[4].data(), data[5].data() } },
+				count, visible.data());
+			benchmark::DoNotOptimize(visibleCount);
+		}
+		state.counters["visible"] = visibleCount;
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(BM_Culling_BruteForce)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+	// 10% of the objects wander around their spawn point every frame, then the single view is culled.
+	static void BM_Culling_RefitAndCull(benchmark::State& state)
+	{
+		SetWorkers(0);
+		const uint32_t count = static_cast<uint32_t>(state.range(0));
+		att::Render::FrustumCuller culler;
+		std::vector<att::Render::CullHandle> handles;
+		std::vector<glm::vec3> centers;
+		PopulateCuller(culler, handles, centers, count);
+		const std::vector<att::Math::FrustumPlanes> views = MakeViews(1, count);
+		std::vector<att::Render::CullHandle> visible;
+
+		std::mt19937 rng(7);
+		std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+		uint32_t frame = 0;
+		for (auto _ : state)
+		{
+			for (uint32_t i = frame % 10; i < count; i += 10)
+			{
+				const glm::vec3 center = centers[i] + glm::vec3(jitter(rng), 0.0f, jitter(rng));
+				culler.SetBounds(handles[i], center - glm::vec3(0.5f), center + glm::vec3(0.5f));
+			}
+			culler.Refit();
+			culler.Cull(views.data(), 1, &visible);
+			frame++;
+		}
+		state.counters["rebuilds"] = culler.GetStats().rebuilds;
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(BM_Culling_RefitAndCull)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+	// unit cube, the shape of most occluder proxies (building shells, walls).
+	static const glm::vec3 CubeVertices[8] = {
+		{ -0.5f, -0.5f, -0.5f }, { 0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, -0.5f }, { -0.5f, 0.5f, -0.5f },
+		{ -0.5f, -0.5f, 0.5f }, { 0.5f, -0.5f, 0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, 0.5f, 0.5f }
+	};
+	static const uint32_t CubeIndices[36] = {
+		0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+		3, 6, 2, 3, 7, 6, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5
+	};
+
+	// a city block grid seen from street level: buildings as occluders, props as occludees.
+	struct OcclusionScene
+	{
+		glm::mat4 viewProjection;
+		std::vector<glm::mat4> buildings;
+		std::vector<glm::vec3> propMin;
+		std::vector<glm::vec3> propMax;
+	};
+
+	static OcclusionScene MakeOcclusionScene(uint32_t buildingCount, uint32_t propCount)
+	{
+		OcclusionScene scene;
+		const glm::vec3 eye(0.0f, 2.0f, 0.0f);
+		scene.viewProjection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f) *
+			glm::lookAt(eye, eye + glm::vec3(0.3f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		std::mt19937 rng(1423);
+		std::uniform_real_distribution<float> lateral(-200.0f, 200.0f);
+		std::uniform_real_distribution<float> depth(-400.0f, -10.0f);
+		std::uniform_real_distribution<float> size(5.0f, 25.0f);
+		for (uint32_t i = 0; i < buildingCount; i++)
+		{
+			const glm::vec3 scale(size(rng), size(rng) * 2.0f, size(rng));
+			const glm::vec3 position(lateral(rng), scale.y * 0.5f, depth(rng));
+			scene.buildings.push_back(glm::scale(glm::translate(glm::mat4(1.0f), position), scale));
+		}
+		for (uint32_t i = 0; i < propCount; i++)
+		{
+			const glm::vec3 center(lateral(rng), 1.0f, depth(rng));
+			scene.propMin.push_back(center - glm::vec3(1.0f));
+			scene.propMax.push_back(center + glm::vec3(1.0f));
+		}
+		return scene;
+	}
+
+	// Args: building count, worker count.
+	static void BM_Occlusion_Rasterize(benchmark::State& state)
+	{
+		SetWorkers(static_cast<uint32_t>(state.range(1)));
+		const OcclusionScene scene = MakeOcclusionScene(static_cast<uint32_t>(state.range(0)), 0);
+
+		att::Render::OcclusionRasterizer rasterizer;
+		rasterizer.Initialize(256, 128);
+		for (auto _ : state)
+		{
+			rasterizer.BeginFrame(scene.viewProjection);
+			for (const glm::mat4& model : scene.buildings)
+			{
+				rasterizer.AddOccluder(CubeVertices, 8, CubeIndices, 36, model);
+			}
+			rasterizer.Rasterize();
+			benchmark::DoNotOptimize(rasterizer.GetDepth());
+		}
+		state.counters["triangles"] = rasterizer.GetStats().trianglesRasterized;
+		state.SetItemsProcessed(state.iterations() * rasterizer.GetStats().trianglesSubmitted);
+	}
+	BENCHMARK(BM_Occlusion_Rasterize)
+		->ArgsProduct({ { 64, 512 }, { 0, 3 } })
+		->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+	// Args: prop count.
+	static void BM_Occlusion_Filter(benchmark::State& state)
+	{
+		SetWorkers(0);
+		const uint32_t count = static_cast<uint32_t>(state.range(0));
+		const OcclusionScene scene = MakeOcclusionScene(512, count);
+
+		att::Render::OcclusionRasterizer rasterizer;
+		rasterizer.Initialize(256, 128);
+		rasterizer.BeginFrame(scene.viewProjection);
+		for (const glm::mat4& model : scene.buildings)
+		{
+			rasterizer.AddOccluder(CubeVertices, 8, CubeIndices, 36, model);
+		}
+		rasterizer.Rasterize();
+
+		std::vector<uint32_t> indices(count);
+		uint32_t visibleCount = 0;
+		for (auto _ : state)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				indices[i] = i;
+			}
+			visibleCount = rasterizer.FilterVisible(scene.propMin.data(), scene.propMax.data(), indices.data(), count);
+			benchmark::DoNotOptimize(visibleCount);
+		}
+		state.counters["visible"] = visibleCount;
+		state.SetItemsProcessed(state.iterations() * count);
+	}
+	BENCHMARK(BM_Occlusion_Filter)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+	// two triangle wall, the diagonal is the edge both have to cover.
+	static const glm::vec3 WallVertices[4] = {
+		{ -2.0f, -2.0f, 0.0f }, { 2.0f, -2.0f, 0.0f }, { 2.0f, 2.0f, 0.0f }, { -2.0f, 2.0f, 0.0f }
+	};
+	static const uint32_t WallIndices[6] = { 0, 1, 2, 0, 2, 3 };
+
+	// a wall 10 units ahead, slid by fractions of a pixel every frame: a box right behind it must
+	// always be occluded and one in front of it never. Fails the run on any crack along the shared edge.
+	static void BM_Occlusion_WallCheck(benchmark::State& state)
+	{
+		SetWorkers(0);
+		const glm::mat4 viewProjection = glm::perspectiveRH_ZO(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+
+		att::Render::OcclusionRasterizer rasterizer;
+		rasterizer.Initialize(256, 128);
+		uint32_t frame = 0;
+		for (auto _ : state)
+		{
+			const float slide = static_cast<float>(frame++ % 64) * 0.005f - 0.16f;
+			const glm::vec3 offset(slide, slide * 0.7f, -10.0f);
+			rasterizer.BeginFrame(viewProjection);
+			rasterizer.AddOccluder(WallVertices, 4, WallIndices, 6, glm::translate(glm::mat4(1.0f), offset));
+			rasterizer.Rasterize();
+
+			const glm::vec3 center(offset.x, offset.y, 0.0f);
+			if (!rasterizer.IsOccluded(center + glm::vec3(-0.5f, -0.5f, -21.0f), center + glm::vec3(0.5f, 0.5f, -19.0f)))
+			{
+				state.SkipWithError("box behind the wall is not occluded");
+				break;
+			}
+			if (rasterizer.IsOccluded(center + glm::vec3(-0.5f, -0.5f, -6.0f), center + glm::vec3(0.5f, 0.5f, -5.0f)))
+			{
+				state.SkipWithError("box in front of the wall is occluded");
+				break;
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_Occlusion_WallCheck)->Unit(benchmark::kMicrosecond);
+}
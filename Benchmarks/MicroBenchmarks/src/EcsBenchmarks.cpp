@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <ANTUTU/ECS/Query.hpp>
+
+namespace Bench
+{
+	struct Position
+	{
+		ATT_COMPONENT(Position);
+		float x, y, z;
+	};
+
+	struct Velocity
+	{
+		ATT_COMPONENT(Velocity);
+		float x, y, z;
+	};
+
+	struct Health
+	{
+		ATT_COMPONENT(Health);
+		float value;
+	};
+
+	// three archetypes sharing Position / Velocity, like a real scene.
+	static void Populate(att::ECS::World& world, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const float f = static_cast<float>(i);
+			switch (i % 3)
+			{
+			case 0: world.Create(Position{ f, 0.0f, 0.0f }, Velocity{ 1.0f, 0.5f, 0.25f }); break;
+			case 1: world.Create(Position{ f, 0.0f, 0.0f }, Velocity{ 1.0f, 0.5f, 0.25f }, Health{ 100.0f }); break;
+			default: world.Create(Position{ f, 0.0f, 0.0f }); break;
+			}
+		}
+	}
+
+	static void BM_Ecs_Each(benchmark::State& state)
+	{
+		att::ECS::World world;
+		Populate(world, static_cast<uint32_t>(state.range(0)));
+		att::ECS::Query<const Velocity, Position> query(world);
+
+		const float dt = 1.0f / 60.0f;
+		for (auto _ : state)
+		{
+			query.Each([dt](const Velocity& v, Position& p)
+			{
+				p.x += v.x * dt;
+				p.y += v.y * dt;
+				p.z += v.z * dt;
+			});
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * query.Count());
+	}
+	BENCHMARK(BM_Ecs_Each)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+	// Arg 1 is the worker count of the job system, the calling thread works as well.
+	static void BM_Ecs_ParallelEach(benchmark::State& state)
+	{
+		Common::JobSystem::Get().Shutdown();
+		Common::JobSystem::Get().Initialize(static_cast<uint32_t>(state.range(1)));
+
+		att::ECS::World world;
+		Populate(world, static_cast<uint32_t>(state.range(0)));
+		att::ECS::Query<const Velocity, Position> query(world);
+
+		const float dt = 1.0f / 60.0f;
+		for (auto _ : state)
+		{
+			query.ParallelEach([dt](const Velocity& v, Position& p)
+			{
+				p.x += v.x * dt;
+				p.y += v.y * dt;
+				p.z += v.z * dt;
+			}, 8);
+		}
+		state.SetItemsProcessed(state.iterations() * query.Count());
+		Common::JobSystem::Get().Shutdown();
+	}
+	BENCHMARK(BM_Ecs_ParallelEach)->ArgsProduct({ { 1 << 20 }, { 1, 3, 7, 15 } })->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	// structural cost: create and destroy a batch.
+	static void BM_Ecs_CreateDestroy(benchmark::State& state)
+	{
+		att::ECS::World world;
+		std::vector<att::ECS::Entity> entities(static_cast<size_t>(state.range(0)));
+		for (auto _ : state)
+		{
+			for (auto& entity : entities)
+			{
+				entity = world.Create(Position{}, Velocity{});
+			}
+			for (auto& entity : entities)
+			{
+				world.Destroy(entity);
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Ecs_CreateDestroy)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include <Common/Logger/ObserverSink.h>
+#include <Common/Logger/FileLogObserver.h>
+#include <spdlog/logger.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+	class CountingObserver : public Common::ILogObserver
+	{
+	public:
+		void OnLogReceived(const std::string& msg) override
+		{
+			m_bytes.fetch_add(msg.size(), std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<size_t> m_bytes{ 0 };
+	};
+
+	// ObserverSink: format once, then one virtual call per observer under the observer mutex.
+	// Arg 0 is the observer count, the thread sweep shows the sink mutex on top of it.
+	static void BM_ObserverSink_FanOut(benchmark::State& state)
+	{
+		static std::shared_ptr<spdlog::logger> logger;
+		static std::vector<std::shared_ptr<CountingObserver>> observers;
+
+		if (state.thread_index() == 0)
+		{
+			auto sink = std::make_shared<Common::ObserverSink_mt>();
+			observers.clear();
+			for (int64_t i = 0; i < state.range(0); i++)
+			{
+				observers.push_back(std::make_shared<CountingObserver>());
+				sink->AddObserver(observers.back());
+			}
+			logger = std::make_shared<spdlog::logger>("bench", sink);
+			logger->set_pattern("[%T.%e] [%l] %v");
+		}
+
+		for (auto _ : state)
+		{
+			logger->info("frame {0} took {1} ms", 1423, 16.6);
+		}
+		state.SetItemsProcessed(state.iterations());
+
+		if (state.thread_index() == 0)
+		{
+			logger.reset();
+		}
+	}
+	BENCHMARK(BM_ObserverSink_FanOut)->RangeMultiplier(4)->Range(1, 64)->ThreadRange(1, 8)->UseRealTime();
+
+	static fs::path BenchLogPath(const char* name)
+	{
+		const fs::path dir = fs::temp_directory_path() / "antutu_bench";
+		std::error_code ec;
+		fs::remove_all(dir, ec);
+		return dir / name;
+	}
+
+	// FileLogObserver: enqueue a burst and wait for the worker to write it out, the
+	// destructor drains the queue so the timed region covers the whole trip to disk.
+	// Real time, most of the work happens on the observer's worker thread.
+	// Arg 0 is the message size; the file limit is high enough that it never rotates.
+	static void BM_FileLogObserver_Throughput(benchmark::State& state)
+	{
+		constexpr int64_t burst = 10000;
+		const std::string message(static_cast<size_t>(state.range(0)) - 1, 'a');
+		const std::string line = message + "\n";
+		const fs::path path = BenchLogPath("throughput.log");
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			auto observer = std::make_unique<Common::FileLogObserver>(path, size_t(1) << 40, 1);
+			state.ResumeTiming();
+
+			for (int64_t i = 0; i < burst; i++)
+			{
+				observer->OnLogReceived(line);
+			}
+			observer.reset();
+		}
+		state.SetItemsProcessed(state.iterations() * burst);
+		state.SetBytesProcessed(state.iterations() * burst * state.range(0));
+	}
+	BENCHMARK(BM_FileLogObserver_Throughput)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+	// same burst with a small file limit, so the worker rotates through the backups.
+	// Compare with the throughput run at the same size: the difference is the rotation cost,
+	// "rotations" is how many happened per burst.
+	static void BM_FileLogObserver_Rotation(benchmark::State& state)
+	{
+		constexpr int64_t burst = 10000;
+		constexpr int64_t messageSize = 256;
+		const size_t maxFileSize = static_cast<size_t>(state.range(0));
+		const std::string line = std::string(messageSize - 1, 'a') + "\n";
+		const fs::path path = BenchLogPath("rotation.log");
+
+		for (auto _ : state)
+		{
+			state.PauseTiming();
+			auto observer = std::make_unique<Common::FileLogObserver>(path, maxFileSize, 4);
+			state.ResumeTiming();
+
+			for (int64_t i = 0; i < burst; i++)
+			{
+				observer->OnLogReceived(line);
+			}
+			observer.reset();
+		}
+
+		// the observer counts a message as length + 1 bytes.
+		const double rotations = static_cast<double>(burst * (messageSize + 1) / static_cast<int64_t>(maxFileSize));
+		state.counters["rotations"] = rotations;
+		state.SetItemsProcessed(state.iterations() * burst);
+	}
+	BENCHMARK(BM_FileLogObserver_Rotation)->RangeMultiplier(4)->Range(16 << 10, 1 << 20)->Unit(benchmark::kMillisecond)->UseRealTime();
+}
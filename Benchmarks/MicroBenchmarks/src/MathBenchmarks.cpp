@@ -0,0 +1,257 @@
+#include <benchmark/benchmark.h>
+#include <ANTUTU/Math/BatchKernels.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cfloat>
+#include <random>
+#include <vector>
+
+namespace Bench
+{
+	// the same random data in both layouts, glm gets its natural array of structs.
+	struct MathData
+	{
+		std::vector<glm::vec3> points;
+		std::vector<glm::vec4> spheres;
+		std::vector<float> x, y, z, radius;
+		std::vector<float> outX, outY, outZ;
+		std::vector<uint32_t> visible;
+
+		explicit MathData(uint32_t count)
+		{
+			std::mt19937 rng(1423);
+			std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> size(0.1f, 4.0f);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const glm::vec3 p(position(rng), position(rng), position(rng));
+				const float r = size(rng);
+				points.push_back(p);
+				spheres.emplace_back(p, r);
+				x.push_back(p.x);
+				y.push_back(p.y);
+				z.push_back(p.z);
+				radius.push_back(r);
+			}
+			outX.resize(count);
+			outY.resize(count);
+			outZ.resize(count);
+			visible.resize(count);
+		}
+	};
+
+	static glm::mat4 TestMatrix()
+	{
+		return glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f)) *
+			glm::rotate(glm::mat4(1.0f), 0.7f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)));
+	}
+
+	static att::Math::FrustumPlanes TestFrustum()
+	{
+		const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+		const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, -120.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		return att::Math::FrustumPlanes::FromViewProjection(projection * view);
+	}
+
+	// Arg 1 is the att::Math::SimdLevel, levels the CPU lacks are skipped.
+	static bool SelectLevel(benchmark::State& state)
+	{
+		const auto wanted = static_cast<att::Math::SimdLevel>(state.range(1));
+		if (att::Math::SetSimdLevel(wanted) != wanted)
+		{
+			state.SkipWithError("SIMD level not supported on this CPU");
+			return false;
+		}
+		state.SetLabel(att::Math::GetBatchKernels().name);
+		return true;
+	}
+
+	static void BM_Math_TransformPoints_Glm(benchmark::State& state)
+	{
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		std::vector<glm::vec3> out(data.points.size());
+		const glm::mat4 m = TestMatrix();
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < data.points.size(); i++)
+			{
+				out[i] = glm::vec3(m * glm::vec4(data.points[i], 1.0f));
+			}
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_TransformPoints_Glm)->Arg(1 << 16);
+
+	static void BM_Math_TransformPoints(benchmark::State& state)
+	{
+		if (!SelectLevel(state))
+		{
+			return;
+		}
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		const glm::mat4 m = TestMatrix();
+		for (auto _ : state)
+		{
+			att::Math::TransformPoints(m, { data.x.data(), data.y.data(), data.z.data() },
+				{ data.outX.data(), data.outY.data(), data.outZ.data() }, static_cast<uint32_t>(data.x.size()));
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_TransformPoints)->ArgsProduct({ { 1 << 16 }, { 0, 1, 2, 3 } });
+
+	static void BM_Math_TransformNormals_Glm(benchmark::State& state)
+	{
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		std::vector<glm::vec3> out(data.points.size());
+		const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(TestMatrix())));
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < data.points.size(); i++)
+			{
+				out[i] = glm::normalize(normalMatrix * data.points[i]);
+			}
+			benchmark::DoNotOptimize(out.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_TransformNormals_Glm)->Arg(1 << 16);
+
+	static void BM_Math_TransformNormals(benchmark::State& state)
+	{
+		if (!SelectLevel(state))
+		{
+			return;
+		}
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		const glm::mat4 m = TestMatrix();
+		for (auto _ : state)
+		{
+			att::Math::TransformNormals(m, { data.x.data(), data.y.data(), data.z.data() },
+				{ data.outX.data(), data.outY.data(), data.outZ.data() }, static_cast<uint32_t>(data.x.size()));
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_TransformNormals)->ArgsProduct({ { 1 << 16 }, { 0, 1, 2, 3 } });
+
+	// boxes are the points grown by the radius, the glm side transforms all eight corners.
+	static void BM_Math_TransformAabbs_Glm(benchmark::State& state)
+	{
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		std::vector<glm::vec3> outMin(data.points.size()), outMax(data.points.size());
+		const glm::mat4 m = TestMatrix();
+		for (auto _ : state)
+		{
+			for (size_t i = 0; i < data.points.size(); i++)
+			{
+				const glm::vec3 lo = data.points[i] - data.radius[i];
+				const glm::vec3 hi = data.points[i] + data.radius[i];
+				glm::vec3 resultMin(FLT_MAX), resultMax(-FLT_MAX);
+				for (int corner = 0; corner < 8; corner++)
+				{
+					const glm::vec3 p((corner & 1) ? hi.x : lo.x, (corner & 2) ? hi.y : lo.y, (corner & 4) ? hi.z : lo.z);
+					const glm::vec3 t = glm::vec3(m * glm::vec4(p, 1.0f));
+					resultMin = glm::min(resultMin, t);
+					resultMax = glm::max(resultMax, t);
+				}
+				outMin[i] = resultMin;
+				outMax[i] = resultMax;
+			}
+			benchmark::DoNotOptimize(outMin.data());
+			benchmark::DoNotOptimize(outMax.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_TransformAabbs_Glm)->Arg(1 << 16);
+
+	static void BM_Math_TransformAabbs(benchmark::State& state)
+	{
+		if (!SelectLevel(state))
+		{
+			return;
+		}
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		const size_t count = data.x.size();
+		std::vector<float> bounds[6];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const std::vector<float>& center = axis == 0 ? data.x : axis == 1 ? data.y : data.z;
+			bounds[axis].resize(count);
+			bounds[axis + 3].resize(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				bounds[axis][i] = center[i] - data.radius[i];
+				bounds[axis + 3][i] = center[i] + data.radius[i];
+			}
+		}
+		std::vector<float> outMax[3] = { std::vector<float>(count), std::vector<float>(count), std::vector<float>(count) };
+
+		const glm::mat4 m = TestMatrix();
+		for (auto _ : state)
+		{
+			att::Math::TransformAabbs(m,
+				{ { bounds[0].data(), bounds[1].data(), bounds[2].data() }, { bounds[3].data(), bounds[4].data(), bounds[5].data() } },
+				{ { data.outX.data(), data.outY.data(), data.outZ.data() }, { outMax[0].data(), outMax[1].data(), outMax[2].data() } },
+				static_cast<uint32_t>(count));
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_TransformAabbs)->ArgsProduct({ { 1 << 16 }, { 0, 1, 2, 3 } });
+
+	static void BM_Math_CullSpheres_Glm(benchmark::State& state)
+	{
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		const att::Math::FrustumPlanes frustum = TestFrustum();
+		uint32_t visibleCount = 0;
+		for (auto _ : state)
+		{
+			visibleCount = 0;
+			for (uint32_t i = 0; i < data.spheres.size(); i++)
+			{
+				const glm::vec4& sphere = data.spheres[i];
+				bool inside = true;
+				for (const glm::vec4& plane : frustum.planes)
+				{
+					inside = inside && glm::dot(glm::vec3(plane), glm::vec3(sphere)) + plane.w >= -sphere.w;
+				}
+				if (inside)
+				{
+					data.visible[visibleCount++] = i;
+				}
+			}
+			benchmark::DoNotOptimize(visibleCount);
+			benchmark::ClobberMemory();
+		}
+		state.counters["visible"] = visibleCount;
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_CullSpheres_Glm)->Arg(1 << 16);
+
+	static void BM_Math_CullSpheres(benchmark::State& state)
+	{
+		if (!SelectLevel(state))
+		{
+			return;
+		}
+		MathData data(static_cast<uint32_t>(state.range(0)));
+		const att::Math::FrustumPlanes frustum = TestFrustum();
+		uint32_t visibleCount = 0;
+		for (auto _ : state)
+		{
+			visibleCount = att::Math::CullSpheres(frustum, { { data.x.data(), data.y.data(), data.z.data() }, data.radius.data() },
+				static_cast<uint32_t>(data.x.size()), data.visible.data());
+			benchmark::DoNotOptimize(visibleCount);
+			benchmark::ClobberMemory();
+		}
+		state.counters["visible"] = visibleCount;
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Math_CullSpheres)->ArgsProduct({ { 1 << 16 }, { 0, 1, 2, 3 } });
+}
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Every run also writes Benchmarks.json to the working directory unless
+// --benchmark_out is given, keep one per commit to track regressions, e.g.:
+//   Benchmarks --benchmark_out=bench-$(git rev-parse --short HEAD).json
+// and compare two of them with tools/compare.py from Google Benchmark.
+
+int main(int argc, char** argv)
+{
+	std::vector<char*> args(argv, argv + argc);
+
+	bool hasOutput = false;
+	for (int i = 1; i < argc; i++)
+	{
+		hasOutput |= strncmp(argv[i], "--benchmark_out=", 16) == 0;
+	}
+
+	std::string outArg = "--benchmark_out=Benchmarks.json";
+	std::string formatArg = "--benchmark_out_format=json";
+	if (!hasOutput)
+	{
+		args.push_back(outArg.data());
+		args.push_back(formatArg.data());
+	}
+
+	int count = static_cast<int>(args.size());
+	benchmark::Initialize(&count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
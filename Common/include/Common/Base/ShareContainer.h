@@ -19,6 +19,8 @@ namespace Common
 			std::unique_lock lock(m_mutex);
 			if constexpr (requires {m_container.push_back(value);  }) {
 				m_container.push_back(value);
+			} else if constexpr (requires { m_container.push(value); }) {
+				m_container.push(value);
 			} else {
 				m_container.insert(value);
 			}
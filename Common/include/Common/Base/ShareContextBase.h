@@ -39,7 +39,7 @@ namespace Common
 			return m_context;
 		}
 	protected:
-		std::shared_mutex m_mutex;
+		mutable std::shared_mutex m_mutex;
 		T m_context;
 	};
 }
@@ -64,10 +64,8 @@
 
 	//  Linux/Android system/MacOS
 	#else
-		#if defined(COMMON_CORE_EXPORT)
-			#define COMMON_API __attribute__((visibility("default")))
-		#else
-			#define COMMON_API
-		#endif
+		// default on the importing side too: under -fvisibility=hidden the inline
+		// singletons (LogManager::Get ...) would otherwise get a hidden copy per library.
+		#define COMMON_API __attribute__((visibility("default")))
 	#endif
 #endif 
\ No newline at end of file
@@ -0,0 +1,338 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <Common/Config.h>
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// gives an event struct its compile-time id, the name must be unique across the engine:
+//   struct WindowResizeEvent { COMMON_EVENT(WindowResizeEvent); uint32_t width; uint32_t height; };
+#define COMMON_EVENT(name)                                                          \
+	static constexpr Common::EventId EventId = Common::HashEventName(#name);     \
+	static constexpr const char* EventName = #name
+
+namespace Common
+{
+	using EventId = uint32_t;
+
+	// FNV-1a of the type name: the same in every module and build, no RTTI needed.
+	constexpr EventId HashEventName(const char* name)
+	{
+		uint32_t hash = 2166136261u;
+		for (; *name != '\0'; name++)
+		{
+			hash ^= static_cast<uint8_t>(*name);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// events are copied into the queues as plain bytes, so no owning members (std::string, ...).
+	template<typename E>
+	concept Event = std::is_trivially_copyable_v<E>
+		&& std::is_default_constructible_v<E>
+		&& requires { { E::EventId } -> std::convertible_to<EventId>; { E::EventName } -> std::convertible_to<const char*>; };
+
+	struct EventSubscription
+	{
+		EventId eventId = 0;
+		uint32_t handlerId = 0;
+
+		bool IsValid() const { return handlerId != 0; }
+	};
+
+	// posting threads alive at the same time, a slot is reused once its thread exits.
+	inline constexpr uint32_t MaxPostingThreads = 64;
+
+	// type-erased side of a channel, lets the bus drain every event type in one loop.
+	class COMMON_API IEventChannel
+	{
+	public:
+		virtual ~IEventChannel() = default;
+		virtual void DispatchDeferred() = 0;
+		virtual void Unsubscribe(uint32_t handlerId) = 0;
+		virtual uint64_t GetDroppedCount() const = 0;
+	};
+
+	// Everything for one event type: its handlers in one array, and one deferred ring per
+	// posting thread. Handlers are a function pointer + context, dispatch never allocates.
+	template<Event E>
+	class EventChannel final : public IEventChannel
+	{
+	public:
+		using HandlerFn = void(*)(void* context, const E& event);
+
+		static constexpr uint32_t MaxThreads = MaxPostingThreads;
+		// per posting thread, Post drops the event when its ring is full.
+		static constexpr uint32_t QueueCapacity = 1024;
+
+		~EventChannel() override
+		{
+			for (auto& ring : m_rings)
+			{
+				delete ring.load(std::memory_order_relaxed);
+			}
+		}
+
+		uint32_t Subscribe(HandlerFn fn, void* context)
+		{
+			m_handlers.push_back({ fn, context, ++m_nextHandlerId });
+			return m_nextHandlerId;
+		}
+
+		void Unsubscribe(uint32_t handlerId) override
+		{
+			for (Handler& handler : m_handlers)
+			{
+				if (handler.id == handlerId)
+				{
+					handler.fn = nullptr;
+					m_dirty = true;
+				}
+			}
+			if (m_dispatchDepth == 0)
+			{
+				Compact();
+			}
+		}
+
+		void Publish(const E& event)
+		{
+			m_dispatchDepth++;
+			// by index and by copy: a handler may subscribe, and grow the array, mid dispatch.
+			const size_t count = m_handlers.size();
+			for (size_t i = 0; i < count; i++)
+			{
+				const Handler handler = m_handlers[i];
+				if (handler.fn != nullptr)
+				{
+					handler.fn(handler.context, event);
+				}
+			}
+			if (--m_dispatchDepth == 0 && m_dirty)
+			{
+				Compact();
+			}
+		}
+
+		// single producer (the thread owning the slot) / single consumer (the bus owner).
+		// A recycled slot keeps its ring, events the exited thread left are still delivered.
+		bool Post(const E& event, uint32_t threadSlot)
+		{
+			if (threadSlot >= MaxThreads)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			// only this thread ever creates its ring, so there is no race on the first post.
+			Ring* ring = m_rings[threadSlot].load(std::memory_order_acquire);
+			if (ring == nullptr)
+			{
+				ring = new Ring();
+				m_rings[threadSlot].store(ring, std::memory_order_release);
+			}
+
+			const uint32_t t = ring->tail.load(std::memory_order_relaxed);
+			if (t - ring->head.load(std::memory_order_acquire) >= QueueCapacity)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			ring->events[t & (QueueCapacity - 1)] = event;
+			ring->tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		// events posted while draining (also by the handlers) wait for the next drain.
+		void DispatchDeferred() override
+		{
+			for (auto& slot : m_rings)
+			{
+				Ring* ring = slot.load(std::memory_order_acquire);
+				if (ring == nullptr)
+				{
+					continue;
+				}
+
+				const uint32_t t = ring->tail.load(std::memory_order_acquire);
+				uint32_t h = ring->head.load(std::memory_order_relaxed);
+				for (; h != t; h++)
+				{
+					Publish(ring->events[h & (QueueCapacity - 1)]);
+				}
+				ring->head.store(h, std::memory_order_release);
+			}
+		}
+
+		uint64_t GetDroppedCount() const override { return m_dropped.load(std::memory_order_relaxed); }
+
+	private:
+		struct Handler
+		{
+			HandlerFn fn;
+			void* context;
+			uint32_t id;
+		};
+
+		struct Ring
+		{
+			std::unique_ptr<E[]> events{ new E[QueueCapacity] };
+			alignas(64) std::atomic<uint32_t> head{ 0 };	// written by the bus owner
+			alignas(64) std::atomic<uint32_t> tail{ 0 };	// written by the posting thread
+		};
+
+		void Compact()
+		{
+			std::erase_if(m_handlers, [](const Handler& handler) { return handler.fn == nullptr; });
+			m_dirty = false;
+		}
+
+		std::vector<Handler> m_handlers;
+		uint32_t m_nextHandlerId = 0;
+		uint32_t m_dispatchDepth = 0;
+		bool m_dirty = false;
+
+		std::atomic<Ring*> m_rings[MaxThreads] = {};
+		std::atomic<uint64_t> m_dropped{ 0 };
+	};
+
+	namespace Detail
+	{
+		template<typename Method>
+		struct MemberEventHandler;
+
+		template<typename T, typename E>
+		struct MemberEventHandler<void (T::*)(const E&)>
+		{
+			using EventType = E;
+		};
+	}
+
+	// Typed event bus. Subscribing, Publish (immediate) and DispatchDeferred belong to the
+	// owner thread, the one that constructed the bus unless SetOwnerThread says otherwise.
+	// Post may be called from any thread; the events wait in that thread's ring until the
+	// owner drains them at a fixed point of the frame. Order is kept per type and per posting
+	// thread, not across types.
+	class COMMON_API EventBus
+	{
+	public:
+		static constexpr uint32_t MaxEventTypes = 256;
+
+		static EventBus& Get()
+		{
+			static EventBus instance;
+			return instance;
+		}
+
+		void SetOwnerThread(std::thread::id owner) { m_owner = owner; }
+		bool IsOwnerThread() const { return std::this_thread::get_id() == m_owner; }
+
+		template<Event E>
+		EventSubscription Subscribe(typename EventChannel<E>::HandlerFn fn, void* context = nullptr)
+		{
+			assert(IsOwnerThread());
+			return { E::EventId, GetChannel<E>().Subscribe(fn, context) };
+		}
+
+		// member handler: Subscribe<&Game::OnResize>(this) for `void Game::OnResize(const WindowResizeEvent&)`.
+		template<auto Method, typename T>
+		EventSubscription Subscribe(T* object)
+		{
+			using E = typename Detail::MemberEventHandler<decltype(Method)>::EventType;
+			return Subscribe<E>([](void* context, const E& event) { (static_cast<T*>(context)->*Method)(event); }, object);
+		}
+
+		void Unsubscribe(EventSubscription& subscription);
+
+		template<Event E>
+		void Publish(const E& event)
+		{
+			assert(IsOwnerThread());
+			GetChannel<E>().Publish(event);
+		}
+
+		// false when the event was dropped (this thread's ring for E is full).
+		template<Event E>
+		bool Post(const E& event)
+		{
+			return GetChannel<E>().Post(event, ThreadSlot());
+		}
+
+		// the frame phase that delivers posted events, call once per frame from the owner thread.
+		void DispatchDeferred();
+
+		uint64_t GetDroppedCount() const;
+
+	private:
+		EventBus();
+
+		// small index per thread for the per-channel rings, handed out on first use and
+		// given back when the thread exits. MaxPostingThreads when none is free.
+		static uint32_t ThreadSlot();
+
+		// lock-free lookup, AddChannel is the only writer.
+		IEventChannel* FindChannel(EventId id) const
+		{
+			uint32_t index = id & (MaxEventTypes - 1);
+			for (uint32_t probe = 0; probe < MaxEventTypes; probe++)
+			{
+				const EventId slotId = m_ids[index].load(std::memory_order_acquire);
+				if (slotId == id)
+				{
+					return m_slots[index].load(std::memory_order_relaxed);
+				}
+				if (slotId == 0)
+				{
+					return nullptr;
+				}
+				index = (index + 1) & (MaxEventTypes - 1);
+			}
+			return nullptr;
+		}
+
+		IEventChannel* AddChannel(EventId id, std::unique_ptr<IEventChannel> channel);
+
+		// debug registry: false, and an assert, when another event type already has this id.
+		bool RegisterEventType(EventId id, const char* name, uint32_t size);
+
+		template<Event E>
+		EventChannel<E>& GetChannel()
+		{
+			static_assert(E::EventId != 0, "event id 0 is reserved");
+#ifndef NDEBUG
+			// once per type: two names hashing to one id would share a channel of the wrong type.
+			[[maybe_unused]] static const bool registered = RegisterEventType(E::EventId, E::EventName, sizeof(E));
+#endif
+			IEventChannel* channel = FindChannel(E::EventId);
+			if (channel == nullptr)
+			{
+				channel = AddChannel(E::EventId, std::make_unique<EventChannel<E>>());
+			}
+			return static_cast<EventChannel<E>&>(*channel);
+		}
+
+		std::thread::id m_owner;
+
+		std::mutex m_mutex;
+		std::atomic<EventId> m_ids[MaxEventTypes] = {};
+		std::atomic<IEventChannel*> m_slots[MaxEventTypes] = {};
+		// registration order, the order DispatchDeferred drains the types in.
+		std::unique_ptr<IEventChannel> m_channels[MaxEventTypes];
+		std::atomic<uint32_t> m_channelCount{ 0 };
+		// RegisterEventType, guarded by m_mutex.
+		std::unordered_map<EventId, std::pair<std::string, uint32_t>> m_eventTypes;
+	};
+}
+
+#endif // EVENT_BUS_H
@@ -0,0 +1,63 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <Common/Event/EventBus.h>
+
+// Engine events. Plain data only: they are copied into the deferred queues.
+// Key, button, action and mod values are the GLFW ones.
+
+namespace Common
+{
+	struct WindowResizeEvent
+	{
+		COMMON_EVENT(WindowResizeEvent);
+		uint32_t width;		// framebuffer size in pixels, 0 x 0 while minimized
+		uint32_t height;
+	};
+
+	struct WindowCloseEvent
+	{
+		COMMON_EVENT(WindowCloseEvent);
+	};
+
+	struct KeyEvent
+	{
+		COMMON_EVENT(KeyEvent);
+		int32_t key;
+		int32_t scancode;
+		int32_t action;		// press, release or repeat
+		int32_t mods;
+	};
+
+	struct MouseButtonEvent
+	{
+		COMMON_EVENT(MouseButtonEvent);
+		int32_t button;
+		int32_t action;
+		int32_t mods;
+	};
+
+	struct MouseMoveEvent
+	{
+		COMMON_EVENT(MouseMoveEvent);
+		double x;
+		double y;
+	};
+
+	struct MouseScrollEvent
+	{
+		COMMON_EVENT(MouseScrollEvent);
+		double offsetX;
+		double offsetY;
+	};
+
+	struct AssetReadyEvent
+	{
+		COMMON_EVENT(AssetReadyEvent);
+		uint64_t assetId;
+		uint32_t assetType;
+		bool succeeded;
+	};
+}
+
+#endif // EVENTS_H
@@ -0,0 +1,137 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <Common/Config.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Common
+{
+	// number of scheduled jobs not finished yet, Wait() returns when it reaches zero.
+	class JobCounter
+	{
+	public:
+		bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+		std::atomic<uint32_t> m_pending{ 0 };
+	};
+
+	// a plain function pointer and its data, the caller keeps `data` alive until the counter is done.
+	struct Job
+	{
+		void (*function)(void* data) = nullptr;
+		void* data = nullptr;
+		JobCounter* counter = nullptr;
+	};
+
+	class COMMON_API JobSystem
+	{
+	public:
+		static JobSystem& Get()
+		{
+			static JobSystem instance;
+			return instance;
+		}
+
+		// 0 = one worker per hardware thread minus the calling one. Without workers every
+		// job runs inline on the thread that waits for it.
+		void Initialize(uint32_t workerCount = 0);
+		void Shutdown();
+
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+		void Schedule(const Job& job);
+
+		// runs queued jobs on the calling thread while it waits, so waiting from inside a job is fine.
+		void Wait(JobCounter& counter);
+
+		// fn(begin, end) over [0, count) in batches of `grain`. The calling thread takes part and
+		// the call returns once every batch is done.
+		template<typename Fn>
+		void ParallelFor(uint32_t count, uint32_t grain, Fn&& fn)
+		{
+			grain = std::max(grain, 1u);
+			const uint32_t batches = (count + grain - 1) / grain;
+			if (batches == 0)
+			{
+				return;
+			}
+			if (batches == 1 || m_workers.empty())
+			{
+				fn(0u, count);
+				return;
+			}
+
+			struct Range
+			{
+				std::atomic<uint32_t> next{ 0 };
+				uint32_t count;
+				uint32_t grain;
+				Fn* fn;
+
+				void Run()
+				{
+					for (;;)
+					{
+						const uint32_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+						if (begin >= count)
+						{
+							return;
+						}
+						(*fn)(begin, std::min(begin + grain, count));
+					}
+				}
+			};
+
+			// every helper claims batches from the shared cursor until it runs out.
+			Range range;
+			range.count = count;
+			range.grain = grain;
+			range.fn = &fn;
+
+			JobCounter counter;
+			const uint32_t helpers = std::min(GetWorkerCount(), batches - 1);
+			for (uint32_t i = 0; i < helpers; i++)
+			{
+				Schedule({ [](void* data) { static_cast<Range*>(data)->Run(); }, &range, &counter });
+			}
+			range.Run();
+			Wait(counter);
+		}
+
+		// busy fraction of the workers since the last call, fed to Stats::JobUtilization.
+		// Call once per frame.
+		float ReportUtilization();
+
+	private:
+		JobSystem() = default;
+		~JobSystem();
+
+		bool TryRunOne();
+		void Execute(const Job& job);
+		void WorkerLoop(uint32_t index);
+
+		std::vector<std::thread> m_workers;
+		std::atomic<bool> m_running{ false };
+
+		// ring of pending jobs, grows when full.
+		std::mutex m_mutex;
+		std::condition_variable m_wakeup;
+		std::vector<Job> m_queue;
+		size_t m_head = 0;
+		size_t m_size = 0;
+
+		std::atomic<uint64_t> m_busyNanoseconds{ 0 };
+		std::chrono::steady_clock::time_point m_lastReport;
+	};
+}
+
+#endif // JOB_SYSTEM_H
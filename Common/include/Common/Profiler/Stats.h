@@ -0,0 +1,185 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <Common/Config.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// set by the root CMake from ANTUTU_STATS, every macro below compiles to nothing when 0.
+#ifndef _ANTUTU_STATS_ENABLED
+	#define _ANTUTU_STATS_ENABLED 0
+#endif
+
+#if _ANTUTU_STATS_ENABLED
+	#define STATS_INCREMENT(id, value)   Common::StatsRegistry::Increment(id, value)
+	#define STATS_SET(id, value)         Common::StatsRegistry::Get().SetGauge(id, static_cast<double>(value))
+	#define STATS_ADJUST(id, delta)      Common::StatsRegistry::Get().AdjustGauge(id, static_cast<double>(delta))
+	#define STATS_SAMPLE(id, value)      Common::StatsRegistry::Get().RecordSample(id, static_cast<double>(value))
+	#define STATS_END_FRAME()            Common::StatsRegistry::Get().EndFrame()
+#else
+	#define STATS_INCREMENT(id, value)   ((void)0)
+	#define STATS_SET(id, value)         ((void)0)
+	#define STATS_ADJUST(id, delta)      ((void)0)
+	#define STATS_SAMPLE(id, value)      ((void)0)
+	#define STATS_END_FRAME()            ((void)0)
+#endif
+
+namespace Common
+{
+	// first slot of the stat in the per-thread shards.
+	using StatId = uint32_t;
+
+	// returned when the slots ran out, recording to it does nothing.
+	constexpr StatId InvalidStatId = UINT32_MAX;
+
+	enum class StatType : uint8_t
+	{
+		Counter,	// summed over all threads, reported per frame
+		Gauge,		// last value set from any thread
+		Histogram	// linear buckets, percentiles since start
+	};
+
+	// registered by the StatsRegistry constructor in this order.
+	namespace Stats
+	{
+		constexpr StatId FrameTime = 0;			// histogram, ms
+		constexpr StatId DrawCalls = 65;		// counter
+		constexpr StatId GpuMemory = 66;		// gauge, bytes of device memory allocated
+		constexpr StatId DescriptorPools = 67;	// gauge, descriptor allocator pools alive
+		constexpr StatId LogQueueDepth = 68;	// gauge, pending async log messages
+		constexpr StatId JobUtilization = 69;	// gauge, busy fraction of the worker threads
+		constexpr StatId AssetBytesRead = 70;	// counter, bytes read by the asset streamer
+		constexpr StatId AssetPending = 71;		// gauge, asset requests not finished yet
+		constexpr StatId AssetCacheBytes = 72;	// gauge, bytes resident in the asset cache
+		constexpr StatId TextureStreamedBytes = 73;	// gauge, bytes of streamed texture mips resident
+	}
+
+	struct StatSample
+	{
+		const char* name;
+		StatType type;
+		double value;		// counter: this frame, gauge: current, histogram: mean of this frame
+		double total;		// counter: since start, histogram: sample count since start
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+	};
+
+	struct StatsSnapshot
+	{
+		uint64_t frame = 0;
+		std::vector<StatSample> stats;
+	};
+
+	class COMMON_API StatsRegistry
+	{
+	public:
+		static constexpr uint32_t MaxSlots = 4096;
+		static constexpr uint32_t HistogramBuckets = 64;
+
+		using OverlayCallback = std::function<void(const StatsSnapshot& snapshot)>;
+
+		struct Shard
+		{
+			std::atomic<uint64_t> slots[MaxSlots] = {};
+		};
+
+		static StatsRegistry& Get()
+		{
+			static StatsRegistry instance;
+			return instance;
+		}
+
+		// registering an existing name returns its id, InvalidStatId once MaxSlots are used.
+		StatId RegisterCounter(const std::string& name);
+		StatId RegisterGauge(const std::string& name);
+		// bucket i covers [i * bucketWidth, (i + 1) * bucketWidth), the last one is open ended.
+		StatId RegisterHistogram(const std::string& name, double bucketWidth);
+
+		// hot path: a plain load / add / store on this thread's slot. Relaxed atomics only so
+		// the collector's read is defined, the owning thread is the only writer.
+		static COMMON_INLINE void Increment(StatId id, uint64_t value = 1)
+		{
+			if (id == InvalidStatId)
+			{
+				return;
+			}
+			std::atomic<uint64_t>& slot = LocalShard().slots[id];
+			slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		void SetGauge(StatId id, double value);
+		void AdjustGauge(StatId id, double delta);
+		void RecordSample(StatId id, double value);
+
+		// aggregates the shards into the snapshot and feeds the outputs, call once per frame.
+		void EndFrame();
+
+		const StatsSnapshot& GetSnapshot() const { return m_snapshot; }
+
+		// logs the snapshot every `frames` frames, 0 disables it.
+		void SetLogInterval(uint32_t frames) { m_logInterval = frames; }
+
+		// one row per frame; CSV when the path ends in .csv, JSON lines otherwise.
+		// Stats registered after the CSV header was written are left out of it.
+		bool OpenTimeSeries(const std::string& path);
+		void CloseTimeSeries();
+
+		// e.g. an on-screen overlay, called from EndFrame.
+		void SetOverlayCallback(OverlayCallback callback) { m_overlayCallback = std::move(callback); }
+
+	private:
+		StatsRegistry();
+		StatId Register(const std::string& name, StatType type, uint32_t slotCount, double bucketWidth);
+		Shard& RegisterShard();
+		uint64_t SumSlot(uint32_t slot) const;
+		void WriteTimeSeries();
+		void LogSnapshot() const;
+
+		static COMMON_INLINE Shard& LocalShard()
+		{
+			thread_local Shard* t_shard = nullptr;
+			if (t_shard == nullptr)
+			{
+				t_shard = &Get().RegisterShard();
+			}
+			return *t_shard;
+		}
+
+		struct StatInfo
+		{
+			std::string name;
+			StatId id;
+			StatType type;
+			uint32_t slotCount;
+			double bucketWidth;
+		};
+
+		mutable std::mutex m_mutex;
+		// deque: snapshot names point into it and must survive later registrations.
+		std::deque<StatInfo> m_stats;
+		std::atomic<uint32_t> m_nextSlot{ 0 };
+		// read by RecordSample without the lock, written once at registration.
+		double m_bucketWidth[MaxSlots] = {};
+		std::atomic<double> m_gauges[MaxSlots] = {};
+		// shards are never freed, a thread that exits keeps contributing its totals.
+		std::vector<std::unique_ptr<Shard>> m_shards;
+		std::vector<uint64_t> m_previous;
+
+		StatsSnapshot m_snapshot;
+		uint32_t m_logInterval = 0;
+		std::ofstream m_timeSeries;
+		bool m_timeSeriesCsv = false;
+		size_t m_csvColumns = 0;
+		OverlayCallback m_overlayCallback;
+	};
+}
+
+#endif // STATS_H
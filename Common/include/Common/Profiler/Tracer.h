@@ -0,0 +1,186 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <Common/Config.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+// set by the root CMake from ANTUTU_TRACE, every macro below compiles to nothing when 0.
+#ifndef _ANTUTU_TRACING_ENABLED
+	#define _ANTUTU_TRACING_ENABLED 0
+#endif
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#if _ANTUTU_TRACING_ENABLED
+	// names must outlive the capture (string literals), only the pointer is recorded.
+	#define TRACE_SCOPE(name)            Common::TraceScope TRACE_CONCAT(_traceScope, __LINE__)(name)
+	#define TRACE_FUNCTION()             TRACE_SCOPE(__FUNCTION__)
+	#define TRACE_FRAME_MARK()           Common::Tracer::Get().FrameMark()
+	#define TRACE_COUNTER(name, value)   Common::Tracer::Get().Counter(name, static_cast<double>(value))
+	#define TRACE_THREAD_NAME(name)      Common::Tracer::Get().SetThreadName(name)
+#else
+	#define TRACE_SCOPE(name)            ((void)0)
+	#define TRACE_FUNCTION()             ((void)0)
+	#define TRACE_FRAME_MARK()           ((void)0)
+	#define TRACE_COUNTER(name, value)   ((void)0)
+	#define TRACE_THREAD_NAME(name)      ((void)0)
+#endif
+
+namespace Common
+{
+	enum class TraceEventType : uint8_t
+	{
+		Begin,
+		End,
+		Counter,
+		Frame,
+		Zone		// complete event on a virtual track (e.g. GPU timings)
+	};
+
+	struct TraceEvent
+	{
+		uint64_t ticks;
+		const char* name;
+		double value;		// counter value, frame index or zone duration in microseconds
+		TraceEventType type;
+	};
+
+	// single producer (the owning thread) / single consumer (the collector) ring.
+	// The producer never blocks, events are dropped when the collector falls behind.
+	// Created by a thread's first event during a capture, freed once the thread exited
+	// and its events were collected.
+	struct COMMON_API TraceThreadBuffer
+	{
+		static constexpr uint32_t Capacity = 1u << 16;
+
+		uint32_t threadId = 0;
+		std::string name;
+		bool exited = false;		// guarded by the tracer's mutex
+		std::unique_ptr<TraceEvent[]> events{ new TraceEvent[Capacity] };
+		alignas(64) std::atomic<uint32_t> head{ 0 };	// written by the collector
+		alignas(64) std::atomic<uint32_t> tail{ 0 };	// written by the owning thread
+		std::atomic<uint64_t> dropped{ 0 };
+
+		COMMON_INLINE void Push(const TraceEvent& event)
+		{
+			const uint32_t t = tail.load(std::memory_order_relaxed);
+			if (t - head.load(std::memory_order_acquire) >= Capacity)
+			{
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			events[t & (Capacity - 1)] = event;
+			tail.store(t + 1, std::memory_order_release);
+		}
+	};
+
+	class COMMON_API Tracer
+	{
+	public:
+		static Tracer& Get()
+		{
+			static Tracer instance;
+			return instance;
+		}
+
+		// TSC on x86, the virtual counter on ARM64, steady_clock elsewhere.
+		static COMMON_INLINE uint64_t ReadTicks()
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#elif defined(__aarch64__)
+			uint64_t ticks;
+			asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+			return ticks;
+#else
+			return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+		}
+
+		// starts a capture, events recorded before are discarded.
+		void Start();
+		void Stop();
+		bool IsCapturing() const { return m_capturing.load(std::memory_order_relaxed); }
+
+		void BeginZone(const char* name) { Emit({ ReadTicks(), name, 0.0, TraceEventType::Begin }); }
+		void EndZone(const char* name) { Emit({ ReadTicks(), name, 0.0, TraceEventType::End }); }
+		void Counter(const char* name, double value) { Emit({ ReadTicks(), name, value, TraceEventType::Counter }); }
+		void FrameMark();
+		void SetThreadName(const std::string& name);
+
+		// virtual tracks carry timings that don't come from a CPU thread, e.g. the GPU.
+		uint32_t RegisterTrack(const std::string& name);
+		// beginTicks is in ReadTicks() units, duration in microseconds.
+		void SubmitZone(uint32_t track, const char* name, uint64_t beginTicks, double durationUs);
+
+		// drains every thread buffer, call once per frame (or from a worker) so the rings never fill.
+		void Collect();
+
+		// Chrome Trace Event JSON, loads in chrome://tracing and ui.perfetto.dev.
+		bool WriteChromeTrace(const std::string& path);
+
+		uint64_t GetDroppedCount() const;
+
+		// measured against steady_clock since Start().
+		double GetTicksPerMicrosecond() const;
+
+	private:
+		// per thread: its name and its buffer, if it recorded anything yet.
+		struct ThreadState;
+
+		Tracer() = default;
+		void Emit(const TraceEvent& event);
+		static ThreadState& GetThreadState();
+		TraceThreadBuffer& GetThreadBuffer();
+		void ReleaseThreadBuffer(TraceThreadBuffer* buffer);
+
+		struct CollectedEvent
+		{
+			TraceEvent event;
+			uint32_t threadId;
+		};
+
+		std::atomic<bool> m_capturing{ false };
+		std::atomic<uint64_t> m_frameIndex{ 0 };
+		uint64_t m_startTicks = 0;
+		std::chrono::steady_clock::time_point m_startTime;
+
+		mutable std::mutex m_mutex;
+		std::vector<std::unique_ptr<TraceThreadBuffer>> m_threads;
+		uint32_t m_nextThreadId = 1;
+		// threads that exited during the capture, their events are in m_collected.
+		std::vector<std::pair<uint32_t, std::string>> m_exitedThreads;
+		uint64_t m_exitedDropped = 0;
+		std::vector<std::string> m_tracks;
+		std::vector<CollectedEvent> m_collected;
+	};
+
+	class TraceScope
+	{
+	public:
+		explicit TraceScope(const char* name) : m_name(name) { Tracer::Get().BeginZone(name); }
+		~TraceScope() { Tracer::Get().EndZone(m_name); }
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+	private:
+		const char* m_name;
+	};
+}
+
+#endif // TRACER_H
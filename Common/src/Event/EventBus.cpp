@@ -0,0 +1,143 @@
+#include <Common/Event/EventBus.h>
+#include <Common/Logger/LogManager.h>
+#include <Common/Profiler/Tracer.h>
+
+namespace Common
+{
+	EventBus::EventBus()
+		: m_owner(std::this_thread::get_id())
+	{
+	}
+
+	// the free slots, a thread's slot returns here when it exits.
+	struct PostingSlots
+	{
+		std::mutex mutex;
+		std::vector<uint32_t> free;
+		uint32_t next = 0;
+
+		static PostingSlots& Get()
+		{
+			static PostingSlots slots;
+			return slots;
+		}
+
+		uint32_t Acquire()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!free.empty())
+			{
+				const uint32_t slot = free.back();
+				free.pop_back();
+				return slot;
+			}
+			return next < MaxPostingThreads ? next++ : MaxPostingThreads;
+		}
+
+		void Release(uint32_t slot)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			free.push_back(slot);
+		}
+	};
+
+	struct PostingThreadSlot
+	{
+		uint32_t slot = PostingSlots::Get().Acquire();
+
+		~PostingThreadSlot()
+		{
+			if (slot < MaxPostingThreads)
+			{
+				PostingSlots::Get().Release(slot);
+			}
+		}
+	};
+
+	uint32_t EventBus::ThreadSlot()
+	{
+		// defined here, not in the header, so every module shares the one slot list.
+		// Past MaxPostingThreads live threads, Post drops and counts the events.
+		thread_local PostingThreadSlot t_slot;
+		return t_slot.slot;
+	}
+
+	IEventChannel* EventBus::AddChannel(EventId id, std::unique_ptr<IEventChannel> channel)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// another thread may have added it between the lookup and the lock.
+		if (IEventChannel* existing = FindChannel(id))
+		{
+			return existing;
+		}
+
+		const uint32_t count = m_channelCount.load(std::memory_order_relaxed);
+		assert(count < MaxEventTypes && "too many event types, raise EventBus::MaxEventTypes");
+
+		uint32_t index = id & (MaxEventTypes - 1);
+		while (m_ids[index].load(std::memory_order_relaxed) != 0)
+		{
+			index = (index + 1) & (MaxEventTypes - 1);
+		}
+
+		IEventChannel* result = channel.get();
+		m_channels[count] = std::move(channel);
+		m_slots[index].store(result, std::memory_order_relaxed);
+		// publishes the slot, FindChannel reads the id with acquire.
+		m_ids[index].store(id, std::memory_order_release);
+		m_channelCount.store(count + 1, std::memory_order_release);
+		return result;
+	}
+
+	bool EventBus::RegisterEventType(EventId id, const char* name, uint32_t size)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const auto [it, added] = m_eventTypes.try_emplace(id, name, size);
+		if (added || (it->second.first == name && it->second.second == size))
+		{
+			return true;
+		}
+		LOG_ERROR("Event {0} ({1} bytes) has the id {2:x} of {3} ({4} bytes), rename one of them.",
+			name, size, id, it->second.first, it->second.second);
+		assert(false && "event id collision");
+		return false;
+	}
+
+	void EventBus::Unsubscribe(EventSubscription& subscription)
+	{
+		assert(IsOwnerThread());
+		if (!subscription.IsValid())
+		{
+			return;
+		}
+		if (IEventChannel* channel = FindChannel(subscription.eventId))
+		{
+			channel->Unsubscribe(subscription.handlerId);
+		}
+		subscription = {};
+	}
+
+	void EventBus::DispatchDeferred()
+	{
+		TRACE_SCOPE("EventBus::DispatchDeferred");
+		assert(IsOwnerThread());
+
+		const uint32_t count = m_channelCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_channels[i]->DispatchDeferred();
+		}
+	}
+
+	uint64_t EventBus::GetDroppedCount() const
+	{
+		uint64_t dropped = 0;
+		const uint32_t count = m_channelCount.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			dropped += m_channels[i]->GetDroppedCount();
+		}
+		return dropped;
+	}
+}
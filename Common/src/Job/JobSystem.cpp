@@ -0,0 +1,166 @@
+#include <Common/Job/JobSystem.h>
+#include <Common/Profiler/Stats.h>
+#include <Common/Profiler/Tracer.h>
+#include <string>
+
+namespace Common
+{
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	void JobSystem::Initialize(uint32_t workerCount)
+	{
+		if (!m_workers.empty())
+		{
+			return;
+		}
+
+		if (workerCount == 0)
+		{
+			const uint32_t hardware = std::thread::hardware_concurrency();
+			workerCount = hardware > 1 ? hardware - 1 : 0;
+		}
+
+		m_queue.resize(256);
+		m_lastReport = std::chrono::steady_clock::now();
+		m_running.store(true, std::memory_order_release);
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+		}
+	}
+
+	void JobSystem::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running.store(false, std::memory_order_release);
+		}
+		m_wakeup.notify_all();
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+		m_workers.clear();
+
+		// nothing is left to run them, finish the remaining jobs here.
+		while (TryRunOne())
+		{
+		}
+	}
+
+	void JobSystem::Schedule(const Job& job)
+	{
+		if (job.counter != nullptr)
+		{
+			job.counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (m_workers.empty())
+		{
+			Execute(job);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_size == m_queue.size())
+			{
+				std::vector<Job> grown(std::max<size_t>(m_queue.size() * 2, 256));
+				for (size_t i = 0; i < m_size; i++)
+				{
+					grown[i] = m_queue[(m_head + i) % m_queue.size()];
+				}
+				m_queue.swap(grown);
+				m_head = 0;
+			}
+			m_queue[(m_head + m_size) % m_queue.size()] = job;
+			m_size++;
+		}
+		m_wakeup.notify_one();
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!TryRunOne())
+			{
+				// the remaining jobs are running on other threads.
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool JobSystem::TryRunOne()
+	{
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_size == 0)
+			{
+				return false;
+			}
+			job = m_queue[m_head];
+			m_head = (m_head + 1) % m_queue.size();
+			m_size--;
+		}
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::Execute(const Job& job)
+	{
+		job.function(job.data);
+		if (job.counter != nullptr)
+		{
+			job.counter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+	void JobSystem::WorkerLoop([[maybe_unused]] uint32_t index)
+	{
+		TRACE_THREAD_NAME("Worker " + std::to_string(index));
+
+		for (;;)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wakeup.wait(lock, [this]() {
+					return m_size > 0 || !m_running.load(std::memory_order_acquire);
+				});
+				if (m_size == 0)
+				{
+					return;
+				}
+				job = m_queue[m_head];
+				m_head = (m_head + 1) % m_queue.size();
+				m_size--;
+			}
+
+			const auto begin = std::chrono::steady_clock::now();
+			Execute(job);
+			const auto busy = std::chrono::steady_clock::now() - begin;
+			m_busyNanoseconds.fetch_add(static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count()), std::memory_order_relaxed);
+		}
+	}
+
+	float JobSystem::ReportUtilization()
+	{
+		const auto now = std::chrono::steady_clock::now();
+		const double elapsed = std::chrono::duration<double, std::nano>(now - m_lastReport).count();
+		m_lastReport = now;
+
+		const uint64_t busy = m_busyNanoseconds.exchange(0, std::memory_order_relaxed);
+		const float utilization = (m_workers.empty() || elapsed <= 0.0)
+			? 0.0f
+			: static_cast<float>(std::min(1.0, static_cast<double>(busy) / (elapsed * m_workers.size())));
+
+		STATS_SET(Stats::JobUtilization, utilization);
+		return utilization;
+	}
+}
@@ -0,0 +1,291 @@
+#include <Common/Profiler/Stats.h>
+#include <Common/Logger/LogManager.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+namespace Common
+{
+	// histogram sums are kept in the shards as fixed point.
+	static constexpr double HistogramSumScale = 1000000.0;
+
+	StatsRegistry::StatsRegistry()
+		: m_previous(MaxSlots, 0)
+	{
+		[[maybe_unused]] StatId id = RegisterHistogram("frame_time_ms", 0.5);
+		assert(id == Stats::FrameTime);
+		id = RegisterCounter("draw_calls");
+		assert(id == Stats::DrawCalls);
+		id = RegisterGauge("gpu_memory_bytes");
+		assert(id == Stats::GpuMemory);
+		id = RegisterGauge("descriptor_pools");
+		assert(id == Stats::DescriptorPools);
+		id = RegisterGauge("log_queue_depth");
+		assert(id == Stats::LogQueueDepth);
+		id = RegisterGauge("job_utilization");
+		assert(id == Stats::JobUtilization);
+		id = RegisterCounter("asset_bytes_read");
+		assert(id == Stats::AssetBytesRead);
+		id = RegisterGauge("asset_pending");
+		assert(id == Stats::AssetPending);
+		id = RegisterGauge("asset_cache_bytes");
+		assert(id == Stats::AssetCacheBytes);
+		id = RegisterGauge("texture_streamed_bytes");
+		assert(id == Stats::TextureStreamedBytes);
+	}
+
+	StatId StatsRegistry::RegisterCounter(const std::string& name)
+	{
+		return Register(name, StatType::Counter, 1, 0.0);
+	}
+
+	StatId StatsRegistry::RegisterGauge(const std::string& name)
+	{
+		return Register(name, StatType::Gauge, 1, 0.0);
+	}
+
+	StatId StatsRegistry::RegisterHistogram(const std::string& name, double bucketWidth)
+	{
+		// the extra slot holds the sum of the samples.
+		return Register(name, StatType::Histogram, HistogramBuckets + 1, bucketWidth > 0.0 ? bucketWidth : 1.0);
+	}
+
+	void StatsRegistry::SetGauge(StatId id, double value)
+	{
+		if (id == InvalidStatId)
+		{
+			return;
+		}
+		m_gauges[id].store(value, std::memory_order_relaxed);
+	}
+
+	void StatsRegistry::AdjustGauge(StatId id, double delta)
+	{
+		if (id == InvalidStatId)
+		{
+			return;
+		}
+		double current = m_gauges[id].load(std::memory_order_relaxed);
+		while (!m_gauges[id].compare_exchange_weak(current, current + delta, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void StatsRegistry::RecordSample(StatId id, double value)
+	{
+		if (id == InvalidStatId)
+		{
+			return;
+		}
+		const double clamped = value > 0.0 ? value : 0.0;
+		const uint32_t bucket = std::min(static_cast<uint32_t>(clamped / m_bucketWidth[id]), HistogramBuckets - 1);
+
+		Shard& shard = LocalShard();
+		std::atomic<uint64_t>& count = shard.slots[id + bucket];
+		count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic<uint64_t>& sum = shard.slots[id + HistogramBuckets];
+		sum.store(sum.load(std::memory_order_relaxed) + static_cast<uint64_t>(clamped * HistogramSumScale),
+			std::memory_order_relaxed);
+	}
+
+	void StatsRegistry::EndFrame()
+	{
+		if (auto pool = spdlog::thread_pool())
+		{
+			SetGauge(Stats::LogQueueDepth, static_cast<double>(pool->queue_size()));
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_snapshot.frame++;
+			m_snapshot.stats.clear();
+
+			for (const StatInfo& info : m_stats)
+			{
+				StatSample sample{ info.name.c_str(), info.type, 0.0, 0.0 };
+				switch (info.type)
+				{
+				case StatType::Counter:
+				{
+					const uint64_t total = SumSlot(info.id);
+					sample.value = static_cast<double>(total - m_previous[info.id]);
+					sample.total = static_cast<double>(total);
+					m_previous[info.id] = total;
+					break;
+				}
+				case StatType::Gauge:
+					sample.value = m_gauges[info.id].load(std::memory_order_relaxed);
+					sample.total = sample.value;
+					break;
+				case StatType::Histogram:
+				{
+					uint64_t buckets[HistogramBuckets];
+					uint64_t count = 0;
+					for (uint32_t i = 0; i < HistogramBuckets; i++)
+					{
+						buckets[i] = SumSlot(info.id + i);
+						count += buckets[i];
+					}
+
+					const uint64_t sum = SumSlot(info.id + HistogramBuckets);
+					const uint64_t frameCount = count - m_previous[info.id];
+					const uint64_t frameSum = sum - m_previous[info.id + HistogramBuckets];
+					m_previous[info.id] = count;
+					m_previous[info.id + HistogramBuckets] = sum;
+
+					sample.value = frameCount > 0 ? static_cast<double>(frameSum) / HistogramSumScale / frameCount : 0.0;
+					sample.total = static_cast<double>(count);
+
+					// bucket midpoints, exact to half a bucket width.
+					const double targets[3] = { 0.50, 0.95, 0.99 };
+					double* outputs[3] = { &sample.p50, &sample.p95, &sample.p99 };
+					for (int t = 0; t < 3 && count > 0; t++)
+					{
+						const uint64_t rank = static_cast<uint64_t>(targets[t] * (count - 1)) + 1;
+						uint64_t seen = 0;
+						for (uint32_t i = 0; i < HistogramBuckets; i++)
+						{
+							seen += buckets[i];
+							if (seen >= rank)
+							{
+								*outputs[t] = (i + 0.5) * info.bucketWidth;
+								break;
+							}
+						}
+					}
+					break;
+				}
+				}
+				m_snapshot.stats.push_back(sample);
+			}
+
+			if (m_timeSeries.is_open())
+			{
+				WriteTimeSeries();
+			}
+		}
+
+		if (m_logInterval > 0 && m_snapshot.frame % m_logInterval == 0)
+		{
+			LogSnapshot();
+		}
+		if (m_overlayCallback)
+		{
+			m_overlayCallback(m_snapshot);
+		}
+	}
+
+	bool StatsRegistry::OpenTimeSeries(const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_timeSeries.close();
+		m_timeSeries.open(path, std::ios::out | std::ios::trunc);
+		m_timeSeriesCsv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+		m_csvColumns = 0;
+		return m_timeSeries.is_open();
+	}
+
+	void StatsRegistry::CloseTimeSeries()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_timeSeries.close();
+	}
+
+	StatId StatsRegistry::Register(const std::string& name, StatType type, uint32_t slotCount, double bucketWidth)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const StatInfo& info : m_stats)
+		{
+			if (info.name == name)
+			{
+				return info.id;
+			}
+		}
+
+		const StatId id = m_nextSlot.load(std::memory_order_relaxed);
+		if (id + slotCount > MaxSlots)
+		{
+			// out of slots: the stat is not recorded, a shared slot would overflow a histogram.
+			return InvalidStatId;
+		}
+		m_nextSlot.store(id + slotCount, std::memory_order_relaxed);
+		m_bucketWidth[id] = bucketWidth;
+		m_stats.push_back({ name, id, type, slotCount, bucketWidth });
+		return id;
+	}
+
+	StatsRegistry::Shard& StatsRegistry::RegisterShard()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_shards.push_back(std::make_unique<Shard>());
+		return *m_shards.back();
+	}
+
+	uint64_t StatsRegistry::SumSlot(uint32_t slot) const
+	{
+		uint64_t total = 0;
+		for (const auto& shard : m_shards)
+		{
+			total += shard->slots[slot].load(std::memory_order_relaxed);
+		}
+		return total;
+	}
+
+	void StatsRegistry::WriteTimeSeries()
+	{
+		if (m_timeSeriesCsv)
+		{
+			if (m_csvColumns == 0)
+			{
+				m_csvColumns = m_snapshot.stats.size();
+				m_timeSeries << "frame";
+				for (size_t i = 0; i < m_csvColumns; i++)
+				{
+					m_timeSeries << ',' << m_snapshot.stats[i].name;
+				}
+				m_timeSeries << '\n';
+			}
+
+			m_timeSeries << m_snapshot.frame;
+			for (size_t i = 0; i < m_csvColumns; i++)
+			{
+				m_timeSeries << ',' << m_snapshot.stats[i].value;
+			}
+			m_timeSeries << '\n';
+			return;
+		}
+
+		m_timeSeries << "{\"frame\":" << m_snapshot.frame;
+		for (const StatSample& sample : m_snapshot.stats)
+		{
+			m_timeSeries << ",\"" << sample.name << "\":" << sample.value;
+		}
+		m_timeSeries << "}\n";
+	}
+
+	void StatsRegistry::LogSnapshot() const
+	{
+		auto& logger = LogManager::Get().GetLogger();
+		if (!logger)
+		{
+			return;
+		}
+
+		std::string text = "Stats at frame " + std::to_string(m_snapshot.frame) + ":";
+		char line[160];
+		for (const StatSample& sample : m_snapshot.stats)
+		{
+			if (sample.type == StatType::Histogram)
+			{
+				snprintf(line, sizeof(line), "\n  %-24s mean %10.3f  p50 %8.3f  p95 %8.3f  p99 %8.3f",
+					sample.name, sample.value, sample.p50, sample.p95, sample.p99);
+			}
+			else
+			{
+				snprintf(line, sizeof(line), "\n  %-24s %14.2f  total %14.0f", sample.name, sample.value, sample.total);
+			}
+			text += line;
+		}
+		logger->info(text);
+	}
+}
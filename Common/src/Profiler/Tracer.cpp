@@ -0,0 +1,275 @@
+#include <Common/Profiler/Tracer.h>
+#include <fstream>
+
+namespace Common
+{
+	// virtual tracks are listed after the real threads in the viewer.
+	static constexpr uint32_t TrackIdBase = 1000000;
+
+	static void WriteJsonString(std::ofstream& out, const char* text)
+	{
+		out << '"';
+		for (const char* c = text ? text : ""; *c != '\0'; c++)
+		{
+			switch (*c)
+			{
+			case '"':  out << "\\\""; break;
+			case '\\': out << "\\\\"; break;
+			case '\n': out << "\\n"; break;
+			case '\t': out << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(*c) >= 0x20)
+				{
+					out << *c;
+				}
+				break;
+			}
+		}
+		out << '"';
+	}
+
+	struct Tracer::ThreadState
+	{
+		std::string name;
+		TraceThreadBuffer* buffer = nullptr;
+
+		~ThreadState()
+		{
+			if (buffer != nullptr)
+			{
+				Tracer::Get().ReleaseThreadBuffer(buffer);
+			}
+		}
+	};
+
+	void Tracer::Start()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		// the events of exited threads are discarded, nothing keeps their buffers.
+		std::erase_if(m_threads, [](const std::unique_ptr<TraceThreadBuffer>& buffer) { return buffer->exited; });
+		for (auto& buffer : m_threads)
+		{
+			buffer->head.store(buffer->tail.load(std::memory_order_acquire), std::memory_order_release);
+			buffer->dropped.store(0, std::memory_order_relaxed);
+		}
+		m_exitedThreads.clear();
+		m_exitedDropped = 0;
+		m_collected.clear();
+		m_frameIndex = 0;
+		m_startTime = std::chrono::steady_clock::now();
+		m_startTicks = ReadTicks();
+		m_capturing.store(true, std::memory_order_release);
+	}
+
+	void Tracer::Stop()
+	{
+		m_capturing.store(false, std::memory_order_release);
+	}
+
+	void Tracer::FrameMark()
+	{
+		const uint64_t frame = m_frameIndex.fetch_add(1, std::memory_order_relaxed);
+		Emit({ ReadTicks(), "Frame", static_cast<double>(frame), TraceEventType::Frame });
+	}
+
+	void Tracer::SetThreadName(const std::string& name)
+	{
+		// kept with the thread, a buffer created later picks it up.
+		ThreadState& state = GetThreadState();
+		state.name = name;
+		if (state.buffer != nullptr)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			state.buffer->name = name;
+		}
+	}
+
+	uint32_t Tracer::RegisterTrack(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tracks.push_back(name);
+		return TrackIdBase + static_cast<uint32_t>(m_tracks.size() - 1);
+	}
+
+	void Tracer::SubmitZone(uint32_t track, const char* name, uint64_t beginTicks, double durationUs)
+	{
+		if (!IsCapturing())
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_collected.push_back({ { beginTicks, name, durationUs, TraceEventType::Zone }, track });
+	}
+
+	void Tracer::Collect()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& buffer : m_threads)
+		{
+			const uint32_t tail = buffer->tail.load(std::memory_order_acquire);
+			uint32_t head = buffer->head.load(std::memory_order_relaxed);
+			for (; head != tail; head++)
+			{
+				m_collected.push_back({ buffer->events[head & (TraceThreadBuffer::Capacity - 1)], buffer->threadId });
+			}
+			buffer->head.store(head, std::memory_order_release);
+		}
+
+		// drained and no longer written: keep the name for the trace, free the ring.
+		std::erase_if(m_threads, [this](const std::unique_ptr<TraceThreadBuffer>& buffer)
+		{
+			if (!buffer->exited)
+			{
+				return false;
+			}
+			m_exitedThreads.emplace_back(buffer->threadId, std::move(buffer->name));
+			m_exitedDropped += buffer->dropped.load(std::memory_order_relaxed);
+			return true;
+		});
+	}
+
+	bool Tracer::WriteChromeTrace(const std::string& path)
+	{
+		Collect();
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out.is_open())
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const double ticksPerUs = GetTicksPerMicrosecond();
+		auto toUs = [&](uint64_t ticks)
+		{
+			return ticks > m_startTicks ? static_cast<double>(ticks - m_startTicks) / ticksPerUs : 0.0;
+		};
+
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool first = true;
+		auto separator = [&]()
+		{
+			if (!first)
+			{
+				out << ",\n";
+			}
+			first = false;
+		};
+
+		auto writeThreadName = [&](uint32_t threadId, const std::string& name)
+		{
+			separator();
+			out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << threadId << ",\"args\":{\"name\":";
+			WriteJsonString(out, name.empty() ? ("Thread " + std::to_string(threadId)).c_str() : name.c_str());
+			out << "}}";
+		};
+		for (const auto& buffer : m_threads)
+		{
+			writeThreadName(buffer->threadId, buffer->name);
+		}
+		for (const auto& [threadId, name] : m_exitedThreads)
+		{
+			writeThreadName(threadId, name);
+		}
+		for (size_t i = 0; i < m_tracks.size(); i++)
+		{
+			separator();
+			out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << TrackIdBase + i << ",\"args\":{\"name\":";
+			WriteJsonString(out, m_tracks[i].c_str());
+			out << "}}";
+		}
+
+		out.precision(3);
+		out << std::fixed;
+		for (const CollectedEvent& collected : m_collected)
+		{
+			const TraceEvent& event = collected.event;
+			separator();
+			out << "{\"name\":";
+			WriteJsonString(out, event.name);
+			out << ",\"pid\":1,\"tid\":" << collected.threadId << ",\"ts\":" << toUs(event.ticks);
+
+			switch (event.type)
+			{
+			case TraceEventType::Begin:
+				out << ",\"ph\":\"B\"}";
+				break;
+			case TraceEventType::End:
+				out << ",\"ph\":\"E\"}";
+				break;
+			case TraceEventType::Counter:
+				out << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+				break;
+			case TraceEventType::Frame:
+				out << ",\"ph\":\"i\",\"s\":\"g\",\"args\":{\"frame\":" << static_cast<uint64_t>(event.value) << "}}";
+				break;
+			case TraceEventType::Zone:
+				out << ",\"ph\":\"X\",\"dur\":" << event.value << "}";
+				break;
+			}
+		}
+		out << "\n]}\n";
+		return out.good();
+	}
+
+	uint64_t Tracer::GetDroppedCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		uint64_t dropped = m_exitedDropped;
+		for (const auto& buffer : m_threads)
+		{
+			dropped += buffer->dropped.load(std::memory_order_relaxed);
+		}
+		return dropped;
+	}
+
+	void Tracer::Emit(const TraceEvent& event)
+	{
+		if (!m_capturing.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		GetThreadBuffer().Push(event);
+	}
+
+	Tracer::ThreadState& Tracer::GetThreadState()
+	{
+		thread_local ThreadState t_state;
+		return t_state;
+	}
+
+	TraceThreadBuffer& Tracer::GetThreadBuffer()
+	{
+		// only Emit gets here, so threads that never record during a capture never allocate.
+		ThreadState& state = GetThreadState();
+		if (state.buffer == nullptr)
+		{
+			auto buffer = std::make_unique<TraceThreadBuffer>();
+			buffer->name = state.name;
+			std::lock_guard<std::mutex> lock(m_mutex);
+			buffer->threadId = m_nextThreadId++;
+			state.buffer = buffer.get();
+			m_threads.push_back(std::move(buffer));
+		}
+		return *state.buffer;
+	}
+
+	void Tracer::ReleaseThreadBuffer(TraceThreadBuffer* buffer)
+	{
+		// the collector still owns the unread events, the next Collect frees the buffer.
+		std::lock_guard<std::mutex> lock(m_mutex);
+		buffer->exited = true;
+	}
+
+	double Tracer::GetTicksPerMicrosecond() const
+	{
+		// calibrated over the whole capture, long enough to make the TSC rate exact.
+		const uint64_t ticks = ReadTicks() - m_startTicks;
+		const double elapsedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_startTime).count();
+		if (ticks == 0 || elapsedUs <= 0.0)
+		{
+			return 1.0;
+		}
+		return static_cast<double>(ticks) / elapsedUs;
+	}
+}
@@ -61,6 +61,7 @@ namespace SB
         GLFWwindow* GetGLFWWindow() const { return m_window; }
     private:
         void InitWindow();
+        void InstallEventCallbacks();
         void Cleanup();
     private:
         WindowConfig m_config;
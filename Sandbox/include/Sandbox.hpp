@@ -2,6 +2,7 @@
 #define SANDBOX_H
 
 #include <State/SandBoxState.hpp>
+#include <Common/Event/EventBus.h>
 
 namespace att
 {
@@ -14,6 +15,7 @@ namespace att
 namespace Common
 {
 	class FileLogObserver;
+	struct WindowResizeEvent;
 }
 
 namespace SB
@@ -37,10 +39,12 @@ namespace SB
 		void Update();
 		void HandleEvents();
 		void Cleanup();
+		void OnWindowResize(const Common::WindowResizeEvent& event);
 	private:
 		SB::Window* m_window;
 		att::RHI::VulkanInstance* m_vulkanInstance;
 		std::shared_ptr<Common::FileLogObserver> m_fileLogObserver;
+		Common::EventSubscription m_resizeSubscription;
 
 		bool m_isRunning;
 	};
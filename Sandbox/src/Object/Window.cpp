@@ -1,4 +1,5 @@
 #include <Object/Window.hpp>
+#include <Common/Event/Events.h>
 #include <stdexcept>
 
 namespace SB
@@ -18,6 +19,8 @@ namespace SB
     {
         while (!ShouldClose()) {
             PollEvents();
+            // input and window events posted during the poll are delivered here, once per frame.
+            Common::EventBus::Get().DispatchDeferred();
             // Rendering code will go here in the future
         }
     }
@@ -51,6 +54,31 @@ namespace SB
         int windowPosX = (mode->width - m_config.windowSize.x) / 2;
         int windowPosY = (mode->height - m_config.windowSize.y) / 2;
         glfwSetWindowPos(m_window, windowPosX, windowPosY);
+
+        InstallEventCallbacks();
+    }
+
+    void Window::InstallEventCallbacks()
+    {
+        // GLFW calls these from glfwPollEvents, they only queue the event.
+        glfwSetFramebufferSizeCallback(m_window, [](GLFWwindow*, int width, int height) {
+            Common::EventBus::Get().Post(Common::WindowResizeEvent{ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+        });
+        glfwSetWindowCloseCallback(m_window, [](GLFWwindow*) {
+            Common::EventBus::Get().Post(Common::WindowCloseEvent{});
+        });
+        glfwSetKeyCallback(m_window, [](GLFWwindow*, int key, int scancode, int action, int mods) {
+            Common::EventBus::Get().Post(Common::KeyEvent{ key, scancode, action, mods });
+        });
+        glfwSetMouseButtonCallback(m_window, [](GLFWwindow*, int button, int action, int mods) {
+            Common::EventBus::Get().Post(Common::MouseButtonEvent{ button, action, mods });
+        });
+        glfwSetCursorPosCallback(m_window, [](GLFWwindow*, double x, double y) {
+            Common::EventBus::Get().Post(Common::MouseMoveEvent{ x, y });
+        });
+        glfwSetScrollCallback(m_window, [](GLFWwindow*, double offsetX, double offsetY) {
+            Common::EventBus::Get().Post(Common::MouseScrollEvent{ offsetX, offsetY });
+        });
     }
 
     void Window::Cleanup()
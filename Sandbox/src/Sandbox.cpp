@@ -4,6 +4,7 @@
 #include <Common/Logger/FileLogObserver.h>
 #include <Common/Logger/LogManager.h>
 #include <Common/Logger/GUIConsole.h>
+#include <Common/Event/Events.h>
 
 namespace SB
 {
@@ -29,6 +30,7 @@ namespace SB
 		// Initialize the window, Vulkan instance, and logging system here
 		m_window = new SB::Window(800, 600, "Sandbox Antutu Window");
 		LOG_INFO("init window sucessfully.");
+		m_resizeSubscription = Common::EventBus::Get().Subscribe<&Sandbox::OnWindowResize>(this);
 
 		// init vulkan instance with config
 		{
@@ -83,8 +85,14 @@ namespace SB
 
 	}
 
+	void Sandbox::OnWindowResize(const Common::WindowResizeEvent& event)
+	{
+		LOG_INFO("window resized to {0}x{1}.", event.width, event.height);
+	}
+
 	void Sandbox::Cleanup()
 	{
+		Common::EventBus::Get().Unsubscribe(m_resizeSubscription);
 		delete m_vulkanInstance;
 		m_vulkanInstance = nullptr;
 	}
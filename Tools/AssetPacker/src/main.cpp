@@ -0,0 +1,240 @@
+#include <ANTUTU/Asset/Archive.hpp>
+#include <ANTUTU/Asset/ArchiveWriter.hpp>
+#include <ANTUTU/Asset/Compression.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Logger/GUIConsole.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Packs loose files into a .apak archive, directories recursively with their
+// paths relative to the directory given, e.g.:
+//   AssetPacker --compress lz4 data/level1.apak cooked/level1
+//   AssetPacker --list data/level1.apak
+//
+// exit codes: 0 = success, 1 = failure, 2 = bad arguments.
+
+using namespace att::Asset;
+
+static void PrintUsage()
+{
+	std::cout <<
+		"AssetPacker [options] <output.apak> <file or directory>...\n"
+		"  --align N               blob alignment, 4096 (default) or 65536\n"
+		"  --compress C            none (default), lz4 or zstd\n"
+		"  --level N               codec level, 0 picks the default\n"
+		"  --min-saving F          store uncompressed unless it saves this fraction (0.1)\n"
+		"  --list FILE.apak        print the table of contents and exit\n";
+}
+
+static int ListArchive(const char* path)
+{
+	Archive archive;
+	if (!archive.Open(path))
+	{
+		std::cerr << "Can't open " << path << std::endl;
+		return 1;
+	}
+
+	// by offset: the order of the file, not of the lookup table.
+	std::vector<const ArchiveEntry*> entries;
+	for (uint32_t i = 0; i < archive.GetEntryCount(); i++)
+	{
+		entries.push_back(&archive.GetEntries()[i]);
+	}
+	std::sort(entries.begin(), entries.end(), [](const ArchiveEntry* a, const ArchiveEntry* b)
+	{
+		return a->offset < b->offset;
+	});
+
+	uint64_t rawBytes = 0;
+	for (const ArchiveEntry* entry : entries)
+	{
+		std::cout << entry->offset << '\t' << entry->size << '\t' << entry->rawSize << '\t'
+				  << GetCompressionName(entry->compression) << '\t' << archive.GetPath(*entry) << '\n';
+		rawBytes += entry->rawSize;
+	}
+	std::cout << entries.size() << " entries, " << rawBytes << " bytes in " << archive.GetHeader().fileSize
+			  << " (alignment " << archive.GetHeader().alignment << ")" << std::endl;
+	return 0;
+}
+
+static bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& bytes)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		return false;
+	}
+	bytes.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	return bytes.empty() || file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+int main(int argc, char** argv)
+{
+	// the archive code logs its own errors.
+	Common::LogManager::Get().Init();
+	Common::LogManager::Get().AddObserver(std::make_shared<Common::GUIConsole>());
+
+	uint32_t alignment = ArchiveSmallAlignment;
+	ArchiveCompression compression = ArchiveCompression::None;
+	int level = 0;
+	float minSaving = 0.1f;
+	std::vector<const char*> positional;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		auto takesValue = [&]()
+		{
+			if (value == nullptr)
+			{
+				std::cerr << arg << " needs a value" << std::endl;
+				std::exit(2);
+			}
+			i++;
+			return value;
+		};
+
+		if (strcmp(arg, "--align") == 0)
+		{
+			alignment = static_cast<uint32_t>(std::strtoul(takesValue(), nullptr, 10));
+			if (alignment < 8 || (alignment & (alignment - 1)) != 0)
+			{
+				std::cerr << "--align needs a power of two of at least 8" << std::endl;
+				return 2;
+			}
+		}
+		else if (strcmp(arg, "--compress") == 0)
+		{
+			const char* name = takesValue();
+			if (strcmp(name, "none") == 0)
+			{
+				compression = ArchiveCompression::None;
+			}
+			else if (strcmp(name, "lz4") == 0)
+			{
+				compression = ArchiveCompression::LZ4;
+			}
+			else if (strcmp(name, "zstd") == 0)
+			{
+				compression = ArchiveCompression::Zstd;
+			}
+			else
+			{
+				std::cerr << "unknown compression " << name << std::endl;
+				return 2;
+			}
+			if (!IsCompressionSupported(compression))
+			{
+				std::cerr << name << " isn't available in this build" << std::endl;
+				return 2;
+			}
+		}
+		else if (strcmp(arg, "--level") == 0)
+		{
+			level = std::atoi(takesValue());
+		}
+		else if (strcmp(arg, "--min-saving") == 0)
+		{
+			minSaving = static_cast<float>(std::strtod(takesValue(), nullptr));
+		}
+		else if (strcmp(arg, "--list") == 0)
+		{
+			const int result = ListArchive(takesValue());
+			spdlog::shutdown();
+			return result;
+		}
+		else if (arg[0] == '-')
+		{
+			PrintUsage();
+			return strcmp(arg, "--help") == 0 ? EXIT_SUCCESS : 2;
+		}
+		else
+		{
+			positional.push_back(arg);
+		}
+	}
+
+	if (positional.size() < 2)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	// (file, path in the archive), sorted so the same inputs give the same archive.
+	std::vector<std::pair<std::filesystem::path, std::string>> inputs;
+	for (size_t i = 1; i < positional.size(); i++)
+	{
+		const std::filesystem::path input(positional[i]);
+		std::error_code error;
+		if (std::filesystem::is_directory(input, error))
+		{
+			for (const auto& item : std::filesystem::recursive_directory_iterator(input, error))
+			{
+				if (item.is_regular_file())
+				{
+					inputs.emplace_back(item.path(), std::filesystem::relative(item.path(), input).generic_string());
+				}
+			}
+		}
+		else if (std::filesystem::is_regular_file(input, error))
+		{
+			inputs.emplace_back(input, input.filename().generic_string());
+		}
+		else
+		{
+			std::cerr << positional[i] << " doesn't exist" << std::endl;
+			spdlog::shutdown();
+			return 1;
+		}
+	}
+	std::sort(inputs.begin(), inputs.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+
+	ArchiveWriter writer;
+	if (!writer.Open(positional[0], alignment))
+	{
+		std::cerr << "Can't create " << positional[0] << std::endl;
+		spdlog::shutdown();
+		return 1;
+	}
+
+	std::vector<uint8_t> bytes;
+	for (const auto& [file, path] : inputs)
+	{
+		if (!ReadFile(file, bytes))
+		{
+			std::cerr << "Can't read " << file.string() << std::endl;
+			spdlog::shutdown();
+			return 1;
+		}
+		if (!writer.Add(path, bytes.data(), bytes.size(), compression, level, minSaving))
+		{
+			std::cerr << "Can't add " << path << " (duplicate path or write error)" << std::endl;
+			spdlog::shutdown();
+			return 1;
+		}
+	}
+
+	const uint64_t rawBytes = writer.GetRawBytes();
+	const uint64_t storedBytes = writer.GetStoredBytes();
+	if (!writer.Finish())
+	{
+		std::cerr << "Failed to write " << positional[0] << std::endl;
+		spdlog::shutdown();
+		return 1;
+	}
+
+	std::cout << positional[0] << ": " << inputs.size() << " files, " << rawBytes << " bytes stored in " << storedBytes << std::endl;
+	spdlog::shutdown();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,44 @@
+#ifndef MESH_COOKER_JSON_H
+#define MESH_COOKER_JSON_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Cooker
+{
+	// just enough JSON for glTF: no \u escapes beyond the basic plane, numbers as double.
+	struct JsonValue
+	{
+		enum class Type
+		{
+			Null,
+			Bool,
+			Number,
+			String,
+			Array,
+			Object
+		};
+
+		Type type = Type::Null;
+		bool boolean = false;
+		double number = 0.0;
+		std::string string;
+		// array items, or object members (names in keys).
+		std::vector<JsonValue> items;
+		std::vector<std::string> keys;
+
+		// nullptr when missing or not an object.
+		const JsonValue* Find(std::string_view key) const;
+		size_t GetSize() const { return type == Type::Array ? items.size() : 0; }
+
+		double GetNumber(std::string_view key, double fallback) const;
+		const std::string* GetString(std::string_view key) const;
+	};
+
+	// false on a syntax error, error receives where.
+	bool ParseJson(std::string_view text, JsonValue& value, std::string& error);
+}
+
+#endif	// MESH_COOKER_JSON_H
@@ -0,0 +1,45 @@
+#ifndef MESH_COOKER_MESH_COOKER_H
+#define MESH_COOKER_MESH_COOKER_H
+
+#include <MeshImporter.hpp>
+#include <ANTUTU/Asset/MeshFormat.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Cooker
+{
+	struct CookSettings
+	{
+		// LOD 0 included, at most CookedMeshMaxLods.
+		uint32_t lodCount = 4;
+		// triangles of LOD n+1 relative to LOD n.
+		float lodRatio = 0.5f;
+		// how far a LOD may move the surface, as a fraction of the mesh extent.
+		float lodMaxError = 0.02f;
+		// ACMR given up for the overdraw order, 1 keeps the cache order.
+		float overdrawThreshold = 1.05f;
+	};
+
+	struct CookReport
+	{
+		// FIFO 16 ACMR of LOD 0 as imported and as cooked.
+		float sourceAcmr = 0.0f;
+		float cookedAcmr = 0.0f;
+		// float position, normal, uv (and tangent) with 32-bit indices.
+		uint64_t sourceBytes = 0;
+		// what drawing LOD 0 reads: the packed vertices and its indices.
+		uint64_t cookedLod0Bytes = 0;
+		// the blob, every LOD.
+		uint64_t cookedBytes = 0;
+		uint32_t vertexCount = 0;
+		uint32_t lodCount = 0;
+		uint32_t lodTriangles[att::Asset::CookedMeshMaxLods] = {};
+		float lodErrors[att::Asset::CookedMeshMaxLods] = {};
+	};
+
+	// the CookedMeshHeader blob of MeshFormat.hpp.
+	void CookMesh(const ImportedMesh& mesh, const CookSettings& settings, std::vector<uint8_t>& blob, CookReport& report);
+}
+
+#endif	// MESH_COOKER_MESH_COOKER_H
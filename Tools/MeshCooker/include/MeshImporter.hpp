@@ -0,0 +1,34 @@
+#ifndef MESH_COOKER_MESH_IMPORTER_H
+#define MESH_COOKER_MESH_IMPORTER_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Cooker
+{
+	// one indexed triangle list, every attribute per vertex. The importers flatten the
+	// scene: every primitive is merged in object space of the root.
+	struct ImportedMesh
+	{
+		std::vector<glm::vec3> positions;
+		// empty when the source has none, see GenerateNormals.
+		std::vector<glm::vec3> normals;
+		std::vector<glm::vec2> uvs;
+		// xyz, w = bitangent sign; empty when the source has none.
+		std::vector<glm::vec4> tangents;
+		std::vector<uint32_t> indices;
+	};
+
+	// .obj (polygons fanned, negative indices) or .gltf / .glb (triangle primitives of the
+	// default scene, external, embedded or base64 buffers). error says why it failed.
+	bool ImportMesh(const std::filesystem::path& path, ImportedMesh& mesh, std::string& error);
+
+	// area weighted, vertices at the same position are smoothed together.
+	void GenerateNormals(ImportedMesh& mesh);
+}
+
+#endif	// MESH_COOKER_MESH_IMPORTER_H
@@ -0,0 +1,251 @@
+#include <Json.hpp>
+
+#include <cstdlib>
+
+namespace Cooker
+{
+	const JsonValue* JsonValue::Find(std::string_view key) const
+	{
+		if (type != Type::Object)
+		{
+			return nullptr;
+		}
+		for (size_t i = 0; i < keys.size(); i++)
+		{
+			if (keys[i] == key)
+			{
+				return &items[i];
+			}
+		}
+		return nullptr;
+	}
+
+	double JsonValue::GetNumber(std::string_view key, double fallback) const
+	{
+		const JsonValue* value = Find(key);
+		return value != nullptr && value->type == Type::Number ? value->number : fallback;
+	}
+
+	const std::string* JsonValue::GetString(std::string_view key) const
+	{
+		const JsonValue* value = Find(key);
+		return value != nullptr && value->type == Type::String ? &value->string : nullptr;
+	}
+
+	namespace
+	{
+		class JsonParser
+		{
+		public:
+			explicit JsonParser(std::string_view text) : m_text(text) {}
+
+			bool Parse(JsonValue& value, std::string& error)
+			{
+				if (!ParseValue(value, 0) || (SkipSpace(), m_position != m_text.size()))
+				{
+					error = "JSON syntax error at byte " + std::to_string(m_position);
+					return false;
+				}
+				return true;
+			}
+
+		private:
+			static constexpr int MaxDepth = 256;
+
+			void SkipSpace()
+			{
+				while (m_position < m_text.size() &&
+					   (m_text[m_position] == ' ' || m_text[m_position] == '\t' || m_text[m_position] == '\n' || m_text[m_position] == '\r'))
+				{
+					m_position++;
+				}
+			}
+
+			bool Consume(char c)
+			{
+				SkipSpace();
+				if (m_position < m_text.size() && m_text[m_position] == c)
+				{
+					m_position++;
+					return true;
+				}
+				return false;
+			}
+
+			bool ConsumeWord(std::string_view word)
+			{
+				if (m_text.substr(m_position, word.size()) == word)
+				{
+					m_position += word.size();
+					return true;
+				}
+				return false;
+			}
+
+			static void AppendUtf8(std::string& out, uint32_t code)
+			{
+				if (code < 0x80)
+				{
+					out += static_cast<char>(code);
+				}
+				else if (code < 0x800)
+				{
+					out += static_cast<char>(0xC0 | (code >> 6));
+					out += static_cast<char>(0x80 | (code & 0x3F));
+				}
+				else
+				{
+					out += static_cast<char>(0xE0 | (code >> 12));
+					out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+					out += static_cast<char>(0x80 | (code & 0x3F));
+				}
+			}
+
+			bool ParseString(std::string& out)
+			{
+				if (!Consume('"'))
+				{
+					return false;
+				}
+				while (m_position < m_text.size())
+				{
+					const char c = m_text[m_position++];
+					if (c == '"')
+					{
+						return true;
+					}
+					if (c != '\\')
+					{
+						out += c;
+						continue;
+					}
+					if (m_position >= m_text.size())
+					{
+						return false;
+					}
+					switch (m_text[m_position++])
+					{
+					case '"': out += '"'; break;
+					case '\\': out += '\\'; break;
+					case '/': out += '/'; break;
+					case 'b': out += '\b'; break;
+					case 'f': out += '\f'; break;
+					case 'n': out += '\n'; break;
+					case 'r': out += '\r'; break;
+					case 't': out += '\t'; break;
+					case 'u':
+					{
+						if (m_position + 4 > m_text.size())
+						{
+							return false;
+						}
+						const std::string digits(m_text.substr(m_position, 4));
+						char* end = nullptr;
+						const uint32_t code = static_cast<uint32_t>(std::strtoul(digits.c_str(), &end, 16));
+						if (end != digits.c_str() + 4)
+						{
+							return false;
+						}
+						AppendUtf8(out, code);
+						m_position += 4;
+						break;
+					}
+					default:
+						return false;
+					}
+				}
+				return false;
+			}
+
+			bool ParseValue(JsonValue& value, int depth)
+			{
+				SkipSpace();
+				if (m_position >= m_text.size() || depth > MaxDepth)
+				{
+					return false;
+				}
+
+				const char c = m_text[m_position];
+				if (c == '{')
+				{
+					m_position++;
+					value.type = JsonValue::Type::Object;
+					if (Consume('}'))
+					{
+						return true;
+					}
+					do
+					{
+						value.keys.emplace_back();
+						value.items.emplace_back();
+						if (!ParseString(value.keys.back()) || !Consume(':') || !ParseValue(value.items.back(), depth + 1))
+						{
+							return false;
+						}
+					} while (Consume(','));
+					return Consume('}');
+				}
+				if (c == '[')
+				{
+					m_position++;
+					value.type = JsonValue::Type::Array;
+					if (Consume(']'))
+					{
+						return true;
+					}
+					do
+					{
+						value.items.emplace_back();
+						if (!ParseValue(value.items.back(), depth + 1))
+						{
+							return false;
+						}
+					} while (Consume(','));
+					return Consume(']');
+				}
+				if (c == '"')
+				{
+					value.type = JsonValue::Type::String;
+					return ParseString(value.string);
+				}
+				if (ConsumeWord("true") || ConsumeWord("false"))
+				{
+					value.type = JsonValue::Type::Bool;
+					value.boolean = c == 't';
+					return true;
+				}
+				if (ConsumeWord("null"))
+				{
+					value.type = JsonValue::Type::Null;
+					return true;
+				}
+
+				// strtod needs a terminator, numbers are short.
+				size_t end = m_position;
+				while (end < m_text.size() && std::string_view("+-0123456789.eE").find(m_text[end]) != std::string_view::npos)
+				{
+					end++;
+				}
+				const std::string digits(m_text.substr(m_position, end - m_position));
+				char* parsed = nullptr;
+				value.type = JsonValue::Type::Number;
+				value.number = std::strtod(digits.c_str(), &parsed);
+				if (digits.empty() || parsed != digits.c_str() + digits.size())
+				{
+					return false;
+				}
+				m_position = end;
+				return true;
+			}
+
+			std::string_view m_text;
+			size_t m_position = 0;
+		};
+	}
+
+	bool ParseJson(std::string_view text, JsonValue& value, std::string& error)
+	{
+		value = {};
+		return JsonParser(text).Parse(value, error);
+	}
+}
@@ -0,0 +1,163 @@
+#include <MeshCooker.hpp>
+#include <ANTUTU/Render/MeshOptimizer.hpp>
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace att::Asset;
+using att::Render::MeshOptimizer;
+
+namespace Cooker
+{
+	static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	void CookMesh(const ImportedMesh& mesh, const CookSettings& settings, std::vector<uint8_t>& blob, CookReport& report)
+	{
+		report = {};
+		const size_t vertexCount = mesh.positions.size();
+		const float* positions = &mesh.positions[0].x;
+		const size_t stride = sizeof(glm::vec3);
+		const bool hasTangents = !mesh.tangents.empty();
+
+		report.sourceAcmr = MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), vertexCount).acmr;
+		const uint64_t sourceVertexSize = sizeof(glm::vec3) * 2 + (mesh.uvs.empty() ? 0 : sizeof(glm::vec2)) +
+										  (hasTangents ? sizeof(glm::vec4) : 0);
+		report.sourceBytes = vertexCount * sourceVertexSize + mesh.indices.size() * sizeof(uint32_t);
+
+		// LOD 0: cache order first, then its clusters outside-in.
+		std::vector<std::vector<uint32_t>> lods(1, mesh.indices);
+		MeshOptimizer::OptimizeVertexCache(lods[0].data(), lods[0].size(), vertexCount);
+		MeshOptimizer::OptimizeOverdraw(lods[0].data(), lods[0].size(), positions, vertexCount, stride, settings.overdrawThreshold);
+		report.cookedAcmr = MeshOptimizer::AnalyzeVertexCache(lods[0].data(), lods[0].size(), vertexCount).acmr;
+
+		// every LOD from LOD 0, so the errors don't add up along the chain.
+		const float extent = MeshOptimizer::GetMeshExtent(positions, vertexCount, stride);
+		const uint32_t lodCount = std::clamp(settings.lodCount, 1u, CookedMeshMaxLods);
+		for (uint32_t i = 1; i < lodCount; i++)
+		{
+			const size_t target = static_cast<size_t>(static_cast<double>(lods[0].size() / 3) * std::pow(settings.lodRatio, i)) * 3;
+			std::vector<uint32_t> lod(lods[0].size());
+			float error = 0.0f;
+			lod.resize(MeshOptimizer::Simplify(lod.data(), lods[0].data(), lods[0].size(), positions, vertexCount, stride,
+											   target, settings.lodMaxError, &error));
+			// the error bound or the locked borders stop it: another LOD wouldn't save much.
+			if (lod.empty() || lod.size() * 10 > lods.back().size() * 9)
+			{
+				break;
+			}
+			MeshOptimizer::OptimizeVertexCache(lod.data(), lod.size(), vertexCount);
+			report.lodErrors[lods.size()] = error * extent;
+			lods.push_back(std::move(lod));
+		}
+
+		// vertices in first use order over LOD 0, then what the coarser LODs add (nothing, they
+		// only collapse onto existing vertices): the unused ones are dropped.
+		std::vector<uint32_t> indices;
+		CookedMeshLod lodRanges[CookedMeshMaxLods] = {};
+		for (size_t i = 0; i < lods.size(); i++)
+		{
+			lodRanges[i].indexOffset = static_cast<uint32_t>(indices.size());
+			lodRanges[i].indexCount = static_cast<uint32_t>(lods[i].size());
+			lodRanges[i].error = report.lodErrors[i];
+			report.lodTriangles[i] = static_cast<uint32_t>(lods[i].size() / 3);
+			indices.insert(indices.end(), lods[i].begin(), lods[i].end());
+		}
+		size_t cookedVertexCount = 0;
+		const std::vector<uint32_t> remap = MeshOptimizer::OptimizeVertexFetch(indices.data(), indices.size(), vertexCount, &cookedVertexCount);
+
+		glm::vec3 minimum(std::numeric_limits<float>::max());
+		glm::vec3 maximum(-std::numeric_limits<float>::max());
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			if (remap[v] != ~0u)
+			{
+				minimum = glm::min(minimum, mesh.positions[v]);
+				maximum = glm::max(maximum, mesh.positions[v]);
+			}
+		}
+		const glm::vec3 size = maximum - minimum;
+		const glm::vec3 center = (minimum + maximum) * 0.5f;
+		float radius = 0.0f;
+
+		std::vector<PackedVertex> vertices(cookedVertexCount);
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			if (remap[v] == ~0u)
+			{
+				continue;
+			}
+
+			PackedVertex& packed = vertices[remap[v]];
+			const glm::vec3& p = mesh.positions[v];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float unorm = size[axis] > 0.0f ? (p[axis] - minimum[axis]) / size[axis] : 0.0f;
+				packed.position[axis] = static_cast<uint16_t>(std::lround(std::clamp(unorm, 0.0f, 1.0f) * 65535.0f));
+			}
+			packed.position[3] = 0;
+
+			const glm::vec4 tangent = hasTangents ? mesh.tangents[v] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			packed.normal = PackNormalTangent(mesh.normals[v], glm::vec3(tangent), tangent.w);
+			const glm::vec2 uv = mesh.uvs.empty() ? glm::vec2(0.0f) : mesh.uvs[v];
+			packed.uv[0] = glm::packHalf1x16(uv.x);
+			packed.uv[1] = glm::packHalf1x16(uv.y);
+
+			radius = std::max(radius, glm::length(p - center));
+		}
+
+		CookedMeshHeader header = {};
+		header.magic = CookedMeshMagic;
+		header.version = CookedMeshVersion;
+		const bool index16 = cookedVertexCount <= 65536;
+		header.flags = (index16 ? CookedMeshIndex16 : 0u) | (hasTangents ? CookedMeshTangents : 0u);
+		header.vertexCount = static_cast<uint32_t>(cookedVertexCount);
+		header.indexCount = static_cast<uint32_t>(indices.size());
+		header.lodCount = static_cast<uint32_t>(lods.size());
+		for (int axis = 0; axis < 3; axis++)
+		{
+			header.positionOffset[axis] = minimum[axis];
+			header.positionScale[axis] = size[axis];
+		}
+		header.boundingSphere[0] = center.x;
+		header.boundingSphere[1] = center.y;
+		header.boundingSphere[2] = center.z;
+		header.boundingSphere[3] = radius;
+		std::copy(lodRanges, lodRanges + CookedMeshMaxLods, header.lods);
+
+		const uint64_t vertexBytes = vertices.size() * sizeof(PackedVertex);
+		const uint64_t indexBytes = indices.size() * (index16 ? sizeof(uint16_t) : sizeof(uint32_t));
+		header.vertexOffset = AlignUp(sizeof(CookedMeshHeader), 16);
+		header.indexOffset = AlignUp(header.vertexOffset + vertexBytes, 16);
+
+		blob.assign(header.indexOffset + indexBytes, 0);
+		memcpy(blob.data(), &header, sizeof(header));
+		if (vertexBytes > 0)
+		{
+			memcpy(blob.data() + header.vertexOffset, vertices.data(), vertexBytes);
+		}
+		if (index16)
+		{
+			uint16_t* out = reinterpret_cast<uint16_t*>(blob.data() + header.indexOffset);
+			for (size_t i = 0; i < indices.size(); i++)
+			{
+				out[i] = static_cast<uint16_t>(indices[i]);
+			}
+		}
+		else if (indexBytes > 0)
+		{
+			memcpy(blob.data() + header.indexOffset, indices.data(), indexBytes);
+		}
+
+		report.cookedLod0Bytes = vertexBytes + lods[0].size() * (index16 ? sizeof(uint16_t) : sizeof(uint32_t));
+		report.cookedBytes = blob.size();
+		report.vertexCount = header.vertexCount;
+		report.lodCount = header.lodCount;
+	}
+}
@@ -0,0 +1,780 @@
+#include <MeshImporter.hpp>
+#include <Json.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace Cooker
+{
+	static bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& bytes)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+		bytes.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		return bytes.empty() || file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	struct PositionHash
+	{
+		size_t operator()(const glm::vec3& p) const
+		{
+			uint32_t bits[3];
+			memcpy(bits, &p, sizeof(bits));
+			return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+		}
+	};
+
+	void GenerateNormals(ImportedMesh& mesh)
+	{
+		std::unordered_map<glm::vec3, uint32_t, PositionHash> firsts;
+		std::vector<uint32_t> welded(mesh.positions.size());
+		for (size_t v = 0; v < mesh.positions.size(); v++)
+		{
+			welded[v] = firsts.emplace(mesh.positions[v], static_cast<uint32_t>(v)).first->second;
+		}
+
+		std::vector<glm::vec3> sums(mesh.positions.size(), glm::vec3(0.0f));
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+		{
+			const glm::vec3& a = mesh.positions[mesh.indices[i]];
+			// not normalized: weighted by the area.
+			const glm::vec3 normal = glm::cross(mesh.positions[mesh.indices[i + 1]] - a, mesh.positions[mesh.indices[i + 2]] - a);
+			for (int k = 0; k < 3; k++)
+			{
+				sums[welded[mesh.indices[i + k]]] += normal;
+			}
+		}
+
+		mesh.normals.resize(mesh.positions.size());
+		for (size_t v = 0; v < mesh.positions.size(); v++)
+		{
+			const glm::vec3& sum = sums[welded[v]];
+			const float length = glm::length(sum);
+			mesh.normals[v] = length > 0.0f ? sum / length : glm::vec3(0.0f, 0.0f, 1.0f);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// OBJ
+	////////////////////////////////////////////////////////////////////////////
+
+	struct ObjCorner
+	{
+		int32_t position;
+		int32_t uv;
+		int32_t normal;
+
+		bool operator==(const ObjCorner& other) const
+		{
+			return position == other.position && uv == other.uv && normal == other.normal;
+		}
+	};
+
+	struct ObjCornerHash
+	{
+		size_t operator()(const ObjCorner& c) const
+		{
+			return (static_cast<uint32_t>(c.position) * 73856093u) ^ (static_cast<uint32_t>(c.uv) * 19349663u) ^
+				   (static_cast<uint32_t>(c.normal) * 83492791u);
+		}
+	};
+
+	// 1 based, negative from the end, 0 = absent. -1 when out of range.
+	static int32_t ResolveObjIndex(long index, size_t count)
+	{
+		if (index == 0)
+		{
+			return -2;
+		}
+		const long resolved = index > 0 ? index - 1 : static_cast<long>(count) + index;
+		return resolved >= 0 && resolved < static_cast<long>(count) ? static_cast<int32_t>(resolved) : -1;
+	}
+
+	static bool ImportObj(const std::vector<uint8_t>& bytes, ImportedMesh& mesh, std::string& error)
+	{
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec2> uvs;
+		std::vector<glm::vec3> normals;
+		std::unordered_map<ObjCorner, uint32_t, ObjCornerHash> vertices;
+		std::vector<uint32_t> polygon;
+		bool missingNormals = false;
+
+		// every line null terminated in place, so strtof/strtol stop at its end.
+		std::string text(bytes.begin(), bytes.end());
+		text += '\n';
+		size_t lineNumber = 0;
+		for (size_t begin = 0; begin < text.size();)
+		{
+			const size_t end = text.find('\n', begin);
+			text[end] = '\0';
+			char* line = &text[begin];
+			begin = end + 1;
+			lineNumber++;
+
+			while (*line == ' ' || *line == '\t')
+			{
+				line++;
+			}
+			auto readFloats = [&line](float* values, int count)
+			{
+				for (int i = 0; i < count; i++)
+				{
+					char* next = nullptr;
+					values[i] = std::strtof(line, &next);
+					if (next == line)
+					{
+						return false;
+					}
+					line = next;
+				}
+				return true;
+			};
+
+			if (line[0] == 'v' && (line[1] == ' ' || line[1] == '\t'))
+			{
+				line += 2;
+				glm::vec3 p;
+				if (!readFloats(glm::value_ptr(p), 3))
+				{
+					error = "bad vertex on line " + std::to_string(lineNumber);
+					return false;
+				}
+				positions.push_back(p);
+			}
+			else if (line[0] == 'v' && line[1] == 't')
+			{
+				line += 2;
+				glm::vec2 uv(0.0f);
+				readFloats(glm::value_ptr(uv), 1);
+				readFloats(&uv.y, 1);
+				// OBJ has v going up, the engine (like glTF) down.
+				uvs.emplace_back(uv.x, 1.0f - uv.y);
+			}
+			else if (line[0] == 'v' && line[1] == 'n')
+			{
+				line += 2;
+				glm::vec3 n;
+				if (!readFloats(glm::value_ptr(n), 3))
+				{
+					error = "bad normal on line " + std::to_string(lineNumber);
+					return false;
+				}
+				normals.push_back(n);
+			}
+			else if (line[0] == 'f' && (line[1] == ' ' || line[1] == '\t'))
+			{
+				line += 2;
+				polygon.clear();
+				for (;;)
+				{
+					while (*line == ' ' || *line == '\t' || *line == '\r')
+					{
+						line++;
+					}
+					if (*line == '\0' || *line == '#')
+					{
+						break;
+					}
+
+					long fields[3] = { 0, 0, 0 };
+					for (int field = 0; field < 3; field++)
+					{
+						char* next = nullptr;
+						fields[field] = std::strtol(line, &next, 10);
+						line = next;
+						if (*line != '/')
+						{
+							break;
+						}
+						line++;
+					}
+					ObjCorner corner{ ResolveObjIndex(fields[0], positions.size()),
+									  ResolveObjIndex(fields[1], uvs.size()),
+									  ResolveObjIndex(fields[2], normals.size()) };
+					if (corner.position < 0 || corner.uv == -1 || corner.normal == -1)
+					{
+						error = "bad face index on line " + std::to_string(lineNumber);
+						return false;
+					}
+					missingNormals |= corner.normal < 0;
+
+					const auto [it, inserted] = vertices.emplace(corner, static_cast<uint32_t>(mesh.positions.size()));
+					if (inserted)
+					{
+						mesh.positions.push_back(positions[corner.position]);
+						mesh.uvs.push_back(corner.uv >= 0 ? uvs[corner.uv] : glm::vec2(0.0f));
+						mesh.normals.push_back(corner.normal >= 0 ? normals[corner.normal] : glm::vec3(0.0f));
+					}
+					polygon.push_back(it->second);
+				}
+
+				for (size_t i = 2; i < polygon.size(); i++)
+				{
+					mesh.indices.insert(mesh.indices.end(), { polygon[0], polygon[i - 1], polygon[i] });
+				}
+			}
+		}
+
+		if (missingNormals)
+		{
+			mesh.normals.clear();
+		}
+		if (uvs.empty())
+		{
+			mesh.uvs.clear();
+		}
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// glTF 2.0
+	////////////////////////////////////////////////////////////////////////////
+
+	namespace
+	{
+		struct Gltf
+		{
+			JsonValue json;
+			std::vector<std::vector<uint8_t>> buffers;
+		};
+
+		struct AccessorData
+		{
+			const uint8_t* data = nullptr;
+			size_t stride = 0;
+			size_t count = 0;
+			uint32_t componentType = 0;
+			uint32_t components = 0;
+			bool normalized = false;
+		};
+	}
+
+	static bool DecodeBase64(std::string_view text, std::vector<uint8_t>& bytes)
+	{
+		uint32_t bits = 0;
+		int bitCount = 0;
+		for (char c : text)
+		{
+			int value;
+			if (c >= 'A' && c <= 'Z') value = c - 'A';
+			else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+			else if (c >= '0' && c <= '9') value = c - '0' + 52;
+			else if (c == '+' || c == '-') value = 62;
+			else if (c == '/' || c == '_') value = 63;
+			else if (c == '=') break;
+			else return false;
+
+			bits = (bits << 6) | static_cast<uint32_t>(value);
+			bitCount += 6;
+			if (bitCount >= 8)
+			{
+				bitCount -= 8;
+				bytes.push_back(static_cast<uint8_t>(bits >> bitCount));
+			}
+		}
+		return true;
+	}
+
+	static std::string DecodeUri(std::string_view uri)
+	{
+		std::string result;
+		for (size_t i = 0; i < uri.size(); i++)
+		{
+			if (uri[i] == '%' && i + 2 < uri.size())
+			{
+				const std::string digits(uri.substr(i + 1, 2));
+				result += static_cast<char>(std::strtol(digits.c_str(), nullptr, 16));
+				i += 2;
+			}
+			else
+			{
+				result += uri[i];
+			}
+		}
+		return result;
+	}
+
+	static bool LoadGltf(const std::filesystem::path& path, std::vector<uint8_t>& bytes, Gltf& gltf, std::string& error)
+	{
+		std::string_view jsonText(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		std::vector<uint8_t> binaryChunk;
+		bool hasBinaryChunk = false;
+
+		uint32_t header[3] = {};
+		if (bytes.size() >= sizeof(header))
+		{
+			memcpy(header, bytes.data(), sizeof(header));
+		}
+		if (header[0] == 0x46546C67) // "glTF"
+		{
+			if (header[1] != 2 || header[2] > bytes.size())
+			{
+				error = "unsupported .glb version or truncated file";
+				return false;
+			}
+			jsonText = {};
+			for (size_t offset = sizeof(header); offset + 8 <= header[2];)
+			{
+				uint32_t chunk[2];
+				memcpy(chunk, bytes.data() + offset, sizeof(chunk));
+				offset += sizeof(chunk);
+				if (chunk[0] > header[2] - offset)
+				{
+					error = "truncated .glb chunk";
+					return false;
+				}
+				if (chunk[1] == 0x4E4F534A) // "JSON"
+				{
+					jsonText = std::string_view(reinterpret_cast<const char*>(bytes.data() + offset), chunk[0]);
+				}
+				else if (chunk[1] == 0x004E4942 && !hasBinaryChunk) // "BIN"
+				{
+					binaryChunk.assign(bytes.data() + offset, bytes.data() + offset + chunk[0]);
+					hasBinaryChunk = true;
+				}
+				offset += (chunk[0] + 3) & ~3u;
+			}
+		}
+
+		if (!ParseJson(jsonText, gltf.json, error))
+		{
+			return false;
+		}
+
+		const JsonValue* buffers = gltf.json.Find("buffers");
+		for (size_t i = 0; buffers != nullptr && i < buffers->GetSize(); i++)
+		{
+			const JsonValue& buffer = buffers->items[i];
+			const std::string* uri = buffer.GetString("uri");
+			std::vector<uint8_t>& data = gltf.buffers.emplace_back();
+			if (uri == nullptr)
+			{
+				if (i != 0 || !hasBinaryChunk)
+				{
+					error = "buffer " + std::to_string(i) + " has no data";
+					return false;
+				}
+				data = std::move(binaryChunk);
+			}
+			else if (uri->compare(0, 5, "data:") == 0)
+			{
+				const size_t comma = uri->find(',');
+				if (comma == std::string::npos || uri->rfind(";base64", comma) == std::string::npos ||
+					!DecodeBase64(std::string_view(*uri).substr(comma + 1), data))
+				{
+					error = "buffer " + std::to_string(i) + " has an unsupported data URI";
+					return false;
+				}
+			}
+			else if (!ReadFile(path.parent_path() / std::filesystem::u8path(DecodeUri(*uri)), data))
+			{
+				error = "can't read buffer " + *uri;
+				return false;
+			}
+
+			if (data.size() < static_cast<size_t>(buffer.GetNumber("byteLength", 0.0)))
+			{
+				error = "buffer " + std::to_string(i) + " is shorter than its byteLength";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static uint32_t GetComponentSize(uint32_t componentType)
+	{
+		switch (componentType)
+		{
+		case 5120: case 5121: return 1;
+		case 5122: case 5123: return 2;
+		case 5125: case 5126: return 4;
+		default: return 0;
+		}
+	}
+
+	static bool GetAccessor(const Gltf& gltf, const JsonValue* index, AccessorData& accessor, std::string& error)
+	{
+		const JsonValue* accessors = gltf.json.Find("accessors");
+		const JsonValue* views = gltf.json.Find("bufferViews");
+		if (index == nullptr || index->type != JsonValue::Type::Number || accessors == nullptr ||
+			index->number < 0 || index->number >= accessors->GetSize())
+		{
+			error = "bad accessor index";
+			return false;
+		}
+		const JsonValue& json = accessors->items[static_cast<size_t>(index->number)];
+		if (json.Find("sparse") != nullptr)
+		{
+			error = "sparse accessors aren't supported";
+			return false;
+		}
+
+		static constexpr std::pair<const char*, uint32_t> Types[] = { { "SCALAR", 1 }, { "VEC2", 2 }, { "VEC3", 3 }, { "VEC4", 4 } };
+		const std::string* type = json.GetString("type");
+		accessor.components = 0;
+		for (const auto& [name, components] : Types)
+		{
+			accessor.components = type != nullptr && *type == name ? components : accessor.components;
+		}
+		accessor.componentType = static_cast<uint32_t>(json.GetNumber("componentType", 0.0));
+		accessor.count = static_cast<size_t>(json.GetNumber("count", 0.0));
+		const JsonValue* normalized = json.Find("normalized");
+		accessor.normalized = normalized != nullptr && normalized->boolean;
+
+		const uint32_t elementSize = accessor.components * GetComponentSize(accessor.componentType);
+		const double viewIndex = json.GetNumber("bufferView", -1.0);
+		if (elementSize == 0 || views == nullptr || viewIndex < 0 || viewIndex >= views->GetSize())
+		{
+			error = "unsupported accessor (no buffer view or unknown type)";
+			return false;
+		}
+
+		const JsonValue& view = views->items[static_cast<size_t>(viewIndex)];
+		const double bufferIndex = view.GetNumber("buffer", -1.0);
+		if (bufferIndex < 0 || bufferIndex >= gltf.buffers.size())
+		{
+			error = "bad buffer index";
+			return false;
+		}
+		const std::vector<uint8_t>& buffer = gltf.buffers[static_cast<size_t>(bufferIndex)];
+		const size_t viewOffset = static_cast<size_t>(view.GetNumber("byteOffset", 0.0));
+		const size_t viewLength = static_cast<size_t>(view.GetNumber("byteLength", 0.0));
+		const size_t offset = static_cast<size_t>(json.GetNumber("byteOffset", 0.0));
+		accessor.stride = static_cast<size_t>(view.GetNumber("byteStride", 0.0));
+		accessor.stride = accessor.stride != 0 ? accessor.stride : elementSize;
+		if (viewOffset > buffer.size() || viewLength > buffer.size() - viewOffset ||
+			(accessor.count > 0 && offset + accessor.stride * (accessor.count - 1) + elementSize > viewLength))
+		{
+			error = "accessor out of its buffer";
+			return false;
+		}
+		accessor.data = buffer.data() + viewOffset + offset;
+		return true;
+	}
+
+	static float ReadComponent(const uint8_t* data, uint32_t componentType, bool normalized)
+	{
+		switch (componentType)
+		{
+		case 5120: { int8_t v; memcpy(&v, data, 1); return normalized ? std::max(v / 127.0f, -1.0f) : v; }
+		case 5121: { uint8_t v = *data; return normalized ? v / 255.0f : v; }
+		case 5122: { int16_t v; memcpy(&v, data, 2); return normalized ? std::max(v / 32767.0f, -1.0f) : v; }
+		case 5123: { uint16_t v; memcpy(&v, data, 2); return normalized ? v / 65535.0f : v; }
+		case 5125: { uint32_t v; memcpy(&v, data, 4); return static_cast<float>(v); }
+		default: { float v; memcpy(&v, data, 4); return v; }
+		}
+	}
+
+	// count elements of components floats each, missing components are 0.
+	static void ReadFloats(const AccessorData& accessor, uint32_t components, float* out)
+	{
+		const uint32_t componentSize = GetComponentSize(accessor.componentType);
+		for (size_t i = 0; i < accessor.count; i++)
+		{
+			for (uint32_t c = 0; c < components; c++)
+			{
+				out[i * components + c] = c < accessor.components
+					? ReadComponent(accessor.data + i * accessor.stride + c * componentSize, accessor.componentType, accessor.normalized)
+					: 0.0f;
+			}
+		}
+	}
+
+	static glm::mat4 GetNodeTransform(const JsonValue& node)
+	{
+		const JsonValue* matrix = node.Find("matrix");
+		if (matrix != nullptr && matrix->GetSize() == 16)
+		{
+			glm::mat4 result;
+			for (int i = 0; i < 16; i++)
+			{
+				glm::value_ptr(result)[i] = static_cast<float>(matrix->items[i].number);
+			}
+			return result;
+		}
+
+		auto readVector = [&node](const char* name, float* values, size_t count)
+		{
+			const JsonValue* value = node.Find(name);
+			for (size_t i = 0; value != nullptr && i < count && i < value->GetSize(); i++)
+			{
+				values[i] = static_cast<float>(value->items[i].number);
+			}
+		};
+		glm::vec3 translation(0.0f), scale(1.0f);
+		float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		readVector("translation", glm::value_ptr(translation), 3);
+		readVector("rotation", rotation, 4);
+		readVector("scale", glm::value_ptr(scale), 3);
+		const glm::quat orientation(rotation[3], rotation[0], rotation[1], rotation[2]);
+		return glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(orientation) * glm::scale(glm::mat4(1.0f), scale);
+	}
+
+	static bool ImportGltfMesh(const Gltf& gltf, const JsonValue& json, const glm::mat4& transform, ImportedMesh& mesh,
+							   bool& hasUvs, bool& hasTangents, std::string& error)
+	{
+		const glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(transform)));
+		const bool flipped = glm::determinant(glm::mat3(transform)) < 0.0f;
+
+		const JsonValue* primitives = json.Find("primitives");
+		for (size_t p = 0; primitives != nullptr && p < primitives->GetSize(); p++)
+		{
+			const JsonValue& primitive = primitives->items[p];
+			const JsonValue* attributes = primitive.Find("attributes");
+			if (primitive.GetNumber("mode", 4.0) != 4.0 || attributes == nullptr || attributes->Find("POSITION") == nullptr)
+			{
+				// points, lines and strips aren't meshes the engine draws.
+				continue;
+			}
+
+			AccessorData positions;
+			if (!GetAccessor(gltf, attributes->Find("POSITION"), positions, error))
+			{
+				return false;
+			}
+			const size_t base = mesh.positions.size();
+			const size_t count = positions.count;
+			mesh.positions.resize(base + count);
+			ReadFloats(positions, 3, glm::value_ptr(mesh.positions[base]));
+			for (size_t v = base; v < base + count; v++)
+			{
+				mesh.positions[v] = glm::vec3(transform * glm::vec4(mesh.positions[v], 1.0f));
+			}
+
+			// attributes a primitive lacks are zero, GenerateNormals fills in the normals later.
+			AccessorData accessor;
+			mesh.normals.resize(base + count, glm::vec3(0.0f));
+			if (attributes->Find("NORMAL") != nullptr)
+			{
+				if (!GetAccessor(gltf, attributes->Find("NORMAL"), accessor, error) || accessor.count != count)
+				{
+					error = error.empty() ? "NORMAL count mismatch" : error;
+					return false;
+				}
+				ReadFloats(accessor, 3, glm::value_ptr(mesh.normals[base]));
+				for (size_t v = base; v < base + count; v++)
+				{
+					mesh.normals[v] = glm::normalize(normalTransform * mesh.normals[v]);
+				}
+			}
+			mesh.uvs.resize(base + count, glm::vec2(0.0f));
+			if (attributes->Find("TEXCOORD_0") != nullptr)
+			{
+				if (!GetAccessor(gltf, attributes->Find("TEXCOORD_0"), accessor, error) || accessor.count != count)
+				{
+					error = error.empty() ? "TEXCOORD_0 count mismatch" : error;
+					return false;
+				}
+				ReadFloats(accessor, 2, glm::value_ptr(mesh.uvs[base]));
+				hasUvs = true;
+			}
+			mesh.tangents.resize(base + count, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+			if (attributes->Find("TANGENT") != nullptr)
+			{
+				if (!GetAccessor(gltf, attributes->Find("TANGENT"), accessor, error) || accessor.count != count)
+				{
+					error = error.empty() ? "TANGENT count mismatch" : error;
+					return false;
+				}
+				ReadFloats(accessor, 4, glm::value_ptr(mesh.tangents[base]));
+				for (size_t v = base; v < base + count; v++)
+				{
+					const glm::vec3 tangent = glm::normalize(glm::mat3(transform) * glm::vec3(mesh.tangents[v]));
+					mesh.tangents[v] = glm::vec4(tangent, (mesh.tangents[v].w < 0.0f) != flipped ? -1.0f : 1.0f);
+				}
+				hasTangents = true;
+			}
+
+			const size_t firstIndex = mesh.indices.size();
+			if (primitive.Find("indices") != nullptr)
+			{
+				if (!GetAccessor(gltf, primitive.Find("indices"), accessor, error) || accessor.components != 1 ||
+					accessor.componentType == 5126)
+				{
+					error = error.empty() ? "bad index accessor" : error;
+					return false;
+				}
+				const uint32_t componentSize = GetComponentSize(accessor.componentType);
+				for (size_t i = 0; i + 2 < accessor.count; i += 3)
+				{
+					for (size_t k = 0; k < 3; k++)
+					{
+						uint32_t index = 0;
+						memcpy(&index, accessor.data + (i + k) * accessor.stride, componentSize);
+						if (index >= count)
+						{
+							error = "index out of range";
+							return false;
+						}
+						mesh.indices.push_back(static_cast<uint32_t>(base + index));
+					}
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i + 2 < count; i += 3)
+				{
+					mesh.indices.insert(mesh.indices.end(), { static_cast<uint32_t>(base + i), static_cast<uint32_t>(base + i + 1),
+															   static_cast<uint32_t>(base + i + 2) });
+				}
+			}
+			if (flipped)
+			{
+				for (size_t i = firstIndex; i < mesh.indices.size(); i += 3)
+				{
+					std::swap(mesh.indices[i + 1], mesh.indices[i + 2]);
+				}
+			}
+		}
+		return true;
+	}
+
+	static bool ImportGltf(const std::filesystem::path& path, std::vector<uint8_t>& bytes, ImportedMesh& mesh, std::string& error)
+	{
+		Gltf gltf;
+		if (!LoadGltf(path, bytes, gltf, error))
+		{
+			return false;
+		}
+
+		const JsonValue* meshes = gltf.json.Find("meshes");
+		const JsonValue* nodes = gltf.json.Find("nodes");
+		const JsonValue* scenes = gltf.json.Find("scenes");
+		bool hasUvs = false;
+		bool hasTangents = false;
+		bool hasNormals = true;
+
+		auto importMesh = [&](double index, const glm::mat4& transform)
+		{
+			if (meshes == nullptr || index < 0 || index >= meshes->GetSize())
+			{
+				error = "bad mesh index";
+				return false;
+			}
+			const JsonValue& json = meshes->items[static_cast<size_t>(index)];
+			const JsonValue* primitives = json.Find("primitives");
+			for (size_t p = 0; primitives != nullptr && p < primitives->GetSize(); p++)
+			{
+				const JsonValue* attributes = primitives->items[p].Find("attributes");
+				hasNormals &= attributes == nullptr || attributes->Find("NORMAL") != nullptr;
+			}
+			return ImportGltfMesh(gltf, json, transform, mesh, hasUvs, hasTangents, error);
+		};
+
+		if (scenes == nullptr || scenes->GetSize() == 0)
+		{
+			// a library of meshes, no scene to place them.
+			for (size_t i = 0; meshes != nullptr && i < meshes->GetSize(); i++)
+			{
+				if (!importMesh(static_cast<double>(i), glm::mat4(1.0f)))
+				{
+					return false;
+				}
+			}
+		}
+		else
+		{
+			const double sceneIndex = gltf.json.GetNumber("scene", 0.0);
+			if (sceneIndex < 0 || sceneIndex >= scenes->GetSize())
+			{
+				error = "bad default scene";
+				return false;
+			}
+
+			std::vector<std::pair<size_t, glm::mat4>> stack;
+			const JsonValue* roots = scenes->items[static_cast<size_t>(sceneIndex)].Find("nodes");
+			for (size_t i = 0; roots != nullptr && i < roots->GetSize(); i++)
+			{
+				stack.emplace_back(static_cast<size_t>(roots->items[i].number), glm::mat4(1.0f));
+			}
+			// a valid glTF is a forest, the limit only stops malformed cycles.
+			size_t visited = 0;
+			while (!stack.empty())
+			{
+				const auto [index, parent] = stack.back();
+				stack.pop_back();
+				if (nodes == nullptr || index >= nodes->GetSize() || ++visited > 16 * nodes->GetSize())
+				{
+					error = "bad node hierarchy";
+					return false;
+				}
+				const JsonValue& node = nodes->items[index];
+				const glm::mat4 transform = parent * GetNodeTransform(node);
+				if (node.Find("mesh") != nullptr && !importMesh(node.GetNumber("mesh", -1.0), transform))
+				{
+					return false;
+				}
+				const JsonValue* children = node.Find("children");
+				for (size_t i = 0; children != nullptr && i < children->GetSize(); i++)
+				{
+					stack.emplace_back(static_cast<size_t>(children->items[i].number), transform);
+				}
+			}
+		}
+
+		if (!hasNormals)
+		{
+			mesh.normals.clear();
+		}
+		if (!hasUvs)
+		{
+			mesh.uvs.clear();
+		}
+		if (!hasTangents)
+		{
+			mesh.tangents.clear();
+		}
+		return true;
+	}
+
+	bool ImportMesh(const std::filesystem::path& path, ImportedMesh& mesh, std::string& error)
+	{
+		mesh = {};
+		std::vector<uint8_t> bytes;
+		if (!ReadFile(path, bytes))
+		{
+			error = "can't read the file";
+			return false;
+		}
+
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+		bool imported;
+		if (extension == ".obj")
+		{
+			imported = ImportObj(bytes, mesh, error);
+		}
+		else if (extension == ".gltf" || extension == ".glb")
+		{
+			imported = ImportGltf(path, bytes, mesh, error);
+		}
+		else
+		{
+			error = "unknown format, expected .obj, .gltf or .glb";
+			return false;
+		}
+
+		if (imported && mesh.indices.empty())
+		{
+			error = "no triangles";
+			return false;
+		}
+		if (imported && mesh.normals.empty())
+		{
+			GenerateNormals(mesh);
+		}
+		return imported;
+	}
+}
@@ -0,0 +1,235 @@
+#include <MeshCooker.hpp>
+#include <MeshImporter.hpp>
+#include <ANTUTU/Asset/ArchiveWriter.hpp>
+#include <ANTUTU/Asset/Compression.hpp>
+#include <Common/Logger/LogManager.h>
+#include <Common/Logger/GUIConsole.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Cooks .obj / .gltf / .glb files into GPU ready .mesh blobs (MeshFormat.hpp)
+// in a .apak archive, directories recursively with their paths relative to
+// the directory given, e.g.:
+//   MeshCooker --lods 5 data/meshes.apak art/meshes
+//
+// art/meshes/rocks/rock.gltf is then "rocks/rock.mesh" in the archive.
+//
+// exit codes: 0 = success, 1 = failure, 2 = bad arguments.
+
+using namespace att::Asset;
+
+static void PrintUsage()
+{
+	std::cout <<
+		"MeshCooker [options] <output.apak> <mesh file or directory>...\n"
+		"  --lods N                LODs including the full mesh, 1 to 8 (4)\n"
+		"  --lod-ratio F           triangles of a LOD relative to the previous one (0.5)\n"
+		"  --lod-error F           surface error allowed, fraction of the mesh size (0.02)\n"
+		"  --overdraw F            ACMR allowed for the overdraw order, 1 = off (1.05)\n"
+		"  --align N               blob alignment, 4096 (default) or 65536\n"
+		"  --compress C            none (default), lz4 or zstd\n";
+}
+
+static bool IsMeshFile(const std::filesystem::path& path)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+	return extension == ".obj" || extension == ".gltf" || extension == ".glb";
+}
+
+int main(int argc, char** argv)
+{
+	// the archive code logs its own errors.
+	Common::LogManager::Get().Init();
+	Common::LogManager::Get().AddObserver(std::make_shared<Common::GUIConsole>());
+
+	Cooker::CookSettings settings;
+	uint32_t alignment = ArchiveSmallAlignment;
+	ArchiveCompression compression = ArchiveCompression::None;
+	std::vector<const char*> positional;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		auto takesValue = [&]()
+		{
+			if (value == nullptr)
+			{
+				std::cerr << arg << " needs a value" << std::endl;
+				std::exit(2);
+			}
+			i++;
+			return value;
+		};
+
+		if (strcmp(arg, "--lods") == 0)
+		{
+			settings.lodCount = static_cast<uint32_t>(std::strtoul(takesValue(), nullptr, 10));
+			if (settings.lodCount < 1 || settings.lodCount > CookedMeshMaxLods)
+			{
+				std::cerr << "--lods needs 1 to " << CookedMeshMaxLods << std::endl;
+				return 2;
+			}
+		}
+		else if (strcmp(arg, "--lod-ratio") == 0)
+		{
+			settings.lodRatio = static_cast<float>(std::strtod(takesValue(), nullptr));
+			if (settings.lodRatio <= 0.0f || settings.lodRatio >= 1.0f)
+			{
+				std::cerr << "--lod-ratio needs a value between 0 and 1" << std::endl;
+				return 2;
+			}
+		}
+		else if (strcmp(arg, "--lod-error") == 0)
+		{
+			settings.lodMaxError = static_cast<float>(std::strtod(takesValue(), nullptr));
+		}
+		else if (strcmp(arg, "--overdraw") == 0)
+		{
+			settings.overdrawThreshold = static_cast<float>(std::strtod(takesValue(), nullptr));
+		}
+		else if (strcmp(arg, "--align") == 0)
+		{
+			alignment = static_cast<uint32_t>(std::strtoul(takesValue(), nullptr, 10));
+			if (alignment < 16 || (alignment & (alignment - 1)) != 0)
+			{
+				std::cerr << "--align needs a power of two of at least 16" << std::endl;
+				return 2;
+			}
+		}
+		else if (strcmp(arg, "--compress") == 0)
+		{
+			const char* name = takesValue();
+			if (strcmp(name, "none") == 0)
+			{
+				compression = ArchiveCompression::None;
+			}
+			else if (strcmp(name, "lz4") == 0)
+			{
+				compression = ArchiveCompression::LZ4;
+			}
+			else if (strcmp(name, "zstd") == 0)
+			{
+				compression = ArchiveCompression::Zstd;
+			}
+			else
+			{
+				std::cerr << "unknown compression " << name << std::endl;
+				return 2;
+			}
+			if (!IsCompressionSupported(compression))
+			{
+				std::cerr << name << " isn't available in this build" << std::endl;
+				return 2;
+			}
+		}
+		else if (arg[0] == '-')
+		{
+			PrintUsage();
+			return strcmp(arg, "--help") == 0 ? EXIT_SUCCESS : 2;
+		}
+		else
+		{
+			positional.push_back(arg);
+		}
+	}
+
+	if (positional.size() < 2)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	// (file, path in the archive), sorted so the same inputs give the same archive.
+	std::vector<std::pair<std::filesystem::path, std::string>> inputs;
+	for (size_t i = 1; i < positional.size(); i++)
+	{
+		const std::filesystem::path input(positional[i]);
+		std::error_code error;
+		if (std::filesystem::is_directory(input, error))
+		{
+			for (const auto& item : std::filesystem::recursive_directory_iterator(input, error))
+			{
+				if (item.is_regular_file() && IsMeshFile(item.path()))
+				{
+					inputs.emplace_back(item.path(), std::filesystem::relative(item.path(), input).replace_extension(".mesh").generic_string());
+				}
+			}
+		}
+		else if (std::filesystem::is_regular_file(input, error))
+		{
+			inputs.emplace_back(input, std::filesystem::path(input.filename()).replace_extension(".mesh").generic_string());
+		}
+		else
+		{
+			std::cerr << positional[i] << " doesn't exist" << std::endl;
+			spdlog::shutdown();
+			return 1;
+		}
+	}
+	std::sort(inputs.begin(), inputs.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+
+	ArchiveWriter writer;
+	if (!writer.Open(positional[0], alignment))
+	{
+		std::cerr << "Can't create " << positional[0] << std::endl;
+		spdlog::shutdown();
+		return 1;
+	}
+
+	uint64_t sourceBytes = 0;
+	uint64_t cookedBytes = 0;
+	Cooker::ImportedMesh mesh;
+	std::vector<uint8_t> blob;
+	for (const auto& [file, path] : inputs)
+	{
+		std::string error;
+		if (!Cooker::ImportMesh(file, mesh, error))
+		{
+			std::cerr << file.string() << ": " << error << std::endl;
+			spdlog::shutdown();
+			return 1;
+		}
+
+		Cooker::CookReport report;
+		Cooker::CookMesh(mesh, settings, blob, report);
+		if (!writer.Add(path, blob.data(), blob.size(), compression))
+		{
+			std::cerr << "Can't add " << path << " (duplicate path or write error)" << std::endl;
+			spdlog::shutdown();
+			return 1;
+		}
+
+		std::cout << std::fixed << std::setprecision(3) << path << ": " << report.vertexCount << " vertices, ACMR "
+				  << report.sourceAcmr << " -> " << report.cookedAcmr << ", " << report.sourceBytes << " -> "
+				  << report.cookedLod0Bytes << " bytes (" << report.cookedBytes << " with the LODs), LOD triangles";
+		for (uint32_t i = 0; i < report.lodCount; i++)
+		{
+			std::cout << ' ' << report.lodTriangles[i];
+		}
+		std::cout << std::endl;
+		sourceBytes += report.sourceBytes;
+		cookedBytes += report.cookedLod0Bytes;
+	}
+
+	if (!writer.Finish())
+	{
+		std::cerr << "Failed to write " << positional[0] << std::endl;
+		spdlog::shutdown();
+		return 1;
+	}
+
+	std::cout << positional[0] << ": " << inputs.size() << " meshes, " << sourceBytes << " source bytes cooked to "
+			  << cookedBytes << " for LOD 0" << std::endl;
+	spdlog::shutdown();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+#ifndef SHADER_COMPILER_SHADER_COMPILER_H
+#define SHADER_COMPILER_SHADER_COMPILER_H
+
+#include <SpirvReflection.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Cooker
+{
+	struct CompileSettings
+	{
+		// glslc, glslangValidator, dxc or slangc, told apart by the file name.
+		std::filesystem::path compiler;
+		// spirv-opt, empty leaves the optimization to the compiler.
+		std::filesystem::path optimizer;
+		// NAME or NAME=VALUE.
+		std::vector<std::string> defines;
+		std::vector<std::filesystem::path> includeDirs;
+		std::string entryPoint = "main";
+		std::string targetEnv = "vulkan1.2";
+		// float math marked RelaxedPrecision, mediump on mobile GPUs.
+		bool relaxedPrecision = false;
+		// compile even when the output is up to date.
+		bool force = false;
+	};
+
+	struct CompileReport
+	{
+		bool upToDate = false;
+		uint64_t hash = 0;
+		// the source then everything it includes, the dependencies of the output.
+		std::vector<std::filesystem::path> files;
+		ShaderReflection reflection;
+		uint64_t spirvBytes = 0;
+		uint64_t optimizedBytes = 0;
+		double compileMs = 0.0;
+		double optimizeMs = 0.0;
+	};
+
+	// the stage from the extension: name.comp, or name.comp.hlsl / name.comp.slang.
+	uint32_t GetShaderStage(const std::filesystem::path& source);
+
+	// source to a cooked .shader blob (ShaderFormat.hpp). The source, its includes, the
+	// defines and the tool command lines are hashed first: an output carrying the same hash
+	// is left alone (and touched for the build system), only changed permutations compile.
+	bool CompileShader(const std::filesystem::path& source, const std::filesystem::path& output,
+					   const CompileSettings& settings, CompileReport& report, std::string& error);
+}
+
+#endif	// SHADER_COMPILER_SHADER_COMPILER_H
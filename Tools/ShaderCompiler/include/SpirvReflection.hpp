@@ -0,0 +1,34 @@
+#ifndef SHADER_COMPILER_SPIRV_REFLECTION_H
+#define SHADER_COMPILER_SPIRV_REFLECTION_H
+
+#include <ANTUTU/Asset/ShaderFormat.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Cooker
+{
+	struct ShaderReflection
+	{
+		// one att::Asset::ShaderStage bit.
+		uint32_t stage = 0;
+		std::string entryPoint;
+		uint32_t localSize[3] = {};
+		uint32_t pushConstantOffset = 0;
+		uint32_t pushConstantSize = 0;
+		// sorted by set then binding.
+		std::vector<att::Asset::CookedShaderBinding> bindings;
+		// vertex stage, sorted by location.
+		std::vector<att::Asset::CookedShaderVertexInput> vertexInputs;
+	};
+
+	// the resources the entry point can reach: every global of the module before SPIR-V 1.4,
+	// its interface list from 1.4 on. false with error set when the module isn't SPIR-V,
+	// has no such entry point or uses a vertex input type without a VkFormat.
+	bool ReflectSpirv(const uint32_t* words, size_t wordCount, const std::string& entryPoint,
+					  ShaderReflection& reflection, std::string& error);
+}
+
+#endif	// SHADER_COMPILER_SPIRV_REFLECTION_H
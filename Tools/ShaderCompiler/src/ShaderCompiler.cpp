@@ -0,0 +1,472 @@
+#include <ShaderCompiler.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+using namespace att::Asset;
+
+namespace Cooker
+{
+	namespace
+	{
+		enum class CompilerKind
+		{
+			Glslc,
+			Glslang,
+			Dxc,
+			Slangc
+		};
+
+		struct StageInfo
+		{
+			const char* extension;
+			uint32_t stage;
+			// DXC target profile and Slang stage name.
+			const char* hlslProfile;
+			const char* slangStage;
+		};
+
+		// mesh and amplification shaders need shader model 6.5.
+		constexpr StageInfo Stages[] = {
+			{ "vert", ShaderStageVertex, "vs_6_5", "vertex" },
+			{ "frag", ShaderStageFragment, "ps_6_5", "fragment" },
+			{ "comp", ShaderStageCompute, "cs_6_5", "compute" },
+			{ "geom", ShaderStageGeometry, "gs_6_5", "geometry" },
+			{ "tesc", ShaderStageTessControl, "hs_6_5", "hull" },
+			{ "tese", ShaderStageTessEvaluation, "ds_6_5", "domain" },
+			{ "task", ShaderStageTask, "as_6_5", "amplification" },
+			{ "mesh", ShaderStageMesh, "ms_6_5", "mesh" },
+			{ "rgen", ShaderStageRayGen, "lib_6_5", "raygeneration" },
+			{ "rahit", ShaderStageAnyHit, "lib_6_5", "anyhit" },
+			{ "rchit", ShaderStageClosestHit, "lib_6_5", "closesthit" },
+			{ "rmiss", ShaderStageMiss, "lib_6_5", "miss" },
+			{ "rint", ShaderStageIntersection, "lib_6_5", "intersection" },
+			{ "rcall", ShaderStageCallable, "lib_6_5", "callable" }
+		};
+
+		const StageInfo* FindStage(const std::filesystem::path& source)
+		{
+			std::filesystem::path name = source.filename();
+			if (name.extension() == ".hlsl" || name.extension() == ".slang")
+			{
+				name = name.stem();
+			}
+			const std::string extension = name.extension().string();
+			for (const StageInfo& info : Stages)
+			{
+				if (extension.size() > 1 && extension.compare(1, std::string::npos, info.extension) == 0)
+				{
+					return &info;
+				}
+			}
+			return nullptr;
+		}
+
+		CompilerKind GetCompilerKind(const std::filesystem::path& compiler)
+		{
+			std::string name = compiler.stem().string();
+			std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			if (name.find("glslang") != std::string::npos)
+			{
+				return CompilerKind::Glslang;
+			}
+			if (name.find("dxc") != std::string::npos)
+			{
+				return CompilerKind::Dxc;
+			}
+			if (name.find("slangc") != std::string::npos)
+			{
+				return CompilerKind::Slangc;
+			}
+			// glslc and anything taking its command line.
+			return CompilerKind::Glslc;
+		}
+
+		bool ReadFile(const std::filesystem::path& path, std::string& bytes)
+		{
+			std::ifstream file(path, std::ios::binary | std::ios::ate);
+			if (!file)
+			{
+				return false;
+			}
+			bytes.resize(static_cast<size_t>(file.tellg()));
+			file.seekg(0);
+			return bytes.empty() || file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		}
+
+		bool WriteFile(const std::filesystem::path& path, const void* data, size_t size)
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			return file && file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size)) && file.flush();
+		}
+
+		std::filesystem::path ResolveInclude(const std::string& name, const std::filesystem::path& from,
+											 const std::vector<std::filesystem::path>& includeDirs)
+		{
+			std::error_code error;
+			std::filesystem::path candidate = from.parent_path() / name;
+			if (std::filesystem::is_regular_file(candidate, error))
+			{
+				return candidate.lexically_normal();
+			}
+			for (const std::filesystem::path& dir : includeDirs)
+			{
+				candidate = dir / name;
+				if (std::filesystem::is_regular_file(candidate, error))
+				{
+					return candidate.lexically_normal();
+				}
+			}
+			return {};
+		}
+
+		// #include "x" / <x> of every language, and Slang's import a.b (a/b.slang). Conditionals
+		// aren't evaluated: a superset of the real dependencies, and of the hash.
+		void ScanIncludes(const std::filesystem::path& file, const std::string& text,
+						  const std::vector<std::filesystem::path>& includeDirs, std::vector<std::filesystem::path>& files)
+		{
+			size_t line = 0;
+			while (line < text.size())
+			{
+				size_t end = text.find('\n', line);
+				end = end == std::string::npos ? text.size() : end;
+				size_t i = text.find_first_not_of(" \t", line);
+
+				std::string name;
+				if (i < end && text[i] == '#')
+				{
+					i = text.find_first_not_of(" \t", i + 1);
+					if (i < end && text.compare(i, 7, "include") == 0)
+					{
+						i = text.find_first_not_of(" \t", i + 7);
+						if (i < end && (text[i] == '"' || text[i] == '<'))
+						{
+							const size_t close = text.find(text[i] == '"' ? '"' : '>', i + 1);
+							name = close < end ? text.substr(i + 1, close - i - 1) : std::string();
+						}
+					}
+				}
+				else if (i < end && text.compare(i, 7, "import ") == 0 && file.extension() == ".slang")
+				{
+					const size_t close = text.find(';', i);
+					if (close < end)
+					{
+						name = text.substr(i + 7, close - i - 7);
+						name.erase(std::remove_if(name.begin(), name.end(), [](char c) { return c == ' ' || c == '\t'; }), name.end());
+						std::replace(name.begin(), name.end(), '.', '/');
+						name += ".slang";
+					}
+				}
+				line = end + 1;
+
+				// missing ones are left to the compiler: system headers, or not compiled in.
+				const std::filesystem::path include = name.empty() ? std::filesystem::path() : ResolveInclude(name, file, includeDirs);
+				if (include.empty() || std::find(files.begin(), files.end(), include) != files.end())
+				{
+					continue;
+				}
+				files.push_back(include);
+				std::string includeText;
+				if (ReadFile(include, includeText))
+				{
+					ScanIncludes(include, includeText, includeDirs, files);
+				}
+			}
+		}
+
+		// FNV-1a 64.
+		void Hash(uint64_t& hash, const void* data, size_t size)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+		}
+
+		void Hash(uint64_t& hash, const std::string& text)
+		{
+			// with the length: "ab" "c" and "a" "bc" differ.
+			const uint64_t size = text.size();
+			Hash(hash, &size, sizeof(size));
+			Hash(hash, text.data(), text.size());
+		}
+
+		// a tool update rebuilds everything it compiled.
+		void HashTool(uint64_t& hash, const std::filesystem::path& tool)
+		{
+			std::error_code error;
+			const uint64_t size = tool.empty() ? 0 : std::filesystem::file_size(tool, error);
+			const int64_t time = tool.empty() ? 0 : std::filesystem::last_write_time(tool, error).time_since_epoch().count();
+			Hash(hash, tool.generic_string());
+			Hash(hash, &size, sizeof(size));
+			Hash(hash, &time, sizeof(time));
+		}
+
+		std::string Quote(const std::string& arg)
+		{
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+			std::string quoted = "\"";
+			for (char c : arg)
+			{
+				quoted += c == '"' ? "\\\"" : std::string(1, c);
+			}
+			return quoted + "\"";
+#else
+			std::string quoted = "'";
+			for (char c : arg)
+			{
+				quoted += c == '\'' ? "'\\''" : std::string(1, c);
+			}
+			return quoted + "'";
+#endif
+		}
+
+		// the tool's own output goes to ours, the build shows its errors.
+		bool RunCommand(const std::vector<std::string>& args)
+		{
+			std::string command;
+			for (const std::string& arg : args)
+			{
+				command += (command.empty() ? "" : " ") + Quote(arg);
+			}
+#if defined(ANTUTU_SYSTEM_WINDOWS)
+			// cmd /c strips the first and last quote of the line.
+			command = "\"" + command + "\"";
+#endif
+			return std::system(command.c_str()) == 0;
+		}
+
+		std::vector<std::string> GetCompileCommand(const std::filesystem::path& source, const std::filesystem::path& output,
+												   const StageInfo& stage, const CompileSettings& settings)
+		{
+			const CompilerKind kind = GetCompilerKind(settings.compiler);
+			// unoptimized when spirv-opt runs after, it does it better and once.
+			const bool optimize = settings.optimizer.empty();
+			std::vector<std::string> args = { settings.compiler.string() };
+			switch (kind)
+			{
+			case CompilerKind::Glslc:
+				args.insert(args.end(), { std::string("-fshader-stage=") + stage.extension, "--target-env=" + settings.targetEnv,
+										  optimize ? "-O" : "-O0", "-fentry-point=" + settings.entryPoint });
+				break;
+			case CompilerKind::Glslang:
+				args.insert(args.end(), { "-V", "--target-env", settings.targetEnv, "-S", stage.extension });
+				if (source.extension() == ".hlsl")
+				{
+					// a lone -D is HLSL input.
+					args.insert(args.end(), { "-D", "-e", settings.entryPoint });
+				}
+				break;
+			case CompilerKind::Dxc:
+				args.insert(args.end(), { "-spirv", "-T", stage.hlslProfile, "-E", settings.entryPoint,
+										  "-fspv-target-env=" + settings.targetEnv, optimize ? "-O3" : "-O0" });
+				break;
+			case CompilerKind::Slangc:
+				args.insert(args.end(), { "-target", "spirv", "-stage", stage.slangStage, "-entry", settings.entryPoint,
+										  optimize ? "-O2" : "-O0" });
+				break;
+			}
+			// the joined forms, the only ones every compiler takes.
+			for (const std::string& define : settings.defines)
+			{
+				args.push_back("-D" + define);
+			}
+			for (const std::filesystem::path& dir : settings.includeDirs)
+			{
+				args.push_back("-I" + dir.string());
+			}
+			args.insert(args.end(), { kind == CompilerKind::Dxc ? "-Fo" : "-o", output.string(), source.string() });
+			return args;
+		}
+
+		std::vector<std::string> GetOptimizeCommand(const std::filesystem::path& input, const std::filesystem::path& output,
+													 const CompileSettings& settings)
+		{
+			// the bindings stay whether used or not: every permutation of a shader keeps the
+			// layout the application writes its descriptors for.
+			std::vector<std::string> args = { settings.optimizer.string(), "--target-env=" + settings.targetEnv };
+			if (settings.relaxedPrecision)
+			{
+				args.push_back("--relax-float-ops");
+			}
+			args.insert(args.end(), { "-O", "--preserve-bindings", "--preserve-spec-constants", input.string(), "-o", output.string() });
+			return args;
+		}
+	}
+
+	uint32_t GetShaderStage(const std::filesystem::path& source)
+	{
+		const StageInfo* info = FindStage(source);
+		return info != nullptr ? info->stage : 0;
+	}
+
+	bool CompileShader(const std::filesystem::path& source, const std::filesystem::path& output,
+					   const CompileSettings& settings, CompileReport& report, std::string& error)
+	{
+		report = {};
+		const StageInfo* stage = FindStage(source);
+		if (stage == nullptr)
+		{
+			error = "unknown stage, name it .vert, .frag, .comp... (or .comp.hlsl, .comp.slang)";
+			return false;
+		}
+
+		std::string text;
+		if (!ReadFile(source, text))
+		{
+			error = "can't read the source";
+			return false;
+		}
+		const std::filesystem::path sourcePath = source.lexically_normal();
+		report.files.push_back(sourcePath);
+		ScanIncludes(sourcePath, text, settings.includeDirs, report.files);
+
+		// everything the output depends on: the format, the tools and their options, the
+		// files. Paths of the files are left out, a moved tree stays up to date.
+		uint64_t hash = 14695981039346656037ull;
+		Hash(hash, &CookedShaderVersion, sizeof(CookedShaderVersion));
+		const std::vector<std::string> command = GetCompileCommand({}, {}, *stage, settings);
+		for (const std::string& arg : command)
+		{
+			Hash(hash, arg);
+		}
+		for (const std::string& arg : settings.optimizer.empty() ? std::vector<std::string>() : GetOptimizeCommand({}, {}, settings))
+		{
+			Hash(hash, arg);
+		}
+		HashTool(hash, settings.compiler);
+		HashTool(hash, settings.optimizer);
+		for (const std::filesystem::path& file : report.files)
+		{
+			std::string bytes;
+			if (file != report.files[0] && !ReadFile(file, bytes))
+			{
+				error = "can't read " + file.string();
+				return false;
+			}
+			Hash(hash, file == report.files[0] ? text : bytes);
+		}
+		report.hash = hash;
+
+		CookedShaderHeader existing = {};
+		std::ifstream previous(output, std::ios::binary);
+		if (!settings.force && previous && previous.read(reinterpret_cast<char*>(&existing), sizeof(existing)) &&
+			existing.magic == CookedShaderMagic && existing.version == CookedShaderVersion && existing.sourceHash == hash)
+		{
+			// newer than its inputs for make and ninja, without recompiling.
+			previous.close();
+			std::error_code touchError;
+			std::filesystem::last_write_time(output, std::filesystem::file_time_type::clock::now(), touchError);
+			report.upToDate = true;
+			return true;
+		}
+		previous.close();
+
+		const std::filesystem::path spirvPath = output.string() + ".spv";
+		const std::filesystem::path optimizedPath = output.string() + ".opt.spv";
+		auto cleanup = [&]()
+		{
+			std::error_code removeError;
+			std::filesystem::remove(spirvPath, removeError);
+			std::filesystem::remove(optimizedPath, removeError);
+		};
+
+		auto start = std::chrono::steady_clock::now();
+		if (!RunCommand(GetCompileCommand(source, spirvPath, *stage, settings)))
+		{
+			cleanup();
+			error = "compilation failed";
+			return false;
+		}
+		report.compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::string spirv;
+		if (!ReadFile(spirvPath, spirv))
+		{
+			cleanup();
+			error = "the compiler wrote no SPIR-V";
+			return false;
+		}
+		report.spirvBytes = spirv.size();
+		if (!settings.optimizer.empty())
+		{
+			start = std::chrono::steady_clock::now();
+			if (!RunCommand(GetOptimizeCommand(spirvPath, optimizedPath, settings)) || !ReadFile(optimizedPath, spirv))
+			{
+				cleanup();
+				error = "spirv-opt failed";
+				return false;
+			}
+			report.optimizeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+		cleanup();
+		report.optimizedBytes = spirv.size();
+
+		if (spirv.size() % 4 != 0 ||
+			!ReflectSpirv(reinterpret_cast<const uint32_t*>(spirv.data()), spirv.size() / 4, settings.entryPoint, report.reflection, error))
+		{
+			error = error.empty() ? "SPIR-V isn't whole words" : error;
+			return false;
+		}
+		const ShaderReflection& reflection = report.reflection;
+		if (reflection.stage != stage->stage)
+		{
+			error = std::string("the module is a ") + GetShaderStageName(reflection.stage) + " shader";
+			return false;
+		}
+		// the module's only entry point is taken whatever its name, so check the reflected one.
+		if (reflection.entryPoint.size() >= CookedShaderMaxEntryPoint)
+		{
+			error = "entry point " + reflection.entryPoint + " is longer than " +
+				std::to_string(CookedShaderMaxEntryPoint - 1) + " characters";
+			return false;
+		}
+
+		CookedShaderHeader header = {};
+		header.magic = CookedShaderMagic;
+		header.version = CookedShaderVersion;
+		header.stage = reflection.stage;
+		header.flags = settings.relaxedPrecision && !settings.optimizer.empty() ? CookedShaderRelaxedPrecision : 0u;
+		header.sourceHash = hash;
+		memcpy(header.localSize, reflection.localSize, sizeof(header.localSize));
+		header.pushConstantOffset = reflection.pushConstantOffset;
+		header.pushConstantSize = reflection.pushConstantSize;
+		header.bindingCount = static_cast<uint32_t>(reflection.bindings.size());
+		header.vertexInputCount = static_cast<uint32_t>(reflection.vertexInputs.size());
+		const size_t bindingBytes = reflection.bindings.size() * sizeof(CookedShaderBinding);
+		const size_t inputBytes = reflection.vertexInputs.size() * sizeof(CookedShaderVertexInput);
+		header.codeOffset = static_cast<uint32_t>((sizeof(header) + bindingBytes + inputBytes + 15) & ~size_t(15));
+		header.codeSize = static_cast<uint32_t>(spirv.size());
+		memcpy(header.entryPoint, reflection.entryPoint.c_str(), reflection.entryPoint.size() + 1);
+
+		std::vector<uint8_t> blob(header.codeOffset + spirv.size(), 0);
+		memcpy(blob.data(), &header, sizeof(header));
+		memcpy(blob.data() + sizeof(header), reflection.bindings.data(), bindingBytes);
+		memcpy(blob.data() + sizeof(header) + bindingBytes, reflection.vertexInputs.data(), inputBytes);
+		memcpy(blob.data() + header.codeOffset, spirv.data(), spirv.size());
+
+		// a failed write never leaves a half blob carrying a valid hash.
+		const std::filesystem::path temporary = output.string() + ".tmp";
+		std::error_code renameError;
+		if (!WriteFile(temporary, blob.data(), blob.size()))
+		{
+			error = "can't write " + temporary.string();
+			return false;
+		}
+		std::filesystem::rename(temporary, output, renameError);
+		if (renameError)
+		{
+			std::filesystem::remove(temporary, renameError);
+			error = "can't write " + output.string();
+			return false;
+		}
+		return true;
+	}
+}
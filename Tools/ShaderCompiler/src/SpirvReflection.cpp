@@ -0,0 +1,657 @@
+#include <SpirvReflection.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+using namespace att::Asset;
+
+namespace Cooker
+{
+	namespace
+	{
+		constexpr uint32_t SpirvMagic = 0x07230203;
+		constexpr uint32_t SpirvVersion14 = 0x00010400;
+		constexpr uint32_t NoValue = ~0u;
+
+		// the few opcodes, decorations and enums the reflection looks at, from the SPIR-V spec.
+		enum Opcode : uint32_t
+		{
+			OpEntryPoint = 15,
+			OpExecutionMode = 16,
+			OpTypeBool = 20,
+			OpTypeInt = 21,
+			OpTypeFloat = 22,
+			OpTypeVector = 23,
+			OpTypeMatrix = 24,
+			OpTypeImage = 25,
+			OpTypeSampler = 26,
+			OpTypeSampledImage = 27,
+			OpTypeArray = 28,
+			OpTypeRuntimeArray = 29,
+			OpTypeStruct = 30,
+			OpTypePointer = 32,
+			OpConstant = 43,
+			OpConstantComposite = 44,
+			OpSpecConstant = 50,
+			OpSpecConstantComposite = 51,
+			OpVariable = 59,
+			OpDecorate = 71,
+			OpMemberDecorate = 72,
+			OpTypeAccelerationStructure = 5341
+		};
+
+		enum Decoration : uint32_t
+		{
+			DecorationBlock = 2,
+			DecorationBufferBlock = 3,
+			DecorationRowMajor = 4,
+			DecorationArrayStride = 6,
+			DecorationMatrixStride = 7,
+			DecorationBuiltIn = 11,
+			DecorationLocation = 30,
+			DecorationBinding = 33,
+			DecorationDescriptorSet = 34,
+			DecorationOffset = 35
+		};
+
+		enum StorageClass : uint32_t
+		{
+			StorageUniformConstant = 0,
+			StorageInput = 1,
+			StorageUniform = 2,
+			StoragePushConstant = 9,
+			StorageStorageBuffer = 12,
+			StoragePhysicalStorageBuffer = 5349
+		};
+
+		constexpr uint32_t ExecutionModeLocalSize = 17;
+		constexpr uint32_t ExecutionModeLocalSizeId = 38;
+		constexpr uint32_t BuiltInWorkgroupSize = 25;
+		constexpr uint32_t DimBuffer = 5;
+		constexpr uint32_t DimSubpassData = 6;
+
+		struct Id
+		{
+			uint32_t opcode = 0;
+			// result type of constants and variables.
+			uint32_t type = 0;
+			// the words after the result id.
+			const uint32_t* operands = nullptr;
+			uint32_t operandCount = 0;
+
+			uint32_t set = NoValue;
+			uint32_t binding = NoValue;
+			uint32_t location = NoValue;
+			uint32_t builtIn = NoValue;
+			uint32_t arrayStride = 0;
+			bool bufferBlock = false;
+		};
+
+		struct Member
+		{
+			uint32_t offset = NoValue;
+			uint32_t matrixStride = 0;
+			bool rowMajor = false;
+		};
+
+		struct EntryPoint
+		{
+			uint32_t model = 0;
+			uint32_t function = 0;
+			std::string name;
+			std::vector<uint32_t> interface;
+		};
+
+		class Module
+		{
+		public:
+			std::vector<Id> ids;
+			std::unordered_map<uint64_t, Member> members;
+
+			const Id* Get(uint32_t id) const
+			{
+				return id < ids.size() && ids[id].opcode != 0 ? &ids[id] : nullptr;
+			}
+
+			const Member* GetMember(uint32_t structId, uint32_t index) const
+			{
+				auto it = members.find((uint64_t(structId) << 32) | index);
+				return it != members.end() ? &it->second : nullptr;
+			}
+
+			// default value of a (spec) constant, 0 when it isn't one.
+			uint32_t GetConstant(uint32_t id) const
+			{
+				const Id* constant = Get(id);
+				return constant != nullptr && (constant->opcode == OpConstant || constant->opcode == OpSpecConstant) &&
+							   constant->operandCount > 0 ? constant->operands[0] : 0;
+			}
+
+			// std140 / std430 size as laid out by the Offset and stride decorations, without
+			// the tail padding.
+			uint32_t GetTypeSize(uint32_t typeId, uint32_t depth = 0) const
+			{
+				const Id* type = Get(typeId);
+				if (type == nullptr || depth > 32)
+				{
+					return 0;
+				}
+				switch (type->opcode)
+				{
+				case OpTypeBool:
+					return 4;
+				case OpTypeInt:
+				case OpTypeFloat:
+					return type->operands[0] / 8;
+				case OpTypeVector:
+				case OpTypeMatrix:
+					return type->operands[1] * GetTypeSize(type->operands[0], depth + 1);
+				case OpTypeArray:
+					return GetConstant(type->operands[1]) *
+						   (type->arrayStride != 0 ? type->arrayStride : GetTypeSize(type->operands[0], depth + 1));
+				case OpTypePointer:
+					return type->operands[0] == StoragePhysicalStorageBuffer ? 8 : 0;
+				case OpTypeStruct:
+				{
+					uint32_t size = 0;
+					for (uint32_t i = 0; i < type->operandCount; i++)
+					{
+						const Member* member = GetMember(typeId, i);
+						const uint32_t offset = member != nullptr && member->offset != NoValue ? member->offset : size;
+						size = std::max(size, offset + GetMemberSize(typeId, i, depth + 1));
+					}
+					return size;
+				}
+				default:
+					return 0;
+				}
+			}
+
+			uint32_t GetMemberSize(uint32_t structId, uint32_t index, uint32_t depth) const
+			{
+				const uint32_t typeId = Get(structId)->operands[index];
+				const Id* type = Get(typeId);
+				const Member* member = GetMember(structId, index);
+				if (type != nullptr && type->opcode == OpTypeMatrix && member != nullptr && member->matrixStride != 0)
+				{
+					// column major: a stride per column, row major: per row.
+					const Id* column = Get(type->operands[0]);
+					const uint32_t rows = column != nullptr ? column->operands[1] : 0;
+					return (member->rowMajor ? rows : type->operands[1]) * member->matrixStride;
+				}
+				return GetTypeSize(typeId, depth);
+			}
+		};
+
+		uint32_t GetStage(uint32_t executionModel)
+		{
+			switch (executionModel)
+			{
+			case 0:
+				return ShaderStageVertex;
+			case 1:
+				return ShaderStageTessControl;
+			case 2:
+				return ShaderStageTessEvaluation;
+			case 3:
+				return ShaderStageGeometry;
+			case 4:
+				return ShaderStageFragment;
+			case 5:
+				return ShaderStageCompute;
+			// NV then EXT.
+			case 5267:
+			case 5364:
+				return ShaderStageTask;
+			case 5268:
+			case 5365:
+				return ShaderStageMesh;
+			case 5313:
+				return ShaderStageRayGen;
+			case 5314:
+				return ShaderStageIntersection;
+			case 5315:
+				return ShaderStageAnyHit;
+			case 5316:
+				return ShaderStageClosestHit;
+			case 5317:
+				return ShaderStageMiss;
+			case 5318:
+				return ShaderStageCallable;
+			default:
+				return 0;
+			}
+		}
+
+		// words of the type instructions up to the operands read here.
+		uint32_t GetTypeWordCount(uint32_t opcode)
+		{
+			switch (opcode)
+			{
+			case OpTypeImage:
+				return 9;
+			case OpTypeInt:
+			case OpTypeVector:
+			case OpTypeMatrix:
+			case OpTypeArray:
+			case OpTypePointer:
+				return 4;
+			case OpTypeFloat:
+			case OpTypeSampledImage:
+			case OpTypeRuntimeArray:
+				return 3;
+			default:
+				return 2;
+			}
+		}
+
+		// VkFormat of a scalar or vector input, 0 when there is none.
+		uint32_t GetVertexFormat(const Module& module, const Id& type)
+		{
+			const Id* scalar = type.opcode == OpTypeVector ? module.Get(type.operands[0]) : &type;
+			const uint32_t components = type.opcode == OpTypeVector ? type.operands[1] : 1;
+			if (scalar == nullptr || components < 1 || components > 4 ||
+				(scalar->opcode != OpTypeInt && scalar->opcode != OpTypeFloat))
+			{
+				return 0;
+			}
+			// UINT, SINT, SFLOAT in a row, R16 formats 7 apart, R32 and R64 ones 3 apart.
+			const uint32_t kind = scalar->opcode == OpTypeFloat ? 2 : scalar->operands[1] != 0 ? 1 : 0;
+			switch (scalar->operands[0])
+			{
+			case 16:
+				return 74 + 7 * (components - 1) + kind;
+			case 32:
+				return 98 + 3 * (components - 1) + kind;
+			case 64:
+				return 110 + 3 * (components - 1) + kind;
+			default:
+				return 0;
+			}
+		}
+
+		bool AddVertexInput(const Module& module, uint32_t typeId, uint32_t& location, ShaderReflection& reflection)
+		{
+			const Id* type = module.Get(typeId);
+			if (type == nullptr)
+			{
+				return false;
+			}
+			if (type->opcode == OpTypeArray || type->opcode == OpTypeMatrix)
+			{
+				// an element, a column, per location.
+				const uint32_t count = type->opcode == OpTypeArray ? module.GetConstant(type->operands[1]) : type->operands[1];
+				for (uint32_t i = 0; i < count; i++)
+				{
+					if (!AddVertexInput(module, type->operands[0], location, reflection))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			const uint32_t format = GetVertexFormat(module, *type);
+			if (format == 0)
+			{
+				return false;
+			}
+			reflection.vertexInputs.push_back({ location, format });
+			// dvec3 and dvec4 take two locations.
+			const Id* scalar = type->opcode == OpTypeVector ? module.Get(type->operands[0]) : type;
+			location += scalar->operands[0] == 64 && type->opcode == OpTypeVector && type->operands[1] > 2 ? 2 : 1;
+			return true;
+		}
+
+		bool GetDescriptorType(const Id& pointee, uint32_t storage, ShaderDescriptorType& type)
+		{
+			switch (pointee.opcode)
+			{
+			case OpTypeSampler:
+				type = ShaderDescriptorType::Sampler;
+				return true;
+			case OpTypeSampledImage:
+				type = ShaderDescriptorType::CombinedImageSampler;
+				return true;
+			case OpTypeImage:
+				// operands: sampled type, dim, depth, arrayed, multisampled, sampled (2 = storage).
+				if (pointee.operands[1] == DimBuffer)
+				{
+					type = pointee.operands[5] == 2 ? ShaderDescriptorType::StorageTexelBuffer : ShaderDescriptorType::UniformTexelBuffer;
+				}
+				else if (pointee.operands[1] == DimSubpassData)
+				{
+					type = ShaderDescriptorType::InputAttachment;
+				}
+				else
+				{
+					type = pointee.operands[5] == 2 ? ShaderDescriptorType::StorageImage : ShaderDescriptorType::SampledImage;
+				}
+				return true;
+			case OpTypeAccelerationStructure:
+				type = ShaderDescriptorType::AccelerationStructure;
+				return true;
+			case OpTypeStruct:
+				// BufferBlock is the storage buffer of SPIR-V before 1.3.
+				if (storage == StorageStorageBuffer || (storage == StorageUniform && pointee.bufferBlock))
+				{
+					type = ShaderDescriptorType::StorageBuffer;
+					return true;
+				}
+				type = ShaderDescriptorType::UniformBuffer;
+				return storage == StorageUniform;
+			default:
+				return false;
+			}
+		}
+	}
+
+	bool ReflectSpirv(const uint32_t* words, size_t wordCount, const std::string& entryPoint,
+					  ShaderReflection& reflection, std::string& error)
+	{
+		reflection = {};
+		if (wordCount < 5 || words[0] != SpirvMagic || words[3] > (1u << 22))
+		{
+			error = "not a SPIR-V module";
+			return false;
+		}
+
+		Module module;
+		module.ids.resize(words[3]);
+		std::vector<EntryPoint> entryPoints;
+		// (function, mode, first operand).
+		std::vector<std::pair<uint32_t, const uint32_t*>> modes;
+
+		for (size_t i = 5; i < wordCount;)
+		{
+			const uint32_t opcode = words[i] & 0xffff;
+			const uint32_t count = words[i] >> 16;
+			if (count == 0 || i + count > wordCount)
+			{
+				error = "truncated SPIR-V";
+				return false;
+			}
+			const uint32_t* instruction = words + i;
+			i += count;
+
+			switch (opcode)
+			{
+			case OpEntryPoint:
+			{
+				if (count < 4)
+				{
+					break;
+				}
+				EntryPoint entry;
+				entry.model = instruction[1];
+				entry.function = instruction[2];
+				// a null terminated string padded to whole words.
+				const char* name = reinterpret_cast<const char*>(instruction + 3);
+				const size_t nameBytes = (count - 3) * sizeof(uint32_t);
+				entry.name.assign(name, strnlen(name, nameBytes));
+				for (uint32_t word = 3 + static_cast<uint32_t>(entry.name.size() / 4 + 1); word < count; word++)
+				{
+					entry.interface.push_back(instruction[word]);
+				}
+				entryPoints.push_back(std::move(entry));
+				break;
+			}
+			case OpExecutionMode:
+				if (count >= 3)
+				{
+					modes.emplace_back(instruction[1], instruction + 2);
+				}
+				break;
+			case OpDecorate:
+			{
+				if (count < 3 || instruction[1] >= module.ids.size())
+				{
+					break;
+				}
+				Id& target = module.ids[instruction[1]];
+				const uint32_t value = count > 3 ? instruction[3] : 0;
+				switch (instruction[2])
+				{
+				case DecorationBufferBlock:
+					target.bufferBlock = true;
+					break;
+				case DecorationArrayStride:
+					target.arrayStride = value;
+					break;
+				case DecorationBuiltIn:
+					target.builtIn = value;
+					break;
+				case DecorationLocation:
+					target.location = value;
+					break;
+				case DecorationBinding:
+					target.binding = value;
+					break;
+				case DecorationDescriptorSet:
+					target.set = value;
+					break;
+				default:
+					break;
+				}
+				break;
+			}
+			case OpMemberDecorate:
+			{
+				if (count < 4)
+				{
+					break;
+				}
+				Member& member = module.members[(uint64_t(instruction[1]) << 32) | instruction[2]];
+				const uint32_t value = count > 4 ? instruction[4] : 0;
+				if (instruction[3] == DecorationOffset)
+				{
+					member.offset = value;
+				}
+				else if (instruction[3] == DecorationMatrixStride)
+				{
+					member.matrixStride = value;
+				}
+				else if (instruction[3] == DecorationRowMajor)
+				{
+					member.rowMajor = true;
+				}
+				break;
+			}
+			case OpTypeBool:
+			case OpTypeInt:
+			case OpTypeFloat:
+			case OpTypeVector:
+			case OpTypeMatrix:
+			case OpTypeImage:
+			case OpTypeSampler:
+			case OpTypeSampledImage:
+			case OpTypeArray:
+			case OpTypeRuntimeArray:
+			case OpTypeStruct:
+			case OpTypePointer:
+			case OpTypeAccelerationStructure:
+			{
+				// result id, then the operands.
+				if (count < GetTypeWordCount(opcode) || instruction[1] >= module.ids.size())
+				{
+					error = "malformed SPIR-V type";
+					return false;
+				}
+				Id& id = module.ids[instruction[1]];
+				id.opcode = opcode;
+				id.operands = instruction + 2;
+				id.operandCount = count - 2;
+				break;
+			}
+			case OpConstant:
+			case OpConstantComposite:
+			case OpSpecConstant:
+			case OpSpecConstantComposite:
+			case OpVariable:
+			{
+				// result type, result id, then the operands.
+				if (count < 3 || instruction[2] >= module.ids.size())
+				{
+					break;
+				}
+				Id& id = module.ids[instruction[2]];
+				id.opcode = opcode;
+				id.type = instruction[1];
+				id.operands = instruction + 3;
+				id.operandCount = count - 3;
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		// a module of one entry point is taken whatever its name, Slang and DXC may rename it.
+		const EntryPoint* entry = nullptr;
+		for (const EntryPoint& candidate : entryPoints)
+		{
+			if (candidate.name == entryPoint || entryPoints.size() == 1)
+			{
+				entry = &candidate;
+				break;
+			}
+		}
+		if (entry == nullptr)
+		{
+			error = "no entry point " + entryPoint;
+			return false;
+		}
+		reflection.stage = GetStage(entry->model);
+		reflection.entryPoint = entry->name;
+		if (reflection.stage == 0 || entry->name.size() >= CookedShaderMaxEntryPoint)
+		{
+			error = "unsupported execution model or entry point name";
+			return false;
+		}
+
+		for (const auto& [function, mode] : modes)
+		{
+			if (function != entry->function)
+			{
+				continue;
+			}
+			for (uint32_t axis = 0; axis < 3 && (mode[0] == ExecutionModeLocalSize || mode[0] == ExecutionModeLocalSizeId); axis++)
+			{
+				reflection.localSize[axis] = mode[0] == ExecutionModeLocalSize ? mode[1 + axis] : module.GetConstant(mode[1 + axis]);
+			}
+		}
+		const uint32_t workStages = ShaderStageCompute | ShaderStageTask | ShaderStageMesh;
+		for (const Id& id : module.ids)
+		{
+			// the WorkgroupSize built-in wins over the execution mode, and carries the
+			// specialization constants of local_size_x_id.
+			if ((reflection.stage & workStages) != 0 && id.builtIn == BuiltInWorkgroupSize && id.operandCount >= 3 &&
+				(id.opcode == OpConstantComposite || id.opcode == OpSpecConstantComposite))
+			{
+				for (uint32_t axis = 0; axis < 3; axis++)
+				{
+					reflection.localSize[axis] = module.GetConstant(id.operands[axis]);
+				}
+			}
+		}
+
+		const bool interfaceListsAll = words[1] >= SpirvVersion14;
+		uint32_t pushConstantEnd = 0;
+		for (uint32_t i = 0; i < module.ids.size(); i++)
+		{
+			const Id& variable = module.ids[i];
+			if (variable.opcode != OpVariable || variable.operandCount < 1)
+			{
+				continue;
+			}
+			const uint32_t storage = variable.operands[0];
+			const bool inInterface = std::find(entry->interface.begin(), entry->interface.end(), i) != entry->interface.end();
+			if ((interfaceListsAll || storage == StorageInput) && !inInterface)
+			{
+				continue;
+			}
+			const Id* pointer = module.Get(variable.type);
+			if (pointer == nullptr || pointer->opcode != OpTypePointer)
+			{
+				continue;
+			}
+
+			if (storage == StorageInput)
+			{
+				if (reflection.stage == ShaderStageVertex && variable.location != NoValue && variable.builtIn == NoValue)
+				{
+					uint32_t location = variable.location;
+					if (!AddVertexInput(module, pointer->operands[1], location, reflection))
+					{
+						error = "vertex input at location " + std::to_string(variable.location) + " has no VkFormat";
+						return false;
+					}
+				}
+				continue;
+			}
+
+			if (storage == StoragePushConstant)
+			{
+				const Id* block = module.Get(pointer->operands[1]);
+				if (block == nullptr || block->opcode != OpTypeStruct)
+				{
+					continue;
+				}
+				uint32_t offset = NoValue;
+				for (uint32_t member = 0; member < block->operandCount; member++)
+				{
+					const Member* decoration = module.GetMember(pointer->operands[1], member);
+					offset = std::min(offset, decoration != nullptr ? decoration->offset : 0);
+				}
+				reflection.pushConstantOffset = offset == NoValue ? 0 : offset;
+				pushConstantEnd = std::max(pushConstantEnd, module.GetTypeSize(pointer->operands[1]));
+				continue;
+			}
+
+			if (storage != StorageUniformConstant && storage != StorageUniform && storage != StorageStorageBuffer)
+			{
+				continue;
+			}
+			// arrays of resources, 0 for runtime sized ones.
+			uint32_t count = 1;
+			const Id* pointee = module.Get(pointer->operands[1]);
+			while (pointee != nullptr && (pointee->opcode == OpTypeArray || pointee->opcode == OpTypeRuntimeArray))
+			{
+				count *= pointee->opcode == OpTypeArray ? module.GetConstant(pointee->operands[1]) : 0;
+				pointee = module.Get(pointee->operands[0]);
+			}
+			ShaderDescriptorType type;
+			if (pointee == nullptr || variable.binding == NoValue || !GetDescriptorType(*pointee, storage, type))
+			{
+				continue;
+			}
+
+			const uint32_t set = variable.set != NoValue ? variable.set : 0;
+			auto same = [&](const CookedShaderBinding& binding) { return binding.set == set && binding.binding == variable.binding; };
+			// aliases of one binding (HLSL views of the same buffer) are one descriptor.
+			if (std::find_if(reflection.bindings.begin(), reflection.bindings.end(), same) == reflection.bindings.end())
+			{
+				reflection.bindings.push_back({ set, variable.binding, type, count });
+			}
+		}
+
+		// vkCmdPushConstants works in multiples of 4 bytes.
+		if (pushConstantEnd > reflection.pushConstantOffset)
+		{
+			reflection.pushConstantSize = ((pushConstantEnd + 3) & ~3u) - reflection.pushConstantOffset;
+		}
+		else
+		{
+			reflection.pushConstantOffset = 0;
+		}
+
+		std::sort(reflection.bindings.begin(), reflection.bindings.end(), [](const CookedShaderBinding& a, const CookedShaderBinding& b)
+		{
+			return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+		});
+		std::sort(reflection.vertexInputs.begin(), reflection.vertexInputs.end(),
+				  [](const CookedShaderVertexInput& a, const CookedShaderVertexInput& b) { return a.location < b.location; });
+		return true;
+	}
+}
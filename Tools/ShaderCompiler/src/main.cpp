@@ -0,0 +1,249 @@
+#include <ShaderCompiler.hpp>
+#include <ANTUTU/Asset/ShaderFormat.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Compiles one shader permutation to a cooked .shader blob (ShaderFormat.hpp):
+// SPIR-V through spirv-opt, with the reflection the runtime builds its
+// pipeline layouts from. Run by antutu_add_shaders for every permutation, e.g.:
+//   ShaderCompiler --compiler glslc --optimizer spirv-opt -DNO_HIZ=1
+//       --depfile out/GpuCulling.comp+NO_HIZ=1.shader.d
+//       shaders/GpuCulling.comp out/GpuCulling.comp+NO_HIZ=1.shader
+//   ShaderCompiler --dump out/GpuCulling.comp.shader
+//
+// exit codes: 0 = success (compiled or up to date), 1 = failure, 2 = bad arguments.
+
+using namespace att::Asset;
+
+static void PrintUsage()
+{
+	std::cout <<
+		"ShaderCompiler [options] <source> <output.shader>\n"
+		"  --compiler PATH         glslc, glslangValidator, dxc or slangc, by file name (glslc)\n"
+		"  --optimizer PATH        spirv-opt, without it the compiler optimizes\n"
+		"  -D NAME[=VALUE]         a define, also -DNAME[=VALUE]\n"
+		"  -I DIR                  an include directory, also -IDIR\n"
+		"  --entry NAME            entry point (main)\n"
+		"  --target-env ENV        vulkan1.1, vulkan1.2 or vulkan1.3 (vulkan1.2)\n"
+		"  --relaxed               RelaxedPrecision float math, needs the optimizer\n"
+		"  --depfile FILE          make style dependencies of the output, for the build\n"
+		"  --force                 compile even when the output is up to date\n"
+		"  --dump FILE.shader      print the reflection of a cooked shader and exit\n";
+}
+
+static const char* GetDescriptorTypeName(ShaderDescriptorType type)
+{
+	switch (type)
+	{
+	case ShaderDescriptorType::Sampler:
+		return "sampler";
+	case ShaderDescriptorType::CombinedImageSampler:
+		return "combined image sampler";
+	case ShaderDescriptorType::SampledImage:
+		return "sampled image";
+	case ShaderDescriptorType::StorageImage:
+		return "storage image";
+	case ShaderDescriptorType::UniformTexelBuffer:
+		return "uniform texel buffer";
+	case ShaderDescriptorType::StorageTexelBuffer:
+		return "storage texel buffer";
+	case ShaderDescriptorType::UniformBuffer:
+		return "uniform buffer";
+	case ShaderDescriptorType::StorageBuffer:
+		return "storage buffer";
+	case ShaderDescriptorType::InputAttachment:
+		return "input attachment";
+	case ShaderDescriptorType::AccelerationStructure:
+		return "acceleration structure";
+	default:
+		return "unknown";
+	}
+}
+
+static int DumpShader(const char* path)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	const uint64_t size = file ? static_cast<uint64_t>(file.tellg()) : 0;
+	file.seekg(0);
+	// 16-byte aligned for ParseCookedShader.
+	struct alignas(16) Block { uint8_t bytes[16]; };
+	std::vector<Block> blob((size + 15) / 16);
+	const CookedShaderHeader* header = file && file.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(size))
+										   ? ParseCookedShader(blob.data(), size) : nullptr;
+	if (header == nullptr)
+	{
+		std::cerr << "Can't read " << path << " as a cooked shader" << std::endl;
+		return 1;
+	}
+
+	std::cout << path << ": " << GetShaderStageName(header->stage) << " \"" << header->entryPoint << "\", "
+			  << header->codeSize << " bytes of SPIR-V, hash " << std::hex << header->sourceHash << std::dec
+			  << ((header->flags & CookedShaderRelaxedPrecision) != 0 ? ", relaxed precision" : "") << '\n';
+	if (header->localSize[0] != 0)
+	{
+		std::cout << "  local size " << header->localSize[0] << " x " << header->localSize[1] << " x " << header->localSize[2] << '\n';
+	}
+	if (header->pushConstantSize != 0)
+	{
+		std::cout << "  push constants " << header->pushConstantOffset << " + " << header->pushConstantSize << " bytes\n";
+	}
+	for (uint32_t i = 0; i < header->bindingCount; i++)
+	{
+		const CookedShaderBinding& binding = GetShaderBindings(*header)[i];
+		std::cout << "  set " << binding.set << " binding " << binding.binding << ": " << GetDescriptorTypeName(binding.type);
+		if (binding.count != 1)
+		{
+			std::cout << (binding.count == 0 ? " [runtime]" : " [" + std::to_string(binding.count) + "]");
+		}
+		std::cout << '\n';
+	}
+	for (uint32_t i = 0; i < header->vertexInputCount; i++)
+	{
+		const CookedShaderVertexInput& input = GetShaderVertexInputs(*header)[i];
+		std::cout << "  location " << input.location << ": VkFormat " << input.format << '\n';
+	}
+	return 0;
+}
+
+// make syntax, read by ninja and by CMake's DEPFILE support.
+static bool WriteDepfile(const std::filesystem::path& path, const std::filesystem::path& output,
+						 const std::vector<std::filesystem::path>& files)
+{
+	auto escape = [](const std::filesystem::path& file)
+	{
+		std::string escaped;
+		for (char c : std::filesystem::absolute(file).lexically_normal().generic_string())
+		{
+			escaped += c == ' ' ? "\\ " : c == '$' ? "$$" : c == '#' ? "\\#" : std::string(1, c);
+		}
+		return escaped;
+	};
+
+	std::ofstream file(path, std::ios::trunc);
+	file << escape(output) << ':';
+	for (const std::filesystem::path& dependency : files)
+	{
+		file << " \\\n  " << escape(dependency);
+	}
+	file << '\n';
+	return static_cast<bool>(file);
+}
+
+int main(int argc, char** argv)
+{
+	Cooker::CompileSettings settings;
+	settings.compiler = "glslc";
+	const char* depfile = nullptr;
+	std::vector<const char*> positional;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		auto takesValue = [&]()
+		{
+			if (value == nullptr)
+			{
+				std::cerr << arg << " needs a value" << std::endl;
+				std::exit(2);
+			}
+			i++;
+			return value;
+		};
+
+		if (strcmp(arg, "--compiler") == 0)
+		{
+			settings.compiler = takesValue();
+		}
+		else if (strcmp(arg, "--optimizer") == 0)
+		{
+			settings.optimizer = takesValue();
+		}
+		else if (strncmp(arg, "-D", 2) == 0)
+		{
+			settings.defines.emplace_back(arg[2] != '\0' ? arg + 2 : takesValue());
+		}
+		else if (strncmp(arg, "-I", 2) == 0)
+		{
+			settings.includeDirs.emplace_back(arg[2] != '\0' ? arg + 2 : takesValue());
+		}
+		else if (strcmp(arg, "--entry") == 0)
+		{
+			settings.entryPoint = takesValue();
+			if (settings.entryPoint.empty() || settings.entryPoint.size() >= CookedShaderMaxEntryPoint)
+			{
+				std::cerr << "--entry needs 1 to " << CookedShaderMaxEntryPoint - 1 << " characters" << std::endl;
+				return 2;
+			}
+		}
+		else if (strcmp(arg, "--target-env") == 0)
+		{
+			settings.targetEnv = takesValue();
+		}
+		else if (strcmp(arg, "--relaxed") == 0)
+		{
+			settings.relaxedPrecision = true;
+		}
+		else if (strcmp(arg, "--depfile") == 0)
+		{
+			depfile = takesValue();
+		}
+		else if (strcmp(arg, "--force") == 0)
+		{
+			settings.force = true;
+		}
+		else if (strcmp(arg, "--dump") == 0)
+		{
+			return DumpShader(takesValue());
+		}
+		else if (arg[0] == '-')
+		{
+			PrintUsage();
+			return strcmp(arg, "--help") == 0 ? EXIT_SUCCESS : 2;
+		}
+		else
+		{
+			positional.push_back(arg);
+		}
+	}
+
+	if (positional.size() != 2)
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	const std::filesystem::path source(positional[0]);
+	const std::filesystem::path output(positional[1]);
+	Cooker::CompileReport report;
+	std::string error;
+	if (!Cooker::CompileShader(source, output, settings, report, error))
+	{
+		std::cerr << source.string() << ": " << error << std::endl;
+		return EXIT_FAILURE;
+	}
+	// also when up to date: the includes may have changed without changing the output.
+	if (depfile != nullptr && !WriteDepfile(depfile, output, report.files))
+	{
+		std::cerr << "Can't write " << depfile << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!report.upToDate)
+	{
+		const Cooker::ShaderReflection& reflection = report.reflection;
+		std::cout << std::fixed << std::setprecision(1) << output.filename().string() << ": "
+				  << GetShaderStageName(reflection.stage) << ", " << reflection.bindings.size() << " bindings, "
+				  << reflection.pushConstantSize << " push constant bytes, " << reflection.vertexInputs.size() << " vertex inputs, "
+				  << report.spirvBytes << " -> " << report.optimizedBytes << " bytes of SPIR-V, compile " << report.compileMs
+				  << " ms, optimize " << report.optimizeMs << " ms" << std::endl;
+	}
+	return EXIT_SUCCESS;
+}
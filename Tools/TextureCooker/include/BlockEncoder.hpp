@@ -0,0 +1,40 @@
+#ifndef TEXTURE_COOKER_BLOCK_ENCODER_H
+#define TEXTURE_COOKER_BLOCK_ENCODER_H
+
+#include <ImageLoader.hpp>
+#include <ANTUTU/Asset/TextureFormat.hpp>
+
+#include <cstdint>
+
+namespace Cooker
+{
+	// pixels: a 4x4 block of RGBA8, row by row. Every encoder fits one pair of endpoints
+	// along the principal axis of the block and refines them by least squares against the
+	// indices it picked.
+
+	// 8 bytes, RGB in 4 color mode, alpha ignored.
+	void EncodeBC1(const uint8_t* pixels, uint8_t* block);
+	// 16 bytes, BC4 alpha then BC1 color.
+	void EncodeBC3(const uint8_t* pixels, uint8_t* block);
+	// 8 bytes, one channel of the pixels (0 = red...).
+	void EncodeBC4(const uint8_t* pixels, uint32_t channel, uint8_t* block);
+	// 16 bytes, BC4 red then BC4 green.
+	void EncodeBC5(const uint8_t* pixels, uint8_t* block);
+	// 16 bytes, one subset: mode 6 (RGBA 7.7.7.7 endpoints with a p-bit, 4-bit indices), or
+	// mode 5 (RGB 7.7.7 and alpha 8 with 2-bit indices each) where alpha varies on its own.
+	void EncodeBC7(const uint8_t* pixels, uint8_t* block);
+
+#if defined(ANTUTU_PLATFORM_MOBILE)
+	// 16 bytes, ASTC 4x4 LDR, one partition with 8-bit endpoints: RGB direct with 3-bit
+	// weights for opaque blocks, RGBA direct with 2-bit weights for the others.
+	void EncodeASTC4x4(const uint8_t* pixels, uint8_t* block);
+#endif
+
+	bool IsFormatSupported(att::Asset::TextureFormat format);
+
+	// the whole image in blocks of format, GetTextureMipBytes bytes, block rows on the job
+	// system. Edge blocks repeat the last row and column.
+	void EncodeImage(const Image& image, att::Asset::TextureFormat format, uint8_t* output);
+}
+
+#endif	// TEXTURE_COOKER_BLOCK_ENCODER_H
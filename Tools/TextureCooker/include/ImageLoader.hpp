@@ -0,0 +1,26 @@
+#ifndef TEXTURE_COOKER_IMAGE_LOADER_H
+#define TEXTURE_COOKER_IMAGE_LOADER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Cooker
+{
+	// RGBA8, rows top to bottom.
+	struct Image
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<uint8_t> pixels;
+	};
+
+	bool IsImageFile(const std::filesystem::path& path);
+
+	// .tga (uncompressed or RLE, gray, RGB or RGBA) and .png when built with libpng.
+	// On failure error says why.
+	bool LoadImage(const std::filesystem::path& path, Image& image, std::string& error);
+}
+
+#endif	// TEXTURE_COOKER_IMAGE_LOADER_H
@@ -0,0 +1,29 @@
+#ifndef TEXTURE_COOKER_MIP_GENERATOR_H
+#define TEXTURE_COOKER_MIP_GENERATOR_H
+
+#include <ImageLoader.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Cooker
+{
+	struct MipSettings
+	{
+		// the color channels are sRGB encoded: filtered in linear space.
+		bool srgb = true;
+		// xyz in the color channels: filtered as vectors and renormalized.
+		bool normalMap = false;
+		// 0: down to 1x1.
+		uint32_t maxMips = 0;
+	};
+
+	uint32_t GetMipCount(uint32_t width, uint32_t height, uint32_t maxMips);
+
+	// mip 0 (the source as is) first. Every mip is filtered from the previous one in float,
+	// color weighted by alpha so transparent texels don't bleed into the opaque ones; the
+	// rows run on the job system.
+	std::vector<Image> GenerateMips(const Image& source, const MipSettings& settings);
+}
+
+#endif	// TEXTURE_COOKER_MIP_GENERATOR_H
@@ -0,0 +1,41 @@
+#ifndef TEXTURE_COOKER_TEXTURE_COOKER_H
+#define TEXTURE_COOKER_TEXTURE_COOKER_H
+
+#include <ImageLoader.hpp>
+#include <ANTUTU/Asset/TextureFormat.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Cooker
+{
+	struct CookSettings
+	{
+		// the linear format, the sRGB variant is picked when srgb is set.
+		att::Asset::TextureFormat format = att::Asset::TextureFormat::BC7;
+		// color data, filtered in linear space and sampled through an sRGB format.
+		bool srgb = true;
+		bool normalMap = false;
+		// 0: the full chain.
+		uint32_t maxMips = 0;
+	};
+
+	struct CookReport
+	{
+		att::Asset::TextureFormat format = att::Asset::TextureFormat::RGBA8;
+		uint32_t mipCount = 0;
+		uint32_t tailMip = 0;
+		// RGBA8 with every mip.
+		uint64_t sourceBytes = 0;
+		uint64_t cookedBytes = 0;
+		// header and packed tail, the first read of the runtime.
+		uint64_t tailBytes = 0;
+		double mipMs = 0.0;
+		double encodeMs = 0.0;
+	};
+
+	// the CookedTextureHeader blob of TextureFormat.hpp, the image at most 32768 on a side.
+	void CookTexture(const Image& image, const CookSettings& settings, std::vector<uint8_t>& blob, CookReport& report);
+}
+
+#endif	// TEXTURE_COOKER_TEXTURE_COOKER_H
@@ -0,0 +1,678 @@
+#include <BlockEncoder.hpp>
+#include <Common/Job/JobSystem.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+using att::Asset::TextureFormat;
+
+namespace Cooker
+{
+	// endpoints as the GPU decodes them (0-255) and the palette index of every pixel.
+	struct EndpointFit
+	{
+		int endpoints[2][4] = {};
+		uint8_t indices[16] = {};
+		float error = FLT_MAX;
+	};
+
+	// LSB first, into a zeroed block.
+	struct BitWriter
+	{
+		uint8_t* block;
+		uint32_t position = 0;
+
+		void Write(uint32_t value, uint32_t bits)
+		{
+			for (uint32_t i = 0; i < bits; i++, position++)
+			{
+				block[position >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (position & 7));
+			}
+		}
+	};
+
+	static void LoadBlock(const uint8_t* pixels, float values[16][4])
+	{
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				values[i][c] = pixels[i * 4 + c];
+			}
+		}
+	}
+
+	static void GetPrincipalAxis(const float values[16][4], uint32_t channels, float mean[4], float axis[4])
+	{
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			mean[c] = 0.0f;
+			axis[c] = 0.0f;
+		}
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				mean[c] += values[i][c] / 16.0f;
+			}
+		}
+
+		float covariance[4][4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			for (uint32_t a = 0; a < channels; a++)
+			{
+				for (uint32_t b = 0; b < channels; b++)
+				{
+					covariance[a][b] += (values[i][a] - mean[a]) * (values[i][b] - mean[b]);
+				}
+			}
+		}
+
+		// power iteration from the row of the widest channel.
+		uint32_t widest = 0;
+		for (uint32_t c = 1; c < channels; c++)
+		{
+			widest = covariance[c][c] > covariance[widest][widest] ? c : widest;
+		}
+		if (covariance[widest][widest] <= 0.0f)
+		{
+			return;
+		}
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			axis[c] = covariance[widest][c];
+		}
+		for (uint32_t iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+			for (uint32_t a = 0; a < channels; a++)
+			{
+				for (uint32_t b = 0; b < channels; b++)
+				{
+					next[a] += covariance[a][b] * axis[b];
+				}
+				length += next[a] * next[a];
+			}
+			if (length <= 0.0f)
+			{
+				return;
+			}
+			length = 1.0f / std::sqrt(length);
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				axis[c] = next[c] * length;
+			}
+		}
+	}
+
+	// indices to the nearest palette entry, returns the squared error.
+	static float SelectIndices(const float values[16][4], uint32_t channels, const int endpoints[2][4], const float* weights,
+							   uint32_t levels, uint8_t* indices)
+	{
+		float palette[16][4];
+		for (uint32_t k = 0; k < levels; k++)
+		{
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				palette[k][c] = endpoints[0][c] + (endpoints[1][c] - endpoints[0][c]) * weights[k];
+			}
+		}
+
+		float error = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float best = FLT_MAX;
+			for (uint32_t k = 0; k < levels; k++)
+			{
+				float distance = 0.0f;
+				for (uint32_t c = 0; c < channels; c++)
+				{
+					const float d = values[i][c] - palette[k][c];
+					distance += d * d;
+				}
+				if (distance < best)
+				{
+					best = distance;
+					indices[i] = static_cast<uint8_t>(k);
+				}
+			}
+			error += best;
+		}
+		return error;
+	}
+
+	// least squares endpoints for the indices, false when they don't span the block.
+	static bool RefineEndpoints(const float values[16][4], uint32_t channels, const uint8_t* indices, const float* weights,
+								float endpoints[2][4])
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ax[4] = {}, bx[4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			const float t = weights[indices[i]];
+			const float s = 1.0f - t;
+			aa += s * s;
+			ab += s * t;
+			bb += t * t;
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				ax[c] += s * values[i][c];
+				bx[c] += t * values[i][c];
+			}
+		}
+
+		const float determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f)
+		{
+			return false;
+		}
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			endpoints[0][c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+			endpoints[1][c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	// the extremes along the principal axis, then a few rounds of index selection and least
+	// squares. quantize(float in[2][4], int out[2][4]) gives the endpoints the format can store.
+	template<typename Quantize>
+	static EndpointFit FitEndpoints(const float values[16][4], uint32_t channels, const float* weights, uint32_t levels, Quantize quantize)
+	{
+		float mean[4], axis[4];
+		GetPrincipalAxis(values, channels, mean, axis);
+		float low = FLT_MAX;
+		float high = -FLT_MAX;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float projection = 0.0f;
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				projection += (values[i][c] - mean[c]) * axis[c];
+			}
+			low = std::min(low, projection);
+			high = std::max(high, projection);
+		}
+
+		float endpoints[2][4] = {};
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			endpoints[0][c] = std::clamp(mean[c] + axis[c] * low, 0.0f, 255.0f);
+			endpoints[1][c] = std::clamp(mean[c] + axis[c] * high, 0.0f, 255.0f);
+		}
+
+		EndpointFit best;
+		for (uint32_t iteration = 0; iteration < 3; iteration++)
+		{
+			EndpointFit fit;
+			quantize(endpoints, fit.endpoints);
+			fit.error = SelectIndices(values, channels, fit.endpoints, weights, levels, fit.indices);
+			if (fit.error < best.error)
+			{
+				best = fit;
+			}
+			if (best.error == 0.0f || !RefineEndpoints(values, channels, fit.indices, weights, endpoints))
+			{
+				break;
+			}
+		}
+		return best;
+	}
+
+	static void QuantizeUnorm8(const float in[2][4], int out[2][4])
+	{
+		for (uint32_t e = 0; e < 2; e++)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				out[e][c] = static_cast<int>(std::lround(std::clamp(in[e][c], 0.0f, 255.0f)));
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// BC1 / BC3
+	////////////////////////////////////////////////////////////////////////////
+
+	// index order of the format: c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1.
+	static const float BC1Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+	static void QuantizeRgb565(const float in[2][4], int out[2][4])
+	{
+		static const int Bits[3] = { 5, 6, 5 };
+		for (uint32_t e = 0; e < 2; e++)
+		{
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				const int maximum = (1 << Bits[c]) - 1;
+				const int value = static_cast<int>(std::lround(std::clamp(in[e][c], 0.0f, 255.0f) * maximum / 255.0f));
+				// the decoder's bit replication.
+				out[e][c] = (value << (8 - Bits[c])) | (value >> (2 * Bits[c] - 8));
+			}
+		}
+	}
+
+	static uint16_t Pack565(const int color[4])
+	{
+		return static_cast<uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+	}
+
+	static void WriteColorBlock(const uint8_t* pixels, uint8_t* block)
+	{
+		float values[16][4];
+		LoadBlock(pixels, values);
+		EndpointFit fit = FitEndpoints(values, 3, BC1Weights, 4, QuantizeRgb565);
+
+		uint16_t color0 = Pack565(fit.endpoints[0]);
+		uint16_t color1 = Pack565(fit.endpoints[1]);
+		// color0 > color1 selects the 4 color mode, swapping the endpoints swaps 0 / 1 and 2 / 3.
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+			for (uint8_t& index : fit.indices)
+			{
+				index ^= 1;
+			}
+		}
+		else if (color0 == color1)
+		{
+			memset(fit.indices, 0, sizeof(fit.indices));
+		}
+
+		block[0] = static_cast<uint8_t>(color0);
+		block[1] = static_cast<uint8_t>(color0 >> 8);
+		block[2] = static_cast<uint8_t>(color1);
+		block[3] = static_cast<uint8_t>(color1 >> 8);
+		uint32_t indices = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			indices |= static_cast<uint32_t>(fit.indices[i]) << (i * 2);
+		}
+		memcpy(block + 4, &indices, 4);
+	}
+
+	void EncodeBC1(const uint8_t* pixels, uint8_t* block)
+	{
+		WriteColorBlock(pixels, block);
+	}
+
+	void EncodeBC3(const uint8_t* pixels, uint8_t* block)
+	{
+		EncodeBC4(pixels, 3, block);
+		WriteColorBlock(pixels, block + 8);
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// BC4 / BC5
+	////////////////////////////////////////////////////////////////////////////
+
+	// 8 value mode (a0 > a1): a0, a1, then 6/7 a0 + 1/7 a1 ... 1/7 a0 + 6/7 a1.
+	static const float BC4Weights[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+
+	static void WriteBC4(int a0, int a1, const uint8_t* indices, uint8_t* block)
+	{
+		block[0] = static_cast<uint8_t>(a0);
+		block[1] = static_cast<uint8_t>(a1);
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			bits |= static_cast<uint64_t>(indices[i]) << (i * 3);
+		}
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			block[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+		}
+	}
+
+	void EncodeBC4(const uint8_t* pixels, uint32_t channel, uint8_t* block)
+	{
+		float values[16][4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			values[i][0] = pixels[i * 4 + channel];
+		}
+
+		EndpointFit fit = FitEndpoints(values, 1, BC4Weights, 8, QuantizeUnorm8);
+		int a0 = fit.endpoints[0][0];
+		int a1 = fit.endpoints[1][0];
+		if (a0 < a1)
+		{
+			std::swap(a0, a1);
+			for (uint8_t& index : fit.indices)
+			{
+				index = index < 2 ? index ^ 1 : static_cast<uint8_t>(9 - index);
+			}
+		}
+		else if (a0 == a1)
+		{
+			// a0 <= a1 is the 6 value mode, index 0 is a0 there too.
+			memset(fit.indices, 0, sizeof(fit.indices));
+		}
+
+		// 6 value mode (a0 <= a1): a0, a1, four steps between them, then 0 and 255. Better
+		// when the block has both extremes and a cluster elsewhere, e.g. alpha cutouts.
+		int low = 255;
+		int high = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			const int value = static_cast<int>(values[i][0]);
+			if (value != 0 && value != 255)
+			{
+				low = std::min(low, value);
+				high = std::max(high, value);
+			}
+		}
+		if (low > high)
+		{
+			low = high = 0;
+		}
+		float palette[8];
+		for (uint32_t k = 0; k < 6; k++)
+		{
+			palette[k] = low + (high - low) * (k == 0 ? 0.0f : k == 1 ? 1.0f : (k - 1) / 5.0f);
+		}
+		palette[6] = 0.0f;
+		palette[7] = 255.0f;
+		uint8_t indices[16];
+		float error = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float best = FLT_MAX;
+			for (uint32_t k = 0; k < 8; k++)
+			{
+				const float d = (values[i][0] - palette[k]) * (values[i][0] - palette[k]);
+				if (d < best)
+				{
+					best = d;
+					indices[i] = static_cast<uint8_t>(k);
+				}
+			}
+			error += best;
+		}
+
+		if (error < fit.error)
+		{
+			WriteBC4(low, high, indices, block);
+		}
+		else
+		{
+			WriteBC4(a0, a1, fit.indices, block);
+		}
+	}
+
+	void EncodeBC5(const uint8_t* pixels, uint8_t* block)
+	{
+		EncodeBC4(pixels, 0, block);
+		EncodeBC4(pixels, 1, block + 8);
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// BC7
+	////////////////////////////////////////////////////////////////////////////
+
+	static const float BC7Weights[16] = {
+		0 / 64.0f, 4 / 64.0f, 9 / 64.0f, 13 / 64.0f, 17 / 64.0f, 21 / 64.0f, 26 / 64.0f, 30 / 64.0f,
+		34 / 64.0f, 38 / 64.0f, 43 / 64.0f, 47 / 64.0f, 51 / 64.0f, 55 / 64.0f, 60 / 64.0f, 64 / 64.0f
+	};
+
+	// 7 bits per channel and a p-bit shared by the endpoint's channels.
+	static void QuantizeRgba7P(const float in[2][4], int out[2][4])
+	{
+		for (uint32_t e = 0; e < 2; e++)
+		{
+			float bestError = FLT_MAX;
+			for (int p = 0; p < 2; p++)
+			{
+				int candidate[4];
+				float error = 0.0f;
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					const int value = std::clamp(static_cast<int>(std::lround((in[e][c] - p) * 0.5f)), 0, 127);
+					candidate[c] = (value << 1) | p;
+					error += (candidate[c] - in[e][c]) * (candidate[c] - in[e][c]);
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					memcpy(out[e], candidate, sizeof(candidate));
+				}
+			}
+		}
+	}
+
+	static const float BC7Weights2[4] = { 0 / 64.0f, 21 / 64.0f, 43 / 64.0f, 64 / 64.0f };
+
+	static void QuantizeRgb7(const float in[2][4], int out[2][4])
+	{
+		for (uint32_t e = 0; e < 2; e++)
+		{
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				const int value = static_cast<int>(std::lround(std::clamp(in[e][c], 0.0f, 255.0f) * 127.0f / 255.0f));
+				out[e][c] = (value << 1) | (value >> 6);
+			}
+		}
+	}
+
+	// the first index of a set is stored without its top bit, which must be 0.
+	static void SetAnchor(EndpointFit& fit, uint32_t levels)
+	{
+		if (fit.indices[0] >= levels / 2)
+		{
+			std::swap(fit.endpoints[0], fit.endpoints[1]);
+			for (uint8_t& index : fit.indices)
+			{
+				index = static_cast<uint8_t>(levels - 1 - index);
+			}
+		}
+	}
+
+	void EncodeBC7(const uint8_t* pixels, uint8_t* block)
+	{
+		float values[16][4];
+		LoadBlock(pixels, values);
+		EndpointFit fit = FitEndpoints(values, 4, BC7Weights, 16, QuantizeRgba7P);
+
+		// mode 5 for blocks whose alpha doesn't follow the color, e.g. cutout edges: RGB and
+		// alpha with their own endpoints and 2-bit indices.
+		bool translucent = false;
+		for (uint32_t i = 0; i < 16 && !translucent; i++)
+		{
+			translucent = pixels[i * 4 + 3] != pixels[3];
+		}
+		if (translucent && fit.error > 0.0f)
+		{
+			float alphas[16][4] = {};
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				alphas[i][0] = values[i][3];
+			}
+			EndpointFit color = FitEndpoints(values, 3, BC7Weights2, 4, QuantizeRgb7);
+			EndpointFit alpha = FitEndpoints(alphas, 1, BC7Weights2, 4, QuantizeUnorm8);
+			if (color.error + alpha.error < fit.error)
+			{
+				SetAnchor(color, 4);
+				SetAnchor(alpha, 4);
+
+				memset(block, 0, 16);
+				BitWriter writer{ block };
+				// mode 5, no channel rotation.
+				writer.Write(1 << 5, 6);
+				writer.Write(0, 2);
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					writer.Write(static_cast<uint32_t>(color.endpoints[0][c]) >> 1, 7);
+					writer.Write(static_cast<uint32_t>(color.endpoints[1][c]) >> 1, 7);
+				}
+				writer.Write(static_cast<uint32_t>(alpha.endpoints[0][0]), 8);
+				writer.Write(static_cast<uint32_t>(alpha.endpoints[1][0]), 8);
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					writer.Write(color.indices[i], i == 0 ? 1 : 2);
+				}
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					writer.Write(alpha.indices[i], i == 0 ? 1 : 2);
+				}
+				return;
+			}
+		}
+
+		// mode 6: one line through RGBA.
+		SetAnchor(fit, 16);
+		memset(block, 0, 16);
+		BitWriter writer{ block };
+		writer.Write(1 << 6, 7);
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			writer.Write(static_cast<uint32_t>(fit.endpoints[0][c]) >> 1, 7);
+			writer.Write(static_cast<uint32_t>(fit.endpoints[1][c]) >> 1, 7);
+		}
+		writer.Write(static_cast<uint32_t>(fit.endpoints[0][0]) & 1, 1);
+		writer.Write(static_cast<uint32_t>(fit.endpoints[1][0]) & 1, 1);
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			writer.Write(fit.indices[i], i == 0 ? 3 : 4);
+		}
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// ASTC
+	////////////////////////////////////////////////////////////////////////////
+
+#if defined(ANTUTU_PLATFORM_MOBILE)
+	// the decoder's weight unquantization, out of 64.
+	static const float AstcWeights3[8] = { 0 / 64.0f, 9 / 64.0f, 18 / 64.0f, 27 / 64.0f, 37 / 64.0f, 46 / 64.0f, 55 / 64.0f, 64 / 64.0f };
+	static const float AstcWeights2[4] = { 0 / 64.0f, 21 / 64.0f, 43 / 64.0f, 64 / 64.0f };
+
+	// 4x4 weight grid, single plane: 0x53 with 3-bit weights, 0x42 with 2-bit weights.
+	static constexpr uint32_t AstcBlockModeWeights3 = 0x53;
+	static constexpr uint32_t AstcBlockModeWeights2 = 0x42;
+	static constexpr uint32_t AstcEndpointModeRgb = 8;
+	static constexpr uint32_t AstcEndpointModeRgba = 12;
+
+	void EncodeASTC4x4(const uint8_t* pixels, uint8_t* block)
+	{
+		float values[16][4];
+		LoadBlock(pixels, values);
+		bool opaque = true;
+		for (uint32_t i = 0; i < 16 && opaque; i++)
+		{
+			opaque = pixels[i * 4 + 3] == 255;
+		}
+
+		// what is left for the endpoints after the weights fits 8 bits per value: 63 bits for
+		// 6 values with 48 bits of weights, 79 for 8 values with 32.
+		const uint32_t channels = opaque ? 3 : 4;
+		const uint32_t weightBits = opaque ? 3 : 2;
+		const uint32_t levels = 1u << weightBits;
+		EndpointFit fit = FitEndpoints(values, channels, opaque ? AstcWeights3 : AstcWeights2, levels, QuantizeUnorm8);
+
+		// with the second endpoint darker the decoder swaps them and applies blue contraction.
+		if (fit.endpoints[1][0] + fit.endpoints[1][1] + fit.endpoints[1][2] < fit.endpoints[0][0] + fit.endpoints[0][1] + fit.endpoints[0][2])
+		{
+			std::swap(fit.endpoints[0], fit.endpoints[1]);
+			for (uint8_t& index : fit.indices)
+			{
+				index = static_cast<uint8_t>(levels - 1 - index);
+			}
+		}
+
+		memset(block, 0, 16);
+		BitWriter writer{ block };
+		writer.Write(opaque ? AstcBlockModeWeights3 : AstcBlockModeWeights2, 11);
+		// one partition, its endpoint mode.
+		writer.Write(0, 2);
+		writer.Write(opaque ? AstcEndpointModeRgb : AstcEndpointModeRgba, 4);
+		for (uint32_t c = 0; c < channels; c++)
+		{
+			writer.Write(static_cast<uint32_t>(fit.endpoints[0][c]), 8);
+			writer.Write(static_cast<uint32_t>(fit.endpoints[1][c]), 8);
+		}
+		// the weights are stored from the top of the block down, bit reversed.
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			for (uint32_t b = 0; b < weightBits; b++)
+			{
+				const uint32_t position = 127 - (i * weightBits + b);
+				block[position >> 3] |= static_cast<uint8_t>(((fit.indices[i] >> b) & 1) << (position & 7));
+			}
+		}
+	}
+#endif
+
+	////////////////////////////////////////////////////////////////////////////
+	/// Images
+	////////////////////////////////////////////////////////////////////////////
+
+	bool IsFormatSupported(TextureFormat format)
+	{
+#if defined(ANTUTU_PLATFORM_MOBILE)
+		return format < TextureFormat::Count;
+#else
+		return format < TextureFormat::ASTC4x4;
+#endif
+	}
+
+	void EncodeImage(const Image& image, TextureFormat format, uint8_t* output)
+	{
+		if (att::Asset::GetTextureBlockSize(format) == 1)
+		{
+			memcpy(output, image.pixels.data(), image.pixels.size());
+			return;
+		}
+
+		const uint32_t blocksX = (image.width + 3) / 4;
+		const uint32_t blocksY = (image.height + 3) / 4;
+		const uint32_t blockBytes = att::Asset::GetTextureBlockBytes(format);
+		Common::JobSystem::Get().ParallelFor(blocksY, std::max(256 / blocksX, 1u), [&](uint32_t begin, uint32_t end)
+		{
+			uint8_t pixels[64];
+			for (uint32_t by = begin; by < end; by++)
+			{
+				for (uint32_t bx = 0; bx < blocksX; bx++)
+				{
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						const uint32_t x = std::min(bx * 4 + i % 4, image.width - 1);
+						const uint32_t y = std::min(by * 4 + i / 4, image.height - 1);
+						memcpy(pixels + i * 4, &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4], 4);
+					}
+
+					uint8_t* block = output + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+					switch (format)
+					{
+					case TextureFormat::BC1:
+					case TextureFormat::BC1Srgb:
+						EncodeBC1(pixels, block);
+						break;
+					case TextureFormat::BC3:
+					case TextureFormat::BC3Srgb:
+						EncodeBC3(pixels, block);
+						break;
+					case TextureFormat::BC5:
+						EncodeBC5(pixels, block);
+						break;
+					case TextureFormat::BC7:
+					case TextureFormat::BC7Srgb:
+						EncodeBC7(pixels, block);
+						break;
+#if defined(ANTUTU_PLATFORM_MOBILE)
+					case TextureFormat::ASTC4x4:
+					case TextureFormat::ASTC4x4Srgb:
+						EncodeASTC4x4(pixels, block);
+						break;
+#endif
+					default:
+						memset(block, 0, blockBytes);
+						break;
+					}
+				}
+			}
+		});
+	}
+}
@@ -0,0 +1,195 @@
+#include <ImageLoader.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+#if defined(TEXTURE_COOKER_PNG)
+	#include <png.h>
+#endif
+
+namespace Cooker
+{
+	static bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& bytes)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			return false;
+		}
+		bytes.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		return bytes.empty() || file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	static std::string GetExtension(const std::filesystem::path& path)
+	{
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+		return extension;
+	}
+
+	bool IsImageFile(const std::filesystem::path& path)
+	{
+		const std::string extension = GetExtension(path);
+#if defined(TEXTURE_COOKER_PNG)
+		if (extension == ".png")
+		{
+			return true;
+		}
+#endif
+		return extension == ".tga";
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// TGA
+	////////////////////////////////////////////////////////////////////////////
+
+	static bool LoadTga(const std::vector<uint8_t>& bytes, Image& image, std::string& error)
+	{
+		if (bytes.size() < 18)
+		{
+			error = "truncated TGA header";
+			return false;
+		}
+
+		const uint32_t idLength = bytes[0];
+		const uint32_t colorMapType = bytes[1];
+		const uint32_t imageType = bytes[2];
+		const uint32_t width = bytes[12] | (bytes[13] << 8);
+		const uint32_t height = bytes[14] | (bytes[15] << 8);
+		const uint32_t bitsPerPixel = bytes[16];
+		const bool topDown = (bytes[17] & 0x20) != 0;
+		const bool rle = imageType == 10 || imageType == 11;
+		const bool gray = imageType == 3 || imageType == 11;
+		// 2 / 10: true color, 3 / 11: gray, the color mapped ones aren't used for textures.
+		if (colorMapType != 0 || (imageType != 2 && imageType != 3 && !rle) ||
+			(gray ? bitsPerPixel != 8 : bitsPerPixel != 24 && bitsPerPixel != 32))
+		{
+			error = "unsupported TGA (color mapped or not 8, 24 or 32 bits)";
+			return false;
+		}
+		if (width == 0 || height == 0)
+		{
+			error = "empty image";
+			return false;
+		}
+
+		const uint32_t pixelSize = bitsPerPixel / 8;
+		const size_t pixelCount = static_cast<size_t>(width) * height;
+		size_t cursor = 18 + idLength;
+		image.width = width;
+		image.height = height;
+		image.pixels.resize(pixelCount * 4);
+
+		auto store = [&](size_t pixel, const uint8_t* source)
+		{
+			// stored bottom row first unless topDown, BGR(A).
+			const size_t x = pixel % width;
+			const size_t y = topDown ? pixel / width : height - 1 - pixel / width;
+			uint8_t* out = &image.pixels[(y * width + x) * 4];
+			if (gray)
+			{
+				out[0] = out[1] = out[2] = source[0];
+				out[3] = 255;
+			}
+			else
+			{
+				out[0] = source[2];
+				out[1] = source[1];
+				out[2] = source[0];
+				out[3] = pixelSize == 4 ? source[3] : 255;
+			}
+		};
+
+		size_t pixel = 0;
+		while (pixel < pixelCount)
+		{
+			size_t run = 1;
+			bool repeat = false;
+			if (rle)
+			{
+				if (cursor >= bytes.size())
+				{
+					break;
+				}
+				run = (bytes[cursor] & 0x7F) + 1u;
+				repeat = (bytes[cursor] & 0x80) != 0;
+				cursor++;
+			}
+			const size_t needed = repeat ? pixelSize : run * pixelSize;
+			if (cursor + needed > bytes.size() || pixel + run > pixelCount)
+			{
+				break;
+			}
+			for (size_t i = 0; i < run; i++)
+			{
+				store(pixel++, &bytes[cursor + (repeat ? 0 : i * pixelSize)]);
+			}
+			cursor += needed;
+		}
+		if (pixel < pixelCount)
+		{
+			error = "truncated TGA pixel data";
+			return false;
+		}
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////////////////////
+	/// PNG
+	////////////////////////////////////////////////////////////////////////////
+
+#if defined(TEXTURE_COOKER_PNG)
+	static bool LoadPng(const std::vector<uint8_t>& bytes, Image& image, std::string& error)
+	{
+		png_image png;
+		memset(&png, 0, sizeof(png));
+		png.version = PNG_IMAGE_VERSION;
+		if (!png_image_begin_read_from_memory(&png, bytes.data(), bytes.size()))
+		{
+			error = png.message;
+			return false;
+		}
+
+		// 16-bit and palette images are converted by libpng.
+		png.format = PNG_FORMAT_RGBA;
+		image.width = png.width;
+		image.height = png.height;
+		image.pixels.resize(PNG_IMAGE_SIZE(png));
+		if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr))
+		{
+			error = png.message;
+			png_image_free(&png);
+			return false;
+		}
+		return true;
+	}
+#endif
+
+	bool LoadImage(const std::filesystem::path& path, Image& image, std::string& error)
+	{
+		image = {};
+		std::vector<uint8_t> bytes;
+		if (!ReadFile(path, bytes))
+		{
+			error = "can't read the file";
+			return false;
+		}
+
+		const std::string extension = GetExtension(path);
+		if (extension == ".tga")
+		{
+			return LoadTga(bytes, image, error);
+		}
+#if defined(TEXTURE_COOKER_PNG)
+		if (extension == ".png")
+		{
+			return LoadPng(bytes, image, error);
+		}
+#endif
+		error = "unsupported image format " + extension;
+		return false;
+	}
+}
@@ -0,0 +1,246 @@
+#include <MipGenerator.hpp>
+#include <Common/Job/JobSystem.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Cooker
+{
+	// one source texel of a destination texel's footprint.
+	struct Tap
+	{
+		uint32_t source;
+		float weight;
+	};
+
+	// linear RGBA, color premultiplied by alpha. plain keeps the color unweighted for the
+	// texels whose footprint is fully transparent, empty for opaque images.
+	struct FloatImage
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<glm::vec4> texels;
+		std::vector<glm::vec3> plain;
+	};
+
+	static float SrgbToLinear(float c)
+	{
+		return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+	}
+
+	static float LinearToSrgb(float c)
+	{
+		return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+	}
+
+	static uint8_t ToUnorm8(float value)
+	{
+		return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+	}
+
+	static uint32_t BatchRows(uint32_t width)
+	{
+		return std::max(16384u / std::max(width, 1u), 1u);
+	}
+
+	uint32_t GetMipCount(uint32_t width, uint32_t height, uint32_t maxMips)
+	{
+		uint32_t count = 1;
+		for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+		{
+			count++;
+		}
+		return maxMips > 0 ? std::min(count, maxMips) : count;
+	}
+
+	// box filter over the exact footprint, source / destination texels wide: 2 for even sizes,
+	// three partially covered texels for odd ones so nothing shifts by half a texel.
+	static void BuildTaps(uint32_t sourceSize, uint32_t destinationSize, std::vector<Tap>& taps, std::vector<uint32_t>& firsts)
+	{
+		const double scale = static_cast<double>(sourceSize) / destinationSize;
+		taps.clear();
+		firsts.assign(destinationSize + 1, 0);
+		for (uint32_t i = 0; i < destinationSize; i++)
+		{
+			firsts[i] = static_cast<uint32_t>(taps.size());
+			const double begin = i * scale;
+			const double end = (i + 1) * scale;
+			for (uint32_t s = static_cast<uint32_t>(begin); s < sourceSize && s < end; s++)
+			{
+				const double covered = std::min<double>(end, s + 1.0) - std::max<double>(begin, s);
+				if (covered > 1e-6)
+				{
+					taps.push_back({ s, static_cast<float>(covered / scale) });
+				}
+			}
+		}
+		firsts[destinationSize] = static_cast<uint32_t>(taps.size());
+	}
+
+	static FloatImage Downsample(const FloatImage& source)
+	{
+		FloatImage result;
+		result.width = std::max(source.width / 2, 1u);
+		result.height = std::max(source.height / 2, 1u);
+		result.texels.resize(static_cast<size_t>(result.width) * result.height);
+		result.plain.resize(source.plain.empty() ? 0 : result.texels.size());
+
+		std::vector<Tap> tapsX, tapsY;
+		std::vector<uint32_t> firstsX, firstsY;
+		BuildTaps(source.width, result.width, tapsX, firstsX);
+		BuildTaps(source.height, result.height, tapsY, firstsY);
+
+		Common::JobSystem::Get().ParallelFor(result.height, BatchRows(source.width), [&](uint32_t begin, uint32_t end)
+		{
+			// the footprint's rows into one, then across.
+			std::vector<glm::vec4> row(source.width);
+			std::vector<glm::vec3> plainRow(source.plain.empty() ? 0 : source.width);
+			for (uint32_t y = begin; y < end; y++)
+			{
+				std::fill(row.begin(), row.end(), glm::vec4(0.0f));
+				std::fill(plainRow.begin(), plainRow.end(), glm::vec3(0.0f));
+				for (uint32_t t = firstsY[y]; t < firstsY[y + 1]; t++)
+				{
+					const size_t offset = static_cast<size_t>(tapsY[t].source) * source.width;
+					for (uint32_t x = 0; x < source.width; x++)
+					{
+						row[x] += source.texels[offset + x] * tapsY[t].weight;
+					}
+					for (size_t x = 0; x < plainRow.size(); x++)
+					{
+						plainRow[x] += source.plain[offset + x] * tapsY[t].weight;
+					}
+				}
+
+				for (uint32_t x = 0; x < result.width; x++)
+				{
+					glm::vec4 texel(0.0f);
+					glm::vec3 plain(0.0f);
+					for (uint32_t t = firstsX[x]; t < firstsX[x + 1]; t++)
+					{
+						texel += row[tapsX[t].source] * tapsX[t].weight;
+						if (!plainRow.empty())
+						{
+							plain += plainRow[tapsX[t].source] * tapsX[t].weight;
+						}
+					}
+					const size_t index = static_cast<size_t>(y) * result.width + x;
+					result.texels[index] = texel;
+					if (!result.plain.empty())
+					{
+						result.plain[index] = plain;
+					}
+				}
+			}
+		});
+		return result;
+	}
+
+	static FloatImage ToFloat(const Image& image, const MipSettings& settings)
+	{
+		float toLinear[256];
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			toLinear[i] = settings.srgb ? SrgbToLinear(i / 255.0f) : i / 255.0f;
+		}
+
+		FloatImage result;
+		result.width = image.width;
+		result.height = image.height;
+		result.texels.resize(static_cast<size_t>(image.width) * image.height);
+		bool translucent = false;
+		for (size_t i = 0; i < result.texels.size() && !settings.normalMap && !translucent; i++)
+		{
+			translucent = image.pixels[i * 4 + 3] != 255;
+		}
+		if (translucent)
+		{
+			result.plain.resize(result.texels.size());
+		}
+
+		Common::JobSystem::Get().ParallelFor(image.height, BatchRows(image.width), [&](uint32_t begin, uint32_t end)
+		{
+			for (size_t i = static_cast<size_t>(begin) * image.width; i < static_cast<size_t>(end) * image.width; i++)
+			{
+				const uint8_t* pixel = &image.pixels[i * 4];
+				const float alpha = pixel[3] / 255.0f;
+				if (settings.normalMap)
+				{
+					result.texels[i] = glm::vec4(glm::vec3(pixel[0], pixel[1], pixel[2]) / 127.5f - 1.0f, alpha);
+					continue;
+				}
+				const glm::vec3 color(toLinear[pixel[0]], toLinear[pixel[1]], toLinear[pixel[2]]);
+				result.texels[i] = glm::vec4(color * alpha, alpha);
+				if (translucent)
+				{
+					result.plain[i] = color;
+				}
+			}
+		});
+		return result;
+	}
+
+	static Image ToImage(const FloatImage& image, const MipSettings& settings)
+	{
+		uint8_t fromLinear[4096];
+		for (uint32_t i = 0; i < 4096; i++)
+		{
+			fromLinear[i] = ToUnorm8(settings.srgb ? LinearToSrgb(i / 4095.0f) : i / 4095.0f);
+		}
+
+		Image result;
+		result.width = image.width;
+		result.height = image.height;
+		result.pixels.resize(image.texels.size() * 4);
+		Common::JobSystem::Get().ParallelFor(image.height, BatchRows(image.width), [&](uint32_t begin, uint32_t end)
+		{
+			for (size_t i = static_cast<size_t>(begin) * image.width; i < static_cast<size_t>(end) * image.width; i++)
+			{
+				const glm::vec4& texel = image.texels[i];
+				uint8_t* pixel = &result.pixels[i * 4];
+				pixel[3] = ToUnorm8(texel.a);
+
+				glm::vec3 color;
+				if (settings.normalMap)
+				{
+					const float length = glm::length(glm::vec3(texel));
+					color = (length > 0.0f ? glm::vec3(texel) / length : glm::vec3(0.0f, 0.0f, 1.0f)) * 0.5f + 0.5f;
+					for (int c = 0; c < 3; c++)
+					{
+						pixel[c] = ToUnorm8(color[c]);
+					}
+					continue;
+				}
+				// under 1/255 of coverage the weighted color is mostly rounding noise.
+				color = texel.a > 1.0f / 255.0f || image.plain.empty() ? glm::vec3(texel) / std::max(texel.a, 1e-8f) : image.plain[i];
+				for (int c = 0; c < 3; c++)
+				{
+					pixel[c] = fromLinear[static_cast<uint32_t>(std::lround(std::clamp(color[c], 0.0f, 1.0f) * 4095.0f))];
+				}
+			}
+		});
+		return result;
+	}
+
+	std::vector<Image> GenerateMips(const Image& source, const MipSettings& settings)
+	{
+		const uint32_t mipCount = GetMipCount(source.width, source.height, settings.maxMips);
+		std::vector<Image> mips;
+		mips.reserve(mipCount);
+		mips.push_back(source);
+		if (mipCount == 1)
+		{
+			return mips;
+		}
+
+		FloatImage level = ToFloat(source, settings);
+		for (uint32_t i = 1; i < mipCount; i++)
+		{
+			level = Downsample(level);
+			mips.push_back(ToImage(level, settings));
+		}
+		return mips;
+	}
+}
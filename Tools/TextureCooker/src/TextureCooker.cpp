@@ -0,0 +1,100 @@
+#include <TextureCooker.hpp>
+#include <BlockEncoder.hpp>
+#include <MipGenerator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace att::Asset;
+
+namespace Cooker
+{
+	static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	static TextureFormat ToSrgb(TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::RGBA8:
+			return TextureFormat::RGBA8Srgb;
+		case TextureFormat::BC1:
+			return TextureFormat::BC1Srgb;
+		case TextureFormat::BC3:
+			return TextureFormat::BC3Srgb;
+		case TextureFormat::BC7:
+			return TextureFormat::BC7Srgb;
+		case TextureFormat::ASTC4x4:
+			return TextureFormat::ASTC4x4Srgb;
+		default:
+			return format;
+		}
+	}
+
+	void CookTexture(const Image& image, const CookSettings& settings, std::vector<uint8_t>& blob, CookReport& report)
+	{
+		report = {};
+		const TextureFormat format = settings.srgb && !settings.normalMap ? ToSrgb(settings.format) : settings.format;
+
+		MipSettings mipSettings;
+		mipSettings.srgb = settings.srgb && !settings.normalMap;
+		mipSettings.normalMap = settings.normalMap;
+		mipSettings.maxMips = std::min(settings.maxMips > 0 ? settings.maxMips : CookedTextureMaxMips, CookedTextureMaxMips);
+		auto start = std::chrono::steady_clock::now();
+		const std::vector<Image> mips = GenerateMips(image, mipSettings);
+		report.mipMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		CookedTextureHeader header = {};
+		header.magic = CookedTextureMagic;
+		header.version = CookedTextureVersion;
+		header.format = format;
+		header.width = image.width;
+		header.height = image.height;
+		header.mipCount = static_cast<uint32_t>(mips.size());
+		for (size_t i = 0; i < image.pixels.size() && (header.flags & CookedTextureAlpha) == 0; i += 4)
+		{
+			header.flags |= image.pixels[i + 3] != 255 ? CookedTextureAlpha : 0u;
+		}
+		header.flags |= settings.normalMap ? CookedTextureNormalMap : 0u;
+
+		// the mips that fit the tail size are read with the header, the rest smallest first.
+		header.tailMip = header.mipCount - 1;
+		while (header.tailMip > 0 && std::max(mips[header.tailMip - 1].width, mips[header.tailMip - 1].height) <= CookedTextureTailSize)
+		{
+			header.tailMip--;
+		}
+		uint64_t offset = sizeof(CookedTextureHeader);
+		for (uint32_t i = header.mipCount; i > 0; i--)
+		{
+			CookedTextureMip& mip = header.mips[i - 1];
+			mip.offset = AlignUp(offset, 16);
+			mip.size = static_cast<uint32_t>(GetTextureMipBytes(format, mips[i - 1].width, mips[i - 1].height));
+			mip.width = static_cast<uint16_t>(mips[i - 1].width);
+			mip.height = static_cast<uint16_t>(mips[i - 1].height);
+			offset = mip.offset + mip.size;
+			if (i - 1 == header.tailMip)
+			{
+				header.tailSize = offset;
+			}
+		}
+
+		blob.assign(offset, 0);
+		memcpy(blob.data(), &header, sizeof(header));
+		start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < header.mipCount; i++)
+		{
+			EncodeImage(mips[i], format, blob.data() + header.mips[i].offset);
+			report.sourceBytes += mips[i].pixels.size();
+		}
+		report.encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		report.format = format;
+		report.mipCount = header.mipCount;
+		report.tailMip = header.tailMip;
+		report.cookedBytes = blob.size();
+		report.tailBytes = header.tailSize;
+	}
+}
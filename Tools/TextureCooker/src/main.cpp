@@ -0,0 +1,249 @@
+#include <BlockEncoder.hpp>
+#include <ImageLoader.hpp>
+#include <TextureCooker.hpp>
+#include <ANTUTU/Asset/ArchiveWriter.hpp>
+#include <Common/Job/JobSystem.h>
+#include <Common/Logger/LogManager.h>
+#include <Common/Logger/GUIConsole.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Cooks .tga / .png images into mipmapped, block compressed .tex blobs
+// (TextureFormat.hpp) in a .apak archive, directories recursively with their
+// paths relative to the directory given, e.g.:
+//   TextureCooker data/textures.apak art/textures
+//   TextureCooker --normal --format bc5 data/normals.apak art/normals
+//
+// art/textures/rock/albedo.png is then "rock/albedo.tex" in the archive.
+// The blobs are stored uncompressed: the runtime reads single mips out of
+// them.
+//
+// exit codes: 0 = success, 1 = failure, 2 = bad arguments.
+
+using namespace att::Asset;
+
+static void PrintUsage()
+{
+	std::cout <<
+		"TextureCooker [options] <output.apak> <image file or directory>...\n"
+		"  --format F              rgba8, bc1, bc3, bc5, bc7"
+#if defined(ANTUTU_PLATFORM_MOBILE)
+		", astc (astc)\n"
+#else
+		" (bc7, bc5 for normal maps)\n"
+#endif
+		"  --linear                data, not sRGB color: no sRGB format or filtering\n"
+		"  --normal                normal maps: filtered as vectors, linear\n"
+		"  --mips N                at most N mips, 0 = down to 1x1 (0)\n"
+		"  --align N               blob alignment, 4096 (default) or 65536\n";
+}
+
+static bool ParseFormat(const char* name, TextureFormat& format)
+{
+	static constexpr std::pair<const char*, TextureFormat> Formats[] = {
+		{ "rgba8", TextureFormat::RGBA8 }, { "bc1", TextureFormat::BC1 }, { "bc3", TextureFormat::BC3 },
+		{ "bc5", TextureFormat::BC5 }, { "bc7", TextureFormat::BC7 }, { "astc", TextureFormat::ASTC4x4 }
+	};
+	for (const auto& [formatName, value] : Formats)
+	{
+		if (strcmp(name, formatName) == 0)
+		{
+			format = value;
+			return true;
+		}
+	}
+	return false;
+}
+
+int main(int argc, char** argv)
+{
+	// the archive code logs its own errors.
+	Common::LogManager::Get().Init();
+	Common::LogManager::Get().AddObserver(std::make_shared<Common::GUIConsole>());
+
+	Cooker::CookSettings settings;
+	bool formatGiven = false;
+	uint32_t alignment = ArchiveSmallAlignment;
+	std::vector<const char*> positional;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		auto takesValue = [&]()
+		{
+			if (value == nullptr)
+			{
+				std::cerr << arg << " needs a value" << std::endl;
+				std::exit(2);
+			}
+			i++;
+			return value;
+		};
+
+		if (strcmp(arg, "--format") == 0)
+		{
+			const char* name = takesValue();
+			if (!ParseFormat(name, settings.format))
+			{
+				std::cerr << "unknown format " << name << std::endl;
+				return 2;
+			}
+			if (!Cooker::IsFormatSupported(settings.format))
+			{
+				std::cerr << name << " is for mobile builds (ANTUTU_PLATFORM_MOBILE)" << std::endl;
+				return 2;
+			}
+			formatGiven = true;
+		}
+		else if (strcmp(arg, "--linear") == 0)
+		{
+			settings.srgb = false;
+		}
+		else if (strcmp(arg, "--normal") == 0)
+		{
+			settings.normalMap = true;
+			settings.srgb = false;
+		}
+		else if (strcmp(arg, "--mips") == 0)
+		{
+			settings.maxMips = static_cast<uint32_t>(std::strtoul(takesValue(), nullptr, 10));
+			if (settings.maxMips > CookedTextureMaxMips)
+			{
+				std::cerr << "--mips needs 0 to " << CookedTextureMaxMips << std::endl;
+				return 2;
+			}
+		}
+		else if (strcmp(arg, "--align") == 0)
+		{
+			alignment = static_cast<uint32_t>(std::strtoul(takesValue(), nullptr, 10));
+			if (alignment < 16 || (alignment & (alignment - 1)) != 0)
+			{
+				std::cerr << "--align needs a power of two of at least 16" << std::endl;
+				return 2;
+			}
+		}
+		else if (arg[0] == '-')
+		{
+			PrintUsage();
+			return strcmp(arg, "--help") == 0 ? EXIT_SUCCESS : 2;
+		}
+		else
+		{
+			positional.push_back(arg);
+		}
+	}
+
+	if (positional.size() < 2)
+	{
+		PrintUsage();
+		return 2;
+	}
+	if (!formatGiven)
+	{
+#if defined(ANTUTU_PLATFORM_MOBILE)
+		settings.format = TextureFormat::ASTC4x4;
+#else
+		settings.format = settings.normalMap ? TextureFormat::BC5 : TextureFormat::BC7;
+#endif
+	}
+
+	// (file, path in the archive), sorted so the same inputs give the same archive.
+	std::vector<std::pair<std::filesystem::path, std::string>> inputs;
+	for (size_t i = 1; i < positional.size(); i++)
+	{
+		const std::filesystem::path input(positional[i]);
+		std::error_code error;
+		if (std::filesystem::is_directory(input, error))
+		{
+			for (const auto& item : std::filesystem::recursive_directory_iterator(input, error))
+			{
+				if (item.is_regular_file() && Cooker::IsImageFile(item.path()))
+				{
+					inputs.emplace_back(item.path(), std::filesystem::relative(item.path(), input).replace_extension(".tex").generic_string());
+				}
+			}
+		}
+		else if (std::filesystem::is_regular_file(input, error))
+		{
+			inputs.emplace_back(input, std::filesystem::path(input.filename()).replace_extension(".tex").generic_string());
+		}
+		else
+		{
+			std::cerr << positional[i] << " doesn't exist" << std::endl;
+			spdlog::shutdown();
+			return 1;
+		}
+	}
+	std::sort(inputs.begin(), inputs.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+
+	ArchiveWriter writer;
+	if (!writer.Open(positional[0], alignment))
+	{
+		std::cerr << "Can't create " << positional[0] << std::endl;
+		spdlog::shutdown();
+		return 1;
+	}
+
+	// mip filtering and block encoding run their rows on the workers.
+	Common::JobSystem::Get().Initialize();
+	int result = EXIT_SUCCESS;
+	uint64_t sourceBytes = 0;
+	uint64_t cookedBytes = 0;
+	Cooker::Image image;
+	std::vector<uint8_t> blob;
+	for (const auto& [file, path] : inputs)
+	{
+		std::string error;
+		if (!Cooker::LoadImage(file, image, error))
+		{
+			std::cerr << file.string() << ": " << error << std::endl;
+			result = EXIT_FAILURE;
+			break;
+		}
+		if (image.width > (1u << (CookedTextureMaxMips - 1)) || image.height > (1u << (CookedTextureMaxMips - 1)))
+		{
+			std::cerr << file.string() << ": larger than " << (1u << (CookedTextureMaxMips - 1)) << " on a side" << std::endl;
+			result = EXIT_FAILURE;
+			break;
+		}
+
+		Cooker::CookReport report;
+		Cooker::CookTexture(image, settings, blob, report);
+		if (!writer.Add(path, blob.data(), blob.size(), ArchiveCompression::None))
+		{
+			std::cerr << "Can't add " << path << " (duplicate path or write error)" << std::endl;
+			result = EXIT_FAILURE;
+			break;
+		}
+
+		std::cout << std::fixed << std::setprecision(1) << path << ": " << image.width << "x" << image.height << " "
+				  << GetTextureFormatName(report.format) << ", " << report.mipCount << " mips (tail from " << report.tailMip
+				  << ", " << report.tailBytes << " bytes), " << report.sourceBytes << " -> " << report.cookedBytes
+				  << " bytes, mips " << report.mipMs << " ms, encode " << report.encodeMs << " ms" << std::endl;
+		sourceBytes += report.sourceBytes;
+		cookedBytes += report.cookedBytes;
+	}
+	Common::JobSystem::Get().Shutdown();
+
+	if (result == EXIT_SUCCESS && !writer.Finish())
+	{
+		std::cerr << "Failed to write " << positional[0] << std::endl;
+		result = EXIT_FAILURE;
+	}
+	if (result == EXIT_SUCCESS)
+	{
+		std::cout << positional[0] << ": " << inputs.size() << " textures, " << sourceBytes << " RGBA8 bytes cooked to "
+				  << cookedBytes << std::endl;
+	}
+	spdlog::shutdown();
+	return result;
+}